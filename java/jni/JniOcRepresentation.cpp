@@ -56,14 +56,14 @@ JNIEXPORT jobject JNICALL Java_org_iotivity_base_OcRepresentation_getValues
         return nullptr;
     }
 
-    std::map<std::string, AttributeValue> values = rep->getValues();
+    const OCRepresentation::AttributeMap& values = rep->getValues();
     jobject jHashMap = env->NewObject(g_cls_HashMap, g_mid_HashMap_ctor);
     if (!jHashMap)
     {
         return nullptr;
     }
 
-    for (std::map<std::string, AttributeValue>::const_iterator it = values.begin(); it != values.end(); it++)
+    for (OCRepresentation::AttributeMap::const_iterator it = values.begin(); it != values.end(); it++)
     {
         jobject key = static_cast<jobject>(env->NewStringUTF(it->first.c_str()));
         jobject val = boost::apply_visitor(JObjectConverter(env), it->second);
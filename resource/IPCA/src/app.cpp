@@ -31,6 +31,7 @@ OCFFramework ocfFramework;
 App::App(const IPCAAppInfo* ipcaAppInfo, IPCAVersion ipcaVersion) :
     m_isStopped(false),
     m_ipcaVersion(ipcaVersion),
+    m_appWorkerThreadWakeRequested(false),
     m_passwordInputCallbackHandle(nullptr),
     m_passwordInputCallbackInfo(nullptr),
     m_passwordDisplayCallbackHandle(nullptr),
@@ -96,7 +97,7 @@ void App::Stop()
 
     // Stop the discovery thread.
     m_isStopped = true;
-    m_discoveryThreadCV.notify_all();   // Wake discovery thread and wait for it to quit.
+    WakeWorkerThread();   // Wake discovery thread and wait for it to quit.
     if (m_appWorkerThread.joinable())
     {
         m_appWorkerThread.join();
@@ -148,18 +149,14 @@ void App::AppWorkerThread(App::Ptr app)
 
     const uint64_t PingPeriodMS = 30000;  // Do device ping for Observed devices every 30 seconds.
 
-    // Outstanding requests should time out in 247 seconds (EXCHANGE_LIFETIME) per rfc 7252.
-    // Wake up every second to check.
-    const size_t AppThreadSleepTimeSeconds = 1;
-    std::chrono::seconds appThreadSleepTime(AppThreadSleepTimeSeconds);
-
-    std::unique_lock<std::mutex> appWorkerLock(app->m_appWorkerThreadMutex);
+    const uint64_t NoDeadline = UINT64_MAX;
 
     OIC_LOG_V(INFO, TAG, "+AppWorkerThread started.");
 
     while (false == app->m_isStopped)
     {
         uint64_t currentTime = OICGetCurrentTime(TIME_IN_MS);
+        uint64_t nextDeadline = NoDeadline;
 
         // Do periodic discovery for active IPCADiscoverDevices() requests.
         std::map<size_t, std::vector<std::string>> resourceTypesToDiscover;
@@ -169,28 +166,25 @@ void App::AppWorkerThread(App::Ptr app)
             {
                 DiscoveryDetails::Ptr discoveryDetails = entry.second;
 
-                if (discoveryDetails->discoveryCount < FastDiscoveryCount)
-                {
-                    if (currentTime - discoveryDetails->lastDiscoveryTime > FastDiscoveryPeriodMs)
-                    {
-                        resourceTypesToDiscover[entry.first] =
-                            discoveryDetails->resourceTypesToDiscover;
-
-                        discoveryDetails->lastDiscoveryTime = currentTime;
-                        discoveryDetails->discoveryCount++;
-                    }
-                }
-                else
+                uint64_t discoveryPeriodMs =
+                    (discoveryDetails->discoveryCount < FastDiscoveryCount) ?
+                        FastDiscoveryPeriodMs : SlowDiscoveryPeriodMs;
+
+                if (currentTime - discoveryDetails->lastDiscoveryTime > discoveryPeriodMs)
                 {
-                    if (currentTime - discoveryDetails->lastDiscoveryTime > SlowDiscoveryPeriodMs)
-                    {
-                        resourceTypesToDiscover[entry.first] =
-                            discoveryDetails->resourceTypesToDiscover;
-
-                        discoveryDetails->lastDiscoveryTime = currentTime;
-                        discoveryDetails->discoveryCount++;
-                    }
+                    resourceTypesToDiscover[entry.first] =
+                        discoveryDetails->resourceTypesToDiscover;
+
+                    discoveryDetails->lastDiscoveryTime = currentTime;
+                    discoveryDetails->discoveryCount++;
+
+                    discoveryPeriodMs =
+                        (discoveryDetails->discoveryCount < FastDiscoveryCount) ?
+                            FastDiscoveryPeriodMs : SlowDiscoveryPeriodMs;
                 }
+
+                nextDeadline = std::min(nextDeadline,
+                                    discoveryDetails->lastDiscoveryTime + discoveryPeriodMs + 1);
             }
         }
 
@@ -201,8 +195,10 @@ void App::AppWorkerThread(App::Ptr app)
 
         // Do callbacks for expired outstanding requests.
         std::vector<CallbackInfo::Ptr> expiredCallbacks;
-        app->m_callback->CompleteAndRemoveExpiredCallbackInfo(expiredCallbacks);
+        uint64_t nextExpiryTime;
+        app->m_callback->CompleteAndRemoveExpiredCallbackInfo(expiredCallbacks, nextExpiryTime);
         expiredCallbacks.clear();   // no use of the expired callbacks.
+        nextDeadline = std::min(nextDeadline, nextExpiryTime);
 
         // Get oustanding Observe requests and ping the device every PingPeriodMS.
         std::vector<CallbackInfo::Ptr> observeCallbacks;
@@ -210,24 +206,66 @@ void App::AppWorkerThread(App::Ptr app)
         for (auto& cbInfo : observeCallbacks)
         {
             uint64_t lastPingTime;
-            if ((IPCA_OK == cbInfo->device->GetLastPingTime(lastPingTime)) &&
-                (currentTime - lastPingTime > PingPeriodMS))
+            if (IPCA_OK != cbInfo->device->GetLastPingTime(lastPingTime))
+            {
+                continue;
+            }
+
+            if (currentTime - lastPingTime > PingPeriodMS)
             {
                 cbInfo->device->Ping();
+                lastPingTime = currentTime;
             }
+
+            nextDeadline = std::min(nextDeadline, lastPingTime + PingPeriodMS + 1);
         }
 
-        app->m_discoveryThreadCV.wait_for(appWorkerLock,
-                        appThreadSleepTime,
-                        [app]()
-                        {
-                            return app->m_isStopped;
-                        });
+        // Sleep until the earliest deadline.  The lock is only held while waiting so that
+        // WakeWorkerThread() never blocks behind the work above.
+        std::unique_lock<std::mutex> appWorkerLock(app->m_appWorkerThreadMutex);
+        auto isWakeUpNeeded = [app]()
+                                {
+                                    return app->m_isStopped ||
+                                           app->m_appWorkerThreadWakeRequested;
+                                };
+
+        if (nextDeadline == NoDeadline)
+        {
+            app->m_discoveryThreadCV.wait(appWorkerLock, isWakeUpNeeded);
+        }
+        else
+        {
+            currentTime = OICGetCurrentTime(TIME_IN_MS);
+            uint64_t sleepTimeMs = (nextDeadline > currentTime) ? (nextDeadline - currentTime) : 0;
+            app->m_discoveryThreadCV.wait_for(appWorkerLock,
+                                              std::chrono::milliseconds(sleepTimeMs),
+                                              isWakeUpNeeded);
+        }
+
+        app->m_appWorkerThreadWakeRequested = false;
     }
 
     OIC_LOG_V(INFO, TAG, "-AppWorkerThread exit.");
 }
 
+void App::RequestSent(CallbackInfo::Ptr cbInfo)
+{
+    if (m_callback->ScheduleRequestExpiry(cbInfo))
+    {
+        WakeWorkerThread();
+    }
+}
+
+void App::WakeWorkerThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_appWorkerThreadMutex);
+        m_appWorkerThreadWakeRequested = true;
+    }
+
+    m_discoveryThreadCV.notify_all();
+}
+
 IPCAStatus App::OpenDevice(App::Ptr thisApp, const char* deviceId, IPCADeviceHandle* deviceHandle)
 {
     *deviceHandle = nullptr;
@@ -327,8 +365,13 @@ IPCAStatus App::DiscoverDevices(
     if (status == IPCA_OK)
     {
         // Add it to the periodic discovery list.
-        std::lock_guard<std::mutex> lock(m_appMutex);
-        m_discoveryList[cbInfo->mapKey] = discoveryDetails;
+        {
+            std::lock_guard<std::mutex> lock(m_appMutex);
+            m_discoveryList[cbInfo->mapKey] = discoveryDetails;
+        }
+
+        // Schedule the next discovery of this list.
+        WakeWorkerThread();
     }
     else
     {
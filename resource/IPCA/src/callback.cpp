@@ -28,6 +28,12 @@
 // Next key for the m_callbackInfoList map. Key is unique across all IPCA apps.
 static std::atomic<size_t> g_nextKey(1);
 
+// Time after which an outstanding request fails with IPCA_REQUEST_TIMEOUT.
+static const uint64_t RequestTimeoutMs = 247000;    // This is EXCHANGE_LIFETIME defined in RFC7252.
+
+// Time after which a request that expired while its callback was in progress is checked again.
+static const uint64_t RequestExpiryRetryMs = 1000;
+
 extern OCFFramework ocfFramework;
 
 Callback::Callback(AppPtr app) :
@@ -66,6 +72,8 @@ void Callback::Stop()
         if (m_callbackInfoList.size() != 0)
         {
             std::lock_guard<std::mutex> lock(m_callbackMutex);
+            m_requestExpiries.clear();
+            m_callbacksToBeRemoved.clear();
             for (auto it = m_callbackInfoList.cbegin();
                  it != m_callbackInfoList.cend();
                  /* increment inside loop */)
@@ -456,6 +464,7 @@ IPCAStatus Callback::RemoveCallbackInfo(size_t mapKey,
     {
         // There's at least one in progress callback to app's code.
         callbackInfo->markedToBeRemoved = true;
+        m_callbacksToBeRemoved.insert(mapKey);
 
         // Call to closeHandleComplete will happen when all the callbacks are completed.
         callbackInfo->closeHandleCompleteCallback = closeHandleComplete;
@@ -465,14 +474,30 @@ IPCAStatus Callback::RemoveCallbackInfo(size_t mapKey,
     return IPCA_OK;
 }
 
-void Callback::CompleteAndRemoveExpiredCallbackInfo(std::vector<CallbackInfo::Ptr>& cbInfoList)
+bool Callback::ScheduleRequestExpiry(CallbackInfo::Ptr cbInfo)
 {
-    const int RequestTimeoutMs = 247000;    // This is EXCHANGE_LIFETIME defined in RFC7252.
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+
+    cbInfo->requestSentTimestamp = OICGetCurrentTime(TIME_IN_MS);
+    if ((m_stopCalled == true) ||
+        ((cbInfo->type != CallbackType_GetPropertiesComplete)  &&
+         (cbInfo->type != CallbackType_SetPropertiesComplete)  &&
+         (cbInfo->type != CallbackType_CreateResourceComplete) &&
+         (cbInfo->type != CallbackType_DeleteResourceComplete)))
+    {
+        return false;
+    }
 
-    // Separate list for callbacks that are already completed.
-    std::vector<CallbackInfo::Ptr> completedCallbacks;
+    auto expiry = m_requestExpiries.emplace(cbInfo->requestSentTimestamp + RequestTimeoutMs,
+                                            cbInfo->mapKey);
+    return expiry == m_requestExpiries.begin();
+}
 
+void Callback::CompleteAndRemoveExpiredCallbackInfo(std::vector<CallbackInfo::Ptr>& cbInfoList,
+                                                    uint64_t& nextExpiryTime)
+{
     uint64_t currentTime = OICGetCurrentTime(TIME_IN_MS);
+    nextExpiryTime = UINT64_MAX;
 
     {
         std::lock_guard<std::mutex> lock(m_callbackMutex);
@@ -482,44 +507,61 @@ void Callback::CompleteAndRemoveExpiredCallbackInfo(std::vector<CallbackInfo::Pt
             return;
         }
 
-        // Collect the expired requests.
-        for(auto const& entry : m_callbackInfoList)
+        // Removal of callbacks that couldn't be removed during RemoveCallbackInfo()
+        // and that have completed the callback by now.
+        for (auto it = m_callbacksToBeRemoved.begin(); it != m_callbacksToBeRemoved.end();
+             /* increment inside loop */)
         {
-            // Opportunistic removal of callback that couldn't be removed during
-            // RemoveCallbackInfo() and if by now it has completed the callback.
-            if ((entry.second->markedToBeRemoved == true) &&
-                (entry.second->callbackInProgressCount == 0))
+            auto entry = m_callbackInfoList.find(*it);
+            if (entry == m_callbackInfoList.end())
             {
-                completedCallbacks.push_back(entry.second);
-                continue;
+                it = m_callbacksToBeRemoved.erase(it);
             }
-
-            // Look for outstanding get, set, create requests that have been sent
-            // (time stamp is not 0), have timed out and not already in the middle of callback.
-            if ((entry.second->requestSentTimestamp != 0) &&
-                (entry.second->callbackInProgressCount == 0) &&
-                ((entry.second->type == CallbackType_GetPropertiesComplete)  ||
-                 (entry.second->type == CallbackType_SetPropertiesComplete)  ||
-                 (entry.second->type == CallbackType_CreateResourceComplete) ||
-                 (entry.second->type == CallbackType_DeleteResourceComplete)))
+            else if (entry->second->callbackInProgressCount == 0)
             {
-                if ((currentTime - entry.second->requestSentTimestamp) > RequestTimeoutMs)
-                {
-                    m_expiredCallbacksInProgress++;
-                    cbInfoList.push_back(entry.second);
-                }
+                m_callbackInfoList.erase(entry);
+                it = m_callbacksToBeRemoved.erase(it);
+            }
+            else
+            {
+                ++it;
             }
         }
 
-        // Remove them from the list.
-        for (auto const& entry : completedCallbacks)
+        // Collect the expired requests, in order of expiry.
+        std::vector<std::pair<uint64_t, size_t>> retries;
+        while (!m_requestExpiries.empty() && (currentTime > m_requestExpiries.begin()->first))
         {
-            m_callbackInfoList.erase(entry->mapKey);
+            uint64_t expiryTime = m_requestExpiries.begin()->first;
+            size_t mapKey = m_requestExpiries.begin()->second;
+            m_requestExpiries.erase(m_requestExpiries.begin());
+
+            // The request completed, or was closed, or was sent again and expires later.
+            auto entry = m_callbackInfoList.find(mapKey);
+            if ((entry == m_callbackInfoList.end()) ||
+                (entry->second->markedToBeRemoved == true) ||
+                (entry->second->requestSentTimestamp + RequestTimeoutMs > expiryTime))
+            {
+                continue;
+            }
+
+            // Not expired in the middle of a callback, check again a little later.
+            if (entry->second->callbackInProgressCount != 0)
+            {
+                retries.emplace_back(currentTime + RequestExpiryRetryMs, mapKey);
+                continue;
+            }
+
+            m_expiredCallbacksInProgress++;
+            cbInfoList.push_back(entry->second);
+            m_callbackInfoList.erase(entry);
         }
 
-        for (auto const& entry : cbInfoList)
+        m_requestExpiries.insert(retries.begin(), retries.end());
+
+        if (!m_requestExpiries.empty())
         {
-            m_callbackInfoList.erase(entry->mapKey);
+            nextExpiryTime = m_requestExpiries.begin()->first;
         }
     }
 
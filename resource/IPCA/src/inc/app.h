@@ -59,6 +59,14 @@ class App
         // Returns application's ID.
         std::string GetAppId();
 
+        // Wake the app worker thread so it recomputes its next deadline, e.g. when a request
+        // is sent or a discovery is started.
+        void WakeWorkerThread();
+
+        // A get, set, create or delete request was sent. Its expiry is scheduled, and the app
+        // worker thread is woken if it expires before the other outstanding requests.
+        void RequestSent(CallbackInfo::Ptr cbInfo);
+
         // Application calls IPCADiscoverDevices().
         IPCAStatus DiscoverDevices(
                         IPCADiscoverDeviceCallback callback,
@@ -159,10 +167,12 @@ class App
         // Devices this app opened.
         std::map<DeviceWrapper*, DeviceWrapper*> m_openedDevices;
 
-        // Thread that performs periodic discovery.
+        // Thread that performs periodic discovery, request expiry and device ping.  It sleeps
+        // until the earliest of those deadlines or until WakeWorkerThread() is called.
         std::thread m_appWorkerThread;
         std::condition_variable m_discoveryThreadCV;
         std::mutex m_appWorkerThreadMutex;
+        bool m_appWorkerThreadWakeRequested;
 
         // Create and register CallbackInfo with the Callback object.
         IPCAStatus CreateAndRegisterNewCallbackInfo(
@@ -153,9 +153,15 @@ class Callback
                         IPCACloseHandleComplete closeHandleComplete = nullptr,
                         const void* context = nullptr);
 
+        // Record that the request of cbInfo was sent and schedule its expiry.
+        // Returns true if it expires before every other outstanding request.
+        bool ScheduleRequestExpiry(CallbackInfo::Ptr cbInfo);
+
         // Complete the callback for expired CallbackInfo and remove them from the
-        // m_callbackInfoList. Caller receives a list of them.
-        void CompleteAndRemoveExpiredCallbackInfo(std::vector<CallbackInfo::Ptr>& cbInfoList);
+        // m_callbackInfoList. Caller receives a list of them, and in nextExpiryTime the time
+        // the next outstanding request expires (UINT64_MAX if there is none).
+        void CompleteAndRemoveExpiredCallbackInfo(std::vector<CallbackInfo::Ptr>& cbInfoList,
+                                                  uint64_t& nextExpiryTime);
 
         // Return a list of CallbackInfo object matching the type.
         void GetCallbackInfoList(CallbackType type, std::vector<CallbackInfo::Ptr>& cbInfoList);
@@ -221,6 +227,13 @@ class Callback
 
         // Table of CallbackInfo.  Key is autogenerated.
         std::map<size_t, CallbackInfo::Ptr> m_callbackInfoList;  // List of expected callbacks.
+
+        // Expiry time of the outstanding requests, mapped to the key of their CallbackInfo.
+        // Entries of callbacks removed meanwhile are skipped when they expire.
+        std::multimap<uint64_t, size_t> m_requestExpiries;
+
+        // Keys of the CallbackInfo marked to be removed once their callback completes.
+        std::set<size_t> m_callbacksToBeRemoved;
         AppPtr m_app; // Callback object is per app.
         volatile bool m_stopCalled;    // Set to true when Stop() is called.
 
@@ -82,7 +82,6 @@ typedef struct
     bool subowner;
     bool isStarted;
     std::shared_ptr<OC::OCSecureResource> device;
-    std::thread requestAccessThread;
     std::mutex requestAccessThreadMutex;
     std::condition_variable requestAccessThreadCV;
 } InternalSecurityInfo;
@@ -26,6 +26,9 @@
 #include <vector>
 #include <atomic>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <deque>
 #include <memory>
 #include <condition_variable>
 
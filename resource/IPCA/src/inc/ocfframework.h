@@ -68,6 +68,9 @@ typedef struct DeviceDetails
     size_t maintenanceResourceRequestCount; // Number of requests sent for /oic/mnt
     bool maintenanceResourceAvailable; // Set to true if device returns resource for rt: oic.wk.mnt.
 
+    // Timestamp of the last GetCommonResources() call, used to schedule retries.
+    uint64_t lastCommonResourcesRequestTime;
+
     // Security Info
     bool securityInfoAvailable;
     InternalSecurityInfo securityInfo;
@@ -230,7 +233,14 @@ class OCFFramework
         // See m_workerThread variable below.
         static void WorkerThread(OCFFramework* ocfFramework);
 
-        // Entry point for the thread that will request access to a device.
+        // Wake the worker thread so it recomputes its next deadline, e.g. when a device is
+        // added or closed.
+        void WakeWorkerThread();
+
+        // Entry point for the threads in the RequestAccess pool, see m_requestAccessThreads.
+        static void RequestAccessPoolThread(OCFFramework* ocfFramework);
+
+        // Process one RequestAccess request.  Runs on a RequestAccess pool thread.
         static void RequestAccessWorkerThread(RequestAccessContext* requestContext);
 
         // Get DeviceDetails for deviceId.
@@ -263,12 +273,12 @@ class OCFFramework
 
         // A list of devices and their resources.
         // Key to the map is device ID (which is a UUID)
-        std::map<std::string, DeviceDetails::Ptr> m_OCFDevices;
+        std::unordered_map<std::string, DeviceDetails::Ptr> m_OCFDevices;
 
         // Fast look up for DeviceDetails given device's URI.
         // Key to the map is device URI (e.g., "coap://[fe80::5828:93a8:d53e:4222%7]:62744").
         // A device may have multiple URIs (e.g., ipv4 and ipv6).
-        std::map<std::string, DeviceDetails::Ptr> m_OCFDevicesIndexedByDeviceURI;
+        std::unordered_map<std::string, DeviceDetails::Ptr> m_OCFDevicesIndexedByDeviceURI;
 
         // A list of RequestAccess contexts.
         // Key to the map is the device ID (which is a UUID)
@@ -276,9 +286,21 @@ class OCFFramework
 
         // One Callback per App. One App per IPCAOpen().
         std::vector<Callback::Ptr> m_callbacks;
+
+        // Thread that expires unused devices, indicates devices that stopped responding and
+        // retries device/platform info requests.  It sleeps until the earliest of those deadlines
+        // or until WakeWorkerThread() is called.
         std::thread m_workerThread;
         std::condition_variable m_workerThreadCV;
         std::mutex m_workerThreadMutex;
+        bool m_workerThreadWakeRequested;
+
+        // Bounded pool of threads running RequestAccessWorkerThread() for queued requests.
+        std::vector<std::thread> m_requestAccessThreads;
+        std::deque<RequestAccessContext*> m_requestAccessQueue;
+        std::condition_variable m_requestAccessQueueCV;
+        std::mutex m_requestAccessQueueMutex;
+        bool m_requestAccessStopping;   // Set while Stop() drains the pool.
 
         // Synchronize Start()/Stop()
         std::mutex m_startStopMutex;
@@ -40,6 +40,23 @@ using namespace std::placeholders;
 const unsigned short c_discoveryTimeout = 5;  // Max number of seconds to discover
                                               // security information for a device
 
+const size_t c_maxCommonResourceRequestCount = 3;  // Max requests sent for each of oic/d, oic/p
+                                                   // and oic/mnt of a device.
+
+const size_t c_maxRequestAccessThreads = 2;  // Max number of RequestAccess requests processed
+                                             // concurrently.  The rest are queued.
+
+// True if GetCommonResources() has requests left to send for the device.
+static bool IsCommonResourceRequestPending(const DeviceDetails::Ptr& deviceDetails)
+{
+    return (!deviceDetails->deviceInfoAvailable &&
+            (deviceDetails->deviceInfoRequestCount < c_maxCommonResourceRequestCount)) ||
+           (!deviceDetails->platformInfoAvailable &&
+            (deviceDetails->platformInfoRequestCount < c_maxCommonResourceRequestCount)) ||
+           (!deviceDetails->maintenanceResourceAvailable &&
+            (deviceDetails->maintenanceResourceRequestCount < c_maxCommonResourceRequestCount));
+}
+
 // Path for Persistent Storage (Ends with backslash (\) or forward slash (/))
 std::string  g_psPath;
 
@@ -59,6 +76,8 @@ FILE* server_fopen(const char *path, const char *mode)
 OCPersistentStorage ps = {server_fopen, fread, fwrite, fclose, unlink};
 
 OCFFramework::OCFFramework() :
+    m_workerThreadWakeRequested(false),
+    m_requestAccessStopping(false),
     m_isStarted(false),
     m_isStopping(false)
 {
@@ -353,7 +372,8 @@ IPCAStatus OCFFramework::Start(const IPCAAppInfoInternal& appInfo, bool isUnitTe
         }
     }
 
-    // Start the worker thread that performs periodic check on device status.
+    // Start the worker thread that checks device status.
+    m_workerThreadWakeRequested = false;
     m_workerThread = std::thread(&OCFFramework::WorkerThread, this);
     m_isStarted = true;
     return IPCA_OK;
@@ -380,7 +400,7 @@ IPCAStatus OCFFramework::Stop(InputPinCallbackHandle passwordInputCallbackHandle
 
     m_isStopping = true;
 
-    m_workerThreadCV.notify_all();
+    WakeWorkerThread();
     if (m_workerThread.joinable())
     {
         m_workerThread.join();
@@ -405,57 +425,76 @@ IPCAStatus OCFFramework::Stop(InputPinCallbackHandle passwordInputCallbackHandle
 
 void OCFFramework::WorkerThread(OCFFramework* ocfFramework)
 {
-    std::unique_lock<std::mutex> workerThreadLock(ocfFramework->m_workerThreadMutex);
-
-    const size_t WorkerThreadSleepTimeSeconds = 2;
-    std::chrono::seconds workerThreadSleepTime(WorkerThreadSleepTimeSeconds);
+    const uint64_t AllowedTimeSinceLastCloseMs = 300000;
+    const uint64_t AllowedTimeSinceLastDiscoveryResponseMs = 60000;
+    const uint64_t CommonResourcesRetryPeriodMs = 2000;
+    const uint64_t NoDeadline = UINT64_MAX;
 
     while (false == ocfFramework->m_isStopping)
     {
         uint64_t currentTime = OICGetCurrentTime(TIME_IN_MS);
+        uint64_t nextDeadline = NoDeadline;
         std::vector<DeviceDetails::Ptr> devicesThatAreNotResponding;
         std::vector<DeviceDetails::Ptr> devicesThatAreNotOpened;
         std::vector<DeviceDetails::Ptr> devicesToGetCommonResources;
 
         // Collect devices that are not used, i.e. discovered a while back and those that are not
-        // used by app for a while.
+        // used by app for a while.  For the others, note when they need attention next.
         {
             std::lock_guard<std::recursive_mutex> lock(ocfFramework->m_OCFFrameworkMutex);
-            const unsigned int AllowedTimeSincLastCloseMs = 300000;
-            const unsigned int AllowedTimeSinceLastDiscoveryResponseMs = 60000;
 
             // Walk through each device.
             for (auto const& device : ocfFramework->m_OCFDevices)
             {
                 // Is device opened by app?
-                if ((device.second->deviceOpenCount == 0) &&
-                    (currentTime - device.second->lastCloseDeviceTime > AllowedTimeSincLastCloseMs))
+                if (device.second->deviceOpenCount == 0)
                 {
-                    devicesThatAreNotOpened.push_back(device.second);
-                    continue;  // device details is about to be deleted.
+                    uint64_t expiryTime =
+                        device.second->lastCloseDeviceTime + AllowedTimeSinceLastCloseMs;
+                    if (currentTime > expiryTime)
+                    {
+                        devicesThatAreNotOpened.push_back(device.second);
+                        continue;  // device details is about to be deleted.
+                    }
+
+                    nextDeadline = std::min(nextDeadline, expiryTime);
                 }
 
                 // Has device responded to Discovery?
-                if ((device.second->deviceNotRespondingIndicated == false) &&
-                    (currentTime - device.second->lastResponseTimeToDiscovery > AllowedTimeSinceLastDiscoveryResponseMs))
+                if (device.second->deviceNotRespondingIndicated == false)
                 {
-                    device.second->deviceNotRespondingIndicated = true;
-                    devicesThatAreNotResponding.push_back(device.second);
+                    uint64_t expiryTime = device.second->lastResponseTimeToDiscovery +
+                                          AllowedTimeSinceLastDiscoveryResponseMs;
+                    if (currentTime > expiryTime)
+                    {
+                        device.second->deviceNotRespondingIndicated = true;
+                        devicesThatAreNotResponding.push_back(device.second);
+                    }
+                    else
+                    {
+                        nextDeadline = std::min(nextDeadline, expiryTime);
+                    }
                 }
 
                 // Are there common resources that are not yet obtained.
-                if (!device.second->deviceInfoAvailable ||
-                    !device.second->platformInfoAvailable ||
-                    !device.second->maintenanceResourceAvailable)
+                if (IsCommonResourceRequestPending(device.second))
                 {
-                     devicesToGetCommonResources.push_back(device.second);
+                    uint64_t retryTime = device.second->lastCommonResourcesRequestTime +
+                                         CommonResourcesRetryPeriodMs;
+                    if (currentTime >= retryTime)
+                    {
+                        devicesToGetCommonResources.push_back(device.second);
+                        retryTime = currentTime + CommonResourcesRetryPeriodMs;
+                    }
+
+                    nextDeadline = std::min(nextDeadline, retryTime);
                 }
             }
 
             // Erase unopened devices from the m_OCFDevices.
             for (auto& device : devicesThatAreNotOpened)
             {
-                for (auto const& deviceUri : ocfFramework->m_OCFDevices[device->deviceId]->deviceUris)
+                for (auto const& deviceUri : device->deviceUris)
                 {
                     ocfFramework->m_OCFDevicesIndexedByDeviceURI.erase(deviceUri);
                 }
@@ -497,13 +536,41 @@ void OCFFramework::WorkerThread(OCFFramework* ocfFramework)
             }
         }
 
-        ocfFramework->m_workerThreadCV.wait_for(
-                            workerThreadLock,
-                            workerThreadSleepTime,
-                            [ocfFramework]() { return ocfFramework->m_isStopping; });
+        // Sleep until the earliest deadline.  The lock is only held while waiting so that
+        // WakeWorkerThread() never blocks behind the work above.
+        std::unique_lock<std::mutex> workerThreadLock(ocfFramework->m_workerThreadMutex);
+        auto isWakeUpNeeded = [ocfFramework]()
+                                {
+                                    return ocfFramework->m_isStopping ||
+                                           ocfFramework->m_workerThreadWakeRequested;
+                                };
+
+        if (nextDeadline == NoDeadline)
+        {
+            ocfFramework->m_workerThreadCV.wait(workerThreadLock, isWakeUpNeeded);
+        }
+        else
+        {
+            currentTime = OICGetCurrentTime(TIME_IN_MS);
+            uint64_t sleepTimeMs = (nextDeadline > currentTime) ? (nextDeadline - currentTime) : 0;
+            ocfFramework->m_workerThreadCV.wait_for(workerThreadLock,
+                                                    std::chrono::milliseconds(sleepTimeMs),
+                                                    isWakeUpNeeded);
+        }
+
+        ocfFramework->m_workerThreadWakeRequested = false;
     }
 }
 
+void OCFFramework::WakeWorkerThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_workerThreadMutex);
+        m_workerThreadWakeRequested = true;
+    }
+
+    m_workerThreadCV.notify_all();
+}
 
 IPCAStatus OCFFramework::IPCADeviceOpenCalled(std::string& deviceId)
 {
@@ -531,15 +598,24 @@ IPCAStatus OCFFramework::IPCADeviceCloseCalled(std::string& deviceId)
         return IPCA_DEVICE_NOT_DISCOVERED;
     }
 
+    bool lastClose = false;
     {
         std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
         if (--deviceDetails->deviceOpenCount == 0)
         {
             deviceDetails->lastCloseDeviceTime = OICGetCurrentTime(TIME_IN_MS);
+            lastClose = true;
         }
     }
 
     assert(deviceDetails->deviceOpenCount >= 0);
+
+    // The device now has an expiry time, let the worker thread schedule it.
+    if (lastClose)
+    {
+        WakeWorkerThread();
+    }
+
     return IPCA_OK;
 }
 
@@ -566,6 +642,7 @@ void OCFFramework::UnregisterAppCallbackObject(Callback::Ptr cb)
 void OCFFramework::OnResourceFound(std::shared_ptr<OCResource> resource)
 {
     bool newDevice = false; // set to true if the resource is from new device.
+    bool deviceRespondingAgain = false; // set to true if device was indicated not responding.
     bool updatedDeviceInformation = false; // set to true when device information is updated
                                            // (e.g. new resource, new resource type, etc.)
 
@@ -597,6 +674,7 @@ void OCFFramework::OnResourceFound(std::shared_ptr<OCResource> resource)
             deviceDetails->platformInfoAvailable = false; // set to true in OnPlatformInfoCallback()
             deviceDetails->maintenanceResourceRequestCount = 0;
             deviceDetails->maintenanceResourceAvailable = false;
+            deviceDetails->lastCommonResourcesRequestTime = 0;
             deviceDetails->securityInfoAvailable = false; // set to true in
                                                           // RequestAccessWorkerThread()
             deviceDetails->securityInfo.isStarted = false; // set to true in RequestAccess()
@@ -620,6 +698,7 @@ void OCFFramework::OnResourceFound(std::shared_ptr<OCResource> resource)
         deviceDetails = m_OCFDevices[resource->sid()];
 
         // Device is discovered.
+        deviceRespondingAgain = deviceDetails->deviceNotRespondingIndicated;
         deviceDetails->deviceNotRespondingIndicated = false;
         deviceDetails->lastResponseTimeToDiscovery = OICGetCurrentTime(TIME_IN_MS);
 
@@ -665,6 +744,12 @@ void OCFFramework::OnResourceFound(std::shared_ptr<OCResource> resource)
         GetCommonResources(deviceDetails);
     }
 
+    // Let the worker thread schedule expiry and retries for the device.
+    if (newDevice || deviceRespondingAgain)
+    {
+        WakeWorkerThread();
+    }
+
     // Inform apps. If new device, the device info may come in subsequent discovery callbacks with
     // IPCA_DEVICE_UPDATED_INFO status.
 
@@ -889,13 +974,13 @@ void OCFFramework::OnPlatformInfoCallback(const OCRepresentation& rep)
 
 IPCAStatus OCFFramework::GetCommonResources(DeviceDetails::Ptr deviceDetails)
 {
-    const size_t MAX_REQUEST_COUNT = 3;
-
     OCStackResult result;
 
+    deviceDetails->lastCommonResourcesRequestTime = OICGetCurrentTime(TIME_IN_MS);
+
     // Get platform info if device hasn't responded to earlier request.
     if ((deviceDetails->platformInfoAvailable == false) &&
-        (deviceDetails->platformInfoRequestCount < MAX_REQUEST_COUNT))
+        (deviceDetails->platformInfoRequestCount < c_maxCommonResourceRequestCount))
     {
         // Use host address of oic/p if the resource is returned by oic/res.
         std::string platformResourcePath(OC_RSRVD_PLATFORM_URI);
@@ -920,7 +1005,7 @@ IPCAStatus OCFFramework::GetCommonResources(DeviceDetails::Ptr deviceDetails)
 
     // Get device info.
     if ((deviceDetails->deviceInfoAvailable == false) &&
-        (deviceDetails->deviceInfoRequestCount < MAX_REQUEST_COUNT))
+        (deviceDetails->deviceInfoRequestCount < c_maxCommonResourceRequestCount))
     {
         // Use host address of oic/d if the resource is returned by oic/res.
         std::string deviceResourcePath(OC_RSRVD_DEVICE_URI);
@@ -947,7 +1032,7 @@ IPCAStatus OCFFramework::GetCommonResources(DeviceDetails::Ptr deviceDetails)
 
     // Get maintenance resource.
     if ((deviceDetails->maintenanceResourceAvailable == false) &&
-        (deviceDetails->maintenanceResourceRequestCount < MAX_REQUEST_COUNT))
+        (deviceDetails->maintenanceResourceRequestCount < c_maxCommonResourceRequestCount))
     {
         std::ostringstream deviceUri;
         OCConnectivityType connectivityType = CT_DEFAULT;
@@ -1191,7 +1276,15 @@ IPCAStatus OCFFramework::SendCommandToDevice(std::string& deviceId,
 
     if (result == OC_STACK_OK)
     {
-        callbackInfo->requestSentTimestamp = OICGetCurrentTime(TIME_IN_MS);
+        if (callbackInfo->app != nullptr)
+        {
+            callbackInfo->app->RequestSent(callbackInfo);
+        }
+        else
+        {
+            callbackInfo->requestSentTimestamp = OICGetCurrentTime(TIME_IN_MS);
+        }
+
         return IPCA_OK;
     }
     else
@@ -1676,7 +1769,7 @@ IPCAStatus OCFFramework::RequestAccess(std::string& deviceId,
         return status;
     }
 
-    // Construct context for the worker thread
+    // Construct context for the RequestAccess pool
     requestAccessContext = static_cast<RequestAccessContext*>
                                 (OICCalloc(1, sizeof(RequestAccessContext)));
     if (nullptr != requestAccessContext)
@@ -1691,19 +1784,65 @@ IPCAStatus OCFFramework::RequestAccess(std::string& deviceId,
         return IPCA_OUT_OF_MEMORY;
     }
 
+    std::lock_guard<std::mutex> queueLock(m_requestAccessQueueMutex);
+
+    // Stop() may have drained the pool since the check above.
+    if (m_isStopping || m_requestAccessStopping)
+    {
+        deviceDetails->securityInfo.isStarted = false;
+        requestAccessContext->callbackInfo = nullptr;
+        requestAccessContext->passwordInputCallbackInfo = nullptr;
+        OICFree(static_cast<void*>(requestAccessContext));
+        return IPCA_FAIL;
+    }
+
     // Add the context information to the list of contexts so we can clean it up later
     {
         std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
         m_OCFRequestAccessContexts[deviceId] = requestAccessContext;
     }
 
-    // Create a new thread to handle the RequestAccess request
-    deviceDetails->securityInfo.requestAccessThread =
-                std::thread(&OCFFramework::RequestAccessWorkerThread, requestAccessContext);
+    // Queue the request for the RequestAccess pool, growing the pool up to its limit.
+    m_requestAccessQueue.push_back(requestAccessContext);
+    if (m_requestAccessThreads.size() < c_maxRequestAccessThreads)
+    {
+        m_requestAccessThreads.push_back(
+                std::thread(&OCFFramework::RequestAccessPoolThread, this));
+    }
 
+    m_requestAccessQueueCV.notify_one();
     return status;
 }
 
+void OCFFramework::RequestAccessPoolThread(OCFFramework* ocfFramework)
+{
+    std::unique_lock<std::mutex> lock(ocfFramework->m_requestAccessQueueMutex);
+
+    while (true)
+    {
+        ocfFramework->m_requestAccessQueueCV.wait(lock,
+                            [ocfFramework]()
+                            {
+                                return ocfFramework->m_requestAccessStopping ||
+                                       !ocfFramework->m_requestAccessQueue.empty();
+                            });
+
+        // Queued requests are still processed when stopping so that each of them calls back
+        // to the app.  They fail quickly as m_requestAccessStopping is set.
+        if (ocfFramework->m_requestAccessQueue.empty())
+        {
+            break;
+        }
+
+        RequestAccessContext* requestContext = ocfFramework->m_requestAccessQueue.front();
+        ocfFramework->m_requestAccessQueue.pop_front();
+
+        lock.unlock();
+        RequestAccessWorkerThread(requestContext);
+        lock.lock();
+    }
+}
+
 void OCFFramework::RequestAccessWorkerThread(RequestAccessContext* requestContext)
 {
 #ifndef MULTIPLE_OWNER
@@ -1721,7 +1860,7 @@ void OCFFramework::RequestAccessWorkerThread(RequestAccessContext* requestContex
     OicUuid_t uuid;
 
     // Check to make sure the OCFFramework is not shutting down before we start this request
-    if (ocfFramework->m_isStopping)
+    if (ocfFramework->m_isStopping || ocfFramework->m_requestAccessStopping)
     {
         status = IPCA_FAIL;
     }
@@ -2028,17 +2167,37 @@ void OCFFramework::CleanupRequestAccessDevices()
         }
     }
 
-    // If a RequestAccess operation is still in progress for a device wait for it to finish.
-    // Once the operation is complete cleanup the RequestAccess context for the operation.
+    // If a RequestAccess operation is still in progress for a device wake it up, then wait for
+    // the pool to finish the in progress and queued operations.
     for (auto const& device : requestAccessDevices)
     {
         device->securityInfo.requestAccessThreadCV.notify_all();
+    }
 
-        if (device->securityInfo.requestAccessThread.joinable())
+    std::vector<std::thread> requestAccessThreads;
+    {
+        std::lock_guard<std::mutex> lock(m_requestAccessQueueMutex);
+        m_requestAccessStopping = true;
+        requestAccessThreads.swap(m_requestAccessThreads);
+        m_requestAccessQueueCV.notify_all();
+    }
+
+    for (auto& thread : requestAccessThreads)
+    {
+        if (thread.joinable())
         {
-            device->securityInfo.requestAccessThread.join();
+            thread.join();
         }
+    }
 
+    {
+        std::lock_guard<std::mutex> lock(m_requestAccessQueueMutex);
+        m_requestAccessStopping = false;
+    }
+
+    // Once the operations are complete cleanup the RequestAccess context for each of them.
+    for (auto const& device : requestAccessDevices)
+    {
         auto context = m_OCFRequestAccessContexts.find(device->deviceId);
         if (context != m_OCFRequestAccessContexts.end())
         {
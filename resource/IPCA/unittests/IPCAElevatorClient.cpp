@@ -374,6 +374,7 @@ bool IPCAElevatorClient::SetUnknoownInterface()
 void IPCAElevatorClient::SetUp()
 {
     m_elevator1Discovered = false;
+    m_discoveryLatencyMs = -1;
     m_discoveredElevator1DeviceId.clear();
     m_discoveredElevator1DeviceName.clear();
 
@@ -600,6 +601,12 @@ void IPCAElevatorClient::DiscoverElevator1Callback(
 
     if (g_elevator1Name.compare(discoveredDeviceInfo->deviceName) == 0)
     {
+        if (m_discoveryLatencyMs < 0)
+        {
+            m_discoveryLatencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - m_discoveryStartTime).count();
+        }
+
         m_discoveredElevator1DeviceUris.clear();
         for (size_t i = 0; i < discoveredDeviceInfo->deviceUriCount; i++)
         {
@@ -636,6 +643,7 @@ void IPCAElevatorClient::DiscoverElevator1()
    const int ResourceTypeCount = sizeof(RequiredResourceTypes) / sizeof(char*);
 
    // Start discovery.
+   m_discoveryStartTime = std::chrono::steady_clock::now();
    IPCAStatus status = IPCADiscoverDevices(
                                m_ipcaAppHandle,
                                &C_DiscoverElevator1Cb,
@@ -28,6 +28,7 @@ class IPCAElevatorClient : public testing::Test
 public:
     // Discovery functionalities
     bool IsElevator1Discovered() { return m_elevator1Discovered; }
+    int64_t GetDiscoveryLatencyMs() { return m_discoveryLatencyMs; }
     IPCAStatus ConfirmDeviceAndPlatformInfo();
     IPCAStatus ConfirmResources();
     IPCAStatus ConfirmResourceTypes();
@@ -118,6 +119,8 @@ private:
     std::string m_discoveredElevator1DeviceName;
     std::string m_discoveredElevator1DeviceId;
     std::vector<std::string> m_discoveredElevator1DeviceUris;
+    std::chrono::steady_clock::time_point m_discoveryStartTime;
+    int64_t m_discoveryLatencyMs;   // IPCADiscoverDevices() to first callback with device name.
     std::mutex m_deviceDiscoveredCVMutex;
     std::condition_variable m_deviceDiscoveredCV;  // conditional variable to wake up thread waiting
                                                    // for device discovered callback.
@@ -497,6 +497,16 @@ TEST_F(IPCAElevatorClient, DiscoveryShouldFindElevatorServer)
     EXPECT_TRUE(IsElevator1Discovered());
 }
 
+TEST_F(IPCAElevatorClient, DiscoveryCallbackShouldNotWaitForWorkerThreads)
+{
+    // Device info is requested as soon as the device is found, not from a periodic wake up
+    // of the framework worker thread. The bound is generous so that a busy host passes too.
+    const int64_t MaxDiscoveryLatencyMs = 5000;
+
+    ASSERT_LE(0, GetDiscoveryLatencyMs());
+    EXPECT_GT(MaxDiscoveryLatencyMs, GetDiscoveryLatencyMs());
+}
+
 TEST_F(IPCAElevatorClient, DiscoveryShouldFindDeviceAndPlatformInfo)
 {
     EXPECT_EQ(IPCA_OK, ConfirmDeviceAndPlatformInfo());
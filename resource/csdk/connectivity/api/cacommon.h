@@ -531,6 +531,11 @@ typedef struct
     CAURI_t resourceUri;        /**< Resource URI information **/
     CARemoteId_t identity;      /**< endpoint identity */
     CADataType_t dataType;      /**< data type */
+    struct oc_refcounter_t *buffer; /**< received data which token, options, payload and
+                                         resourceUri point into instead of being allocated,
+                                         NULL if they are allocated. They may be replaced,
+                                         but neither freed nor reallocated, while they
+                                         point into it */
 } CAInfo_t;
 
 /**
@@ -231,6 +231,31 @@ CATransportAdapter_t CAGetSelectedNetwork(void);
  */
 CAResult_t CAHandleRequestResponse(void);
 
+/**
+ * Get a descriptor readable while CAHandleRequestResponse has received data to handle.
+ * CAHandleRequestResponse clears it, it must not be read from or closed.
+ * It is valid until CATerminate.
+ * @param[out]   fd      descriptor to poll for reading.
+ * @return   ::CA_STATUS_OK, ::CA_NOT_SUPPORTED if the platform has no such descriptor,
+ *           ::CA_STATUS_INVALID_PARAM or ::CA_STATUS_NOT_INITIALIZED
+ */
+CAResult_t CAGetWakeupFd(int *fd);
+
+/**
+ * Wait until CAHandleRequestResponse has received data to handle or CASignalWakeup
+ * is called. Unlike other functions, it can be called while another thread uses CA.
+ * @param[in]    timeoutMs   maximum time to wait in milliseconds.
+ * @return   ::CA_STATUS_OK or ::CA_STATUS_NOT_INITIALIZED
+ */
+CAResult_t CAWaitForWakeup(uint32_t timeoutMs);
+
+/**
+ * Make CAWaitForWakeup return and the descriptor of CAGetWakeupFd readable,
+ * until CAHandleRequestResponse is called. It can be called from any thread.
+ * @return   ::CA_STATUS_OK or ::CA_STATUS_NOT_INITIALIZED
+ */
+CAResult_t CASignalWakeup(void);
+
 #ifdef RA_ADAPTER
 /**
  * Set Remote Access information for XMPP Client.
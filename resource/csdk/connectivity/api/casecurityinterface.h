@@ -238,6 +238,13 @@ typedef void (*CAgetPkixInfoHandler)(PkiInfo_t * inf);
  */
 CAResult_t CAregisterPkixInfoHandler(CAgetPkixInfoHandler getPkixInfoHandler);
 
+/**
+ * Discard the PKIX info parsed for earlier handshakes.
+ * The next certificate based handshake fetches it again through the PKIX info callback.
+ * Must be called whenever the info returned by that callback changes.
+ */
+void CAresetPkixInfoCache(void);
+
 /**
  * Select the cipher suite for dtls handshake.
  *
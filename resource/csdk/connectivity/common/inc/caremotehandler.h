@@ -57,6 +57,28 @@ CAEndpoint_t *CACreateEndpointObject(CATransportFlags_t flags, CATransportAdapte
  */
 void CAFreeEndpoint(CAEndpoint_t *rep);
 
+/**
+ * Received pdu which the token, options, payload and resourceUri of a CAInfo_t
+ * point into when it is parsed without copies, held by CAInfo_t::buffer.
+ * The options and the uri are rebuilt in the storage following the structure.
+ */
+typedef struct
+{
+    void *pdu;                  /**< received coap_pdu_t, deleted with the buffer */
+    const uint8_t *pduData;     /**< bytes of the pdu */
+    size_t pduLength;           /**< number of bytes of the pdu */
+    size_t storageLength;       /**< number of bytes following the structure */
+} CAInfoBuffer_t;
+
+/**
+ * Whether a field of the given info points into its buffer, in which case it
+ * is released with the buffer instead of being freed.
+ * @param[in]   info    info object holding the field.
+ * @param[in]   field   value of the field.
+ * @return      true if the field points into the buffer of the info.
+ */
+bool CAIsInInfoBuffer(const CAInfo_t *info, const void *field);
+
 /**
  * duplicates the given info.
  * @param[in]   info    info object to be duplicated.
@@ -0,0 +1,174 @@
+/* ****************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef U_HASHMAP_H_
+#define U_HASHMAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Initial value of a hash computed with u_hashmap_hash().
+ */
+#define U_HASHMAP_HASH_INIT 2166136261u
+
+/**
+ * Returns the structure an entry is embedded in.
+ * @param[in] entry        pointer of the entry.
+ * @param[in] type         type of the structure.
+ * @param[in] member       name of the entry in the structure.
+ */
+#define U_HASHMAP_CONTAINER(entry, type, member) \
+    ((type *)((char *)(entry) - offsetof(type, member)))
+
+/**
+ * hash map entry, embedded in the structures stored in a hash map, which
+ * allocates nothing for them.
+ *
+ * @note
+ * Members should be treated as private and not accessed directly.
+ */
+typedef struct u_hashmap_entry_t
+{
+    struct u_hashmap_entry_t *next;
+    uint32_t hash;
+} u_hashmap_entry_t;
+
+/**
+ * Callback telling whether an entry has a key.
+ * @param[in] entry        entry with the hash of the key.
+ * @param[in] key          key given to the lookup function.
+ * @return true if the entry has the key, false otherwise.
+ */
+typedef bool (*u_hashmap_match_t)(const u_hashmap_entry_t *entry, const void *key);
+
+/**
+ * hash map structure. Entries are chained in buckets, whose number doubles
+ * when there are more entries than buckets. Several entries may have the
+ * same key.
+ *
+ * @note
+ * Members should be treated as private and not accessed directly. Instead
+ * all access should be through the defined u_hashmap_*() functions.
+ */
+typedef struct u_hashmap_t
+{
+    u_hashmap_entry_t **buckets;
+    size_t capacity;
+    size_t length;
+} u_hashmap_t;
+
+/**
+ * API to create a hash map.
+ * @return  u_hashmap_t if Success, NULL otherwise.
+ */
+u_hashmap_t *u_hashmap_create(void);
+
+/**
+ * Deletes the hash map. The entries are not freed, calling function must
+ * take care of the structures they are embedded in.
+ * @param[in] map        u_hashmap pointer
+ */
+void u_hashmap_free(u_hashmap_t **map);
+
+/**
+ * Add an entry in the hash map. The entry must not be in a hash map.
+ * @param[in] map        pointer of hash map.
+ * @param[in] entry      entry to add.
+ * @param[in] hash       hash of the key of the entry.
+ * @return true if success, false otherwise.
+ */
+bool u_hashmap_add(u_hashmap_t *map, u_hashmap_entry_t *entry, uint32_t hash);
+
+/**
+ * Returns an entry with a key.
+ * @param[in] map        pointer of hash map.
+ * @param[in] hash       hash of the key.
+ * @param[in] key        key, given to the match callback.
+ * @param[in] match      callback comparing the key of an entry with the key.
+ * @return the entry if found, NULL otherwise.
+ */
+u_hashmap_entry_t *u_hashmap_find(const u_hashmap_t *map, uint32_t hash,
+                                  const void *key, u_hashmap_match_t match);
+
+/**
+ * Returns the entry following an entry with the same key.
+ * @param[in] map        pointer of hash map.
+ * @param[in] entry      entry returned by u_hashmap_find() or this function.
+ * @param[in] key        key, given to the match callback.
+ * @param[in] match      callback comparing the key of an entry with the key.
+ * @return the next entry if found, NULL otherwise.
+ */
+u_hashmap_entry_t *u_hashmap_find_next(const u_hashmap_t *map, const u_hashmap_entry_t *entry,
+                                       const void *key, u_hashmap_match_t match);
+
+/**
+ * Remove an entry from the hash map.
+ * @param[in] map        pointer of hash map.
+ * @param[in] entry      entry to remove.
+ * @return true if the entry was in the hash map, false otherwise.
+ */
+bool u_hashmap_remove(u_hashmap_t *map, u_hashmap_entry_t *entry);
+
+/**
+ * Iterates over the entries of the hash map. The entry returned may be
+ * removed, but not freed, before getting the next one. No entry may be added.
+ * @param[in] map        pointer of hash map.
+ * @param[in] entry      previous entry, NULL to get the first one.
+ * @return the next entry, NULL if there is none.
+ */
+u_hashmap_entry_t *u_hashmap_next(const u_hashmap_t *map, const u_hashmap_entry_t *entry);
+
+/**
+ * Returns the number of entries in the hash map.
+ * @param[in] map        pointer of hash map.
+ * @return number of entries.
+ */
+size_t u_hashmap_length(const u_hashmap_t *map);
+
+/**
+ * Hashes data with FNV-1a. Hashes of several keys are combined by passing
+ * the result as hash of the next call.
+ * @param[in] hash       U_HASHMAP_HASH_INIT, or the hash of the previous keys.
+ * @param[in] data       data to hash.
+ * @param[in] length     length of the data.
+ * @return the hash.
+ */
+uint32_t u_hashmap_hash(uint32_t hash, const void *data, size_t length);
+
+/**
+ * Hashes a string ignoring case, see u_hashmap_hash().
+ * @param[in] hash       U_HASHMAP_HASH_INIT, or the hash of the previous keys.
+ * @param[in] string     string to hash.
+ * @return the hash.
+ */
+uint32_t u_hashmap_hash_nocase(uint32_t hash, const char *string);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* U_HASHMAP_H_ */
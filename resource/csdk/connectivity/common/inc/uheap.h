@@ -0,0 +1,149 @@
+/* ****************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef U_HEAP_H_
+#define U_HEAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Returns the structure an entry is embedded in.
+ * @param[in] entry        pointer of the entry.
+ * @param[in] type         type of the structure.
+ * @param[in] member       name of the entry in the structure.
+ */
+#define U_HEAP_CONTAINER(entry, type, member) \
+    ((type *)((char *)(entry) - offsetof(type, member)))
+
+/**
+ * heap entry, embedded in the structures stored in a heap. It holds the
+ * position of the structure in the heap, so that it is removed or moved
+ * after a change of its key without searching for it.
+ *
+ * @note
+ * Members should be treated as private and not accessed directly.
+ */
+typedef struct u_heap_entry_t
+{
+    size_t index;
+} u_heap_entry_t;
+
+/**
+ * Callback ordering the entries of a heap.
+ * @param[in] first        first entry.
+ * @param[in] second       second entry.
+ * @return true if the first entry comes before the second one.
+ */
+typedef bool (*u_heap_less_t)(const u_heap_entry_t *first, const u_heap_entry_t *second);
+
+/**
+ * binary min-heap structure, such as a list of timeouts ordered by expiry.
+ *
+ * @note
+ * Members should be treated as private and not accessed directly. Instead
+ * all access should be through the defined u_heap_*() functions.
+ */
+typedef struct u_heap_t
+{
+    u_heap_entry_t **data;
+    size_t length;
+    size_t capacity;
+    u_heap_less_t less;
+} u_heap_t;
+
+/**
+ * API to create a heap.
+ * @param[in] less       callback ordering the entries.
+ * @return  u_heap_t if Success, NULL otherwise.
+ */
+u_heap_t *u_heap_create(u_heap_less_t less);
+
+/**
+ * Deletes the heap. The entries are not freed, calling function must take
+ * care of the structures they are embedded in.
+ * @param[in] heap       u_heap pointer
+ */
+void u_heap_free(u_heap_t **heap);
+
+/**
+ * Add an entry in the heap. The entry must not be in a heap.
+ * @param[in] heap       pointer of heap.
+ * @param[in] entry      entry to add.
+ * @return true if success, false otherwise.
+ */
+bool u_heap_push(u_heap_t *heap, u_heap_entry_t *entry);
+
+/**
+ * Returns the first entry of the heap, without removing it.
+ * @param[in] heap       pointer of heap.
+ * @return the first entry, NULL if the heap is empty.
+ */
+u_heap_entry_t *u_heap_top(const u_heap_t *heap);
+
+/**
+ * Removes the first entry of the heap.
+ * @param[in] heap       pointer of heap.
+ * @return the removed entry, NULL if the heap is empty.
+ */
+u_heap_entry_t *u_heap_pop(u_heap_t *heap);
+
+/**
+ * Remove an entry from the heap.
+ * @param[in] heap       pointer of heap.
+ * @param[in] entry      entry to remove.
+ * @return true if the entry was in the heap, false otherwise.
+ */
+bool u_heap_remove(u_heap_t *heap, u_heap_entry_t *entry);
+
+/**
+ * Moves an entry whose key changed to its new position.
+ * @param[in] heap       pointer of heap.
+ * @param[in] entry      entry in the heap.
+ * @return true if the entry is in the heap, false otherwise.
+ */
+bool u_heap_update(u_heap_t *heap, u_heap_entry_t *entry);
+
+/**
+ * Returns whether an entry is in the heap.
+ * @param[in] heap       pointer of heap.
+ * @param[in] entry      entry to look for, zeroed if it was never added.
+ * @return true if the entry is in the heap, false otherwise.
+ */
+bool u_heap_contains(const u_heap_t *heap, const u_heap_entry_t *entry);
+
+/**
+ * Returns the number of entries in the heap.
+ * @param[in] heap       pointer of heap.
+ * @return number of entries.
+ */
+size_t u_heap_length(const u_heap_t *heap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* U_HEAP_H_ */
@@ -22,6 +22,7 @@
 
 #include "oic_malloc.h"
 #include "oic_string.h"
+#include "oc_refcounter.h"
 #include "caremotehandler.h"
 #include "experimental/logger.h"
 
@@ -223,26 +224,52 @@ void CAFreeEndpoint(CAEndpoint_t *rep)
     OICFree(rep);
 }
 
+bool CAIsInInfoBuffer(const CAInfo_t *info, const void *field)
+{
+    if (!info || !info->buffer || !field)
+    {
+        return false;
+    }
+
+    const CAInfoBuffer_t *buffer = (const CAInfoBuffer_t *) oc_refcounter_get_data(info->buffer);
+    const uint8_t *ptr = (const uint8_t *) field;
+    const uint8_t *storage = (const uint8_t *) (buffer + 1);
+    return (ptr >= buffer->pduData && ptr < buffer->pduData + buffer->pduLength) ||
+           (ptr >= storage && ptr < storage + buffer->storageLength);
+}
+
+static void CAFreeInfoField(const CAInfo_t *info, void *field)
+{
+    if (!CAIsInInfoBuffer(info, field))
+    {
+        OICFree(field);
+    }
+}
+
 static void CADestroyInfoInternal(CAInfo_t *info)
 {
     // free token field
-    OICFree(info->token);
+    CAFreeInfoField(info, info->token);
     info->token = NULL;
     info->tokenLength = 0;
 
     // free options field
-    OICFree(info->options);
+    CAFreeInfoField(info, info->options);
     info->options = NULL;
     info->numOptions = 0;
 
     // free payload field
-    OICFree((char *) info->payload);
+    CAFreeInfoField(info, info->payload);
     info->payload = NULL;
     info->payloadSize = 0;
 
     // free uri
-    OICFree(info->resourceUri);
+    CAFreeInfoField(info, info->resourceUri);
     info->resourceUri = NULL;
+
+    // release the received data the fields pointed into
+    oc_refcounter_dec(info->buffer);
+    info->buffer = NULL;
 }
 
 void CADestroyRequestInfoInternal(CARequestInfo_t *rep)
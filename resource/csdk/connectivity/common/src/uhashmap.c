@@ -0,0 +1,237 @@
+/******************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <ctype.h>
+#include <stdlib.h>
+#include "uhashmap.h"
+#include "experimental/logger.h"
+#include "oic_malloc.h"
+
+#define TAG "OIC_UHASHMAP"
+
+/**
+ * Number of buckets when created, a power of two.
+ */
+#define U_HASHMAP_DEFAULT_CAPACITY 8
+
+#define U_HASHMAP_FNV_PRIME 16777619u
+
+static size_t u_hashmap_bucket(const u_hashmap_t *map, uint32_t hash)
+{
+    return hash & (map->capacity - 1);
+}
+
+/**
+ * Doubles the number of buckets. The map is left as is when out of memory,
+ * with longer chains.
+ */
+static void u_hashmap_grow(u_hashmap_t *map)
+{
+    size_t new_capacity = map->capacity * 2;
+    u_hashmap_entry_t **buckets =
+        (u_hashmap_entry_t **) OICCalloc(new_capacity, sizeof(map->buckets[0]));
+    if (!buckets)
+    {
+        OIC_LOG(DEBUG, TAG, "Memory allocation failed.");
+        return;
+    }
+
+    for (size_t i = 0; i < map->capacity; i++)
+    {
+        u_hashmap_entry_t *entry = map->buckets[i];
+        while (entry)
+        {
+            u_hashmap_entry_t *next = entry->next;
+            size_t bucket = entry->hash & (new_capacity - 1);
+            entry->next = buckets[bucket];
+            buckets[bucket] = entry;
+            entry = next;
+        }
+    }
+
+    OICFree(map->buckets);
+    map->buckets = buckets;
+    map->capacity = new_capacity;
+}
+
+u_hashmap_t *u_hashmap_create(void)
+{
+    u_hashmap_t *map = (u_hashmap_t *) OICCalloc(1, sizeof(u_hashmap_t));
+    if (!map)
+    {
+        OIC_LOG(DEBUG, TAG, "Out of memory");
+        return NULL;
+    }
+
+    map->capacity = U_HASHMAP_DEFAULT_CAPACITY;
+    map->buckets = (u_hashmap_entry_t **) OICCalloc(map->capacity, sizeof(map->buckets[0]));
+    if (!map->buckets)
+    {
+        OIC_LOG(DEBUG, TAG, "Out of memory");
+        OICFree(map);
+        return NULL;
+    }
+    return map;
+}
+
+void u_hashmap_free(u_hashmap_t **map)
+{
+    if (!map || !(*map))
+    {
+        return;
+    }
+
+    OICFree((*map)->buckets);
+    OICFree(*map);
+
+    *map = NULL;
+}
+
+bool u_hashmap_add(u_hashmap_t *map, u_hashmap_entry_t *entry, uint32_t hash)
+{
+    if (!map || !entry)
+    {
+        return false;
+    }
+
+    if (map->length >= map->capacity)
+    {
+        u_hashmap_grow(map);
+    }
+
+    size_t bucket = u_hashmap_bucket(map, hash);
+    entry->hash = hash;
+    entry->next = map->buckets[bucket];
+    map->buckets[bucket] = entry;
+    map->length++;
+    return true;
+}
+
+/**
+ * Returns the first entry with a key, starting from an entry of its bucket.
+ */
+static u_hashmap_entry_t *u_hashmap_match(u_hashmap_entry_t *entry, uint32_t hash,
+                                          const void *key, u_hashmap_match_t match)
+{
+    for (; entry; entry = entry->next)
+    {
+        if (entry->hash == hash && match(entry, key))
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+u_hashmap_entry_t *u_hashmap_find(const u_hashmap_t *map, uint32_t hash,
+                                  const void *key, u_hashmap_match_t match)
+{
+    if (!map || !match)
+    {
+        return NULL;
+    }
+
+    return u_hashmap_match(map->buckets[u_hashmap_bucket(map, hash)], hash, key, match);
+}
+
+u_hashmap_entry_t *u_hashmap_find_next(const u_hashmap_t *map, const u_hashmap_entry_t *entry,
+                                       const void *key, u_hashmap_match_t match)
+{
+    if (!map || !entry || !match)
+    {
+        return NULL;
+    }
+
+    return u_hashmap_match(entry->next, entry->hash, key, match);
+}
+
+bool u_hashmap_remove(u_hashmap_t *map, u_hashmap_entry_t *entry)
+{
+    if (!map || !entry)
+    {
+        return false;
+    }
+
+    u_hashmap_entry_t **link = &map->buckets[u_hashmap_bucket(map, entry->hash)];
+    for (; *link; link = &(*link)->next)
+    {
+        if (*link == entry)
+        {
+            // The entry keeps its next one, for u_hashmap_next().
+            *link = entry->next;
+            map->length--;
+            return true;
+        }
+    }
+    return false;
+}
+
+u_hashmap_entry_t *u_hashmap_next(const u_hashmap_t *map, const u_hashmap_entry_t *entry)
+{
+    if (!map)
+    {
+        return NULL;
+    }
+
+    size_t bucket = 0;
+    if (entry)
+    {
+        if (entry->next)
+        {
+            return entry->next;
+        }
+        bucket = u_hashmap_bucket(map, entry->hash) + 1;
+    }
+
+    for (; bucket < map->capacity; bucket++)
+    {
+        if (map->buckets[bucket])
+        {
+            return map->buckets[bucket];
+        }
+    }
+    return NULL;
+}
+
+size_t u_hashmap_length(const u_hashmap_t *map)
+{
+    return map ? map->length : 0;
+}
+
+uint32_t u_hashmap_hash(uint32_t hash, const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t *) data;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= bytes[i];
+        hash *= U_HASHMAP_FNV_PRIME;
+    }
+    return hash;
+}
+
+uint32_t u_hashmap_hash_nocase(uint32_t hash, const char *string)
+{
+    for (const char *c = string; c && *c; c++)
+    {
+        hash ^= (uint8_t) tolower((unsigned char) *c);
+        hash *= U_HASHMAP_FNV_PRIME;
+    }
+    return hash;
+}
@@ -0,0 +1,216 @@
+/******************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <stdlib.h>
+#include "uheap.h"
+#include "experimental/logger.h"
+#include "oic_malloc.h"
+
+#define TAG "OIC_UHEAP"
+
+/**
+ * Use this default capacity when initialized
+ */
+#define U_HEAP_DEFAULT_CAPACITY 8
+
+static void u_heap_set(u_heap_t *heap, size_t index, u_heap_entry_t *entry)
+{
+    heap->data[index] = entry;
+    entry->index = index;
+}
+
+/**
+ * Moves an entry towards the top until its parent comes before it.
+ * @return true if the entry moved.
+ */
+static bool u_heap_sift_up(u_heap_t *heap, size_t index)
+{
+    u_heap_entry_t *entry = heap->data[index];
+    size_t start = index;
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (!heap->less(entry, heap->data[parent]))
+        {
+            break;
+        }
+        u_heap_set(heap, index, heap->data[parent]);
+        index = parent;
+    }
+    u_heap_set(heap, index, entry);
+    return index != start;
+}
+
+/**
+ * Moves an entry towards the bottom until it comes before its children.
+ */
+static void u_heap_sift_down(u_heap_t *heap, size_t index)
+{
+    u_heap_entry_t *entry = heap->data[index];
+    for (;;)
+    {
+        size_t child = 2 * index + 1;
+        if (child >= heap->length)
+        {
+            break;
+        }
+        if (child + 1 < heap->length && heap->less(heap->data[child + 1], heap->data[child]))
+        {
+            child++;
+        }
+        if (!heap->less(heap->data[child], entry))
+        {
+            break;
+        }
+        u_heap_set(heap, index, heap->data[child]);
+        index = child;
+    }
+    u_heap_set(heap, index, entry);
+}
+
+/**
+ * Moves an entry up or down to its position.
+ */
+static void u_heap_fix(u_heap_t *heap, size_t index)
+{
+    if (!u_heap_sift_up(heap, index))
+    {
+        u_heap_sift_down(heap, index);
+    }
+}
+
+u_heap_t *u_heap_create(u_heap_less_t less)
+{
+    if (!less)
+    {
+        return NULL;
+    }
+
+    u_heap_t *heap = (u_heap_t *) OICCalloc(1, sizeof(u_heap_t));
+    if (!heap)
+    {
+        OIC_LOG(DEBUG, TAG, "Out of memory");
+        return NULL;
+    }
+
+    heap->capacity = U_HEAP_DEFAULT_CAPACITY;
+    heap->less = less;
+    heap->data = (u_heap_entry_t **) OICMalloc(heap->capacity * sizeof(heap->data[0]));
+    if (!heap->data)
+    {
+        OIC_LOG(DEBUG, TAG, "Out of memory");
+        OICFree(heap);
+        return NULL;
+    }
+    return heap;
+}
+
+void u_heap_free(u_heap_t **heap)
+{
+    if (!heap || !(*heap))
+    {
+        return;
+    }
+
+    OICFree((*heap)->data);
+    OICFree(*heap);
+
+    *heap = NULL;
+}
+
+bool u_heap_push(u_heap_t *heap, u_heap_entry_t *entry)
+{
+    if (!heap || !entry)
+    {
+        return false;
+    }
+
+    if (heap->capacity <= heap->length)
+    {
+        size_t new_capacity = heap->capacity * 2;
+        void *tmp = OICRealloc(heap->data, new_capacity * sizeof(heap->data[0]));
+        if (!tmp)
+        {
+            OIC_LOG(DEBUG, TAG, "Memory reallocation failed.");
+            return false;
+        }
+        heap->data = (u_heap_entry_t **) tmp;
+        heap->capacity = new_capacity;
+    }
+
+    u_heap_set(heap, heap->length, entry);
+    heap->length++;
+    u_heap_sift_up(heap, entry->index);
+    return true;
+}
+
+u_heap_entry_t *u_heap_top(const u_heap_t *heap)
+{
+    return (heap && heap->length) ? heap->data[0] : NULL;
+}
+
+u_heap_entry_t *u_heap_pop(u_heap_t *heap)
+{
+    u_heap_entry_t *top = u_heap_top(heap);
+    if (top)
+    {
+        u_heap_remove(heap, top);
+    }
+    return top;
+}
+
+bool u_heap_remove(u_heap_t *heap, u_heap_entry_t *entry)
+{
+    if (!u_heap_contains(heap, entry))
+    {
+        return false;
+    }
+
+    size_t index = entry->index;
+    heap->length--;
+    if (index < heap->length)
+    {
+        // The last entry takes the place of the removed one.
+        u_heap_set(heap, index, heap->data[heap->length]);
+        u_heap_fix(heap, index);
+    }
+    return true;
+}
+
+bool u_heap_update(u_heap_t *heap, u_heap_entry_t *entry)
+{
+    if (!u_heap_contains(heap, entry))
+    {
+        return false;
+    }
+
+    u_heap_fix(heap, entry->index);
+    return true;
+}
+
+bool u_heap_contains(const u_heap_t *heap, const u_heap_entry_t *entry)
+{
+    return heap && entry && entry->index < heap->length && heap->data[entry->index] == entry;
+}
+
+size_t u_heap_length(const u_heap_t *heap)
+{
+    return heap ? heap->length : 0;
+}
@@ -30,6 +30,7 @@
 #define CA_FRAGMENTATION_H_
 
 #include "cacommon.h"
+#include "uhashmap.h"
 #include "experimental/logger.h"
 
 /**
@@ -291,6 +292,184 @@ CAResult_t CAParseHeaderPayloadLength(uint8_t *header,
                                       size_t headerLength,
                                       uint32_t *dataLength);
 
+/**
+ * A segment of a fragmented message. It points to its headers, held by the
+ * segmenter, and to the part of the message it carries, neither is copied.
+ */
+typedef struct
+{
+    /** Data header, followed by the length header in the first segment. */
+    const uint8_t *header;
+
+    /** Length of the headers. */
+    uint32_t headerLength;
+
+    /** Part of the message carried by the segment. */
+    const uint8_t *data;
+
+    /** Length of the part of the message. */
+    uint32_t dataLength;
+} CABLESegment_t;
+
+/**
+ * State of the fragmentation of a message, see CAInitBLESegmenter().
+ */
+typedef struct
+{
+    /** Message to fragment. */
+    const uint8_t *data;
+
+    /** Length of the message. */
+    uint32_t dataLength;
+
+    /** Length of the message carried by the segments returned so far. */
+    uint32_t offset;
+
+    /** MTU size, the maximum length of a segment with its headers. */
+    uint16_t mtuSize;
+
+    /** Whether the first segment was returned. */
+    bool started;
+
+    /** Data and length headers of the first segment. */
+    uint8_t startHeader[CA_BLE_HEADER_SIZE + CA_BLE_LENGTH_HEADER_SIZE];
+
+    /** Data header of the other segments. */
+    uint8_t header[CA_BLE_HEADER_SIZE];
+} CABLESegmenter_t;
+
+/**
+ * This function is used to start the fragmentation of a message into
+ * segments of at most the MTU size, which are then returned in order by
+ * CAGetNextBLESegment(). The message must not change until its last
+ * segment is sent.
+ * @param[out]  segmenter      Fragmentation state to initialize.
+ * @param[in]   data           Message to fragment.
+ * @param[in]   dataLength     Length of the message.
+ * @param[in]   mtuSize        MTU size. It must be larger than the headers
+ *                             of the first segment and at most
+ *                             ::CA_SUPPORTED_BLE_MTU_SIZE.
+ * @param[in]   sourcePort     Source(own) port, see CAGenerateHeader().
+ * @param[in]   secure         Enum value to check whether secure or not.
+ * @param[in]   destPort       Destination(remote endpoint) port.
+ * @return ::CA_STATUS_OK on success. One of the CA_STATUS_FAILED
+ *           or other error values on error.
+ * @retval ::CA_STATUS_OK             Successful
+ * @retval ::CA_STATUS_INVALID_PARAM  Invalid input arguments
+ * @retval ::CA_STATUS_FAILED         Operation failed
+ */
+CAResult_t CAInitBLESegmenter(CABLESegmenter_t *segmenter,
+                              const uint8_t *data,
+                              uint32_t dataLength,
+                              uint16_t mtuSize,
+                              uint8_t sourcePort,
+                              CABLEPacketSecure_t secure,
+                              uint8_t destPort);
+
+/**
+ * This function is used to get the next segment of a message. The segment
+ * points into the message given to CAInitBLESegmenter() and into the
+ * segmenter, which must outlive it.
+ * @param[in,out] segmenter    Fragmentation state.
+ * @param[out]    segment      Next segment.
+ * @return true if a segment was returned, false if all of them were.
+ */
+bool CAGetNextBLESegment(CABLESegmenter_t *segmenter, CABLESegment_t *segment);
+
+/**
+ * This function is used to write a segment as it is sent, its headers
+ * followed by its part of the message.
+ * @param[in]   segment        Segment to write.
+ * @param[out]  buffer         Buffer receiving the segment.
+ * @param[in]   bufferLength   Length of the buffer.
+ * @return length of the written segment, 0 if the buffer is too small.
+ */
+uint32_t CACopyBLESegment(const CABLESegment_t *segment,
+                          uint8_t *buffer,
+                          uint32_t bufferLength);
+
+/**
+ * Stores the reassembly state of the message being received from a
+ * sender, identified by its address and port.
+ */
+typedef struct CABLESenderInfo
+{
+    /** Length of the message received so far. */
+    uint32_t recvDataLen;
+
+    /** Length of the whole message. */
+    uint32_t totalDataLen;
+
+    /** Buffer of totalDataLen bytes the message is reassembled into. */
+    uint8_t *defragData;
+
+    /** Sender of the message. */
+    CAEndpoint_t *remoteEndpoint;
+
+    /** Entry of the sender in its table, hashed by address. */
+    u_hashmap_entry_t entry;
+} CABLESenderInfo_t;
+
+/**
+ * Senders whose messages are being reassembled, hashed by address so that
+ * finding the sender of a segment does not depend on the number of peers.
+ * A zero initialized table is empty.
+ */
+typedef struct CABLESenderTable
+{
+    /** Senders, created with the first one. */
+    u_hashmap_t *senders;
+} CABLESenderTable_t;
+
+/**
+ * This function is used to find the sender of a received segment.
+ * @param[in]   table      Senders.
+ * @param[in]   address    Address of the sender, compared ignoring case.
+ * @param[in]   port       Port of the sender.
+ * @return the sender, or NULL if it is not in the table.
+ */
+CABLESenderInfo_t *CAGetBLESenderInfo(const CABLESenderTable_t *table,
+                                      const char *address,
+                                      uint16_t port);
+
+/**
+ * This function is used to add a sender, which is then owned by the table.
+ * @param[in,out] table    Senders.
+ * @param[in]     info     Sender with its remote endpoint set.
+ * @return ::CA_STATUS_OK on success, ::CA_STATUS_INVALID_PARAM on invalid
+ *           input arguments, ::CA_MEMORY_ALLOC_FAILED if out of memory.
+ */
+CAResult_t CAAddBLESenderInfo(CABLESenderTable_t *table, CABLESenderInfo_t *info);
+
+/**
+ * This function is used to remove a sender from the table, without
+ * destroying it.
+ * @param[in,out] table    Senders.
+ * @param[in]     info     Sender to remove.
+ */
+void CARemoveBLESenderInfo(CABLESenderTable_t *table, CABLESenderInfo_t *info);
+
+/**
+ * This function is used to destroy all the senders of an address, for
+ * instance when its device is disconnected.
+ * @param[in,out] table    Senders.
+ * @param[in]     address  Address of the senders, compared ignoring case.
+ */
+void CARemoveBLESendersOfAddress(CABLESenderTable_t *table, const char *address);
+
+/**
+ * This function is used to destroy all the senders of the table.
+ * @param[in,out] table    Senders.
+ */
+void CAClearBLESenderInfo(CABLESenderTable_t *table);
+
+/**
+ * This function is used to destroy a sender which is not in a table,
+ * with its reassembly buffer and remote endpoint.
+ * @param[in]   info       Sender to destroy.
+ */
+void CADestroyBLESenderInfo(CABLESenderInfo_t *info);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
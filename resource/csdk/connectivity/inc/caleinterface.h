@@ -67,8 +67,8 @@ typedef struct
     /// Length of the data being transmitted.
     uint32_t dataLen;
 
-    /// Sender information list
-    u_arraylist_t * senderInfo;
+    /// Senders whose messages are being reassembled, see cafragmentation.h.
+    struct CABLESenderTable *senderInfo;
 } CALEData_t;
 
 /**
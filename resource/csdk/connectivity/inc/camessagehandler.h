@@ -104,13 +104,13 @@ void CASetNetworkMonitorCallback(CANetworkMonitorCallback nwMonitorHandler);
  * @param[in] data    send data.
  */
 void CAAddDataToSendThread(CAData_t *data);
+#endif
 
 /**
  * Add the data to the receive queue thread to notify received data.
  * @param[in] data    received data.
  */
 void CAAddDataToReceiveThread(CAData_t *data);
-#endif
 
 #ifdef TCP_ADAPTER
 /**
@@ -109,6 +109,13 @@ CAResult_t CASendPongMessage(const CAEndpoint_t *endpoint, bool withCustody,
  */
 void CAProcessPing();
 
+/**
+ * Gets the time until CAProcessPing has a ping message to time out.
+ * @param[in] timeoutMs   maximum time to return (in ms).
+ * @return the lower of timeoutMs and the time until the first ping message times out.
+ */
+uint32_t CAGetPingTimeout(uint32_t timeoutMs);
+
 /**
  * Sets the timeout for a ping message
  * @param[in] timeout   the timeout for the ping message (in ms). If this
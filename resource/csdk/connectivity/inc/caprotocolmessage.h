@@ -26,6 +26,7 @@
 #define CA_PROTOCOL_MESSAGE_H_
 
 #include "cacommon.h"
+#include "oc_refcounter.h"
 #ifndef WITH_UPSTREAM_LIBCOAP
 #include "coap/config.h"
 #endif
@@ -57,6 +58,23 @@ static const uint8_t PAYLOAD_MARKER = 1;
 coap_pdu_t *CAGeneratePDU(uint32_t code, const CAInfo_t *info, const CAEndpoint_t *endpoint,
                           coap_list_t **optlist, coap_transport_t *transport);
 
+/**
+ * generates pdu structure from the given information in a single pass.
+ * Unlike CAGeneratePDU, the options are gathered in a fixed size array instead
+ * of a list and the pdu is allocated once with its exact size, then the options
+ * and the payload are written into it in order. Blockwise transfer options are
+ * not added, so messages which are part of a block transfer or don't fit a
+ * single UDP datagram have to be generated with CAGeneratePDU.
+ * @param[in]   code                 code of the pdu packet.
+ * @param[in]   info                 pdu information.
+ * @param[in]   endpoint             endpoint information.
+ * @param[out]  transport            transport type of the generated pdu.
+ * @return  generated pdu, or NULL on failure, including when the message has more
+ *          options than the builder holds or is too large for a UDP pdu.
+ */
+coap_pdu_t *CABuildPDU(uint32_t code, const CAInfo_t *info, const CAEndpoint_t *endpoint,
+                       coap_transport_t *transport);
+
 /**
  * extracts request information from received pdu.
  * @param[in]   pdu                   received pdu.
@@ -204,6 +222,30 @@ uint32_t CAGetOptionData(uint16_t key, const uint8_t *data, uint32_t len,
 CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
                             uint32_t *outCode, CAInfo_t *outInfo);
 
+/**
+ * creates the buffer information is extracted into by CAGetInfoFromPDUBuffer.
+ * the buffer takes the ownership of the pdu, which is deleted when the last
+ * reference to the buffer is released with oc_refcounter_dec.
+ * @param[in]    pdu                  received pdu.
+ * @param[in]    endpoint             endpoint information.
+ * @return  buffer holding a reference, or NULL on failure, in which case the pdu
+ *          is still owned by the caller.
+ */
+oc_refcounter CACreateInfoBuffer(coap_pdu_t *pdu, const CAEndpoint_t *endpoint);
+
+/**
+ * extracts information from the received pdu held by a buffer without copying it.
+ * token, payload, options and resourceUri of outInfo point into the buffer, which
+ * outInfo holds a reference to until it is destroyed.
+ * @param[in]    buffer               buffer created by CACreateInfoBuffer.
+ * @param[in]    endpoint             endpoint information.
+ * @param[out]   outCode              code of the received pdu.
+ * @param[out]   outInfo              info structure made from received pdu.
+ * @return  CA_STATUS_OK or ERROR CODES (CAResult_t error codes in cacommon.h).
+ */
+CAResult_t CAGetInfoFromPDUBuffer(oc_refcounter buffer, const CAEndpoint_t *endpoint,
+                                  uint32_t *outCode, CAInfo_t *outInfo);
+
 /**
  * create pdu from received data.
  * @param[in]   data                received data.
@@ -0,0 +1,79 @@
+/******************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+/**
+ * @file
+ * This file contains the wakeup of the thread handling received data. The
+ * wakeup is signalled when data is queued for CAHandleRequestResponse and
+ * cleared when it is handled. Where the platform allows, a descriptor is
+ * readable while the wakeup is signalled, so that the thread can wait for it
+ * in its own event loop.
+ */
+
+#ifndef CA_WAKEUP_H_
+#define CA_WAKEUP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cacommon.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Create the wakeup, not signalled.
+ * @return  ::CA_STATUS_OK or ::CA_STATUS_FAILED.
+ */
+CAResult_t CAWakeupInitialize(void);
+
+/**
+ * Destroy the wakeup. No thread may be waiting for it.
+ */
+void CAWakeupTerminate(void);
+
+/**
+ * Signal the wakeup. May be called from any thread.
+ */
+void CAWakeupSignal(void);
+
+/**
+ * Clear the wakeup, before handling the data it was signalled for.
+ */
+void CAWakeupClear(void);
+
+/**
+ * Wait until the wakeup is signalled.
+ * @param[in]   timeoutMs   maximum time to wait in milliseconds, 0 not to wait.
+ * @return  true if the wakeup is signalled.
+ */
+bool CAWakeupWait(uint32_t timeoutMs);
+
+/**
+ * Get the descriptor readable while the wakeup is signalled.
+ * @return  the descriptor, or -1 if the platform has none.
+ */
+int CAWakeupGetFd(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CA_WAKEUP_H_ */
@@ -38,6 +38,7 @@
 #include "experimental/ocrandom.h"
 #include "experimental/byte_array.h"
 #include "octhread.h"
+#include "ocatomic.h"
 #include "octimer.h"
 #include "utlist.h"
 #include "parsechain.h"
@@ -368,6 +369,8 @@ typedef struct SslContext
                                               peer id, it's n/w address and mbedTLS context. */
     mbedtls_entropy_context entropy;
     mbedtls_ctr_drbg_context rnd;
+    oc_mutex rndMutex;               /**< serializes rnd, which record encryption uses
+                                          without holding g_sslContextMutex. */
     mbedtls_x509_crt ca;
     mbedtls_x509_crt crt;
     mbedtls_pk_context pkey;
@@ -383,6 +386,13 @@ typedef struct SslContext
     bool cipherFlag[2];
     int selectedCipher;
 
+    bool pkixLoaded;                 /**< ca, crt, pkey and crl hold parsed PKIX info. */
+    int32_t pkixGeneration;          /**< g_pkixGeneration the PKIX info was loaded at. */
+    int pkixResult;                  /**< InitPKIX result for the loaded CA chain. */
+    bool ownCertLoaded;              /**< crt and pkey hold a usable own certificate. */
+    bool crlLoaded;                  /**< crl holds a parsed CRL. */
+    bool pkixConfigured[2];          /**< DTLS and TLS configs use the loaded PKIX info. */
+
 #ifdef __WITH_DTLS__
     mbedtls_ssl_cookie_ctx cookieCtx;
     int timerId;
@@ -412,6 +422,12 @@ static CAgetCredentialTypesHandler g_getCredentialTypesCallback = NULL;
  * @brief callback to get X.509-based Public Key Infrastructure
  */
 static CAgetPkixInfoHandler g_getPkixInfoCallback = NULL;
+/**
+ * @var g_pkixGeneration
+ *
+ * @brief bumped whenever the PKIX info returned by g_getPkixInfoCallback changes
+ */
+static volatile int32_t g_pkixGeneration = 0;
 /**
  * @var g_getIdentityCallback
  *
@@ -427,7 +443,9 @@ static CAcloseSslConnectionCallback g_closeSslConnectionCallback = NULL;
 
 /**
  * @var g_dtlsContextMutex
- * @brief Mutex to synchronize access to g_caSslContext and g_sslCallback.
+ * @brief Mutex to synchronize access to g_caSslContext, its peer list, handshakes
+ *        and g_sslCallback. Records of established sessions are processed under
+ *        the lock of the session only.
  */
 static oc_mutex g_sslContextMutex = NULL;
 
@@ -468,6 +486,10 @@ typedef struct SslEndPoint
 #ifdef __WITH_DTLS__
     mbedtls_timing_delay_context timer;
 #endif // __WITH_DTLS__
+    oc_mutex mutex;                  /**< serializes use of ssl once established is set. */
+    volatile int32_t refCount;       /**< peer list entry plus record operations in flight. */
+    bool established;                /**< handshake is over, set under g_sslContextMutex. */
+    bool removed;                    /**< removed from the peer list, set under mutex. */
 } SslEndPoint_t;
 
 void CAsetPskCredentialsCallback(CAgetPskCredentialsHandler credCallback)
@@ -481,10 +503,21 @@ void CAsetPskCredentialsCallback(CAgetPskCredentialsHandler credCallback)
 void CAsetPkixInfoCallback(CAgetPkixInfoHandler infoCallback)
 {
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "In %s", __func__);
+    if (g_getPkixInfoCallback != infoCallback)
+    {
+        oc_atomic_increment(&g_pkixGeneration);
+    }
     g_getPkixInfoCallback = infoCallback;
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
 }
 
+void CAresetPkixInfoCache(void)
+{
+    OIC_LOG_V(DEBUG, NET_SSL_TAG, "In %s", __func__);
+    oc_atomic_increment(&g_pkixGeneration);
+    OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
+}
+
 void CAsetIdentityCallback(CAgetIdentityHandler identityCallback)
 {
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "In %s", __func__);
@@ -689,11 +722,10 @@ static void DeInitPkixInfo(PkiInfo_t * inf)
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
 }
 
-//Loads PKIX related information from SRM
-static int InitPKIX(CATransportAdapter_t adapter)
+//Loads and parses PKIX related information from SRM
+static void LoadPKIX(void)
 {
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "In %s", __func__);
-    VERIFY_NON_NULL_RET(g_getPkixInfoCallback, NET_SSL_TAG, "PKIX info callback is NULL", -1);
     // load pk key, cert, trust chain and crl
     PkiInfo_t pkiInfo = {
         CERT_CHAIN_INITIALIZER,
@@ -702,11 +734,7 @@ static int InitPKIX(CATransportAdapter_t adapter)
         BYTE_ARRAY_INITIALIZER
     };
 
-    if (g_getPkixInfoCallback)
-    {
-        g_getPkixInfoCallback(&pkiInfo);
-    }
-    VERIFY_NON_NULL_RET(g_caSslContext, NET_SSL_TAG, "SSL Context is NULL", -1);
+    g_getPkixInfoCallback(&pkiInfo);
 
     mbedtls_x509_crt_free(&g_caSslContext->ca);
     mbedtls_x509_crt_free(&g_caSslContext->crt);
@@ -717,12 +745,11 @@ static int InitPKIX(CATransportAdapter_t adapter)
     mbedtls_x509_crt_init(&g_caSslContext->crt);
     mbedtls_pk_init(&g_caSslContext->pkey);
     mbedtls_x509_crl_init(&g_caSslContext->crl);
-    mbedtls_ssl_config * serverConf = (adapter == CA_ADAPTER_IP ||
-                                   adapter == CA_ADAPTER_GATT_BTLE ?
-                                   &g_caSslContext->serverDtlsConf : &g_caSslContext->serverTlsConf);
-    mbedtls_ssl_config * clientConf = (adapter == CA_ADAPTER_IP ||
-                                   adapter == CA_ADAPTER_GATT_BTLE ?
-                                   &g_caSslContext->clientDtlsConf : &g_caSslContext->clientTlsConf);
+
+    g_caSslContext->pkixResult = -1;
+    g_caSslContext->ownCertLoaded = false;
+    g_caSslContext->crlLoaded = false;
+
     // optional
     int ret;
     int errNum;
@@ -757,35 +784,7 @@ static int InitPKIX(CATransportAdapter_t adapter)
         OIC_LOG(WARNING, NET_SSL_TAG, "Key parsing error");
         goto required;
     }
-
-    ret = mbedtls_ssl_conf_own_cert(serverConf, &g_caSslContext->crt, &g_caSslContext->pkey);
-    if (0 != ret)
-    {
-        OIC_LOG(WARNING, NET_SSL_TAG, "Own certificate parsing error");
-        goto required;
-    }
-    ret = mbedtls_ssl_conf_own_cert(clientConf, &g_caSslContext->crt, &g_caSslContext->pkey);
-    if(0 != ret)
-    {
-        OIC_LOG(WARNING, NET_SSL_TAG, "Own certificate configuration error");
-        goto required;
-    }
-
-    /* If we get here, certificates could be used, so configure OCF EKUs. */
-    ret = mbedtls_ssl_conf_ekus(serverConf, (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY),
-        (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY));
-    if (0 == ret)
-    {
-        ret = mbedtls_ssl_conf_ekus(clientConf, (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY),
-            (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY));
-    }
-    if (0 != ret)
-    {
-        /* Cert-based ciphersuites will fail, but if PSK ciphersuites are in
-         * the list they might work, so don't return error.
-         */
-        OIC_LOG(WARNING, NET_SSL_TAG, "EKU configuration error");
-    }
+    g_caSslContext->ownCertLoaded = true;
 
     required:
     count = ParseChain(&g_caSslContext->ca, &(pkiInfo.ca), &errNum);
@@ -794,7 +793,7 @@ static int InitPKIX(CATransportAdapter_t adapter)
         OIC_LOG(ERROR, NET_SSL_TAG, "CA chain parsing error");
         OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
         DeInitPkixInfo(&pkiInfo);
-        return -1;
+        return;
     }
     if(0 != errNum)
     {
@@ -808,31 +807,116 @@ static int InitPKIX(CATransportAdapter_t adapter)
             OIC_LOG(ERROR, NET_SSL_TAG, "Invalid own CA cert chain");
             OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
             DeInitPkixInfo(&pkiInfo);
-            return -1;
+            return;
         }
         else if (0 < ret )
         {
             OIC_LOG_V(ERROR, NET_SSL_TAG, "%d certificate(s) in own CA cert chain violate OCF Root CA cert profile requirements", ret);
             OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
             DeInitPkixInfo(&pkiInfo);
-            return -1;
+            return;
         }
     }
+    g_caSslContext->pkixResult = 0;
 
     ret = mbedtls_x509_crl_parse_der(&g_caSslContext->crl, pkiInfo.crl.data, pkiInfo.crl.len);
     if(0 != ret)
     {
         OIC_LOG(WARNING, NET_SSL_TAG, "CRL parsing error");
-        CONF_SSL(clientConf, serverConf, mbedtls_ssl_conf_ca_chain, &g_caSslContext->ca, NULL);
     }
     else
     {
-        CONF_SSL(clientConf, serverConf, mbedtls_ssl_conf_ca_chain,
-                 &g_caSslContext->ca, &g_caSslContext->crl);
+        g_caSslContext->crlLoaded = true;
     }
 
     DeInitPkixInfo(&pkiInfo);
 
+    OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
+}
+
+//Configures PKIX related information from SRM, parsing it only when it has changed
+static int InitPKIX(CATransportAdapter_t adapter)
+{
+    OIC_LOG_V(DEBUG, NET_SSL_TAG, "In %s", __func__);
+    VERIFY_NON_NULL_RET(g_getPkixInfoCallback, NET_SSL_TAG, "PKIX info callback is NULL", -1);
+    VERIFY_NON_NULL_RET(g_caSslContext, NET_SSL_TAG, "SSL Context is NULL", -1);
+
+    // Read the generation first so a change made while loading triggers another load.
+    int32_t generation = oc_atomic_add(&g_pkixGeneration, 0);
+    if (!g_caSslContext->pkixLoaded || generation != g_caSslContext->pkixGeneration)
+    {
+        LoadPKIX();
+        g_caSslContext->pkixLoaded = true;
+        g_caSslContext->pkixGeneration = generation;
+        g_caSslContext->pkixConfigured[0] = false;
+        g_caSslContext->pkixConfigured[1] = false;
+    }
+
+    bool isDtls = (adapter == CA_ADAPTER_IP || adapter == CA_ADAPTER_GATT_BTLE);
+    bool *configured = &g_caSslContext->pkixConfigured[isDtls ? 0 : 1];
+    if (*configured)
+    {
+        OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
+        return g_caSslContext->pkixResult;
+    }
+    *configured = true;
+
+    mbedtls_ssl_config * serverConf = (isDtls ?
+                                   &g_caSslContext->serverDtlsConf : &g_caSslContext->serverTlsConf);
+    mbedtls_ssl_config * clientConf = (isDtls ?
+                                   &g_caSslContext->clientDtlsConf : &g_caSslContext->clientTlsConf);
+    int ret;
+    if (!g_caSslContext->ownCertLoaded)
+    {
+        goto required;
+    }
+
+    ret = mbedtls_ssl_conf_own_cert(serverConf, &g_caSslContext->crt, &g_caSslContext->pkey);
+    if (0 != ret)
+    {
+        OIC_LOG(WARNING, NET_SSL_TAG, "Own certificate parsing error");
+        goto required;
+    }
+    ret = mbedtls_ssl_conf_own_cert(clientConf, &g_caSslContext->crt, &g_caSslContext->pkey);
+    if(0 != ret)
+    {
+        OIC_LOG(WARNING, NET_SSL_TAG, "Own certificate configuration error");
+        goto required;
+    }
+
+    /* If we get here, certificates could be used, so configure OCF EKUs. */
+    ret = mbedtls_ssl_conf_ekus(serverConf, (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY),
+        (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY));
+    if (0 == ret)
+    {
+        ret = mbedtls_ssl_conf_ekus(clientConf, (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY),
+            (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY));
+    }
+    if (0 != ret)
+    {
+        /* Cert-based ciphersuites will fail, but if PSK ciphersuites are in
+         * the list they might work, so don't return error.
+         */
+        OIC_LOG(WARNING, NET_SSL_TAG, "EKU configuration error");
+    }
+
+    required:
+    if (0 != g_caSslContext->pkixResult)
+    {
+        OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
+        return g_caSslContext->pkixResult;
+    }
+
+    if (g_caSslContext->crlLoaded)
+    {
+        CONF_SSL(clientConf, serverConf, mbedtls_ssl_conf_ca_chain,
+                 &g_caSslContext->ca, &g_caSslContext->crl);
+    }
+    else
+    {
+        CONF_SSL(clientConf, serverConf, mbedtls_ssl_conf_ca_chain, &g_caSslContext->ca, NULL);
+    }
+
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
     return 0;
 }
@@ -1112,9 +1196,54 @@ static void DeleteSslEndPoint(SslEndPoint_t * tep)
 
     mbedtls_ssl_free(&tep->ssl);
     DeleteCacheList(tep->cacheList);
+    oc_mutex_free(tep->mutex);
     OICFree(tep);
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
 }
+
+/**
+ * Takes a reference to endpoint, so it outlives its removal from the peer list.
+ *
+ * @param[in]  tep    endpoint with session info
+ */
+static void AcquireSslEndPoint(SslEndPoint_t * tep)
+{
+    oc_atomic_increment(&tep->refCount);
+}
+
+/**
+ * Drops a reference to endpoint, deleting it with the last one.
+ *
+ * @param[in]  tep    endpoint with session info
+ */
+static void ReleaseSslEndPoint(SslEndPoint_t * tep)
+{
+    if (0 == oc_atomic_decrement(&tep->refCount))
+    {
+        DeleteSslEndPoint(tep);
+    }
+}
+
+/**
+ * Removes endpoint session from list. Record operations still running on it
+ * fail once they get its lock.
+ *
+ * @param[in]  listIndex    index of the endpoint in the peer list
+ * @param[in]  tep    endpoint with session info
+ */
+static void RemoveSslEndPoint(size_t listIndex, SslEndPoint_t * tep)
+{
+    oc_mutex_assert_owner(g_sslContextMutex, true);
+
+    u_arraylist_remove(g_caSslContext->peerList, listIndex);
+
+    oc_mutex_lock(tep->mutex);
+    tep->removed = true;
+    oc_mutex_unlock(tep->mutex);
+
+    ReleaseSslEndPoint(tep);
+}
+
 /**
  * Removes endpoint session from list.
  *
@@ -1138,13 +1267,36 @@ static void RemovePeerFromList(CAEndpoint_t * endpoint)
         if(0 == strncmp(endpoint->addr, tep->sep.endpoint.addr, MAX_ADDR_STR_SIZE_CA)
                 && (endpoint->port == tep->sep.endpoint.port))
         {
-            u_arraylist_remove(g_caSslContext->peerList, listIndex);
-            DeleteSslEndPoint(tep);
+            RemoveSslEndPoint(listIndex, tep);
             return;
         }
     }
 }
 
+/**
+ * Removes endpoint session from list, unless that has been done already.
+ * Used by record operations, which do not hold g_sslContextMutex.
+ *
+ * @param[in]  tep    endpoint with session info
+ */
+static void RemoveSslPeer(SslEndPoint_t * tep)
+{
+    oc_mutex_lock(g_sslContextMutex);
+    if (NULL != g_caSslContext)
+    {
+        size_t listLength = u_arraylist_length(g_caSslContext->peerList);
+        for (size_t listIndex = 0; listIndex < listLength; listIndex++)
+        {
+            if (tep == u_arraylist_get(g_caSslContext->peerList, listIndex))
+            {
+                RemoveSslEndPoint(listIndex, tep);
+                break;
+            }
+        }
+    }
+    oc_mutex_unlock(g_sslContextMutex);
+}
+
  /**
   * Checks handshake result. Removes peer from list and sends alert
   * if handshake failed.
@@ -1247,6 +1399,7 @@ static void DeletePeerList(void)
         {
             continue;
         }
+        oc_mutex_lock(tep->mutex);
         if (MBEDTLS_SSL_HANDSHAKE_OVER == tep->ssl.state)
         {
             int ret = 0;
@@ -1256,7 +1409,12 @@ static void DeletePeerList(void)
             }
             while (MBEDTLS_ERR_SSL_WANT_WRITE == ret);
         }
-        DeleteSslEndPoint(tep);
+        // The configs are freed next; a record operation still holding a
+        // reference only frees what is left of the cleared session.
+        mbedtls_ssl_free(&tep->ssl);
+        tep->removed = true;
+        oc_mutex_unlock(tep->mutex);
+        ReleaseSslEndPoint(tep);
     }
     u_arraylist_free(&g_caSslContext->peerList);
 }
@@ -1282,11 +1440,13 @@ CAResult_t CAcloseSslConnection(const CAEndpoint_t *endpoint)
     }
     /* No error checking, the connection might be closed already */
     int ret = 0;
+    oc_mutex_lock(tep->mutex);
     do
     {
         ret = mbedtls_ssl_close_notify(&tep->ssl);
     }
     while (MBEDTLS_ERR_SSL_WANT_WRITE == ret);
+    oc_mutex_unlock(tep->mutex);
 
     if (NULL != g_closeSslConnectionCallback)
     {
@@ -1340,8 +1500,7 @@ void CAcloseSslConnectionAll(CATransportAdapter_t transportType)
         while (MBEDTLS_ERR_SSL_WANT_WRITE == ret);*/
 
         // delete from list
-        u_arraylist_remove(g_caSslContext->peerList, i - 1);
-        DeleteSslEndPoint(tep);
+        RemoveSslEndPoint(i - 1, tep);
     }
     oc_mutex_unlock(g_sslContextMutex);
 
@@ -1476,6 +1635,17 @@ static SslEndPoint_t * NewSslEndPoint(const CAEndpoint_t * endpoint, mbedtls_ssl
         OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
         return NULL;
     }
+    tep->mutex = oc_mutex_new_recursive();
+    if (NULL == tep->mutex)
+    {
+        OIC_LOG(ERROR, NET_SSL_TAG, "mutex initialization failed!");
+        mbedtls_ssl_free(&tep->ssl);
+        u_arraylist_free(&tep->cacheList);
+        OICFree(tep);
+        OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
+        return NULL;
+    }
+    tep->refCount = 1;
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "New [%s role] endpoint added [%s:%d]",
             (MBEDTLS_SSL_IS_SERVER==config->endpoint ? "server" : "client"),
             endpoint->addr, endpoint->port);
@@ -1676,9 +1846,9 @@ static SslEndPoint_t * InitiateTlsHandshake(const CAEndpoint_t *endpoint)
                                "Handshake error",
                                MBEDTLS_SSL_ALERT_MSG_HANDSHAKE_FAILURE))
         {
+            // checkSslOperation removed tep from the list, which deleted it.
             oc_mutex_unlock(g_sslContextMutex);
             OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
-            DeleteSslEndPoint(tep);
             return NULL;
         }
     }
@@ -1716,6 +1886,8 @@ void CAdeinitSslAdapter(void)
     // De-initialize mbedTLS
     mbedtls_x509_crt_free(&g_caSslContext->crt);
     mbedtls_pk_free(&g_caSslContext->pkey);
+    mbedtls_x509_crt_free(&g_caSslContext->ca);
+    mbedtls_x509_crl_free(&g_caSslContext->crl);
 #ifdef __WITH_TLS__
     mbedtls_ssl_config_free(&g_caSslContext->clientTlsConf);
     mbedtls_ssl_config_free(&g_caSslContext->serverTlsConf);
@@ -1727,6 +1899,7 @@ void CAdeinitSslAdapter(void)
 #endif // __WITH_DTLS__
     mbedtls_ctr_drbg_free(&g_caSslContext->rnd);
     mbedtls_entropy_free(&g_caSslContext->entropy);
+    oc_mutex_free(g_caSslContext->rndMutex);
 #ifdef __WITH_DTLS__
     StopRetransmit();
 #endif
@@ -1742,6 +1915,24 @@ void CAdeinitSslAdapter(void)
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s ", __func__);
 }
 
+/**
+ * Random number generator of the (D)TLS configs.
+ *
+ * @param[in]  ctx    SSL context
+ * @param[out]  output    buffer to fill
+ * @param[in]  len    buffer length
+ *
+ * @return  0 on success or mbedTLS error code
+ */
+static int SslRandom(void * ctx, unsigned char * output, size_t len)
+{
+    SslContext_t * context = (SslContext_t *)ctx;
+    oc_mutex_lock(context->rndMutex);
+    int ret = mbedtls_ctr_drbg_random(&context->rnd, output, len);
+    oc_mutex_unlock(context->rndMutex);
+    return ret;
+}
+
 static int InitConfig(mbedtls_ssl_config * conf, int transport, int mode)
 {
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "In %s", __func__);
@@ -1759,7 +1950,7 @@ static int InitConfig(mbedtls_ssl_config * conf, int transport, int mode)
      * time, see extlibs/mbedtls/config-iotivity.h
      */
     mbedtls_ssl_conf_psk_cb(conf, GetPskCredentialsCallback, NULL);
-    mbedtls_ssl_conf_rng(conf, mbedtls_ctr_drbg_random, &g_caSslContext->rnd);
+    mbedtls_ssl_conf_rng(conf, SslRandom, g_caSslContext);
     mbedtls_ssl_conf_curves(conf, curve[ADAPTER_CURVE_SECP256R1]);
     mbedtls_ssl_conf_authmode(conf, MBEDTLS_SSL_VERIFY_REQUIRED);
 
@@ -1813,6 +2004,7 @@ static void StartRetransmit(void *ctx)
         {
             tep = (SslEndPoint_t *) u_arraylist_get(g_caSslContext->peerList, listIndex);
             if (NULL == tep
+                || tep->established
                 || (tep->ssl.conf && MBEDTLS_SSL_TRANSPORT_STREAM == tep->ssl.conf->transport)
                 || MBEDTLS_SSL_HANDSHAKE_OVER == tep->ssl.state)
             {
@@ -1885,6 +2077,19 @@ CAResult_t CAinitSslAdapter(void)
         return CA_STATUS_FAILED;
     }
 
+    g_caSslContext->rndMutex = oc_mutex_new();
+    if (NULL == g_caSslContext->rndMutex)
+    {
+        OIC_LOG(ERROR, NET_SSL_TAG, "rndMutex initialization failed!");
+        u_arraylist_free(&g_caSslContext->peerList);
+        OICFree(g_caSslContext);
+        g_caSslContext = NULL;
+        oc_mutex_unlock(g_sslContextMutex);
+        oc_mutex_free(g_sslContextMutex);
+        g_sslContextMutex = NULL;
+        return CA_STATUS_FAILED;
+    }
+
     /* Initialize TLS library
      */
 #if !defined(NDEBUG) || defined(TB_LOG)
@@ -2021,13 +2226,144 @@ SslCacheMessage_t *NewCacheMessage(uint8_t * data, size_t dataLen)
     return message;
 }
 
+/**
+ * Writes data to an established session. Only the lock of the session is held,
+ * so sessions of different peers are written concurrently.
+ *
+ * @param[in]  tep    session, referenced by the caller; the reference is released
+ * @param[in]  data    message
+ * @param[in]  dataLen    message length
+ *
+ * @return  CA_STATUS_OK on success or CA_STATUS_FAILED on error
+ */
+static CAResult_t WriteSslRecords(SslEndPoint_t * tep, const void * data, size_t dataLen)
+{
+    CAResult_t result = CA_STATUS_OK;
+
+    oc_mutex_lock(tep->mutex);
+    if (tep->removed)
+    {
+        OIC_LOG(ERROR, NET_SSL_TAG, "Session was closed");
+        result = CA_STATUS_FAILED;
+    }
+    else
+    {
+        const unsigned char *dataBuf = (const unsigned char *)data;
+        size_t written = 0;
+
+        do
+        {
+            int ret = mbedtls_ssl_write(&tep->ssl, dataBuf, dataLen - written);
+            if (ret < 0)
+            {
+                if (MBEDTLS_ERR_SSL_WANT_WRITE != ret)
+                {
+                    OIC_LOG_V(ERROR, NET_SSL_TAG, "mbedTLS write failed! returned 0x%x", -ret);
+                    result = CA_STATUS_FAILED;
+                    break;
+                }
+                continue;
+            }
+            OIC_LOG_V(DEBUG, NET_SSL_TAG, "mbedTLS write returned with sent bytes[%d]", ret);
+
+            dataBuf += ret;
+            written += ret;
+        } while (dataLen > written);
+    }
+    oc_mutex_unlock(tep->mutex);
+
+    if (CA_STATUS_OK != result)
+    {
+        RemoveSslPeer(tep);
+    }
+    ReleaseSslEndPoint(tep);
+    return result;
+}
+
+/**
+ * Reads the records loaded into the receive buffer of an established session
+ * and passes the decrypted data to the adapter. Only the lock of the session
+ * is held while decrypting, and none while calling the adapter.
+ *
+ * @param[in]  peer    session, referenced and locked by the caller; it is
+ *                     unlocked and the reference is released
+ *
+ * @return  CA_STATUS_OK on success or CA_STATUS_FAILED on error
+ */
+static CAResult_t ReadSslRecords(SslEndPoint_t * peer)
+{
+    uint8_t decryptBuffer[TLS_MSG_BUF_LEN] = {0};
+    SslCallbacks_t callbacks = { NULL, NULL, NULL };
+    uint8_t * data = peer->recBuf.buff;
+    size_t dataLen = peer->recBuf.len;
+    int ret = 0;
+
+    if (peer->removed)
+    {
+        oc_mutex_unlock(peer->mutex);
+        ReleaseSslEndPoint(peer);
+        OIC_LOG(ERROR, NET_SSL_TAG, "Session was closed");
+        return CA_STATUS_FAILED;
+    }
+
+    // The context outlives sessions which are still in the peer list.
+    int adapterIndex = GetAdapterIndex(peer->sep.endpoint.adapter);
+    if (adapterIndex >= 0)
+    {
+        callbacks = g_caSslContext->adapterCallbacks[adapterIndex];
+    }
+
+    do
+    {
+        ret = mbedtls_ssl_read(&peer->ssl, decryptBuffer, TLS_MSG_BUF_LEN);
+    } while (MBEDTLS_ERR_SSL_WANT_READ == ret);
+
+    bool closed = (MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY == ret ||
+                   // TinyDTLS sends fatal close_notify alert
+                   (MBEDTLS_ERR_SSL_FATAL_ALERT_MESSAGE == ret &&
+                    MBEDTLS_SSL_ALERT_LEVEL_FATAL == peer->ssl.in_msg[0] &&
+                    MBEDTLS_SSL_ALERT_MSG_CLOSE_NOTIFY == peer->ssl.in_msg[1]));
+    oc_mutex_unlock(peer->mutex);
+
+    CAResult_t result = CA_STATUS_OK;
+    if (closed)
+    {
+        OIC_LOG(INFO, NET_SSL_TAG, "Connection was closed gracefully");
+
+        if (NULL != g_closeSslConnectionCallback)
+        {
+            g_closeSslConnectionCallback(peer->sep.identity.id, peer->sep.identity.id_length);
+        }
+
+        RemoveSslPeer(peer);
+    }
+    else if (adapterIndex < 0)
+    {
+        OIC_LOG(ERROR, NET_SSL_TAG, "Unsuported adapter");
+        RemoveSslPeer(peer);
+        result = CA_STATUS_FAILED;
+    }
+    else if (0 > ret)
+    {
+        OIC_LOG_V(ERROR, NET_SSL_TAG, "mbedtls_ssl_read returned -0x%x", -ret);
+        callbacks.errorCallback(&peer->sep.endpoint, data, dataLen, CA_STATUS_FAILED);
+        RemoveSslPeer(peer);
+        result = CA_STATUS_FAILED;
+    }
+    else if (0 < ret)
+    {
+        callbacks.recvCallback(&peer->sep, decryptBuffer, ret);
+    }
+
+    ReleaseSslEndPoint(peer);
+    return result;
+}
+
 /* Send data via TLS connection.
  */
 CAResult_t CAencryptSsl(const CAEndpoint_t *endpoint,
                         const void *data, size_t dataLen)
 {
-    int ret = 0;
-
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "In %s ", __func__);
 
     VERIFY_NON_NULL_RET(endpoint, NET_SSL_TAG,"Remote address is NULL", CA_STATUS_INVALID_PARAM);
@@ -2062,33 +2398,7 @@ CAResult_t CAencryptSsl(const CAEndpoint_t *endpoint,
         return CA_STATUS_FAILED;
     }
 
-    if (MBEDTLS_SSL_HANDSHAKE_OVER == tep->ssl.state)
-    {
-        unsigned char *dataBuf = (unsigned char *)data;
-        size_t written = 0;
-
-        do
-        {
-            ret = mbedtls_ssl_write(&tep->ssl, dataBuf, dataLen - written);
-            if (ret < 0)
-            {
-                if (MBEDTLS_ERR_SSL_WANT_WRITE != ret)
-                {
-                    OIC_LOG_V(ERROR, NET_SSL_TAG, "mbedTLS write failed! returned 0x%x", -ret);
-                    RemovePeerFromList(&tep->sep.endpoint);
-                    oc_mutex_unlock(g_sslContextMutex);
-                    return CA_STATUS_FAILED;
-                }
-                continue;
-            }
-            OIC_LOG_V(DEBUG, NET_SSL_TAG, "mbedTLS write returned with sent bytes[%d]", ret);
-
-            dataBuf += ret;
-            written += ret;
-        } while (dataLen > written);
-
-    }
-    else
+    if (!tep->established && MBEDTLS_SSL_HANDSHAKE_OVER != tep->ssl.state)
     {
         SslCacheMessage_t * msg = NewCacheMessage((uint8_t*) data, dataLen);
         if (NULL == msg || !u_arraylist_add(tep->cacheList, (void *) msg))
@@ -2097,12 +2407,20 @@ CAResult_t CAencryptSsl(const CAEndpoint_t *endpoint,
             oc_mutex_unlock(g_sslContextMutex);
             return CA_STATUS_FAILED;
         }
+        oc_mutex_unlock(g_sslContextMutex);
+
+        OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
+        return CA_STATUS_OK;
     }
 
+    tep->established = true;
+    AcquireSslEndPoint(tep);
     oc_mutex_unlock(g_sslContextMutex);
 
+    CAResult_t result = WriteSslRecords(tep, data, dataLen);
+
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
-    return CA_STATUS_OK;
+    return result;
 }
 /**
  * Sends cached messages via TLS connection.
@@ -2216,6 +2534,19 @@ CAResult_t CAdecryptSsl(const CASecureEndpoint_t *sep, uint8_t *data, size_t dat
     }
 
     SslEndPoint_t * peer = GetSslPeer(&sep->endpoint);
+    if (NULL != peer && peer->established)
+    {
+        AcquireSslEndPoint(peer);
+        oc_mutex_unlock(g_sslContextMutex);
+
+        oc_mutex_lock(peer->mutex);
+        peer->recBuf.buff = data;
+        peer->recBuf.len = dataLen;
+        peer->recBuf.loaded = 0;
+
+        OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
+        return ReadSslRecords(peer);
+    }
     if (NULL == peer)
     {
         mbedtls_ssl_config * config = (sep->endpoint.adapter == CA_ADAPTER_IP ||
@@ -2499,53 +2830,14 @@ CAResult_t CAdecryptSsl(const CASecureEndpoint_t *sep, uint8_t *data, size_t dat
 
     if (MBEDTLS_SSL_HANDSHAKE_OVER == peer->ssl.state)
     {
-        uint8_t decryptBuffer[TLS_MSG_BUF_LEN] = {0};
-        do
-        {
-            ret = mbedtls_ssl_read(&peer->ssl, decryptBuffer, TLS_MSG_BUF_LEN);
-        } while (MBEDTLS_ERR_SSL_WANT_READ == ret);
-
-        if (MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY == ret ||
-            // TinyDTLS sends fatal close_notify alert
-            (MBEDTLS_ERR_SSL_FATAL_ALERT_MESSAGE == ret &&
-             MBEDTLS_SSL_ALERT_LEVEL_FATAL == peer->ssl.in_msg[0] &&
-             MBEDTLS_SSL_ALERT_MSG_CLOSE_NOTIFY == peer->ssl.in_msg[1]))
-        {
-            OIC_LOG(INFO, NET_SSL_TAG, "Connection was closed gracefully");
-
-            if (NULL != g_closeSslConnectionCallback)
-            {
-                g_closeSslConnectionCallback(peer->sep.identity.id, peer->sep.identity.id_length);
-            }
-
-            RemovePeerFromList(&peer->sep.endpoint);
-            oc_mutex_unlock(g_sslContextMutex);
-            return CA_STATUS_OK;
-        }
+        // Records following the last handshake message are still loaded.
+        peer->established = true;
+        AcquireSslEndPoint(peer);
+        oc_mutex_lock(peer->mutex);
+        oc_mutex_unlock(g_sslContextMutex);
 
-        int adapterIndex = GetAdapterIndex(peer->sep.endpoint.adapter);
-        if (adapterIndex >= 0)
-        {
-            if (0 > ret)
-            {
-                OIC_LOG_V(ERROR, NET_SSL_TAG, "mbedtls_ssl_read returned -0x%x", -ret);
-                g_caSslContext->adapterCallbacks[adapterIndex].errorCallback(&peer->sep.endpoint, peer->recBuf.buff, peer->recBuf.len, CA_STATUS_FAILED);
-                RemovePeerFromList(&peer->sep.endpoint);
-                oc_mutex_unlock(g_sslContextMutex);
-                return CA_STATUS_FAILED;
-            }
-            else if (0 < ret)
-            {
-                g_caSslContext->adapterCallbacks[adapterIndex].recvCallback(&peer->sep, decryptBuffer, ret);
-            }
-        }
-        else
-        {
-            OIC_LOG(ERROR, NET_SSL_TAG, "Unsuported adapter");
-            RemovePeerFromList(&peer->sep.endpoint);
-            oc_mutex_unlock(g_sslContextMutex);
-            return CA_STATUS_FAILED;
-        }
+        OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
+        return ReadSslRecords(peer);
     }
 
     oc_mutex_unlock(g_sslContextMutex);
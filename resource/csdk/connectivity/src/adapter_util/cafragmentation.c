@@ -18,13 +18,21 @@
  *
  ******************************************************************/
 
+#include "iotivity_config.h"
 #include <string.h>
+#ifdef HAVE_STRINGS_H
+#include <strings.h>
+#endif
 #include <math.h>
 
+#include "platform_features.h"
+
 #include "cacommon.h"
 #include "caadapterutils.h"
 #include "cafragmentation.h"
 #include "caleinterface.h"
+#include "caremotehandler.h"
+#include "oic_malloc.h"
 
 /**
  * Debugging tag for fragmentation module.
@@ -239,3 +247,229 @@ CAResult_t CAParseHeaderPayloadLength(uint8_t *header,
 
     return CA_STATUS_OK;
 }
+
+CAResult_t CAInitBLESegmenter(CABLESegmenter_t *segmenter,
+                              const uint8_t *data,
+                              uint32_t dataLength,
+                              uint16_t mtuSize,
+                              uint8_t sourcePort,
+                              CABLEPacketSecure_t secure,
+                              uint8_t destPort)
+{
+    VERIFY_NON_NULL(segmenter, TAG, "segmenter is NULL");
+    VERIFY_NON_NULL(data, TAG, "data is NULL");
+
+    if (mtuSize <= CA_BLE_HEADER_SIZE + CA_BLE_LENGTH_HEADER_SIZE
+        || mtuSize > CA_SUPPORTED_BLE_MTU_SIZE)
+    {
+        OIC_LOG_V(ERROR, TAG, "invalid mtu size(%u)", (uint32_t)mtuSize);
+        return CA_STATUS_INVALID_PARAM;
+    }
+
+    memset(segmenter, 0, sizeof(*segmenter));
+    CAResult_t result = CAGenerateHeader(segmenter->startHeader, CA_BLE_PACKET_START,
+                                         sourcePort, secure, destPort);
+    if (CA_STATUS_OK != result)
+    {
+        return result;
+    }
+    result = CAGenerateHeaderPayloadLength(segmenter->startHeader + CA_BLE_HEADER_SIZE,
+                                           CA_BLE_LENGTH_HEADER_SIZE, dataLength);
+    if (CA_STATUS_OK != result)
+    {
+        return result;
+    }
+    result = CAGenerateHeader(segmenter->header, CA_BLE_PACKET_NOT_START,
+                              sourcePort, secure, destPort);
+    if (CA_STATUS_OK != result)
+    {
+        return result;
+    }
+
+    segmenter->data = data;
+    segmenter->dataLength = dataLength;
+    segmenter->mtuSize = mtuSize;
+    return CA_STATUS_OK;
+}
+
+bool CAGetNextBLESegment(CABLESegmenter_t *segmenter, CABLESegment_t *segment)
+{
+    if (!segmenter || !segment)
+    {
+        return false;
+    }
+
+    if (!segmenter->started)
+    {
+        // The first segment is sent even for an empty message, it carries the length.
+        segment->header = segmenter->startHeader;
+        segment->headerLength = CA_BLE_HEADER_SIZE + CA_BLE_LENGTH_HEADER_SIZE;
+        segmenter->started = true;
+    }
+    else if (segmenter->offset < segmenter->dataLength)
+    {
+        segment->header = segmenter->header;
+        segment->headerLength = CA_BLE_HEADER_SIZE;
+    }
+    else
+    {
+        return false;
+    }
+
+    uint32_t capacity = segmenter->mtuSize - segment->headerLength;
+    uint32_t remaining = segmenter->dataLength - segmenter->offset;
+    segment->data = segmenter->data + segmenter->offset;
+    segment->dataLength = remaining < capacity ? remaining : capacity;
+    segmenter->offset += segment->dataLength;
+    return true;
+}
+
+uint32_t CACopyBLESegment(const CABLESegment_t *segment,
+                          uint8_t *buffer,
+                          uint32_t bufferLength)
+{
+    if (!segment || !buffer
+        || bufferLength < segment->headerLength + segment->dataLength)
+    {
+        return 0;
+    }
+
+    // Copies of a constant size are inlined, only the payload goes through memcpy.
+    if (CA_BLE_HEADER_SIZE == segment->headerLength)
+    {
+        memcpy(buffer, segment->header, CA_BLE_HEADER_SIZE);
+    }
+    else
+    {
+        memcpy(buffer, segment->header, CA_BLE_HEADER_SIZE + CA_BLE_LENGTH_HEADER_SIZE);
+    }
+    memcpy(buffer + segment->headerLength, segment->data, segment->dataLength);
+    return segment->headerLength + segment->dataLength;
+}
+
+static uint32_t CAHashBLESenderAddress(const char *address)
+{
+    return u_hashmap_hash_nocase(U_HASHMAP_HASH_INIT, address);
+}
+
+static bool CAMatchBLESenderAddress(const u_hashmap_entry_t *entry, const void *address)
+{
+    const CABLESenderInfo_t *info = U_HASHMAP_CONTAINER(entry, CABLESenderInfo_t, entry);
+    return 0 == strcasecmp(info->remoteEndpoint->addr, (const char *)address);
+}
+
+/**
+ * Address and port of a sender, the key of CAMatchBLESender().
+ */
+typedef struct
+{
+    const char *address;
+    uint16_t port;
+} CABLESenderKey_t;
+
+static bool CAMatchBLESender(const u_hashmap_entry_t *entry, const void *key)
+{
+    const CABLESenderInfo_t *info = U_HASHMAP_CONTAINER(entry, CABLESenderInfo_t, entry);
+    const CABLESenderKey_t *sender = (const CABLESenderKey_t *)key;
+    return info->remoteEndpoint->port == sender->port
+        && 0 == strcasecmp(info->remoteEndpoint->addr, sender->address);
+}
+
+CABLESenderInfo_t *CAGetBLESenderInfo(const CABLESenderTable_t *table,
+                                      const char *address,
+                                      uint16_t port)
+{
+    if (!table || !address)
+    {
+        return NULL;
+    }
+
+    // Senders are hashed by address only, so that all those of an address
+    // are found by CARemoveBLESendersOfAddress().
+    CABLESenderKey_t key = { .address = address, .port = port };
+    u_hashmap_entry_t *entry = u_hashmap_find(table->senders, CAHashBLESenderAddress(address),
+                                              &key, CAMatchBLESender);
+    return entry ? U_HASHMAP_CONTAINER(entry, CABLESenderInfo_t, entry) : NULL;
+}
+
+CAResult_t CAAddBLESenderInfo(CABLESenderTable_t *table, CABLESenderInfo_t *info)
+{
+    VERIFY_NON_NULL(table, TAG, "table is NULL");
+    VERIFY_NON_NULL(info, TAG, "info is NULL");
+    VERIFY_NON_NULL(info->remoteEndpoint, TAG, "remoteEndpoint is NULL");
+
+    if (!table->senders)
+    {
+        table->senders = u_hashmap_create();
+        if (!table->senders)
+        {
+            OIC_LOG(ERROR, TAG, "out of memory");
+            return CA_MEMORY_ALLOC_FAILED;
+        }
+    }
+
+    u_hashmap_add(table->senders, &info->entry,
+                  CAHashBLESenderAddress(info->remoteEndpoint->addr));
+    return CA_STATUS_OK;
+}
+
+void CARemoveBLESenderInfo(CABLESenderTable_t *table, CABLESenderInfo_t *info)
+{
+    if (!table || !info)
+    {
+        return;
+    }
+
+    u_hashmap_remove(table->senders, &info->entry);
+}
+
+void CARemoveBLESendersOfAddress(CABLESenderTable_t *table, const char *address)
+{
+    if (!table || !address)
+    {
+        return;
+    }
+
+    u_hashmap_entry_t *entry = u_hashmap_find(table->senders, CAHashBLESenderAddress(address),
+                                              address, CAMatchBLESenderAddress);
+    while (entry)
+    {
+        u_hashmap_entry_t *next = u_hashmap_find_next(table->senders, entry,
+                                                      address, CAMatchBLESenderAddress);
+        CABLESenderInfo_t *info = U_HASHMAP_CONTAINER(entry, CABLESenderInfo_t, entry);
+        OIC_LOG_V(DEBUG, TAG, "remove sender of %s:%u", address,
+                  (uint32_t)info->remoteEndpoint->port);
+        u_hashmap_remove(table->senders, entry);
+        CADestroyBLESenderInfo(info);
+        entry = next;
+    }
+}
+
+void CAClearBLESenderInfo(CABLESenderTable_t *table)
+{
+    if (!table)
+    {
+        return;
+    }
+
+    u_hashmap_entry_t *entry = u_hashmap_next(table->senders, NULL);
+    while (entry)
+    {
+        u_hashmap_entry_t *next = u_hashmap_next(table->senders, entry);
+        CADestroyBLESenderInfo(U_HASHMAP_CONTAINER(entry, CABLESenderInfo_t, entry));
+        entry = next;
+    }
+    u_hashmap_free(&table->senders);
+}
+
+void CADestroyBLESenderInfo(CABLESenderInfo_t *info)
+{
+    if (!info)
+    {
+        return;
+    }
+
+    OICFree(info->defragData);
+    CAFreeEndpoint(info->remoteEndpoint);
+    OICFree(info);
+}
@@ -36,6 +36,8 @@
 #if defined(__TIZEN__) || defined(__ANDROID__)
 #include "caleserver.h"
 #include "caleclient.h"
+#elif defined(LE_LOOPBACK)
+#include "caleloopback.h"
 #endif
 #include "oic_malloc.h"
 #include "oic_string.h"
@@ -47,19 +49,6 @@
  */
 #define CALEADAPTER_TAG "OIC_CA_LE_ADAP"
 
-/**
- * Stores information of all the senders.
- *
- * This structure will be used to track and defragment all incoming data packet.
- */
-typedef struct
-{
-    uint32_t recvDataLen;
-    uint32_t totalDataLen;
-    uint8_t *defragData;
-    CAEndpoint_t *remoteEndpoint;
- } CABLESenderInfo_t;
-
 typedef enum
 {
     ADAPTER_EMPTY = 1,
@@ -271,12 +260,12 @@ static bool g_dataBleClientReceiverHandlerState = false;
 /**
  * Sender information of Server.
  */
-static u_arraylist_t *g_bleServerSenderInfo = NULL;
+static CABLESenderTable_t g_bleServerSenderInfo;
 
 /**
  * Sender information of Client.
  */
-static u_arraylist_t *g_bleClientSenderInfo = NULL;
+static CABLESenderTable_t g_bleClientSenderInfo;
 
 /**
  * Queue to process the outgoing packets from GATTServer.
@@ -473,7 +462,7 @@ static CAResult_t CAInitLEClientReceiverQueue(void);
 static CALEData_t *CACreateLEData(const CAEndpoint_t *remoteEndpoint,
                                   const uint8_t *data,
                                   uint32_t dataLength,
-                                  u_arraylist_t *senderInfo);
+                                  CABLESenderTable_t *senderInfo);
 
 /**
  * Used to free the BLE information stored in the sender/receiver
@@ -502,43 +491,16 @@ static void CALERemoveSendQueueData(CAQueueingThread_t *queueHandle,
 /**
  * remove all received data of data list from receive queue.
  *
- * @param[in] dataInfoList   received data list to remove for client / server.
+ * @param[in] senderInfo     received data list to remove for client / server.
+ *                           Multi application can have more than 2 senders
+ *                           using same BLE address, all of them are removed.
+ * @param[in] mutex          mutex related to receiver for client / server.
  * @param[in] address        target address to remove data in queue.
  */
-static void CALERemoveReceiveQueueData(u_arraylist_t *dataInfoList,
+static void CALERemoveReceiveQueueData(CABLESenderTable_t *senderInfo,
+                                       oc_mutex mutex,
                                        const char* address);
 
-/**
- * get received data info and positioned index from the received data list
- * for client / server which is matched same leAddress and port.
- *
- * @param[in]  leAddress       target address to get serderInfo.
- * @param[in]  port            target port to get serderInfo.
- * @param[in]  senderInfoList  received data list for client / server.
- * @param[out] senderInfo      Pointer to contain matched(leAddress and port)
- *                             received data info.
- * @param[out] senderIndex     Pointer to contain matched(leAddress and port)
- *                             received data info index.
- */
-static CAResult_t CALEGetSenderInfo(const char *leAddress,
-                                    const uint16_t port,
-                                    u_arraylist_t *senderInfoList,
-                                    CABLESenderInfo_t **senderInfo,
-                                    size_t *senderIndex);
-
-/**
- * get ports related to remote address. It is need because multi application
- * can have more than 2 senderInfo using same BLE address. So before remove
- * receive queue data, should get port list from sender Info.
- *
- * @param[in]  leAddress       target address to get port in serderInfo.
- * @param[in]  senderInfoList  received data list to remove for client / server.
- * @param[out] portList        target port list related to leAddress.
- */
-static CAResult_t CALEGetPortsFromSenderInfo(const char *leAddress,
-                                            u_arraylist_t *senderInfoList,
-                                            u_arraylist_t *portList);
-
 static CAResult_t CAInitLEClientQueues(void)
 {
     oc_mutex_lock(g_bleAdapterThreadPoolMutex);
@@ -551,19 +513,10 @@ static CAResult_t CAInitLEClientQueues(void)
         return CA_STATUS_FAILED;
     }
 
-    g_bleClientSenderInfo = u_arraylist_create();
-    if (!g_bleClientSenderInfo)
-    {
-        OIC_LOG(ERROR, CALEADAPTER_TAG, "memory allocation failed!");
-        oc_mutex_unlock(g_bleAdapterThreadPoolMutex);
-        return CA_MEMORY_ALLOC_FAILED;
-    }
-
     result = CAInitLEClientReceiverQueue();
     if (CA_STATUS_OK != result)
     {
         OIC_LOG(ERROR, CALEADAPTER_TAG, "CAInitLEClientReceiverQueue failed");
-        u_arraylist_free(&g_bleClientSenderInfo);
         oc_mutex_unlock(g_bleAdapterThreadPoolMutex);
         return CA_STATUS_FAILED;
     }
@@ -627,19 +580,10 @@ static CAResult_t CAInitLEServerQueues(void)
         return CA_STATUS_FAILED;
     }
 
-    g_bleServerSenderInfo = u_arraylist_create();
-    if (!g_bleServerSenderInfo)
-    {
-        OIC_LOG(ERROR, CALEADAPTER_TAG, "memory allocation failed!");
-        oc_mutex_unlock(g_bleAdapterThreadPoolMutex);
-        return CA_MEMORY_ALLOC_FAILED;
-    }
-
     result = CAInitLEServerReceiverQueue();
     if (CA_STATUS_OK != result)
     {
         OIC_LOG(ERROR, CALEADAPTER_TAG, "CAInitLEServerReceiverQueue failed");
-        u_arraylist_free(&g_bleServerSenderInfo);
         oc_mutex_unlock(g_bleAdapterThreadPoolMutex);
         return CA_STATUS_FAILED;
     }
@@ -744,87 +688,28 @@ static void CALEServerSendDataThread(void *threadData)
         return;
     }
 
-#if defined(__TIZEN__) || defined(__ANDROID__)
+#if defined(__TIZEN__) || defined(__ANDROID__) || defined(LE_LOOPBACK)
     // get MTU size
     g_mtuSize = CALEServerGetMtuSize(bleData->remoteEndpoint->addr);
 #endif
     OIC_LOG_V(INFO, CALEADAPTER_TAG, "MTU size [%d]", g_mtuSize);
 
-    uint32_t midPacketCount = 0;
-    size_t remainingLen = 0;
-    size_t totalLength = 0;
-    CABLEPacketSecure_t secureFlag = CA_BLE_PACKET_NON_SECURE;
-
-    CAResult_t result = CAGenerateVariableForFragmentation(bleData->dataLen,
-                                                           &midPacketCount,
-                                                           &remainingLen,
-                                                           &totalLength,
-                                                           g_mtuSize);
-
-    if (CA_STATUS_OK != result)
-    {
-        OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                  "CAGenerateVariableForFragmentation failed, result [%d]", result);
-        if (g_errorHandler)
-        {
-            g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-        }
-        return;
-    }
-
-    OIC_LOG_V(DEBUG, CALEADAPTER_TAG,
-              "Packet info: data size[%d] midPacketCount[%u] remainingLen[%" PRIuPTR "] totalLength[%" PRIuPTR "]",
-              bleData->dataLen, midPacketCount, remainingLen, totalLength);
-
-    OIC_LOG_V(DEBUG,
-              CALEADAPTER_TAG,
-              "Server total Data length with header is [%" PRIuPTR "]",
-              totalLength);
-
-    uint8_t dataSegment[CA_SUPPORTED_BLE_MTU_SIZE] = {0};
-    uint8_t dataHeader[CA_BLE_HEADER_SIZE] = {0};
-
-    if (NULL != bleData->remoteEndpoint) //Unicast Data
-    {
-        secureFlag = (bleData->remoteEndpoint->flags & CA_SECURE) ?
-            CA_BLE_PACKET_SECURE : CA_BLE_PACKET_NON_SECURE;
-
-        OIC_LOG_V(DEBUG, CALEADAPTER_TAG, "This Packet is secure? %d", secureFlag);
-        result = CAGenerateHeader(dataHeader,
-                                  CA_BLE_PACKET_START,
-                                  g_localBLESourcePort,
-                                  secureFlag,
-                                  bleData->remoteEndpoint->port);
-    }
-    else                                //Multicast Data
-    {
-        result = CAGenerateHeader(dataHeader,
-                                  CA_BLE_PACKET_START,
-                                  g_localBLESourcePort,
-                                  secureFlag,
-                                  CA_BLE_MULTICAST_PORT);
-    }
-
-    if (CA_STATUS_OK != result)
-    {
-        OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                  "CAGenerateHeader failed, result [%d]", result);
-        if (g_errorHandler)
-        {
-            g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-        }
-        return;
-    }
-
-    uint8_t lengthHeader[CA_BLE_LENGTH_HEADER_SIZE] = {0};
-    result = CAGenerateHeaderPayloadLength(lengthHeader,
-                                           CA_BLE_LENGTH_HEADER_SIZE,
-                                           bleData->dataLen);
-
+    const CABLEPacketSecure_t secureFlag = (bleData->remoteEndpoint->flags & CA_SECURE) ?
+        CA_BLE_PACKET_SECURE : CA_BLE_PACKET_NON_SECURE;
+    OIC_LOG_V(DEBUG, CALEADAPTER_TAG, "This Packet is secure? %d", secureFlag);
+
+    CABLESegmenter_t segmenter;
+    CAResult_t result = CAInitBLESegmenter(&segmenter,
+                                           bleData->data,
+                                           bleData->dataLen,
+                                           g_mtuSize,
+                                           g_localBLESourcePort,
+                                           secureFlag,
+                                           bleData->remoteEndpoint->port);
     if (CA_STATUS_OK != result)
     {
         OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                  "CAGenerateHeaderPayloadLength failed, result [%d]", result);
+                  "CAInitBLESegmenter failed, result [%d]", result);
         if (g_errorHandler)
         {
             g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
@@ -832,317 +717,39 @@ static void CALEServerSendDataThread(void *threadData)
         return;
     }
 
-    uint32_t length = 0;
-    uint32_t dataLen = 0;
-    if (g_mtuSize > totalLength)
-    {
-        length = totalLength;
-        dataLen = bleData->dataLen;
-    }
-    else
-    {
-        length = g_mtuSize;
-        dataLen = g_mtuSize - CA_BLE_HEADER_SIZE - CA_BLE_LENGTH_HEADER_SIZE;
-    }
-
-    result = CAMakeFirstDataSegment(dataSegment,
-                                    bleData->data, dataLen,
-                                    dataHeader, lengthHeader);
+    OIC_LOG(DEBUG, CALEADAPTER_TAG, "Server Sending Unicast Data");
 
-    if (CA_STATUS_OK != result)
+    // Segments point into the data, each is framed once for the GATT layer.
+    uint8_t dataSegment[CA_SUPPORTED_BLE_MTU_SIZE];
+    CABLESegment_t segment;
+    while (CAGetNextBLESegment(&segmenter, &segment))
     {
-        OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                  "Making data segment failed, result [%d]", result);
-        if (g_errorHandler)
-        {
-            g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-        }
-        return;
-    }
-
-    const uint32_t iter = midPacketCount;
-    uint32_t index = 0;
-
-    // Send the first segment with the header.
-    if (NULL != bleData->remoteEndpoint) // Sending Unicast Data
-    {
-        OIC_LOG(DEBUG, CALEADAPTER_TAG, "Server Sending Unicast Data");
-
-        result = CAUpdateCharacteristicsToGattClient(
-                    bleData->remoteEndpoint->addr, dataSegment, length);
-
-        if (CA_STATUS_OK != result)
-        {
-            OIC_LOG_V(ERROR,
-                      CALEADAPTER_TAG,
-                      "Update characteristics failed, result [%d]",
-                      result);
-            if (g_errorHandler)
-            {
-                g_errorHandler(bleData->remoteEndpoint,
-                               bleData->data,
-                               bleData->dataLen,
-                               result);
-            }
-            return;
-        }
-
-        OIC_LOG_V(DEBUG,
-                  CALEADAPTER_TAG,
-                  "Server Sent Unicast First Data - data length [%u]",
-                  length);
-
-        result = CAGenerateHeader(dataHeader,
-                                  CA_BLE_PACKET_NOT_START,
-                                  g_localBLESourcePort,
-                                  secureFlag,
-                                  bleData->remoteEndpoint->port);
+        const uint32_t length = CACopyBLESegment(&segment, dataSegment, sizeof(dataSegment));
+        result = CAUpdateCharacteristicsToGattClient(bleData->remoteEndpoint->addr,
+                                                     dataSegment, length);
 
         if (CA_STATUS_OK != result)
         {
             OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                      "CAGenerateHeader failed, result [%d]", result);
+                      "Update characteristics failed, result [%d]", result);
             if (g_errorHandler)
             {
                 g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
             }
             return;
         }
-
-        for (index = 0; index < iter; index++)
-        {
-            // Send the remaining header.
-            result = CAMakeRemainDataSegment(dataSegment,
-                                             g_mtuSize - CA_BLE_HEADER_SIZE,
-                                             bleData->data,
-                                             bleData->dataLen,
-                                             index,
-                                             dataHeader,
-                                             g_mtuSize);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                            "Making data segment failed, result [%d]", result);
-                if (g_errorHandler)
-                {
-                    g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-                }
-                return;
-            }
-
-            result =
-                CAUpdateCharacteristicsToGattClient(
-                    bleData->remoteEndpoint->addr,
-                    dataSegment,
-                    g_mtuSize);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                            "Update characteristics failed, result [%d]", result);
-                if (g_errorHandler)
-                {
-                    g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-                }
-                return;
-            }
-            OIC_LOG_V(DEBUG, CALEADAPTER_TAG, "Server Sent data length [%d]",
-                                               g_mtuSize);
-        }
-
-        if (remainingLen && (totalLength > g_mtuSize))
-        {
-            // send the last segment of the data (Ex: 22 bytes of 622
-            // bytes of data when MTU is 200)
-            result = CAMakeRemainDataSegment(dataSegment,
-                                             remainingLen,
-                                             bleData->data,
-                                             bleData->dataLen,
-                                             index,
-                                             dataHeader,
-                                             g_mtuSize);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                            "Making data segment failed, result [%d]", result);
-                if (g_errorHandler)
-                {
-                    g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-                }
-                return;
-            }
-
-            result = CAUpdateCharacteristicsToGattClient(
-                         bleData->remoteEndpoint->addr,
-                         dataSegment,
-                         remainingLen + CA_BLE_HEADER_SIZE);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR,
-                          CALEADAPTER_TAG,
-                          "Update characteristics failed, result [%d]",
-                          result);
-                if (g_errorHandler)
-                {
-                    g_errorHandler(bleData->remoteEndpoint,
-                                   bleData->data,
-                                   bleData->dataLen,
-                                   result);
-                }
-                return;
-            }
-            OIC_LOG_V(DEBUG,
-                      CALEADAPTER_TAG,
-                      "Server Sent Unicast Last Data - data length [%" PRIuPTR "]",
-                      remainingLen + CA_BLE_HEADER_SIZE);
-        }
-     }
-    else
-    {
-        OIC_LOG(DEBUG, CALEADAPTER_TAG, "Server Sending Multicast data");
-#if defined(__TIZEN__)
-        // @todo
-        // tizen ble should also disabled when Tizen 3.0 is updated.
-        result = CAUpdateCharacteristicsToAllGattClients(dataSegment, length);
-        if (CA_STATUS_OK != result)
-        {
-            OIC_LOG_V(ERROR, CALEADAPTER_TAG, "Update characteristics failed, result [%d]",
-                      result);
-            CALEErrorHandler(NULL, bleData->data, bleData->dataLen, result);
-            return;
-        }
-
-        result = CAGenerateHeader(dataHeader,
-                                  CA_BLE_PACKET_NOT_START,
-                                  g_localBLESourcePort,
-                                  secureFlag,
-                                  CA_BLE_MULTICAST_PORT);
-
-        if (CA_STATUS_OK != result)
-        {
-            OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                      "CAGenerateHeader failed, result [%d]", result);
-            if (g_errorHandler)
-            {
-                g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-            }
-            return;
-        }
-        OIC_LOG_V(DEBUG,
-                  CALEADAPTER_TAG,
-                  "Server Sent Multicast First Data - data length [%zu]",
-                  length);
-
-        for (index = 0; index < iter; index++)
-        {
-            // Send the remaining header.
-            result = CAMakeRemainDataSegment(dataSegment,
-                                             CA_BLE_NORMAL_SEGMENT_PAYLOAD_SIZE,
-                                             bleData->data,
-                                             bleData->dataLen,
-                                             index,
-                                             dataHeader);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                            "Making data segment failed, result [%d]", result);
-                if (g_errorHandler)
-                {
-                    g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-                }
-                return;
-            }
-
-            result = CAUpdateCharacteristicsToAllGattClients(
-                         dataSegment,
-                         CA_SUPPORTED_BLE_MTU_SIZE);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG, "Update characteristics failed, result [%d]",
-                          result);
-                CALEErrorHandler(NULL, bleData->data, bleData->dataLen, result);
-                return;
-            }
-            OIC_LOG_V(DEBUG,
-                      CALEADAPTER_TAG,
-                      "Server Sent Multicast %d Data - data length [%zu]",
-                      index + 1,
-                      CA_SUPPORTED_BLE_MTU_SIZE);
-        }
-
-        if (remainingLen && (totalLength > CA_SUPPORTED_BLE_MTU_SIZE))
-        {
-            // send the last segment of the data (Ex: 22 bytes of 622
-            // bytes of data when MTU is 200)
-            result = CAMakeRemainDataSegment(dataSegment,
-                                             remainingLen,
-                                             bleData->data,
-                                             bleData->dataLen,
-                                             index,
-                                             dataHeader);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                            "Making data segment failed, result [%d]", result);
-                if (g_errorHandler)
-                {
-                    g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-                }
-                return;
-            }
-
-            result = CAUpdateCharacteristicsToAllGattClients(
-                         dataSegment,
-                         remainingLen + CA_BLE_HEADER_SIZE);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG, "Update characteristics failed, result [%d]",
-                          result);
-                CALEErrorHandler(NULL, bleData->data, bleData->dataLen, result);
-                return;
-            }
-            OIC_LOG_V(DEBUG,
-                      CALEADAPTER_TAG,
-                      "Server Sent Multicast Last Data - data length [%" PRIuPTR "]",
-                      remainingLen + CA_BLE_HEADER_SIZE);
-        }
-#else
-        OIC_LOG(DEBUG, CALEADAPTER_TAG, "BLE Multicast is not supported");
-#endif
+        OIC_LOG_V(DEBUG, CALEADAPTER_TAG,
+                  "Server Sent Unicast Data - data length [%u]", length);
     }
 
     OIC_LOG(DEBUG, CALEADAPTER_TAG, "OUT - CALEServerSendDataThread");
 }
 #endif // not ROUTING_GATEWAY not SINGLE_THREAD
 
-static void CALEClearSenderInfoImpl(u_arraylist_t ** list)
-{
-    const size_t length = u_arraylist_length(*list);
-    for (size_t i = 0; i < length; ++i)
-    {
-        CABLESenderInfo_t * const info =
-                (CABLESenderInfo_t *) u_arraylist_get(*list, i);
-        if (info)
-         {
-             OICFree(info->defragData);
-             CAFreeEndpoint(info->remoteEndpoint);
-             OICFree(info);
-         }
-    }
-    u_arraylist_free(list);
-}
-
 static void CALEClearSenderInfo(void)
 {
-    CALEClearSenderInfoImpl(&g_bleServerSenderInfo);
-    CALEClearSenderInfoImpl(&g_bleClientSenderInfo);
+    CAClearBLESenderInfo(&g_bleServerSenderInfo);
+    CAClearBLESenderInfo(&g_bleClientSenderInfo);
 }
 
 static CAResult_t CAInitLEClientSenderQueue(void)
@@ -1217,48 +824,6 @@ static void CATerminateLEQueues(void)
     CALEClearSenderInfo();
 }
 
-static CAResult_t CALEGetSenderInfo(const char *leAddress,
-                                    const uint16_t port,
-                                    u_arraylist_t *senderInfoList,
-                                    CABLESenderInfo_t **senderInfo,
-                                    size_t *senderIndex)
-{
-    VERIFY_NON_NULL_RET(leAddress,
-                        CALEADAPTER_TAG,
-                        "NULL BLE address argument",
-                        CA_STATUS_INVALID_PARAM);
-    VERIFY_NON_NULL_RET(senderIndex,
-                        CALEADAPTER_TAG,
-                        "NULL index argument",
-                        CA_STATUS_INVALID_PARAM);
-
-    const size_t listLength = u_arraylist_length(senderInfoList);
-    const size_t addrLength = strlen(leAddress);
-    for (size_t index = 0; index < listLength; index++)
-    {
-        CABLESenderInfo_t *info = (CABLESenderInfo_t *) u_arraylist_get(senderInfoList, index);
-        if (!info || !(info->remoteEndpoint))
-        {
-            continue;
-        }
-
-        if (!strncmp(info->remoteEndpoint->addr, leAddress, addrLength))
-        {
-            if (info->remoteEndpoint->port == port)
-            {
-                *senderIndex = index;
-                if (senderInfo)
-                {
-                    *senderInfo = info;
-                }
-                return CA_STATUS_OK;
-            }
-        }
-    }
-
-    return CA_STATUS_FAILED;
-}
-
 static void CALEDataReceiverHandler(void *threadData, CABLEAdapter_t receiverType)
 {
     OIC_LOG(DEBUG, CALEADAPTER_TAG, "CALEDataReceiverHandler");
@@ -1316,8 +881,14 @@ static void CALEDataReceiverHandler(void *threadData, CABLEAdapter_t receiverTyp
             return;
         }
 
-        CABLESenderInfo_t *senderInfo = NULL;
-        size_t senderIndex = 0;
+        CABLESenderTable_t *senderTable = bleData->senderInfo;
+
+        if (bleData->dataLen < CA_BLE_HEADER_SIZE)
+        {
+            OIC_LOG(ERROR, CALEADAPTER_TAG, "This packet is too short! ignore.");
+            oc_mutex_unlock(bleReceiveDataMutex);
+            return;
+        }
 
         //packet parsing
         CABLEPacketStart_t startFlag = CA_BLE_PACKET_NOT_START;
@@ -1341,62 +912,44 @@ static void CALEDataReceiverHandler(void *threadData, CABLEAdapter_t receiverTyp
 
         bleData->remoteEndpoint->port = sourcePort;
 
-        if (CA_STATUS_OK != CALEGetSenderInfo(bleData->remoteEndpoint->addr,
-                                              bleData->remoteEndpoint->port,
-                                              bleData->senderInfo,
-                                              &senderInfo, &senderIndex))
+        CABLESenderInfo_t *senderInfo = CAGetBLESenderInfo(senderTable,
+                                                           bleData->remoteEndpoint->addr,
+                                                           bleData->remoteEndpoint->port);
+        if (!senderInfo)
         {
             OIC_LOG_V(DEBUG, CALEADAPTER_TAG, "This is a new client [%s:%X]",
                       bleData->remoteEndpoint->addr, bleData->remoteEndpoint->port);
         }
-        else
+        else if (startFlag)
         {
-            if (startFlag)
-            {
-                OIC_LOG(ERROR, CALEADAPTER_TAG,
-                        "This packet is start packet but exist senderInfo. Remove senderInfo");
-                u_arraylist_remove(bleData->senderInfo, senderIndex);
-                OICFree(senderInfo->defragData);
-                OICFree(senderInfo);
-                senderInfo = NULL;
-                senderIndex = 0;
-            }
+            OIC_LOG(ERROR, CALEADAPTER_TAG,
+                    "This packet is start packet but exist senderInfo. Remove senderInfo");
+            CARemoveBLESenderInfo(senderTable, senderInfo);
+            CADestroyBLESenderInfo(senderInfo);
+            senderInfo = NULL;
         }
 
         if (!senderInfo)
         {
             uint32_t totalLength = 0;
-            if (startFlag)
-            {
-                CAParseHeaderPayloadLength(bleData->data, CA_BLE_LENGTH_HEADER_SIZE, &totalLength);
-            }
-            else
+            if (!startFlag)
             {
                 OIC_LOG(ERROR, CALEADAPTER_TAG, "This packet is wrong packet! ignore.");
                 oc_mutex_unlock(bleReceiveDataMutex);
                 return;
             }
-
-            CABLESenderInfo_t *newSender = OICMalloc(sizeof(CABLESenderInfo_t));
-            if (!newSender)
+            if (bleData->dataLen < CA_BLE_HEADER_SIZE + CA_BLE_LENGTH_HEADER_SIZE)
             {
-                OIC_LOG(ERROR, CALEADAPTER_TAG, "Memory allocation failed for new sender");
+                OIC_LOG(ERROR, CALEADAPTER_TAG, "Start packet is too short! ignore.");
                 oc_mutex_unlock(bleReceiveDataMutex);
                 return;
             }
-            newSender->recvDataLen = 0;
-            newSender->totalDataLen = 0;
-            newSender->defragData = NULL;
-            newSender->remoteEndpoint = NULL;
 
             OIC_LOG(DEBUG, CALEADAPTER_TAG, "Parsing the header");
-
-            newSender->totalDataLen = totalLength;
-
-            if (!(newSender->totalDataLen))
+            CAParseHeaderPayloadLength(bleData->data, CA_BLE_LENGTH_HEADER_SIZE, &totalLength);
+            if (!totalLength)
             {
                 OIC_LOG(ERROR, CALEADAPTER_TAG, "Total Data Length is parsed as 0!!!");
-                OICFree(newSender);
                 oc_mutex_unlock(bleReceiveDataMutex);
                 return;
             }
@@ -1404,17 +957,30 @@ static void CALEDataReceiverHandler(void *threadData, CABLEAdapter_t receiverTyp
             size_t dataOnlyLen =
                 bleData->dataLen - (CA_BLE_HEADER_SIZE + CA_BLE_LENGTH_HEADER_SIZE);
             OIC_LOG_V(DEBUG, CALEADAPTER_TAG, "Total data to be accumulated [%u] bytes",
-                      newSender->totalDataLen);
+                      totalLength);
             OIC_LOG_V(DEBUG, CALEADAPTER_TAG, "data received in the first packet [%" PRIuPTR "] bytes",
                       dataOnlyLen);
+            if (dataOnlyLen > totalLength)
+            {
+                OIC_LOG(ERROR, CALEADAPTER_TAG, "buffer is smaller than received data");
+                oc_mutex_unlock(bleReceiveDataMutex);
+                return;
+            }
 
+            CABLESenderInfo_t *newSender = OICCalloc(1, sizeof(CABLESenderInfo_t));
+            if (!newSender)
+            {
+                OIC_LOG(ERROR, CALEADAPTER_TAG, "Memory allocation failed for new sender");
+                oc_mutex_unlock(bleReceiveDataMutex);
+                return;
+            }
+            newSender->totalDataLen = totalLength;
             newSender->defragData = OICCalloc(newSender->totalDataLen + 1,
                                               sizeof(*newSender->defragData));
-
             if (NULL == newSender->defragData)
             {
                 OIC_LOG(ERROR, CALEADAPTER_TAG, "defragData is NULL!");
-                OICFree(newSender);
+                CADestroyBLESenderInfo(newSender);
                 oc_mutex_unlock(bleReceiveDataMutex);
                 return;
             }
@@ -1431,46 +997,20 @@ static void CALEDataReceiverHandler(void *threadData, CABLEAdapter_t receiverTyp
                                                                CA_ADAPTER_GATT_BTLE,
                                                                remoteAddress,
                                                                bleData->remoteEndpoint->port);
-
             if (NULL == newSender->remoteEndpoint)
             {
                 OIC_LOG(ERROR, CALEADAPTER_TAG, "remoteEndpoint is NULL!");
-                OICFree(newSender->defragData);
-                OICFree(newSender);
+                CADestroyBLESenderInfo(newSender);
                 oc_mutex_unlock(bleReceiveDataMutex);
                 return;
             }
 
-            if (newSender->recvDataLen + dataOnlyLen > newSender->totalDataLen)
-            {
-                OIC_LOG(ERROR, CALEADAPTER_TAG, "buffer is smaller than received data");
-                OICFree(newSender->defragData);
-                CAFreeEndpoint(newSender->remoteEndpoint);
-                OICFree(newSender);
-                oc_mutex_unlock(bleReceiveDataMutex);
-                return;
-            }
             memcpy(newSender->defragData,
                    bleData->data + (CA_BLE_HEADER_SIZE + CA_BLE_LENGTH_HEADER_SIZE),
                    dataOnlyLen);
             newSender->recvDataLen += dataOnlyLen;
 
-            u_arraylist_add(bleData->senderInfo,(void *)newSender);
-
-            //Getting newSender index position in bleSenderInfo array list
-            if (CA_STATUS_OK !=
-                    CALEGetSenderInfo(newSender->remoteEndpoint->addr,
-                                      newSender->remoteEndpoint->port,
-                                      bleData->senderInfo,
-                                      NULL, &senderIndex))
-            {
-                OIC_LOG(ERROR, CALEADAPTER_TAG, "Existing sender index not found!!");
-                OICFree(newSender->defragData);
-                CAFreeEndpoint(newSender->remoteEndpoint);
-                OICFree(newSender);
-                oc_mutex_unlock(bleReceiveDataMutex);
-                return;
-            }
+            CAAddBLESenderInfo(senderTable, newSender);
             senderInfo = newSender;
         }
         else
@@ -1481,9 +1021,8 @@ static void CALEDataReceiverHandler(void *threadData, CABLEAdapter_t receiverTyp
                 OIC_LOG_V(ERROR, CALEADAPTER_TAG,
                           "Data Length exceeding error!! Receiving [%" PRIuPTR "] total length [%u]",
                           senderInfo->recvDataLen + dataOnlyLen, senderInfo->totalDataLen);
-                u_arraylist_remove(bleData->senderInfo, senderIndex);
-                OICFree(senderInfo->defragData);
-                OICFree(senderInfo);
+                CARemoveBLESenderInfo(senderTable, senderInfo);
+                CADestroyBLESenderInfo(senderInfo);
                 oc_mutex_unlock(bleReceiveDataMutex);
                 return;
             }
@@ -1499,14 +1038,15 @@ static void CALEDataReceiverHandler(void *threadData, CABLEAdapter_t receiverTyp
 
         if (senderInfo->totalDataLen == senderInfo->recvDataLen)
         {
+            // The message is complete, the sender is destroyed once it is delivered.
+            CARemoveBLESenderInfo(senderTable, senderInfo);
+
             oc_mutex_lock(g_bleAdapterReqRespCbMutex);
             if (NULL == g_networkPacketReceivedCallback)
             {
                 OIC_LOG(ERROR, CALEADAPTER_TAG, "gReqRespCallback is NULL!");
 
-                u_arraylist_remove(bleData->senderInfo, senderIndex);
-                OICFree(senderInfo->defragData);
-                OICFree(senderInfo);
+                CADestroyBLESenderInfo(senderInfo);
                 oc_mutex_unlock(g_bleAdapterReqRespCbMutex);
                 oc_mutex_unlock(bleReceiveDataMutex);
                 return;
@@ -1535,7 +1075,6 @@ static void CALEDataReceiverHandler(void *threadData, CABLEAdapter_t receiverTyp
                 {
                     OIC_LOG(ERROR, CALEADAPTER_TAG, "CAdecryptSsl successed");
                 }
-                OICFree(senderInfo->defragData);
             }
             else
             {
@@ -1549,10 +1088,7 @@ static void CALEDataReceiverHandler(void *threadData, CABLEAdapter_t receiverTyp
 #endif
 
             oc_mutex_unlock(g_bleAdapterReqRespCbMutex);
-            u_arraylist_remove(bleData->senderInfo, senderIndex);
-            senderInfo->remoteEndpoint = NULL;
-            senderInfo->defragData = NULL;
-            OICFree(senderInfo);
+            CADestroyBLESenderInfo(senderInfo);
         }
     }
     oc_mutex_unlock(bleReceiveDataMutex);
@@ -1605,63 +1141,27 @@ static void CALEClientSendDataThread(void *threadData)
         }
     }
     g_mtuSize = CALEClientGetMtuSize(bleData->remoteEndpoint->addr);
+#elif defined(LE_LOOPBACK)
+    g_mtuSize = CALEClientGetMtuSize(bleData->remoteEndpoint->addr);
 #endif
     OIC_LOG_V(INFO, CALEADAPTER_TAG, "MTU size [%d]", g_mtuSize);
 
-    uint32_t midPacketCount = 0;
-    size_t remainingLen = 0;
-    size_t totalLength = 0;
-    CABLEPacketSecure_t secureFlag = CA_BLE_PACKET_NON_SECURE;
-
-    CAResult_t result = CAGenerateVariableForFragmentation(bleData->dataLen,
-                                                           &midPacketCount,
-                                                           &remainingLen,
-                                                           &totalLength,
-                                                           g_mtuSize);
-
-    if (CA_STATUS_OK != result)
-    {
-        OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                  "CAGenerateVariableForFragmentation failed, result [%d]", result);
-        if (g_errorHandler)
-        {
-            g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-        }
-        return;
-    }
-
-    OIC_LOG_V(DEBUG, CALEADAPTER_TAG,
-              "Packet info: data size[%d] midPacketCount[%u] remainingLen[%" PRIuPTR "] totalLength[%" PRIuPTR "]",
-              bleData->dataLen, midPacketCount, remainingLen, totalLength);
-
-    uint8_t dataSegment[CA_SUPPORTED_BLE_MTU_SIZE] = {0};
-    uint8_t dataHeader[CA_BLE_HEADER_SIZE] = {0};
-
-    if (NULL != bleData->remoteEndpoint) //Unicast Data
-    {
-        secureFlag = (bleData->remoteEndpoint->flags & CA_SECURE) ?
-            CA_BLE_PACKET_SECURE : CA_BLE_PACKET_NON_SECURE;
-
-        OIC_LOG_V(DEBUG, CALEADAPTER_TAG, "This Packet is secure? %d", secureFlag);
-        result = CAGenerateHeader(dataHeader,
-                                  CA_BLE_PACKET_START,
-                                  g_localBLESourcePort,
-                                  secureFlag,
-                                  bleData->remoteEndpoint->port);
-    }
-    else                                //Multicast Data
-    {
-        result = CAGenerateHeader(dataHeader,
-                                  CA_BLE_PACKET_START,
-                                  g_localBLESourcePort,
-                                  secureFlag,
-                                  CA_BLE_MULTICAST_PORT);
-    }
-
+    const CABLEPacketSecure_t secureFlag = (bleData->remoteEndpoint->flags & CA_SECURE) ?
+        CA_BLE_PACKET_SECURE : CA_BLE_PACKET_NON_SECURE;
+    OIC_LOG_V(DEBUG, CALEADAPTER_TAG, "This Packet is secure? %d", secureFlag);
+
+    CABLESegmenter_t segmenter;
+    CAResult_t result = CAInitBLESegmenter(&segmenter,
+                                           bleData->data,
+                                           bleData->dataLen,
+                                           g_mtuSize,
+                                           g_localBLESourcePort,
+                                           secureFlag,
+                                           bleData->remoteEndpoint->port);
     if (CA_STATUS_OK != result)
     {
         OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                  "CAGenerateHeader failed, result [%d]", result);
+                  "CAInitBLESegmenter failed, result [%d]", result);
         if (g_errorHandler)
         {
             g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
@@ -1669,320 +1169,39 @@ static void CALEClientSendDataThread(void *threadData)
         return;
     }
 
-    uint8_t lengthHeader[CA_BLE_LENGTH_HEADER_SIZE] = {0};
-    result = CAGenerateHeaderPayloadLength(lengthHeader,
-                                           CA_BLE_LENGTH_HEADER_SIZE,
-                                           bleData->dataLen);
-
-    if (CA_STATUS_OK != result)
-    {
-        OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                  "CAGenerateHeaderPayloadLength failed, result [%d]", result);
-        if (g_errorHandler)
-        {
-            g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-        }
-        return;
-    }
-
-    uint32_t length = 0;
-    uint32_t dataLen = 0;
-    if (g_mtuSize > totalLength)
-    {
-        length = totalLength;
-        dataLen = bleData->dataLen;
-    }
-    else
-    {
-        length = g_mtuSize;
-        dataLen = g_mtuSize - CA_BLE_HEADER_SIZE - CA_BLE_LENGTH_HEADER_SIZE;
-    }
-
-    result = CAMakeFirstDataSegment(dataSegment,
-                                    bleData->data, dataLen,
-                                    dataHeader, lengthHeader);
+    OIC_LOG(DEBUG, CALEADAPTER_TAG, "Client Sending Unicast Data");
 
-    if (CA_STATUS_OK != result)
+    // Segments point into the data, each is framed once for the GATT layer.
+    uint8_t dataSegment[CA_SUPPORTED_BLE_MTU_SIZE];
+    CABLESegment_t segment;
+    while (CAGetNextBLESegment(&segmenter, &segment))
     {
-        OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                  "Making data segment failed, result [%d]", result);
-        if (g_errorHandler)
-        {
-            g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-        }
-        return;
-    }
-
-    const uint32_t iter = midPacketCount;
-    uint32_t index = 0;
-    if (NULL != bleData->remoteEndpoint) //Sending Unicast Data
-    {
-        OIC_LOG(DEBUG, CALEADAPTER_TAG, "Sending Unicast Data");
-        // Send the first segment with the header.
-        result =
-            CAUpdateCharacteristicsToGattServer(
-                bleData->remoteEndpoint->addr,
-                dataSegment,
-                length,
-                LE_UNICAST,
-                0);
-
-        if (CA_STATUS_OK != result)
-        {
-            OIC_LOG_V(ERROR,
-                      CALEADAPTER_TAG,
-                      "Update characteristics failed, result [%d]",
-                      result);
-            if (g_errorHandler)
-            {
-                g_errorHandler(bleData->remoteEndpoint,
-                               bleData->data,
-                               bleData->dataLen,
-                               result);
-            }
-            return;
-        }
-        OIC_LOG_V(DEBUG,
-                  CALEADAPTER_TAG,
-                  "Client Sent Unicast First Data - data length [%u]",
-                  length);
-
-        result = CAGenerateHeader(dataHeader,
-                                  CA_BLE_PACKET_NOT_START,
-                                  g_localBLESourcePort,
-                                  secureFlag,
-                                  bleData->remoteEndpoint->port);
+        const uint32_t length = CACopyBLESegment(&segment, dataSegment, sizeof(dataSegment));
+        result = CAUpdateCharacteristicsToGattServer(bleData->remoteEndpoint->addr,
+                                                     dataSegment, length,
+                                                     LE_UNICAST, 0);
 
         if (CA_STATUS_OK != result)
         {
             OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                      "CAGenerateHeader failed, result [%d]", result);
+                      "Update characteristics failed, result [%d]", result);
             if (g_errorHandler)
             {
                 g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
             }
             return;
         }
-
-        for (index = 0; index < iter; index++)
-        {
-            result = CAMakeRemainDataSegment(dataSegment,
-                                             g_mtuSize - CA_BLE_HEADER_SIZE,
-                                             bleData->data,
-                                             bleData->dataLen,
-                                             index,
-                                             dataHeader,
-                                             g_mtuSize);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                            "Making data segment failed, result [%d]", result);
-                if (g_errorHandler)
-                {
-                    g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-                }
-                return;
-            }
-
-            // Send the remaining header.
-            result = CAUpdateCharacteristicsToGattServer(
-                     bleData->remoteEndpoint->addr,
-                     dataSegment,
-                     g_mtuSize,
-                     LE_UNICAST, 0);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR,
-                          CALEADAPTER_TAG,
-                          "Update characteristics failed, result [%d]",
-                          result);
-                if (g_errorHandler)
-                {
-                    g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-                }
-                return;
-            }
-            OIC_LOG_V(DEBUG,
-                      CALEADAPTER_TAG,
-                      "Client Sent Unicast %d Data - data(mtu) length [%u]",
-                      index + 1,
-                      g_mtuSize);
-        }
-
-        if (remainingLen && (totalLength > g_mtuSize))
-        {
-            // send the last segment of the data (Ex: 22 bytes of 622
-            // bytes of data when MTU is 200)
-            result = CAMakeRemainDataSegment(dataSegment,
-                                             remainingLen,
-                                             bleData->data,
-                                             bleData->dataLen,
-                                             index,
-                                             dataHeader,
-                                             g_mtuSize);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                            "Making data segment failed, result [%d]", result);
-                if (g_errorHandler)
-                {
-                    g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-                }
-                return;
-            }
-
-            result = CAUpdateCharacteristicsToGattServer(
-                     bleData->remoteEndpoint->addr,
-                     dataSegment,
-                     remainingLen + CA_BLE_HEADER_SIZE,
-                     LE_UNICAST, 0);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG, "Update characteristics failed, result [%d]",
-                                                   result);
-                if (g_errorHandler)
-                {
-                    g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-                }
-                return;
-            }
-            OIC_LOG_V(DEBUG,
-                      CALEADAPTER_TAG,
-                      "Client Sent Unicast Last Data - data length [%" PRIuPTR "]",
-                      remainingLen + CA_BLE_HEADER_SIZE);
-        }
+        OIC_LOG_V(DEBUG, CALEADAPTER_TAG,
+                  "Client Sent Unicast Data - data length [%u]", length);
     }
-    else
-    {
-#if defined(__TIZEN__)
-        // @todo
-        // tizen ble should also disabled when Tizen 3.0 is updated.
-        //Sending Mulitcast Data
-        // Send the first segment with the header.
-        OIC_LOG(DEBUG, CALEADAPTER_TAG, "Client Sending Multicast Data");
-        result = CAUpdateCharacteristicsToAllGattServers(dataSegment, length);
-        if (CA_STATUS_OK != result)
-        {
-            OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                      "Update characteristics (all) failed, result [%d]", result);
-            CALEErrorHandler(NULL, bleData->data, bleData->dataLen, result);
-            return;
-        }
-
-        result = CAGenerateHeader(dataHeader,
-                                  CA_BLE_PACKET_NOT_START,
-                                  g_localBLESourcePort,
-                                  secureFlag,
-                                  0);
-
-        if (CA_STATUS_OK != result)
-        {
-            OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                      "CAGenerateHeader failed, result [%d]", result);
-            if (g_errorHandler)
-            {
-                g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-            }
-            return;
-        }
-        OIC_LOG_V(DEBUG,
-                  CALEADAPTER_TAG,
-                  "Client Sent Multicast First Data - data length [%zu]",
-                  length);
-
-        for (index = 0; index < iter; index++)
-        {
-            // Send the remaining header.
-            result = CAMakeRemainDataSegment(dataSegment,
-                                             CA_BLE_NORMAL_SEGMENT_PAYLOAD_SIZE,
-                                             bleData->data,
-                                             bleData->dataLen,
-                                             index,
-                                             dataHeader);
 
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                            "Making data segment failed, result [%d]", result);
-                if (g_errorHandler)
-                {
-                    g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-                }
-                return;
-            }
-
-            result = CAUpdateCharacteristicsToAllGattServers(
-                         dataSegment,
-                         CA_SUPPORTED_BLE_MTU_SIZE);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG, "Update characteristics failed, result [%d]",
-                          result);
-                CALEErrorHandler(NULL, bleData->data, bleData->dataLen, result);
-                return;
-            }
-            OIC_LOG_V(DEBUG,
-                      CALEADAPTER_TAG,
-                      "Client Sent Multicast %d Data - data length [%zu]",
-                      index + 1,
-                      CA_SUPPORTED_BLE_MTU_SIZE);
-        }
-
-        if (remainingLen && (totalLength > CA_SUPPORTED_BLE_MTU_SIZE))
-        {
-            // send the last segment of the data (Ex: 22 bytes of 622
-            // bytes of data when MTU is 200)
-            result = CAMakeRemainDataSegment(dataSegment,
-                                             remainingLen,
-                                             bleData->data,
-                                             bleData->dataLen,
-                                             index,
-                                             dataHeader);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                            "Making data segment failed, result [%d]", result);
-                if (g_errorHandler)
-                {
-                    g_errorHandler(bleData->remoteEndpoint, bleData->data, bleData->dataLen, result);
-                }
-                return;
-            }
-
-            result =
-                CAUpdateCharacteristicsToAllGattServers(
-                    dataSegment,
-                    remainingLen + CA_BLE_HEADER_SIZE);
-
-            if (CA_STATUS_OK != result)
-            {
-                OIC_LOG_V(ERROR, CALEADAPTER_TAG,
-                          "Update characteristics (all) failed, result [%d]", result);
-                CALEErrorHandler(NULL, bleData->data, bleData->dataLen, result);
-                return;
-            }
-            OIC_LOG_V(DEBUG,
-                      CALEADAPTER_TAG,
-                      "Client Sent Multicast Last Data - data length [%" PRIuPTR "]",
-                      remainingLen + CA_BLE_HEADER_SIZE);
-        }
-#else
-        OIC_LOG(DEBUG, CALEADAPTER_TAG, "BLE Multicast is not supported");
-    }
-#endif
-    OIC_LOG(DEBUG, CALEADAPTER_TAG, "OUT - CABLEClientSendDataThread");
+    OIC_LOG(DEBUG, CALEADAPTER_TAG, "OUT - CALEClientSendDataThread");
 }
 
 static CALEData_t *CACreateLEData(const CAEndpoint_t *remoteEndpoint,
                                   const uint8_t *data,
                                   uint32_t dataLength,
-                                  u_arraylist_t *senderInfo)
+                                  CABLESenderTable_t *senderInfo)
 {
     CALEData_t * const bleData = OICMalloc(sizeof(CALEData_t));
 
@@ -2004,10 +1223,7 @@ static CALEData_t *CACreateLEData(const CAEndpoint_t *remoteEndpoint,
 
     memcpy(bleData->data, data, dataLength);
     bleData->dataLen = dataLength;
-    if (senderInfo)
-    {
-        bleData->senderInfo = senderInfo;
-    }
+    bleData->senderInfo = senderInfo;
 
     return bleData;
 }
@@ -3135,15 +2351,12 @@ static void CALEConnectionStateChangedCb(CATransportAdapter_t adapter, const cha
 
     if(!isConnected)
     {
-        if(g_bleClientSenderInfo)
-        {
-            CALERemoveReceiveQueueData(g_bleClientSenderInfo, address);
-        }
-
-        if(g_bleServerSenderInfo)
-        {
-            CALERemoveReceiveQueueData(g_bleServerSenderInfo, address);
-        }
+        CALERemoveReceiveQueueData(&g_bleClientSenderInfo,
+                                   g_bleClientReceiveDataMutex,
+                                   address);
+        CALERemoveReceiveQueueData(&g_bleServerSenderInfo,
+                                   g_bleServerReceiveDataMutex,
+                                   address);
 
         // remove data of send queue.
         if (g_bleClientSendQueueHandle)
@@ -3336,7 +2549,7 @@ static CAResult_t CALEAdapterServerReceivedData(const char *remoteAddress,
               dataLength);
 
     CALEData_t * const bleData =
-        CACreateLEData(remoteEndpoint, data, dataLength, g_bleServerSenderInfo);
+        CACreateLEData(remoteEndpoint, data, dataLength, &g_bleServerSenderInfo);
 
     if (!bleData)
     {
@@ -3383,7 +2596,7 @@ static CAResult_t CALEAdapterClientReceivedData(const char *remoteAddress,
               dataLength);
 
     CALEData_t * const bleData =
-        CACreateLEData(remoteEndpoint, data, dataLength, g_bleClientSenderInfo);
+        CACreateLEData(remoteEndpoint, data, dataLength, &g_bleClientSenderInfo);
 
     if (!bleData)
     {
@@ -3474,91 +2687,16 @@ static void CALERemoveSendQueueData(CAQueueingThread_t *queueHandle, oc_mutex mu
     oc_mutex_unlock(mutex);
 }
 
-static void CALERemoveReceiveQueueData(u_arraylist_t *dataInfoList, const char* address)
+static void CALERemoveReceiveQueueData(CABLESenderTable_t *senderInfo,
+                                       oc_mutex mutex,
+                                       const char* address)
 {
     OIC_LOG(DEBUG, CALEADAPTER_TAG, "CALERemoveReceiveQueueData");
 
-    VERIFY_NON_NULL_VOID(dataInfoList, CALEADAPTER_TAG, "dataInfoList");
+    VERIFY_NON_NULL_VOID(senderInfo, CALEADAPTER_TAG, "senderInfo");
     VERIFY_NON_NULL_VOID(address, CALEADAPTER_TAG, "address");
 
-    CABLESenderInfo_t *senderInfo = NULL;
-    size_t senderIndex = 0;
-
-    u_arraylist_t *portList = u_arraylist_create();
-    if (CA_STATUS_OK == CALEGetPortsFromSenderInfo(address, dataInfoList, portList))
-    {
-        size_t arrayLength = u_arraylist_length(portList);
-        for (size_t i = 0; i < arrayLength; i++)
-        {
-            uint16_t *port = (uint16_t *)u_arraylist_get(portList, i);
-            if (!port)
-            {
-                OIC_LOG(ERROR, CALEADAPTER_TAG, "Failed to get port from sender info !");
-                u_arraylist_destroy(portList);
-                return;
-            }
-
-            OIC_LOG_V(DEBUG, CALEADAPTER_TAG, "port : %X", *port);
-
-            if (CA_STATUS_OK == CALEGetSenderInfo(address, *port,
-                                                  dataInfoList, &senderInfo,
-                                                  &senderIndex))
-            {
-                u_arraylist_remove(dataInfoList, senderIndex);
-                OICFree(senderInfo->defragData);
-                OICFree(senderInfo->remoteEndpoint);
-                OICFree(senderInfo);
-
-                OIC_LOG(DEBUG, CALEADAPTER_TAG,
-                        "SenderInfo is removed for disconnection");
-            }
-            else
-            {
-                OIC_LOG(DEBUG, CALEADAPTER_TAG, "SenderInfo doesn't exist");
-            }
-        }
-    }
-    u_arraylist_destroy(portList);
-}
-
-static CAResult_t CALEGetPortsFromSenderInfo(const char *leAddress,
-                                            u_arraylist_t *senderInfoList,
-                                            u_arraylist_t *portList)
-{
-    VERIFY_NON_NULL(leAddress,
-                    CALEADAPTER_TAG,
-                    "NULL BLE address argument");
-
-    const size_t listLength = u_arraylist_length(senderInfoList);
-    const size_t addrLength = strlen(leAddress);
-
-    for (size_t index = 0; index < listLength; index++)
-    {
-        CABLESenderInfo_t *info = (CABLESenderInfo_t *) u_arraylist_get(senderInfoList, index);
-        if (!info || !(info->remoteEndpoint))
-        {
-            continue;
-        }
-
-        if (!strncmp(info->remoteEndpoint->addr, leAddress, addrLength))
-        {
-            uint16_t *port = (uint16_t *)OICMalloc(sizeof(uint16_t));
-            if (!port)
-            {
-                OIC_LOG(ERROR, CALEADAPTER_TAG, "memory allocation failed!");
-                return CA_MEMORY_ALLOC_FAILED;
-            }
-            *port = info->remoteEndpoint->port;
-            u_arraylist_add(portList, (void *)port);
-        }
-    }
-
-    if (u_arraylist_length(portList) != 0)
-    {
-        return CA_STATUS_OK;
-    }
-    else
-    {
-        return CA_STATUS_FAILED;
-    }
+    oc_mutex_lock(mutex);
+    CARemoveBLESendersOfAddress(senderInfo, address);
+    oc_mutex_unlock(mutex);
 }
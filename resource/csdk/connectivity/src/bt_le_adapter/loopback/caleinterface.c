@@ -0,0 +1,339 @@
+/******************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include "iotivity_config.h"
+#ifdef HAVE_STRINGS_H
+#include <strings.h>
+#endif
+
+#include "caleinterface.h"
+#include "caleloopback.h"
+#include "cafragmentation.h"
+#include "octhread.h"
+#include "oic_string.h"
+#include "platform_features.h"
+#include "experimental/logger.h"
+
+#define TAG "OIC_CA_LE_LOOPBACK"
+
+/**
+ * State of the loopback. Data is delivered in the thread sending it, to the
+ * receive callback the LE adapter set for the other role. Sending fails
+ * synchronously, so the error callbacks are never called, and the device
+ * is never disconnected.
+ */
+typedef struct
+{
+    oc_mutex lock;
+    bool started;
+    bool serverStarted;
+    bool clientStarted;
+    uint16_t mtuSize;
+    CABLEDataReceivedCallback onServerReceivedData;
+    CABLEDataReceivedCallback onClientReceivedData;
+} CALELoopbackContext;
+
+static CALELoopbackContext g_context = {
+    .lock = NULL,
+    .mtuSize = CA_DEFAULT_BLE_MTU_SIZE
+};
+
+/**
+ * Deliver data sent to the loopback device.
+ *
+ * @param[in] address   Address the data is sent to.
+ * @param[in] data      Data to deliver.
+ * @param[in] dataLen   Length of the data.
+ * @param[in] toServer  true if the data goes to the GATT server, false
+ *                      for the GATT client.
+ */
+static CAResult_t CALELoopbackDeliver(const char *address,
+                                      const uint8_t *data,
+                                      uint32_t dataLen,
+                                      bool toServer)
+{
+    if (!data || (address && 0 != strcasecmp(address, CA_LE_LOOPBACK_ADDRESS)))
+    {
+        return CA_STATUS_INVALID_PARAM;
+    }
+
+    oc_mutex_lock(g_context.lock);
+    const bool started = g_context.started
+        && (toServer ? g_context.serverStarted : g_context.clientStarted);
+    CABLEDataReceivedCallback callback =
+        toServer ? g_context.onServerReceivedData : g_context.onClientReceivedData;
+    const uint16_t mtuSize = g_context.mtuSize;
+    oc_mutex_unlock(g_context.lock);
+
+    if (!started || !callback)
+    {
+        OIC_LOG(ERROR, TAG, "loopback receiver is not started");
+        return CA_STATUS_FAILED;
+    }
+    if (dataLen > mtuSize)
+    {
+        OIC_LOG_V(ERROR, TAG, "segment of %u bytes exceeds mtu %u",
+                  dataLen, (uint32_t)mtuSize);
+        return CA_STATUS_INVALID_PARAM;
+    }
+
+    uint32_t sentLength = 0;
+    return callback(CA_LE_LOOPBACK_ADDRESS, data, dataLen, &sentLength);
+}
+
+void CALESetLoopbackMtuSize(uint16_t mtuSize)
+{
+    if (mtuSize > CA_SUPPORTED_BLE_MTU_SIZE)
+    {
+        mtuSize = CA_SUPPORTED_BLE_MTU_SIZE;
+    }
+
+    oc_mutex_lock(g_context.lock);
+    g_context.mtuSize = mtuSize;
+    oc_mutex_unlock(g_context.lock);
+}
+
+uint16_t CALEServerGetMtuSize(const char* address)
+{
+    (void)address;
+
+    oc_mutex_lock(g_context.lock);
+    const uint16_t mtuSize = g_context.mtuSize;
+    oc_mutex_unlock(g_context.lock);
+    return mtuSize;
+}
+
+uint16_t CALEClientGetMtuSize(const char* address)
+{
+    return CALEServerGetMtuSize(address);
+}
+
+CAResult_t CAInitializeLEAdapter(void)
+{
+    return CA_STATUS_OK;
+}
+
+CAResult_t CAStartLEAdapter(void)
+{
+    oc_mutex_lock(g_context.lock);
+    const bool wasStarted = g_context.started;
+    g_context.started = true;
+    oc_mutex_unlock(g_context.lock);
+
+    return wasStarted ? CA_STATUS_FAILED : CA_STATUS_OK;
+}
+
+CAResult_t CAStopLEAdapter(void)
+{
+    oc_mutex_lock(g_context.lock);
+    const bool wasStarted = g_context.started;
+    g_context.started = false;
+    oc_mutex_unlock(g_context.lock);
+
+    return wasStarted ? CA_STATUS_OK : CA_STATUS_FAILED;
+}
+
+CAResult_t CAGetLEAdapterState(void)
+{
+    return CA_STATUS_OK;
+}
+
+CAResult_t CAInitializeLENetworkMonitor(void)
+{
+    if (!g_context.lock)
+    {
+        g_context.lock = oc_mutex_new();
+    }
+    return g_context.lock ? CA_STATUS_OK : CA_STATUS_FAILED;
+}
+
+void CATerminateLENetworkMonitor(void)
+{
+    oc_mutex_lock(g_context.lock);
+    g_context.started = false;
+    g_context.serverStarted = false;
+    g_context.clientStarted = false;
+    g_context.onServerReceivedData = NULL;
+    g_context.onClientReceivedData = NULL;
+    oc_mutex_unlock(g_context.lock);
+
+    oc_mutex_free(g_context.lock);
+    g_context.lock = NULL;
+}
+
+CAResult_t CASetLEAdapterStateChangedCb(CALEDeviceStateChangedCallback callback)
+{
+    (void)callback;
+    return CA_STATUS_OK;
+}
+
+CAResult_t CAUnSetLEAdapterStateChangedCb(void)
+{
+    return CA_STATUS_OK;
+}
+
+CAResult_t CASetLENWConnectionStateChangedCb(CALEConnectionStateChangedCallback callback)
+{
+    (void)callback;
+    return CA_STATUS_OK;
+}
+
+CAResult_t CAUnSetLENWConnectionStateChangedCb(void)
+{
+    return CA_STATUS_OK;
+}
+
+CAResult_t CAGetLEAddress(char **local_address)
+{
+    if (!local_address)
+    {
+        return CA_STATUS_INVALID_PARAM;
+    }
+
+    *local_address = OICStrdup(CA_LE_LOOPBACK_ADDRESS);
+    return *local_address ? CA_STATUS_OK : CA_MEMORY_ALLOC_FAILED;
+}
+
+CAResult_t CAStartLEGattServer(void)
+{
+    oc_mutex_lock(g_context.lock);
+    g_context.serverStarted = true;
+    oc_mutex_unlock(g_context.lock);
+
+    return CA_STATUS_OK;
+}
+
+CAResult_t CAStopLEGattServer(void)
+{
+    oc_mutex_lock(g_context.lock);
+    g_context.serverStarted = false;
+    oc_mutex_unlock(g_context.lock);
+
+    return CA_STATUS_OK;
+}
+
+CAResult_t CAInitializeLEGattServer(void)
+{
+    return CA_STATUS_OK;
+}
+
+void CATerminateLEGattServer(void)
+{
+}
+
+void CASetLEReqRespServerCallback(CABLEDataReceivedCallback callback)
+{
+    oc_mutex_lock(g_context.lock);
+    g_context.onServerReceivedData = callback;
+    oc_mutex_unlock(g_context.lock);
+}
+
+CAResult_t CAUpdateCharacteristicsToGattClient(const char *address,
+                                               const uint8_t *value,
+                                               uint32_t valueLen)
+{
+    if (!address)
+    {
+        return CA_STATUS_INVALID_PARAM;
+    }
+    return CALELoopbackDeliver(address, value, valueLen, false);
+}
+
+CAResult_t CAUpdateCharacteristicsToAllGattClients(const uint8_t *value,
+                                                   uint32_t valueLen)
+{
+    return CALELoopbackDeliver(NULL, value, valueLen, false);
+}
+
+CAResult_t CAStartLEGattClient(void)
+{
+    oc_mutex_lock(g_context.lock);
+    g_context.clientStarted = true;
+    oc_mutex_unlock(g_context.lock);
+
+    return CA_STATUS_OK;
+}
+
+void CAStopLEGattClient(void)
+{
+    oc_mutex_lock(g_context.lock);
+    g_context.clientStarted = false;
+    oc_mutex_unlock(g_context.lock);
+}
+
+CAResult_t CAInitializeLEGattClient(void)
+{
+    return CA_STATUS_OK;
+}
+
+void CATerminateLEGattClient(void)
+{
+}
+
+void CACheckLEData(void)
+{
+}
+
+CAResult_t CAUpdateCharacteristicsToGattServer(const char *remoteAddress,
+                                               const uint8_t *data,
+                                               uint32_t dataLen,
+                                               CALETransferType_t type,
+                                               int32_t position)
+{
+    (void)position;
+
+    if (!remoteAddress || LE_UNICAST != type)
+    {
+        return CA_STATUS_INVALID_PARAM;
+    }
+    return CALELoopbackDeliver(remoteAddress, data, dataLen, true);
+}
+
+CAResult_t CAUpdateCharacteristicsToAllGattServers(const uint8_t *data, uint32_t dataLen)
+{
+    return CALELoopbackDeliver(NULL, data, dataLen, true);
+}
+
+void CASetLEReqRespClientCallback(CABLEDataReceivedCallback callback)
+{
+    oc_mutex_lock(g_context.lock);
+    g_context.onClientReceivedData = callback;
+    oc_mutex_unlock(g_context.lock);
+}
+
+void CASetLEServerThreadPoolHandle(ca_thread_pool_t handle)
+{
+    (void)handle;
+}
+
+void CASetLEClientThreadPoolHandle(ca_thread_pool_t handle)
+{
+    (void)handle;
+}
+
+void CASetBLEClientErrorHandleCallback(CABLEErrorHandleCallback callback)
+{
+    (void)callback;
+}
+
+void CASetBLEServerErrorHandleCallback(CABLEErrorHandleCallback callback)
+{
+    (void)callback;
+}
@@ -0,0 +1,75 @@
+/******************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/**
+ * @file
+ *
+ * This file contains the loopback LE transport. It is built instead of the
+ * platform transport with LE_LOOPBACK=1 and delivers what the GATT client
+ * sends to the GATT server of the same process and the other way around,
+ * so the LE adapter and its fragmentation can be run without a radio.
+ */
+
+#ifndef CA_LE_LOOPBACK_H_
+#define CA_LE_LOOPBACK_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Address of the loopback device, the only one data can be sent to.
+ * It is a locally administered address, which no radio has.
+ */
+#define CA_LE_LOOPBACK_ADDRESS "02:00:00:00:00:01"
+
+/**
+ * Set the MTU size the loopback reports, ::CA_DEFAULT_BLE_MTU_SIZE until set.
+ *
+ * @param[in] mtuSize  MTU size, at most ::CA_SUPPORTED_BLE_MTU_SIZE.
+ */
+void CALESetLoopbackMtuSize(uint16_t mtuSize);
+
+/**
+ * Get the MTU size negotiated with a GATT client.
+ *
+ * @param[in] address  Address of the client.
+ *
+ * @return the MTU size set by CALESetLoopbackMtuSize().
+ */
+uint16_t CALEServerGetMtuSize(const char* address);
+
+/**
+ * Get the MTU size negotiated with a GATT server.
+ *
+ * @param[in] address  Address of the server.
+ *
+ * @return the MTU size set by CALESetLoopbackMtuSize().
+ */
+uint16_t CALEClientGetMtuSize(const char* address);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CA_LE_LOOPBACK_H_ */
@@ -30,6 +30,7 @@
 #include "caprotocolmessage.h"
 #include "canetworkconfigurator.h"
 #include "cainterfacecontroller.h"
+#include "cawakeup.h"
 #include "experimental/logger.h"
 
 #if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
@@ -529,6 +530,45 @@ CAResult_t CAHandleRequestResponse(void)
     return CA_STATUS_OK;
 }
 
+CAResult_t CAGetWakeupFd(int *fd)
+{
+    if (!fd)
+    {
+        return CA_STATUS_INVALID_PARAM;
+    }
+
+    if (!g_isInitialized)
+    {
+        OIC_LOG(ERROR, TAG, "not initialized");
+        return CA_STATUS_NOT_INITIALIZED;
+    }
+
+    *fd = CAWakeupGetFd();
+    return (-1 != *fd) ? CA_STATUS_OK : CA_NOT_SUPPORTED;
+}
+
+CAResult_t CAWaitForWakeup(uint32_t timeoutMs)
+{
+    if (!g_isInitialized)
+    {
+        return CA_STATUS_NOT_INITIALIZED;
+    }
+
+    CAWakeupWait(timeoutMs);
+    return CA_STATUS_OK;
+}
+
+CAResult_t CASignalWakeup(void)
+{
+    if (!g_isInitialized)
+    {
+        return CA_STATUS_NOT_INITIALIZED;
+    }
+
+    CAWakeupSignal();
+    return CA_STATUS_OK;
+}
+
 CAResult_t CASelectCipherSuite(const uint16_t cipher, CATransportAdapter_t adapter)
 {
     (void)(adapter); // prevent unused-parameter warning when building release variant
@@ -52,6 +52,7 @@
 #include "uqueue.h"
 #include "cathreadpool.h" /* for thread pool */
 #include "caqueueingthread.h"
+#include "cawakeup.h"
 
 #if defined(TCP_ADAPTER) && defined(WITH_CLOUD)
 #include "caconnectionmanager.h"
@@ -83,7 +84,8 @@ static void CAErrorHandler(const CAEndpoint_t *endpoint,
 
 static CAData_t* CAGenerateHandlerData(const CAEndpoint_t *endpoint,
                                        const CARemoteId_t *identity,
-                                       const void *data, CADataType_t dataType);
+                                       const void *data, oc_refcounter buffer,
+                                       CADataType_t dataType);
 
 static void CASendErrorInfo(const CAEndpoint_t *endpoint, const CAInfo_t *info,
                             CAResult_t result);
@@ -108,6 +110,7 @@ void CAAddDataToSendThread(CAData_t *data)
     // add thread
     CAQueueingThreadAddData(&g_sendThread, data, sizeof(CAData_t));
 }
+#endif
 
 void CAAddDataToReceiveThread(CAData_t *data)
 {
@@ -115,8 +118,73 @@ void CAAddDataToReceiveThread(CAData_t *data)
 
     // add thread
     CAQueueingThreadAddData(&g_receiveThread, data, sizeof(CAData_t));
+    CAWakeupSignal();
+}
+
+#ifdef WITH_BWT
+/**
+ * whether a message is left to blockwise transfer, which adds its options.
+ */
+static bool CAIsBlockwiseMessage(uint32_t code, const CAInfo_t *info,
+                                 const CAEndpoint_t *endpoint)
+{
+    if (!CAIsSupportedBlockwiseTransfer(endpoint->adapter))
+    {
+        return false;
+    }
+    if (CA_REQUEST_ENTITY_INCOMPLETE == code)
+    {
+        return true;
+    }
+
+    // the token is not put in empty messages.
+    bool hasToken = CA_EMPTY != code && info->token;
+    CABlockDataID_t *blockDataID = CACreateBlockDatablockId(hasToken ? info->token : NULL,
+                                                            hasToken ? info->tokenLength : 0,
+                                                            endpoint->addr, endpoint->port);
+    if (!blockDataID)
+    {
+        return true;
+    }
+    bool isBlockwise = (NULL != CAGetBlockDataFromBlockDataList(blockDataID));
+    CADestroyBlockID(blockDataID);
+    return isBlockwise;
 }
+#endif // WITH_BWT
+
+/**
+ * generates the pdu of a message to send. It is built in a single pass unless it is
+ * part of a blockwise transfer, or doesn't fit the builder, in which case its
+ * options are left in the list for CAAddBlockOption as needed.
+ * @param[in]   code                 code of the pdu packet.
+ * @param[in]   info                 pdu information.
+ * @param[in]   endpoint             endpoint information.
+ * @param[out]  options              options to add with CAAddBlockOption.
+ * @param[out]  transport            transport type of the generated pdu.
+ * @param[out]  addBlockOption       whether CAAddBlockOption has to be called on the pdu.
+ * @return  generated pdu.
+ */
+static coap_pdu_t *CAGenerateSendPDU(uint32_t code, const CAInfo_t *info,
+                                     const CAEndpoint_t *endpoint, coap_list_t **options,
+                                     coap_transport_t *transport, bool *addBlockOption)
+{
+    *addBlockOption = false;
+#ifdef WITH_BWT
+    *addBlockOption = CAIsBlockwiseMessage(code, info, endpoint);
+#endif
+    if (!*addBlockOption)
+    {
+        coap_pdu_t *pdu = CABuildPDU(code, info, endpoint, transport);
+        if (pdu)
+        {
+            return pdu;
+        }
+#ifdef WITH_BWT
+        *addBlockOption = CAIsSupportedBlockwiseTransfer(endpoint->adapter);
 #endif
+    }
+    return CAGeneratePDU(code, info, endpoint, options, transport);
+}
 
 static bool CAIsSelectedNetworkAvailable(void)
 {
@@ -130,9 +198,25 @@ static bool CAIsSelectedNetworkAvailable(void)
     return true;
 }
 
+/**
+ * extracts the information of a received pdu, pointing into the buffer holding
+ * the pdu if there is one, or copying it otherwise.
+ */
+static CAResult_t CAGetReceivedInfo(const coap_pdu_t *pdu, oc_refcounter buffer,
+                                    const CAEndpoint_t *endpoint,
+                                    uint32_t *outCode, CAInfo_t *outInfo)
+{
+    if (buffer)
+    {
+        return CAGetInfoFromPDUBuffer(buffer, endpoint, outCode, outInfo);
+    }
+    return CAGetInfoFromPDU(pdu, endpoint, outCode, outInfo);
+}
+
 static CAData_t* CAGenerateHandlerData(const CAEndpoint_t *endpoint,
                                        const CARemoteId_t *identity,
-                                       const void *data, CADataType_t dataType)
+                                       const void *data, oc_refcounter buffer,
+                                       CADataType_t dataType)
 {
     OIC_LOG(DEBUG, TAG, "CAGenerateHandlerData IN");
     CAInfo_t *info = NULL;
@@ -151,6 +235,7 @@ static CAData_t* CAGenerateHandlerData(const CAEndpoint_t *endpoint,
 
     OIC_LOG_V(DEBUG, TAG, "address : %s", ep->addr);
 
+    uint32_t code = CA_NOT_FOUND;
     if (CA_RESPONSE_DATA == dataType)
     {
         CAResponseInfo_t* resInfo = (CAResponseInfo_t*)OICCalloc(1, sizeof(CAResponseInfo_t));
@@ -160,13 +245,14 @@ static CAData_t* CAGenerateHandlerData(const CAEndpoint_t *endpoint,
             goto exit;
         }
 
-        CAResult_t result = CAGetResponseInfoFromPDU(data, resInfo, endpoint);
+        CAResult_t result = CAGetReceivedInfo(data, buffer, endpoint, &code, &resInfo->info);
         if (CA_STATUS_OK != result)
         {
             OIC_LOG(ERROR, TAG, "CAGetResponseInfoFromPDU Failed");
             CADestroyResponseInfoInternal(resInfo);
             goto exit;
         }
+        resInfo->result = code;
         cadata->responseInfo = resInfo;
         info = &resInfo->info;
         if (identity)
@@ -189,13 +275,14 @@ static CAData_t* CAGenerateHandlerData(const CAEndpoint_t *endpoint,
             goto exit;
         }
 
-        CAResult_t result = CAGetRequestInfoFromPDU(data, endpoint, reqInfo);
+        CAResult_t result = CAGetReceivedInfo(data, buffer, endpoint, &code, &reqInfo->info);
         if (CA_STATUS_OK != result)
         {
             OIC_LOG(ERROR, TAG, "CAGetRequestInfoFromPDU failed");
             CADestroyRequestInfoInternal(reqInfo);
             goto exit;
         }
+        reqInfo->method = code;
 
         if ((reqInfo->info.type != CA_MSG_CONFIRM) &&
             CADropSecondMessage(&caglobals.ca.requestHistory, endpoint, reqInfo->info.messageId,
@@ -252,13 +339,15 @@ static CAData_t* CAGenerateHandlerData(const CAEndpoint_t *endpoint,
             goto exit;
         }
 
-        CAResult_t result = CAGetSignalingInfoFromPDU(data, endpoint, signalingInfo);
+        CAResult_t result = CAGetReceivedInfo(data, buffer, endpoint, &code,
+                                              &signalingInfo->info);
         if (CA_STATUS_OK != result)
         {
             OIC_LOG(ERROR, TAG, "CAGetSignalingInfoFromPDU failed");
             CADestroySignalingInfoInternal(signalingInfo);
             goto exit;
         }
+        signalingInfo->code = code;
 
         cadata->signalingInfo = signalingInfo;
         info = &signalingInfo->info;
@@ -358,7 +447,7 @@ static void CATimeoutCallback(const CAEndpoint_t *endpoint, const void *pdu, uin
     }
 #endif // WITH_BWT
 
-    CAQueueingThreadAddData(&g_receiveThread, cadata, sizeof(CAData_t));
+    CAAddDataToReceiveThread(cadata);
 }
 
 static void CADestroyData(void *data, uint32_t size)
@@ -428,6 +517,7 @@ static CAResult_t CAProcessMulticastData(const CAData_t *data)
     CAInfo_t *info = NULL;
     coap_list_t *options = NULL;
     coap_transport_t transport = COAP_UDP;
+    bool addBlockOption = false;
     CAResult_t res = CA_SEND_FAILED;
 
     if (!data->requestInfo && !data->responseInfo)
@@ -441,15 +531,16 @@ static CAResult_t CAProcessMulticastData(const CAData_t *data)
         OIC_LOG(DEBUG, TAG, "requestInfo is available..");
 
         info = &data->requestInfo->info;
-        pdu = CAGeneratePDU(CA_GET, info, data->remoteEndpoint, &options, &transport);
+        pdu = CAGenerateSendPDU(CA_GET, info, data->remoteEndpoint, &options, &transport,
+                                &addBlockOption);
     }
     else if (data->responseInfo)
     {
         OIC_LOG(DEBUG, TAG, "responseInfo is available..");
 
         info = &data->responseInfo->info;
-        pdu = CAGeneratePDU(data->responseInfo->result, info, data->remoteEndpoint,
-                            &options, &transport);
+        pdu = CAGenerateSendPDU(data->responseInfo->result, info, data->remoteEndpoint,
+                                &options, &transport, &addBlockOption);
     }
 
     if (!pdu)
@@ -461,7 +552,7 @@ static CAResult_t CAProcessMulticastData(const CAData_t *data)
     }
 
 #ifdef WITH_BWT
-    if (CAIsSupportedBlockwiseTransfer(data->remoteEndpoint->adapter))
+    if (addBlockOption)
     {
         // Blockwise transfer
         res = CAAddBlockOption(&pdu, info, data->remoteEndpoint, &options);
@@ -506,6 +597,7 @@ static CAResult_t CAProcessSendData(const CAData_t *data)
     CAInfo_t *info = NULL;
     coap_list_t *options = NULL;
     coap_transport_t transport = COAP_UDP;
+    bool addBlockOption = false;
 
     if (SEND_TYPE_UNICAST == type)
     {
@@ -527,8 +619,8 @@ static CAResult_t CAProcessSendData(const CAData_t *data)
 #ifdef ROUTING_GATEWAY
             skipRetransmission = data->requestInfo->info.skipRetransmission;
 #endif
-            pdu = CAGeneratePDU(data->requestInfo->method, info, data->remoteEndpoint,
-                                &options, &transport);
+            pdu = CAGenerateSendPDU(data->requestInfo->method, info, data->remoteEndpoint,
+                                    &options, &transport, &addBlockOption);
         }
         else if (NULL != data->responseInfo)
         {
@@ -538,8 +630,8 @@ static CAResult_t CAProcessSendData(const CAData_t *data)
 #ifdef ROUTING_GATEWAY
             skipRetransmission = data->responseInfo->info.skipRetransmission;
 #endif
-            pdu = CAGeneratePDU(data->responseInfo->result, info, data->remoteEndpoint,
-                                &options, &transport);
+            pdu = CAGenerateSendPDU(data->responseInfo->result, info, data->remoteEndpoint,
+                                    &options, &transport, &addBlockOption);
         }
 #ifdef TCP_ADAPTER
         else if (NULL != data->signalingInfo)
@@ -549,8 +641,8 @@ static CAResult_t CAProcessSendData(const CAData_t *data)
 #ifdef ROUTING_GATEWAY
             skipRetransmission = data->signalingInfo->info.skipRetransmission;
 #endif
-            pdu = CAGeneratePDU(data->signalingInfo->code, info, data->remoteEndpoint,
-                                &options, &transport);
+            pdu = CAGenerateSendPDU(data->signalingInfo->code, info, data->remoteEndpoint,
+                                    &options, &transport, &addBlockOption);
         }
 #endif
         else
@@ -563,7 +655,7 @@ static CAResult_t CAProcessSendData(const CAData_t *data)
         if (NULL != pdu)
         {
 #ifdef WITH_BWT
-            if (CAIsSupportedBlockwiseTransfer(data->remoteEndpoint->adapter))
+            if (addBlockOption)
             {
                 // Blockwise transfer
                 if (NULL != info)
@@ -758,6 +850,16 @@ static void CAReceivedPacketCallback(const CASecureEndpoint_t *sep,
         goto exit;
     }
 
+    // the received information points into the parsed pdu instead of copying it,
+    // and holds it until the information is destroyed.
+    oc_refcounter buffer = CACreateInfoBuffer(pdu, &(sep->endpoint));
+    if (NULL == buffer)
+    {
+        OIC_LOG(ERROR, TAG, "CACreateInfoBuffer failed");
+        coap_delete_pdu(pdu);
+        goto exit;
+    }
+
     OIC_LOG_V(DEBUG, TAG, "code = %d", code);
 
 #ifdef TCP_ADAPTER
@@ -774,11 +876,12 @@ static void CAReceivedPacketCallback(const CASecureEndpoint_t *sep,
 
     if (CA_GET == code || CA_POST == code || CA_PUT == code || CA_DELETE == code)
     {
-        cadata = CAGenerateHandlerData(&(sep->endpoint), &(sep->identity), pdu, CA_REQUEST_DATA);
+        cadata = CAGenerateHandlerData(&(sep->endpoint), &(sep->identity), pdu, buffer,
+                                       CA_REQUEST_DATA);
         if (!cadata)
         {
             OIC_LOG(ERROR, TAG, "CAReceivedPacketCallback, CAGenerateHandlerData failed!");
-            coap_delete_pdu(pdu);
+            oc_refcounter_dec(buffer);
             goto exit;
         }
     }
@@ -791,11 +894,11 @@ static void CAReceivedPacketCallback(const CASecureEndpoint_t *sep,
                         || CA_RELEASE == code || CA_ABORT == code))
         {
             cadata = CAGenerateHandlerData(&(sep->endpoint), &(sep->identity),
-                                           pdu, CA_SIGNALING_DATA);
+                                           pdu, buffer, CA_SIGNALING_DATA);
+            oc_refcounter_dec(buffer);
             if (!cadata)
             {
                 OIC_LOG(ERROR, TAG, "CAReceivedPacketCallback, CAGenerateHandlerData failed!");
-                coap_delete_pdu(pdu);
                 return;
             }
 
@@ -829,11 +932,12 @@ static void CAReceivedPacketCallback(const CASecureEndpoint_t *sep,
         }
 #endif
 
-        cadata = CAGenerateHandlerData(&(sep->endpoint), &(sep->identity), pdu, CA_RESPONSE_DATA);
+        cadata = CAGenerateHandlerData(&(sep->endpoint), &(sep->identity), pdu, buffer,
+                                       CA_RESPONSE_DATA);
         if (!cadata)
         {
             OIC_LOG(ERROR, TAG, "CAReceivedPacketCallback, CAGenerateHandlerData failed!");
-            coap_delete_pdu(pdu);
+            oc_refcounter_dec(buffer);
             goto exit;
         }
 
@@ -881,7 +985,7 @@ static void CAReceivedPacketCallback(const CASecureEndpoint_t *sep,
         if (CA_NOT_SUPPORTED == res || CA_REQUEST_TIMEOUT == res)
         {
             OIC_LOG(DEBUG, TAG, "this message does not have block option");
-            CAQueueingThreadAddData(&g_receiveThread, cadata, sizeof(CAData_t));
+            CAAddDataToReceiveThread(cadata);
         }
         else
         {
@@ -891,10 +995,10 @@ static void CAReceivedPacketCallback(const CASecureEndpoint_t *sep,
     else
 #endif
     {
-        CAQueueingThreadAddData(&g_receiveThread, cadata, sizeof(CAData_t));
+        CAAddDataToReceiveThread(cadata);
     }
 
-    coap_delete_pdu(pdu);
+    oc_refcounter_dec(buffer);
 
 exit:
     OIC_LOG(DEBUG, TAG, "received pdu data :");
@@ -910,12 +1014,21 @@ void CAHandleRequestResponseCallbacks(void)
     // #1 parse the data
     // #2 get endpoint
 
+    CAWakeupClear();
+
     oc_mutex_lock(g_receiveThread.threadMutex);
 
     u_queue_message_t *item = u_queue_get_element(g_receiveThread.dataQueue);
+    bool moreItems = 0 < u_queue_get_size(g_receiveThread.dataQueue);
 
     oc_mutex_unlock(g_receiveThread.threadMutex);
 
+    // Only one item is handled per call, the wakeup stays signalled for the others.
+    if (moreItems)
+    {
+        CAWakeupSignal();
+    }
+
     if (NULL == item || NULL == item->msg)
     {
         return;
@@ -1086,7 +1199,7 @@ CAResult_t CADetachSendMessage(const CAEndpoint_t *endpoint, const void *sendMsg
     {
         OIC_LOG(DEBUG, TAG,
                 "This is a loopback message. Transfer it to the receive queue directly");
-        CAQueueingThreadAddData(&g_receiveThread, data, sizeof(CAData_t));
+        CAAddDataToReceiveThread(data);
         return CA_STATUS_OK;
     }
 #ifdef WITH_BWT
@@ -1133,8 +1246,15 @@ CAResult_t CAInitializeMessageHandler(CATransportAdapter_t transportType)
     CASetPacketReceivedCallback(CAReceivedPacketCallback);
     CASetErrorHandleCallback(CAErrorHandler);
 
+    CAResult_t res = CAWakeupInitialize();
+    if (CA_STATUS_OK != res)
+    {
+        OIC_LOG(ERROR, TAG, "wakeup initialize error.");
+        return res;
+    }
+
     // create thread pool
-    CAResult_t res = ca_thread_pool_init(MAX_THREAD_POOL_SIZE, &g_threadPoolHandle);
+    res = ca_thread_pool_init(MAX_THREAD_POOL_SIZE, &g_threadPoolHandle);
     if (CA_STATUS_OK != res)
     {
         OIC_LOG(ERROR, TAG, "thread pool initialize error.");
@@ -1255,6 +1375,7 @@ void CATerminateMessageHandler(void)
     CARetransmissionDestroy(&g_retransmissionContext);
     CAQueueingThreadDestroy(&g_sendThread);
     CAQueueingThreadDestroy(&g_receiveThread);
+    CAWakeupTerminate();
 
     // terminate interface adapters by controller
     CATerminateAdapters();
@@ -1318,7 +1439,7 @@ void CAErrorHandler(const CAEndpoint_t *endpoint,
         return;
     }
 
-    CAData_t *cadata = CAGenerateHandlerData(endpoint, NULL, pdu, CA_ERROR_DATA);
+    CAData_t *cadata = CAGenerateHandlerData(endpoint, NULL, pdu, NULL, CA_ERROR_DATA);
     if (!cadata)
     {
         OIC_LOG(ERROR, TAG, "CAErrorHandler, CAGenerateHandlerData failed!");
@@ -1362,7 +1483,7 @@ void CAErrorHandler(const CAEndpoint_t *endpoint,
 
     cadata->errorInfo->result = result;
 
-    CAQueueingThreadAddData(&g_receiveThread, cadata, sizeof(CAData_t));
+    CAAddDataToReceiveThread(cadata);
     coap_delete_pdu(pdu);
 
     OIC_LOG(DEBUG, TAG, "CAErrorHandler OUT");
@@ -1411,7 +1532,7 @@ static void CASendErrorInfo(const CAEndpoint_t *endpoint, const CAInfo_t *info,
     cadata->errorInfo = errorInfo;
     cadata->dataType = CA_ERROR_DATA;
 
-    CAQueueingThreadAddData(&g_receiveThread, cadata, sizeof(CAData_t));
+    CAAddDataToReceiveThread(cadata);
     OIC_LOG(DEBUG, TAG, "CASendErrorInfo OUT");
 }
 
@@ -31,6 +31,7 @@
 #include "oic_time.h"
 #include "oic_string.h"
 #include "catcpadapter.h"
+#include "cawakeup.h"
 
 #define TAG "OIC_CA_PING"
 
@@ -158,6 +159,9 @@ CAResult_t CASendPingMessage(const CAEndpoint_t *endpoint, bool withCustody, CAP
     g_pingInfoList = cur;
     oc_mutex_unlock(g_pingInfoListMutex);
 
+    // The thread waiting for work must wake up for the timeout of this ping.
+    CAWakeupSignal();
+
     OIC_LOG(DEBUG, TAG, "CASendPingMessage OUT");
     return CA_STATUS_OK;
 }
@@ -229,6 +233,32 @@ void CAProcessPing()
     oc_mutex_unlock(g_pingInfoListMutex);
 }
 
+uint32_t CAGetPingTimeout(uint32_t timeoutMs)
+{
+    oc_mutex_lock(g_pingInfoListMutex);
+    // The list is reverse sorted, the last ping message expires first.
+    PingInfo *oldest = g_pingInfoList;
+    while (oldest && oldest->next)
+    {
+        oldest = oldest->next;
+    }
+    if (oldest)
+    {
+        uint64_t curTime = OICGetCurrentTime(TIME_IN_MS);
+        uint64_t expiry = oldest->timeStamp + g_timeout;
+        if (expiry <= curTime)
+        {
+            timeoutMs = 0;
+        }
+        else if (expiry - curTime < timeoutMs)
+        {
+            timeoutMs = (uint32_t)(expiry - curTime);
+        }
+    }
+    oc_mutex_unlock(g_pingInfoListMutex);
+    return timeoutMs;
+}
+
 void CAPongReceivedCallback(const CAEndpoint_t *endpoint, const CAToken_t token, uint8_t tokenLength)
 {
     OIC_LOG(DEBUG, TAG, "CAPongReceivedCallback IN");
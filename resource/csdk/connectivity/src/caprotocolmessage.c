@@ -44,6 +44,7 @@
 #include "experimental/ocrandom.h"
 #include "cacommonutil.h"
 #include "cablockwisetransfer.h"
+#include "caremotehandler.h"
 
 #define TAG "OIC_CA_PRTCL_MSG"
 
@@ -272,66 +273,20 @@ exit:
     return NULL;
 }
 
-coap_pdu_t *CAGeneratePDUImpl(code_t code, const CAInfo_t *info,
-                              const CAEndpoint_t *endpoint, coap_list_t *options,
-                              coap_transport_t *transport)
+/**
+ * allocates a pdu of the given size and fills its header and token.
+ */
+static coap_pdu_t *CACreatePDUHeader(code_t code, const CAInfo_t *info,
+                                     const CAEndpoint_t *endpoint, size_t length,
+                                     size_t msgLength, coap_transport_t transport)
 {
-    VERIFY_NON_NULL_RET(info, TAG, "info", NULL);
-    VERIFY_NON_NULL_RET(endpoint, TAG, "endpoint", NULL);
-    VERIFY_NON_NULL_RET(transport, TAG, "transport", NULL);
-    VERIFY_TRUE_RET((info->payloadSize <= UINT_MAX), TAG,
-                    "info->payloadSize", NULL);
-
-    size_t length = COAP_MAX_PDU_SIZE;
-#ifdef WITH_TCP
-    size_t msgLength = 0;
-    if (CAIsSupportedCoAPOverTCP(endpoint->adapter))
-    {
-        if (options)
-        {
-            unsigned short prevOptNumber = 0;
-            for (coap_list_t *opt = options; opt; opt = opt->next)
-            {
-                unsigned short curOptNumber = COAP_OPTION_KEY(*(coap_option *) opt->data);
-                if (prevOptNumber > curOptNumber)
-                {
-                    OIC_LOG(ERROR, TAG, "option list is wrong");
-                    return NULL;
-                }
-
-                size_t optValueLen = COAP_OPTION_LENGTH(*(coap_option *) opt->data);
-                size_t optLength = coap_get_opt_header_length(curOptNumber - prevOptNumber, optValueLen);
-                if (0 == optLength)
-                {
-                    OIC_LOG(ERROR, TAG, "Reserved for the Payload marker for the option");
-                    return NULL;
-                }
-                msgLength += optLength;
-                prevOptNumber = curOptNumber;
-                OIC_LOG_V(DEBUG, TAG, "curOptNumber[%d], prevOptNumber[%d], optValueLen[%" PRIuPTR "], "
-                        "optLength[%" PRIuPTR "], msgLength[%" PRIuPTR "]",
-                          curOptNumber, prevOptNumber, optValueLen, optLength, msgLength);
-            }
-        }
-
-        if (info->payloadSize > 0)
-        {
-            msgLength = msgLength + info->payloadSize + PAYLOAD_MARKER;
-        }
-
-        *transport = coap_get_tcp_header_type_from_size((unsigned int)msgLength);
-        length = msgLength + coap_get_tcp_header_length_for_transport(*transport)
-                + info->tokenLength;
-    }
-    else
+#ifndef WITH_TCP
+    (void)endpoint;
+    (void)msgLength;
 #endif
-    {
-        *transport = COAP_UDP;
-    }
-
     coap_pdu_t *pdu = coap_pdu_init2(0, 0,
                                      ntohs((unsigned short)COAP_INVALID_TID),
-                                     length, *transport);
+                                     length, transport);
 
     if (NULL == pdu)
     {
@@ -340,12 +295,12 @@ coap_pdu_t *CAGeneratePDUImpl(code_t code, const CAInfo_t *info,
     }
 
     OIC_LOG_V(DEBUG, TAG, "transport type: %d, payload size: %" PRIuPTR,
-              *transport, info->payloadSize);
+              transport, info->payloadSize);
 
 #ifdef WITH_TCP
     if (CAIsSupportedCoAPOverTCP(endpoint->adapter))
     {
-        coap_add_length(pdu, *transport, (unsigned int)msgLength);
+        coap_add_length(pdu, transport, (unsigned int)msgLength);
     }
     else
 #endif
@@ -370,7 +325,7 @@ coap_pdu_t *CAGeneratePDUImpl(code_t code, const CAInfo_t *info,
         pdu->transport_hdr->udp.type = info->type;
     }
 
-    coap_add_code(pdu, *transport, code);
+    coap_add_code(pdu, transport, code);
 
     if (info->token && CA_EMPTY != code)
     {
@@ -383,7 +338,7 @@ coap_pdu_t *CAGeneratePDUImpl(code_t code, const CAInfo_t *info,
                                        code == CA_ABORT))
         {
             int32_t ret = coap_add_token_to_empty_message(pdu, tokenLength,
-                            (unsigned char *)info->token, *transport);
+                            (unsigned char *)info->token, transport);
             if (0 == ret)
             {
                 OIC_LOG(ERROR, TAG, "can't add token");
@@ -392,7 +347,7 @@ coap_pdu_t *CAGeneratePDUImpl(code_t code, const CAInfo_t *info,
         else
         {
             int32_t ret = coap_add_token2(pdu, tokenLength, (unsigned char *)info->token,
-                            *transport);
+                            transport);
             if (0 == ret)
             {
                 OIC_LOG(ERROR, TAG, "can't add token");
@@ -400,6 +355,76 @@ coap_pdu_t *CAGeneratePDUImpl(code_t code, const CAInfo_t *info,
         }
     }
 
+    return pdu;
+}
+
+coap_pdu_t *CAGeneratePDUImpl(code_t code, const CAInfo_t *info,
+                              const CAEndpoint_t *endpoint, coap_list_t *options,
+                              coap_transport_t *transport)
+{
+    VERIFY_NON_NULL_RET(info, TAG, "info", NULL);
+    VERIFY_NON_NULL_RET(endpoint, TAG, "endpoint", NULL);
+    VERIFY_NON_NULL_RET(transport, TAG, "transport", NULL);
+    VERIFY_TRUE_RET((info->payloadSize <= UINT_MAX), TAG,
+                    "info->payloadSize", NULL);
+
+    size_t length = COAP_MAX_PDU_SIZE;
+#ifdef WITH_TCP
+    size_t msgLength = 0;
+    if (CAIsSupportedCoAPOverTCP(endpoint->adapter))
+    {
+        if (options)
+        {
+            unsigned short prevOptNumber = 0;
+            for (coap_list_t *opt = options; opt; opt = opt->next)
+            {
+                unsigned short curOptNumber = COAP_OPTION_KEY(*(coap_option *) opt->data);
+                if (prevOptNumber > curOptNumber)
+                {
+                    OIC_LOG(ERROR, TAG, "option list is wrong");
+                    return NULL;
+                }
+
+                size_t optValueLen = COAP_OPTION_LENGTH(*(coap_option *) opt->data);
+                size_t optLength = coap_get_opt_header_length(curOptNumber - prevOptNumber, optValueLen);
+                if (0 == optLength)
+                {
+                    OIC_LOG(ERROR, TAG, "Reserved for the Payload marker for the option");
+                    return NULL;
+                }
+                msgLength += optLength;
+                prevOptNumber = curOptNumber;
+                OIC_LOG_V(DEBUG, TAG, "curOptNumber[%d], prevOptNumber[%d], optValueLen[%" PRIuPTR "], "
+                        "optLength[%" PRIuPTR "], msgLength[%" PRIuPTR "]",
+                          curOptNumber, prevOptNumber, optValueLen, optLength, msgLength);
+            }
+        }
+
+        if (info->payloadSize > 0)
+        {
+            msgLength = msgLength + info->payloadSize + PAYLOAD_MARKER;
+        }
+
+        *transport = coap_get_tcp_header_type_from_size((unsigned int)msgLength);
+        length = msgLength + coap_get_tcp_header_length_for_transport(*transport)
+                + info->tokenLength;
+    }
+    else
+#endif
+    {
+        *transport = COAP_UDP;
+    }
+
+#ifdef WITH_TCP
+    coap_pdu_t *pdu = CACreatePDUHeader(code, info, endpoint, length, msgLength, *transport);
+#else
+    coap_pdu_t *pdu = CACreatePDUHeader(code, info, endpoint, length, 0, *transport);
+#endif
+    if (NULL == pdu)
+    {
+        return NULL;
+    }
+
 #ifdef WITH_BWT
     if (CA_ADAPTER_GATT_BTLE != endpoint->adapter
 #ifdef WITH_TCP
@@ -443,6 +468,368 @@ coap_pdu_t *CAGeneratePDUImpl(code_t code, const CAInfo_t *info,
     return pdu;
 }
 
+/**
+ * Maximum number of options CABuildPDU gathers, the uri path and query
+ * segments included. Messages with more options are left to CAGeneratePDU.
+ */
+#define CA_MAX_PDU_OPTIONS (32)
+
+/**
+ * option gathered by CABuildPDU.
+ */
+typedef struct
+{
+    uint16_t key;
+    uint16_t length;
+    /** value of the option, or NULL if it is held in encoded.*/
+    const uint8_t *value;
+    /** value of a variable length option, shrunk to its minimum size.*/
+    uint8_t encoded[CA_ENCODE_BUFFER_SIZE];
+} CAPduOption_t;
+
+/**
+ * options of a pdu sorted by key, in insertion order for equal keys.
+ */
+typedef struct
+{
+    CAPduOption_t options[CA_MAX_PDU_OPTIONS];
+    size_t count;
+    /** uri path and query options split by libcoap, which the values point into.*/
+    unsigned char pathBuffer[CA_MAX_URI_LENGTH];
+    unsigned char queryBuffer[CA_MAX_URI_LENGTH];
+} CAPduOptions_t;
+
+/**
+ * inserts an option in order. Values of copied options must fit CA_ENCODE_BUFFER_SIZE,
+ * those of the others must outlive the options.
+ */
+static CAResult_t CAAddPduOption(CAPduOptions_t *options, uint16_t key, size_t length,
+                                 const uint8_t *data, bool copy)
+{
+    if (CA_MAX_PDU_OPTIONS <= options->count)
+    {
+        OIC_LOG(DEBUG, TAG, "too many options for pdu builder");
+        return CA_MEMORY_ALLOC_FAILED;
+    }
+    if (UINT16_MAX < length || (copy && CA_ENCODE_BUFFER_SIZE < length))
+    {
+        OIC_LOG(ERROR, TAG, "option too long");
+        return CA_STATUS_INVALID_PARAM;
+    }
+
+    // keep the array sorted, after the options with the same key.
+    size_t idx = options->count++;
+    while (idx > 0 && options->options[idx - 1].key > key)
+    {
+        options->options[idx] = options->options[idx - 1];
+        idx--;
+    }
+
+    CAPduOption_t *option = &options->options[idx];
+    option->key = key;
+
+    // same encoding as CACreateNewOptionNode.
+    coap_option_def_t *def = coap_opt_def(key);
+    if (NULL != def && coap_is_var_bytes(def))
+    {
+        if (length > def->max)
+        {
+            data = &(data[length - def->max]);
+            length = def->max;
+        }
+        option->length = (uint16_t)coap_encode_var_bytes(option->encoded,
+                coap_decode_var_bytes((unsigned char *)data, (unsigned int)length));
+        option->value = NULL;
+    }
+    else if (copy)
+    {
+        option->length = (uint16_t)length;
+        memcpy(option->encoded, data, length);
+        option->value = NULL;
+    }
+    else
+    {
+        option->length = (uint16_t)length;
+        option->value = data;
+    }
+    return CA_STATUS_OK;
+}
+
+static CAResult_t CAAddPduUriOptions(CAPduOptions_t *options, const unsigned char *str,
+                                     size_t length, uint16_t target, unsigned char *buffer)
+{
+    size_t unusedBufferSize = CA_MAX_URI_LENGTH;
+    int res = (COAP_OPTION_URI_PATH == target) ?
+              coap_split_path(str, length, buffer, &unusedBufferSize) :
+              coap_split_query(str, length, buffer, &unusedBufferSize);
+    if (res <= 0)
+    {
+        OIC_LOG_V(ERROR, TAG, "Problem parsing URI : %d for %d", res, target);
+        return CA_STATUS_FAILED;
+    }
+
+    size_t usedBufferSize = CA_MAX_URI_LENGTH - unusedBufferSize;
+    size_t idx = 0;
+    while (res--)
+    {
+        const unsigned char *opt = buffer + idx;
+        size_t optSize = COAP_OPT_SIZE(opt);
+        if (idx + optSize > usedBufferSize)
+        {
+            return CA_STATUS_INVALID_PARAM;
+        }
+
+        CAResult_t ret = CAAddPduOption(options, target, COAP_OPT_LENGTH(opt),
+                                        COAP_OPT_VALUE(opt), false);
+        if (CA_STATUS_OK != ret)
+        {
+            return ret;
+        }
+        idx += optSize;
+    }
+    return CA_STATUS_OK;
+}
+
+static CAResult_t CAAddPduFormatOptions(CAPduOptions_t *options, uint16_t formatOption,
+                                        CAPayloadFormat_t format, uint16_t versionOption,
+                                        uint16_t version)
+{
+    uint8_t buf[CA_ENCODE_BUFFER_SIZE] = { 0 };
+    unsigned int length = 0;
+
+    switch (format)
+    {
+        case CA_FORMAT_APPLICATION_CBOR:
+            length = coap_encode_var_bytes(buf, (unsigned short) COAP_MEDIATYPE_APPLICATION_CBOR);
+            break;
+        case CA_FORMAT_APPLICATION_VND_OCF_CBOR:
+            length = coap_encode_var_bytes(buf,
+                    (unsigned short) COAP_MEDIATYPE_APPLICATION_VND_OCF_CBOR);
+            break;
+        default:
+            // CAParseHeadOption skips the unsupported formats as well.
+            OIC_LOG_V(ERROR, TAG, "Format option:[%d] not supported", format);
+            return CA_STATUS_OK;
+    }
+
+    CAResult_t ret = CAAddPduOption(options, formatOption, length, buf, true);
+    if (CA_STATUS_OK != ret || CA_FORMAT_APPLICATION_VND_OCF_CBOR != format)
+    {
+        return ret;
+    }
+
+    length = coap_encode_var_bytes(buf, version);
+    return CAAddPduOption(options, versionOption, length, buf, true);
+}
+
+static CAResult_t CAGatherPduOptions(const CAInfo_t *info, CAPduOptions_t *options)
+{
+    if (info->resourceUri)
+    {
+        size_t length = strlen(info->resourceUri);
+        if (CA_MAX_URI_LENGTH < length)
+        {
+            OIC_LOG(ERROR, TAG, "URI len err");
+            return CA_STATUS_INVALID_PARAM;
+        }
+
+        char coapUri[sizeof(COAP_URI_HEADER) + CA_MAX_URI_LENGTH];
+        memcpy(coapUri, COAP_URI_HEADER, sizeof(COAP_URI_HEADER) - 1);
+        memcpy(coapUri + sizeof(COAP_URI_HEADER) - 1, info->resourceUri, length + 1);
+
+        coap_uri_t uri;
+        coap_split_uri((unsigned char *) coapUri, sizeof(COAP_URI_HEADER) - 1 + length, &uri);
+
+        CAResult_t ret = CA_STATUS_OK;
+        if (uri.port != COAP_DEFAULT_PORT)
+        {
+            unsigned char portbuf[CA_ENCODE_BUFFER_SIZE] = { 0 };
+            ret = CAAddPduOption(options, COAP_OPTION_URI_PORT,
+                                 coap_encode_var_bytes(portbuf, uri.port), portbuf, true);
+        }
+        if (CA_STATUS_OK == ret && uri.path.s && uri.path.length)
+        {
+            ret = CAAddPduUriOptions(options, uri.path.s, uri.path.length,
+                                     COAP_OPTION_URI_PATH, options->pathBuffer);
+        }
+        if (CA_STATUS_OK == ret && uri.query.s && uri.query.length)
+        {
+            ret = CAAddPduUriOptions(options, uri.query.s, uri.query.length,
+                                     COAP_OPTION_URI_QUERY, options->queryBuffer);
+        }
+        if (CA_STATUS_OK != ret)
+        {
+            return ret;
+        }
+    }
+
+    for (uint32_t i = 0; i < info->numOptions; i++)
+    {
+        const CAHeaderOption_t *option = info->options + i;
+        switch (option->optionID)
+        {
+            case COAP_OPTION_URI_PATH:
+            case COAP_OPTION_URI_QUERY:
+            case COAP_OPTION_ACCEPT:
+            case CA_OPTION_ACCEPT_VERSION:
+            case COAP_OPTION_CONTENT_FORMAT:
+            case CA_OPTION_CONTENT_VERSION:
+                // added from the uri and the payload formats as in CAParseHeadOption.
+                break;
+            default:
+            {
+                CAResult_t ret = CAAddPduOption(options, option->optionID, option->optionLength,
+                                                (const uint8_t *)option->optionData, false);
+                if (CA_STATUS_OK != ret)
+                {
+                    return ret;
+                }
+            }
+        }
+    }
+
+    if (CA_FORMAT_UNDEFINED != info->payloadFormat)
+    {
+        uint16_t version = info->payloadVersion;
+        if (MAX_VERSION_VALUE < version)
+        {
+            version = MAX_VERSION_VALUE;
+        }
+        CAResult_t ret = CAAddPduFormatOptions(options, COAP_OPTION_CONTENT_FORMAT,
+                                               info->payloadFormat,
+                                               CA_OPTION_CONTENT_VERSION, version);
+        if (CA_STATUS_OK != ret)
+        {
+            return ret;
+        }
+    }
+    if (CA_FORMAT_UNDEFINED != info->acceptFormat)
+    {
+        uint16_t version = info->acceptVersion;
+        if (MAX_VERSION_VALUE < version)
+        {
+            version = MAX_VERSION_VALUE;
+        }
+        CAResult_t ret = CAAddPduFormatOptions(options, COAP_OPTION_ACCEPT, info->acceptFormat,
+                                               CA_OPTION_ACCEPT_VERSION, version);
+        if (CA_STATUS_OK != ret)
+        {
+            return ret;
+        }
+    }
+    return CA_STATUS_OK;
+}
+
+/**
+ * size of an option encoded after the option numbered key - delta (RFC 7252, 3.1).
+ */
+static size_t CAGetPduOptionSize(uint16_t delta, uint16_t length)
+{
+    size_t size = 1 + (size_t)length;
+    size += (delta < 13) ? 0 : ((delta < 269) ? 1 : 2);
+    size += (length < 13) ? 0 : ((length < 269) ? 1 : 2);
+    return size;
+}
+
+coap_pdu_t *CABuildPDU(uint32_t code, const CAInfo_t *info, const CAEndpoint_t *endpoint,
+                       coap_transport_t *transport)
+{
+    VERIFY_NON_NULL_RET(info, TAG, "info", NULL);
+    VERIFY_NON_NULL_RET(endpoint, TAG, "endpoint", NULL);
+    VERIFY_NON_NULL_RET(transport, TAG, "transport", NULL);
+    VERIFY_TRUE_RET((info->payloadSize <= UINT_MAX), TAG,
+                    "info->payloadSize", NULL);
+
+    CAPduOptions_t options;
+    options.count = 0;
+
+    // RESET have to use only 4byte (empty message)
+    // and ACKNOWLEDGE can use empty message when code is empty.
+    if (CA_MSG_RESET == info->type || (CA_EMPTY == code && CA_MSG_ACKNOWLEDGE == info->type))
+    {
+        if (CA_EMPTY != code)
+        {
+            OIC_LOG(ERROR, TAG, "reset is not empty message");
+            return NULL;
+        }
+
+        if (info->payloadSize > 0 || info->payload || info->token || info->tokenLength > 0)
+        {
+            OIC_LOG(ERROR, TAG, "Empty message has unnecessary data after messageID");
+            return NULL;
+        }
+    }
+    else if (CA_STATUS_OK != CAGatherPduOptions(info, &options))
+    {
+        return NULL;
+    }
+
+    size_t msgLength = 0;
+    uint16_t prevKey = 0;
+    for (size_t i = 0; i < options.count; i++)
+    {
+        msgLength += CAGetPduOptionSize(options.options[i].key - prevKey,
+                                        options.options[i].length);
+        prevKey = options.options[i].key;
+    }
+    bool hasPayload = (NULL != info->payload) && (0 < info->payloadSize);
+    if (hasPayload)
+    {
+        // payload marker
+        msgLength += 1 + info->payloadSize;
+    }
+
+    size_t length = 0;
+#ifdef WITH_TCP
+    if (CAIsSupportedCoAPOverTCP(endpoint->adapter))
+    {
+        *transport = coap_get_tcp_header_type_from_size((unsigned int)msgLength);
+        length = msgLength + coap_get_tcp_header_length_for_transport(*transport)
+                + info->tokenLength;
+    }
+    else
+#endif
+    {
+        *transport = COAP_UDP;
+        length = msgLength + CA_PDU_MIN_SIZE + info->tokenLength;
+        if (COAP_MAX_PDU_SIZE < length)
+        {
+            OIC_LOG_V(DEBUG, TAG, "pdu of %" PRIuPTR " bytes exceeds max pdu size", length);
+            return NULL;
+        }
+    }
+
+    coap_pdu_t *pdu = CACreatePDUHeader((code_t) code, info, endpoint, length, msgLength,
+                                        *transport);
+    if (NULL == pdu)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < options.count; i++)
+    {
+        const CAPduOption_t *option = &options.options[i];
+        if (0 == coap_add_option2(pdu, option->key, option->length,
+                                  option->value ? option->value : option->encoded,
+                                  *transport))
+        {
+            OIC_LOG(ERROR, TAG, "coap_add_option2 has failed");
+            coap_delete_pdu(pdu);
+            return NULL;
+        }
+    }
+
+    if (hasPayload && 0 == coap_add_data(pdu, (unsigned int)info->payloadSize,
+                                         (const unsigned char *)info->payload))
+    {
+        OIC_LOG(ERROR, TAG, "coap_add_data has failed");
+        coap_delete_pdu(pdu);
+        return NULL;
+    }
+
+    return pdu;
+}
+
 CAResult_t CAParseURI(const char *uriInfo, coap_list_t **optlist)
 {
     VERIFY_NON_NULL(uriInfo, TAG, "uriInfo");
@@ -796,8 +1183,66 @@ CAResult_t CAGetOptionCount(coap_opt_iterator_t opt_iter, uint8_t *optionCount)
     return result;
 }
 
-CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
-                            uint32_t *outCode, CAInfo_t *outInfo)
+static void CADestroyInfoBuffer(void *data)
+{
+    CAInfoBuffer_t *buffer = (CAInfoBuffer_t *) data;
+    coap_delete_pdu((coap_pdu_t *) buffer->pdu);
+    OICFree(buffer);
+}
+
+oc_refcounter CACreateInfoBuffer(coap_pdu_t *pdu, const CAEndpoint_t *endpoint)
+{
+    VERIFY_NON_NULL_RET(pdu, TAG, "pdu", NULL);
+    VERIFY_NON_NULL_RET(endpoint, TAG, "endpoint", NULL);
+
+    coap_transport_t transport = COAP_UDP;
+#ifdef WITH_TCP
+    if (CAIsSupportedCoAPOverTCP(endpoint->adapter))
+    {
+        transport = coap_get_tcp_header_type_from_initbyte(((unsigned char *)pdu->transport_hdr)[0] >> 4);
+    }
+#else
+    (void) endpoint;
+#endif
+
+    coap_opt_iterator_t opt_iter;
+    coap_option_iterator_init2(pdu, &opt_iter, COAP_OPT_ALL, transport);
+
+    uint8_t count = 0;
+    if (CA_STATUS_OK != CAGetOptionCount(opt_iter, &count))
+    {
+        return NULL;
+    }
+
+    // room for the header options and the uri rebuilt by CAGetInfoFromPDUImpl.
+    size_t storageLength = count * sizeof(CAHeaderOption_t) + CA_MAX_URI_LENGTH;
+    CAInfoBuffer_t *buffer = (CAInfoBuffer_t *) OICMalloc(sizeof(CAInfoBuffer_t) + storageLength);
+    if (!buffer)
+    {
+        OIC_LOG(ERROR, TAG, "Out of memory");
+        return NULL;
+    }
+    buffer->pdu = pdu;
+    buffer->pduData = (const uint8_t *) pdu->transport_hdr;
+    buffer->pduLength = pdu->length;
+    buffer->storageLength = storageLength;
+
+    oc_refcounter ref = oc_refcounter_create(buffer, CADestroyInfoBuffer);
+    if (!ref)
+    {
+        OIC_LOG(ERROR, TAG, "Out of memory");
+        OICFree(buffer);
+    }
+    return ref;
+}
+
+/**
+ * extracts the information of a pdu into outInfo, copying it, or pointing into
+ * the given info buffer which holds the pdu.
+ */
+static CAResult_t CAGetInfoFromPDUImpl(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
+                                       uint32_t *outCode, CAInfo_t *outInfo,
+                                       CAInfoBuffer_t *buffer)
 {
     OIC_LOG(INFO, TAG, "IN - CAGetInfoFromPDU");
     VERIFY_NON_NULL(pdu, TAG, "pdu");
@@ -855,9 +1300,19 @@ CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
         outInfo->acceptFormat = CA_FORMAT_UNDEFINED;
     }
 
+    // in the storage of the buffer, the options are followed by the uri.
+    uint8_t *storage = buffer ? (uint8_t *) (buffer + 1) : NULL;
     if (count > 0)
     {
-        outInfo->options = (CAHeaderOption_t *) OICCalloc(count, sizeof(CAHeaderOption_t));
+        if (buffer)
+        {
+            outInfo->options = (CAHeaderOption_t *) storage;
+            memset(outInfo->options, 0, count * sizeof(CAHeaderOption_t));
+        }
+        else
+        {
+            outInfo->options = (CAHeaderOption_t *) OICCalloc(count, sizeof(CAHeaderOption_t));
+        }
         if (NULL == outInfo->options)
         {
             OIC_LOG(ERROR, TAG, "Out of memory");
@@ -866,11 +1321,8 @@ CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
     }
 
     coap_opt_t *option = NULL;
-    char *optionResult = (char *)OICCalloc(1, CA_MAX_URI_LENGTH * sizeof(char));
-    if (NULL == optionResult)
-    {
-        goto exit;
-    }
+    char optionResult[CA_MAX_URI_LENGTH] = { 0 };
+    char buf[COAP_MAX_PDU_SIZE];
 
     uint32_t idx = 0;
     uint32_t optionLength = 0;
@@ -880,12 +1332,6 @@ CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
 
     while ((option = coap_option_next(&opt_iter)))
     {
-        char *buf = (char *)OICCalloc(1, COAP_MAX_PDU_SIZE * sizeof(char));
-        if (NULL == buf)
-        {
-            goto exit;
-        }
-
         uint32_t bufLength =
             CAGetOptionData(opt_iter.type, (uint8_t *)(COAP_OPT_VALUE(option)),
                     COAP_OPT_LENGTH(option), (uint8_t *)buf, COAP_MAX_PDU_SIZE);
@@ -907,7 +1353,6 @@ CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
                     }
                     else
                     {
-                        OICFree(buf);
                         goto exit;
                     }
                 }
@@ -923,8 +1368,7 @@ CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
                         }
                         else
                         {
-                            OICFree(buf);
-                            goto exit;
+                                goto exit;
                         }
                     }
                     else if (COAP_OPTION_URI_QUERY == opt_iter.type)
@@ -940,7 +1384,6 @@ CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
                             }
                             else
                             {
-                                OICFree(buf);
                                 goto exit;
                             }
                         }
@@ -954,7 +1397,6 @@ CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
                             }
                             else
                             {
-                                OICFree(buf);
                                 goto exit;
                             }
                         }
@@ -967,7 +1409,6 @@ CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
                     }
                     else
                     {
-                        OICFree(buf);
                         goto exit;
                     }
                 }
@@ -1075,7 +1516,6 @@ CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
                 }
             }
         }
-        OICFree(buf);
     } // while
 
     unsigned char* token = NULL;
@@ -1086,15 +1526,21 @@ CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
     if (token_length > 0)
     {
         OIC_LOG_V(DEBUG, TAG, "inside token length : %d", token_length);
-        outInfo->token = (char *) OICMalloc(token_length);
-        if (NULL == outInfo->token)
+        if (buffer)
         {
-            OIC_LOG(ERROR, TAG, "Out of memory");
-            OICFree(outInfo->options);
-            OICFree(optionResult);
-            return CA_MEMORY_ALLOC_FAILED;
+            outInfo->token = (char *) token;
+        }
+        else
+        {
+            outInfo->token = (char *) OICMalloc(token_length);
+            if (NULL == outInfo->token)
+            {
+                OIC_LOG(ERROR, TAG, "Out of memory");
+                OICFree(outInfo->options);
+                return CA_MEMORY_ALLOC_FAILED;
+            }
+            memcpy(outInfo->token, token, token_length);
         }
-        memcpy(outInfo->token, token, token_length);
     }
 
     assert(token_length <= UINT8_MAX);
@@ -1106,32 +1552,31 @@ CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
     if (coap_get_data(pdu, &dataSize, &data))
     {
         OIC_LOG(DEBUG, TAG, "inside pdu->data");
-        outInfo->payload = (uint8_t *) OICMalloc(dataSize);
-        if (NULL == outInfo->payload)
+        if (buffer)
         {
-            OIC_LOG(ERROR, TAG, "Out of memory");
-            OICFree(outInfo->options);
-            OICFree(outInfo->token);
-            OICFree(optionResult);
-            return CA_MEMORY_ALLOC_FAILED;
+            outInfo->payload = data;
+        }
+        else
+        {
+            outInfo->payload = (uint8_t *) OICMalloc(dataSize);
+            if (NULL == outInfo->payload)
+            {
+                OIC_LOG(ERROR, TAG, "Out of memory");
+                OICFree(outInfo->options);
+                OICFree(outInfo->token);
+                return CA_MEMORY_ALLOC_FAILED;
+            }
+            memcpy(outInfo->payload, pdu->data, dataSize);
         }
-        memcpy(outInfo->payload, pdu->data, dataSize);
         outInfo->payloadSize = dataSize;
     }
 
+    const char *resourceUri = NULL;
     if (optionResult[0] != '\0')
     {
         optionResult[optionLength] = '\0';
         OIC_LOG_V(DEBUG, TAG, "URL length:%" PRIuPTR, strlen(optionResult));
-        outInfo->resourceUri = OICStrdup(optionResult);
-        if (!outInfo->resourceUri)
-        {
-            OIC_LOG(ERROR, TAG, "Out of memory");
-            OICFree(outInfo->options);
-            OICFree(outInfo->token);
-            OICFree(optionResult);
-            return CA_MEMORY_ALLOC_FAILED;
-        }
+        resourceUri = optionResult;
     }
     else if(isProxyRequest && g_chproxyUri[0] != '\0')
     {
@@ -1140,28 +1585,64 @@ CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
         *   and only COAP_OPTION_PROXY_URI will be present. Use preset proxy URI
         *   for such requests.
         */
-        outInfo->resourceUri = OICStrdup(g_chproxyUri);
-        if (!outInfo->resourceUri)
+        resourceUri = g_chproxyUri;
+    }
+
+    if (resourceUri)
+    {
+        if (buffer)
         {
-            OIC_LOG(ERROR, TAG, "Out of memory");
-            OICFree(outInfo->options);
-            OICFree(outInfo->token);
-            OICFree(optionResult);
-            return CA_MEMORY_ALLOC_FAILED;
+            outInfo->resourceUri = (CAURI_t) (storage + count * sizeof(CAHeaderOption_t));
+            OICStrcpy(outInfo->resourceUri, CA_MAX_URI_LENGTH, resourceUri);
+        }
+        else
+        {
+            outInfo->resourceUri = OICStrdup(resourceUri);
+            if (!outInfo->resourceUri)
+            {
+                OIC_LOG(ERROR, TAG, "Out of memory");
+                OICFree(outInfo->options);
+                OICFree(outInfo->token);
+                OICFree(outInfo->payload);
+                return CA_MEMORY_ALLOC_FAILED;
+            }
         }
     }
-    OICFree(optionResult);
     OIC_LOG(INFO, TAG, "OUT - CAGetInfoFromPDU");
     return CA_STATUS_OK;
 
 exit:
     OIC_LOG(ERROR, TAG, "buffer too small");
     OIC_LOG_V(ERROR, TAG, "%s: ERROR EXIT", __func__);
-    OICFree(outInfo->options);
-    OICFree(optionResult);
+    if (!buffer)
+    {
+        OICFree(outInfo->options);
+    }
+    outInfo->options = NULL;
     return CA_STATUS_FAILED;
 }
 
+CAResult_t CAGetInfoFromPDU(const coap_pdu_t *pdu, const CAEndpoint_t *endpoint,
+                            uint32_t *outCode, CAInfo_t *outInfo)
+{
+    return CAGetInfoFromPDUImpl(pdu, endpoint, outCode, outInfo, NULL);
+}
+
+CAResult_t CAGetInfoFromPDUBuffer(oc_refcounter buffer, const CAEndpoint_t *endpoint,
+                                  uint32_t *outCode, CAInfo_t *outInfo)
+{
+    VERIFY_NON_NULL(buffer, TAG, "buffer");
+
+    CAInfoBuffer_t *infoBuffer = (CAInfoBuffer_t *) oc_refcounter_get_data(buffer);
+    CAResult_t ret = CAGetInfoFromPDUImpl((const coap_pdu_t *) infoBuffer->pdu, endpoint,
+                                          outCode, outInfo, infoBuffer);
+    if (CA_STATUS_OK == ret)
+    {
+        outInfo->buffer = oc_refcounter_inc(buffer);
+    }
+    return ret;
+}
+
 CAResult_t CAGetTokenFromPDU(const coap_hdr_transport_t *pdu_hdr,
                              CAInfo_t *outInfo,
                              const CAEndpoint_t *endpoint)
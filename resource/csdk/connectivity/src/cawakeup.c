@@ -0,0 +1,213 @@
+/******************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include "iotivity_config.h"
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+#ifdef HAVE_SYS_EVENTFD_H
+#include <sys/eventfd.h>
+#endif
+
+#include "cawakeup.h"
+#include "octhread.h"
+#include "experimental/logger.h"
+
+#define TAG "OIC_CA_WAKEUP"
+
+#if defined(HAVE_SYS_EVENTFD_H)
+#define CA_WAKEUP_EVENTFD
+#elif defined(HAVE_UNISTD_H) && defined(HAVE_FCNTL_H)
+#define CA_WAKEUP_PIPE
+#endif
+
+static oc_mutex g_wakeupMutex = NULL;
+static oc_cond g_wakeupCond = NULL;
+static bool g_signalled = false;
+
+/** Descriptors polled and written, the same one for an eventfd.*/
+static int g_readFd = -1;
+static int g_writeFd = -1;
+
+static bool CAWakeupOpenFds(void)
+{
+#if defined(CA_WAKEUP_EVENTFD)
+    g_readFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    g_writeFd = g_readFd;
+    return -1 != g_readFd;
+#elif defined(CA_WAKEUP_PIPE)
+    int fds[2];
+    if (-1 == pipe(fds))
+    {
+        return false;
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        int flags = fcntl(fds[i], F_GETFL);
+        if (-1 == flags || -1 == fcntl(fds[i], F_SETFL, flags | O_NONBLOCK) ||
+            -1 == fcntl(fds[i], F_SETFD, FD_CLOEXEC))
+        {
+            close(fds[0]);
+            close(fds[1]);
+            return false;
+        }
+    }
+    g_readFd = fds[0];
+    g_writeFd = fds[1];
+    return true;
+#else
+    return true;
+#endif
+}
+
+static void CAWakeupCloseFds(void)
+{
+#if defined(CA_WAKEUP_EVENTFD) || defined(CA_WAKEUP_PIPE)
+    if (-1 != g_readFd)
+    {
+        close(g_readFd);
+    }
+    if (g_writeFd != g_readFd && -1 != g_writeFd)
+    {
+        close(g_writeFd);
+    }
+#endif
+    g_readFd = -1;
+    g_writeFd = -1;
+}
+
+CAResult_t CAWakeupInitialize(void)
+{
+    if (g_wakeupMutex)
+    {
+        return CA_STATUS_OK;
+    }
+
+    g_wakeupMutex = oc_mutex_new();
+    g_wakeupCond = oc_cond_new();
+    if (!g_wakeupMutex || !g_wakeupCond || !CAWakeupOpenFds())
+    {
+        OIC_LOG(ERROR, TAG, "Failed to create the wakeup");
+        CAWakeupTerminate();
+        return CA_STATUS_FAILED;
+    }
+    g_signalled = false;
+    return CA_STATUS_OK;
+}
+
+void CAWakeupTerminate(void)
+{
+    CAWakeupCloseFds();
+    if (g_wakeupCond)
+    {
+        oc_cond_free(g_wakeupCond);
+        g_wakeupCond = NULL;
+    }
+    if (g_wakeupMutex)
+    {
+        oc_mutex_free(g_wakeupMutex);
+        g_wakeupMutex = NULL;
+    }
+    g_signalled = false;
+}
+
+void CAWakeupSignal(void)
+{
+    if (!g_wakeupMutex)
+    {
+        return;
+    }
+
+    oc_mutex_lock(g_wakeupMutex);
+    if (!g_signalled)
+    {
+        g_signalled = true;
+#if defined(CA_WAKEUP_EVENTFD)
+        uint64_t one = 1;
+        if (sizeof(one) != write(g_writeFd, &one, sizeof(one)))
+        {
+            OIC_LOG(ERROR, TAG, "Failed to signal the wakeup descriptor");
+        }
+#elif defined(CA_WAKEUP_PIPE)
+        char one = 1;
+        if (sizeof(one) != write(g_writeFd, &one, sizeof(one)))
+        {
+            OIC_LOG(ERROR, TAG, "Failed to signal the wakeup descriptor");
+        }
+#endif
+        oc_cond_broadcast(g_wakeupCond);
+    }
+    oc_mutex_unlock(g_wakeupMutex);
+}
+
+void CAWakeupClear(void)
+{
+    if (!g_wakeupMutex)
+    {
+        return;
+    }
+
+    oc_mutex_lock(g_wakeupMutex);
+    if (g_signalled)
+    {
+        g_signalled = false;
+#if defined(CA_WAKEUP_EVENTFD)
+        uint64_t count;
+        if (sizeof(count) != read(g_readFd, &count, sizeof(count)))
+        {
+            OIC_LOG(ERROR, TAG, "Failed to clear the wakeup descriptor");
+        }
+#elif defined(CA_WAKEUP_PIPE)
+        char one;
+        if (sizeof(one) != read(g_readFd, &one, sizeof(one)))
+        {
+            OIC_LOG(ERROR, TAG, "Failed to clear the wakeup descriptor");
+        }
+#endif
+    }
+    oc_mutex_unlock(g_wakeupMutex);
+}
+
+bool CAWakeupWait(uint32_t timeoutMs)
+{
+    if (!g_wakeupMutex)
+    {
+        return false;
+    }
+
+    oc_mutex_lock(g_wakeupMutex);
+    // A wait of 0 microseconds would not time out.
+    if (!g_signalled && timeoutMs)
+    {
+        oc_cond_wait_for(g_wakeupCond, g_wakeupMutex, (uint64_t)timeoutMs * 1000);
+    }
+    bool signalled = g_signalled;
+    oc_mutex_unlock(g_wakeupMutex);
+    return signalled;
+}
+
+int CAWakeupGetFd(void)
+{
+    return g_readFd;
+}
@@ -36,6 +36,9 @@
 #ifdef HAVE_SYS_POLL_H
 #include <sys/poll.h>
 #endif
+#ifdef HAVE_SYS_EVENTFD_H
+#include <sys/eventfd.h>
+#endif
 #include <stdio.h>
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
@@ -135,6 +138,11 @@ static void CASocketEventReturned(u_arraylist_t* sessionList, CASocketFd_t socke
 static CAResult_t CAReceiveMessage(CATCPSessionInfo_t *svritem);
 static void CAReceiveHandler(void *data);
 static CAResult_t CATCPCreateSocket(int family, CATCPSessionInfo_t *svritem);
+#if !defined(WSA_WAIT_EVENT_0)
+static ssize_t CAWakeUpForReadFdsUpdate(const char *host);
+#else
+static void CAWakeUpForReadFdsUpdate();
+#endif
 
 #if defined(WSA_WAIT_EVENT_0)
 #define CHECKFD(FD)
@@ -239,6 +247,12 @@ static void CARemoveSession(CATCPSessionInfo_t *session)
     oc_mutex_unlock(g_mutexObjectList);
     if (ref)
     {
+        // the receive thread holds the last reference until it stops watching the socket.
+#if !defined(WSA_WAIT_EVENT_0)
+        CAWakeUpForReadFdsUpdate(session->sep.endpoint.addr);
+#else
+        CAWakeUpForReadFdsUpdate();
+#endif
         oc_refcounter_dec(ref);
     }
 }
@@ -282,6 +296,9 @@ static void CAFindReadyMessage(u_arraylist_t* sessionList)
     fd_set readFds;
     struct timeval timeout = { .tv_sec = caglobals.tcp.selectTimeout };
 
+    // Read fds updates and shutdown wake the thread, poll only if that is not possible.
+    struct timeval *tv = (OC_INVALID_SOCKET != caglobals.tcp.connectionFds[0]) ? NULL : &timeout;
+
     FD_ZERO(&readFds);
     CA_FD_SET(ipv4, &readFds);
     CA_FD_SET(ipv4s, &readFds);
@@ -306,7 +323,7 @@ static void CAFindReadyMessage(u_arraylist_t* sessionList)
         }
     }
 
-    int ret = select(caglobals.tcp.maxfd + 1, &readFds, NULL, NULL, &timeout);
+    int ret = select(caglobals.tcp.maxfd + 1, &readFds, NULL, NULL, tv);
 
     if (caglobals.tcp.terminate)
     {
@@ -356,15 +373,25 @@ static void CASelectReturned(u_arraylist_t* sessionList, fd_set *readFds)
     else if (-1 != caglobals.tcp.connectionFds[0] &&
             FD_ISSET(caglobals.tcp.connectionFds[0], readFds))
     {
-        // new connection was created from remote device.
+        // sessions were added or removed, or the server is stopping.
         // exit the function to update read file descriptor.
+#ifdef HAVE_SYS_EVENTFD_H
+        uint64_t count = 0;
+        ssize_t len = read(caglobals.tcp.connectionFds[0], &count, sizeof (count));
+        if (-1 == len)
+        {
+            return;
+        }
+        OIC_LOG_V(DEBUG, TAG, "Received %" PRIu64 " read fds update events", count);
+#else
         char buf[MAX_ADDR_STR_SIZE_CA] = {0};
-        ssize_t len = read(caglobals.tcp.connectionFds[0], buf, sizeof (buf));
+        ssize_t len = read(caglobals.tcp.connectionFds[0], buf, sizeof (buf) - 1);
         if (-1 == len)
         {
             return;
         }
-        OIC_LOG_V(DEBUG, TAG, "Received new connection event with [%s]", buf);
+        OIC_LOG_V(DEBUG, TAG, "Received read fds update event with [%s]", buf);
+#endif
         return;
     }
     else
@@ -930,7 +957,13 @@ static ssize_t CAWakeUpForReadFdsUpdate(const char *host)
         ssize_t len = 0;
         do
         {
+#ifdef HAVE_SYS_EVENTFD_H
+            (void)host;
+            uint64_t count = 1;
+            len = write(caglobals.tcp.connectionFds[1], &count, sizeof (count));
+#else
             len = write(caglobals.tcp.connectionFds[1], host, strlen(host));
+#endif
         } while ((len == -1) && (errno == EINTR));
 
         if ((len == -1) && (errno != EINTR) && (errno != EPIPE))
@@ -1126,6 +1159,35 @@ static void CAInitializePipe(int *fds)
         }
     }
 }
+
+/**
+ * Create the fds used to wake the receive thread when its read fds change.
+ * On Linux an eventfd serves as both ends and also signals shutdown.
+ */
+static void CAInitializeWakeupFds(int *fds)
+{
+#ifdef HAVE_SYS_EVENTFD_H
+    fds[0] = eventfd(0, EFD_CLOEXEC);
+    fds[1] = fds[0];
+    if (-1 == fds[0])
+    {
+        OIC_LOG_V(ERROR, TAG, "eventfd failed: %s", strerror(errno));
+    }
+#else
+    CAInitializePipe(fds);
+#endif
+}
+
+static void CACloseWakeupFds(int *fds)
+{
+    if (fds[1] != fds[0])
+    {
+        close(fds[1]);
+    }
+    close(fds[0]);
+    fds[1] = OC_INVALID_SOCKET;
+    fds[0] = OC_INVALID_SOCKET;
+}
 #endif
 
 #define NEWSOCKET(FAMILY, NAME) \
@@ -1202,6 +1264,10 @@ CAResult_t CATCPStartServer(const ca_thread_pool_t threadPool)
         OIC_LOG(ERROR, TAG, "failed to create shutdown event");
         return res;
     }
+#elif defined(HAVE_SYS_EVENTFD_H)
+    // shutdown is signalled through the wakeup eventfd.
+    caglobals.tcp.shutdownFds[0] = OC_INVALID_SOCKET;
+    caglobals.tcp.shutdownFds[1] = OC_INVALID_SOCKET;
 #else
     CAInitializePipe(caglobals.tcp.shutdownFds);
     CHECKFD(caglobals.tcp.shutdownFds[0]);
@@ -1209,7 +1275,7 @@ CAResult_t CATCPStartServer(const ca_thread_pool_t threadPool)
 #endif
 
 #ifndef WSA_WAIT_EVENT_0
-    CAInitializePipe(caglobals.tcp.connectionFds);
+    CAInitializeWakeupFds(caglobals.tcp.connectionFds);
     CHECKFD(caglobals.tcp.connectionFds[0]);
     CHECKFD(caglobals.tcp.connectionFds[1]);
 #endif
@@ -1248,6 +1314,11 @@ void CATCPStopServer(void)
         caglobals.tcp.shutdownFds[1] = OC_INVALID_SOCKET;
         // receive thread will stop immediately
     }
+    else
+    {
+        // receive thread will stop immediately, or in selectTimeout seconds without wakeup fds.
+        CAWakeUpForReadFdsUpdate("shutdown");
+    }
 #else
     // unit tests sometimes stop the TCP Server after starting just the UDP Server.
     if (caglobals.tcp.updateEvent != NULL)
@@ -1273,10 +1344,7 @@ void CATCPStopServer(void)
     }
 
 #if !defined(WSA_WAIT_EVENT_0)
-    close(caglobals.tcp.connectionFds[1]);
-    close(caglobals.tcp.connectionFds[0]);
-    caglobals.tcp.connectionFds[1] = OC_INVALID_SOCKET;
-    caglobals.tcp.connectionFds[0] = OC_INVALID_SOCKET;
+    CACloseWakeupFds(caglobals.tcp.connectionFds);
 
     close(caglobals.tcp.shutdownFds[0]);
     caglobals.tcp.shutdownFds[0] = OC_INVALID_SOCKET;
@@ -1676,6 +1744,11 @@ CAResult_t CASearchAndDeleteTCPSession(const CAEndpoint_t *endpoint)
     {
        OIC_LOG(DEBUG, TAG, "Found in session list");
        oc_refcounter_dec(ref);
+#if !defined(WSA_WAIT_EVENT_0)
+       CAWakeUpForReadFdsUpdate(endpoint->addr);
+#else
+       CAWakeUpForReadFdsUpdate();
+#endif
        return CA_STATUS_OK;
     }
 
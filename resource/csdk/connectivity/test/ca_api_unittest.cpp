@@ -27,6 +27,7 @@
 #include "oic_malloc.h"
 #include "cafragmentation.h"
 #include "caleinterface.h"
+#include "caremotehandler.h"
 
 #define CA_TRANSPORT_ADAPTER_SCOPE  1000
 #define CA_BLE_FIRST_SEGMENT_PAYLOAD_SIZE (((CA_DEFAULT_BLE_MTU_SIZE) - (CA_BLE_HEADER_SIZE)) \
@@ -842,6 +843,143 @@ TEST(CAfragmentationTest, DefragmentTest)
 #endif
 }
 
+TEST(CAfragmentationTest, SegmenterTest)
+{
+#if defined(LE_ADAPTER)
+    const uint32_t dataLen = 100;
+    uint8_t data[dataLen];
+    for (uint32_t i = 0; i < dataLen; i++)
+    {
+        data[i] = (uint8_t) i;
+    }
+
+    CABLESegmenter_t segmenter;
+    EXPECT_EQ(CA_STATUS_INVALID_PARAM, CAInitBLESegmenter(&segmenter, data, dataLen,
+                                                          CA_BLE_HEADER_SIZE
+                                                          + CA_BLE_LENGTH_HEADER_SIZE,
+                                                          1, CA_BLE_PACKET_NON_SECURE, 2));
+    EXPECT_EQ(CA_STATUS_INVALID_PARAM, CAInitBLESegmenter(&segmenter, data, dataLen,
+                                                          CA_SUPPORTED_BLE_MTU_SIZE + 1,
+                                                          1, CA_BLE_PACKET_NON_SECURE, 2));
+    ASSERT_EQ(CA_STATUS_OK, CAInitBLESegmenter(&segmenter, data, dataLen,
+                                               CA_DEFAULT_BLE_MTU_SIZE,
+                                               1, CA_BLE_PACKET_SECURE, 2));
+
+    uint8_t defragData[dataLen] = {0};
+    uint32_t recvDataLen = 0;
+    uint32_t segmentCount = 0;
+    CABLESegment_t segment;
+    while (CAGetNextBLESegment(&segmenter, &segment))
+    {
+        uint8_t dataSegment[CA_DEFAULT_BLE_MTU_SIZE];
+        uint32_t length = CACopyBLESegment(&segment, dataSegment, sizeof(dataSegment));
+        ASSERT_NE(0u, length);
+        EXPECT_LE(length, (uint32_t) CA_DEFAULT_BLE_MTU_SIZE);
+
+        CABLEPacketStart_t startFlag = CA_BLE_PACKET_NOT_START;
+        CABLEPacketSecure_t secureFlag = CA_BLE_PACKET_NON_SECURE;
+        uint16_t sourcePort = 0;
+        uint16_t destPort = 0;
+        EXPECT_EQ(CA_STATUS_OK, CAParseHeader(dataSegment, &startFlag, &sourcePort,
+                                              &secureFlag, &destPort));
+        EXPECT_EQ(0u == segmentCount ? CA_BLE_PACKET_START : CA_BLE_PACKET_NOT_START,
+                  startFlag);
+        EXPECT_EQ(CA_BLE_PACKET_SECURE, secureFlag);
+        EXPECT_EQ(1, sourcePort);
+        EXPECT_EQ(2, destPort);
+
+        uint32_t headerLength = CA_BLE_HEADER_SIZE;
+        if (CA_BLE_PACKET_START == startFlag)
+        {
+            uint32_t totalLength = 0;
+            EXPECT_EQ(CA_STATUS_OK, CAParseHeaderPayloadLength(dataSegment,
+                                                               CA_BLE_LENGTH_HEADER_SIZE,
+                                                               &totalLength));
+            EXPECT_EQ(dataLen, totalLength);
+            headerLength += CA_BLE_LENGTH_HEADER_SIZE;
+        }
+        ASSERT_LE(recvDataLen + length - headerLength, dataLen);
+        memcpy(defragData + recvDataLen, dataSegment + headerLength, length - headerLength);
+        recvDataLen += length - headerLength;
+        segmentCount++;
+    }
+
+    // 14 bytes in the first segment and 18 in each of the others.
+    EXPECT_EQ(6u, segmentCount);
+    EXPECT_EQ(dataLen, recvDataLen);
+    EXPECT_EQ(0, memcmp(data, defragData, dataLen));
+    EXPECT_FALSE(CAGetNextBLESegment(&segmenter, &segment));
+
+    // The first segment is the one CAMakeFirstDataSegment() makes.
+    uint8_t dataHeader[CA_BLE_HEADER_SIZE] = {0};
+    uint8_t lengthHeader[CA_BLE_LENGTH_HEADER_SIZE] = {0};
+    uint8_t dataSegment[CA_DEFAULT_BLE_MTU_SIZE] = {0};
+    uint8_t expectedSegment[CA_DEFAULT_BLE_MTU_SIZE] = {0};
+    EXPECT_EQ(CA_STATUS_OK, CAGenerateHeader(dataHeader, CA_BLE_PACKET_START,
+                                             1, CA_BLE_PACKET_SECURE, 2));
+    EXPECT_EQ(CA_STATUS_OK, CAGenerateHeaderPayloadLength(lengthHeader,
+                                                          CA_BLE_LENGTH_HEADER_SIZE,
+                                                          dataLen));
+    EXPECT_EQ(CA_STATUS_OK, CAMakeFirstDataSegment(expectedSegment, data,
+                                                   CA_BLE_FIRST_SEGMENT_PAYLOAD_SIZE,
+                                                   dataHeader, lengthHeader));
+    ASSERT_EQ(CA_STATUS_OK, CAInitBLESegmenter(&segmenter, data, dataLen,
+                                               CA_DEFAULT_BLE_MTU_SIZE,
+                                               1, CA_BLE_PACKET_SECURE, 2));
+    ASSERT_TRUE(CAGetNextBLESegment(&segmenter, &segment));
+    EXPECT_EQ(0u, CACopyBLESegment(&segment, dataSegment, CA_DEFAULT_BLE_MTU_SIZE - 1));
+    EXPECT_EQ((uint32_t) CA_DEFAULT_BLE_MTU_SIZE,
+              CACopyBLESegment(&segment, dataSegment, sizeof(dataSegment)));
+    EXPECT_EQ(0, memcmp(expectedSegment, dataSegment, sizeof(dataSegment)));
+#endif
+}
+
+#if defined(LE_ADAPTER)
+static CABLESenderInfo_t *CreateSenderInfo(const char *address, uint16_t port)
+{
+    CABLESenderInfo_t *info = (CABLESenderInfo_t *) OICCalloc(1, sizeof(CABLESenderInfo_t));
+    info->remoteEndpoint = CACreateEndpointObject(CA_DEFAULT_FLAGS, CA_ADAPTER_GATT_BTLE,
+                                                  address, port);
+    info->defragData = (uint8_t *) OICCalloc(1, 1);
+    return info;
+}
+#endif
+
+TEST(CAfragmentationTest, SenderTableTest)
+{
+#if defined(LE_ADAPTER)
+    CABLESenderTable_t table = {};
+    const char address[] = "AA:BB:CC:DD:EE:FF";
+    const char otherAddress[] = "00:11:22:33:44:55";
+
+    CABLESenderInfo_t *first = CreateSenderInfo(address, 1);
+    CABLESenderInfo_t *second = CreateSenderInfo(address, 2);
+    CABLESenderInfo_t *other = CreateSenderInfo(otherAddress, 1);
+    EXPECT_EQ(CA_STATUS_OK, CAAddBLESenderInfo(&table, first));
+    EXPECT_EQ(CA_STATUS_OK, CAAddBLESenderInfo(&table, second));
+    EXPECT_EQ(CA_STATUS_OK, CAAddBLESenderInfo(&table, other));
+
+    EXPECT_EQ(first, CAGetBLESenderInfo(&table, address, 1));
+    EXPECT_EQ(second, CAGetBLESenderInfo(&table, "aa:bb:cc:dd:ee:ff", 2));
+    EXPECT_EQ(other, CAGetBLESenderInfo(&table, otherAddress, 1));
+    EXPECT_EQ(NULL, CAGetBLESenderInfo(&table, address, 3));
+
+    CARemoveBLESenderInfo(&table, second);
+    EXPECT_EQ(NULL, CAGetBLESenderInfo(&table, address, 2));
+    EXPECT_EQ(first, CAGetBLESenderInfo(&table, address, 1));
+    CADestroyBLESenderInfo(second);
+
+    CAAddBLESenderInfo(&table, CreateSenderInfo(address, 2));
+    CARemoveBLESendersOfAddress(&table, address);
+    EXPECT_EQ(NULL, CAGetBLESenderInfo(&table, address, 1));
+    EXPECT_EQ(NULL, CAGetBLESenderInfo(&table, address, 2));
+    EXPECT_EQ(other, CAGetBLESenderInfo(&table, otherAddress, 1));
+
+    CAClearBLESenderInfo(&table);
+    EXPECT_EQ(NULL, CAGetBLESenderInfo(&table, otherAddress, 1));
+#endif
+}
+
 TEST(Ipv6ScopeLevel, getMulticastScope)
 {
 
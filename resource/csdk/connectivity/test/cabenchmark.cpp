@@ -0,0 +1,354 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+// Microbenchmarks of the connectivity hot paths: CoAP PDU generation and
+// parsing, and the containers used for endpoints, sessions, timeouts and messages.
+// Results are printed as one JSON object per benchmark.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "caprotocolmessage.h"
+#include "caremotehandler.h"
+#include "uarraylist.h"
+#include "uhashmap.h"
+#include "uheap.h"
+#include "uqueue.h"
+#include "oic_malloc.h"
+
+namespace
+{
+    const int PDU_ITERATIONS = 100000;
+    const int LIST_ITERATIONS = 100;
+    const size_t LIST_LENGTH = 1000;
+
+    template <typename Op>
+    double nsPerOp(int iterations, Op op)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            op(i);
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    }
+
+    struct ListItem
+    {
+        size_t key;
+        u_hashmap_entry_t mapEntry;
+        u_heap_entry_t heapEntry;
+    };
+
+    bool matchItem(const u_hashmap_entry_t *entry, const void *key)
+    {
+        return U_HASHMAP_CONTAINER(entry, ListItem, mapEntry)->key == *(const size_t *)key;
+    }
+
+    bool itemBefore(const u_heap_entry_t *first, const u_heap_entry_t *second)
+    {
+        return U_HEAP_CONTAINER(first, ListItem, heapEntry)->key
+            < U_HEAP_CONTAINER(second, ListItem, heapEntry)->key;
+    }
+
+    void report(const char *name, int iterations, double ns, const std::string &extra = "")
+    {
+        std::cout << "{\"benchmark\":\"" << name << "\",\"iterations\":" << iterations
+                  << extra << ",\"nsPerOp\":" << ns << "}" << std::endl;
+    }
+}
+
+class CABenchmark : public ::testing::Test
+{
+protected:
+    void SetUp()
+    {
+        memset(&endpoint, 0, sizeof(endpoint));
+        endpoint.flags = CA_DEFAULT_FLAGS;
+        endpoint.adapter = CA_ADAPTER_IP;
+        endpoint.port = 5683;
+
+        // A POST of a small CBOR representation with a query, as sent by most clients.
+        for (size_t i = 0; i < sizeof(payload); i++)
+        {
+            payload[i] = (uint8_t)i;
+        }
+        memset(&info, 0, sizeof(info));
+        info.type = CA_MSG_CONFIRM;
+        info.messageId = 1;
+        info.token = (CAToken_t)"benchtok";
+        info.tokenLength = 8;
+        info.resourceUri = (CAURI_t)"/a/light/1?if=oic.if.a&rt=oic.r.switch.binary";
+        info.payload = payload;
+        info.payloadSize = sizeof(payload);
+        info.payloadFormat = CA_FORMAT_APPLICATION_VND_OCF_CBOR;
+        info.acceptFormat = CA_FORMAT_APPLICATION_VND_OCF_CBOR;
+        info.payloadVersion = 2048;
+        info.acceptVersion = 2048;
+    }
+
+    CAEndpoint_t endpoint;
+    CAInfo_t info;
+    uint8_t payload[128];
+};
+
+TEST_F(CABenchmark, GeneratePDU)
+{
+    size_t length = 0;
+    double ns = nsPerOp(PDU_ITERATIONS, [&](int)
+    {
+        coap_list_t *options = NULL;
+        coap_transport_t transport = COAP_UDP;
+        coap_pdu_t *pdu = CAGeneratePDU(CA_POST, &info, &endpoint, &options, &transport);
+        ASSERT_TRUE(NULL != pdu);
+        length = pdu->length;
+        coap_delete_list(options);
+        coap_delete_pdu(pdu);
+    });
+    report("CAGeneratePDU", PDU_ITERATIONS, ns, ",\"bytes\":" + std::to_string(length));
+}
+
+// Same message as GeneratePDU. With WITH_BWT, CAGeneratePDU leaves the options of
+// IP messages to CAAddBlockOption, so only this one measures a complete PDU there.
+TEST_F(CABenchmark, BuildPDU)
+{
+    size_t length = 0;
+    double ns = nsPerOp(PDU_ITERATIONS, [&](int)
+    {
+        coap_transport_t transport = COAP_UDP;
+        coap_pdu_t *pdu = CABuildPDU(CA_POST, &info, &endpoint, &transport);
+        ASSERT_TRUE(NULL != pdu);
+        length = pdu->length;
+        coap_delete_pdu(pdu);
+    });
+    report("CABuildPDU", PDU_ITERATIONS, ns, ",\"bytes\":" + std::to_string(length));
+}
+
+TEST_F(CABenchmark, ParsePDU)
+{
+    coap_list_t *options = NULL;
+    coap_transport_t transport = COAP_UDP;
+    coap_pdu_t *pdu = CAGeneratePDU(CA_POST, &info, &endpoint, &options, &transport);
+    ASSERT_TRUE(NULL != pdu);
+    std::vector<char> data((char *)pdu->transport_hdr, (char *)pdu->transport_hdr + pdu->length);
+    coap_delete_list(options);
+    coap_delete_pdu(pdu);
+
+    double ns = nsPerOp(PDU_ITERATIONS, [&](int)
+    {
+        uint32_t code = CA_NOT_FOUND;
+        coap_pdu_t *parsed = CAParsePDU(data.data(), data.size(), &code, &endpoint);
+        ASSERT_TRUE(NULL != parsed);
+        coap_delete_pdu(parsed);
+    });
+    report("CAParsePDU", PDU_ITERATIONS, ns, ",\"bytes\":" + std::to_string(data.size()));
+
+    uint32_t code = CA_NOT_FOUND;
+    coap_pdu_t *parsed = CAParsePDU(data.data(), data.size(), &code, &endpoint);
+    ASSERT_TRUE(NULL != parsed);
+    ns = nsPerOp(PDU_ITERATIONS, [&](int)
+    {
+        CAInfo_t outInfo;
+        memset(&outInfo, 0, sizeof(outInfo));
+        ASSERT_EQ(CA_STATUS_OK, CAGetInfoFromPDU(parsed, &endpoint, &code, &outInfo));
+        OICFree(outInfo.token);
+        OICFree(outInfo.options);
+        OICFree(outInfo.resourceUri);
+        OICFree(outInfo.payload);
+    });
+    report("CAGetInfoFromPDU", PDU_ITERATIONS, ns, ",\"bytes\":" + std::to_string(data.size()));
+    coap_delete_pdu(parsed);
+}
+
+// Whole receive path of a request up to its info, which is destroyed when the stack
+// is done with it: copying the pdu into the info, or pointing the info into it.
+TEST_F(CABenchmark, ReceivePDU)
+{
+    coap_transport_t transport = COAP_UDP;
+    coap_pdu_t *pdu = CABuildPDU(CA_POST, &info, &endpoint, &transport);
+    ASSERT_TRUE(NULL != pdu);
+    std::vector<char> data((char *)pdu->transport_hdr, (char *)pdu->transport_hdr + pdu->length);
+    coap_delete_pdu(pdu);
+
+    double ns = nsPerOp(PDU_ITERATIONS, [&](int)
+    {
+        uint32_t code = CA_NOT_FOUND;
+        coap_pdu_t *parsed = CAParsePDU(data.data(), data.size(), &code, &endpoint);
+        ASSERT_TRUE(NULL != parsed);
+        CARequestInfo_t *reqInfo = (CARequestInfo_t *)OICCalloc(1, sizeof(CARequestInfo_t));
+        ASSERT_TRUE(NULL != reqInfo);
+        ASSERT_EQ(CA_STATUS_OK, CAGetInfoFromPDU(parsed, &endpoint, &code, &reqInfo->info));
+        coap_delete_pdu(parsed);
+        CADestroyRequestInfoInternal(reqInfo);
+    });
+    report("ReceiveCopied", PDU_ITERATIONS, ns, ",\"bytes\":" + std::to_string(data.size()));
+
+    ns = nsPerOp(PDU_ITERATIONS, [&](int)
+    {
+        uint32_t code = CA_NOT_FOUND;
+        coap_pdu_t *parsed = CAParsePDU(data.data(), data.size(), &code, &endpoint);
+        ASSERT_TRUE(NULL != parsed);
+        oc_refcounter buffer = CACreateInfoBuffer(parsed, &endpoint);
+        ASSERT_TRUE(NULL != buffer);
+        CARequestInfo_t *reqInfo = (CARequestInfo_t *)OICCalloc(1, sizeof(CARequestInfo_t));
+        ASSERT_TRUE(NULL != reqInfo);
+        ASSERT_EQ(CA_STATUS_OK, CAGetInfoFromPDUBuffer(buffer, &endpoint, &code, &reqInfo->info));
+        oc_refcounter_dec(buffer);
+        CADestroyRequestInfoInternal(reqInfo);
+    });
+    report("ReceiveBuffered", PDU_ITERATIONS, ns, ",\"bytes\":" + std::to_string(data.size()));
+}
+
+TEST_F(CABenchmark, ArrayList)
+{
+    std::vector<int> items(LIST_LENGTH);
+
+    // Grow to LIST_LENGTH, look every item up and remove from the front.
+    double ns = nsPerOp(LIST_ITERATIONS, [&](int)
+    {
+        u_arraylist_t *list = u_arraylist_create();
+        for (size_t i = 0; i < LIST_LENGTH; i++)
+        {
+            u_arraylist_add(list, &items[i]);
+        }
+        for (size_t i = 0; i < LIST_LENGTH; i++)
+        {
+            size_t index = 0;
+            u_arraylist_get_index(list, &items[(i * 7919) % LIST_LENGTH], &index);
+        }
+        while (u_arraylist_length(list) > 0)
+        {
+            u_arraylist_remove(list, 0);
+        }
+        u_arraylist_free(&list);
+    });
+    report("UArrayList", LIST_ITERATIONS, ns / LIST_LENGTH,
+           ",\"length\":" + std::to_string(LIST_LENGTH));
+}
+
+// Same operations as ArrayList, looking items up by key.
+TEST_F(CABenchmark, HashMap)
+{
+    std::vector<ListItem> items(LIST_LENGTH);
+    for (size_t i = 0; i < LIST_LENGTH; i++)
+    {
+        items[i].key = i;
+    }
+
+    double ns = nsPerOp(LIST_ITERATIONS, [&](int)
+    {
+        u_hashmap_t *map = u_hashmap_create();
+        for (size_t i = 0; i < LIST_LENGTH; i++)
+        {
+            u_hashmap_add(map, &items[i].mapEntry,
+                          u_hashmap_hash(U_HASHMAP_HASH_INIT, &items[i].key, sizeof(size_t)));
+        }
+        for (size_t i = 0; i < LIST_LENGTH; i++)
+        {
+            size_t key = (i * 7919) % LIST_LENGTH;
+            u_hashmap_find(map, u_hashmap_hash(U_HASHMAP_HASH_INIT, &key, sizeof(key)),
+                           &key, matchItem);
+        }
+        for (size_t i = 0; i < LIST_LENGTH; i++)
+        {
+            u_hashmap_remove(map, &items[i].mapEntry);
+        }
+        u_hashmap_free(&map);
+    });
+    report("UHashMap", LIST_ITERATIONS, ns / LIST_LENGTH,
+           ",\"length\":" + std::to_string(LIST_LENGTH));
+}
+
+// Earliest first removal of timeouts, scanning an array list as the
+// retransmission list does, and with a heap.
+TEST_F(CABenchmark, Timeouts)
+{
+    std::vector<ListItem> items(LIST_LENGTH);
+    for (size_t i = 0; i < LIST_LENGTH; i++)
+    {
+        items[i].key = (i * 7919) % LIST_LENGTH;
+    }
+
+    double ns = nsPerOp(LIST_ITERATIONS, [&](int)
+    {
+        u_arraylist_t *list = u_arraylist_create();
+        for (size_t i = 0; i < LIST_LENGTH; i++)
+        {
+            u_arraylist_add(list, &items[i]);
+        }
+        while (u_arraylist_length(list) > 0)
+        {
+            size_t first = 0;
+            for (size_t i = 1; i < u_arraylist_length(list); i++)
+            {
+                if (((ListItem *)u_arraylist_get(list, i))->key
+                    < ((ListItem *)u_arraylist_get(list, first))->key)
+                {
+                    first = i;
+                }
+            }
+            u_arraylist_remove(list, first);
+        }
+        u_arraylist_free(&list);
+    });
+    report("UArrayListTimeouts", LIST_ITERATIONS, ns / LIST_LENGTH,
+           ",\"length\":" + std::to_string(LIST_LENGTH));
+
+    ns = nsPerOp(LIST_ITERATIONS, [&](int)
+    {
+        u_heap_t *heap = u_heap_create(itemBefore);
+        for (size_t i = 0; i < LIST_LENGTH; i++)
+        {
+            u_heap_push(heap, &items[i].heapEntry);
+        }
+        while (NULL != u_heap_pop(heap))
+        {
+        }
+        u_heap_free(&heap);
+    });
+    report("UHeapTimeouts", LIST_ITERATIONS, ns / LIST_LENGTH,
+           ",\"length\":" + std::to_string(LIST_LENGTH));
+}
+
+TEST_F(CABenchmark, Queue)
+{
+    std::vector<u_queue_message_t> messages(LIST_LENGTH);
+
+    // Enqueue LIST_LENGTH messages, then drain the queue.
+    double ns = nsPerOp(LIST_ITERATIONS, [&](int)
+    {
+        u_queue_t *queue = u_queue_create();
+        for (size_t i = 0; i < LIST_LENGTH; i++)
+        {
+            u_queue_add_element(queue, &messages[i]);
+        }
+        while (NULL != u_queue_get_element(queue))
+        {
+        }
+        u_queue_delete(queue);
+    });
+    report("UQueue", LIST_ITERATIONS, ns / LIST_LENGTH,
+           ",\"length\":" + std::to_string(LIST_LENGTH));
+}
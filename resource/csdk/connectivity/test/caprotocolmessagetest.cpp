@@ -28,7 +28,9 @@
 #include <gtest/gtest.h>
 
 #include "oic_malloc.h"
+#include "oic_string.h"
 #include "caprotocolmessage.h"
+#include "caremotehandler.h"
 
 namespace {
 
@@ -261,3 +263,186 @@ TEST(CAProtocolMessage, CAGetInfoFromPDU)
     coap_delete_list(options);
     coap_delete_pdu(pdu);
 }
+
+TEST(CAProtocolMessage, CABuildPDUMatchesCAGeneratePDU)
+{
+    CAEndpoint_t tempRep;
+    memset(&tempRep, 0, sizeof(CAEndpoint_t));
+    tempRep.flags = CA_DEFAULT_FLAGS;
+    tempRep.adapter = CA_ADAPTER_GATT_BTLE;
+
+    CAHeaderOption_t headerOption;
+    memset(&headerOption, 0, sizeof(CAHeaderOption_t));
+    headerOption.optionID = 2100;
+    headerOption.optionLength = 3;
+    memcpy(headerOption.optionData, "abc", 3);
+
+    CAInfo_t inData;
+    memset(&inData, 0, sizeof(CAInfo_t));
+    inData.type = CA_MSG_CONFIRM;
+    inData.messageId = 1234;
+    inData.token = (CAToken_t)"token";
+    inData.tokenLength = (uint8_t)strlen(inData.token);
+    inData.resourceUri = (CAURI_t)"/a/light/%20x?rt=core.light&if=oic.if.baseline";
+    inData.options = &headerOption;
+    inData.numOptions = 1;
+    inData.payload = (CAPayload_t) "requestPayload";
+    inData.payloadSize = strlen((const char *)inData.payload);
+    inData.payloadFormat = CA_FORMAT_APPLICATION_VND_OCF_CBOR;
+    inData.acceptFormat = CA_FORMAT_APPLICATION_VND_OCF_CBOR;
+    inData.payloadVersion = 2048;
+    inData.acceptVersion = 2048;
+
+    coap_list_t *options = NULL;
+    coap_transport_t transport = COAP_UDP;
+    coap_pdu_t *expected = CAGeneratePDU(CA_POST, &inData, &tempRep, &options, &transport);
+    ASSERT_TRUE(expected != NULL);
+
+    coap_transport_t builtTransport = COAP_TCP;
+    coap_pdu_t *pdu = CABuildPDU(CA_POST, &inData, &tempRep, &builtTransport);
+    ASSERT_TRUE(pdu != NULL);
+
+    EXPECT_EQ(transport, builtTransport);
+    ASSERT_EQ(expected->length, pdu->length);
+    EXPECT_EQ(pdu->length, pdu->max_size);
+    EXPECT_EQ(0, memcmp(expected->transport_hdr, pdu->transport_hdr, pdu->length));
+
+    coap_delete_list(options);
+    coap_delete_pdu(expected);
+    coap_delete_pdu(pdu);
+}
+
+TEST(CAProtocolMessage, CABuildPDUGetInfo)
+{
+    CAEndpoint_t tempRep;
+    memset(&tempRep, 0, sizeof(CAEndpoint_t));
+    tempRep.flags = CA_DEFAULT_FLAGS;
+    tempRep.adapter = CA_ADAPTER_IP;
+    tempRep.port = 5683;
+
+    CAInfo_t inData;
+    memset(&inData, 0, sizeof(CAInfo_t));
+    inData.type = CA_MSG_NONCONFIRM;
+    inData.token = (CAToken_t)"token";
+    inData.tokenLength = (uint8_t)strlen(inData.token);
+    inData.resourceUri = (CAURI_t)"/a/light?rt=core.light";
+    inData.payload = (CAPayload_t) "requestPayload";
+    inData.payloadSize = strlen((const char *)inData.payload);
+    inData.payloadFormat = CA_FORMAT_APPLICATION_CBOR;
+
+    coap_transport_t transport = COAP_UDP;
+    coap_pdu_t *pdu = CABuildPDU(CA_PUT, &inData, &tempRep, &transport);
+    ASSERT_TRUE(pdu != NULL);
+
+    uint32_t code = CA_NOT_FOUND;
+    CAInfo_t outData;
+    memset(&outData, 0, sizeof(CAInfo_t));
+    EXPECT_EQ(CA_STATUS_OK, CAGetInfoFromPDU(pdu, &tempRep, &code, &outData));
+
+    EXPECT_EQ(static_cast<uint32_t>(CA_PUT), code);
+    EXPECT_STREQ("/a/light?rt=core.light", outData.resourceUri);
+    EXPECT_EQ(CA_FORMAT_APPLICATION_CBOR, outData.payloadFormat);
+    ASSERT_EQ(inData.payloadSize, outData.payloadSize);
+    EXPECT_EQ(0, memcmp(inData.payload, outData.payload, outData.payloadSize));
+
+    OICFree(outData.token);
+    OICFree(outData.options);
+    OICFree(outData.payload);
+    OICFree(outData.resourceUri);
+    coap_delete_pdu(pdu);
+}
+
+TEST(CAProtocolMessage, CABuildPDUTooManyOptions)
+{
+    CAEndpoint_t tempRep;
+    memset(&tempRep, 0, sizeof(CAEndpoint_t));
+    tempRep.flags = CA_DEFAULT_FLAGS;
+    tempRep.adapter = CA_ADAPTER_IP;
+
+    std::string uri;
+    for (int i = 0; i < 64; i++)
+    {
+        uri += "/a";
+    }
+
+    CAInfo_t inData;
+    memset(&inData, 0, sizeof(CAInfo_t));
+    inData.type = CA_MSG_NONCONFIRM;
+    inData.resourceUri = (CAURI_t)uri.c_str();
+
+    // left to CAGeneratePDU.
+    coap_transport_t transport = COAP_UDP;
+    EXPECT_TRUE(NULL == CABuildPDU(CA_GET, &inData, &tempRep, &transport));
+}
+
+TEST(CAProtocolMessage, CAGetInfoFromPDUBuffer)
+{
+    CAEndpoint_t tempRep;
+    memset(&tempRep, 0, sizeof(CAEndpoint_t));
+    tempRep.flags = CA_DEFAULT_FLAGS;
+    tempRep.adapter = CA_ADAPTER_IP;
+    tempRep.port = 5683;
+
+    CAHeaderOption_t option;
+    memset(&option, 0, sizeof(CAHeaderOption_t));
+    option.protocolID = CA_COAP_ID;
+    option.optionID = 2048;
+    option.optionLength = 4;
+    memcpy(option.optionData, "abcd", 4);
+
+    CAInfo_t inData;
+    memset(&inData, 0, sizeof(CAInfo_t));
+    inData.type = CA_MSG_NONCONFIRM;
+    inData.token = (CAToken_t)"token";
+    inData.tokenLength = (uint8_t)strlen(inData.token);
+    inData.options = &option;
+    inData.numOptions = 1;
+    inData.resourceUri = (CAURI_t)"/a/light?rt=core.light";
+    inData.payload = (CAPayload_t) "requestPayload";
+    inData.payloadSize = strlen((const char *)inData.payload);
+    inData.payloadFormat = CA_FORMAT_APPLICATION_CBOR;
+
+    coap_transport_t transport = COAP_UDP;
+    coap_pdu_t *pdu = CABuildPDU(CA_PUT, &inData, &tempRep, &transport);
+    ASSERT_TRUE(pdu != NULL);
+
+    uint32_t code = CA_NOT_FOUND;
+    CARequestInfo_t *copied = (CARequestInfo_t *) OICCalloc(1, sizeof(CARequestInfo_t));
+    ASSERT_TRUE(copied != NULL);
+    EXPECT_EQ(CA_STATUS_OK, CAGetInfoFromPDU(pdu, &tempRep, &code, &copied->info));
+
+    // the buffer owns the pdu from now on.
+    oc_refcounter buffer = CACreateInfoBuffer(pdu, &tempRep);
+    ASSERT_TRUE(buffer != NULL);
+
+    CARequestInfo_t *viewed = (CARequestInfo_t *) OICCalloc(1, sizeof(CARequestInfo_t));
+    ASSERT_TRUE(viewed != NULL);
+    code = CA_NOT_FOUND;
+    EXPECT_EQ(CA_STATUS_OK, CAGetInfoFromPDUBuffer(buffer, &tempRep, &code, &viewed->info));
+    EXPECT_EQ(static_cast<uint32_t>(CA_PUT), code);
+
+    // the info keeps the buffer alive.
+    oc_refcounter_dec(buffer);
+
+    EXPECT_TRUE(CAIsInInfoBuffer(&viewed->info, viewed->info.token));
+    EXPECT_TRUE(CAIsInInfoBuffer(&viewed->info, viewed->info.options));
+    EXPECT_TRUE(CAIsInInfoBuffer(&viewed->info, viewed->info.payload));
+    EXPECT_TRUE(CAIsInInfoBuffer(&viewed->info, viewed->info.resourceUri));
+    EXPECT_FALSE(CAIsInInfoBuffer(&copied->info, copied->info.payload));
+
+    ASSERT_EQ(copied->info.tokenLength, viewed->info.tokenLength);
+    EXPECT_EQ(0, memcmp(copied->info.token, viewed->info.token, viewed->info.tokenLength));
+    ASSERT_EQ(copied->info.numOptions, viewed->info.numOptions);
+    EXPECT_EQ(0, memcmp(copied->info.options, viewed->info.options,
+                        viewed->info.numOptions * sizeof(CAHeaderOption_t)));
+    ASSERT_EQ(copied->info.payloadSize, viewed->info.payloadSize);
+    EXPECT_EQ(0, memcmp(copied->info.payload, viewed->info.payload, viewed->info.payloadSize));
+    EXPECT_STREQ(copied->info.resourceUri, viewed->info.resourceUri);
+    EXPECT_EQ(copied->info.payloadFormat, viewed->info.payloadFormat);
+
+    // a field replaced after the parse is freed with the info.
+    viewed->info.resourceUri = OICStrdup("/a/replaced");
+
+    CADestroyRequestInfoInternal(copied);
+    CADestroyRequestInfoInternal(viewed);
+}
@@ -0,0 +1,163 @@
+/* ****************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "cacommon.h"
+#include "cathreadpool.h"
+#include "catcpinterface.h"
+
+// The receive thread must pick up session changes as soon as they happen,
+// not when its select() times out.
+
+namespace
+{
+    const std::chrono::milliseconds MAX_LATENCY(500);
+
+    std::mutex g_lock;
+    std::condition_variable g_cond;
+    bool g_received;
+    std::chrono::steady_clock::time_point g_receivedTime;
+
+    void packetReceived(const CASecureEndpoint_t *endpoint, const void *data, size_t dataLength)
+    {
+        (void)endpoint;
+        (void)data;
+        (void)dataLength;
+
+        std::lock_guard<std::mutex> lock(g_lock);
+        if (!g_received)
+        {
+            g_received = true;
+            g_receivedTime = std::chrono::steady_clock::now();
+        }
+        g_cond.notify_all();
+    }
+}
+
+class CATCPServerTests : public testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        g_received = false;
+        acceptedFd = -1;
+
+        // As set by CAInitializeTCP.
+        caglobals.tcp.ipv4.fd = OC_INVALID_SOCKET;
+        caglobals.tcp.ipv4s.fd = OC_INVALID_SOCKET;
+        caglobals.tcp.ipv6.fd = OC_INVALID_SOCKET;
+        caglobals.tcp.ipv6s.fd = OC_INVALID_SOCKET;
+        caglobals.tcp.selectTimeout = 10;
+        caglobals.tcp.listenBacklog = 3;
+
+        ASSERT_EQ(CA_STATUS_OK, ca_thread_pool_init(2, &threadPool));
+        CATCPSetPacketReceiveCallback(packetReceived);
+        ASSERT_EQ(CA_STATUS_OK, CATCPStartServer(threadPool));
+
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_NE(-1, listenFd);
+
+        struct sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ASSERT_EQ(0, bind(listenFd, (struct sockaddr *)&addr, sizeof(addr)));
+        ASSERT_EQ(0, listen(listenFd, 1));
+
+        socklen_t len = sizeof(addr);
+        ASSERT_EQ(0, getsockname(listenFd, (struct sockaddr *)&addr, &len));
+
+        endpoint = {};
+        endpoint.adapter = CA_ADAPTER_TCP;
+        endpoint.flags = CA_IPV4;
+        strcpy(endpoint.addr, "127.0.0.1");
+        endpoint.port = ntohs(addr.sin_port);
+    }
+
+    virtual void TearDown()
+    {
+        if (-1 != acceptedFd)
+        {
+            close(acceptedFd);
+        }
+        close(listenFd);
+        CATCPStopServer();
+        ca_thread_pool_free(threadPool);
+    }
+
+    ca_thread_pool_t threadPool;
+    int listenFd;
+    int acceptedFd;
+    CAEndpoint_t endpoint;
+};
+
+TEST_F(CATCPServerTests, FirstReceivedByteIsDispatchedWithoutPolling)
+{
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_NE(OC_INVALID_SOCKET, CAConnectTCPSession(&endpoint));
+
+    acceptedFd = accept(listenFd, NULL, NULL);
+    ASSERT_NE(-1, acceptedFd);
+    ASSERT_EQ(1, write(acceptedFd, "x", 1));
+
+    std::unique_lock<std::mutex> lock(g_lock);
+    ASSERT_TRUE(g_cond.wait_for(lock, std::chrono::seconds(30), []{ return g_received; }));
+
+    auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(g_receivedTime - start);
+    EXPECT_LT(latency.count(), MAX_LATENCY.count());
+}
+
+TEST_F(CATCPServerTests, DeletedSessionIsClosedWithoutPolling)
+{
+    ASSERT_NE(OC_INVALID_SOCKET, CAConnectTCPSession(&endpoint));
+
+    acceptedFd = accept(listenFd, NULL, NULL);
+    ASSERT_NE(-1, acceptedFd);
+
+    // Once a byte is received the receive thread is watching the session.
+    ASSERT_EQ(1, write(acceptedFd, "x", 1));
+    {
+        std::unique_lock<std::mutex> lock(g_lock);
+        ASSERT_TRUE(g_cond.wait_for(lock, std::chrono::seconds(30), []{ return g_received; }));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(CA_STATUS_OK, CASearchAndDeleteTCPSession(&endpoint));
+
+    // The peer sees the connection closed once the receive thread releases the session.
+    struct pollfd pfd = { acceptedFd, POLLIN, 0 };
+    ASSERT_EQ(1, poll(&pfd, 1, 30000));
+    char buf[1];
+    EXPECT_EQ(0, read(acceptedFd, buf, sizeof(buf)));
+
+    auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    EXPECT_LT(latency.count(), MAX_LATENCY.count());
+}
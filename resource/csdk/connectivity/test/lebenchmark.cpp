@@ -0,0 +1,218 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+// Throughput of the LE adapter over the loopback transport, built with
+// LE_LOOPBACK=1: messages go through the client send queue, fragmentation,
+// the server receive queue and reassembly, at the usual MTU sizes. The cost
+// of fragmenting alone is measured too, with the segment building functions
+// the send threads used before and with the segmenter they use now.
+// Results are printed as one JSON object per benchmark.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include "caleadapter.h"
+#include "caleinterface.h"
+#include "caleloopback.h"
+#include "cafragmentation.h"
+#include "cathreadpool.h"
+
+namespace
+{
+    const uint16_t MTU_SIZES[] = { CA_DEFAULT_BLE_MTU_SIZE, 185, 247, CA_SUPPORTED_BLE_MTU_SIZE };
+    const uint32_t MESSAGE_LENGTH = 64 * 1024;
+    const int MESSAGES = 16;
+    const int FRAGMENT_ITERATIONS = 200;
+
+    std::mutex g_lock;
+    std::condition_variable g_cond;
+    int g_receivedMessages = 0;
+    size_t g_receivedBytes = 0;
+    CAConnectivityHandler_t g_handler;
+
+    void registerCallback(CAConnectivityHandler_t handler)
+    {
+        g_handler = handler;
+    }
+
+    void packetReceived(const CASecureEndpoint_t *, const void *, size_t dataLen)
+    {
+        std::lock_guard<std::mutex> lock(g_lock);
+        g_receivedMessages++;
+        g_receivedBytes += dataLen;
+        g_cond.notify_all();
+    }
+
+    void adapterChanged(CATransportAdapter_t, CANetworkStatus_t)
+    {
+    }
+
+    void connectionChanged(const CAEndpoint_t *, bool)
+    {
+    }
+
+    void errorHandler(const CAEndpoint_t *, const void *, size_t, CAResult_t)
+    {
+    }
+}
+
+class LEBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp()
+    {
+        ASSERT_EQ(CA_STATUS_OK, ca_thread_pool_init(4, &threadPool));
+        ASSERT_EQ(CA_STATUS_OK, CAInitializeLE(registerCallback, packetReceived,
+                                               adapterChanged, connectionChanged,
+                                               errorHandler, threadPool));
+        ASSERT_EQ(CA_STATUS_OK, g_handler.startAdapter());
+        ASSERT_EQ(CA_STATUS_OK, g_handler.startListenServer());
+        ASSERT_EQ(CA_STATUS_OK, g_handler.startDiscoveryServer());
+
+        memset(&endpoint, 0, sizeof(endpoint));
+        endpoint.adapter = CA_ADAPTER_GATT_BTLE;
+        strncpy(endpoint.addr, CA_LE_LOOPBACK_ADDRESS, sizeof(endpoint.addr) - 1);
+        endpoint.port = CA_BLE_MULTICAST_PORT;
+
+        data.resize(MESSAGE_LENGTH);
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            data[i] = (uint8_t)i;
+        }
+    }
+
+    void TearDown()
+    {
+        g_handler.stopAdapter();
+        g_handler.terminate();
+        ca_thread_pool_free(threadPool);
+        CALESetLoopbackMtuSize(CA_DEFAULT_BLE_MTU_SIZE);
+    }
+
+    ca_thread_pool_t threadPool;
+    CAEndpoint_t endpoint;
+    std::vector<uint8_t> data;
+};
+
+TEST_F(LEBenchmark, LoopbackThroughput)
+{
+    for (uint16_t mtuSize : MTU_SIZES)
+    {
+        CALESetLoopbackMtuSize(mtuSize);
+        {
+            std::lock_guard<std::mutex> lock(g_lock);
+            g_receivedMessages = 0;
+            g_receivedBytes = 0;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < MESSAGES; i++)
+        {
+            ASSERT_EQ((int32_t)MESSAGE_LENGTH,
+                      g_handler.sendData(&endpoint, data.data(), MESSAGE_LENGTH, CA_REQUEST_DATA));
+        }
+        {
+            std::unique_lock<std::mutex> lock(g_lock);
+            ASSERT_TRUE(g_cond.wait_for(lock, std::chrono::seconds(30),
+                                        [] { return g_receivedMessages == MESSAGES; }));
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ((size_t)MESSAGES * MESSAGE_LENGTH, g_receivedBytes);
+        std::cout << "{\"benchmark\":\"LoopbackThroughput\",\"mtu\":" << mtuSize
+                  << ",\"messages\":" << MESSAGES
+                  << ",\"messageBytes\":" << MESSAGE_LENGTH
+                  << ",\"bytesPerSec\":" << (MESSAGES * MESSAGE_LENGTH / elapsed.count())
+                  << "}" << std::endl;
+    }
+}
+
+TEST_F(LEBenchmark, Fragment)
+{
+    uint8_t dataSegment[CA_SUPPORTED_BLE_MTU_SIZE];
+    for (uint16_t mtuSize : MTU_SIZES)
+    {
+        // Segment building of the send threads before the segmenter.
+        size_t legacyBytes = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < FRAGMENT_ITERATIONS; i++)
+        {
+            uint32_t midPacketCount = 0;
+            size_t remainingLen = 0;
+            size_t totalLength = 0;
+            uint8_t dataHeader[CA_BLE_HEADER_SIZE] = {0};
+            uint8_t lengthHeader[CA_BLE_LENGTH_HEADER_SIZE] = {0};
+            CAGenerateVariableForFragmentation(MESSAGE_LENGTH, &midPacketCount, &remainingLen,
+                                               &totalLength, mtuSize);
+            CAGenerateHeader(dataHeader, CA_BLE_PACKET_START, 1, CA_BLE_PACKET_NON_SECURE, 2);
+            CAGenerateHeaderPayloadLength(lengthHeader, CA_BLE_LENGTH_HEADER_SIZE, MESSAGE_LENGTH);
+            CAMakeFirstDataSegment(dataSegment, data.data(),
+                                   mtuSize - CA_BLE_HEADER_SIZE - CA_BLE_LENGTH_HEADER_SIZE,
+                                   dataHeader, lengthHeader);
+            legacyBytes += mtuSize;
+            CAGenerateHeader(dataHeader, CA_BLE_PACKET_NOT_START, 1, CA_BLE_PACKET_NON_SECURE, 2);
+            uint32_t index = 0;
+            for (; index < midPacketCount; index++)
+            {
+                CAMakeRemainDataSegment(dataSegment, mtuSize - CA_BLE_HEADER_SIZE, data.data(),
+                                        MESSAGE_LENGTH, index, dataHeader, mtuSize);
+                legacyBytes += mtuSize;
+            }
+            if (remainingLen)
+            {
+                CAMakeRemainDataSegment(dataSegment, remainingLen, data.data(),
+                                        MESSAGE_LENGTH, index, dataHeader, mtuSize);
+                legacyBytes += remainingLen + CA_BLE_HEADER_SIZE;
+            }
+        }
+        std::chrono::duration<double, std::nano> legacy = std::chrono::steady_clock::now() - start;
+
+        size_t segmenterBytes = 0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < FRAGMENT_ITERATIONS; i++)
+        {
+            CABLESegmenter_t segmenter;
+            CABLESegment_t segment;
+            CAInitBLESegmenter(&segmenter, data.data(), MESSAGE_LENGTH, mtuSize,
+                               1, CA_BLE_PACKET_NON_SECURE, 2);
+            while (CAGetNextBLESegment(&segmenter, &segment))
+            {
+                segmenterBytes += CACopyBLESegment(&segment, dataSegment, sizeof(dataSegment));
+            }
+        }
+        std::chrono::duration<double, std::nano> segmenter =
+            std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ(legacyBytes, segmenterBytes);
+        std::cout << "{\"benchmark\":\"FragmentLegacy\",\"mtu\":" << mtuSize
+                  << ",\"messageBytes\":" << MESSAGE_LENGTH
+                  << ",\"nsPerMessage\":" << (legacy.count() / FRAGMENT_ITERATIONS) << "}"
+                  << std::endl;
+        std::cout << "{\"benchmark\":\"FragmentSegmenter\",\"mtu\":" << mtuSize
+                  << ",\"messageBytes\":" << MESSAGE_LENGTH
+                  << ",\"nsPerMessage\":" << (segmenter.count() / FRAGMENT_ITERATIONS) << "}"
+                  << std::endl;
+    }
+}
@@ -0,0 +1,172 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+// Per packet routing table lookups of a gateway in a mesh of 500 gateways,
+// of which 50 are neighbours. Results are printed as one JSON object per benchmark.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+#include "routingtablemanager.h"
+
+namespace
+{
+    const uint32_t GATEWAY_COUNT = 500;
+    const uint32_t NEIGHBOUR_COUNT = 50;
+    const uint16_t ENDPOINT_COUNT = 500;
+    const int PACKET_COUNT = 100000;
+
+    RTMDestIntfInfo_t neighbourAddr(uint32_t gatewayId)
+    {
+        RTMDestIntfInfo_t dest = {};
+        dest.destIntfAddr.adapter = CA_ADAPTER_IP;
+        snprintf(dest.destIntfAddr.addr, sizeof(dest.destIntfAddr.addr), "10.0.%u.%u",
+                 100 + gatewayId / 100, 100 + gatewayId % 100);
+        dest.destIntfAddr.port = 5683;
+        dest.observerId = gatewayId;
+        return dest;
+    }
+
+    // Addresses have a fixed length as the table walk compares address prefixes.
+    CAEndpoint_t endpointAddr(uint16_t index)
+    {
+        CAEndpoint_t addr = {};
+        addr.adapter = CA_ADAPTER_IP;
+        snprintf(addr.addr, sizeof(addr.addr), "10.1.%u.%u", 100 + index / 100, 100 + index % 100);
+        addr.port = 5683;
+        return addr;
+    }
+}
+
+class RoutingTableBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp()
+    {
+        gatewayTable = NULL;
+        endpointTable = NULL;
+        ASSERT_EQ(OC_STACK_OK, RTMInitialize(&gatewayTable, &endpointTable));
+
+        for (uint32_t id = 1; id <= NEIGHBOUR_COUNT; id++)
+        {
+            RTMDestIntfInfo_t dest = neighbourAddr(id);
+            ASSERT_EQ(OC_STACK_OK, RTMAddGatewayEntry(id, 0, 1, &dest, &gatewayTable));
+        }
+
+        for (uint32_t id = NEIGHBOUR_COUNT + 1; id <= GATEWAY_COUNT; id++)
+        {
+            uint32_t nextHop = (id % NEIGHBOUR_COUNT) + 1;
+            ASSERT_EQ(OC_STACK_OK, RTMAddGatewayEntry(id, nextHop, 2 + id % 4, NULL,
+                                                      &gatewayTable));
+        }
+
+        for (uint16_t i = 0; i < ENDPOINT_COUNT; i++)
+        {
+            uint16_t endpointId = i + 1;
+            CAEndpoint_t addr = endpointAddr(i);
+            ASSERT_EQ(OC_STACK_OK, RTMAddEndpointEntry(&endpointId, &addr, &endpointTable));
+        }
+    }
+
+    void TearDown()
+    {
+        EXPECT_EQ(OC_STACK_OK, RTMTerminate(&gatewayTable, &endpointTable));
+    }
+
+    u_linklist_t *gatewayTable;
+    u_linklist_t *endpointTable;
+};
+
+TEST_F(RoutingTableBenchmark, ForwardPackets)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < PACKET_COUNT; i++)
+    {
+        uint32_t gatewayId = (i * 7919) % GATEWAY_COUNT + 1;
+        RTMGatewayId_t *nextHop = RTMGetNextHop(gatewayId, gatewayTable);
+        ASSERT_TRUE(NULL != nextHop);
+        ASSERT_EQ(((gatewayId <= NEIGHBOUR_COUNT) ? gatewayId :
+                  (gatewayId % NEIGHBOUR_COUNT) + 1), nextHop->gatewayId);
+
+        uint16_t endpointId = (i % ENDPOINT_COUNT) + 1;
+        ASSERT_TRUE(NULL != RTMGetEndpointEntry(endpointId, endpointTable));
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "{\"benchmark\":\"ForwardPackets\",\"gateways\":" << GATEWAY_COUNT
+              << ",\"packets\":" << PACKET_COUNT
+              << ",\"packetsPerSec\":" << (PACKET_COUNT / elapsed.count()) << "}" << std::endl;
+}
+
+TEST_F(RoutingTableBenchmark, MulticastSequenceNumbers)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < PACKET_COUNT; i++)
+    {
+        uint32_t gatewayId = (i % GATEWAY_COUNT) + 1;
+        uint16_t seqNum = (uint16_t)(i / GATEWAY_COUNT + 1);
+        ASSERT_EQ(OC_STACK_OK, RTMUpdateMcastSeqNumber(gatewayId, seqNum, &gatewayTable));
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "{\"benchmark\":\"MulticastSequenceNumbers\",\"gateways\":" << GATEWAY_COUNT
+              << ",\"packets\":" << PACKET_COUNT
+              << ",\"packetsPerSec\":" << (PACKET_COUNT / elapsed.count()) << "}" << std::endl;
+
+    EXPECT_EQ(OC_STACK_DUPLICATE_REQUEST,
+              RTMUpdateMcastSeqNumber(GATEWAY_COUNT, PACKET_COUNT / GATEWAY_COUNT,
+                                      &gatewayTable));
+}
+
+TEST_F(RoutingTableBenchmark, ObserverLookup)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < PACKET_COUNT; i++)
+    {
+        uint32_t gatewayId = (i % NEIGHBOUR_COUNT) + 1;
+        OCObservationId obsId = 0;
+        ASSERT_TRUE(RTMIsObserverPresent(neighbourAddr(gatewayId).destIntfAddr, &obsId,
+                                         gatewayTable));
+        ASSERT_EQ(gatewayId, (uint32_t)obsId);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "{\"benchmark\":\"ObserverLookup\",\"neighbours\":" << NEIGHBOUR_COUNT
+              << ",\"lookups\":" << PACKET_COUNT
+              << ",\"lookupsPerSec\":" << (PACKET_COUNT / elapsed.count()) << "}" << std::endl;
+}
+
+TEST_F(RoutingTableBenchmark, RouteUpdateInvalidatesLookup)
+{
+    ASSERT_TRUE(NULL != RTMGetNextHop(GATEWAY_COUNT, gatewayTable));
+
+    u_linklist_t *removed = NULL;
+    ASSERT_EQ(OC_STACK_OK, RTMRemoveGatewayEntry(GATEWAY_COUNT, &removed, &gatewayTable));
+    RTMFreeGatewayRouteTable(&removed);
+
+    EXPECT_TRUE(NULL == RTMGetNextHop(GATEWAY_COUNT, gatewayTable));
+    EXPECT_TRUE(NULL != RTMGetNextHop(GATEWAY_COUNT - 1, gatewayTable));
+}
@@ -3219,3 +3219,48 @@ TEST(TLSAdapter, TestCertsValid)
     EXPECT_EQ(0, ret) << "Failed to parse CA cert";
     mbedtls_x509_crt_free(&cert);
 }
+
+static int pkixInfoCallCount = 0;
+
+static void countingInfoCallback(PkiInfo_t * inf)
+{
+    pkixInfoCallCount++;
+    infoCallback_that_loads_x509(inf);
+
+    // InitPKIX frees the key it is handed.
+    inf->key.data = (uint8_t *)OICMalloc(sizeof(serverPrivateKey));
+    ASSERT_TRUE(inf->key.data != NULL);
+    memcpy(inf->key.data, serverPrivateKey, sizeof(serverPrivateKey));
+}
+
+TEST(TLSAdapter, PkixInfoIsParsedOnlyWhenChanged)
+{
+    ASSERT_EQ(CA_STATUS_OK, CAinitSslAdapter());
+    pkixInfoCallCount = 0;
+    CAsetPkixInfoCallback(countingInfoCallback);
+
+    oc_mutex_lock(g_sslContextMutex);
+    int ret = InitPKIX(CA_ADAPTER_TCP);
+    EXPECT_EQ(ret, InitPKIX(CA_ADAPTER_TCP));
+    EXPECT_EQ(ret, InitPKIX(CA_ADAPTER_IP));
+    oc_mutex_unlock(g_sslContextMutex);
+    EXPECT_EQ(1, pkixInfoCallCount);
+
+    CAresetPkixInfoCache();
+
+    oc_mutex_lock(g_sslContextMutex);
+    EXPECT_EQ(ret, InitPKIX(CA_ADAPTER_TCP));
+    EXPECT_EQ(ret, InitPKIX(CA_ADAPTER_IP));
+    oc_mutex_unlock(g_sslContextMutex);
+    EXPECT_EQ(2, pkixInfoCallCount);
+
+    CAsetPkixInfoCallback(infoCallback_that_loads_x509);
+    CAsetPkixInfoCallback(countingInfoCallback);
+
+    oc_mutex_lock(g_sslContextMutex);
+    EXPECT_EQ(ret, InitPKIX(CA_ADAPTER_TCP));
+    oc_mutex_unlock(g_sslContextMutex);
+    EXPECT_EQ(3, pkixInfoCallCount);
+
+    CAdeinitSslAdapter();
+}
@@ -0,0 +1,237 @@
+/* *****************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * *****************************************************************/
+
+// TLS record throughput of the SSL adapter with many peers, serviced by an
+// increasing number of threads. Client and server sessions live in the same
+// adapter and records are looped back in memory, so the numbers only cover
+// the adapter and mbedTLS. Results are printed as one JSON object per thread count.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Test function hooks, as in ssladapter_test.cpp
+#define CAcloseSslConnection CAcloseSslConnectionTest
+#define CAdecryptSsl CAdecryptSslTest
+#define CAdeinitSslAdapter CAdeinitSslAdapterTest
+#define CAencryptSsl CAencryptSslTest
+#define CAinitSslAdapter CAinitSslAdapterTest
+#define CAinitiateSslHandshake CAinitiateSslHandshakeTest
+#define CAsetCredentialTypesCallback CAsetCredentialTypesCallbackTest
+#define CAsetSslAdapterCallbacks CAsetSslAdapterCallbacksTest
+#define CAsetSslHandshakeCallback CAsetSslHandshakeCallbackTest
+#define CAsetTlsCipherSuite CAsetTlsCipherSuiteTest
+#define CAsslGenerateOwnerPsk CAsslGenerateOwnerPskTest
+#define CAcloseSslConnectionAll CAcloseSslConnectionAllTest
+#define GetCASecureEndpointData GetCASecureEndpointDataTest
+#define SetCASecureEndpointAttribute SetCASecureEndpointAttributeTest
+#define GetCASecureEndpointAttributes GetCASecureEndpointAttributesTest
+#define CAsetPeerCNVerifyCallback CAsetPeerCNVerifyCallbackTest
+#define CAsetCloseSslConnectionCallback CAsetCloseSslConnectionCallbackTest
+
+#include "../src/adapter_util/ca_adapter_net_ssl.c"
+
+namespace
+{
+    const uint16_t PAIR_COUNT = 16;
+    const uint16_t CLIENT_PORT = 20000;
+    const uint16_t SERVER_PORT = CLIENT_PORT + PAIR_COUNT;
+    const int RECORDS_PER_PAIR = 2000;
+    const size_t RECORD_SIZE = 1024;
+
+    const unsigned char PSK_IDENTITY[] = "ssladapterbench0";
+    const unsigned char PSK[] = "0123456789abcdef";
+
+    // Records on their way to the client (index 0) or server (index 1) of a pair.
+    struct Pair
+    {
+        std::mutex lock;
+        std::deque<std::vector<uint8_t>> records[2];
+    };
+
+    Pair g_pairs[PAIR_COUNT];
+    std::atomic<long> g_received(0);
+
+    CAEndpoint_t pairEndpoint(uint16_t port)
+    {
+        CAEndpoint_t endpoint = {};
+        endpoint.adapter = CA_ADAPTER_TCP;
+        endpoint.flags = CA_IPV4;
+        OICStrcpy(endpoint.addr, sizeof(endpoint.addr), "127.0.0.1");
+        endpoint.port = port;
+        return endpoint;
+    }
+
+    ssize_t loopbackSend(CAEndpoint_t *endpoint, const void *data, size_t dataLength)
+    {
+        bool toServer = (endpoint->port >= SERVER_PORT);
+        Pair &pair = g_pairs[endpoint->port - (toServer ? SERVER_PORT : CLIENT_PORT)];
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+        std::lock_guard<std::mutex> lock(pair.lock);
+        pair.records[toServer].emplace_back(bytes, bytes + dataLength);
+        return (ssize_t)dataLength;
+    }
+
+    void loopbackReceived(const CASecureEndpoint_t *, const void *, size_t)
+    {
+        g_received++;
+    }
+
+    void loopbackError(const CAEndpoint_t *, const void *, size_t, CAResult_t)
+    {
+    }
+
+    void pskOnly(bool *list, const char *)
+    {
+        list[0] = true;
+    }
+
+    int32_t pskCredentials(CADtlsPskCredType_t type, const unsigned char *, size_t,
+                           unsigned char *result, size_t resultLength)
+    {
+        const unsigned char *cred = (CA_DTLS_PSK_IDENTITY == type) ? PSK_IDENTITY : PSK;
+        if (NULL == result || resultLength < UUID_LENGTH)
+        {
+            return -1;
+        }
+        memcpy(result, cred, UUID_LENGTH);
+        return UUID_LENGTH;
+    }
+
+    // Delivers the records queued for both ends of a pair, returns false if there were none.
+    bool deliver(uint16_t index)
+    {
+        bool delivered = false;
+        for (int toServer = 0; toServer < 2; toServer++)
+        {
+            CASecureEndpoint_t sep = {};
+            sep.endpoint = pairEndpoint(toServer ? CLIENT_PORT + index : SERVER_PORT + index);
+
+            for (;;)
+            {
+                std::vector<uint8_t> record;
+                {
+                    std::lock_guard<std::mutex> lock(g_pairs[index].lock);
+                    if (g_pairs[index].records[toServer].empty())
+                    {
+                        break;
+                    }
+                    record.swap(g_pairs[index].records[toServer].front());
+                    g_pairs[index].records[toServer].pop_front();
+                }
+                CAdecryptSsl(&sep, record.data(), record.size());
+                delivered = true;
+            }
+        }
+        return delivered;
+    }
+}
+
+class SslAdapterBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp()
+    {
+        ASSERT_EQ(CA_STATUS_OK, CAinitSslAdapter());
+        CAsetSslAdapterCallbacks(loopbackReceived, loopbackSend, loopbackError, CA_ADAPTER_TCP);
+        CAsetCredentialTypesCallback(pskOnly);
+        CAsetPskCredentialsCallback(pskCredentials);
+        ASSERT_EQ(CA_STATUS_OK, CAsetTlsCipherSuite(MBEDTLS_TLS_ECDHE_PSK_WITH_AES_128_CBC_SHA256));
+
+        for (uint16_t i = 0; i < PAIR_COUNT; i++)
+        {
+            CAEndpoint_t server = pairEndpoint(SERVER_PORT + i);
+            ASSERT_EQ(CA_STATUS_OK, CAinitiateSslHandshake(&server));
+        }
+        for (bool delivered = true; delivered; )
+        {
+            delivered = false;
+            for (uint16_t i = 0; i < PAIR_COUNT; i++)
+            {
+                delivered |= deliver(i);
+            }
+        }
+    }
+
+    void TearDown()
+    {
+        CAdeinitSslAdapter();
+        for (uint16_t i = 0; i < PAIR_COUNT; i++)
+        {
+            g_pairs[i].records[0].clear();
+            g_pairs[i].records[1].clear();
+        }
+    }
+};
+
+TEST_F(SslAdapterBenchmark, RecordsPerSecond)
+{
+    const std::vector<uint8_t> payload(RECORD_SIZE, 0x5a);
+    unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned int threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+    {
+        g_received = 0;
+        std::atomic<int> failures(0);
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> threads;
+        for (unsigned int t = 0; t < threadCount; t++)
+        {
+            threads.emplace_back([&, t]
+            {
+                for (int n = 0; n < RECORDS_PER_PAIR; n++)
+                {
+                    for (uint16_t i = t; i < PAIR_COUNT; i += threadCount)
+                    {
+                        CAEndpoint_t server = pairEndpoint(SERVER_PORT + i);
+                        if (CA_STATUS_OK != CAencryptSsl(&server, payload.data(), payload.size()))
+                        {
+                            failures++;
+                        }
+                        deliver(i);
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        long records = (long)PAIR_COUNT * RECORDS_PER_PAIR;
+        std::cout << "{\"benchmark\":\"RecordsPerSecond\",\"threads\":" << threadCount
+                  << ",\"peers\":" << PAIR_COUNT
+                  << ",\"recordBytes\":" << RECORD_SIZE
+                  << ",\"recordsPerSec\":" << (records / elapsed.count()) << "}" << std::endl;
+
+        EXPECT_EQ(0, failures.load());
+        EXPECT_EQ(records, g_received.load());
+    }
+}
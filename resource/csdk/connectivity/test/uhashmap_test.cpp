@@ -0,0 +1,195 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+#include "uhashmap.h"
+
+namespace
+{
+    struct Item
+    {
+        int key;
+        int value;
+        u_hashmap_entry_t entry;
+    };
+
+    uint32_t hashKey(int key)
+    {
+        return u_hashmap_hash(U_HASHMAP_HASH_INIT, &key, sizeof(key));
+    }
+
+    bool matchKey(const u_hashmap_entry_t *entry, const void *key)
+    {
+        return U_HASHMAP_CONTAINER(entry, Item, entry)->key == *(const int *)key;
+    }
+
+    Item *find(u_hashmap_t *map, int key)
+    {
+        u_hashmap_entry_t *entry = u_hashmap_find(map, hashKey(key), &key, matchKey);
+        return entry ? U_HASHMAP_CONTAINER(entry, Item, entry) : NULL;
+    }
+}
+
+class UHashMapF : public testing::Test {
+public:
+  UHashMapF() :
+      testing::Test(),
+      map(NULL)
+  {
+  }
+
+protected:
+    virtual void SetUp()
+    {
+        map = u_hashmap_create();
+        ASSERT_TRUE(map != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        u_hashmap_free(&map);
+        ASSERT_EQ(NULL, map);
+    }
+
+    void addItems(std::vector<Item> &items)
+    {
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            items[i].key = (int)i;
+            items[i].value = (int)i * 2;
+            ASSERT_TRUE(u_hashmap_add(map, &items[i].entry, hashKey(items[i].key)));
+        }
+        ASSERT_EQ(items.size(), u_hashmap_length(map));
+    }
+
+    u_hashmap_t *map;
+};
+
+TEST(UHashMap, Base)
+{
+    u_hashmap_t *map = u_hashmap_create();
+    ASSERT_TRUE(map != NULL);
+
+    u_hashmap_free(&map);
+    ASSERT_EQ(NULL, map);
+}
+
+TEST(UHashMap, FreeNull)
+{
+    u_hashmap_free(NULL);
+}
+
+TEST(UHashMap, Hash)
+{
+    EXPECT_EQ(U_HASHMAP_HASH_INIT, u_hashmap_hash(U_HASHMAP_HASH_INIT, "", 0));
+    EXPECT_NE(u_hashmap_hash(U_HASHMAP_HASH_INIT, "a", 1),
+              u_hashmap_hash(U_HASHMAP_HASH_INIT, "b", 1));
+    EXPECT_EQ(u_hashmap_hash(U_HASHMAP_HASH_INIT, "ab", 2),
+              u_hashmap_hash(u_hashmap_hash(U_HASHMAP_HASH_INIT, "a", 1), "b", 1));
+    EXPECT_EQ(u_hashmap_hash(U_HASHMAP_HASH_INIT, "fe80::1", 7),
+              u_hashmap_hash_nocase(U_HASHMAP_HASH_INIT, "FE80::1"));
+}
+
+TEST_F(UHashMapF, Find)
+{
+    std::vector<Item> items(1000);
+    addItems(items);
+
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        Item *item = find(map, (int)i);
+        ASSERT_EQ(&items[i], item);
+        EXPECT_EQ((int)i * 2, item->value);
+    }
+    EXPECT_EQ(NULL, find(map, -1));
+    EXPECT_EQ(NULL, find(map, (int)items.size()));
+}
+
+TEST_F(UHashMapF, FindNext)
+{
+    std::vector<Item> items(3);
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        items[i].key = 7;
+        ASSERT_TRUE(u_hashmap_add(map, &items[i].entry, hashKey(7)));
+    }
+
+    int key = 7;
+    std::set<Item *> found;
+    for (u_hashmap_entry_t *entry = u_hashmap_find(map, hashKey(key), &key, matchKey);
+         entry; entry = u_hashmap_find_next(map, entry, &key, matchKey))
+    {
+        found.insert(U_HASHMAP_CONTAINER(entry, Item, entry));
+    }
+    EXPECT_EQ(items.size(), found.size());
+}
+
+TEST_F(UHashMapF, Remove)
+{
+    std::vector<Item> items(1000);
+    addItems(items);
+
+    for (size_t i = 0; i < items.size(); i += 2)
+    {
+        ASSERT_TRUE(u_hashmap_remove(map, &items[i].entry));
+    }
+    ASSERT_EQ(items.size() / 2, u_hashmap_length(map));
+    EXPECT_FALSE(u_hashmap_remove(map, &items[0].entry));
+
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        EXPECT_EQ((i % 2) ? &items[i] : NULL, find(map, (int)i));
+    }
+}
+
+TEST_F(UHashMapF, Iterate)
+{
+    std::vector<Item> items(100);
+    addItems(items);
+
+    std::set<Item *> found;
+    for (u_hashmap_entry_t *entry = u_hashmap_next(map, NULL); entry;
+         entry = u_hashmap_next(map, entry))
+    {
+        EXPECT_TRUE(found.insert(U_HASHMAP_CONTAINER(entry, Item, entry)).second);
+    }
+    EXPECT_EQ(items.size(), found.size());
+}
+
+TEST_F(UHashMapF, RemoveWhileIterating)
+{
+    std::vector<Item> items(100);
+    addItems(items);
+
+    size_t visited = 0;
+    for (u_hashmap_entry_t *entry = u_hashmap_next(map, NULL); entry;
+         entry = u_hashmap_next(map, entry))
+    {
+        ++visited;
+        ASSERT_TRUE(u_hashmap_remove(map, entry));
+    }
+    EXPECT_EQ(items.size(), visited);
+    EXPECT_EQ(static_cast<size_t>(0), u_hashmap_length(map));
+    EXPECT_EQ(NULL, u_hashmap_next(map, NULL));
+}
@@ -0,0 +1,171 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "uheap.h"
+
+namespace
+{
+    struct Timeout
+    {
+        uint64_t expiry;
+        u_heap_entry_t entry;
+    };
+
+    bool expiresFirst(const u_heap_entry_t *first, const u_heap_entry_t *second)
+    {
+        return U_HEAP_CONTAINER(first, Timeout, entry)->expiry
+            < U_HEAP_CONTAINER(second, Timeout, entry)->expiry;
+    }
+
+    uint64_t popExpiry(u_heap_t *heap)
+    {
+        u_heap_entry_t *entry = u_heap_pop(heap);
+        return entry ? U_HEAP_CONTAINER(entry, Timeout, entry)->expiry : UINT64_MAX;
+    }
+}
+
+class UHeapF : public testing::Test {
+public:
+  UHeapF() :
+      testing::Test(),
+      heap(NULL)
+  {
+  }
+
+protected:
+    virtual void SetUp()
+    {
+        heap = u_heap_create(expiresFirst);
+        ASSERT_TRUE(heap != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        u_heap_free(&heap);
+        ASSERT_EQ(NULL, heap);
+    }
+
+    // Expiries in a scrambled order, each of 0..size-1 once.
+    void pushTimeouts(std::vector<Timeout> &timeouts)
+    {
+        for (size_t i = 0; i < timeouts.size(); ++i)
+        {
+            timeouts[i].expiry = (i * 7919) % timeouts.size();
+            ASSERT_TRUE(u_heap_push(heap, &timeouts[i].entry));
+        }
+        ASSERT_EQ(timeouts.size(), u_heap_length(heap));
+    }
+
+    u_heap_t *heap;
+};
+
+TEST(UHeap, Base)
+{
+    EXPECT_EQ(NULL, u_heap_create(NULL));
+
+    u_heap_t *heap = u_heap_create(expiresFirst);
+    ASSERT_TRUE(heap != NULL);
+    EXPECT_EQ(NULL, u_heap_top(heap));
+    EXPECT_EQ(NULL, u_heap_pop(heap));
+
+    u_heap_free(&heap);
+    ASSERT_EQ(NULL, heap);
+}
+
+TEST(UHeap, FreeNull)
+{
+    u_heap_free(NULL);
+}
+
+TEST_F(UHeapF, PopInOrder)
+{
+    std::vector<Timeout> timeouts(1000);
+    pushTimeouts(timeouts);
+
+    for (uint64_t expiry = 0; expiry < timeouts.size(); ++expiry)
+    {
+        ASSERT_EQ(expiry, popExpiry(heap));
+    }
+    EXPECT_EQ(static_cast<size_t>(0), u_heap_length(heap));
+}
+
+TEST_F(UHeapF, Remove)
+{
+    std::vector<Timeout> timeouts(1000);
+    pushTimeouts(timeouts);
+
+    // Remove the odd expiries.
+    for (size_t i = 0; i < timeouts.size(); ++i)
+    {
+        if (timeouts[i].expiry % 2)
+        {
+            ASSERT_TRUE(u_heap_remove(heap, &timeouts[i].entry));
+            EXPECT_FALSE(u_heap_contains(heap, &timeouts[i].entry));
+        }
+    }
+    ASSERT_EQ(timeouts.size() / 2, u_heap_length(heap));
+
+    for (uint64_t expiry = 0; expiry < timeouts.size(); expiry += 2)
+    {
+        ASSERT_EQ(expiry, popExpiry(heap));
+    }
+}
+
+TEST_F(UHeapF, Update)
+{
+    std::vector<Timeout> timeouts(100);
+    pushTimeouts(timeouts);
+
+    // Postpone the first timeout and bring the last one forward.
+    Timeout *first = U_HEAP_CONTAINER(u_heap_top(heap), Timeout, entry);
+    first->expiry = 1000;
+    ASSERT_TRUE(u_heap_update(heap, &first->entry));
+    for (size_t i = 0; i < timeouts.size(); ++i)
+    {
+        if (timeouts[i].expiry == timeouts.size() - 1)
+        {
+            timeouts[i].expiry = 0;
+            ASSERT_TRUE(u_heap_update(heap, &timeouts[i].entry));
+        }
+    }
+
+    EXPECT_EQ(0u, popExpiry(heap));
+    for (uint64_t expiry = 1; expiry < timeouts.size() - 1; ++expiry)
+    {
+        ASSERT_EQ(expiry, popExpiry(heap));
+    }
+    EXPECT_EQ(1000u, popExpiry(heap));
+}
+
+TEST_F(UHeapF, Contains)
+{
+    Timeout timeout = Timeout();
+    EXPECT_FALSE(u_heap_contains(heap, &timeout.entry));
+    ASSERT_TRUE(u_heap_push(heap, &timeout.entry));
+    EXPECT_TRUE(u_heap_contains(heap, &timeout.entry));
+    EXPECT_FALSE(u_heap_update(NULL, &timeout.entry));
+    EXPECT_EQ(&timeout.entry, u_heap_pop(heap));
+    EXPECT_FALSE(u_heap_contains(heap, &timeout.entry));
+    EXPECT_FALSE(u_heap_remove(heap, &timeout.entry));
+}
@@ -1235,6 +1235,61 @@ typedef struct
     OCObservationId obsId;
 } OCObservationInfo;
 
+/**
+ * Policy limiting the notifications sent to each observer of a resource.
+ * A zeroed policy sends every notification when it is requested.
+ */
+typedef struct
+{
+    /** Minimum time between two notifications to an observer in milliseconds, 0 for none.*/
+    uint32_t minIntervalMs;
+
+    /** Maximum number of confirmable notifications to an observer waiting for an
+     * acknowledgement, 0 for no limit.*/
+    uint8_t maxPendingCon;
+
+    /** Keep the latest notification the policy does not allow yet and send it once allowed,
+     * replacing the one already kept as allowed by RFC 7641. Otherwise it is dropped.*/
+    bool coalesce;
+} OCObserveNotificationPolicy;
+
+/**
+ * Notification counters of a resource, for all its observers.
+ */
+typedef struct
+{
+    /** Number of notifications sent.*/
+    uint32_t sent;
+
+    /** Number of notifications replaced by a newer one before being sent.*/
+    uint32_t coalesced;
+
+    /** Number of notifications dropped, because the policy does not coalesce or the
+     * observer left before they could be sent.*/
+    uint32_t dropped;
+} OCObserveNotificationStats;
+
+/**
+ * Default leisure of RFC 7252 section 8.2 in milliseconds, for servers which do not estimate
+ * the size of the group answering a multicast request.
+ */
+#define OC_DEFAULT_MULTICAST_LEISURE_MS (5000)
+
+/**
+ * How a server answers multicast discovery requests, see ::OCSetMulticastDiscoveryPolicy.
+ * Only /oic/res responses encoded in CBOR are delayed or suppressed.
+ */
+typedef struct
+{
+    /** Leisure of RFC 7252 section 8.2 in milliseconds. Responses are sent after a random delay
+     * up to it, so that the responses of many servers do not collide. 0 responds at once.*/
+    uint32_t leisureMs;
+
+    /** Time in milliseconds during which a response is not sent again to a client it was
+     * already sent to, unless it changed. 0 always responds.*/
+    uint32_t suppressionMs;
+} OCMulticastDiscoveryPolicy;
+
 /**
  * Possible returned values from entity handler.
  */
@@ -31,6 +31,7 @@
 #include "ulinklist.h"
 #include "uarraylist.h"
 #include "ocstackinternal.h"
+#include "caremotehandler.h"
 #include "experimental/logger.h"
 
 /**
@@ -1235,7 +1236,10 @@ rewriteandexit:
                     msg->info.type = CA_MSG_RESET;
                 }
                 msg->result = CA_EMPTY;
-                OICFree(msg->info.token);
+                if (!CAIsInInfoBuffer(&msg->info, msg->info.token))
+                {
+                    OICFree(msg->info.token);
+                }
                 msg->info.token = NULL;
                 msg->info.tokenLength = 0;
             }
@@ -36,6 +36,315 @@
  */
 #define RM_TAG "OIC_RM_RAP"
 
+/**
+ * Minimum number of buckets of a routing table index.
+ */
+#define RTM_INDEX_MIN_BUCKETS 16
+
+/**
+ * Node of a routing table index chain.
+ */
+typedef struct RTMIndexNode
+{
+    uint32_t key;                           /**< Gateway/Endpoint Id or address hash. */
+    void *data;                             /**< Indexed table data. */
+    struct RTMIndexNode *next;              /**< Next node in the bucket. */
+} RTMIndexNode_t;
+
+/**
+ * Hash index over a routing table, rebuilt lazily after the table changes.
+ *
+ * Lookups on the per packet path (next hop, endpoint address, observer, sequence number
+ * updates) use the index instead of walking the table. Route updates are rare compared to
+ * forwarded packets, so every change to the table only marks the index invalid and the next
+ * lookup rebuilds it. For the gateway table the Id index maps a gateway to its entry, which
+ * caches the next hop for the lowest route cost, and the address index maps a neighbour
+ * interface address to its observed RTMDestIntfInfo_t. For the endpoint table they map to
+ * RTMEndpointEntry_t. The first match in table order wins, as with a table walk.
+ */
+typedef struct
+{
+    const u_linklist_t *table;              /**< Table the index is bound to, NULL if none. */
+    bool isGatewayTable;                    /**< Gateway or Endpoint Routing Table. */
+    bool isValid;                           /**< False when the table changed since the build. */
+    size_t bucketCount;                     /**< Number of buckets, power of 2. */
+    RTMIndexNode_t **idBuckets;             /**< Buckets keyed by Gateway/Endpoint Id. */
+    RTMIndexNode_t **addrBuckets;           /**< Buckets keyed by interface address. */
+    RTMIndexNode_t *nodes;                  /**< Storage of all nodes. */
+    size_t nodeCount;                       /**< Nodes in use. */
+    size_t nodeCapacity;                    /**< Nodes allocated. */
+} RTMTableIndex_t;
+
+/**
+ * Index of the gateway table passed to RTMInitialize().
+ */
+static RTMTableIndex_t g_gatewayIndex = { .isGatewayTable = true };
+
+/**
+ * Index of the endpoint table passed to RTMInitialize().
+ */
+static RTMTableIndex_t g_endpointIndex = { .isGatewayTable = false };
+
+static uint32_t RTMHashId(uint32_t id)
+{
+    // Multiplicative hashing spreads sequential Ids over the buckets.
+    return id * 2654435761u;
+}
+
+static uint32_t RTMHashAddr(const CAEndpoint_t *addr)
+{
+    // djb2 over the address string and the port.
+    uint32_t hash = 5381;
+    for (const char *c = addr->addr; *c; c++)
+    {
+        hash = ((hash << 5) + hash) + (unsigned char)*c;
+    }
+    return ((hash << 5) + hash) + addr->port;
+}
+
+static bool RTMIsSameAddr(const CAEndpoint_t *first, const CAEndpoint_t *second)
+{
+    return first->port == second->port && 0 == strcmp(first->addr, second->addr);
+}
+
+static void RTMFreeIndex(RTMTableIndex_t *index)
+{
+    OICFree(index->idBuckets);
+    OICFree(index->addrBuckets);
+    OICFree(index->nodes);
+    index->idBuckets = NULL;
+    index->addrBuckets = NULL;
+    index->nodes = NULL;
+    index->bucketCount = 0;
+    index->nodeCount = 0;
+    index->nodeCapacity = 0;
+    index->isValid = false;
+}
+
+static void RTMBindIndex(RTMTableIndex_t *index, const u_linklist_t *table)
+{
+    RTMFreeIndex(index);
+    index->table = table;
+}
+
+static void RTMUnbindIndex(RTMTableIndex_t *index, const u_linklist_t *table)
+{
+    if (NULL != table && index->table == table)
+    {
+        RTMFreeIndex(index);
+        index->table = NULL;
+    }
+}
+
+/*
+ * Called by every function that changes a table, including the parameters used as keys.
+ */
+static void RTMInvalidateIndex(RTMTableIndex_t *index, const u_linklist_t *table)
+{
+    if (NULL != table && index->table == table)
+    {
+        index->isValid = false;
+    }
+}
+
+static RTMIndexNode_t *RTMIndexFindId(const RTMTableIndex_t *index, uint32_t id)
+{
+    RTMIndexNode_t *node = index->idBuckets[RTMHashId(id) & (index->bucketCount - 1)];
+    while (NULL != node && node->key != id)
+    {
+        node = node->next;
+    }
+    return node;
+}
+
+static void *RTMIndexFindAddr(const RTMTableIndex_t *index, const CAEndpoint_t *addr)
+{
+    uint32_t hash = RTMHashAddr(addr);
+    RTMIndexNode_t *node = index->addrBuckets[hash & (index->bucketCount - 1)];
+    while (NULL != node)
+    {
+        const CAEndpoint_t *nodeAddr = index->isGatewayTable ?
+            &((RTMDestIntfInfo_t *)node->data)->destIntfAddr :
+            &((RTMEndpointEntry_t *)node->data)->destIntfAddr;
+        if (node->key == hash && RTMIsSameAddr(nodeAddr, addr))
+        {
+            return node->data;
+        }
+        node = node->next;
+    }
+    return NULL;
+}
+
+static void RTMIndexAddId(RTMTableIndex_t *index, uint32_t id, void *data)
+{
+    if (NULL != RTMIndexFindId(index, id) || index->nodeCount == index->nodeCapacity)
+    {
+        return;
+    }
+
+    RTMIndexNode_t *node = &index->nodes[index->nodeCount++];
+    RTMIndexNode_t **bucket = &index->idBuckets[RTMHashId(id) & (index->bucketCount - 1)];
+    node->key = id;
+    node->data = data;
+    node->next = *bucket;
+    *bucket = node;
+}
+
+static void RTMIndexAddAddr(RTMTableIndex_t *index, const CAEndpoint_t *addr, void *data)
+{
+    if (NULL != RTMIndexFindAddr(index, addr) || index->nodeCount == index->nodeCapacity)
+    {
+        return;
+    }
+
+    uint32_t hash = RTMHashAddr(addr);
+    RTMIndexNode_t *node = &index->nodes[index->nodeCount++];
+    RTMIndexNode_t **bucket = &index->addrBuckets[hash & (index->bucketCount - 1)];
+    node->key = hash;
+    node->data = data;
+    node->next = *bucket;
+    *bucket = node;
+}
+
+static bool RTMBuildIndex(RTMTableIndex_t *index)
+{
+    // Count the nodes needed: one per entry and one per interface address.
+    size_t nodeCount = 0;
+    u_linklist_iterator_t *iterTable = NULL;
+    u_linklist_init_iterator(index->table, &iterTable);
+    while (NULL != iterTable)
+    {
+        if (index->isGatewayTable)
+        {
+            RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
+            if (NULL != entry && NULL != entry->destination)
+            {
+                nodeCount += 1 + u_arraylist_length(entry->destination->destIntfAddr);
+            }
+        }
+        else
+        {
+            nodeCount += 2;
+        }
+        u_linklist_get_next(&iterTable);
+    }
+
+    size_t bucketCount = RTM_INDEX_MIN_BUCKETS;
+    while (bucketCount < nodeCount)
+    {
+        bucketCount <<= 1;
+    }
+
+    if (bucketCount != index->bucketCount)
+    {
+        OICFree(index->idBuckets);
+        OICFree(index->addrBuckets);
+        index->idBuckets = (RTMIndexNode_t **)OICCalloc(bucketCount, sizeof(RTMIndexNode_t *));
+        index->addrBuckets = (RTMIndexNode_t **)OICCalloc(bucketCount, sizeof(RTMIndexNode_t *));
+        index->bucketCount = bucketCount;
+    }
+    else
+    {
+        memset(index->idBuckets, 0, bucketCount * sizeof(RTMIndexNode_t *));
+        memset(index->addrBuckets, 0, bucketCount * sizeof(RTMIndexNode_t *));
+    }
+
+    if (nodeCount > index->nodeCapacity)
+    {
+        OICFree(index->nodes);
+        index->nodes = (RTMIndexNode_t *)OICMalloc(nodeCount * sizeof(RTMIndexNode_t));
+        index->nodeCapacity = index->nodes ? nodeCount : 0;
+    }
+
+    if (NULL == index->idBuckets || NULL == index->addrBuckets ||
+        (0 < nodeCount && NULL == index->nodes))
+    {
+        OIC_LOG(ERROR, TAG, "Building routing table index failed");
+        RTMFreeIndex(index);
+        return false;
+    }
+
+    index->nodeCount = 0;
+    u_linklist_init_iterator(index->table, &iterTable);
+    while (NULL != iterTable)
+    {
+        if (index->isGatewayTable)
+        {
+            RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
+            if (NULL != entry && NULL != entry->destination)
+            {
+                RTMIndexAddId(index, entry->destination->gatewayId, entry);
+                for (size_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
+                {
+                    RTMDestIntfInfo_t *dest = u_arraylist_get(entry->destination->destIntfAddr, i);
+                    if (NULL != dest && 0 != dest->observerId)
+                    {
+                        RTMIndexAddAddr(index, &dest->destIntfAddr, dest);
+                    }
+                }
+            }
+        }
+        else
+        {
+            RTMEndpointEntry_t *entry = u_linklist_get_data(iterTable);
+            if (NULL != entry)
+            {
+                RTMIndexAddId(index, entry->endpointId, entry);
+                RTMIndexAddAddr(index, &entry->destIntfAddr, entry);
+            }
+        }
+        u_linklist_get_next(&iterTable);
+    }
+
+    index->isValid = true;
+    return true;
+}
+
+/*
+ * Returns the index for the table, rebuilding it if needed, or NULL if the table is not
+ * indexed in which case callers walk the table.
+ */
+static RTMTableIndex_t *RTMGetIndex(RTMTableIndex_t *index, const u_linklist_t *table)
+{
+    if (NULL == table || index->table != table)
+    {
+        return NULL;
+    }
+
+    if (!index->isValid && !RTMBuildIndex(index))
+    {
+        return NULL;
+    }
+    return index;
+}
+
+/*
+ * Returns the first gateway entry with the gatewayId and a destination.
+ */
+static RTMGatewayEntry_t *RTMFindGatewayEntry(uint32_t gatewayId, const u_linklist_t *gatewayTable)
+{
+    RTMTableIndex_t *index = RTMGetIndex(&g_gatewayIndex, gatewayTable);
+    if (NULL != index)
+    {
+        RTMIndexNode_t *node = RTMIndexFindId(index, gatewayId);
+        return node ? (RTMGatewayEntry_t *)node->data : NULL;
+    }
+
+    u_linklist_iterator_t *iterTable = NULL;
+    u_linklist_init_iterator(gatewayTable, &iterTable);
+    while (NULL != iterTable)
+    {
+        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
+        if (NULL != entry && NULL != entry->destination &&
+            gatewayId == entry->destination->gatewayId)
+        {
+            return entry;
+        }
+        u_linklist_get_next(&iterTable);
+    }
+    return NULL;
+}
+
 OCStackResult RTMInitialize(u_linklist_t **gatewayTable, u_linklist_t **endpointTable)
 {
     OIC_LOG(DEBUG, TAG, "RTMInitialize IN");
@@ -62,6 +371,9 @@ OCStackResult RTMInitialize(u_linklist_t **gatewayTable, u_linklist_t **endpoint
            return OC_STACK_ERROR;
         }
     }
+
+    RTMBindIndex(&g_gatewayIndex, *gatewayTable);
+    RTMBindIndex(&g_endpointIndex, *endpointTable);
     OIC_LOG(DEBUG, TAG, "RTMInitialize OUT");
     return OC_STACK_OK;
 }
@@ -77,6 +389,8 @@ OCStackResult RTMFreeGatewayRouteTable(u_linklist_t **gatewayTable)
         return OC_STACK_OK;
     }
 
+    RTMUnbindIndex(&g_gatewayIndex, *gatewayTable);
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(*gatewayTable, &iterTable);
     while (NULL != iterTable)
@@ -121,6 +435,8 @@ OCStackResult RTMFreeEndpointRouteTable(u_linklist_t **endpointTable)
         return OC_STACK_OK;
     }
 
+    RTMUnbindIndex(&g_endpointIndex, *endpointTable);
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(*endpointTable, &iterTable);
     while (NULL != iterTable)
@@ -251,6 +567,8 @@ OCStackResult RTMAddGatewayEntry(uint32_t gatewayId, uint32_t nextHop, uint32_t
         return OC_STACK_ERROR;
     }
 
+    RTMInvalidateIndex(&g_gatewayIndex, *gatewayTable);
+
     u_linklist_iterator_t *destNode = NULL;
     RTMGatewayId_t *gatewayNodeMap = NULL;   // Gateway id ponter can be mapped to NextHop of entry.
 
@@ -508,23 +826,37 @@ OCStackResult RTMAddEndpointEntry(uint16_t *endpointId, const CAEndpoint_t *dest
         }
     }
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(*endpointTable, &iterTable);
-    // Iterate over gateway list to find if already entry with this gatewayid is present.
-    while (NULL != iterTable)
+    RTMTableIndex_t *index = RTMGetIndex(&g_endpointIndex, *endpointTable);
+    if (NULL != index)
     {
-        RTMEndpointEntry_t *entry =
-            (RTMEndpointEntry_t *) u_linklist_get_data(iterTable);
-
-        if (NULL != entry && (0 == memcmp(destAddr->addr, entry->destIntfAddr.addr,
-                              strlen(entry->destIntfAddr.addr)))
-            && destAddr->port == entry->destIntfAddr.port)
+        RTMEndpointEntry_t *entry = RTMIndexFindAddr(index, destAddr);
+        if (NULL != entry)
         {
             *endpointId = entry->endpointId;
             OIC_LOG(ERROR, TAG, "Adding failed as Enpoint Entry Already present in Table");
             return OC_STACK_DUPLICATE_REQUEST;
         }
-        u_linklist_get_next(&iterTable);
+    }
+    else
+    {
+        u_linklist_iterator_t *iterTable = NULL;
+        u_linklist_init_iterator(*endpointTable, &iterTable);
+        // Iterate over gateway list to find if already entry with this gatewayid is present.
+        while (NULL != iterTable)
+        {
+            RTMEndpointEntry_t *entry =
+                (RTMEndpointEntry_t *) u_linklist_get_data(iterTable);
+
+            if (NULL != entry && (0 == memcmp(destAddr->addr, entry->destIntfAddr.addr,
+                                  strlen(entry->destIntfAddr.addr)))
+                && destAddr->port == entry->destIntfAddr.port)
+            {
+                *endpointId = entry->endpointId;
+                OIC_LOG(ERROR, TAG, "Adding failed as Enpoint Entry Already present in Table");
+                return OC_STACK_DUPLICATE_REQUEST;
+            }
+            u_linklist_get_next(&iterTable);
+        }
     }
 
     // Filling Entry.
@@ -546,6 +878,7 @@ OCStackResult RTMAddEndpointEntry(uint16_t *endpointId, const CAEndpoint_t *dest
        OICFree(hopEntry);
        return OC_STACK_ERROR;
     }
+    RTMInvalidateIndex(&g_endpointIndex, *endpointTable);
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
 }
@@ -556,6 +889,8 @@ OCStackResult RTMAddObserver(uint32_t obsID, CAEndpoint_t devAddr, u_linklist_t
     RM_NULL_CHECK_WITH_RET(gatewayTable, TAG, "gatewayTable");
     RM_NULL_CHECK_WITH_RET(*gatewayTable, TAG, "*gatewayTable");
 
+    RTMInvalidateIndex(&g_gatewayIndex, *gatewayTable);
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(*gatewayTable, &iterTable);
     while (NULL != iterTable)
@@ -596,6 +931,18 @@ bool RTMIsObserverPresent(CAEndpoint_t devAddr, OCObservationId *obsID,
         return false;
     }
 
+    RTMTableIndex_t *index = RTMGetIndex(&g_gatewayIndex, gatewayTable);
+    if (NULL != index)
+    {
+        RTMDestIntfInfo_t *destCheck = RTMIndexFindAddr(index, &devAddr);
+        if (NULL != destCheck)
+        {
+            *obsID = destCheck->observerId;
+        }
+        OIC_LOG(DEBUG, TAG, "OUT");
+        return NULL != destCheck;
+    }
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(gatewayTable, &iterTable);
     while (NULL != iterTable)
@@ -644,6 +991,8 @@ OCStackResult RTMRemoveGatewayEntry(uint32_t gatewayId, u_linklist_t **removedGa
             return OC_STACK_NO_MEMORY;
         }
     }
+    RTMInvalidateIndex(&g_gatewayIndex, *gatewayTable);
+
     OCStackResult ret = OC_STACK_OK;
     u_linklist_init_iterator(*gatewayTable, &iterTable);
     while (NULL != iterTable)
@@ -688,6 +1037,8 @@ OCStackResult RTMRemoveGatewayDestEntry(uint32_t gatewayId, uint32_t nextHop,
     RM_NULL_CHECK_WITH_RET(*gatewayTable, TAG, "*gatewayTable");
     RM_NULL_CHECK_WITH_RET(destInfAdr, TAG, "destInfAdr");
 
+    RTMInvalidateIndex(&g_gatewayIndex, *gatewayTable);
+
     u_linklist_iterator_t *iterTable = NULL;
 
     OCStackResult ret = -1;
@@ -754,6 +1105,8 @@ OCStackResult RTMRemoveEndpointEntry(uint16_t endpointId, u_linklist_t **endpoin
     RM_NULL_CHECK_WITH_RET(endpointTable, TAG, "endpointTable");
     RM_NULL_CHECK_WITH_RET(*endpointTable, TAG, "*endpointTable");
 
+    RTMInvalidateIndex(&g_endpointIndex, *endpointTable);
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(*endpointTable, &iterTable);
     while (NULL != iterTable)
@@ -880,6 +1233,19 @@ RTMGatewayId_t *RTMGetNextHop(uint32_t gatewayId, const u_linklist_t *gatewayTab
         return NULL;
     }
 
+    RTMTableIndex_t *index = RTMGetIndex(&g_gatewayIndex, gatewayTable);
+    if (NULL != index)
+    {
+        RTMIndexNode_t *node = RTMIndexFindId(index, gatewayId);
+        RTMGatewayEntry_t *entry = node ? (RTMGatewayEntry_t *)node->data : NULL;
+        OIC_LOG(DEBUG, TAG, "OUT");
+        if (NULL == entry)
+        {
+            return NULL;
+        }
+        return (1 == entry->routeCost) ? entry->destination : entry->nextHop;
+    }
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(gatewayTable, &iterTable);
     while (NULL != iterTable)
@@ -910,6 +1276,14 @@ CAEndpoint_t *RTMGetEndpointEntry(uint16_t endpointId, const u_linklist_t *endpo
         return NULL;
     }
 
+    RTMTableIndex_t *index = RTMGetIndex(&g_endpointIndex, endpointTable);
+    if (NULL != index)
+    {
+        RTMIndexNode_t *node = RTMIndexFindId(index, endpointId);
+        OIC_LOG(DEBUG, TAG, "OUT");
+        return node ? &(((RTMEndpointEntry_t *)node->data)->destIntfAddr) : NULL;
+    }
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(endpointTable, &iterTable);
 
@@ -978,6 +1352,8 @@ OCStackResult RTMUpdateDestinationIntfAdr(uint32_t gatewayId, RTMDestIntfInfo_t
     RM_NULL_CHECK_WITH_RET(gatewayTable, TAG, "gatewayTable");
     RM_NULL_CHECK_WITH_RET(*gatewayTable, TAG, "*gatewayTable");
 
+    RTMInvalidateIndex(&g_gatewayIndex, *gatewayTable);
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(*gatewayTable, &iterTable);
     while (NULL != iterTable)
@@ -1063,29 +1439,22 @@ OCStackResult RTMUpdateMcastSeqNumber(uint32_t gatewayId, uint16_t seqNum,
     RM_NULL_CHECK_WITH_RET(gatewayTable, TAG, "gatewayTable");
     RM_NULL_CHECK_WITH_RET(*gatewayTable, TAG, "*gatewayTable");
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(*gatewayTable, &iterTable);
-    while (NULL != iterTable)
+    RTMGatewayEntry_t *entry = RTMFindGatewayEntry(gatewayId, *gatewayTable);
+    if (NULL != entry)
     {
-        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
-        if (NULL != entry && NULL != entry->destination &&
-            gatewayId == entry->destination->gatewayId)
+        if (0 == entry->mcastMessageSeqNum || entry->mcastMessageSeqNum < seqNum)
         {
-            if (0 == entry->mcastMessageSeqNum || entry->mcastMessageSeqNum < seqNum)
-            {
-                entry->mcastMessageSeqNum = seqNum;
-                return OC_STACK_OK;
-            }
-            else if (entry->mcastMessageSeqNum == seqNum)
-            {
-                return OC_STACK_DUPLICATE_REQUEST;
-            }
-            else
-            {
-                return OC_STACK_COMM_ERROR;
-            }
+            entry->mcastMessageSeqNum = seqNum;
+            return OC_STACK_OK;
+        }
+        else if (entry->mcastMessageSeqNum == seqNum)
+        {
+            return OC_STACK_DUPLICATE_REQUEST;
+        }
+        else
+        {
+            return OC_STACK_COMM_ERROR;
         }
-        u_linklist_get_next(&iterTable);
     }
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
@@ -1181,6 +1550,8 @@ OCStackResult RTMRemoveInvalidGateways(u_linklist_t **invalidTable, u_linklist_t
         return OC_STACK_NO_MEMORY;
     }
 
+    RTMInvalidateIndex(&g_gatewayIndex, *gatewayTable);
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(*gatewayTable, &iterTable);
     while (iterTable != NULL)
@@ -1244,49 +1615,37 @@ OCStackResult RTMUpdateEntryParameters(uint32_t gatewayId, uint32_t seqNum,
     RM_NULL_CHECK_WITH_RET(*gatewayTable, TAG, "*gatewayTable");
     RM_NULL_CHECK_WITH_RET(destAdr, TAG, "destAdr");
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(*gatewayTable, &iterTable);
-    while (NULL != iterTable)
+    RTMGatewayEntry_t *entry = RTMFindGatewayEntry(gatewayId, *gatewayTable);
+    if (NULL != entry)
     {
-        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
-
-        if (NULL == entry)
-        {
-            u_linklist_get_next(&iterTable);
-            continue;
-        }
-        if (NULL != entry->destination && gatewayId == entry->destination->gatewayId)
+        for (size_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
         {
-            for (size_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
+            RTMDestIntfInfo_t *destCheck =
+                u_arraylist_get(entry->destination->destIntfAddr, i);
+            if (NULL != destCheck &&
+                (0 == memcmp(destCheck->destIntfAddr.addr, destAdr->destIntfAddr.addr,
+                 strlen(destAdr->destIntfAddr.addr)))
+                 && destAdr->destIntfAddr.port == destCheck->destIntfAddr.port)
             {
-                RTMDestIntfInfo_t *destCheck =
-                    u_arraylist_get(entry->destination->destIntfAddr, i);
-                if (NULL != destCheck &&
-                    (0 == memcmp(destCheck->destIntfAddr.addr, destAdr->destIntfAddr.addr,
-                     strlen(destAdr->destIntfAddr.addr)))
-                     && destAdr->destIntfAddr.port == destCheck->destIntfAddr.port)
-                {
-                    destCheck->timeElapsed = RTMGetCurrentTime();
-                    destCheck->isValid = true;
-                }
+                destCheck->timeElapsed = RTMGetCurrentTime();
+                destCheck->isValid = true;
             }
+        }
 
-            if (0 != entry->seqNum && seqNum == entry->seqNum)
-            {
-                return OC_STACK_DUPLICATE_REQUEST;
-            }
-            else if (0 != entry->seqNum && seqNum != ((entry->seqNum) + 1) && !forceUpdate)
-            {
-                return OC_STACK_COMM_ERROR;
-            }
-            else
-            {
-                entry->seqNum = seqNum;
-                OIC_LOG(DEBUG, TAG, "OUT");
-                return OC_STACK_OK;
-            }
+        if (0 != entry->seqNum && seqNum == entry->seqNum)
+        {
+            return OC_STACK_DUPLICATE_REQUEST;
+        }
+        else if (0 != entry->seqNum && seqNum != ((entry->seqNum) + 1) && !forceUpdate)
+        {
+            return OC_STACK_COMM_ERROR;
+        }
+        else
+        {
+            entry->seqNum = seqNum;
+            OIC_LOG(DEBUG, TAG, "OUT");
+            return OC_STACK_OK;
         }
-        u_linklist_get_next(&iterTable);
     }
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
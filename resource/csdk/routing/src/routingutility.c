@@ -279,12 +279,7 @@ OCStackResult RMUpdateInfo(CAHeaderOption_t **options, uint8_t *numOptions,
     }
     *numOptions = (*numOptions) - 1;
 
-    if (0 == *numOptions)
-    {
-        // Remove route option.
-        OICFree(*options);
-        *options = NULL;
-    }
+    // The options are left to the info holding them, which may not have allocated them.
     return OC_STACK_OK;
 }
 
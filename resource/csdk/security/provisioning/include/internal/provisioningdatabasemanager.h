@@ -86,6 +86,17 @@ OCStackResult PDMIsDuplicateDevice(const OicUuid_t* uuidOfDevice, bool* result);
  */
 OCStackResult PDMAddDevice(const OicUuid_t* uuidOfDevice);
 
+/**
+ * This method is used by provisioning manager to add many devices in one transaction.
+ * Either all devices are added or none of them.
+ *
+ * @param[in] uuidList list of the devices' uuids.
+ * @param[in] state state of the added devices. (ref. PdmDeviceState_t)
+ *
+ * @return OC_STACK_OK in case of success and other value otherwise.
+ */
+OCStackResult PDMAddDeviceList(const OCUuidList_t* uuidList, PdmDeviceState_t state);
+
 /**
  * This method is used by provisioning manager to update linked status of owned devices.
  *
@@ -96,6 +107,16 @@ OCStackResult PDMAddDevice(const OicUuid_t* uuidOfDevice);
  */
 OCStackResult PDMLinkDevices(const OicUuid_t *uuidOfDevice1, const OicUuid_t *uuidOfDevice2);
 
+/**
+ * This method is used by provisioning manager to link many pairs of owned devices in one
+ * transaction. Either all pairs are linked or none of them.
+ *
+ * @param[in] pairList list of the device pairs to be linked.
+ *
+ * @return OC_STACK_OK in case of success and other value otherwise.
+ */
+OCStackResult PDMLinkDeviceList(const OCPairList_t* pairList);
+
 /**
  * This method is used by provisioning manager to unlink pairwise devices.
  *
@@ -112,6 +112,8 @@ OCStackResult OC_CALL OCDiscoverUnownedDevices(unsigned short waittime, OCProvis
  * @param[in] ctx Application context would be returned in result callback
  * @param[in] targetDevices List of devices to perform ownership transfer.
  * @param[in] resultCallback Result callback function to be invoked when ownership transfer finished.
+ *                           It is not invoked if no device could be started, the error of
+ *                           the first device is returned instead.
  * @return OC_STACK_OK in case of success and other value otherwise.
  */
 OCStackResult OC_CALL OCDoOwnershipTransfer(void* ctx,
@@ -128,6 +130,17 @@ OCStackResult OC_CALL OCDoOwnershipTransfer(void* ctx,
  */
 OCStackResult OC_CALL OCSetOxmAllowStatus(const OicSecOxm_t oxm, const bool allowStatus);
 
+/**
+ * API to set the maximum number of devices OCDoOwnershipTransfer transfers at the same time.
+ * Just-Works devices are transferred concurrently up to this limit, devices using
+ * other OxMs are transferred on their own. Default is 1, one device after the other.
+ *
+ * @param[in] maxDevices maximum number of devices in progress, must not be 0
+ *
+ * @return OC_STACK_OK in case of success and other value otherwise.
+ */
+OCStackResult OC_CALL OCSetMaxConcurrentOwnershipTransfers(size_t maxDevices);
+
 #ifdef MULTIPLE_OWNER
 /**
  * API to perfrom multiple ownership transfer for MOT enabled device.
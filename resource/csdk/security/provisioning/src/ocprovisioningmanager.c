@@ -325,6 +325,11 @@ OCStackResult OC_CALL OCSetOxmAllowStatus(const OicSecOxm_t oxm, const bool allo
     return OTMSetOxmAllowStatus(oxm, allowStatus);
 }
 
+OCStackResult OC_CALL OCSetMaxConcurrentOwnershipTransfers(size_t maxDevices)
+{
+    return OTMSetMaxConcurrentTransfers(maxDevices);
+}
+
 OCStackResult OC_CALL OCDoOwnershipTransfer(void* ctx,
                                             OCProvisionDev_t *targetDevices,
                                             OCProvisionResultCB resultCallback)
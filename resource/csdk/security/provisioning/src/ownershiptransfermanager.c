@@ -97,6 +97,53 @@ static uint8_t g_OxmAllowStatus[OXM_IDX_COUNT] = {ALLOWED_OXM, ALLOWED_OXM, ALLO
                                                   ALLOWED_OXM, ALLOWED_OXM, NOT_ALLOWED_OXM};
 #endif
 
+/**
+ * Maximum number of devices transferred at the same time, see OTMSetMaxConcurrentTransfers.
+ */
+static size_t g_maxConcurrentTransfers = 1;
+
+/**
+ * Step of an ownership transfer which selects the cipher suite of a new secure session.
+ */
+typedef void (*OTMSessionStep)(OTMContext_t* otmCtx);
+
+typedef struct OTMSessionRequest OTMSessionRequest_t;
+
+/**
+ * Device waiting to set up its secure session.
+ */
+struct OTMSessionRequest
+{
+    OTMContext_t* otmCtx;
+    OTMSessionStep step;
+    OTMSessionRequest_t* next;
+};
+
+/**
+ * Ownership transfer of a device list.
+ *
+ * Each device in progress has its own OTMContext_t and goes through the response handlers
+ * on its own. The cipher suite offered in new (D)TLS sessions is process wide, so only one
+ * device at a time may be between selecting it and having its session established, the
+ * others wait in sessionRequests.
+ */
+struct OTMBatch
+{
+    void* userCtx;                            /**< Context for user. */
+    OCProvisionResultCB resultCallback;       /**< Invoked once every device is done. */
+    OCProvisionResult_t* resultArray;         /**< Result of each device. */
+    size_t resultArraySize;                   /**< No of elements in result array. */
+    bool hasError;                            /**< Did any device fail. */
+    OCProvisionDev_t* nextDevice;             /**< Next device to start, NULL once all started. */
+    size_t inProgress;                        /**< No of devices being transferred. */
+    bool exclusive;                           /**< The device in progress must be the only one. */
+    OTMContext_t* sessionOwner;               /**< Device setting up its secure session. */
+    OTMSessionRequest_t* sessionRequests;     /**< Devices waiting to set up their session. */
+    bool scheduling;                          /**< ScheduleTransfers is running. */
+    bool started;                             /**< A device got past StartOwnershipTransfer. */
+    bool holdFinish;                          /**< OTMDoOwnershipTransfer decides how to finish. */
+};
+
 
 OCStackResult OTMSetOTCallback(OicSecOxm_t oxm, OTMCallbackData_t* callbacks)
 {
@@ -360,12 +407,23 @@ static void SelectOperationMode(const OCProvisionDev_t *selectedDeviceInfo,
  * This function will send the first request for provisioning,
  * The next request message is sent from the response handler for this request.
  *
- * @param[in] ctx   context value passed to callback from calling function.
- * @param[in] selectedDevice   selected device information to performing provisioning.
+ * Every failure ends the device through SetResult, so the context must not be used
+ * once this function returned an error.
+ *
+ * @param[in] ctx   context value passed to callback from calling function, not NULL.
+ * @param[in] selectedDevice   selected device information to performing provisioning,
+ *                             with its doxm, not NULL.
  * @return  OC_STACK_OK on success
  */
 static OCStackResult StartOwnershipTransfer(void* ctx, OCProvisionDev_t* selectedDevice);
 
+/**
+ * Function to end the ownership transfer of a device and start the next devices.
+ *
+ * @param[in] otmCtx   Context of the device, freed by this function.
+ */
+static void EndDeviceTransfer(OTMContext_t* otmCtx);
+
 /*
  * Internal function to setup & cleanup PDM to performing provisioning.
  *
@@ -483,19 +541,6 @@ static OCStackResult PostRownerUuid(OTMContext_t* otmCtx);
  */
 static OCStackResult PostNormalOperationStatus(OTMContext_t* otmCtx);
 
-static bool IsComplete(OTMContext_t* otmCtx)
-{
-    for(size_t i = 0; i < otmCtx->ctxResultArraySize; i++)
-    {
-        if(OC_STACK_CONTINUE == otmCtx->ctxResultArray[i].res)
-        {
-            return false;
-        }
-    }
-
-    return true;
-}
-
 /**
  * Function to save the result of provisioning.
  *
@@ -554,7 +599,7 @@ static void SetResult(OTMContext_t* otmCtx, const OCStackResult res)
             otmCtx->ctxResultArray[i].res = res;
             if(OC_STACK_OK != res && OC_STACK_CONTINUE != res && OC_STACK_DUPLICATE_REQUEST != res)
             {
-                otmCtx->ctxHasError = true;
+                otmCtx->batch->hasError = true;
                 if (OC_STACK_OK != PDMDeleteDevice(&otmCtx->ctxResultArray[i].deviceId))
                 {
                     OIC_LOG(WARNING, TAG, "Internal error in PDMDeleteDevice");
@@ -588,36 +633,221 @@ static void SetResult(OTMContext_t* otmCtx, const OCStackResult res)
         }
     }
 
-    //If all OTM process is complete, invoke the user callback.
-    if(IsComplete(otmCtx))
+    else if(otmCtx == GetOTMContext(otmCtx->selectedDeviceInfo->endpoint.addr,
+                                    getSecurePort(otmCtx->selectedDeviceInfo)))
     {
-        switch (SetDosState(DOS_RFNOP))
+        //The context is freed below, only the one of the original OTM process may stay.
+        RemoveOTMContext(otmCtx->selectedDeviceInfo->endpoint.addr,
+                         getSecurePort(otmCtx->selectedDeviceInfo));
+    }
+
+    EndDeviceTransfer(otmCtx);
+exit:
+    OIC_LOG(DEBUG, TAG, "OUT SetResult");
+}
+
+/**
+ * Function to invoke the user callback once every device of the list is done.
+ *
+ * @param[in] batch   Ownership transfer of the device list, freed by this function.
+ */
+static void FinishTransfers(OTMBatch_t* batch)
+{
+    switch (SetDosState(DOS_RFNOP))
+    {
+    case OC_STACK_OK:
+        OIC_LOG(INFO, TAG, "DOS state SUCCESSFULLY changed to DOS_RFNOP.");
+        break;
+    case OC_STACK_FORBIDDEN_REQ:
+        OIC_LOG(WARNING, TAG, "DOS state change to DOS_RFNOP NOT ALLOWED.");
+        break;
+    default:
+        OIC_LOG(WARNING, TAG, "DOS state change to DOS_RFNOP FAILED.");
+        break;
+    }
+    batch->resultCallback(batch->userCtx, batch->resultArraySize,
+                          batch->resultArray, batch->hasError);
+    OICFree(batch->resultArray);
+    OICFree(batch);
+}
+
+/**
+ * Function to check if a device must be transferred on its own. PIN and certificate based
+ * OxMs replace the process wide credential handlers until the owner credential is in place,
+ * and all but Just-Works wait for user input.
+ *
+ * @param[in] selectedDevice   device to be transferred.
+ * @return true if no other device may be in progress at the same time.
+ */
+static bool IsExclusiveTransfer(const OCProvisionDev_t* selectedDevice)
+{
+    OicSecOxm_t oxm = OIC_OXM_COUNT;
+    if (OC_STACK_OK != OTMSelectOwnershipTransferMethod(selectedDevice->doxm->oxm,
+                                                        selectedDevice->doxm->oxmLen,
+                                                        &oxm, SUPER_OWNER))
+    {
+        //StartOwnershipTransfer ends this device right away.
+        return false;
+    }
+    return (OIC_JUST_WORKS != oxm);
+}
+
+/**
+ * Function to hand the secure session setup to the next waiting device and to start as
+ * many devices as allowed. Calls made while it runs, from the steps and handlers it
+ * invokes, are picked up by the running call.
+ *
+ * @param[in] batch   Ownership transfer of the device list, freed once every device is done.
+ */
+static void ScheduleTransfers(OTMBatch_t* batch)
+{
+    if (batch->scheduling)
+    {
+        return;
+    }
+    batch->scheduling = true;
+
+    for (;;)
+    {
+        if (NULL == batch->sessionOwner && NULL != batch->sessionRequests)
+        {
+            OTMSessionRequest_t* request = batch->sessionRequests;
+            OTMContext_t* otmCtx = request->otmCtx;
+            OTMSessionStep step = request->step;
+            LL_DELETE(batch->sessionRequests, request);
+            OICFree(request);
+
+            batch->sessionOwner = otmCtx;
+            step(otmCtx);
+            continue;
+        }
+
+        OCProvisionDev_t* selectedDevice = batch->nextDevice;
+        if (NULL == selectedDevice || batch->exclusive ||
+            g_maxConcurrentTransfers <= batch->inProgress)
         {
-        case OC_STACK_OK:
-            OIC_LOG(INFO, TAG, "DOS state SUCCESSFULLY changed to DOS_RFNOP.");
-            break;
-        case OC_STACK_FORBIDDEN_REQ:
-            OIC_LOG(WARNING, TAG, "DOS state change to DOS_RFNOP NOT ALLOWED.");
             break;
-        default:
-            OIC_LOG(WARNING, TAG, "DOS state change to DOS_RFNOP FAILED.");
+        }
+        bool exclusive = IsExclusiveTransfer(selectedDevice);
+        if (exclusive && 0 < batch->inProgress)
+        {
             break;
         }
-        otmCtx->ctxResultCallback(otmCtx->userCtx, otmCtx->ctxResultArraySize,
-                                   otmCtx->ctxResultArray, otmCtx->ctxHasError);
-        OICFree(otmCtx->ctxResultArray);
-        OICFree(otmCtx);
+        batch->nextDevice = selectedDevice->next;
+
+        OTMContext_t* otmCtx = (OTMContext_t*)OICCalloc(1, sizeof(OTMContext_t));
+        if (NULL == otmCtx)
+        {
+            OIC_LOG(ERROR, TAG, "Failed to create OTM Context");
+            for (size_t i = 0; i < batch->resultArraySize; i++)
+            {
+                if (0 == memcmp(selectedDevice->doxm->deviceID.id,
+                                batch->resultArray[i].deviceId.id, UUID_LENGTH))
+                {
+                    batch->resultArray[i].res = OC_STACK_NO_MEMORY;
+                }
+            }
+            batch->hasError = true;
+            continue;
+        }
+        otmCtx->userCtx = batch->userCtx;
+        otmCtx->ctxResultCallback = batch->resultCallback;
+        otmCtx->ctxResultArray = batch->resultArray;
+        otmCtx->ctxResultArraySize = batch->resultArraySize;
+        otmCtx->batch = batch;
+
+        batch->inProgress++;
+        batch->exclusive = exclusive;
+        //Failures end the device through SetResult.
+        if (OC_STACK_OK == StartOwnershipTransfer(otmCtx, selectedDevice))
+        {
+            batch->started = true;
+        }
     }
-    else
+
+    batch->scheduling = false;
+
+    if (0 == batch->inProgress && NULL == batch->nextDevice && !batch->holdFinish)
     {
-        if(OC_STACK_OK != StartOwnershipTransfer(otmCtx,
-                                                 otmCtx->selectedDeviceInfo->next))
+        FinishTransfers(batch);
+    }
+}
+
+static void EndDeviceTransfer(OTMContext_t* otmCtx)
+{
+    OTMBatch_t* batch = otmCtx->batch;
+    OTMSessionRequest_t* request = NULL;
+    OTMSessionRequest_t* tmp = NULL;
+
+    LL_FOREACH_SAFE(batch->sessionRequests, request, tmp)
+    {
+        if (request->otmCtx == otmCtx)
         {
-            OIC_LOG(ERROR, TAG, "Failed to StartOwnershipTransfer");
+            LL_DELETE(batch->sessionRequests, request);
+            OICFree(request);
         }
     }
-exit:
-    OIC_LOG(DEBUG, TAG, "OUT SetResult");
+    if (batch->sessionOwner == otmCtx)
+    {
+        batch->sessionOwner = NULL;
+    }
+    OICFree(otmCtx);
+
+    batch->inProgress--;
+    if (0 == batch->inProgress)
+    {
+        batch->exclusive = false;
+    }
+    ScheduleTransfers(batch);
+}
+
+/**
+ * Function to run a step selecting the cipher suite of a new secure session once no other
+ * device is setting up its session. The device holds the session setup until
+ * ReleaseSecureSession is called or its ownership transfer ends.
+ * otmCtx must not be used after this call, the step may have ended the device.
+ *
+ * @param[in] otmCtx   Context value of ownership transfer.
+ * @param[in] step   step to run.
+ */
+static void RequestSecureSession(OTMContext_t* otmCtx, OTMSessionStep step)
+{
+    OTMBatch_t* batch = otmCtx->batch;
+
+    if (batch->sessionOwner == otmCtx)
+    {
+        step(otmCtx);
+        return;
+    }
+
+    OTMSessionRequest_t* request = (OTMSessionRequest_t*)OICCalloc(1, sizeof(OTMSessionRequest_t));
+    if (NULL == request)
+    {
+        OIC_LOG(ERROR, TAG, "Failed to allocate memory for secure session request");
+        SetResult(otmCtx, OC_STACK_NO_MEMORY);
+        return;
+    }
+    request->otmCtx = otmCtx;
+    request->step = step;
+    LL_APPEND(batch->sessionRequests, request);
+    ScheduleTransfers(batch);
+}
+
+/**
+ * Function to let the next device set up its secure session, once the session of this
+ * device is established.
+ *
+ * @param[in] otmCtx   Context value of ownership transfer.
+ */
+static void ReleaseSecureSession(OTMContext_t* otmCtx)
+{
+    OTMBatch_t* batch = otmCtx->batch;
+
+    if (batch->sessionOwner == otmCtx)
+    {
+        batch->sessionOwner = NULL;
+        ScheduleTransfers(batch);
+    }
 }
 
 static CAResult_t OwnershipTransferSessionEstablished(const CAEndpoint_t *endpoint,
@@ -971,6 +1201,45 @@ exit:
  * @return  OC_STACK_DELETE_TRANSACTION to delete the transaction
  *          and  OC_STACK_KEEP_TRANSACTION to keep it.
  */
+static void StartSecureSession(OTMContext_t* otmCtx)
+{
+    OCStackResult res = OC_STACK_ERROR;
+
+    //Create DTLS secure session
+    if(otmCtx->otmCallback.loadSecretCB)
+    {
+        res = otmCtx->otmCallback.loadSecretCB(otmCtx);
+        if(OC_STACK_OK != res)
+        {
+            OIC_LOG(ERROR, TAG, "OwnerTransferModeHandler : Failed to load secret");
+            SetResult(otmCtx, res);
+            return;
+        }
+    }
+    if(otmCtx->otmCallback.createSecureSessionCB)
+    {
+        res = otmCtx->otmCallback.createSecureSessionCB(otmCtx);
+        if(OC_STACK_OK != res)
+        {
+            OIC_LOG(ERROR, TAG, "OwnerTransferModeHandler : Failed to create DTLS session");
+            SetResult(otmCtx, res);
+            return;
+        }
+
+        //This is a secure session.
+        otmCtx->selectedDeviceInfo->connType = (OCConnectivityType)(otmCtx->selectedDeviceInfo->connType | CT_FLAG_SECURE);
+
+        //Send request : GET /oic/sec/doxm. Then verify that the property values obtained this way
+        //are the same as those already-stored in the otmCtx.
+        res = GetAndVerifyDoxmResource(otmCtx);
+        if(OC_STACK_OK != res)
+        {
+            OIC_LOG(ERROR, TAG, "Failed to get doxm information after establishing secure connection");
+            SetResult(otmCtx, res);
+        }
+    }
+}
+
 static OCStackApplicationResult OwnerTransferModeHandler(void *ctx, OCDoHandle UNUSED,
                                                          OCClientResponse *clientResponse)
 {
@@ -997,39 +1266,8 @@ static OCStackApplicationResult OwnerTransferModeHandler(void *ctx, OCDoHandle U
             return OC_STACK_DELETE_TRANSACTION;
         }
 
-        //Create DTLS secure session
-        if(otmCtx->otmCallback.loadSecretCB)
-        {
-            res = otmCtx->otmCallback.loadSecretCB(otmCtx);
-            if(OC_STACK_OK != res)
-            {
-                OIC_LOG(ERROR, TAG, "OwnerTransferModeHandler : Failed to load secret");
-                SetResult(otmCtx, res);
-                return  OC_STACK_DELETE_TRANSACTION;
-            }
-        }
-        if(otmCtx->otmCallback.createSecureSessionCB)
-        {
-            res = otmCtx->otmCallback.createSecureSessionCB(otmCtx);
-            if(OC_STACK_OK != res)
-            {
-                OIC_LOG(ERROR, TAG, "OwnerTransferModeHandler : Failed to create DTLS session");
-                SetResult(otmCtx, res);
-                return OC_STACK_DELETE_TRANSACTION;
-            }
-
-            //This is a secure session.
-            otmCtx->selectedDeviceInfo->connType = (OCConnectivityType)(otmCtx->selectedDeviceInfo->connType | CT_FLAG_SECURE);
-
-            //Send request : GET /oic/sec/doxm. Then verify that the property values obtained this way
-            //are the same as those already-stored in the otmCtx.
-            res = GetAndVerifyDoxmResource(otmCtx);
-            if(OC_STACK_OK != res)
-            {
-                OIC_LOG(ERROR, TAG, "Failed to get doxm information after establishing secure connection");
-                SetResult(otmCtx, res);
-            }
-        }
+        //Released by GetAndVerifyDoxmHandler once the session is established.
+        RequestSecureSession(otmCtx, StartSecureSession);
     }
     else
     {
@@ -1150,6 +1388,7 @@ static OCStackApplicationResult DeviceUuidUpdateHandler(void *ctx, OCDoHandle ha
     {
         OIC_LOG_V(WARNING, TAG, "DeviceUuidUpdateHandler : Client response is incorrect : %d",
                 clientResponse->result);
+        SetResult(otmCtx, clientResponse->result);
         return OC_STACK_DELETE_TRANSACTION;
     }
 
@@ -1346,6 +1585,68 @@ static OCStackApplicationResult OperationModeUpdateHandler(void *ctx, OCDoHandle
  * @return  OC_STACK_DELETE_TRANSACTION to delete the transaction
  *          and  OC_STACK_KEEP_TRANSACTION to keep it.
  */
+static void SwitchToOwnerCredential(OTMContext_t* otmCtx)
+{
+    //For Servers based on OCF 1.0, PostOwnerAcl can be executed using
+    //the already-existing session. However, get ready here to use the
+    //Owner Credential for establishing future secure sessions.
+    //
+    //For Servers based on OIC 1.1, PostOwnerAcl might fail with status
+    //OC_STACK_UNAUTHORIZED_REQ. After such a failure, OwnerAclHandler
+    //will close the current session and re-establish a new session,
+    //using the Owner Credential.
+    CAEndpoint_t *endpoint = (CAEndpoint_t *)&otmCtx->selectedDeviceInfo->endpoint;
+
+    if (IS_OIC(otmCtx->selectedDeviceInfo->specVer))
+    {
+        endpoint->port = getSecurePort(otmCtx->selectedDeviceInfo);
+        if(CA_STATUS_OK != CAcloseSslConnection(endpoint))
+        {
+            OIC_LOG_V(WARNING, TAG, "%s: failed to close DTLS session", __func__);
+        }
+    }
+
+    /**
+      * If we select NULL cipher,
+      * client will select appropriate cipher suite according to server's cipher-suite list.
+      */
+    // TLS_ECDHE_PSK_WITH_AES_128_CBC_SHA_256 = 0xC037, /**< see RFC 5489 */
+    CAResult_t caResult = CASelectCipherSuite(0xC037, endpoint->adapter);
+    if(CA_STATUS_OK != caResult)
+    {
+        OIC_LOG(ERROR, TAG, "Failed to select TLS_NULL_WITH_NULL_NULL");
+        SetResult(otmCtx, CAResultToOCResult(caResult));
+        return;
+    }
+
+    /**
+      * in case of random PIN based OxM,
+      * revert get_psk_info callback of tinyDTLS to use owner credential.
+      */
+    if(OIC_RANDOM_DEVICE_PIN == otmCtx->selectedDeviceInfo->doxm->oxmSel)
+    {
+        OicUuid_t emptyUuid = OC_ZERO_UUID;
+        SetUuidForPinBasedOxm(&emptyUuid);
+
+        caResult = CAregisterPskCredentialsHandler(GetDtlsPskCredentials);
+        if(CA_STATUS_OK != caResult)
+        {
+            OIC_LOG(ERROR, TAG, "Failed to revert DTLS credential handler.");
+            SetResult(otmCtx, OC_STACK_INVALID_CALLBACK);
+            return;
+        }
+    }
+#ifdef __WITH_TLS__
+    otmCtx->selectedDeviceInfo->connType = (OCConnectivityType)(otmCtx->selectedDeviceInfo->connType | CT_FLAG_SECURE);
+#endif
+    OCStackResult res = PostOwnerAcl(otmCtx, GET_ACL_VER(otmCtx->selectedDeviceInfo->specVer));
+    if(OC_STACK_OK != res)
+    {
+        OIC_LOG(ERROR, TAG, "Failed to update owner ACL to new device");
+        SetResult(otmCtx, res);
+    }
+}
+
 static OCStackApplicationResult OwnerCredentialHandler(void *ctx, OCDoHandle UNUSED,
                                 OCClientResponse *clientResponse)
 {
@@ -1363,78 +1664,21 @@ static OCStackApplicationResult OwnerCredentialHandler(void *ctx, OCDoHandle UNU
     {
         if(otmCtx->selectedDeviceInfo)
         {
-            //For Servers based on OCF 1.0, PostOwnerAcl can be executed using
-            //the already-existing session. However, get ready here to use the
-            //Owner Credential for establishing future secure sessions.
-            //
-            //For Servers based on OIC 1.1, PostOwnerAcl might fail with status
-            //OC_STACK_UNAUTHORIZED_REQ. After such a failure, OwnerAclHandler
-            //will close the current session and re-establish a new session,
-            //using the Owner Credential.
-            CAEndpoint_t *endpoint = (CAEndpoint_t *)&otmCtx->selectedDeviceInfo->endpoint;
-
-            if (IS_OIC(otmCtx->selectedDeviceInfo->specVer))
-            {
-                endpoint->port = getSecurePort(otmCtx->selectedDeviceInfo);
-                if(CA_STATUS_OK != CAcloseSslConnection(endpoint))
-                {
-                    OIC_LOG_V(WARNING, TAG, "%s: failed to close DTLS session", __func__);
-                }
-            }
-
-            /**
-              * If we select NULL cipher,
-              * client will select appropriate cipher suite according to server's cipher-suite list.
-              */
-            // TLS_ECDHE_PSK_WITH_AES_128_CBC_SHA_256 = 0xC037, /**< see RFC 5489 */
-                CAResult_t caResult = CASelectCipherSuite(0xC037, endpoint->adapter);
-                if(CA_STATUS_OK != caResult)
-                {
-                    OIC_LOG(ERROR, TAG, "Failed to select TLS_NULL_WITH_NULL_NULL");
-                    SetResult(otmCtx, CAResultToOCResult(caResult));
-                    return OC_STACK_DELETE_TRANSACTION;
-                }
-
-                /**
-                  * in case of random PIN based OxM,
-                  * revert get_psk_info callback of tinyDTLS to use owner credential.
-                  */
-                if(OIC_RANDOM_DEVICE_PIN == otmCtx->selectedDeviceInfo->doxm->oxmSel)
-                {
-                    OicUuid_t emptyUuid = OC_ZERO_UUID;
-                    SetUuidForPinBasedOxm(&emptyUuid);
-
-                    caResult = CAregisterPskCredentialsHandler(GetDtlsPskCredentials);
-                    if(CA_STATUS_OK != caResult)
-                    {
-                        OIC_LOG(ERROR, TAG, "Failed to revert DTLS credential handler.");
-                        SetResult(otmCtx, OC_STACK_INVALID_CALLBACK);
-                        return OC_STACK_DELETE_TRANSACTION;
-                    }
-                }
-    #ifdef __WITH_TLS__
-                otmCtx->selectedDeviceInfo->connType = (OCConnectivityType)(otmCtx->selectedDeviceInfo->connType | CT_FLAG_SECURE);
-    #endif
-                res = PostOwnerAcl(otmCtx, GET_ACL_VER(otmCtx->selectedDeviceInfo->specVer));
-                if(OC_STACK_OK != res)
-                {
-                    OIC_LOG(ERROR, TAG, "Failed to update owner ACL to new device");
-                    SetResult(otmCtx, res);
-                    return OC_STACK_DELETE_TRANSACTION;
-                }
-            }
-        }
-        else
-        {
-            res = clientResponse->result;
-            OIC_LOG_V(ERROR, TAG, "OwnerCredentialHandler : Unexpected result %d", res);
-            SetResult(otmCtx, res);
+            //Released by OwnerAclHandler once the session using the Owner Credential is up.
+            RequestSecureSession(otmCtx, SwitchToOwnerCredential);
         }
+    }
+    else
+    {
+        res = clientResponse->result;
+        OIC_LOG_V(ERROR, TAG, "OwnerCredentialHandler : Unexpected result %d", res);
+        SetResult(otmCtx, res);
+    }
 
-        OIC_LOG(DEBUG, TAG, "OUT OwnerCredentialHandler");
+    OIC_LOG(DEBUG, TAG, "OUT OwnerCredentialHandler");
 
-        return  OC_STACK_DELETE_TRANSACTION;
-    }
+    return  OC_STACK_DELETE_TRANSACTION;
+}
 
     static void SetAclVer2(char specVer[]){specVer[0]='o'; specVer[1]='c'; specVer[2]='f';}
 
@@ -1468,6 +1712,9 @@ static OCStackApplicationResult OwnerCredentialHandler(void *ctx, OCDoHandle UNU
         {
             if(NULL != selectedDeviceInfo)
             {
+                //The session using the Owner Credential is up, let the next device set up its own.
+                ReleaseSecureSession(otmCtx);
+
                 //POST /oic/sec/doxm [{ ..., "owned":"TRUE" }]
                 OIC_LOG_V(DEBUG, TAG, "%s posting /doxm.owned = true.", __func__);
                 res = PostOwnershipInformation(otmCtx);
@@ -1723,6 +1970,9 @@ static OCStackApplicationResult OwnerCredentialHandler(void *ctx, OCDoHandle UNU
                 return OC_STACK_DELETE_TRANSACTION;
             }
 
+            //The secure session is established, let the next device set up its own.
+            ReleaseSecureSession(otmCtx);
+
             //Send request : GET /oic/sec/pstat
             res = GetProvisioningStatusResource(otmCtx);
             if(OC_STACK_OK != res)
@@ -2639,14 +2889,10 @@ static OCStackResult StartOwnershipTransfer(void* ctx, OCProvisionDev_t* selecte
     OIC_LOG(INFO, TAG, "IN StartOwnershipTransfer");
     OCStackResult res = OC_STACK_INVALID_PARAM;
 
-    VERIFY_NOT_NULL_RETURN(TAG, ctx, ERROR, OC_STACK_INVALID_PARAM);
-
+    //OTMDoOwnershipTransfer checked the device list, SetResult needs the device and its doxm.
     OTMContext_t* otmCtx = (OTMContext_t*)ctx;
     otmCtx->selectedDeviceInfo = selectedDevice;
 
-    VERIFY_NOT_NULL_RETURN(TAG, selectedDevice, ERROR, OC_STACK_INVALID_PARAM);
-    VERIFY_NOT_NULL_RETURN(TAG, selectedDevice->doxm, ERROR, OC_STACK_INVALID_PARAM);
-
     //Select the OxM to performing ownership transfer
     res = OTMSelectOwnershipTransferMethod(selectedDevice->doxm->oxm,
                                           selectedDevice->doxm->oxmLen,
@@ -2664,6 +2910,7 @@ static OCStackResult StartOwnershipTransfer(void* ctx, OCProvisionDev_t* selecte
     if(OC_STACK_OK != res)
     {
         OIC_LOG_V(ERROR, TAG, "Error in OTMSetOTCallback : %d", res);
+        SetResult(otmCtx, res);
         return res;
     }
 
@@ -2729,53 +2976,101 @@ OCStackResult OTMDoOwnershipTransfer(void* ctx,
         return OC_STACK_INVALID_CALLBACK;
     }
 
-    OTMContext_t* otmCtx = (OTMContext_t*)OICCalloc(1,sizeof(OTMContext_t));
-    if(!otmCtx)
+    OTMBatch_t* batch = (OTMBatch_t*)OICCalloc(1, sizeof(OTMBatch_t));
+    if(!batch)
     {
         OIC_LOG(ERROR, TAG, "Failed to create OTM Context");
         return OC_STACK_NO_MEMORY;
     }
 
-    otmCtx->ctxResultCallback = resultCallback;
-    otmCtx->ctxHasError = false;
-    otmCtx->userCtx = ctx;
+    batch->resultCallback = resultCallback;
+    batch->hasError = false;
+    batch->userCtx = ctx;
     OCProvisionDev_t* pCurDev = selectedDevicelist;
 
     //Counting number of selected devices.
-    otmCtx->ctxResultArraySize = 0;
+    batch->resultArraySize = 0;
     while(NULL != pCurDev)
     {
-        otmCtx->ctxResultArraySize++;
+        if (NULL == pCurDev->doxm)
+        {
+            OIC_LOG(ERROR, TAG, "OTMDoOwnershipTransfer : Device without doxm");
+            OICFree(batch);
+            return OC_STACK_INVALID_PARAM;
+        }
+        batch->resultArraySize++;
         pCurDev = pCurDev->next;
     }
 
-    otmCtx->ctxResultArray =
-        (OCProvisionResult_t*)OICCalloc(otmCtx->ctxResultArraySize, sizeof(OCProvisionResult_t));
-    if(NULL == otmCtx->ctxResultArray)
+    batch->resultArray =
+        (OCProvisionResult_t*)OICCalloc(batch->resultArraySize, sizeof(OCProvisionResult_t));
+    if(NULL == batch->resultArray)
     {
         OIC_LOG(ERROR, TAG, "OTMDoOwnershipTransfer : Failed to memory allocation");
-        OICFree(otmCtx);
+        OICFree(batch);
         return OC_STACK_NO_MEMORY;
     }
     pCurDev = selectedDevicelist;
 
     //Fill the device UUID for result array.
-    for(size_t devIdx = 0; devIdx < otmCtx->ctxResultArraySize; devIdx++)
+    for(size_t devIdx = 0; devIdx < batch->resultArraySize; devIdx++)
     {
-        memcpy(otmCtx->ctxResultArray[devIdx].deviceId.id,
+        memcpy(batch->resultArray[devIdx].deviceId.id,
                pCurDev->doxm->deviceID.id,
                UUID_LENGTH);
-        otmCtx->ctxResultArray[devIdx].res = OC_STACK_CONTINUE;
+        batch->resultArray[devIdx].res = OC_STACK_CONTINUE;
         pCurDev = pCurDev->next;
     }
 
-    OCStackResult res = StartOwnershipTransfer(otmCtx, selectedDevicelist);
+    //Failures of single devices are reported through resultCallback, unless none started.
+    batch->nextDevice = selectedDevicelist;
+    batch->holdFinish = true;
+    ScheduleTransfers(batch);
+    batch->holdFinish = false;
+
+    OCStackResult res = OC_STACK_OK;
+    if (0 == batch->inProgress && NULL == batch->nextDevice)
+    {
+        if (batch->started)
+        {
+            FinishTransfers(batch);
+        }
+        else
+        {
+            //Every device failed before sending a request, return the first error instead.
+            for (size_t devIdx = 0; devIdx < batch->resultArraySize; devIdx++)
+            {
+                if (OC_STACK_OK != batch->resultArray[devIdx].res)
+                {
+                    res = batch->resultArray[devIdx].res;
+                    break;
+                }
+            }
+            OICFree(batch->resultArray);
+            OICFree(batch);
+        }
+    }
 
     OIC_LOG(DEBUG, TAG, "OUT OTMDoOwnershipTransfer");
 
     return res;
 }
 
+OCStackResult OTMSetMaxConcurrentTransfers(size_t maxDevices)
+{
+    OIC_LOG_V(INFO, TAG, "IN %s : maxDevices=%" PRIuPTR, __func__, maxDevices);
+
+    if (0 == maxDevices)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+    g_maxConcurrentTransfers = maxDevices;
+
+    OIC_LOG_V(INFO, TAG, "OUT %s", __func__);
+
+    return OC_STACK_OK;
+}
+
 OCStackResult OTMSetOxmAllowStatus(const OicSecOxm_t oxm, const bool allowStatus)
 {
     OIC_LOG_V(INFO, TAG, "IN %s : oxm=%d, allow status=%s",
@@ -3124,25 +3419,8 @@ static OCStackApplicationResult RownerUuidHandler(void *ctx, OCDoHandle handle,
 
     if(OC_STACK_RESOURCE_CHANGED < clientResponse->result)
     {
-        //Remove the current OTM Context from OTM queue
-        RemoveOTMContext(otmCtx->selectedDeviceInfo->endpoint.addr,
-                         getSecurePort(otmCtx->selectedDeviceInfo));
-
-        //If there is a request being performed, cancel it to prevent retransmission.
-        if(otmCtx->ocDoHandle)
-        {
-            OIC_LOG_V(DEBUG, TAG, "OCCancel - %s : %d",
-                    otmCtx->selectedDeviceInfo->endpoint.addr,
-                    getSecurePort(otmCtx->selectedDeviceInfo));
-            if(OC_STACK_OK != OCCancel(otmCtx->ocDoHandle, OC_HIGH_QOS, NULL, 0))
-            {
-                OIC_LOG(WARNING, TAG, "Failed to remove registered callback");
-            }
-            else
-            {
-                otmCtx->ocDoHandle = NULL;
-            }
-        }
+        OIC_LOG(ERROR, TAG, "Failed to update rowneruuid");
+        SetResult(otmCtx, clientResponse->result);
     }
     else
     {
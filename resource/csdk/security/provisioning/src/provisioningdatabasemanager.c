@@ -47,7 +47,16 @@
 #define PDM_CREATE_DB "CREATE TABLE IF NOT EXISTS T_DEVICE_LIST(ID INTEGER PRIMARY KEY AUTOINCREMENT,\
                                   UUID BLOB NOT NULL UNIQUE, STATE INT NOT NULL);\
                        CREATE TABLE IF NOT EXISTS T_DEVICE_LINK_STATE(ID INT NOT NULL, ID2 INT NOT \
-                                    NULL,STATE INT NOT NULL, PRIMARY KEY (ID, ID2));"
+                                    NULL,STATE INT NOT NULL, PRIMARY KEY (ID, ID2));\
+                       CREATE INDEX IF NOT EXISTS I_DEVICE_LIST_STATE ON T_DEVICE_LIST(STATE, UUID);\
+                       CREATE INDEX IF NOT EXISTS I_DEVICE_LINK_STATE_ID2 ON T_DEVICE_LINK_STATE(ID2);"
+
+/**
+ * Write ahead log, so that a transaction costs an append to the log instead of
+ * rewriting the database pages. The log is synced at checkpoints only.
+ */
+#define PDM_JOURNAL_MODE "PRAGMA journal_mode=WAL;PRAGMA synchronous=NORMAL;"
+
 /**
  * Macro to verify sqlite success.
  * eg: VERIFY_NON_NULL(TAG, ptrData, ERROR,OC_STACK_ERROR);
@@ -78,7 +87,7 @@ PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_STALE_INFO);
 #define PDM_SQLITE_INSERT_T_DEVICE_LIST_SIZE (int)sizeof(PDM_SQLITE_INSERT_T_DEVICE_LIST)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_INSERT_T_DEVICE_LIST);
 
-#define PDM_SQLITE_GET_ID "SELECT ID FROM T_DEVICE_LIST WHERE UUID like ?"
+#define PDM_SQLITE_GET_ID "SELECT ID FROM T_DEVICE_LIST WHERE UUID = ?"
 #define PDM_SQLITE_GET_ID_SIZE (int)sizeof(PDM_SQLITE_GET_ID)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_ID);
 
@@ -94,6 +103,8 @@ PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_DELETE_LINK);
 #define PDM_SQLITE_DELETE_DEVICE_SIZE (int)sizeof(PDM_SQLITE_DELETE_DEVICE)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_DELETE_DEVICE);
 #define PDM_SQLITE_DELETE_DEVICE_WITH_STATE "DELETE FROM T_DEVICE_LIST  WHERE STATE= ?"
+#define PDM_SQLITE_DELETE_DEVICE_WITH_STATE_SIZE (int)sizeof(PDM_SQLITE_DELETE_DEVICE_WITH_STATE)
+PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_DELETE_DEVICE_WITH_STATE);
 #define PDM_SQLITE_UPDATE_LINK "UPDATE T_DEVICE_LINK_STATE SET STATE = ?  WHERE ID = ? and ID2 = ?"
 #define PDM_SQLITE_UPDATE_LINK_SIZE (int)sizeof(PDM_SQLITE_UPDATE_LINK)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_UPDATE_LINK);
@@ -116,11 +127,11 @@ PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_LINKED_DEVICES);
 #define PDM_SQLITE_GET_DEVICE_LINKS_SIZE (int)sizeof(PDM_SQLITE_GET_DEVICE_LINKS)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_DEVICE_LINKS);
 
-#define PDM_SQLITE_UPDATE_DEVICE "UPDATE T_DEVICE_LIST SET STATE = ?  WHERE UUID like ?"
+#define PDM_SQLITE_UPDATE_DEVICE "UPDATE T_DEVICE_LIST SET STATE = ?  WHERE UUID = ?"
 #define PDM_SQLITE_UPDATE_DEVICE_SIZE (int)sizeof(PDM_SQLITE_UPDATE_DEVICE)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_UPDATE_DEVICE);
 
-#define PDM_SQLITE_GET_DEVICE_STATUS "SELECT STATE FROM T_DEVICE_LIST WHERE UUID like ?"
+#define PDM_SQLITE_GET_DEVICE_STATUS "SELECT STATE FROM T_DEVICE_LIST WHERE UUID = ?"
 #define PDM_SQLITE_GET_DEVICE_STATUS_SIZE (int)sizeof(PDM_SQLITE_GET_DEVICE_STATUS)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_DEVICE_STATUS);
 
@@ -129,6 +140,62 @@ PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_DEVICE_STATUS);
 #define PDM_SQLITE_UPDATE_LINK_STALE_FOR_STALE_DEVICE_SIZE (int)sizeof(PDM_SQLITE_UPDATE_LINK_STALE_FOR_STALE_DEVICE)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_UPDATE_LINK_STALE_FOR_STALE_DEVICE);
 
+#define PDM_SQLITE_GET_ID_AND_STATE "SELECT ID,STATE FROM T_DEVICE_LIST WHERE UUID = ?"
+#define PDM_SQLITE_GET_ID_AND_STATE_SIZE (int)sizeof(PDM_SQLITE_GET_ID_AND_STATE)
+PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_ID_AND_STATE);
+
+/**
+ * Statements prepared once per database connection and kept until PDMClose().
+ */
+typedef enum
+{
+    PDM_STMT_GET_STALE_INFO = 0,
+    PDM_STMT_INSERT_T_DEVICE_LIST,
+    PDM_STMT_GET_ID,
+    PDM_STMT_INSERT_LINK_DATA,
+    PDM_STMT_DELETE_LINK,
+    PDM_STMT_DELETE_DEVICE,
+    PDM_STMT_DELETE_DEVICE_WITH_STATE,
+    PDM_STMT_UPDATE_LINK,
+    PDM_STMT_LIST_ALL_UUID,
+    PDM_STMT_GET_UUID,
+    PDM_STMT_GET_LINKED_DEVICES,
+    PDM_STMT_GET_DEVICE_LINKS,
+    PDM_STMT_UPDATE_DEVICE,
+    PDM_STMT_GET_DEVICE_STATUS,
+    PDM_STMT_UPDATE_LINK_STALE_FOR_STALE_DEVICE,
+    PDM_STMT_GET_ID_AND_STATE,
+    PDM_STMT_COUNT
+} PdmStatement_t;
+
+typedef struct
+{
+    const char *sql;
+    int size;
+} PdmStatementText_t;
+
+/* In the order of PdmStatement_t. */
+static const PdmStatementText_t g_statementTexts[PDM_STMT_COUNT] =
+{
+    { PDM_SQLITE_GET_STALE_INFO, PDM_SQLITE_GET_STALE_INFO_SIZE },
+    { PDM_SQLITE_INSERT_T_DEVICE_LIST, PDM_SQLITE_INSERT_T_DEVICE_LIST_SIZE },
+    { PDM_SQLITE_GET_ID, PDM_SQLITE_GET_ID_SIZE },
+    { PDM_SQLITE_INSERT_LINK_DATA, PDM_SQLITE_INSERT_LINK_DATA_SIZE },
+    { PDM_SQLITE_DELETE_LINK, PDM_SQLITE_DELETE_LINK_SIZE },
+    { PDM_SQLITE_DELETE_DEVICE, PDM_SQLITE_DELETE_DEVICE_SIZE },
+    { PDM_SQLITE_DELETE_DEVICE_WITH_STATE, PDM_SQLITE_DELETE_DEVICE_WITH_STATE_SIZE },
+    { PDM_SQLITE_UPDATE_LINK, PDM_SQLITE_UPDATE_LINK_SIZE },
+    { PDM_SQLITE_LIST_ALL_UUID, PDM_SQLITE_LIST_ALL_UUID_SIZE },
+    { PDM_SQLITE_GET_UUID, PDM_SQLITE_GET_UUID_SIZE },
+    { PDM_SQLITE_GET_LINKED_DEVICES, PDM_SQLITE_GET_LINKED_DEVICES_SIZE },
+    { PDM_SQLITE_GET_DEVICE_LINKS, PDM_SQLITE_GET_DEVICE_LINKS_SIZE },
+    { PDM_SQLITE_UPDATE_DEVICE, PDM_SQLITE_UPDATE_DEVICE_SIZE },
+    { PDM_SQLITE_GET_DEVICE_STATUS, PDM_SQLITE_GET_DEVICE_STATUS_SIZE },
+    { PDM_SQLITE_UPDATE_LINK_STALE_FOR_STALE_DEVICE,
+      PDM_SQLITE_UPDATE_LINK_STALE_FOR_STALE_DEVICE_SIZE },
+    { PDM_SQLITE_GET_ID_AND_STATE, PDM_SQLITE_GET_ID_AND_STATE_SIZE },
+};
+
 
 #define ASCENDING_ORDER(id1, id2) do{if( (id1) > (id2) )\
   { int temp; temp = id1; id1 = id2; id2 = temp; }}while(0)
@@ -139,6 +206,51 @@ PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_UPDATE_LINK_STALE_FOR_STALE_DEVICE);
 
 static sqlite3 *g_db = NULL;
 static bool gInit = false;  /* Only if we can open sqlite db successfully, gInit is true. */
+static sqlite3_stmt *g_statements[PDM_STMT_COUNT];
+
+/**
+ * Function to get a prepared statement, prepared on first use.
+ * The statement must be given back with releaseStatement() once stepped.
+ */
+static int prepareStatement(PdmStatement_t index, sqlite3_stmt **stmt)
+{
+    if (NULL == g_statements[index])
+    {
+        int res = sqlite3_prepare_v2(g_db, g_statementTexts[index].sql,
+                                     g_statementTexts[index].size, &g_statements[index], NULL);
+        if (SQLITE_OK != res)
+        {
+            return res;
+        }
+    }
+    *stmt = g_statements[index];
+    return SQLITE_OK;
+}
+
+/**
+ * Function to reset a statement for its next use. This also ends the implicit
+ * read transaction of a query.
+ */
+static void releaseStatement(sqlite3_stmt *stmt)
+{
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+}
+
+/**
+ * Function to finalize all prepared statements, before the database is closed.
+ */
+static void finalizeStatements(void)
+{
+    for (size_t i = 0; i < PDM_STMT_COUNT; i++)
+    {
+        if (NULL != g_statements[i])
+        {
+            sqlite3_finalize(g_statements[i]);
+            g_statements[i] = NULL;
+        }
+    }
+}
 
 /**
  * Function to begin any transaction
@@ -218,6 +330,11 @@ OCStackResult PDMInit(const char *path)
         OIC_LOG_V(INFO, TAG, "ERROR: Can't open database: %s", sqlite3_errmsg(g_db));
         return OC_STACK_ERROR;
     }
+    rc = sqlite3_exec(g_db, PDM_JOURNAL_MODE, NULL, NULL, NULL);
+    if (SQLITE_OK != rc)
+    {
+        OIC_LOG_V(INFO, TAG, "Unable to enable write ahead log: %s", sqlite3_errmsg(g_db));
+    }
     //create DB in case DB doesn't exists
     rc = sqlite3_exec(g_db, PDM_CREATE_DB, NULL, NULL, NULL);
     if (SQLITE_OK != rc)
@@ -245,27 +362,20 @@ OCStackResult PDMInit(const char *path)
 }
 
 
-OCStackResult PDMAddDevice(const OicUuid_t *UUID)
+/**
+ * Function to add a device in the given state
+ */
+static OCStackResult insertDevice(const OicUuid_t *UUID, PdmDeviceState_t state)
 {
-    OIC_LOG_V(DEBUG, TAG, "IN %s", __func__);
-
-    CHECK_PDM_INIT();
-
-    if (NULL == UUID)
-    {
-        return OC_STACK_INVALID_PARAM;
-    }
-
     sqlite3_stmt *stmt = 0;
     int res =0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_INSERT_T_DEVICE_LIST,
-                              PDM_SQLITE_INSERT_T_DEVICE_LIST_SIZE, &stmt, NULL);
+    res = prepareStatement(PDM_STMT_INSERT_T_DEVICE_LIST, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_blob(stmt, PDM_BIND_INDEX_SECOND, UUID, UUID_LENGTH, SQLITE_STATIC);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
-    res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_THIRD, PDM_DEVICE_INIT);
+    res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_THIRD, state);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_step(stmt);
@@ -275,14 +385,68 @@ OCStackResult PDMAddDevice(const OicUuid_t *UUID)
         {
             //new OCStack result code
             OIC_LOG_V(ERROR, TAG, "Error Occured: %s",sqlite3_errmsg(g_db));
-            sqlite3_finalize(stmt);
+            releaseStatement(stmt);
             return OC_STACK_DUPLICATE_UUID;
         }
         OIC_LOG_V(ERROR, TAG, "Error Occured: %s",sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
+        return OC_STACK_ERROR;
+    }
+    releaseStatement(stmt);
+    return OC_STACK_OK;
+}
+
+OCStackResult PDMAddDevice(const OicUuid_t *UUID)
+{
+    OIC_LOG_V(DEBUG, TAG, "IN %s", __func__);
+
+    CHECK_PDM_INIT();
+
+    if (NULL == UUID)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+
+    OCStackResult res = insertDevice(UUID, PDM_DEVICE_INIT);
+
+    OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
+    return res;
+}
+
+OCStackResult PDMAddDeviceList(const OCUuidList_t *uuidList, PdmDeviceState_t state)
+{
+    OIC_LOG_V(DEBUG, TAG, "IN %s", __func__);
+
+    CHECK_PDM_INIT();
+
+    if (NULL == uuidList)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+    if (PDM_DEVICE_ACTIVE != state && PDM_DEVICE_STALE != state && PDM_DEVICE_INIT != state)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+
+    if (OC_STACK_OK != begin())
+    {
+        return OC_STACK_ERROR;
+    }
+    for (const OCUuidList_t *node = uuidList; NULL != node; node = node->next)
+    {
+        OCStackResult res = insertDevice(&node->dev, state);
+        if (OC_STACK_OK != res)
+        {
+            rollback();
+            OIC_LOG(ERROR, TAG, "Unable to add device list");
+            return res;
+        }
+    }
+    if (OC_STACK_OK != commit())
+    {
+        rollback();
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
 
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
@@ -305,8 +469,7 @@ static OCStackResult getIdForUUID(const OicUuid_t *UUID , int *id)
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_ID, PDM_SQLITE_GET_ID_SIZE,
-                             &stmt, NULL);
+    res = prepareStatement(PDM_STMT_GET_ID, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_blob(stmt, PDM_BIND_INDEX_FIRST, UUID, UUID_LENGTH, SQLITE_STATIC);
@@ -318,11 +481,37 @@ static OCStackResult getIdForUUID(const OicUuid_t *UUID , int *id)
         int tempId = sqlite3_column_int(stmt, PDM_FIRST_INDEX);
         OIC_LOG_V(DEBUG, TAG, "ID is %d", tempId);
         *id = tempId;
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
         return OC_STACK_OK;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
+    return OC_STACK_INVALID_PARAM;
+}
+
+/**
+ *function to get Id and state for given UUID
+ */
+static OCStackResult getIdAndStateForUUID(const OicUuid_t *UUID, int *id,
+                                          PdmDeviceState_t *state)
+{
+    sqlite3_stmt *stmt = 0;
+    int res = 0;
+    res = prepareStatement(PDM_STMT_GET_ID_AND_STATE, &stmt);
+    PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
+
+    res = sqlite3_bind_blob(stmt, PDM_BIND_INDEX_FIRST, UUID, UUID_LENGTH, SQLITE_STATIC);
+    PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
+
+    *state = PDM_DEVICE_UNKNOWN;
+    if (SQLITE_ROW == sqlite3_step(stmt))
+    {
+        *id = sqlite3_column_int(stmt, PDM_FIRST_INDEX);
+        *state = (PdmDeviceState_t)sqlite3_column_int(stmt, PDM_SECOND_INDEX);
+        releaseStatement(stmt);
+        return OC_STACK_OK;
+    }
+    releaseStatement(stmt);
     return OC_STACK_INVALID_PARAM;
 }
 
@@ -341,8 +530,7 @@ OCStackResult PDMIsDuplicateDevice(const OicUuid_t* UUID, bool *result)
     }
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_ID, PDM_SQLITE_GET_ID_SIZE,
-                             &stmt, NULL);
+    res = prepareStatement(PDM_STMT_GET_ID, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_blob(stmt, PDM_BIND_INDEX_FIRST, UUID, UUID_LENGTH, SQLITE_STATIC);
@@ -356,7 +544,7 @@ OCStackResult PDMIsDuplicateDevice(const OicUuid_t* UUID, bool *result)
         retValue = true;
     }
 
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     *result = retValue;
 
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
@@ -374,8 +562,7 @@ static OCStackResult addlink(int id1, int id2)
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_INSERT_LINK_DATA,
-                              PDM_SQLITE_INSERT_LINK_DATA_SIZE, &stmt, NULL);
+    res = prepareStatement(PDM_STMT_INSERT_LINK_DATA, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id1);
@@ -390,27 +577,22 @@ static OCStackResult addlink(int id1, int id2)
     if (sqlite3_step(stmt) != SQLITE_DONE)
     {
         OIC_LOG_V(ERROR, TAG, "Error Occured: %s",sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
 
-OCStackResult PDMLinkDevices(const OicUuid_t *UUID1, const OicUuid_t *UUID2)
+/**
+ * Function to link two active devices
+ */
+static OCStackResult linkDevices(const OicUuid_t *UUID1, const OicUuid_t *UUID2)
 {
-    OIC_LOG_V(DEBUG, TAG, "IN %s", __func__);
-
-    CHECK_PDM_INIT();
-    if (NULL == UUID1 || NULL == UUID2)
-    {
-        OIC_LOG(ERROR, TAG, "Invalid PARAM");
-        return  OC_STACK_INVALID_PARAM;
-    }
-
+    int id1 = 0;
     PdmDeviceState_t state = PDM_DEVICE_UNKNOWN;
-    if (OC_STACK_OK != PDMGetDeviceState(UUID1, &state))
+    if (OC_STACK_ERROR == getIdAndStateForUUID(UUID1, &id1, &state))
     {
         OIC_LOG(ERROR, TAG, "Internal error occured");
         return OC_STACK_ERROR;
@@ -421,8 +603,9 @@ OCStackResult PDMLinkDevices(const OicUuid_t *UUID1, const OicUuid_t *UUID2)
         return OC_STACK_INVALID_PARAM;
     }
 
+    int id2 = 0;
     state = PDM_DEVICE_UNKNOWN;
-    if (OC_STACK_OK != PDMGetDeviceState(UUID2, &state))
+    if (OC_STACK_ERROR == getIdAndStateForUUID(UUID2, &id2, &state))
     {
         OIC_LOG(ERROR, TAG, "Internal error occured");
         return OC_STACK_ERROR;
@@ -433,22 +616,58 @@ OCStackResult PDMLinkDevices(const OicUuid_t *UUID1, const OicUuid_t *UUID2)
         return OC_STACK_INVALID_PARAM;
     }
 
-    int id1 = 0;
-    if (OC_STACK_OK != getIdForUUID(UUID1, &id1))
+    ASCENDING_ORDER(id1, id2);
+    return addlink(id1, id2);
+}
+
+OCStackResult PDMLinkDevices(const OicUuid_t *UUID1, const OicUuid_t *UUID2)
+{
+    OIC_LOG_V(DEBUG, TAG, "IN %s", __func__);
+
+    CHECK_PDM_INIT();
+    if (NULL == UUID1 || NULL == UUID2)
     {
-        OIC_LOG(ERROR, TAG, "Requested value not found");
-        return OC_STACK_INVALID_PARAM;
+        OIC_LOG(ERROR, TAG, "Invalid PARAM");
+        return  OC_STACK_INVALID_PARAM;
     }
-    int id2 = 0;
-    if (OC_STACK_OK != getIdForUUID(UUID2, &id2))
+
+    OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
+    return linkDevices(UUID1, UUID2);
+}
+
+OCStackResult PDMLinkDeviceList(const OCPairList_t *pairList)
+{
+    OIC_LOG_V(DEBUG, TAG, "IN %s", __func__);
+
+    CHECK_PDM_INIT();
+    if (NULL == pairList)
     {
-        OIC_LOG(ERROR, TAG, "Requested value not found");
-        return OC_STACK_INVALID_PARAM;
+        OIC_LOG(ERROR, TAG, "Invalid PARAM");
+        return  OC_STACK_INVALID_PARAM;
+    }
+
+    if (OC_STACK_OK != begin())
+    {
+        return OC_STACK_ERROR;
+    }
+    for (const OCPairList_t *node = pairList; NULL != node; node = node->next)
+    {
+        OCStackResult res = linkDevices(&node->dev, &node->dev2);
+        if (OC_STACK_OK != res)
+        {
+            rollback();
+            OIC_LOG(ERROR, TAG, "Unable to link device list");
+            return res;
+        }
+    }
+    if (OC_STACK_OK != commit())
+    {
+        rollback();
+        return OC_STACK_ERROR;
     }
 
-    ASCENDING_ORDER(id1, id2);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
-    return addlink(id1, id2);
+    return OC_STACK_OK;
 }
 
 /**
@@ -462,8 +681,7 @@ static OCStackResult removeLink(int id1, int id2)
 
     int res = 0;
     sqlite3_stmt *stmt = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_DELETE_LINK,
-                             PDM_SQLITE_DELETE_LINK_SIZE, &stmt, NULL);
+    res = prepareStatement(PDM_STMT_DELETE_LINK, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id1);
@@ -475,10 +693,10 @@ static OCStackResult removeLink(int id1, int id2)
     if (SQLITE_DONE != sqlite3_step(stmt))
     {
         OIC_LOG_V(ERROR, TAG, "Error message: %s", sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -520,8 +738,7 @@ static OCStackResult removeFromDeviceList(int id)
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_DELETE_DEVICE,
-                              PDM_SQLITE_DELETE_DEVICE_SIZE, &stmt, NULL);
+    res = prepareStatement(PDM_STMT_DELETE_DEVICE, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id);
@@ -530,10 +747,10 @@ static OCStackResult removeFromDeviceList(int id)
     if (sqlite3_step(stmt) != SQLITE_DONE)
     {
         OIC_LOG_V(ERROR, TAG, "Error message: %s", sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -574,8 +791,7 @@ static OCStackResult updateLinkState(int id1, int id2, int state)
 
     sqlite3_stmt *stmt = 0;
     int res = 0 ;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_UPDATE_LINK,
-                              PDM_SQLITE_UPDATE_LINK_SIZE, &stmt, NULL);
+    res = prepareStatement(PDM_STMT_UPDATE_LINK, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, state);
@@ -590,10 +806,10 @@ static OCStackResult updateLinkState(int id1, int id2, int state)
     if (SQLITE_DONE != sqlite3_step(stmt))
     {
         OIC_LOG_V(ERROR, TAG, "Error message: %s", sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -639,8 +855,7 @@ OCStackResult PDMGetOwnedDevices(OCUuidList_t **uuidList, size_t *numOfDevices)
     }
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_LIST_ALL_UUID,
-                              PDM_SQLITE_LIST_ALL_UUID_SIZE, &stmt, NULL);
+    res = prepareStatement(PDM_STMT_LIST_ALL_UUID, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     size_t counter  = 0;
@@ -652,7 +867,7 @@ OCStackResult PDMGetOwnedDevices(OCUuidList_t **uuidList, size_t *numOfDevices)
         if (NULL == temp)
         {
             OIC_LOG_V(ERROR, TAG, "Memory allocation problem");
-            sqlite3_finalize(stmt);
+            releaseStatement(stmt);
             return OC_STACK_NO_MEMORY;
         }
         memcpy(&temp->dev.id, uid->id, UUID_LENGTH);
@@ -660,7 +875,7 @@ OCStackResult PDMGetOwnedDevices(OCUuidList_t **uuidList, size_t *numOfDevices)
         ++counter;
     }
     *numOfDevices = counter;
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -679,8 +894,7 @@ static OCStackResult getUUIDforId(int id, OicUuid_t *uid, bool *result)
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_UUID,
-                              PDM_SQLITE_GET_UUID_SIZE, &stmt, NULL);
+    res = prepareStatement(PDM_STMT_GET_UUID, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id);
@@ -695,10 +909,10 @@ static OCStackResult getUUIDforId(int id, OicUuid_t *uid, bool *result)
             *result = (PDM_DEVICE_STALE == sqlite3_column_int(stmt, PDM_SECOND_INDEX)) ?
                         true : false;
         }
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_OK;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_INVALID_PARAM;
 }
@@ -728,9 +942,9 @@ OCStackResult PDMGetLinkedDevices(const OicUuid_t *UUID, OCUuidList_t **UUIDLIST
         OIC_LOG(ERROR, TAG, "Not null list will cause memory leak");
         return OC_STACK_INVALID_PARAM;
     }
+    int id = 0;
     PdmDeviceState_t state = PDM_DEVICE_UNKNOWN;
-    OCStackResult ret = PDMGetDeviceState(UUID, &state);
-    if (OC_STACK_OK != ret)
+    if (OC_STACK_ERROR == getIdAndStateForUUID(UUID, &id, &state))
     {
         OIC_LOG(ERROR, TAG, "Internal error occured");
         return OC_STACK_ERROR;
@@ -740,18 +954,11 @@ OCStackResult PDMGetLinkedDevices(const OicUuid_t *UUID, OCUuidList_t **UUIDLIST
         OIC_LOG_V(ERROR, TAG, "Device state is not active : %d", state);
         return OC_STACK_INVALID_PARAM;
     }
-    int id = 0;
-    if (OC_STACK_OK != getIdForUUID(UUID, &id))
-    {
-        OIC_LOG(ERROR, TAG, "Requested value not found");
-        return OC_STACK_INVALID_PARAM;
-    }
 
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_LINKED_DEVICES,
-                              PDM_SQLITE_GET_LINKED_DEVICES_SIZE, &stmt, NULL);
+    res = prepareStatement(PDM_STMT_GET_LINKED_DEVICES, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id);
@@ -780,7 +987,7 @@ OCStackResult PDMGetLinkedDevices(const OicUuid_t *UUID, OCUuidList_t **UUIDLIST
         if (NULL == tempNode)
         {
             OIC_LOG(ERROR, TAG, "No Memory");
-            sqlite3_finalize(stmt);
+            releaseStatement(stmt);
             return OC_STACK_NO_MEMORY;
         }
         memcpy(&tempNode->dev.id, &temp.id, UUID_LENGTH);
@@ -788,7 +995,7 @@ OCStackResult PDMGetLinkedDevices(const OicUuid_t *UUID, OCUuidList_t **UUIDLIST
         ++counter;
     }
     *numOfDevices = counter;
-     sqlite3_finalize(stmt);
+     releaseStatement(stmt);
      OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
      return OC_STACK_OK;
 }
@@ -806,8 +1013,7 @@ OCStackResult PDMGetToBeUnlinkedDevices(OCPairList_t **staleDevList, size_t *num
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_STALE_INFO,
-                              PDM_SQLITE_GET_STALE_INFO_SIZE, &stmt, NULL);
+    res = prepareStatement(PDM_STMT_GET_STALE_INFO, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, PDM_DEVICE_STALE);
@@ -827,7 +1033,7 @@ OCStackResult PDMGetToBeUnlinkedDevices(OCPairList_t **staleDevList, size_t *num
         if (NULL == tempNode)
         {
             OIC_LOG(ERROR, TAG, "No Memory");
-            sqlite3_finalize(stmt);
+            releaseStatement(stmt);
             return OC_STACK_NO_MEMORY;
         }
         memcpy(&tempNode->dev.id, &temp1.id, UUID_LENGTH);
@@ -836,7 +1042,7 @@ OCStackResult PDMGetToBeUnlinkedDevices(OCPairList_t **staleDevList, size_t *num
         ++counter;
     }
     *numOfDevices = counter;
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -849,6 +1055,8 @@ OCStackResult PDMClose(void)
 
     if (g_db)
     {
+        finalizeStatements();
+
         int res = 0;
         res = sqlite3_close(g_db);
         g_db = NULL;
@@ -905,24 +1113,12 @@ OCStackResult PDMIsLinkExists(const OicUuid_t* uuidOfDevice1, const OicUuid_t* u
     }
     int id1 = 0;
     int id2 = 0;
-    if (OC_STACK_OK != getIdForUUID(uuidOfDevice1, &id1))
-    {
-        OIC_LOG(ERROR, TAG, "Requested value not found");
-        return OC_STACK_INVALID_PARAM;
-    }
-
-    if (OC_STACK_OK != getIdForUUID(uuidOfDevice2, &id2))
+    PdmDeviceState_t state = PDM_DEVICE_UNKNOWN;
+    if (OC_STACK_OK != getIdAndStateForUUID(uuidOfDevice1, &id1, &state))
     {
         OIC_LOG(ERROR, TAG, "Requested value not found");
         return OC_STACK_INVALID_PARAM;
     }
-
-    PdmDeviceState_t state = PDM_DEVICE_UNKNOWN;
-    if (OC_STACK_OK != PDMGetDeviceState(uuidOfDevice1, &state))
-    {
-        OIC_LOG(ERROR, TAG, "uuidOfDevice1:Internal error occured");
-        return OC_STACK_ERROR;
-    }
     if (PDM_DEVICE_ACTIVE != state)
     {
         OIC_LOG_V(ERROR, TAG, "uuidOfDevice1:Device state is not active : %d", state);
@@ -930,10 +1126,10 @@ OCStackResult PDMIsLinkExists(const OicUuid_t* uuidOfDevice1, const OicUuid_t* u
     }
 
     state = PDM_DEVICE_UNKNOWN;
-    if (OC_STACK_OK != PDMGetDeviceState(uuidOfDevice2, &state))
+    if (OC_STACK_OK != getIdAndStateForUUID(uuidOfDevice2, &id2, &state))
     {
-        OIC_LOG(ERROR, TAG, "uuidOfDevice2:Internal error occured");
-        return OC_STACK_ERROR;
+        OIC_LOG(ERROR, TAG, "Requested value not found");
+        return OC_STACK_INVALID_PARAM;
     }
     if (PDM_DEVICE_ACTIVE != state)
     {
@@ -945,8 +1141,7 @@ OCStackResult PDMIsLinkExists(const OicUuid_t* uuidOfDevice1, const OicUuid_t* u
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_DEVICE_LINKS,
-                              PDM_SQLITE_GET_DEVICE_LINKS_SIZE, &stmt, NULL);
+    res = prepareStatement(PDM_STMT_GET_DEVICE_LINKS, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id1);
@@ -961,7 +1156,7 @@ OCStackResult PDMIsLinkExists(const OicUuid_t* uuidOfDevice1, const OicUuid_t* u
         OIC_LOG(INFO, TAG, "Link already exists between devices");
         ret = true;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     *result = ret;
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
@@ -975,8 +1170,7 @@ static OCStackResult updateDeviceState(const OicUuid_t *uuid, PdmDeviceState_t s
 
     sqlite3_stmt *stmt = 0;
     int res = 0 ;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_UPDATE_DEVICE,
-                              PDM_SQLITE_UPDATE_DEVICE_SIZE, &stmt, NULL);
+    res = prepareStatement(PDM_STMT_UPDATE_DEVICE, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, state);
@@ -988,10 +1182,10 @@ static OCStackResult updateDeviceState(const OicUuid_t *uuid, PdmDeviceState_t s
     if (SQLITE_DONE != sqlite3_step(stmt))
     {
         OIC_LOG_V(ERROR, TAG, "Error message: %s", sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -1012,9 +1206,7 @@ static OCStackResult updateLinkForStaleDevice(const OicUuid_t *devUuid)
         return OC_STACK_INVALID_PARAM;
     }
 
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_UPDATE_LINK_STALE_FOR_STALE_DEVICE,
-                              PDM_SQLITE_UPDATE_LINK_STALE_FOR_STALE_DEVICE_SIZE,
-                               &stmt, NULL);
+    res = prepareStatement(PDM_STMT_UPDATE_LINK_STALE_FOR_STALE_DEVICE, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id);
@@ -1026,10 +1218,10 @@ static OCStackResult updateLinkForStaleDevice(const OicUuid_t *devUuid)
     if (SQLITE_DONE != sqlite3_step(stmt))
     {
         OIC_LOG_V(ERROR, TAG, "Error message: %s", sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -1084,8 +1276,7 @@ OCStackResult PDMGetDeviceState(const OicUuid_t *uuid, PdmDeviceState_t* result)
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_DEVICE_STATUS, PDM_SQLITE_GET_DEVICE_STATUS_SIZE,
-                              &stmt, NULL);
+    res = prepareStatement(PDM_STMT_GET_DEVICE_STATUS, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_blob(stmt, PDM_BIND_INDEX_FIRST, uuid, UUID_LENGTH, SQLITE_STATIC);
@@ -1098,7 +1289,7 @@ OCStackResult PDMGetDeviceState(const OicUuid_t *uuid, PdmDeviceState_t* result)
         OIC_LOG_V(DEBUG, TAG, "Device state is %d", tempStaleStateFromDb);
         *result = (PdmDeviceState_t)tempStaleStateFromDb;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -1116,8 +1307,7 @@ OCStackResult PDMDeleteDeviceWithState(const PdmDeviceState_t state)
 
     sqlite3_stmt *stmt = 0;
     int res =0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_DELETE_DEVICE_WITH_STATE,
-                              (int)strlen(PDM_SQLITE_DELETE_DEVICE_WITH_STATE) + 1, &stmt, NULL);
+    res = prepareStatement(PDM_STMT_DELETE_DEVICE_WITH_STATE, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, state);
@@ -1126,10 +1316,10 @@ OCStackResult PDMDeleteDeviceWithState(const PdmDeviceState_t state)
     if (SQLITE_DONE != sqlite3_step(stmt))
     {
         OIC_LOG_V(ERROR, TAG, "Error message: %s", sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
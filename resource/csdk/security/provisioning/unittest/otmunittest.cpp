@@ -343,6 +343,74 @@ TEST(OCDiscoverUnownedDevices, Simple)
     EXPECT_EQ(OC_STACK_OK, OCClosePM());
 }
 
+static size_t g_concurrentResults;
+
+static void concurrentOwnershipTransferCB(void *ctx, size_t nOfRes, OCProvisionResult_t *arr,
+                                          bool hasError)
+{
+    OC_UNUSED(ctx);
+
+    for (size_t i = 0; i < nOfRes; i++)
+    {
+        if (OC_STACK_OK == arr[i].res)
+        {
+            g_concurrentResults++;
+        }
+    }
+    g_callbackResult = !hasError;
+    g_doneCB = true;
+}
+
+TEST(OCDoOwnershipTransfer, Concurrent)
+{
+    //initialize Provisioning DB Manager
+    EXPECT_EQ(OC_STACK_OK, OCInitPM(PM_DB_FILE_NAME));
+
+    // Servers 3 and 4 are transferred together, the others by the Simple test.
+    OCProvisionDev_t *devices = NULL;
+    OCProvisionDev_t *tempDev1 = NULL;
+    OCProvisionDev_t *tempDev2 = NULL;
+    size_t numOfDevices = 0;
+    LL_FOREACH_SAFE(g_unownedDevices, tempDev1, tempDev2)
+    {
+        char *uuidString = NULL;
+        EXPECT_EQ(OC_STACK_OK, ConvertUuidToStr((const OicUuid_t *) &tempDev1->doxm->deviceID,
+                                                &uuidString));
+        if (uuidString && ('3' == uuidString[UUID_TEMPLATE_LEN] ||
+                           '4' == uuidString[UUID_TEMPLATE_LEN]))
+        {
+            LL_DELETE(g_unownedDevices, tempDev1);
+            LL_APPEND(devices, tempDev1);
+            gNumOfUnownDevice--;
+            numOfDevices++;
+        }
+        OICFree(uuidString);
+    }
+    ASSERT_EQ((size_t)2, numOfDevices);
+
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCSetMaxConcurrentOwnershipTransfers(0));
+    EXPECT_EQ(OC_STACK_OK, OCSetMaxConcurrentOwnershipTransfers(numOfDevices));
+
+    g_doneCB = false;
+    g_concurrentResults = 0;
+    EXPECT_EQ(OC_STACK_OK, OCDoOwnershipTransfer((void *)g_otmCtx, devices,
+              concurrentOwnershipTransferCB));
+
+    if (waitCallbackRet()) // input |g_doneCB| flag implicitly
+    {
+        OIC_LOG(FATAL, TAG, "OCDoOwnershipTransfer callback error");
+    }
+
+    EXPECT_EQ(true, g_doneCB);
+    EXPECT_EQ(true, g_callbackResult);
+    EXPECT_EQ(numOfDevices, g_concurrentResults);
+
+    EXPECT_EQ(OC_STACK_OK, OCSetMaxConcurrentOwnershipTransfers(1));
+    OCDeleteDiscoveredDevices(devices);
+    // close Provisioning DB
+    EXPECT_EQ(OC_STACK_OK, OCClosePM());
+}
+
 TEST(OCDoOwnershipTransfer, Simple)
 {
     //initialize Provisioning DB Manager
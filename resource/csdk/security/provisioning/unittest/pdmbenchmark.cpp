@@ -0,0 +1,192 @@
+/* *****************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * *****************************************************************/
+
+// Provisioning database operations of a provisioning tool managing 10000
+// devices, each linked with the next one. Results are printed as one JSON
+// object per benchmark.
+
+#include "iotivity_config.h"
+#include <gtest/gtest.h>
+#include "provisioningdatabasemanager.h"
+#include "oic_malloc.h"
+#include "utlist.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+#define BENCH_DB_FILE "PDMBench.db"
+
+namespace
+{
+    const int DEVICE_COUNT = 10000;
+
+    void deviceUuid(int index, OicUuid_t *uuid)
+    {
+        char id[UUID_LENGTH + 1];
+        snprintf(id, sizeof(id), "pdmbench%08d", index);
+        memcpy(uuid->id, id, UUID_LENGTH);
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start)
+    {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    void report(const char *name, const char *unit, int count, double seconds)
+    {
+        std::cout << "{\"benchmark\":\"" << name << "\",\"devices\":" << DEVICE_COUNT
+                  << ",\"" << unit << "PerSec\":" << (count / seconds) << "}" << std::endl;
+    }
+}
+
+class PDMBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp()
+    {
+        remove(BENCH_DB_FILE);
+        remove(BENCH_DB_FILE "-wal");
+        remove(BENCH_DB_FILE "-shm");
+        ASSERT_EQ(OC_STACK_OK, PDMInit(BENCH_DB_FILE));
+    }
+
+    void TearDown()
+    {
+        EXPECT_EQ(OC_STACK_OK, PDMClose());
+        remove(BENCH_DB_FILE);
+    }
+
+    void addDevices()
+    {
+        OCUuidList_t *list = NULL;
+        for (int i = 0; i < DEVICE_COUNT; i++)
+        {
+            OCUuidList_t *node = (OCUuidList_t *)OICCalloc(1, sizeof(OCUuidList_t));
+            ASSERT_TRUE(NULL != node);
+            deviceUuid(i, &node->dev);
+            LL_APPEND(list, node);
+        }
+        ASSERT_EQ(OC_STACK_OK, PDMAddDeviceList(list, PDM_DEVICE_ACTIVE));
+        PDMDestoryOicUuidLinkList(list);
+    }
+
+    void linkDevices()
+    {
+        OCPairList_t *list = NULL;
+        for (int i = 0; i + 1 < DEVICE_COUNT; i++)
+        {
+            OCPairList_t *node = (OCPairList_t *)OICCalloc(1, sizeof(OCPairList_t));
+            ASSERT_TRUE(NULL != node);
+            deviceUuid(i, &node->dev);
+            deviceUuid(i + 1, &node->dev2);
+            LL_APPEND(list, node);
+        }
+        ASSERT_EQ(OC_STACK_OK, PDMLinkDeviceList(list));
+        PDMDestoryStaleLinkList(list);
+    }
+};
+
+TEST_F(PDMBenchmark, AddDevice)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < DEVICE_COUNT; i++)
+    {
+        OicUuid_t uuid;
+        deviceUuid(i, &uuid);
+        ASSERT_EQ(OC_STACK_OK, PDMAddDevice(&uuid));
+        ASSERT_EQ(OC_STACK_OK, PDMSetDeviceState(&uuid, PDM_DEVICE_ACTIVE));
+    }
+    report("AddDevice", "devices", DEVICE_COUNT, secondsSince(start));
+}
+
+TEST_F(PDMBenchmark, AddDeviceList)
+{
+    auto start = std::chrono::steady_clock::now();
+    addDevices();
+    report("AddDeviceList", "devices", DEVICE_COUNT, secondsSince(start));
+
+    OCUuidList_t *owned = NULL;
+    size_t numOfDevices = 0;
+    EXPECT_EQ(OC_STACK_OK, PDMGetOwnedDevices(&owned, &numOfDevices));
+    EXPECT_EQ((size_t)DEVICE_COUNT, numOfDevices);
+    PDMDestoryOicUuidLinkList(owned);
+}
+
+TEST_F(PDMBenchmark, LinkDevices)
+{
+    addDevices();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i + 1 < DEVICE_COUNT; i++)
+    {
+        OicUuid_t uuid1;
+        OicUuid_t uuid2;
+        deviceUuid(i, &uuid1);
+        deviceUuid(i + 1, &uuid2);
+        ASSERT_EQ(OC_STACK_OK, PDMLinkDevices(&uuid1, &uuid2));
+    }
+    report("LinkDevices", "links", DEVICE_COUNT - 1, secondsSince(start));
+}
+
+TEST_F(PDMBenchmark, LinkDeviceList)
+{
+    addDevices();
+
+    auto start = std::chrono::steady_clock::now();
+    linkDevices();
+    report("LinkDeviceList", "links", DEVICE_COUNT - 1, secondsSince(start));
+}
+
+TEST_F(PDMBenchmark, IsLinkExists)
+{
+    addDevices();
+    linkDevices();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i + 1 < DEVICE_COUNT; i++)
+    {
+        OicUuid_t uuid1;
+        OicUuid_t uuid2;
+        deviceUuid(i, &uuid1);
+        deviceUuid((i * 7919 + 1) % DEVICE_COUNT, &uuid2);
+        bool exists = false;
+        ASSERT_EQ(OC_STACK_OK, PDMIsLinkExists(&uuid1, &uuid2, &exists));
+    }
+    report("IsLinkExists", "lookups", DEVICE_COUNT - 1, secondsSince(start));
+}
+
+TEST_F(PDMBenchmark, GetOwnedDevices)
+{
+    const int LIST_COUNT = 20;
+    addDevices();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < LIST_COUNT; i++)
+    {
+        OCUuidList_t *owned = NULL;
+        size_t numOfDevices = 0;
+        ASSERT_EQ(OC_STACK_OK, PDMGetOwnedDevices(&owned, &numOfDevices));
+        ASSERT_EQ((size_t)DEVICE_COUNT, numOfDevices);
+        PDMDestoryOicUuidLinkList(owned);
+    }
+    report("GetOwnedDevices", "lists", LIST_COUNT, secondsSince(start));
+}
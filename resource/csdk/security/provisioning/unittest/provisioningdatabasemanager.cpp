@@ -42,6 +42,9 @@ const char ID_10[] = "1222222222222222";
 const char ID_11[] = "2222222222222222";
 const char ID_12[] = "3222222222222222";
 const char ID_13[] = "4222222222222222";
+const char ID_14[] = "5222222222222222";
+const char ID_15[] = "6222222222222222";
+const char ID_16[] = "7222222222222222";
 
 
 TEST(CallPDMAPIbeforeInit, BeforeInit)
@@ -60,6 +63,8 @@ TEST(CallPDMAPIbeforeInit, BeforeInit)
     EXPECT_EQ(OC_STACK_PDM_IS_NOT_INITIALIZED, PDMSetLinkStale(NULL, NULL));
     EXPECT_EQ(OC_STACK_PDM_IS_NOT_INITIALIZED, PDMGetToBeUnlinkedDevices(NULL, NULL));
     EXPECT_EQ(OC_STACK_PDM_IS_NOT_INITIALIZED, PDMIsLinkExists(NULL, NULL, NULL));
+    EXPECT_EQ(OC_STACK_PDM_IS_NOT_INITIALIZED, PDMAddDeviceList(NULL, PDM_DEVICE_ACTIVE));
+    EXPECT_EQ(OC_STACK_PDM_IS_NOT_INITIALIZED, PDMLinkDeviceList(NULL));
 }
 
 TEST(PDMInitTest, PDMInitWithNULL)
@@ -437,3 +442,55 @@ TEST(PDMSetDeviceStaleTest, StaleDeviceNotinLinkedDevice)
     }
     EXPECT_EQ(OC_STACK_OK, PDMClose());
 }
+
+TEST(PDMAddDeviceListTest, ValidCase)
+{
+    EXPECT_EQ(OC_STACK_OK, PDMInit(NULL));
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, PDMAddDeviceList(NULL, PDM_DEVICE_ACTIVE));
+
+    OCUuidList_t dev2 = {{{0,}}, NULL};
+    memcpy(&dev2.dev.id, ID_15, sizeof(dev2.dev.id));
+    OCUuidList_t dev1 = {{{0,}}, &dev2};
+    memcpy(&dev1.dev.id, ID_14, sizeof(dev1.dev.id));
+    EXPECT_EQ(OC_STACK_OK, PDMAddDeviceList(&dev1, PDM_DEVICE_ACTIVE));
+
+    PdmDeviceState_t state = PDM_DEVICE_UNKNOWN;
+    EXPECT_EQ(OC_STACK_OK, PDMGetDeviceState(&dev2.dev, &state));
+    EXPECT_EQ(PDM_DEVICE_ACTIVE, state);
+
+    // A duplicate device fails the whole list.
+    OCUuidList_t dev3 = {{{0,}}, &dev1};
+    memcpy(&dev3.dev.id, ID_16, sizeof(dev3.dev.id));
+    EXPECT_EQ(OC_STACK_DUPLICATE_UUID, PDMAddDeviceList(&dev3, PDM_DEVICE_ACTIVE));
+    bool isDuplicate = true;
+    EXPECT_EQ(OC_STACK_OK, PDMIsDuplicateDevice(&dev3.dev, &isDuplicate));
+    EXPECT_FALSE(isDuplicate);
+    EXPECT_EQ(OC_STACK_OK, PDMClose());
+}
+
+TEST(PDMLinkDeviceListTest, ValidCase)
+{
+    EXPECT_EQ(OC_STACK_OK, PDMInit(NULL));
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, PDMLinkDeviceList(NULL));
+
+    OicUuid_t uid1 = {{0,}};
+    memcpy(&uid1.id, ID_14, sizeof(uid1.id));
+    OicUuid_t uid2 = {{0,}};
+    memcpy(&uid2.id, ID_15, sizeof(uid2.id));
+    OicUuid_t uid3 = {{0,}};
+    memcpy(&uid3.id, ID_16, sizeof(uid3.id));
+
+    // The second pair names an unknown device, so no link is added.
+    OCPairList_t pair2 = {uid2, uid3, NULL};
+    OCPairList_t pair1 = {uid1, uid2, &pair2};
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, PDMLinkDeviceList(&pair1));
+    bool linkExists = true;
+    EXPECT_EQ(OC_STACK_OK, PDMIsLinkExists(&uid1, &uid2, &linkExists));
+    EXPECT_FALSE(linkExists);
+
+    pair1.next = NULL;
+    EXPECT_EQ(OC_STACK_OK, PDMLinkDeviceList(&pair1));
+    EXPECT_EQ(OC_STACK_OK, PDMIsLinkExists(&uid1, &uid2, &linkExists));
+    EXPECT_TRUE(linkExists);
+    EXPECT_EQ(OC_STACK_OK, PDMClose());
+}
@@ -30,6 +30,7 @@
 #include "ocstack.h"
 #include "octypes.h"
 #include "ocserverrequest.h"
+#include "ocquery.h"
 #include "oic_malloc.h"
 #include "oic_string.h"
 #include "experimental/ocrandom.h"
@@ -53,7 +54,6 @@
 #define TAG  "OIC_SRM_ACL"
 #define NUMBER_OF_SEC_PROV_RSCS 3
 #define NUMBER_OF_DEFAULT_SEC_RSCS 2
-#define STRING_UUID_SIZE (UUID_LENGTH * 2 + 5)
 
 static const uint8_t ACL_MAP_SIZE = 2; // RT and IF
 static const uint8_t ACL_ACLIST_MAP_SIZE = 1; // aces object
@@ -2335,34 +2335,22 @@ static OCStackResult RemoveAceByAceIds(AceIdList_t *aceIdList)
 }
 
 /**
- * This method parses the query string received for REST requests and
- * retrieves the 'subject' field.
+ * This method retrieves the 'subject' field from the parsed query of a REST request.
  *
- * @param query querystring passed in REST request
+ * @param query query parsed from the REST request
  * @param subject subject UUID parsed from query string
  *
  * @return true if query parsed successfully and found 'subject', else false.
  */
-static bool GetSubjectFromQueryString(const char *query, OicUuid_t *subject)
+static bool GetSubjectFromQueryString(const OCParsedQuery *query, OicUuid_t *subject)
 {
-    OicParseQueryIter_t parseIter = OC_DEFAULT_OICPARSEQUWRYITER;
-
-    ParseQueryIterInit((unsigned char *) query, &parseIter);
-
-    while (GetNextQuery (&parseIter))
+    for (uint8_t i = 0; i < query->numParams; i++)
     {
-        if (strncasecmp((char *) parseIter.attrPos, OIC_JSON_SUBJECTID_NAME, parseIter.attrLen) == 0)
+        const OCQueryParam *param = &query->params[i];
+        if (0 == strcasecmp(param->key, OIC_JSON_SUBJECTID_NAME))
         {
-            char strUuid[STRING_UUID_SIZE] = {0};
-            VERIFY_SUCCESS(TAG, 0 != parseIter.valLen, ERROR);
-            if (sizeof(strUuid) < parseIter.valLen)
-            {
-                OIC_LOG(ERROR, TAG, "Uuid is too long");
-                goto exit;
-            }
-
-            memcpy(strUuid, parseIter.valPos, parseIter.valLen);
-            OCStackResult res = ConvertStrToUuid(strUuid, subject);
+            VERIFY_SUCCESS(TAG, '\0' != param->value[0], ERROR);
+            OCStackResult res = ConvertStrToUuid(param->value, subject);
             VERIFY_SUCCESS(TAG, OC_STACK_OK == res, ERROR);
             return true;
         }
@@ -2434,28 +2422,24 @@ exit:
 }
 
 /**
- * This method parses the query string received for REST requests and
- * retrieves the 'resource' field.
+ * This method retrieves the 'resource' field from the parsed query of a REST request.
  *
- * @param query querystring passed in REST request
+ * @param query query parsed from the REST request
  * @param resource resource parsed from query string
  * @param resourceSize size of the memory pointed to resource
  *
  * @return true if query parsed successfully and found 'resource', else false.
  */
-static bool GetResourceFromQueryString(const char *query, char *resource, size_t resourceSize)
+static bool GetResourceFromQueryString(const OCParsedQuery *query, char *resource,
+                                       size_t resourceSize)
 {
-    OicParseQueryIter_t parseIter = OC_DEFAULT_OICPARSEQUWRYITER;
-
-    ParseQueryIterInit((unsigned char *) query, &parseIter);
-
-    while (GetNextQuery (&parseIter))
+    for (uint8_t i = 0; i < query->numParams; i++)
     {
-        if (strncasecmp((char *) parseIter.attrPos, OIC_JSON_RESOURCES_NAME, parseIter.attrLen)
-                == 0)
+        const OCQueryParam *param = &query->params[i];
+        if (0 == strcasecmp(param->key, OIC_JSON_RESOURCES_NAME))
         {
-            VERIFY_SUCCESS(TAG, 0 != parseIter.valLen, ERROR);
-            OICStrcpy(resource, resourceSize, (char *) parseIter.valPos);
+            VERIFY_SUCCESS(TAG, '\0' != param->value[0], ERROR);
+            OICStrcpy(resource, resourceSize, param->value);
 
             return true;
         }
@@ -2806,9 +2790,11 @@ static OCEntityHandlerResult HandleACLGetRequest(const OCEntityHandlerRequest *e
     size_t size = 0;
     OCEntityHandlerResult ehRet;
     OicUuid_t subject = OC_DEFAULT_OICUUID;
+    OCParsedQuery query;
 
     // In case, 'subject' field is included in REST request.
-    if (ehRequest->query && GetSubjectFromQueryString(ehRequest->query, &subject))
+    if (ehRequest->query && OC_STACK_OK == OCParseQuery(ehRequest->query, &query)
+        && GetSubjectFromQueryString(&query, &subject))
     {
         OIC_LOG(DEBUG,TAG,"'subject' field is inculded in REST request.");
         OIC_LOG(DEBUG, TAG, "HandleACLGetRequest processing query");
@@ -2831,7 +2817,7 @@ static OCEntityHandlerResult HandleACLGetRequest(const OCEntityHandlerRequest *e
         targetAcl.aces = NULL;
 
         // 'Subject' field is MUST for processing a querystring in REST request.
-        GetResourceFromQueryString(ehRequest->query, resource, sizeof(resource));
+        GetResourceFromQueryString(&query, resource, sizeof(resource));
 
         /*
          * TODO : Currently, this code only provides one ACE for a Subject.
@@ -3143,6 +3129,7 @@ static OCEntityHandlerResult HandleACLDeleteRequest(const OCEntityHandlerRequest
     OicUuid_t subject = OC_DEFAULT_OICUUID;
     AceIdList_t *aceIdList = NULL;
     char resource[MAX_URI_LENGTH] = { 0 };
+    OCParsedQuery query;
 
     VERIFY_NOT_NULL(TAG, ehRequest->query, ERROR);
 
@@ -3157,6 +3144,13 @@ static OCEntityHandlerResult HandleACLDeleteRequest(const OCEntityHandlerRequest
         goto exit;
     }
 
+    // A query that cannot be parsed in full must not fall through to removing every ACE.
+    if (OC_STACK_OK != OCParseQuery(ehRequest->query, &query))
+    {
+        ehRet = OC_EH_BAD_REQ;
+        goto exit;
+    }
+
     if (GetAceIdsFromQueryString(ehRequest->query, &aceIdList))
     {
         if (OC_STACK_RESOURCE_DELETED == RemoveAceByAceIds(aceIdList))
@@ -3166,9 +3160,9 @@ static OCEntityHandlerResult HandleACLDeleteRequest(const OCEntityHandlerRequest
         DeleteAceIdList(&aceIdList);
     }
     // If 'Subject' field exist, processing a querystring in REST request.
-    else if (GetSubjectFromQueryString(ehRequest->query, &subject))
+    else if (GetSubjectFromQueryString(&query, &subject))
     {
-        GetResourceFromQueryString(ehRequest->query, resource, sizeof(resource));
+        GetResourceFromQueryString(&query, resource, sizeof(resource));
 
         if (OC_STACK_RESOURCE_DELETED == RemoveACE(&subject, resource))
         {
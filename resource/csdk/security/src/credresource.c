@@ -37,6 +37,7 @@
 #include "ocstack.h"
 #include "experimental/ocrandom.h"
 #include "ocserverrequest.h"
+#include "ocquery.h"
 #include "oic_malloc.h"
 #include "oic_string.h"
 #include "ocpayload.h"
@@ -1510,6 +1511,11 @@ static bool UpdatePersistentStorage(const OicSecCred_t *cred)
     bool ret = false;
     OIC_LOG(DEBUG, TAG, "IN Cred UpdatePersistentStorage");
 
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+    // Every change to gCred is saved here, so drop the certificates the TLS adapter parsed.
+    CAresetPkixInfoCache();
+#endif
+
     // Convert Cred data into JSON for update to persistent storage
     if (cred)
     {
@@ -2038,31 +2044,22 @@ static OCStackResult RemoveAllCredentials(void)
 }
 
 /**
- * This method parses the query string received for REST requests and
- * retrieves the 'subjectuuid' field.
+ * This method retrieves the 'subjectuuid' field from the parsed query of a REST request.
  *
- * @param query querystring passed in REST request
+ * @param query query parsed from the REST request
  * @param subject subject UUID parsed from query string
  *
  * @return true if query parsed successfully and found 'subject', else false.
  */
-static bool GetSubjectFromQueryString(const char *query, OicUuid_t *subject)
+static bool GetSubjectFromQueryString(const OCParsedQuery *query, OicUuid_t *subject)
 {
-    OicParseQueryIter_t parseIter = OC_PARSER_ITER_INIT;
-
-    ParseQueryIterInit((unsigned char *) query, &parseIter);
-
-    while (GetNextQuery (&parseIter))
+    for (uint8_t i = 0; i < query->numParams; i++)
     {
-        if (strncasecmp((char *) parseIter.attrPos, OIC_JSON_SUBJECTID_NAME, parseIter.attrLen) == 0)
+        const OCQueryParam *param = &query->params[i];
+        if (0 == strcasecmp(param->key, OIC_JSON_SUBJECTID_NAME))
         {
-            VERIFY_SUCCESS(TAG, 0 != parseIter.valLen, ERROR);
-            //temporary set '\0' symbol instead of copy string
-            char tmp = parseIter.valPos[parseIter.valLen];
-            parseIter.valPos[parseIter.valLen] = '\0';
-
-            OCStackResult res = ConvertStrToUuid((const char*)parseIter.valPos, subject);
-            parseIter.valPos[parseIter.valLen] = tmp;
+            VERIFY_SUCCESS(TAG, '\0' != param->value[0], ERROR);
+            OCStackResult res = ConvertStrToUuid(param->value, subject);
             VERIFY_SUCCESS(TAG, OC_STACK_OK == res, ERROR);
             return true;
         }
@@ -2573,6 +2570,7 @@ static OCEntityHandlerResult HandleDeleteRequest(const OCEntityHandlerRequest *e
     OCEntityHandlerResult ehRet = OC_EH_ERROR;
     CredIdList_t *credIdList = NULL;
     OicUuid_t subject = OC_ZERO_UUID;
+    OCParsedQuery query;
 
     if (NULL == ehRequest->query)
     {
@@ -2589,6 +2587,13 @@ static OCEntityHandlerResult HandleDeleteRequest(const OCEntityHandlerRequest *e
         goto exit;
     }
 
+    // A query that cannot be parsed in full must not fall through to removing every credential.
+    if (OC_STACK_OK != OCParseQuery(ehRequest->query, &query))
+    {
+        ehRet = OC_EH_BAD_REQ;
+        goto exit;
+    }
+
     if (GetCredIdsFromQueryString(ehRequest->query, &credIdList))
     {
         if (OC_STACK_RESOURCE_DELETED == RemoveCredentialByCredIds(credIdList))
@@ -2597,7 +2602,7 @@ static OCEntityHandlerResult HandleDeleteRequest(const OCEntityHandlerRequest *e
         }
         DeleteCredIdList(&credIdList);
     }
-    else if (GetSubjectFromQueryString(ehRequest->query, &subject))
+    else if (GetSubjectFromQueryString(&query, &subject))
     {
         if (OC_STACK_RESOURCE_DELETED == RemoveCredential(&subject))
         {
@@ -2752,6 +2757,11 @@ OCStackResult InitCredResource(void)
         gCred = GetCredDefault();
     }
 
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+    // A cache left over from an earlier stack instance describes another gCred.
+    CAresetPkixInfoCache();
+#endif
+
     if (gCred)
     {
         OicUuid_t deviceID;
@@ -2814,6 +2824,9 @@ OCStackResult DeInitCredResource(void)
         DeleteCredList(gCred);
         gCred = NULL;
     }
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+    CAresetPkixInfoCache();
+#endif
     return result;
 }
 
@@ -31,6 +31,7 @@
 #include "oic_malloc.h"
 #include "oic_string.h"
 #include "crlresource.h"
+#include "casecurityinterface.h"
 #include "ocpayloadcbor.h"
 #include "mbedtls/base64.h"
 #include <time.h>
@@ -446,6 +447,7 @@ OCStackResult UpdateCRLResource(OicSecCrl_t *crl)
         OIC_LOG(ERROR, TAG, "Can't update global crl");
         return OC_STACK_ERROR;
     }
+    CAresetPkixInfoCache();
 
     char currentTime[32] = {0};
     getCurrentUTCTime(currentTime, sizeof(currentTime));
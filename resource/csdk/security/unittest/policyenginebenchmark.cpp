@@ -0,0 +1,167 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+// Cost of the access check made for every request to a secured resource,
+// against an ACL of 200 ACEs with one subject each. Results are printed as
+// one JSON object per benchmark.
+
+#include <gtest/gtest.h>
+#include <coap/utlist.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+#include "ocstack.h"
+#include "oic_malloc.h"
+#include "oic_string.h"
+#include "cainterface.h"
+#include "secureresourcemanager.h"
+#include "srmresourcestrings.h"
+#include "aclresource.h"
+#include "pstatresource.h"
+#include "security_internals.h"
+
+extern "C"
+{
+    #include "policyengine.h"
+}
+
+namespace
+{
+    const int ACE_COUNT = 200;
+    const int CHECK_COUNT = 10000;
+
+    void subjectUuid(int index, OicUuid_t *uuid)
+    {
+        char id[UUID_LENGTH + 1];
+        snprintf(id, sizeof(id), "bench%011d", index);
+        memcpy(uuid->id, id, UUID_LENGTH);
+    }
+
+    void resourceUri(int index, char *uri, size_t size)
+    {
+        snprintf(uri, size, "/bench/light/%d", index);
+    }
+
+    OicSecAce_t *createAce(int index)
+    {
+        OicSecAce_t *ace = (OicSecAce_t *)OICCalloc(1, sizeof(OicSecAce_t));
+        ace->subjectType = OicSecAceUuidSubject;
+        subjectUuid(index, &ace->subjectuuid);
+        ace->permission = PERMISSION_READ | PERMISSION_WRITE;
+
+        char uri[MAX_URI_LENGTH];
+        resourceUri(index, uri, sizeof(uri));
+        OicSecRsrc_t *rsrc = (OicSecRsrc_t *)OICCalloc(1, sizeof(OicSecRsrc_t));
+        rsrc->href = OICStrdup(uri);
+        rsrc->typeLen = 1;
+        rsrc->types = (char **)OICCalloc(1, sizeof(char *));
+        rsrc->types[0] = OICStrdup("oic.r.switch.binary");
+        rsrc->interfaceLen = 1;
+        rsrc->interfaces = (char **)OICCalloc(1, sizeof(char *));
+        rsrc->interfaces[0] = OICStrdup("oic.if.a");
+        LL_APPEND(ace->resources, rsrc);
+        return ace;
+    }
+}
+
+class PolicyEngineBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp()
+    {
+        // Outside of RFNOP only the device configuration resources are accessible.
+        ASSERT_EQ(OC_STACK_OK, InitPstatResourceToDefault());
+        ASSERT_EQ(OC_STACK_OK, SetPstatDosS(DOS_RFNOP));
+
+        OicSecAcl_t *acl = (OicSecAcl_t *)OICCalloc(1, sizeof(OicSecAcl_t));
+        ASSERT_TRUE(NULL != acl);
+        memcpy(acl->rownerID.id, "1111111111111111", sizeof(acl->rownerID.id));
+        for (int i = 0; i < ACE_COUNT; i++)
+        {
+            LL_APPEND(acl->aces, createAce(i));
+        }
+        ASSERT_EQ(OC_STACK_OK, SetDefaultACL(acl));
+
+        memset(&endpoint, 0, sizeof(endpoint));
+        endpoint.adapter = CA_ADAPTER_IP;
+        endpoint.flags = CA_SECURE;
+        OICStrcpy(endpoint.addr, sizeof(endpoint.addr), "127.0.0.1");
+        endpoint.port = 5684;
+    }
+
+    void TearDown()
+    {
+        DeInitACLResource();
+        DeInitPstatResource();
+    }
+
+    // Returns the time per check of a GET on the resource of ACE resourceIndex by subjectIndex.
+    double check(int subjectIndex, int resourceIndex, bool expectGranted)
+    {
+        SRMRequestContext_t context;
+        memset(&context, 0, sizeof(context));
+        context.endPoint = &endpoint;
+        context.resourceType = NOT_A_SVR_RESOURCE;
+        resourceUri(resourceIndex, context.resourceUri, sizeof(context.resourceUri));
+        context.requestedPermission = PERMISSION_READ;
+        context.secureChannel = true;
+        context.subjectIdType = SUBJECT_ID_TYPE_UUID;
+        subjectUuid(subjectIndex, &context.subjectUuid);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < CHECK_COUNT; i++)
+        {
+            CheckPermission(&context);
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ(expectGranted, IsAccessGranted(context.responseVal));
+        return elapsed.count() / CHECK_COUNT;
+    }
+
+    CAEndpoint_t endpoint;
+};
+
+TEST_F(PolicyEngineBenchmark, CheckPermissionFirstAce)
+{
+    double ns = check(0, 0, true);
+    std::cout << "{\"benchmark\":\"CheckPermissionFirstAce\",\"aces\":" << ACE_COUNT
+              << ",\"iterations\":" << CHECK_COUNT
+              << ",\"nsPerOp\":" << ns << "}" << std::endl;
+}
+
+TEST_F(PolicyEngineBenchmark, CheckPermissionLastAce)
+{
+    double ns = check(ACE_COUNT - 1, ACE_COUNT - 1, true);
+    std::cout << "{\"benchmark\":\"CheckPermissionLastAce\",\"aces\":" << ACE_COUNT
+              << ",\"iterations\":" << CHECK_COUNT
+              << ",\"nsPerOp\":" << ns << "}" << std::endl;
+}
+
+TEST_F(PolicyEngineBenchmark, CheckPermissionDenied)
+{
+    // A known subject asking for a resource it has no ACE for walks the whole ACL.
+    double ns = check(0, ACE_COUNT - 1, false);
+    std::cout << "{\"benchmark\":\"CheckPermissionDenied\",\"aces\":" << ACE_COUNT
+              << ",\"iterations\":" << CHECK_COUNT
+              << ",\"nsPerOp\":" << ns << "}" << std::endl;
+}
@@ -66,6 +66,19 @@ typedef struct resourcetype_t OCResourceType;
  * Data structure for holding client's callback context, methods and Time to Live,
  * connectivity Types, presence and resource type, request URI etc.
  */
+/**
+ * Encoded discovery response received by a callback batching its responses.
+ */
+typedef struct ReceivedDiscoveryResponse
+{
+    /** Hash of the encoded payload, compared before the payload itself.*/
+    uint32_t hash;
+
+    /** Copy of the encoded payload.*/
+    uint8_t *payload;
+    size_t payloadSize;
+} ReceivedDiscoveryResponse;
+
 typedef struct ClientCB {
     /** callback method defined in application address space. */
     OCClientResponseHandler callBack;
@@ -128,6 +141,20 @@ typedef struct ClientCB {
      * can be explicitly cancelled.*/
     uint32_t TTL;
 
+    /** Time in milliseconds discovery responses are batched for, 0 if they are not.*/
+    uint32_t batchWindowMs;
+
+    /** Time in milliseconds at which the batched discovery responses are delivered.*/
+    uint64_t batchDeadline;
+
+    /** Batched discovery responses, their payloads chained through OCDiscoveryPayload::next.*/
+    OCClientResponse *batchResponse;
+
+    /** Batched discovery responses received, to skip repeated ones unparsed.*/
+    struct ReceivedDiscoveryResponse *receivedResponses;
+    size_t receivedCount;
+    size_t receivedCapacity;
+
     /** next node in this list.*/
     struct ClientCB    *next;
 } ClientCB;
@@ -214,6 +241,31 @@ ClientCB* GetClientCBUsingToken(const CAToken_t token,
  */
 ClientCB* GetClientCBUsingHandle(const OCDoHandle handle);
 
+/**
+ * This method is used to check whether a discovery response was already received by a callback
+ * batching its responses. The response is remembered if it was not.
+ *
+ * @param[in]  cbNode               Client callback node.
+ * @param[in]  payload              Encoded payload of the response.
+ * @param[in]  payloadSize          Size of the encoded payload.
+ *
+ * @return true if the same response was already received, otherwise false
+ */
+bool CheckDiscoveryResponseReceived(ClientCB *cbNode, const uint8_t *payload,
+                                    size_t payloadSize);
+
+/**
+ * This method is used to add a discovery response to the responses batched by a callback.
+ * The first response starts the batch window, the responses of a device already in the batch
+ * are dropped.
+ *
+ * @param[in]  cbNode               Client callback node.
+ * @param[in]  response             Response with a discovery payload, which is taken over.
+ *
+ * @return OC_STACK_OK for Success, otherwise some error value.
+ */
+OCStackResult AddDiscoveryBatchResponse(ClientCB *cbNode, OCClientResponse *response);
+
 #ifdef WITH_PRESENCE
 /**
  * This method is used to search and retrieve a cb node in cbList using a URI.
@@ -106,6 +106,24 @@ typedef struct ResourceObserver
     /** requested payload content version. */
     uint16_t acceptVersion;
 
+    /** notification policy of the observer.*/
+    OCObserveNotificationPolicy policy;
+
+    /** time the last notification was sent in milliseconds, if the policy has an interval.*/
+    uint64_t lastNotificationTime;
+
+    /** number of CON notifications not acknowledged yet, if the policy limits them.*/
+    uint8_t pendingConCount;
+
+    /** a notification waits for the policy to allow it.*/
+    bool notificationPending;
+
+    /** quality of service of the pending notification.*/
+    OCQualityOfService pendingQos;
+
+    /** payload of the pending notification, NULL to get it from the entity handler.*/
+    OCRepPayload *pendingPayload;
+
 } ResourceObserver;
 
 #ifdef WITH_PRESENCE
@@ -154,6 +172,28 @@ OCStackResult SendListObserverNotification (OCResource * resource,
         const OCRepPayload *payload, uint32_t maxAge,
         OCQualityOfService qos);
 
+/**
+ * Account for the end of a CON notification to an observer, acknowledged or timed out,
+ * so that a notification its policy kept may be sent.
+ *
+ * @param observer        Observer the notification was sent to.
+ */
+void CompleteObserveNotification(ResourceObserver *observer);
+
+/**
+ * Send the notifications kept by the policy of their observer once it allows them.
+ * Called from OCProcess.
+ */
+void ProcessObserverNotifications(void);
+
+/**
+ * Get the time until ProcessObserverNotifications has a notification to send.
+ *
+ * @param timeoutMs Maximum time to return in milliseconds.
+ * @return the lower of timeoutMs and the time until the first notification may be sent.
+ */
+uint32_t GetObserverNotificationTimeout(uint32_t timeoutMs);
+
 /**
  * Delete all observers belonging to the resource.
  *
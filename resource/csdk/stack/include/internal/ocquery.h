@@ -0,0 +1,121 @@
+/* ****************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/**
+ * @file
+ *
+ * This file contains the parsing of request URIs and queries. Parsing does
+ * not allocate: the URI is split in place and a query is parsed once into a
+ * fixed size OCParsedQuery which can be looked up as often as needed.
+ */
+#ifndef OC_QUERY_H_
+#define OC_QUERY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "octypes.h"
+#include "ocstackconfig.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** Maximum number of parameters in a parsed query.*/
+#define OC_MAX_QUERY_PARAMS (8)
+
+/**
+ * Key and value of a query parameter.
+ */
+typedef struct
+{
+    /** Key of the parameter.*/
+    const char *key;
+
+    /** Value of the parameter, empty if the key has none.*/
+    const char *value;
+} OCQueryParam;
+
+/**
+ * A query split into its parameters.
+ */
+typedef struct
+{
+    /** Copy of the query with its separators replaced by '\0', holding the parameters.*/
+    char buffer[MAX_QUERY_LENGTH];
+
+    /** Parameters in the order they appear in the query.*/
+    OCQueryParam params[OC_MAX_QUERY_PARAMS];
+
+    /** Number of parameters.*/
+    uint8_t numParams;
+
+    /** True if the query was too long or had too many parameters to parse in full.*/
+    bool truncated;
+} OCParsedQuery;
+
+/**
+ * Split a URI into its path and its query.
+ *
+ * @param[in]  uri         URI, optionally followed by '?' and a query.
+ * @param[out] pathLength  Length of the path, 0 if there is none.
+ *
+ * @return the query following the '?', or NULL if the URI has no query or an empty one.
+ */
+const char *OCGetUriQuery(const char *uri, size_t *pathLength);
+
+/**
+ * Parse a query into its parameters.
+ *
+ * Parameters are separated by one of ::OC_QUERY_SEPARATOR and their key from
+ * their value by ::OC_KEY_VALUE_DELIMITER. Empty parameters are skipped.
+ *
+ * @param[in]  query   Query without the leading '?', NULL for none.
+ * @param[out] parsed  Parsed query. On failure it holds the parameters parsed so far and
+ *                     is marked truncated.
+ *
+ * @return ::OC_STACK_OK on success, ::OC_STACK_INVALID_QUERY if the query is longer than
+ *         ::MAX_QUERY_LENGTH or has more than ::OC_MAX_QUERY_PARAMS parameters.
+ */
+OCStackResult OCParseQuery(const char *query, OCParsedQuery *parsed);
+
+/**
+ * Get the interface and resource type filters of a parsed query.
+ *
+ * A query may hold at most an interface and a resource type filter. If a filter
+ * is repeated, the last one is picked. The filters point into the parsed query.
+ *
+ * @param[in]  parsed              Parsed query.
+ * @param[out] interfaceFilter     Interface filter, NULL if the query has none.
+ * @param[out] resourceTypeFilter  Resource type filter, NULL if the query has none.
+ *
+ * @return ::OC_STACK_OK on success, ::OC_STACK_INVALID_QUERY if the query has more
+ *         than two parameters, any other parameter or was truncated by ::OCParseQuery.
+ */
+OCStackResult OCGetQueryFilters(const OCParsedQuery *parsed,
+                                const char **interfaceFilter,
+                                const char **resourceTypeFilter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OC_QUERY_H_
@@ -247,6 +247,12 @@ typedef struct OCResource {
     /** Sequence number for observable resources. Per the CoAP standard it is a 24 bit value.*/
     uint32_t sequenceNum;
 
+    /** Notification policy given to new observers.*/
+    OCObserveNotificationPolicy observePolicy;
+
+    /** Notification counters of the observers.*/
+    OCObserveNotificationStats observeStats;
+
     /** Pointer of ActionSet which to support group action.*/
     OCActionSet *actionsetHead;
 
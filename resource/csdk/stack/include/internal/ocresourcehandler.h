@@ -215,6 +215,23 @@ void DeletePlatformInfo(void);
  */
 void DeleteDeviceInfo(void);
 
+/**
+ * Internal API used to drop the cached discovery responses after a change of the resources.
+ * It only marks the cache, which is dropped when handling the next discovery request.
+ */
+void InvalidateDiscoveryCache(void);
+
+/**
+ * Internal API used to free the cached discovery responses.
+ */
+void DeleteDiscoveryCache(void);
+
+/**
+ * Internal API used to set how multicast discovery requests are answered.
+ * Called with the stack lock held.
+ */
+void SetMulticastDiscoveryPolicy(const OCMulticastDiscoveryPolicy *policy);
+
 /*
  * Prepare payload for resource representation.
  */
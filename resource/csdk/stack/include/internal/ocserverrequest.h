@@ -31,6 +31,7 @@
 
 #include "cacommon.h"
 #include "cainterface.h"
+#include "ocquery.h"
 
 #include "tree.h"
 
@@ -66,6 +67,9 @@ typedef struct OCServerRequest
     /** resource query send by client.*/
     char query[MAX_QUERY_LENGTH];
 
+    /** query split into its parameters once, when the request is added.*/
+    OCParsedQuery parsedQuery;
+
     /** qos is indicating if the request is CON or NON.*/
     OCQualityOfService qos;
 
@@ -124,6 +128,31 @@ typedef struct OCServerRequest
     /** Payload Size.*/
     size_t payloadSize;
 
+    /** Time in milliseconds after which the responses aggregated so far are sent, 0 for none.*/
+    uint64_t aggregateDeadline;
+
+    /** Flag indicating the aggregated response was sent before all responses arrived.*/
+    uint8_t aggregateResponseSent;
+
+    /** Next server request in the list of requests with an aggregate deadline.*/
+    struct OCServerRequest *nextAggregate;
+
+    /** Payload of the response already encoded in the accept format, such as a cached
+     * discovery response, sent instead of the payload of the response. Not owned.*/
+    const uint8_t *encodedResponsePayload;
+
+    /** Size of the encoded response payload.*/
+    size_t encodedResponsePayloadSize;
+
+    /** Time in milliseconds at which the delayed response is sent, 0 if not delayed.*/
+    uint64_t responseDeadline;
+
+    /** Copy of the encoded response payload kept until the delayed response is sent.*/
+    uint8_t *delayedResponsePayload;
+
+    /** Next server request in the list of requests with a delayed response.*/
+    struct OCServerRequest *nextDelayed;
+
     /** payload is retrieved from the payload of the received request PDU.*/
     uint8_t payload[1];
 
@@ -230,9 +259,8 @@ OCStackResult HandleSingleResponse(OCEntityHandlerResponse * ehResponse);
 /**
  * Handler function for sending a response from multiple resources, such as a collection.
  * Aggregates responses from multiple resource until all responses are received then sends the
- * concatenated response
- *
- * TODO: Need to add a timeout in case a (remote?) resource does not respond
+ * concatenated response. Responses which arrive after the aggregate deadline of the request
+ * are dropped.
  *
  * @param[in]  ehResponse      Pointer to the response from the resource.
  *
@@ -241,6 +269,55 @@ OCStackResult HandleSingleResponse(OCEntityHandlerResponse * ehResponse);
  */
 OCStackResult HandleAggregateResponse(OCEntityHandlerResponse * ehResponse);
 
+/**
+ * Set the time after which the responses aggregated for a request are sent, even if some
+ * resources have not responded yet.
+ *
+ * @param[in]  serverRequest   Server request using ::HandleAggregateResponse.
+ * @param[in]  timeoutMs       Time from now in milliseconds, 0 to wait for all responses.
+ */
+void SetAggregateResponseDeadline(OCServerRequest * serverRequest, uint32_t timeoutMs);
+
+/**
+ * Send the aggregated responses of requests whose aggregate deadline has passed.
+ * Called from OCProcess.
+ */
+void HandleAggregateResponseTimeouts(void);
+
+/**
+ * Get the time until HandleAggregateResponseTimeouts has a response to send.
+ *
+ * @param timeoutMs Maximum time to return in milliseconds.
+ * @return the lower of timeoutMs and the time until the first aggregate deadline.
+ */
+uint32_t GetAggregateResponseTimeout(uint32_t timeoutMs);
+
+/**
+ * Delay the response to a request, such as a multicast discovery request answered after a
+ * random leisure. The encoded response payload of the request is copied, and the response is
+ * sent by HandleDelayedResponses once the delay has elapsed.
+ *
+ * @param[in]  serverRequest   Server request with an encoded response payload.
+ * @param[in]  delayMs         Delay in milliseconds.
+ *
+ * @return ::OC_STACK_OK if the response is delayed, some other value if it must be sent at once.
+ */
+OCStackResult DelayServerResponse(OCServerRequest * serverRequest, uint32_t delayMs);
+
+/**
+ * Send the delayed responses whose delay has elapsed and delete their requests.
+ * Called from OCProcess.
+ */
+void HandleDelayedResponses(void);
+
+/**
+ * Get the time until HandleDelayedResponses has a response to send.
+ *
+ * @param timeoutMs Maximum time to return in milliseconds.
+ * @return the lower of timeoutMs and the time until the first delayed response.
+ */
+uint32_t GetDelayedResponseTimeout(uint32_t timeoutMs);
+
 /**
  * Form the OCEntityHandlerRequest struct that is passed to a resource's entity handler
  *
@@ -283,23 +283,20 @@ void CopyEndpointToDevAddr(const CAEndpoint_t *in, OCDevAddr *out);
 void CopyDevAddrToEndpoint(const OCDevAddr *in, CAEndpoint_t *out);
 
 /**
- * Get the CoAP ticks after the specified number of milli-seconds.
+ * Point the address of a client response at its device address and derive its connectivity
+ * type from it.
  *
- * @param milliSeconds Milli-seconds.
- * @return CoAP ticks
+ * @param cr Client response.
  */
-uint32_t GetTicks(uint32_t milliSeconds);
+void FixUpClientResponse(OCClientResponse *cr);
 
 /**
- * Extract interface and resource type from the query.
- *
- * @param query is the request received from the client
- * @param filterOne will include result if the interface is included in the query.
- * @param filterTwo will include result if the resource type is included in the query.
+ * Get the CoAP ticks after the specified number of milli-seconds.
  *
- * @return ::OC_STACK_OK on success, some other value upon failure
+ * @param milliSeconds Milli-seconds.
+ * @return CoAP ticks
  */
-OCStackResult ExtractFiltersFromQuery(const char *query, char **filterOne, char **filterTwo);
+uint32_t GetTicks(uint32_t milliSeconds);
 
 #if defined(RD_CLIENT) || defined(RD_SERVER)
 /**
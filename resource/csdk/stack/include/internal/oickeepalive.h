@@ -71,6 +71,13 @@ OCStackResult TerminateKeepAlive(OCMode mode);
  */
 void ProcessKeepAlive(void);
 
+/**
+ * Get the time until ProcessKeepAlive has a ping message to send or a connection to close.
+ * @param[in]   timeoutMs   Maximum time to return in milliseconds.
+ * @return  the lower of timeoutMs and the time until the first KeepAlive timer expires.
+ */
+uint32_t GetKeepAliveTimeout(uint32_t timeoutMs);
+
 /**
  * This API will be called from RI layer whenever there is a request for KeepAlive.
  * Virtual Resource.
@@ -136,14 +136,81 @@ OCStackResult OC_CALL OCStartMulticastServer(void);
  */
 OCStackResult OC_CALL OCStopMulticastServer(void);
 
+/**
+ * Set how multicast discovery requests are answered. By default responses are sent at once
+ * and never suppressed.
+ *
+ * @param policy    Policy, ::OC_DEFAULT_MULTICAST_LEISURE_MS is the leisure of RFC 7252.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+OCStackResult OC_CALL OCSetMulticastDiscoveryPolicy(const OCMulticastDiscoveryPolicy *policy);
+
 /**
  * This function is Called in main loop of OC client or server.
  * Allows low-level processing of stack services.
  *
+ * OCDoRequest, OCDoResource, OCCancel, OCDoResponse, OCNotifyAllObservers and
+ * OCNotifyListOfObservers may be called from other threads while OCProcess runs,
+ * and from the callbacks it calls. Other functions must not run concurrently with it.
+ *
  * @return ::OC_STACK_OK on success, some other value upon failure.
  */
 OCStackResult OC_CALL OCProcess(void);
 
+/**
+ * Get a descriptor readable while OCProcess has received messages to handle, to wait
+ * for them in the application's own event loop (poll, epoll, ...). OCProcess clears it,
+ * it must not be read from or closed. It is valid until OCStop.
+ *
+ * Timed work is not signalled on it, see OCGetProcessTimeout.
+ *
+ * @param[out] fd  Descriptor to poll for reading.
+ *
+ * @return ::OC_STACK_OK on success, ::OC_STACK_NOTIMPL if the platform has no such
+ *         descriptor, some other value upon failure.
+ */
+OCStackResult OC_CALL OCGetWakeupFd(int *fd);
+
+/**
+ * Get the time until OCProcess has timed work to do, such as presence, keepalive or
+ * aggregate response timeouts.
+ *
+ * @param maxTimeoutMs  Maximum time to return in milliseconds.
+ *
+ * @return the lower of maxTimeoutMs and the time until OCProcess has timed work to do.
+ */
+uint32_t OC_CALL OCGetProcessTimeout(uint32_t maxTimeoutMs);
+
+/**
+ * Block until OCProcess has received messages to handle, OCSignalWakeup is called or
+ * the timeout expires. Unlike other functions, it can be called while another thread
+ * calls into the stack.
+ *
+ * @param timeoutMs  Maximum time to wait in milliseconds.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+OCStackResult OC_CALL OCWaitForWork(uint32_t timeoutMs);
+
+/**
+ * Make OCWaitForWork return and the descriptor of OCGetWakeupFd readable until OCProcess
+ * is called, e.g. to stop a thread waiting in OCProcessWait. It can be called from any thread.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+OCStackResult OC_CALL OCSignalWakeup(void);
+
+/**
+ * Same as OCProcess, after waiting until it has work to do, or at most timeoutMs.
+ * Replaces calling OCProcess in a loop with a sleep between the calls.
+ *
+ * @param timeoutMs  Maximum time to wait in milliseconds.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+OCStackResult OC_CALL OCProcessWait(uint32_t timeoutMs);
+
 /**
  * This function discovers or Perform requests on a specified resource
  * (specified by that Resource's respective URI).
@@ -252,6 +319,22 @@ OCStackResult OC_CALL OCCancel(OCDoHandle handle,
                        OCHeaderOption * options,
                        uint8_t numOptions);
 
+/**
+ * This function batches the responses to a discovery request. The responses received within
+ * the window following the first one are delivered together in a single call of the callback.
+ * Their discovery payloads are chained by their next member, one per device, and responses
+ * identical to one already received are skipped without being parsed.
+ * The address of the batched response is the one of the first device that answered, the
+ * addresses of the other devices are the endpoints (eps) of the resources in their payloads.
+ *
+ * @param handle       Handle of a request sent with ::OC_REST_DISCOVER to /oic/res. Responses
+ *                     received before this call were delivered one by one.
+ * @param windowMs     Window in milliseconds, 0 to deliver each response at once.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+OCStackResult OC_CALL OCSetDiscoveryBatchWindow(OCDoHandle handle, uint32_t windowMs);
+
 /**
  * Register Persistent storage callback.
  * @param   persistentStorageHandler  Pointers to open, read, write, close & unlink handlers.
@@ -309,6 +392,20 @@ OCStackResult OC_CALL OCStopPresence(void);
 OCStackResult OC_CALL OCSetDefaultDeviceEntityHandler(OCDeviceEntityHandler entityHandler,
                                               void* callbackParameter);
 
+/**
+ * This function sets how long a batch interface request on a collection waits for the
+ * responses of its child resources.
+ *
+ * Child entity handlers returning ::OC_EH_SLOW respond independently of each other, and
+ * their responses are aggregated as they arrive. Once the timeout expires the responses
+ * received so far are sent, and those of the remaining children are dropped.
+ *
+ * @param timeoutMs    Timeout in milliseconds. 0, the default, waits for all children.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+OCStackResult OC_CALL OCSetBatchResponseTimeout(uint32_t timeoutMs);
+
 /**
  * This function sets device information.
  *
@@ -677,6 +774,46 @@ OCStackResult OC_CALL OCNotifyListOfObservers (OCResourceHandle handle,
                                        const OCRepPayload *payload,
                                        OCQualityOfService qos);
 
+/**
+ * Set the policy limiting the notifications to the observers of a resource. It applies to
+ * the current observers and to the ones registering later. Notifications of
+ * ::OCNotifyAllObservers and ::OCNotifyListOfObservers kept by the policy are sent from
+ * ::OCProcess.
+ *
+ * @param handle                    Handle of resource.
+ * @param policy                    Notification policy, zeroed to send all notifications.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+OCStackResult OC_CALL OCSetObserveNotificationPolicy(OCResourceHandle handle,
+                                                     const OCObserveNotificationPolicy *policy);
+
+/**
+ * Set the policy limiting the notifications to one observer of a resource, replacing the
+ * one set with ::OCSetObserveNotificationPolicy until it is called again.
+ *
+ * @param handle                    Handle of resource.
+ * @param observationId             Observation ID of the observer.
+ * @param policy                    Notification policy, zeroed to send all notifications.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+OCStackResult OC_CALL OCSetObserverNotificationPolicy(OCResourceHandle handle,
+                                                      OCObservationId observationId,
+                                                      const OCObserveNotificationPolicy *policy);
+
+/**
+ * Get the counters of notifications sent, coalesced and dropped for the observers of a
+ * resource.
+ *
+ * @param handle                    Handle of resource.
+ * @param stats                     Counters to fill.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+OCStackResult OC_CALL OCGetObserveNotificationStats(OCResourceHandle handle,
+                                                    OCObserveNotificationStats *stats);
+
 /**
  * This function sends a response to a request.
  * The response can be a normal, slow, or block (i.e. a response that
@@ -178,7 +178,8 @@ static uint8_t GetNumOfResourcesInAtomicMeasurement(const OCResource *amResource
 //*     Handler for the linked list (oic.if.ll) interface request *
 //*                                                               *
 //*****************************************************************
-static OCStackResult HandleLinkedListInterface(OCEntityHandlerRequest *ehRequest, char *ifQueryParam)
+static OCStackResult HandleLinkedListInterface(OCEntityHandlerRequest *ehRequest,
+                                               const char *ifQueryParam)
 {
     if (!ehRequest)
     {
@@ -367,9 +368,12 @@ OCStackResult DefaultAtomicMeasurementEntityHandler(OCEntityHandlerFlag flag, OC
 
     OIC_LOG_V(INFO, TAG, "DefaultAtomicMeasurementEntityHandler with query %s", ehRequest->query);
 
-    char *ifQueryParam = NULL;
-    char *rtQueryParam = NULL;
-    OCStackResult result = ExtractFiltersFromQuery(ehRequest->query, &ifQueryParam, &rtQueryParam);
+    OCServerRequest *request = (OCServerRequest *)ehRequest->requestHandle;
+    const char *ifQueryParam = NULL;
+    const char *rtQueryParam = NULL;
+    OCStackResult result = request
+        ? OCGetQueryFilters(&request->parsedQuery, &ifQueryParam, &rtQueryParam)
+        : OC_STACK_INVALID_PARAM;
     if (result != OC_STACK_OK)
     {
         return OC_STACK_NO_RESOURCE;
@@ -392,11 +396,9 @@ OCStackResult DefaultAtomicMeasurementEntityHandler(OCEntityHandlerFlag flag, OC
     // Default interface for atomic measurement is batch
     if (!ifQueryParam)
     {
-        ifQueryParam = OICStrdup(OC_RSRVD_INTERFACE_BATCH);
+        ifQueryParam = OC_RSRVD_INTERFACE_BATCH;
     }
 
-    VERIFY_PARAM_NON_NULL(TAG, ifQueryParam, "Invalid Parameter ifQueryParam");
-
     if (0 == strcmp(ifQueryParam, OC_RSRVD_INTERFACE_LL) || 0 == strcmp (ifQueryParam, OC_RSRVD_INTERFACE_DEFAULT))
     {
         if (ehRequest->method == OC_REST_PUT || ehRequest->method == OC_REST_POST)
@@ -416,7 +418,6 @@ OCStackResult DefaultAtomicMeasurementEntityHandler(OCEntityHandlerFlag flag, OC
         }
         else
         {
-            OCServerRequest *request = (OCServerRequest *)ehRequest->requestHandle;
             if (request)
             {
                 request->numResponses = GetNumOfResourcesInAtomicMeasurement((OCResource *)ehRequest->resource);
@@ -433,8 +434,6 @@ exit:
             result = OC_STACK_INVALID_QUERY;
         result = SendResponse(NULL, ehRequest, OCStackCodeToEntityHandlerCode(result));
     }
-    OICFree(ifQueryParam);
-    OICFree(rtQueryParam);
     return result;
 }
 
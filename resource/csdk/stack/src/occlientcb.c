@@ -24,6 +24,10 @@
 #include "experimental/logger.h"
 #include "trace.h"
 #include "oic_malloc.h"
+#include "oic_time.h"
+#include "ocpayload.h"
+#include "ocstackinternal.h"
+#include "uhashmap.h"
 #include <string.h>
 
 #ifdef HAVE_SYS_TIME_H
@@ -74,6 +78,16 @@ static void DeleteClientCBInternal(ClientCB * cbNode)
     {
         OICFree(cbNode->payload);
     }
+    if (cbNode->batchResponse)
+    {
+        OCPayloadDestroy(cbNode->batchResponse->payload);
+        OICFree(cbNode->batchResponse);
+    }
+    for (size_t i = 0; i < cbNode->receivedCount; i++)
+    {
+        OICFree(cbNode->receivedResponses[i].payload);
+    }
+    OICFree(cbNode->receivedResponses);
 #ifdef WITH_PRESENCE
     if (cbNode->presence)
     {
@@ -401,6 +415,101 @@ ClientCB* GetClientCBUsingHandle(const OCDoHandle handle)
     return NULL;
 }
 
+bool CheckDiscoveryResponseReceived(ClientCB *cbNode, const uint8_t *payload,
+                                    size_t payloadSize)
+{
+    assert(cbNode);
+
+    uint32_t hash = u_hashmap_hash(U_HASHMAP_HASH_INIT, payload, payloadSize);
+    for (size_t i = 0; i < cbNode->receivedCount; i++)
+    {
+        const ReceivedDiscoveryResponse *received = &cbNode->receivedResponses[i];
+        if (received->hash == hash && received->payloadSize == payloadSize &&
+            0 == memcmp(received->payload, payload, payloadSize))
+        {
+            return true;
+        }
+    }
+
+    // Not remembered on failure, a repeated response is parsed again.
+    if (cbNode->receivedCount == cbNode->receivedCapacity)
+    {
+        size_t capacity = cbNode->receivedCapacity ? cbNode->receivedCapacity * 2 : 8;
+        ReceivedDiscoveryResponse *responses = (ReceivedDiscoveryResponse *)OICRealloc(
+            cbNode->receivedResponses, capacity * sizeof(*responses));
+        if (!responses)
+        {
+            OIC_LOG(ERROR, TAG, "Failed allocating received discovery responses");
+            return false;
+        }
+        cbNode->receivedResponses = responses;
+        cbNode->receivedCapacity = capacity;
+    }
+
+    uint8_t *copy = (uint8_t *)OICMalloc(payloadSize ? payloadSize : 1);
+    if (!copy)
+    {
+        OIC_LOG(ERROR, TAG, "Failed copying received discovery response");
+        return false;
+    }
+    memcpy(copy, payload, payloadSize);
+
+    ReceivedDiscoveryResponse *received = &cbNode->receivedResponses[cbNode->receivedCount++];
+    received->hash = hash;
+    received->payload = copy;
+    received->payloadSize = payloadSize;
+    return false;
+}
+
+OCStackResult AddDiscoveryBatchResponse(ClientCB *cbNode, OCClientResponse *response)
+{
+    assert(cbNode);
+    assert(response);
+
+    OCDiscoveryPayload *payload = (OCDiscoveryPayload *)response->payload;
+    if (!payload || PAYLOAD_TYPE_DISCOVERY != payload->base.type)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+
+    if (!cbNode->batchResponse)
+    {
+        OCClientResponse *batchResponse = (OCClientResponse *)OICMalloc(sizeof(*batchResponse));
+        if (!batchResponse)
+        {
+            OIC_LOG(ERROR, TAG, "Failed allocating batched discovery response");
+            return OC_STACK_NO_MEMORY;
+        }
+        *batchResponse = *response;
+        FixUpClientResponse(batchResponse);
+        batchResponse->resourceUri = cbNode->requestUri;
+        cbNode->batchResponse = batchResponse;
+        cbNode->batchDeadline = OICGetCurrentTime(TIME_IN_MS) + cbNode->batchWindowMs;
+        response->payload = NULL;
+        return OC_STACK_OK;
+    }
+
+    OCDiscoveryPayload *last = (OCDiscoveryPayload *)cbNode->batchResponse->payload;
+    for (;;)
+    {
+        if (payload->sid && last->sid && 0 == strcmp(payload->sid, last->sid))
+        {
+            OIC_LOG_V(INFO, TAG, "Dropping another discovery response of %s", payload->sid);
+            OCDiscoveryPayloadDestroy(payload);
+            response->payload = NULL;
+            return OC_STACK_OK;
+        }
+        if (!last->next)
+        {
+            break;
+        }
+        last = last->next;
+    }
+    last->next = payload;
+    response->payload = NULL;
+    return OC_STACK_OK;
+}
+
 #ifdef WITH_PRESENCE
 ClientCB* GetClientCBUsingUri(const char *requestUri)
 {
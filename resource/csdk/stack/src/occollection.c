@@ -37,6 +37,15 @@
 #include "cainterface.h"
 #define TAG "OIC_RI_COLLECTION"
 
+/** Time in milliseconds a batch request waits for its children, 0 to wait for all. */
+static uint32_t g_batchResponseTimeout = 0;
+
+OCStackResult OC_CALL OCSetBatchResponseTimeout(uint32_t timeoutMs)
+{
+    g_batchResponseTimeout = timeoutMs;
+    return OC_STACK_OK;
+}
+
 static bool AddRTSBaselinePayload(const OCResource* collResource, OCRepPayload **colPayload)
 {
     size_t arraySize = 0;
@@ -109,7 +118,8 @@ uint8_t GetNumOfResourcesInCollection(const OCResource *collResource)
     return size;
 }
 
-static OCStackResult HandleLinkedListInterface(OCEntityHandlerRequest *ehRequest, char *ifQueryParam)
+static OCStackResult HandleLinkedListInterface(OCEntityHandlerRequest *ehRequest,
+                                               const char *ifQueryParam)
 {
     if (!ehRequest)
     {
@@ -280,9 +290,12 @@ OCStackResult DefaultCollectionEntityHandler(OCEntityHandlerFlag flag, OCEntityH
     }
     OIC_LOG_V(INFO, TAG, "DefaultCollectionEntityHandler with query %s", ehRequest->query);
 
-    char *ifQueryParam = NULL;
-    char *rtQueryParam = NULL;
-    OCStackResult result = ExtractFiltersFromQuery(ehRequest->query, &ifQueryParam, &rtQueryParam);
+    OCServerRequest *request = (OCServerRequest *)ehRequest->requestHandle;
+    const char *ifQueryParam = NULL;
+    const char *rtQueryParam = NULL;
+    OCStackResult result = request
+        ? OCGetQueryFilters(&request->parsedQuery, &ifQueryParam, &rtQueryParam)
+        : OC_STACK_INVALID_PARAM;
     if (result != OC_STACK_OK)
     {
         result = OC_STACK_NO_RESOURCE;
@@ -290,11 +303,9 @@ OCStackResult DefaultCollectionEntityHandler(OCEntityHandlerFlag flag, OCEntityH
     }
     if (!ifQueryParam)
     {
-        ifQueryParam = OICStrdup(OC_RSRVD_INTERFACE_LL);
+        ifQueryParam = OC_RSRVD_INTERFACE_LL;
     }
 
-    VERIFY_PARAM_NON_NULL(TAG, ifQueryParam, "Invalid Parameter ifQueryParam");
-
     if (0 == strcmp(ifQueryParam, OC_RSRVD_INTERFACE_LL) || 0 == strcmp (ifQueryParam, OC_RSRVD_INTERFACE_DEFAULT))
     {
         if (ehRequest->method == OC_REST_PUT || ehRequest->method == OC_REST_POST)
@@ -308,11 +319,11 @@ OCStackResult DefaultCollectionEntityHandler(OCEntityHandlerFlag flag, OCEntityH
     }
     else if (0 == strcmp(ifQueryParam, OC_RSRVD_INTERFACE_BATCH))
     {
-        OCServerRequest *request = (OCServerRequest *)ehRequest->requestHandle;
         if (request)
         {
             request->numResponses = GetNumOfResourcesInCollection((OCResource *)ehRequest->resource);
             request->ehResponseHandler = HandleAggregateResponse;
+            SetAggregateResponseDeadline(request, g_batchResponseTimeout);
             result = HandleBatchInterface(ehRequest);
         }
     }
@@ -327,8 +338,6 @@ exit:
     {
         result = SendResponse(NULL, ehRequest, OC_EH_BAD_REQ);
     }
-    OICFree(ifQueryParam);
-    OICFree(rtQueryParam);
     return result;
 }
 
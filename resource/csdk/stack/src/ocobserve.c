@@ -27,6 +27,7 @@
 #include "experimental/ocrandom.h"
 #include "oic_malloc.h"
 #include "oic_string.h"
+#include "oic_time.h"
 #include "ocpayload.h"
 #include "ocserverrequest.h"
 #include "experimental/logger.h"
@@ -42,6 +43,11 @@
 
 #define VERIFY_NON_NULL(arg) { if (!arg) {OIC_LOG(FATAL, TAG, #arg " is NULL"); goto exit;} }
 
+extern OCResource *headResource;
+
+/** Number of observers with a notification kept by their policy. */
+static uint32_t g_pendingNotificationCount = 0;
+
 /**
  * Determine observe QOS based on the QOS of the request.
  * The qos passed as a parameter overrides what the client requested.
@@ -137,6 +143,193 @@ static OCStackResult SendObserveNotification(ResourceObserver *observer,
     return result;
 }
 
+/**
+ * Send a notification with the payload given to OCNotifyListOfObservers.
+ *
+ * @param observer Observer that need to be notified.
+ * @param sequenceNum Sequence number of the notification.
+ * @param payload Payload of the notification.
+ * @param qos Quality of service of the notification.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+static OCStackResult SendObservePayload(ResourceObserver *observer,
+                                        uint32_t sequenceNum,
+                                        const OCRepPayload *payload,
+                                        OCQualityOfService qos)
+{
+    OCServerRequest * request = NULL;
+    OCStackResult result = AddServerRequest(&request, 0, 0, 1, OC_REST_GET,
+            0, sequenceNum, qos, observer->query,
+            NULL, OC_FORMAT_UNDEFINED, NULL, observer->token, observer->tokenLength,
+            observer->resUri, 0, observer->acceptFormat,
+            observer->acceptVersion, &observer->devAddr);
+    if (!request)
+    {
+        return result;
+    }
+    request->observeResult = OC_STACK_OK;
+    if (result != OC_STACK_OK)
+    {
+        DeleteServerRequest(request);
+        return result;
+    }
+
+    OCEntityHandlerResponse ehResponse = {0};
+    ehResponse.ehResult = OC_EH_OK;
+    ehResponse.payload = (OCPayload*)OCRepPayloadCreate();
+    if (!ehResponse.payload)
+    {
+        DeleteServerRequest(request);
+        return OC_STACK_NO_MEMORY;
+    }
+    memcpy(ehResponse.payload, payload, sizeof(*payload));
+    ehResponse.persistentBufferFlag = 0;
+    ehResponse.requestHandle = (OCRequestHandle) request;
+    result = OCDoResponse(&ehResponse);
+
+    // The copy shares its values with the payload of the application.
+    OICFree(ehResponse.payload);
+
+    // Reset Observer TTL.
+    observer->TTL = GetTicks(MAX_OBSERVER_TTL_SECONDS * MILLISECONDS_PER_SECOND);
+    return result;
+}
+
+/**
+ * Check whether the policy of an observer allows a notification now.
+ *
+ * @param observer Observer to notify.
+ *
+ * @return true if the notification may be sent.
+ */
+static bool IsObserveNotificationAllowed(const ResourceObserver *observer)
+{
+    const OCObserveNotificationPolicy *policy = &observer->policy;
+    if (policy->maxPendingCon && observer->pendingConCount >= policy->maxPendingCon)
+    {
+        return false;
+    }
+    return !policy->minIntervalMs || !observer->lastNotificationTime ||
+           OICGetCurrentTime(TIME_IN_MS) - observer->lastNotificationTime >= policy->minIntervalMs;
+}
+
+/**
+ * Forget the notification kept for an observer.
+ *
+ * @param observer Observer of the notification.
+ */
+static void ClearPendingNotification(ResourceObserver *observer)
+{
+    if (observer->notificationPending)
+    {
+        observer->notificationPending = false;
+        g_pendingNotificationCount--;
+    }
+    OCRepPayloadDestroy(observer->pendingPayload);
+    observer->pendingPayload = NULL;
+}
+
+/**
+ * Keep a notification the policy of an observer does not allow yet, replacing the one
+ * already kept, or drop it if the policy does not coalesce.
+ *
+ * @param resource Observed resource.
+ * @param observer Observer to notify.
+ * @param payload Payload given to OCNotifyListOfObservers, NULL to get it from the entity
+ *                handler when the notification is sent.
+ * @param qos Quality of service of the notification.
+ */
+static void KeepObserveNotification(OCResource *resource, ResourceObserver *observer,
+                                    const OCRepPayload *payload, OCQualityOfService qos)
+{
+    OCRepPayload *pendingPayload = NULL;
+    if (observer->policy.coalesce && payload)
+    {
+        pendingPayload = OCRepPayloadClone(payload);
+        if (!pendingPayload)
+        {
+            OIC_LOG(ERROR, TAG, "Failed to copy the notification payload");
+        }
+    }
+    if (!observer->policy.coalesce || (payload && !pendingPayload))
+    {
+        OIC_LOG_V(DEBUG, TAG, "Notification to observer id %u dropped", observer->observeId);
+        resource->observeStats.dropped++;
+        return;
+    }
+
+    bool armed = true;
+    if (observer->notificationPending)
+    {
+        OIC_LOG_V(DEBUG, TAG, "Notification to observer id %u replaced", observer->observeId);
+        resource->observeStats.coalesced++;
+        // The replacing notification keeps the high QoS of the replaced one.
+        if (OC_HIGH_QOS == observer->pendingQos)
+        {
+            qos = OC_HIGH_QOS;
+        }
+        ClearPendingNotification(observer);
+        armed = false;
+    }
+    observer->notificationPending = true;
+    observer->pendingQos = qos;
+    observer->pendingPayload = pendingPayload;
+    g_pendingNotificationCount++;
+
+    if (armed)
+    {
+        // Called from application threads, the process loop may be waiting for a timeout
+        // computed before this notification was kept.
+        OCSignalWakeup();
+    }
+}
+
+/**
+ * Send a notification to an observer and account for it in its policy.
+ *
+ * @param resource Observed resource.
+ * @param observer Observer to notify.
+ * @param method RESTful method.
+ * @param payload Payload given to OCNotifyListOfObservers, NULL to get it from the entity
+ *                handler.
+ * @param qos Quality of service of the notification.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+static OCStackResult NotifyObserver(OCResource *resource, ResourceObserver *observer,
+                                    OCMethod method, const OCRepPayload *payload,
+                                    OCQualityOfService qos)
+{
+    if (observer->notificationPending)
+    {
+        // The notification kept for the observer is outdated by this one.
+        resource->observeStats.coalesced++;
+        ClearPendingNotification(observer);
+    }
+
+    qos = DetermineObserverQoS(method, observer, qos);
+    OCStackResult result = payload ?
+            SendObservePayload(observer, resource->sequenceNum, payload, qos) :
+            SendObserveNotification(observer, resource->sequenceNum, qos);
+    if (result != OC_STACK_OK)
+    {
+        return result;
+    }
+
+    resource->observeStats.sent++;
+    if (observer->policy.minIntervalMs)
+    {
+        observer->lastNotificationTime = OICGetCurrentTime(TIME_IN_MS);
+    }
+    if (observer->policy.maxPendingCon && OC_HIGH_QOS == qos
+            && observer->pendingConCount < UINT8_MAX)
+    {
+        observer->pendingConCount++;
+    }
+    return result;
+}
+
 #ifdef WITH_PRESENCE
 OCStackResult SendAllObserverNotification (OCMethod method, OCResource *resPtr, uint32_t maxAge,
         OCPresenceTrigger trigger, OCResourceType *resourceType, OCQualityOfService qos)
@@ -168,8 +361,15 @@ OCStackResult SendAllObserverNotification (OCMethod method, OCResource *resPtr,
         if (method != OC_REST_PRESENCE)
         {
 #endif
-            qos = DetermineObserverQoS(method, resourceObserver, qos);
-            result = SendObserveNotification(resourceObserver, resPtr->sequenceNum, qos);
+            if (IsObserveNotificationAllowed(resourceObserver))
+            {
+                result = NotifyObserver(resPtr, resourceObserver, method, NULL, qos);
+            }
+            else
+            {
+                KeepObserveNotification(resPtr, resourceObserver, NULL, qos);
+                result = OC_STACK_OK;
+            }
 #ifdef WITH_PRESENCE
         }
         else
@@ -249,7 +449,6 @@ OCStackResult SendListObserverNotification (OCResource * resource,
     uint8_t numIds = numberOfIds;
     ResourceObserver *observer = NULL;
     uint8_t numSentNotification = 0;
-    OCServerRequest * request = NULL;
     OCStackResult result = OC_STACK_ERROR;
     bool observeErrorFlag = false;
 
@@ -259,52 +458,25 @@ OCStackResult SendListObserverNotification (OCResource * resource,
         observer = GetObserverUsingId (resource, *obsIdList);
         if (observer)
         {
-            qos = DetermineObserverQoS(OC_REST_GET, observer, qos);
-
-            result = AddServerRequest(&request, 0, 0, 1, OC_REST_GET,
-                    0, resource->sequenceNum, qos, observer->query,
-                    NULL, OC_FORMAT_UNDEFINED, NULL, observer->token, observer->tokenLength,
-                    observer->resUri, 0, observer->acceptFormat,
-                    observer->acceptVersion, &observer->devAddr);
+            if (IsObserveNotificationAllowed(observer))
+            {
+                result = NotifyObserver(resource, observer, OC_REST_GET, payload, qos);
+            }
+            else
+            {
+                // Kept or dropped by the policy of the observer, which is not an error.
+                KeepObserveNotification(resource, observer, payload, qos);
+                result = OC_STACK_OK;
+            }
 
-            if (request)
+            if (result == OC_STACK_OK)
             {
-                request->observeResult = OC_STACK_OK;
-                if (result == OC_STACK_OK)
-                {
-                    OCEntityHandlerResponse ehResponse = {0};
-                    ehResponse.ehResult = OC_EH_OK;
-                    ehResponse.payload = (OCPayload*)OCRepPayloadCreate();
-                    if (!ehResponse.payload)
-                    {
-                        DeleteServerRequest(request);
-                        continue;
-                    }
-                    memcpy(ehResponse.payload, payload, sizeof(*payload));
-                    ehResponse.persistentBufferFlag = 0;
-                    ehResponse.requestHandle = (OCRequestHandle) request;
-                    result = OCDoResponse(&ehResponse);
-                    if (result == OC_STACK_OK)
-                    {
-                        OIC_LOG_V(INFO, TAG, "Observer id %d notified.", *obsIdList);
-
-                        // Increment only if OCDoResponse is successful
-                        numSentNotification++;
-
-                        OICFree(ehResponse.payload);
-                    }
-                    else
-                    {
-                        OIC_LOG_V(INFO, TAG, "Error notifying observer id %d.", *obsIdList);
-                    }
-                    // Reset Observer TTL.
-                    observer->TTL =
-                            GetTicks(MAX_OBSERVER_TTL_SECONDS * MILLISECONDS_PER_SECOND);
-                }
-                else
-                {
-                    DeleteServerRequest(request);
-                }
+                OIC_LOG_V(INFO, TAG, "Observer id %d notified.", *obsIdList);
+                numSentNotification++;
+            }
+            else
+            {
+                OIC_LOG_V(INFO, TAG, "Error notifying observer id %d.", *obsIdList);
             }
             // Since we are in a loop, set an error flag to indicate
             // at least one error occurred.
@@ -385,6 +557,7 @@ OCStackResult AddObserver (const char         *resUri,
         VERIFY_NON_NULL (obsNode->resUri);
 
         obsNode->qos = qos;
+        obsNode->policy = resHandle->observePolicy;
         obsNode->acceptFormat = acceptFormat;
         obsNode->acceptVersion = acceptVersion;
         if (query)
@@ -518,6 +691,11 @@ OCStackResult DeleteObserverUsingToken (OCResource *resource,
         OIC_LOG_V(INFO, TAG, "deleting observer id  %u with token", obsNode->observeId);
         OIC_LOG_BUFFER(INFO, TAG, (const uint8_t *)obsNode->token, tokenLength);
         LL_DELETE (resource->observersHead, obsNode);
+        if (obsNode->notificationPending)
+        {
+            resource->observeStats.dropped++;
+        }
+        ClearPendingNotification(obsNode);
         OICFree(obsNode->resUri);
         OICFree(obsNode->query);
         OICFree(obsNode->token);
@@ -528,6 +706,89 @@ OCStackResult DeleteObserverUsingToken (OCResource *resource,
     return OC_STACK_OK;
 }
 
+void CompleteObserveNotification(ResourceObserver *observer)
+{
+    if (observer && observer->pendingConCount)
+    {
+        observer->pendingConCount--;
+    }
+}
+
+void ProcessObserverNotifications(void)
+{
+    OCResource *resource = NULL;
+    LL_FOREACH(headResource, resource)
+    {
+        ResourceObserver *observer = NULL;
+        ResourceObserver *tmp = NULL;
+        LL_FOREACH_SAFE(resource->observersHead, observer, tmp)
+        {
+            if (!g_pendingNotificationCount)
+            {
+                return;
+            }
+            if (!observer->notificationPending || !IsObserveNotificationAllowed(observer))
+            {
+                continue;
+            }
+
+            OCQualityOfService qos = observer->pendingQos;
+            OCRepPayload *payload = observer->pendingPayload;
+            observer->pendingPayload = NULL;
+            ClearPendingNotification(observer);
+
+            OIC_LOG_V(DEBUG, TAG, "Sending kept notification to observer id %u",
+                      observer->observeId);
+            if (OC_STACK_OK != NotifyObserver(resource, observer, OC_REST_OBSERVE, payload, qos))
+            {
+                OIC_LOG(ERROR, TAG, "Error sending kept notification");
+                resource->observeStats.dropped++;
+            }
+            OCRepPayloadDestroy(payload);
+        }
+    }
+}
+
+uint32_t GetObserverNotificationTimeout(uint32_t timeoutMs)
+{
+    if (!g_pendingNotificationCount)
+    {
+        return timeoutMs;
+    }
+
+    uint64_t now = OICGetCurrentTime(TIME_IN_MS);
+    OCResource *resource = NULL;
+    LL_FOREACH(headResource, resource)
+    {
+        ResourceObserver *observer = NULL;
+        LL_FOREACH(resource->observersHead, observer)
+        {
+            if (!timeoutMs)
+            {
+                return 0;
+            }
+            const OCObserveNotificationPolicy *policy = &observer->policy;
+            // Waiting for an acknowledgement, whose reception wakes up the stack.
+            if (!observer->notificationPending ||
+                (policy->maxPendingCon && observer->pendingConCount >= policy->maxPendingCon))
+            {
+                continue;
+            }
+
+            uint64_t allowedTime = observer->lastNotificationTime + policy->minIntervalMs;
+            if (allowedTime <= now)
+            {
+                timeoutMs = 0;
+            }
+            else if (allowedTime - now < timeoutMs)
+            {
+                timeoutMs = (uint32_t)(allowedTime - now);
+            }
+        }
+    }
+    return timeoutMs;
+}
+
 void DeleteObserverList(OCResource *resource)
 {
     ResourceObserver *out = NULL;
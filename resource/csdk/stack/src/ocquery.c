@@ -0,0 +1,161 @@
+/* ****************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include "iotivity_config.h"
+#ifdef HAVE_STRING_H
+#include <string.h>
+#endif
+#ifdef HAVE_STRINGS_H
+#include <strings.h>
+#endif
+
+#include "ocquery.h"
+#include "platform_features.h"
+#include "experimental/logger.h"
+
+#define TAG "OIC_RI_QUERY"
+
+const char *OCGetUriQuery(const char *uri, size_t *pathLength)
+{
+    if (pathLength)
+    {
+        *pathLength = 0;
+    }
+    if (!uri || !pathLength)
+    {
+        return NULL;
+    }
+
+    const char *delimiter = strchr(uri, '?');
+    if (!delimiter)
+    {
+        *pathLength = strlen(uri);
+        return NULL;
+    }
+
+    *pathLength = (size_t)(delimiter - uri);
+    return ('\0' != delimiter[1]) ? delimiter + 1 : NULL;
+}
+
+OCStackResult OCParseQuery(const char *query, OCParsedQuery *parsed)
+{
+    if (!parsed)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+
+    parsed->buffer[0] = '\0';
+    parsed->numParams = 0;
+    parsed->truncated = false;
+    if (!query)
+    {
+        return OC_STACK_OK;
+    }
+
+    size_t length = strnlen(query, MAX_QUERY_LENGTH);
+    if (length >= MAX_QUERY_LENGTH)
+    {
+        OIC_LOG(ERROR, TAG, "Query exceeds maximum length.");
+        parsed->truncated = true;
+        return OC_STACK_INVALID_QUERY;
+    }
+    memcpy(parsed->buffer, query, length + 1);
+
+    char *pair = parsed->buffer;
+    while ('\0' != *pair)
+    {
+        size_t pairLength = strcspn(pair, OC_QUERY_SEPARATOR);
+        char *next = pair + pairLength;
+        if ('\0' != *next)
+        {
+            *next++ = '\0';
+        }
+
+        if (pairLength)
+        {
+            if (parsed->numParams >= OC_MAX_QUERY_PARAMS)
+            {
+                OIC_LOG(ERROR, TAG, "Too many query params.");
+                parsed->truncated = true;
+                return OC_STACK_INVALID_QUERY;
+            }
+
+            OCQueryParam *param = &parsed->params[parsed->numParams++];
+            param->key = pair;
+            char *delimiter = strpbrk(pair, OC_KEY_VALUE_DELIMITER);
+            if (delimiter)
+            {
+                *delimiter = '\0';
+                param->value = delimiter + 1;
+            }
+            else
+            {
+                param->value = pair + pairLength;
+            }
+        }
+        pair = next;
+    }
+    return OC_STACK_OK;
+}
+
+OCStackResult OCGetQueryFilters(const OCParsedQuery *parsed,
+                                const char **interfaceFilter,
+                                const char **resourceTypeFilter)
+{
+    if (!parsed || !interfaceFilter || !resourceTypeFilter)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+
+    *interfaceFilter = NULL;
+    *resourceTypeFilter = NULL;
+
+    if (parsed->truncated || parsed->numParams > 2)
+    {
+        OIC_LOG(ERROR, TAG, "More than 2 queries params in URI.");
+        return OC_STACK_INVALID_QUERY;
+    }
+
+    for (uint8_t i = 0; i < parsed->numParams; i++)
+    {
+        const OCQueryParam *param = &parsed->params[i];
+        if (0 == strncasecmp(param->key, OC_RSRVD_INTERFACE, sizeof(OC_RSRVD_INTERFACE) - 1))
+        {
+            *interfaceFilter = param->value;
+        }
+        else if (0 == strncasecmp(param->key, OC_RSRVD_RESOURCE_TYPE,
+                                  sizeof(OC_RSRVD_RESOURCE_TYPE) - 1))
+        {
+            *resourceTypeFilter = param->value;
+        }
+        else
+        {
+            OIC_LOG_V(ERROR, TAG, "Unsupported query key: %s", param->key);
+            *interfaceFilter = NULL;
+            *resourceTypeFilter = NULL;
+            return OC_STACK_INVALID_QUERY;
+        }
+    }
+
+    OIC_LOG_V(INFO, TAG, "Extracted params if: %s and rt: %s.",
+              *interfaceFilter ? *interfaceFilter : "(null)",
+              *resourceTypeFilter ? *resourceTypeFilter : "(null)");
+    return OC_STACK_OK;
+}
@@ -38,6 +38,7 @@
 #endif
 
 #include <coap/coap.h>
+#include <coap/utlist.h>
 
 #include "ocresource.h"
 #include "ocresourcehandler.h"
@@ -60,6 +61,10 @@
 #include "oickeepalive.h"
 #include "ocpayloadcbor.h"
 #include "psinterface.h"
+#include "experimental/ocrandom.h"
+#include "oic_time.h"
+#include "uhashmap.h"
+#include "ocatomic.h"
 
 #ifdef ROUTING_GATEWAY
 #include "routingmanager.h"
@@ -88,9 +93,100 @@ static const uint16_t CBOR_SIZE = 512;
  */
 static const uint16_t CBOR_MAX_SIZE = 4400;
 
+/**
+ * Maximum number of cached discovery responses, the least recently used one is evicted.
+ */
+#define DISCOVERY_CACHE_SIZE (16)
+
+/**
+ * Maximum number of clients whose last multicast discovery response is remembered for
+ * suppression.
+ */
+#define DISCOVERY_SUPPRESSION_SIZE (256)
+
 extern OCResource *headResource;
 extern bool g_multicastServerStopped;
 
+/**
+ * Encoded discovery response, cached for the queries and the kind of endpoint it was built for.
+ */
+typedef struct DiscoveryCacheEntry
+{
+    /** Virtual resource the request was for.*/
+    OCVirtualResources uri;
+
+    /** Interface query of the request, NULL if none.*/
+    char *interfaceQuery;
+
+    /** Resource type query of the request, NULL if none.*/
+    char *resourceTypeQuery;
+
+    /** Format and version the payload is encoded in.*/
+    OCPayloadFormat acceptFormat;
+    uint16_t acceptVersion;
+
+    /** Adapter, secure flag and IP families of the requester, which select the endpoints.*/
+    OCTransportAdapter adapter;
+    OCTransportFlags flags;
+
+    /** ::OC_STACK_OK, or ::OC_STACK_NO_RESOURCE if no resource matched the queries.*/
+    OCStackResult result;
+
+    /** Encoded payload, NULL if no resource matched the queries.*/
+    uint8_t *payload;
+    size_t payloadSize;
+
+    /** Hash of the encoded payload, which tells identical responses apart for suppression.*/
+    uint32_t payloadHash;
+
+    struct DiscoveryCacheEntry *prev;
+    struct DiscoveryCacheEntry *next;
+} DiscoveryCacheEntry;
+
+/**
+ * Cached discovery responses, most recently used first.
+ */
+static DiscoveryCacheEntry *g_discoveryCache = NULL;
+static size_t g_discoveryCacheCount = 0;
+
+/**
+ * Incremented by InvalidateDiscoveryCache(), the cache is dropped at the next lookup when it
+ * differs from the generation the cached responses were built at. Resource APIs may invalidate
+ * from any thread, so the counter is only accessed atomically.
+ */
+static volatile int32_t g_discoveryCacheGeneration = 0;
+static int32_t g_discoveryCacheBuiltGeneration = 0;
+
+/**
+ * Network interfaces and device id the cached responses were built with.
+ */
+static CAEndpoint_t *g_discoveryCacheNetworkInfo = NULL;
+static size_t g_discoveryCacheInfoSize = 0;
+static char g_discoveryCacheDeviceId[UUID_STRING_SIZE] = { 0 };
+
+/**
+ * Last multicast discovery response sent to a client.
+ */
+typedef struct DiscoverySuppression
+{
+    /** Address of the client.*/
+    OCTransportAdapter adapter;
+    char addr[MAX_ADDR_STR_SIZE];
+    uint16_t port;
+
+    /** Hash of the encoded response and time in milliseconds it was sent at.*/
+    uint32_t payloadHash;
+    uint64_t sentTime;
+
+    u_hashmap_entry_t entry;
+} DiscoverySuppression;
+
+/**
+ * Multicast discovery responses sent by client address, see OCSetMulticastDiscoveryPolicy().
+ */
+static u_hashmap_t *g_discoverySuppressions = NULL;
+static OCMulticastDiscoveryPolicy g_multicastDiscoveryPolicy = { 0, 0 };
+
 /**
  * Prepares a Payload for response.
  */
@@ -171,114 +267,6 @@ OCStackResult GetTCPPortInfo(OCDevAddr *endpoint, uint16_t *port, bool secured)
 }
 #endif
 
-/*
- * Function will extract 0, 1 or 2 filters from query.
- * More than 2 filters or unsupported filters will result in error.
- * If both filters are of the same supported type, the 2nd one will be picked.
- * Resource and device filters in the SAME query are NOT validated
- * and resources will likely not clear filters.
- */
-OCStackResult ExtractFiltersFromQuery(const char *query, char **filterOne, char **filterTwo)
-{
-    if (!query)
-    {
-        OIC_LOG(ERROR, TAG, "Query is empty!");
-        return OC_STACK_INVALID_QUERY;
-    }
-    char *key = NULL;
-    char *value = NULL;
-    char *queryDup = NULL;
-    char *restOfQuery = NULL;
-    char *keyValuePair = NULL;
-    int numKeyValuePairsParsed = 0;
-
-    *filterOne = NULL;
-    *filterTwo = NULL;
-
-    queryDup = OICStrdup(query);
-    if (NULL == queryDup)
-    {
-        OIC_LOG(ERROR, TAG, "Creating duplicate string failed!");
-        return OC_STACK_NO_MEMORY;
-    }
-
-    OIC_LOG_V(INFO, TAG, "Extracting params from %s", queryDup);
-
-    OCStackResult eCode = OC_STACK_INVALID_QUERY;
-    if (strnlen(queryDup, MAX_QUERY_LENGTH) >= MAX_QUERY_LENGTH)
-    {
-        OIC_LOG(ERROR, TAG, "Query exceeds maximum length.");
-        goto exit;
-    }
-
-    keyValuePair = strtok_r (queryDup, OC_QUERY_SEPARATOR, &restOfQuery);
-
-    while(keyValuePair)
-    {
-        if (numKeyValuePairsParsed >= 2)
-        {
-            OIC_LOG(ERROR, TAG, "More than 2 queries params in URI.");
-            goto exit;
-        }
-
-        key = strtok_r(keyValuePair, OC_KEY_VALUE_DELIMITER, &value);
-
-        if (!key || !value)
-        {
-            goto exit;
-        }
-        else if (strncasecmp(key, OC_RSRVD_INTERFACE, sizeof(OC_RSRVD_INTERFACE) - 1) == 0)
-        {
-            *filterOne = value;     // if
-        }
-        else if (strncasecmp(key, OC_RSRVD_RESOURCE_TYPE, sizeof(OC_RSRVD_RESOURCE_TYPE) - 1) == 0)
-        {
-            *filterTwo = value;     // rt
-        }
-        else
-        {
-            OIC_LOG_V(ERROR, TAG, "Unsupported query key: %s", key);
-            goto exit;
-        }
-        ++numKeyValuePairsParsed;
-
-        keyValuePair = strtok_r(NULL, OC_QUERY_SEPARATOR, &restOfQuery);
-    }
-
-    if (*filterOne)
-    {
-        *filterOne = OICStrdup(*filterOne);
-        if (NULL == *filterOne)
-        {
-            OIC_LOG(ERROR, TAG, "Creating duplicate string failed!");
-            eCode = OC_STACK_NO_MEMORY;
-            goto exit;
-        }
-    }
-
-    if (*filterTwo)
-    {
-        *filterTwo = OICStrdup(*filterTwo);
-        if (NULL == *filterTwo)
-        {
-            OIC_LOG(ERROR, TAG, "Creating duplicate string failed!");
-            OICFree(*filterOne);
-            eCode = OC_STACK_NO_MEMORY;
-            goto exit;
-        }
-    }
-
-    OICFree(queryDup);
-    OIC_LOG_V(INFO, TAG, "Extracted params if: %s and rt: %s.", *filterOne, *filterTwo);
-    return OC_STACK_OK;
-
-exit:
-    *filterOne = NULL;
-    *filterTwo = NULL;
-    OICFree(queryDup);
-    return eCode;
-}
-
 OCVirtualResources GetTypeOfVirtualURI(const char *uriInRequest)
 {
     if (strcmp(uriInRequest, OC_RSRVD_WELL_KNOWN_URI) == 0)
@@ -335,8 +323,10 @@ OCVirtualResources GetTypeOfVirtualURI(const char *uriInRequest)
     return OC_UNKNOWN_URI;
 }
 
-static OCStackResult getQueryParamsForFiltering (OCVirtualResources uri, char *query,
-                                            char **filterOne, char **filterTwo)
+static OCStackResult getQueryParamsForFiltering (OCVirtualResources uri,
+                                                  const OCParsedQuery *query,
+                                                  const char **filterOne,
+                                                  const char **filterTwo)
 {
     if(!filterOne || !filterTwo)
     {
@@ -355,14 +345,7 @@ static OCStackResult getQueryParamsForFiltering (OCVirtualResources uri, char *q
     }
 #endif
 
-    OCStackResult result = OC_STACK_OK;
-
-    if (query && *query)
-    {
-        result = ExtractFiltersFromQuery(query, filterOne, filterTwo);
-    }
-
-    return result;
+    return OCGetQueryFilters(query, filterOne, filterTwo);
 }
 
 static OCStackResult BuildDevicePlatformPayload(const OCResource *resourcePtr, OCRepPayload** payload,
@@ -1600,7 +1583,7 @@ OCEntityHandlerResult OCStackCodeToEntityHandlerCode(OCStackResult result)
     return ehResult;
 }
 
-static bool resourceMatchesRTFilter(OCResource *resource, char *resourceTypeFilter)
+static bool resourceMatchesRTFilter(OCResource *resource, const char *resourceTypeFilter)
 {
     if (!resource)
     {
@@ -1633,7 +1616,7 @@ static bool resourceMatchesRTFilter(OCResource *resource, char *resourceTypeFilt
     return false;
 }
 
-static bool resourceMatchesIFFilter(OCResource *resource, char *interfaceFilter)
+static bool resourceMatchesIFFilter(OCResource *resource, const char *interfaceFilter)
 {
     if (!resource)
     {
@@ -1674,8 +1657,8 @@ static bool resourceMatchesIFFilter(OCResource *resource, char *interfaceFilter)
  * Function will return true if all non null AND non empty filters passed in find a match.
  */
 static bool includeThisResourceInResponse(OCResource *resource,
-                                          char *interfaceFilter,
-                                          char *resourceTypeFilter)
+                                          const char *interfaceFilter,
+                                          const char *resourceTypeFilter)
 {
     if (!resource)
     {
@@ -1817,6 +1800,7 @@ static OCStackResult discoveryPayloadCreateAndAddDeviceId(OCPayload **payload)
     return OC_STACK_OK;
 exit:
     OCPayloadDestroy(*payload);
+    *payload = NULL;
     return OC_STACK_NO_MEMORY;
 }
 
@@ -1853,6 +1837,349 @@ exit:
     return OC_STACK_NO_MEMORY;
 }
 
+static void DeleteDiscoveryCacheEntry(DiscoveryCacheEntry *entry)
+{
+    DL_DELETE(g_discoveryCache, entry);
+    g_discoveryCacheCount--;
+    OICFree(entry->interfaceQuery);
+    OICFree(entry->resourceTypeQuery);
+    OICFree(entry->payload);
+    OICFree(entry);
+}
+
+void InvalidateDiscoveryCache(void)
+{
+    oc_atomic_increment(&g_discoveryCacheGeneration);
+}
+
+static void DeleteDiscoverySuppressions(void)
+{
+    u_hashmap_entry_t *entry = NULL;
+    while (NULL != (entry = u_hashmap_next(g_discoverySuppressions, NULL)))
+    {
+        u_hashmap_remove(g_discoverySuppressions, entry);
+        OICFree(U_HASHMAP_CONTAINER(entry, DiscoverySuppression, entry));
+    }
+    u_hashmap_free(&g_discoverySuppressions);
+}
+
+void DeleteDiscoveryCache(void)
+{
+    DiscoveryCacheEntry *entry = NULL;
+    DiscoveryCacheEntry *tmp = NULL;
+    DL_FOREACH_SAFE(g_discoveryCache, entry, tmp)
+    {
+        DeleteDiscoveryCacheEntry(entry);
+    }
+    OICFree(g_discoveryCacheNetworkInfo);
+    g_discoveryCacheNetworkInfo = NULL;
+    g_discoveryCacheInfoSize = 0;
+    g_discoveryCacheDeviceId[0] = '\0';
+
+    // Responses built after a change differ from the remembered ones anyway.
+    DeleteDiscoverySuppressions();
+}
+
+void SetMulticastDiscoveryPolicy(const OCMulticastDiscoveryPolicy *policy)
+{
+    g_multicastDiscoveryPolicy = *policy;
+}
+
+static uint32_t HashDiscoveryClient(const OCDevAddr *devAddr)
+{
+    uint32_t hash = u_hashmap_hash(U_HASHMAP_HASH_INIT, devAddr->addr, strlen(devAddr->addr));
+    hash = u_hashmap_hash(hash, &devAddr->port, sizeof(devAddr->port));
+    return u_hashmap_hash(hash, &devAddr->adapter, sizeof(devAddr->adapter));
+}
+
+static bool MatchDiscoveryClient(const u_hashmap_entry_t *entry, const void *key)
+{
+    const DiscoverySuppression *suppression =
+        U_HASHMAP_CONTAINER(entry, DiscoverySuppression, entry);
+    const OCDevAddr *devAddr = (const OCDevAddr *)key;
+    return suppression->adapter == devAddr->adapter && suppression->port == devAddr->port &&
+           0 == strcmp(suppression->addr, devAddr->addr);
+}
+
+/**
+ * Drop the responses sent longer ago than the suppression interval.
+ */
+static void PurgeDiscoverySuppressions(uint64_t now)
+{
+    u_hashmap_entry_t *entry = u_hashmap_next(g_discoverySuppressions, NULL);
+    while (entry)
+    {
+        u_hashmap_entry_t *next = u_hashmap_next(g_discoverySuppressions, entry);
+        DiscoverySuppression *suppression =
+            U_HASHMAP_CONTAINER(entry, DiscoverySuppression, entry);
+        if (now - suppression->sentTime >= g_multicastDiscoveryPolicy.suppressionMs)
+        {
+            u_hashmap_remove(g_discoverySuppressions, entry);
+            OICFree(suppression);
+        }
+        entry = next;
+    }
+}
+
+/**
+ * Whether a multicast discovery response repeats the last one sent to the client within the
+ * suppression interval. Otherwise the response is remembered as the last one sent.
+ *
+ * @param devAddr       Address of the client.
+ * @param payloadHash   Hash of the encoded response.
+ *
+ * @return true if the response must not be sent.
+ */
+static bool SuppressDiscoveryResponse(const OCDevAddr *devAddr, uint32_t payloadHash)
+{
+    if (!g_multicastDiscoveryPolicy.suppressionMs)
+    {
+        return false;
+    }
+    if (!g_discoverySuppressions)
+    {
+        g_discoverySuppressions = u_hashmap_create();
+        if (!g_discoverySuppressions)
+        {
+            OIC_LOG(ERROR, TAG, "Failed creating discovery suppression map");
+            return false;
+        }
+    }
+
+    uint64_t now = OICGetCurrentTime(TIME_IN_MS);
+    uint32_t hash = HashDiscoveryClient(devAddr);
+    u_hashmap_entry_t *entry = u_hashmap_find(g_discoverySuppressions, hash, devAddr,
+                                              MatchDiscoveryClient);
+    DiscoverySuppression *suppression = NULL;
+    if (entry)
+    {
+        suppression = U_HASHMAP_CONTAINER(entry, DiscoverySuppression, entry);
+        if (suppression->payloadHash == payloadHash &&
+            now - suppression->sentTime < g_multicastDiscoveryPolicy.suppressionMs)
+        {
+            return true;
+        }
+    }
+    else
+    {
+        if (u_hashmap_length(g_discoverySuppressions) >= DISCOVERY_SUPPRESSION_SIZE)
+        {
+            PurgeDiscoverySuppressions(now);
+            if (u_hashmap_length(g_discoverySuppressions) >= DISCOVERY_SUPPRESSION_SIZE)
+            {
+                // Too many clients within the interval, their responses are not suppressed.
+                return false;
+            }
+        }
+
+        suppression = (DiscoverySuppression *)OICCalloc(1, sizeof(*suppression));
+        if (!suppression)
+        {
+            OIC_LOG(ERROR, TAG, "Failed allocating discovery suppression");
+            return false;
+        }
+        suppression->adapter = devAddr->adapter;
+        OICStrcpy(suppression->addr, sizeof(suppression->addr), devAddr->addr);
+        suppression->port = devAddr->port;
+        if (!u_hashmap_add(g_discoverySuppressions, &suppression->entry, hash))
+        {
+            OICFree(suppression);
+            return false;
+        }
+    }
+
+    suppression->payloadHash = payloadHash;
+    suppression->sentTime = now;
+    return false;
+}
+
+static bool IsSameNetworkInfo(const CAEndpoint_t *networkInfo, size_t infoSize)
+{
+    if (infoSize != g_discoveryCacheInfoSize)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < infoSize; i++)
+    {
+        const CAEndpoint_t *info = &networkInfo[i];
+        const CAEndpoint_t *cachedInfo = &g_discoveryCacheNetworkInfo[i];
+        if (info->adapter != cachedInfo->adapter || info->flags != cachedInfo->flags ||
+            info->port != cachedInfo->port || info->ifindex != cachedInfo->ifindex ||
+            0 != strcmp(info->addr, cachedInfo->addr))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Drop the cached discovery responses if the resources, the network interfaces or the device id
+ * changed since they were built.
+ *
+ * @param networkInfo   Network interfaces the responses are built with.
+ * @param infoSize      Number of network interfaces.
+ *
+ * @return true if the cache may be used, false if remembering the interfaces failed.
+ */
+static bool ValidateDiscoveryCache(const CAEndpoint_t *networkInfo, size_t infoSize)
+{
+    // Read the generation first so an invalidation made while rebuilding drops the cache again.
+    int32_t generation = oc_atomic_add(&g_discoveryCacheGeneration, 0);
+    const char *deviceId = OCGetServerInstanceIDString();
+    if (!deviceId)
+    {
+        deviceId = "";
+    }
+
+    if (g_discoveryCacheNetworkInfo &&
+        g_discoveryCacheBuiltGeneration == generation &&
+        IsSameNetworkInfo(networkInfo, infoSize) &&
+        0 == strncmp(deviceId, g_discoveryCacheDeviceId, sizeof(g_discoveryCacheDeviceId)))
+    {
+        return true;
+    }
+
+    OIC_LOG(DEBUG, TAG, "Dropping cached discovery responses");
+    DeleteDiscoveryCache();
+
+    // Keep an allocation even without interfaces, it tells the cache was validated.
+    g_discoveryCacheNetworkInfo = (CAEndpoint_t *)OICMalloc(
+        (infoSize ? infoSize : 1) * sizeof(CAEndpoint_t));
+    if (!g_discoveryCacheNetworkInfo)
+    {
+        OIC_LOG(ERROR, TAG, "Failed allocating discovery cache network information");
+        return false;
+    }
+    if (infoSize)
+    {
+        memcpy(g_discoveryCacheNetworkInfo, networkInfo, infoSize * sizeof(CAEndpoint_t));
+    }
+    g_discoveryCacheInfoSize = infoSize;
+    OICStrcpy(g_discoveryCacheDeviceId, sizeof(g_discoveryCacheDeviceId), deviceId);
+    g_discoveryCacheBuiltGeneration = generation;
+    return true;
+}
+
+static bool IsSameQuery(const char *query, const char *cachedQuery)
+{
+    return (!query && !cachedQuery) || (query && cachedQuery && 0 == strcmp(query, cachedQuery));
+}
+
+/**
+ * Find the cached response to a discovery request, and make it the most recently used one.
+ *
+ * @return the cached response, NULL if none.
+ */
+static DiscoveryCacheEntry *FindDiscoveryCacheEntry(const OCServerRequest *request,
+                                                    OCVirtualResources uri,
+                                                    const char *interfaceQuery,
+                                                    const char *resourceTypeQuery)
+{
+    DiscoveryCacheEntry *entry = NULL;
+    DL_FOREACH(g_discoveryCache, entry)
+    {
+        if (entry->uri == uri &&
+            entry->acceptFormat == request->acceptFormat &&
+            entry->acceptVersion == request->acceptVersion &&
+            entry->adapter == request->devAddr.adapter &&
+            entry->flags == (request->devAddr.flags & (OC_FLAG_SECURE | OC_MASK_FAMS)) &&
+            IsSameQuery(interfaceQuery, entry->interfaceQuery) &&
+            IsSameQuery(resourceTypeQuery, entry->resourceTypeQuery))
+        {
+            if (entry != g_discoveryCache)
+            {
+                DL_DELETE(g_discoveryCache, entry);
+                DL_PREPEND(g_discoveryCache, entry);
+            }
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Encode a discovery response and cache it, evicting the least recently used response if the
+ * cache is full.
+ *
+ * @param result    ::OC_STACK_OK, or ::OC_STACK_NO_RESOURCE if no resource matched the queries.
+ * @param payload   Payload of the response, NULL if no resource matched the queries.
+ *
+ * @return the cached response, NULL on failure.
+ */
+static DiscoveryCacheEntry *AddDiscoveryCacheEntry(const OCServerRequest *request,
+                                                   OCVirtualResources uri,
+                                                   const char *interfaceQuery,
+                                                   const char *resourceTypeQuery,
+                                                   OCStackResult result,
+                                                   OCPayload *payload)
+{
+    DiscoveryCacheEntry *entry = (DiscoveryCacheEntry *)OICCalloc(1, sizeof(*entry));
+    VERIFY_PARAM_NON_NULL(TAG, entry, "Failed allocating discovery cache entry");
+
+    entry->uri = uri;
+    entry->acceptFormat = request->acceptFormat;
+    entry->acceptVersion = request->acceptVersion;
+    entry->adapter = request->devAddr.adapter;
+    entry->flags = (OCTransportFlags)(request->devAddr.flags & (OC_FLAG_SECURE | OC_MASK_FAMS));
+    entry->result = result;
+    if (interfaceQuery)
+    {
+        entry->interfaceQuery = OICStrdup(interfaceQuery);
+        VERIFY_PARAM_NON_NULL(TAG, entry->interfaceQuery, "Failed copying interface query");
+    }
+    if (resourceTypeQuery)
+    {
+        entry->resourceTypeQuery = OICStrdup(resourceTypeQuery);
+        VERIFY_PARAM_NON_NULL(TAG, entry->resourceTypeQuery, "Failed copying resource type query");
+    }
+    if (payload)
+    {
+        VERIFY_SUCCESS(OCConvertPayload(payload, request->acceptFormat,
+                                        &entry->payload, &entry->payloadSize));
+        entry->payloadHash = u_hashmap_hash(U_HASHMAP_HASH_INIT, entry->payload,
+                                            entry->payloadSize);
+    }
+
+    if (g_discoveryCacheCount >= DISCOVERY_CACHE_SIZE)
+    {
+        DeleteDiscoveryCacheEntry(g_discoveryCache->prev);
+    }
+    DL_PREPEND(g_discoveryCache, entry);
+    g_discoveryCacheCount++;
+    return entry;
+
+exit:
+    if (entry)
+    {
+        OICFree(entry->interfaceQuery);
+        OICFree(entry->resourceTypeQuery);
+        OICFree(entry);
+    }
+    return NULL;
+}
+
+/**
+ * Whether the response to a discovery request may be cached. Responses encoded in other formats
+ * are rejected when sent, and resources of the resource directory are not tracked by the cache.
+ */
+static bool IsDiscoveryCacheable(const OCServerRequest *request)
+{
+    if (OC_FORMAT_UNDEFINED != request->acceptFormat &&
+        OC_FORMAT_CBOR != request->acceptFormat &&
+        OC_FORMAT_VND_OCF_CBOR != request->acceptFormat)
+    {
+        return false;
+    }
+#ifdef RD_SERVER
+    if (OCGetResourceHandleAtUri(OC_RSRVD_RD_URI) != NULL)
+    {
+        return false;
+    }
+#endif
+    return true;
+}
+
 static bool isUnicast(OCServerRequest *request)
 {
     bool isMulticast = request->devAddr.flags & OC_MULTICAST;
@@ -1963,6 +2290,95 @@ exit:
     return result;
 }
 
+/**
+ * Build the payload of the response to a discovery request.
+ *
+ * @param request               Discovery request.
+ * @param resource              First resource to consider for the response.
+ * @param uri                   Virtual resource the request is for.
+ * @param interfaceQuery        Interface query of the request, NULL if none.
+ * @param resourceTypeQuery     Resource type query of the request, NULL if none.
+ * @param networkInfo           Network interfaces, for the endpoints of the resources.
+ * @param infoSize              Number of network interfaces.
+ * @param payload               Built payload, NULL if no resource matched the queries.
+ *
+ * @return ::OC_STACK_OK if resources matched the queries, ::OC_STACK_NO_RESOURCE if none did,
+ * some other value upon failure.
+ */
+static OCStackResult BuildDiscoveryResponse(OCServerRequest *request,
+                                            OCResource *resource,
+                                            OCVirtualResources uri,
+                                            const char *interfaceQuery,
+                                            const char *resourceTypeQuery,
+                                            CAEndpoint_t *networkInfo,
+                                            size_t infoSize,
+                                            OCPayload **payload)
+{
+    OCStackResult discoveryResult = discoveryPayloadCreateAndAddDeviceId(payload);
+    VERIFY_PARAM_NON_NULL(TAG, *payload, "Failed creating Discovery Payload.");
+    VERIFY_SUCCESS(discoveryResult);
+
+    OCDiscoveryPayload *discPayload = (OCDiscoveryPayload *)*payload;
+    if (interfaceQuery && 0 == strcmp(interfaceQuery, OC_RSRVD_INTERFACE_DEFAULT))
+    {
+        discoveryResult = addDiscoveryBaselineCommonProperties(discPayload);
+        VERIFY_SUCCESS(discoveryResult);
+    }
+    OCResourceProperty prop = OC_DISCOVERABLE;
+#ifdef MQ_BROKER
+    prop = (OC_MQ_BROKER_URI == uri) ? OC_MQ_BROKER : prop;
+#else
+    OC_UNUSED(uri);
+#endif
+    for (; resource && discoveryResult == OC_STACK_OK; resource = resource->next)
+    {
+        // This case will handle when no resource type and it is oic.if.ll.
+        // Do not assume check if the query is ll
+        if (!resourceTypeQuery &&
+            (interfaceQuery && 0 == strcmp(interfaceQuery, OC_RSRVD_INTERFACE_LL)))
+        {
+            // Only include discoverable type
+            if (resource->resourceProperties & prop)
+            {
+                discoveryResult = BuildVirtualResourceResponse(resource,
+                                                               discPayload,
+                                                               &request->devAddr,
+                                                               networkInfo,
+                                                               infoSize);
+            }
+        }
+        else if (includeThisResourceInResponse(resource, interfaceQuery, resourceTypeQuery))
+        {
+            discoveryResult = BuildVirtualResourceResponse(resource,
+                                                           discPayload,
+                                                           &request->devAddr,
+                                                           networkInfo,
+                                                           infoSize);
+        }
+        else
+        {
+            discoveryResult = OC_STACK_OK;
+        }
+    }
+    if (discPayload->resources == NULL)
+    {
+        discoveryResult = OC_STACK_NO_RESOURCE;
+        OCPayloadDestroy(*payload);
+        *payload = NULL;
+    }
+
+#ifdef RD_SERVER
+    discoveryResult = findResourcesAtRD(interfaceQuery, resourceTypeQuery, &request->devAddr,
+            (OCDiscoveryPayload **)payload);
+#endif
+    return discoveryResult;
+
+exit:
+    OCPayloadDestroy(*payload);
+    *payload = NULL;
+    return discoveryResult;
+}
+
 static OCStackResult HandleVirtualResource (OCServerRequest *request, OCResource* resource)
 {
     if (!request || !resource)
@@ -1971,8 +2387,10 @@ static OCStackResult HandleVirtualResource (OCServerRequest *request, OCResource
     }
 
     OCPayload* payload = NULL;
-    char *interfaceQuery = NULL;
-    char *resourceTypeQuery = NULL;
+    const char *interfaceQuery = NULL;
+    const char *resourceTypeQuery = NULL;
+    CAEndpoint_t *networkInfo = NULL;
+    size_t infoSize = 0;
 
     OIC_LOG(INFO, TAG, "Entering HandleVirtualResource");
 
@@ -2028,8 +2446,12 @@ static OCStackResult HandleVirtualResource (OCServerRequest *request, OCResource
             goto exit;
         }
 
-        CAEndpoint_t *networkInfo = NULL;
-        size_t infoSize = 0;
+        if (request->responseDeadline)
+        {
+            // Repeated multicast request, the response is already scheduled.
+            discoveryResult = OC_STACK_CONTINUE;
+            goto exit;
+        }
 
         CAResult_t caResult = CAGetNetworkInformation(&networkInfo, &infoSize);
         if (CA_STATUS_FAILED == caResult)
@@ -2038,75 +2460,71 @@ static OCStackResult HandleVirtualResource (OCServerRequest *request, OCResource
             return OC_STACK_ERROR;
         }
 
-        discoveryResult = getQueryParamsForFiltering (virtualUriInRequest, request->query,
+        discoveryResult = getQueryParamsForFiltering (virtualUriInRequest, &request->parsedQuery,
                 &interfaceQuery, &resourceTypeQuery);
         VERIFY_SUCCESS(discoveryResult);
 
         if (!interfaceQuery && !resourceTypeQuery)
         {
             // If no query is sent, default interface is used i.e. oic.if.ll.
-            interfaceQuery = OICStrdup(OC_RSRVD_INTERFACE_LL);
+            interfaceQuery = OC_RSRVD_INTERFACE_LL;
         }
 
-        discoveryResult = discoveryPayloadCreateAndAddDeviceId(&payload);
-        VERIFY_PARAM_NON_NULL(TAG, payload, "Failed creating Discovery Payload.");
-        VERIFY_SUCCESS(discoveryResult);
+        // The response only depends on the resources, the queries, the accept format and the
+        // kind of endpoint of the requester, so it is encoded once and sent again until they
+        // change.
+        DiscoveryCacheEntry *cached = NULL;
+        bool cacheable = IsDiscoveryCacheable(request) &&
+                         ValidateDiscoveryCache(networkInfo, infoSize);
+        if (cacheable)
+        {
+            cached = FindDiscoveryCacheEntry(request, virtualUriInRequest,
+                                             interfaceQuery, resourceTypeQuery);
+        }
 
-        OCDiscoveryPayload *discPayload = (OCDiscoveryPayload *)payload;
-        if (interfaceQuery && 0 == strcmp(interfaceQuery, OC_RSRVD_INTERFACE_DEFAULT))
+        if (cached)
         {
-            discoveryResult = addDiscoveryBaselineCommonProperties(discPayload);
-            VERIFY_SUCCESS(discoveryResult);
+            OIC_LOG(DEBUG, TAG, "Sending cached discovery response");
+            discoveryResult = cached->result;
         }
-        OCResourceProperty prop = OC_DISCOVERABLE;
-#ifdef MQ_BROKER
-        prop = (OC_MQ_BROKER_URI == virtualUriInRequest) ? OC_MQ_BROKER : prop;
-#endif
-        for (; resource && discoveryResult == OC_STACK_OK; resource = resource->next)
+        else
         {
-            // This case will handle when no resource type and it is oic.if.ll.
-            // Do not assume check if the query is ll
-            if (!resourceTypeQuery &&
-                (interfaceQuery && 0 == strcmp(interfaceQuery, OC_RSRVD_INTERFACE_LL)))
-            {
-                // Only include discoverable type
-                if (resource->resourceProperties & prop)
-                {
-                    discoveryResult = BuildVirtualResourceResponse(resource,
-                                                                   discPayload,
-                                                                   &request->devAddr,
-                                                                   networkInfo,
-                                                                   infoSize);
-                }
-            }
-            else if (includeThisResourceInResponse(resource, interfaceQuery, resourceTypeQuery))
-            {
-                discoveryResult = BuildVirtualResourceResponse(resource,
-                                                               discPayload,
-                                                               &request->devAddr,
-                                                               networkInfo,
-                                                               infoSize);
-            }
-            else
+            discoveryResult = BuildDiscoveryResponse(request, resource, virtualUriInRequest,
+                                                     interfaceQuery, resourceTypeQuery,
+                                                     networkInfo, infoSize, &payload);
+            if (cacheable &&
+                (OC_STACK_OK == discoveryResult || OC_STACK_NO_RESOURCE == discoveryResult))
             {
-                discoveryResult = OC_STACK_OK;
+                cached = AddDiscoveryCacheEntry(request, virtualUriInRequest, interfaceQuery,
+                                                resourceTypeQuery, discoveryResult, payload);
             }
         }
-        if (discPayload->resources == NULL)
-        {
-            discoveryResult = OC_STACK_NO_RESOURCE;
-            OCPayloadDestroy(payload);
-            payload = NULL;
-        }
 
-        if (networkInfo)
+        if (cached && cached->payload)
         {
-            OICFree(networkInfo);
+            request->encodedResponsePayload = cached->payload;
+            request->encodedResponsePayloadSize = cached->payloadSize;
+
+            // Every server on the link answers a multicast request, skip the answers the
+            // client already has and spread the others over the leisure (RFC 7252, 8.2).
+            if ((request->devAddr.flags & OC_MULTICAST) && OC_STACK_OK == discoveryResult)
+            {
+                if (SuppressDiscoveryResponse(&request->devAddr, cached->payloadHash))
+                {
+                    OIC_LOG(INFO, TAG, "Suppressing repeated multicast discovery response");
+                    DeleteServerRequest(request);
+                    discoveryResult = OC_STACK_CONTINUE;
+                    goto exit;
+                }
+                if (g_multicastDiscoveryPolicy.leisureMs &&
+                    OC_STACK_OK == DelayServerResponse(request,
+                        OCGetRandomRange(0, g_multicastDiscoveryPolicy.leisureMs)))
+                {
+                    // Sent by OCProcess once the delay elapsed.
+                    goto exit;
+                }
+            }
         }
-#ifdef RD_SERVER
-        discoveryResult = findResourcesAtRD(interfaceQuery, resourceTypeQuery, &request->devAddr,
-                (OCDiscoveryPayload **)&payload);
-#endif
     }
     else if (virtualUriInRequest == OC_DEVICE_URI)
     {
@@ -2131,7 +2549,7 @@ static OCStackResult HandleVirtualResource (OCServerRequest *request, OCResource
     else if (OC_INTROSPECTION_URI == virtualUriInRequest)
     {
         // Received request for introspection
-        discoveryResult = getQueryParamsForFiltering(virtualUriInRequest, request->query,
+        discoveryResult = getQueryParamsForFiltering(virtualUriInRequest, &request->parsedQuery,
                                                      &interfaceQuery, &resourceTypeQuery);
         VERIFY_SUCCESS(discoveryResult);
 
@@ -2219,16 +2637,8 @@ static OCStackResult HandleVirtualResource (OCServerRequest *request, OCResource
     }
 
 exit:
-    if (interfaceQuery)
-    {
-        OICFree(interfaceQuery);
-    }
-
-    if (resourceTypeQuery)
-    {
-        OICFree(resourceTypeQuery);
-    }
     OCPayloadDestroy(payload);
+    OICFree(networkInfo);
 
     // To ignore the message, OC_STACK_CONTINUE is sent
     return discoveryResult;
@@ -2882,6 +3292,9 @@ static OCStackResult SetAttributeInternal(OCResource *resource,
     }
     VERIFY_PARAM_NON_NULL(TAG, resAttrib->attrValue, "Failed allocating attribute value");
 
+    // The device name is part of baseline discovery responses.
+    InvalidateDiscoveryCache();
+
     // The resource has changed from what is stored in the database. Update the database to
     // reflect the new value.
     if (updateDatabase)
@@ -26,6 +26,7 @@
 #include "ocobserve.h"
 #include "oic_malloc.h"
 #include "oic_string.h"
+#include "oic_time.h"
 #include "ocpayload.h"
 #include "ocpayloadcbor.h"
 #include "experimental/logger.h"
@@ -73,6 +74,12 @@ RB_HEAD(ServerResponseTree, OCServerResponse) g_serverResponseTree =
                                                             RB_INITIALIZER(&g_serverResponseTree);
 RB_GENERATE(ServerResponseTree, OCServerResponse, entry, RBResponseTokenCmp)
 
+/** Server requests with an aggregate deadline, checked by HandleAggregateResponseTimeouts. */
+static OCServerRequest *g_aggregateRequests = NULL;
+
+/** Server requests with a delayed response, sent by HandleDelayedResponses. */
+static OCServerRequest *g_delayedRequests = NULL;
+
 //-------------------------------------------------------------------------------------------------
 // Local functions
 //-------------------------------------------------------------------------------------------------
@@ -325,6 +332,12 @@ OCStackResult AddServerRequest (OCServerRequest ** request,
     {
         OICStrcpy(serverRequest->query, sizeof(serverRequest->query), query);
     }
+    if (OC_STACK_OK != OCParseQuery(serverRequest->query, &serverRequest->parsedQuery))
+    {
+        // A truncated query is kept for the entity handler but fails every filter lookup,
+        // so an if= or rt= past the last parsed param is never silently ignored.
+        OIC_LOG_V(WARNING, TAG, "Only the first %d query params are parsed", OC_MAX_QUERY_PARAMS);
+    }
     if (rcvdVendorSpecificHeaderOptions)
     {
         memcpy(serverRequest->rcvdVendorSpecificHeaderOptions, rcvdVendorSpecificHeaderOptions,
@@ -414,6 +427,31 @@ void DeleteServerRequest(OCServerRequest * serverRequest)
         }
 
         RBL_REMOVE(ServerRequestTree, &g_serverRequestTree, serverRequest);
+        if (serverRequest->aggregateDeadline)
+        {
+            OCServerRequest **prev = &g_aggregateRequests;
+            while (*prev && *prev != serverRequest)
+            {
+                prev = &(*prev)->nextAggregate;
+            }
+            if (*prev)
+            {
+                *prev = serverRequest->nextAggregate;
+            }
+        }
+        if (serverRequest->responseDeadline)
+        {
+            OCServerRequest **prev = &g_delayedRequests;
+            while (*prev && *prev != serverRequest)
+            {
+                prev = &(*prev)->nextDelayed;
+            }
+            if (*prev)
+            {
+                *prev = serverRequest->nextDelayed;
+            }
+        }
+        OICFree(serverRequest->delayedResponsePayload);
         OICFree(serverRequest->requestToken);
         OICFree(serverRequest);
         serverRequest = NULL;
@@ -470,6 +508,31 @@ OCStackResult FormOCEntityHandlerRequest(OCEntityHandlerRequest * entityHandlerR
     return OC_STACK_INVALID_PARAM;
 }
 
+/**
+ * Set the format and version of the payload of a response from the accept format of the
+ * request.
+ *
+ * @param[in]  serverRequest    Request the response is for.
+ * @param[out] info             Information of the response.
+ */
+static void SetResponsePayloadFormat(const OCServerRequest *serverRequest, CAInfo_t *info)
+{
+    info->payloadFormat = OCToCAPayloadFormat(serverRequest->acceptFormat);
+    if (CA_FORMAT_UNDEFINED == info->payloadFormat)
+    {
+        info->payloadFormat = CA_FORMAT_APPLICATION_CBOR;
+    }
+    if ((OC_FORMAT_VND_OCF_CBOR == serverRequest->acceptFormat))
+    {
+        // Add versioning information for this format
+        info->payloadVersion = serverRequest->acceptVersion;
+        if (!info->payloadVersion)
+        {
+            info->payloadVersion = DEFAULT_VERSION_VALUE;
+        }
+    }
+}
+
 /**
  * Handler function for sending a response from a single resource
  *
@@ -478,7 +541,15 @@ OCStackResult FormOCEntityHandlerRequest(OCEntityHandlerRequest * entityHandlerR
  * @return
  *     OCStackResult
  */
-OCStackResult HandleSingleResponse(OCEntityHandlerResponse * ehResponse)
+/**
+ * Send a response to a server request, without deleting the request.
+ *
+ * @param[in]  ehResponse   Pointer to the response.
+ *
+ * @return
+ *     ::OCStackResult
+ */
+static OCStackResult SendServerResponse(OCEntityHandlerResponse * ehResponse)
 {
     OCStackResult result = OC_STACK_ERROR;
     CAEndpoint_t responseEndpoint = {.adapter = CA_DEFAULT_ADAPTER};
@@ -492,6 +563,7 @@ OCStackResult HandleSingleResponse(OCEntityHandlerResponse * ehResponse)
     }
 
     OCServerRequest *serverRequest = (OCServerRequest *)ehResponse->requestHandle;
+    bool hasPayload = ehResponse->payload || serverRequest->encodedResponsePayload;
 
     CopyDevAddrToEndpoint(&serverRequest->devAddr, &responseEndpoint);
 
@@ -558,7 +630,7 @@ OCStackResult HandleSingleResponse(OCEntityHandlerResponse * ehResponse)
     uint16_t payloadFormat = COAP_MEDIATYPE_APPLICATION_VND_OCF_CBOR;
     bool IsPayloadVersionSet = false;
     bool IsPayloadFormatSet = false;
-    if (ehResponse->payload)
+    if (hasPayload)
     {
         for (uint8_t i = 0; i < responseInfo.info.numOptions; i++)
         {
@@ -672,7 +744,7 @@ OCStackResult HandleSingleResponse(OCEntityHandlerResponse * ehResponse)
             optionsPointer += 1;
         }
 
-        if (ehResponse->payload)
+        if (hasPayload)
         {
             if (!IsPayloadVersionSet && !IsPayloadFormatSet)
             {
@@ -718,8 +790,15 @@ OCStackResult HandleSingleResponse(OCEntityHandlerResponse * ehResponse)
     responseInfo.info.payloadSize = 0;
     responseInfo.info.payloadFormat = CA_FORMAT_UNDEFINED;
 
+    if (serverRequest->encodedResponsePayload)
+    {
+        // Encoded in the accept format by the caller, CA copies it before sending.
+        responseInfo.info.payload = (CAPayload_t)serverRequest->encodedResponsePayload;
+        responseInfo.info.payloadSize = serverRequest->encodedResponsePayloadSize;
+        SetResponsePayloadFormat(serverRequest, &responseInfo.info);
+    }
     // Put the JSON prefix and suffix around the payload
-    if(ehResponse->payload)
+    else if(ehResponse->payload)
     {
         if (ehResponse->payload->type == PAYLOAD_TYPE_PRESENCE)
         {
@@ -748,22 +827,7 @@ OCStackResult HandleSingleResponse(OCEntityHandlerResponse * ehResponse)
                 if (ehResponse->payload->type != PAYLOAD_TYPE_DIAGNOSTIC &&
                         responseInfo.info.payloadSize > 0)
                 {
-                    responseInfo.info.payloadFormat = OCToCAPayloadFormat(
-                            serverRequest->acceptFormat);
-                    if (CA_FORMAT_UNDEFINED == responseInfo.info.payloadFormat)
-                    {
-                        responseInfo.info.payloadFormat = CA_FORMAT_APPLICATION_CBOR;
-                    }
-                    if ((OC_FORMAT_VND_OCF_CBOR == serverRequest->acceptFormat))
-                    {
-                        // Add versioning information for this format
-                        responseInfo.info.payloadVersion = serverRequest->acceptVersion;
-                        if (!responseInfo.info.payloadVersion)
-                        {
-                            responseInfo.info.payloadVersion = DEFAULT_VERSION_VALUE;
-                        }
-
-                    }
+                    SetResponsePayloadFormat(serverRequest, &responseInfo.info);
                 }
                 break;
             default:
@@ -830,16 +894,48 @@ OCStackResult HandleSingleResponse(OCEntityHandlerResponse * ehResponse)
     result = OCSendResponse(&responseEndpoint, &responseInfo);
 #endif
 
-    OICFree(responseInfo.info.payload);
+    if (!serverRequest->encodedResponsePayload)
+    {
+        OICFree(responseInfo.info.payload);
+    }
     OICFree(responseInfo.info.options);
-    //Delete the request
-    DeleteServerRequest(serverRequest);
+    return result;
+}
+
+OCStackResult HandleSingleResponse(OCEntityHandlerResponse * ehResponse)
+{
+    OCStackResult result = SendServerResponse(ehResponse);
+    if (ehResponse && ehResponse->requestHandle)
+    {
+        //Delete the request
+        DeleteServerRequest((OCServerRequest *)ehResponse->requestHandle);
+    }
     return result;
 }
 
 OCStackResult HandleAggregateResponse(OCEntityHandlerResponse * ehResponse)
 {
-    if(!ehResponse || !ehResponse->payload)
+    if(!ehResponse || !ehResponse->requestHandle)
+    {
+        OIC_LOG(ERROR, TAG, "HandleAggregateResponse invalid parameters");
+        return OC_STACK_INVALID_PARAM;
+    }
+
+    OCServerRequest *serverRequest = (OCServerRequest *)ehResponse->requestHandle;
+    if (serverRequest->aggregateResponseSent)
+    {
+        // The aggregated response went out at the deadline, the request only waited for
+        // the remaining resources to let go of it.
+        OIC_LOG_V(INFO, TAG, "Dropping response fragment of %s after the deadline",
+                  ehResponse->resourceUri);
+        if (0 == --(serverRequest->numResponses))
+        {
+            DeleteServerRequest(serverRequest);
+        }
+        return OC_STACK_OK;
+    }
+
+    if(!ehResponse->payload)
     {
         OIC_LOG(ERROR, TAG, "HandleAggregateResponse invalid parameters");
         return OC_STACK_INVALID_PARAM;
@@ -848,73 +944,229 @@ OCStackResult HandleAggregateResponse(OCEntityHandlerResponse * ehResponse)
     OIC_LOG(INFO, TAG, "Inside HandleAggregateResponse");
     OIC_LOG_V(DEBUG, TAG, "HandleAggregateResponse: resource uri is %s!", ehResponse->resourceUri);
 
-    OCServerRequest *serverRequest = (OCServerRequest *)ehResponse->requestHandle;
-    OCServerResponse *serverResponse = GetServerResponseUsingHandle((OCServerRequest *)
-                                                                    ehResponse->requestHandle);
+    OCServerResponse *serverResponse = GetServerResponseUsingHandle(serverRequest);
     OCStackResult stackRet = OC_STACK_ERROR;
-    if(serverRequest)
+    if(!serverResponse)
     {
-        if(!serverResponse)
+        OIC_LOG_V(DEBUG, TAG, "HandleAggregateResponse: resource uri (serverRequest) is %s!", serverRequest->resourceUrl);
+
+        OIC_LOG(INFO, TAG, "This is the first response fragment");
+        stackRet = AddServerResponse(&serverResponse, ehResponse->requestHandle);
+        if (OC_STACK_OK != stackRet)
         {
-            OIC_LOG_V(DEBUG, TAG, "HandleAggregateResponse: resource uri (serverRequest) is %s!", serverRequest->resourceUrl);
+            OIC_LOG(ERROR, TAG, "Error adding server response");
+            return stackRet;
+        }
+        VERIFY_NON_NULL(serverResponse);
+    }
 
-            OIC_LOG(INFO, TAG, "This is the first response fragment");
-            stackRet = AddServerResponse(&serverResponse, ehResponse->requestHandle);
-            if (OC_STACK_OK != stackRet)
-            {
-                OIC_LOG(ERROR, TAG, "Error adding server response");
-                return stackRet;
-            }
-            VERIFY_NON_NULL(serverResponse);
+    if(ehResponse->payload->type != PAYLOAD_TYPE_REPRESENTATION)
+    {
+        stackRet = OC_STACK_ERROR;
+        OIC_LOG(ERROR, TAG, "Error adding payload, as it was the incorrect type");
+        goto exit;
+    }
+
+    ((OCRepPayload *)ehResponse->payload)->uri = OICStrdup(ehResponse->resourceUri);
+    OCRepPayload *newPayload = OCRepPayloadBatchClone((OCRepPayload *)ehResponse->payload);
+    OICFree(((OCRepPayload *)ehResponse->payload)->uri);
+    ((OCRepPayload *)ehResponse->payload)->uri = NULL;
+
+    OCRepPayloadSetPayloadRepType(newPayload, PAYLOAD_REP_ARRAY);
+
+    if(!serverResponse->payload)
+    {
+        serverResponse->payload = (OCPayload *)newPayload;
+    }
+    else
+    {
+        OCRepPayloadAppend((OCRepPayload*)serverResponse->payload,
+                (OCRepPayload*)newPayload);
+    }
+
+    (serverRequest->numResponses)--;
+
+    if(serverRequest->numResponses == 0)
+    {
+        OIC_LOG(INFO, TAG, "This is the last response fragment");
+        OCPayload *payload = serverResponse->payload;
+        DeleteServerResponse(serverResponse);
+
+        // The caller keeps and frees its own payload, the aggregated one belongs to the stack.
+        OCPayload *callerPayload = ehResponse->payload;
+        ehResponse->payload = payload;
+        ehResponse->ehResult = OC_EH_OK;
+        //Deletes the request
+        stackRet = HandleSingleResponse(ehResponse);
+        ehResponse->payload = callerPayload;
+        OCPayloadDestroy(payload);
+    }
+    else
+    {
+        OIC_LOG(INFO, TAG, "More response fragments to come");
+        stackRet = OC_STACK_OK;
+    }
+exit:
+
+    return stackRet;
+}
+
+void SetAggregateResponseDeadline(OCServerRequest * serverRequest, uint32_t timeoutMs)
+{
+    if (!serverRequest || !timeoutMs || serverRequest->aggregateDeadline)
+    {
+        return;
+    }
+
+    serverRequest->aggregateDeadline = OICGetCurrentTime(TIME_IN_MS) + timeoutMs;
+    serverRequest->nextAggregate = g_aggregateRequests;
+    g_aggregateRequests = serverRequest;
+}
+
+uint32_t GetAggregateResponseTimeout(uint32_t timeoutMs)
+{
+    if (!g_aggregateRequests)
+    {
+        return timeoutMs;
+    }
+
+    uint64_t now = OICGetCurrentTime(TIME_IN_MS);
+    for (OCServerRequest *serverRequest = g_aggregateRequests; serverRequest && timeoutMs;
+         serverRequest = serverRequest->nextAggregate)
+    {
+        if (serverRequest->aggregateResponseSent)
+        {
+            continue;
         }
 
-        if(ehResponse->payload->type != PAYLOAD_TYPE_REPRESENTATION)
+        if (serverRequest->aggregateDeadline <= now)
+        {
+            timeoutMs = 0;
+        }
+        else if (serverRequest->aggregateDeadline - now < timeoutMs)
         {
-            stackRet = OC_STACK_ERROR;
-            OIC_LOG(ERROR, TAG, "Error adding payload, as it was the incorrect type");
-            goto exit;
+            timeoutMs = (uint32_t)(serverRequest->aggregateDeadline - now);
         }
+    }
+    return timeoutMs;
+}
 
-        if (ehResponse->payload)
-            ((OCRepPayload *)ehResponse->payload)->uri = OICStrdup(ehResponse->resourceUri);
-        OCRepPayload *newPayload = OCRepPayloadBatchClone((OCRepPayload *)ehResponse->payload);
-        if (ehResponse->payload)
+void HandleAggregateResponseTimeouts(void)
+{
+    if (!g_aggregateRequests)
+    {
+        return;
+    }
+
+    uint64_t now = OICGetCurrentTime(TIME_IN_MS);
+    for (OCServerRequest *serverRequest = g_aggregateRequests; serverRequest;
+         serverRequest = serverRequest->nextAggregate)
+    {
+        if (serverRequest->aggregateResponseSent || now < serverRequest->aggregateDeadline)
         {
-            OICFree(((OCRepPayload *)ehResponse->payload)->uri);
-            ((OCRepPayload *)ehResponse->payload)->uri = NULL;
+            continue;
         }
 
-        OCRepPayloadSetPayloadRepType(newPayload, PAYLOAD_REP_ARRAY);
+        OIC_LOG_V(INFO, TAG, "%u responses of %s missed the deadline",
+                  serverRequest->numResponses, serverRequest->resourceUrl);
 
-        if(!serverResponse->payload)
+        OCServerResponse *serverResponse = GetServerResponseUsingHandle(serverRequest);
+        OCPayload *payload = NULL;
+        if (serverResponse)
         {
-            serverResponse->payload = (OCPayload *)newPayload;
+            payload = serverResponse->payload;
+            DeleteServerResponse(serverResponse);
         }
-        else
+
+        OCEntityHandlerResponse ehResponse = { .requestHandle = (OCRequestHandle)serverRequest };
+        ehResponse.payload = payload;
+        ehResponse.ehResult = payload ? OC_EH_OK : OC_EH_ERROR;
+        if (OC_STACK_OK != SendServerResponse(&ehResponse))
         {
-            OCRepPayloadAppend((OCRepPayload*)serverResponse->payload,
-                    (OCRepPayload*)newPayload);
+            OIC_LOG(ERROR, TAG, "Error sending partial aggregated response");
         }
+        OCPayloadDestroy(payload);
+
+        // Kept until the remaining resources respond, they still hold the request handle.
+        serverRequest->aggregateResponseSent = 1;
+    }
+}
+
+OCStackResult DelayServerResponse(OCServerRequest * serverRequest, uint32_t delayMs)
+{
+    if (!serverRequest || !serverRequest->encodedResponsePayload ||
+        serverRequest->responseDeadline)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
 
-        (serverRequest->numResponses)--;
+    // The encoded payload may be a cached response, which can be dropped before the delay ends.
+    uint8_t *payload = (uint8_t *)OICMalloc(serverRequest->encodedResponsePayloadSize);
+    if (!payload)
+    {
+        OIC_LOG(ERROR, TAG, "Failed allocating delayed response payload");
+        return OC_STACK_NO_MEMORY;
+    }
+    memcpy(payload, serverRequest->encodedResponsePayload,
+           serverRequest->encodedResponsePayloadSize);
+
+    serverRequest->delayedResponsePayload = payload;
+    serverRequest->encodedResponsePayload = payload;
+    serverRequest->responseDeadline = OICGetCurrentTime(TIME_IN_MS) + delayMs;
+    serverRequest->nextDelayed = g_delayedRequests;
+    g_delayedRequests = serverRequest;
+    return OC_STACK_OK;
+}
 
-        if(serverRequest->numResponses == 0)
+uint32_t GetDelayedResponseTimeout(uint32_t timeoutMs)
+{
+    if (!g_delayedRequests)
+    {
+        return timeoutMs;
+    }
+
+    uint64_t now = OICGetCurrentTime(TIME_IN_MS);
+    for (OCServerRequest *serverRequest = g_delayedRequests; serverRequest && timeoutMs;
+         serverRequest = serverRequest->nextDelayed)
+    {
+        if (serverRequest->responseDeadline <= now)
         {
-            OIC_LOG(INFO, TAG, "This is the last response fragment");
-            ehResponse->payload = serverResponse->payload;
-            ehResponse->ehResult = OC_EH_OK;
-            stackRet = HandleSingleResponse(ehResponse);
-            //Delete the request and response
-            DeleteServerRequest(serverRequest);
-            DeleteServerResponse(serverResponse);
+            timeoutMs = 0;
         }
-        else
+        else if (serverRequest->responseDeadline - now < timeoutMs)
         {
-            OIC_LOG(INFO, TAG, "More response fragments to come");
-            stackRet = OC_STACK_OK;
+            timeoutMs = (uint32_t)(serverRequest->responseDeadline - now);
         }
     }
-exit:
+    return timeoutMs;
+}
 
-    return stackRet;
+void HandleDelayedResponses(void)
+{
+    if (!g_delayedRequests)
+    {
+        return;
+    }
+
+    uint64_t now = OICGetCurrentTime(TIME_IN_MS);
+    OCServerRequest **prev = &g_delayedRequests;
+    while (*prev)
+    {
+        OCServerRequest *serverRequest = *prev;
+        if (now < serverRequest->responseDeadline)
+        {
+            prev = &serverRequest->nextDelayed;
+            continue;
+        }
+
+        *prev = serverRequest->nextDelayed;
+        serverRequest->responseDeadline = 0;
+
+        OCEntityHandlerResponse ehResponse = { .requestHandle = (OCRequestHandle)serverRequest };
+        ehResponse.ehResult = OC_EH_OK;
+        if (OC_STACK_OK != HandleSingleResponse(&ehResponse))
+        {
+            OIC_LOG(ERROR, TAG, "Error sending delayed response");
+        }
+    }
 }
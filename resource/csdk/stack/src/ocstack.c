@@ -53,6 +53,7 @@
 #include "experimental/ocrandom.h"
 #include "oic_malloc.h"
 #include "oic_string.h"
+#include "oic_time.h"
 #include "experimental/logger.h"
 #include "trace.h"
 #include "ocserverrequest.h"
@@ -70,6 +71,7 @@
 #include "oicgroup.h"
 #include "ocendpoint.h"
 #include "ocatomic.h"
+#include "octhread.h"
 #include "platform_features.h"
 #include "oic_platform.h"
 #include "caping.h"
@@ -170,6 +172,9 @@ static OCPersistentStorage *g_PersistentStorageHandler = NULL;
 uint32_t g_ocStackStartCount = 0;
 // Number of threads currently executing OCInit2 or OCStop
 volatile int32_t g_ocStackStartStopThreadCount = 0;
+// Serializes the processing of the stack with the submission of requests, responses and
+// notifications from other threads. Recursive, as callbacks may submit from OCProcess.
+static oc_mutex g_ocStackLock = NULL;
 
 bool g_multicastServerStopped = false;
 
@@ -194,6 +199,11 @@ bool g_multicastServerStopped = false;
 
 #define MILLISECONDS_PER_SECOND   (1000)
 
+#ifdef ROUTING_GATEWAY
+/** Interval at which OCProcessWait runs the timers of the routing manager.*/
+#define ROUTING_PROCESS_INTERVAL_MS (1000)
+#endif
+
 //-----------------------------------------------------------------------------
 // Private internal function prototypes
 //-----------------------------------------------------------------------------
@@ -382,16 +392,6 @@ static void HandleCAResponses(const CAEndpoint_t* endPoint,
 static void HandleCARequests(const CAEndpoint_t* endPoint,
         const CARequestInfo_t* requestInfo);
 
-/**
- * Extract query from a URI.
- *
- * @param uri Full URI with query.
- * @param query Pointer to string that will contain query.
- * @param newURI Pointer to string that will contain URI.
- * @return ::OC_STACK_OK on success, some other value upon failure.
- */
-static OCStackResult getQueryFromUri(const char * uri, char** resourceType, char ** newURI);
-
 /**
  * Finds a resource type in an OCResourceType link-list.
  *
@@ -535,6 +535,22 @@ static void OCLeaveInitializer(void)
     OC_VERIFY(oc_atomic_decrement(&g_ocStackStartStopThreadCount) >= 0);
 }
 
+static void OCLockStack(void)
+{
+    if (g_ocStackLock)
+    {
+        oc_mutex_lock(g_ocStackLock);
+    }
+}
+
+static void OCUnlockStack(void)
+{
+    if (g_ocStackLock)
+    {
+        oc_mutex_unlock(g_ocStackLock);
+    }
+}
+
 bool checkProxyUri(OCHeaderOption *options, uint8_t numOptions)
 {
     if (!options || 0 == numOptions)
@@ -747,6 +763,7 @@ OCStackResult OCStackFeedBack(CAToken_t token, uint8_t tokenLength, uint8_t stat
         OIC_LOG(DEBUG, TAG, "observer still interested, reset the failedCount");
         observer->forceHighQos = 0;
         observer->failedCommCount = 0;
+        CompleteObserveNotification(observer);
         result = OC_STACK_OK;
         break;
 
@@ -782,6 +799,7 @@ OCStackResult OCStackFeedBack(CAToken_t token, uint8_t tokenLength, uint8_t stat
         {
             observer->failedCommCount++;
             observer->forceHighQos = 1;
+            CompleteObserveNotification(observer);
             OIC_LOG_V(DEBUG, TAG, "Failure counter for this observer is %d",
                       observer->failedCommCount);
             result = OC_STACK_CONTINUE;
@@ -1399,35 +1417,29 @@ OCStackResult HandleBatchResponse(char *requestUri, OCRepPayload **payload)
 {
     if (requestUri && *payload)
     {
-        char *interfaceName = NULL;
-        char *rtTypeName = NULL;
-        char *uriQuery = NULL;
-        char *uriWithoutQuery = NULL;
-        if (OC_STACK_OK == getQueryFromUri(requestUri, &uriQuery, &uriWithoutQuery))
+        size_t pathLength = 0;
+        const char *uriQuery = OCGetUriQuery(requestUri, &pathLength);
+        OCParsedQuery parsedQuery;
+        const char *interfaceName = NULL;
+        const char *rtTypeName = NULL;
+        if (uriQuery && OC_STACK_OK == OCParseQuery(uriQuery, &parsedQuery)
+            && OC_STACK_OK == OCGetQueryFilters(&parsedQuery, &interfaceName, &rtTypeName))
         {
-            if (OC_STACK_OK == ExtractFiltersFromQuery(uriQuery, &interfaceName, &rtTypeName))
+            if (interfaceName && (0 == strcmp(OC_RSRVD_INTERFACE_BATCH, interfaceName)))
             {
-                if (interfaceName && (0 == strcmp(OC_RSRVD_INTERFACE_BATCH, interfaceName)))
+                char *uri = (*payload)->uri;
+                if (uri && (0 != strncmp(requestUri, uri, pathLength) || '\0' != uri[pathLength]))
                 {
-                    char *uri = (*payload)->uri;
-                    if (uri && 0 != strcmp(uriWithoutQuery, uri))
+                    OCRepPayload *newPayload = OCRepPayloadCreate();
+                    if (newPayload)
                     {
-                        OCRepPayload *newPayload = OCRepPayloadCreate();
-                        if (newPayload)
-                        {
-                            OCRepPayloadSetUri(newPayload, uri);
-                            newPayload->next = *payload;
-                            *payload = newPayload;
-                        }
+                        OCRepPayloadSetUri(newPayload, uri);
+                        newPayload->next = *payload;
+                        *payload = newPayload;
                     }
                 }
             }
         }
-
-        OICFree(interfaceName);
-        OICFree(rtTypeName);
-        OICFree(uriQuery);
-        OICFree(uriWithoutQuery);
         return OC_STACK_OK;
     }
     return OC_STACK_INVALID_PARAM;
@@ -1834,6 +1846,22 @@ void OC_CALL OCHandleResponse(const CAEndpoint_t* endPoint, const CAResponseInfo
                     return;
                 }
 
+                // Servers answer repeated multicast requests, skip the copies unparsed.
+                if (cbNode->batchWindowMs && PAYLOAD_TYPE_DISCOVERY == type &&
+                    OCResultToSuccess(response->result) &&
+                    CheckDiscoveryResponseReceived(cbNode, responseInfo->info.payload,
+                                                   responseInfo->info.payloadSize))
+                {
+                    OIC_LOG(INFO, TAG, "Skipping repeated discovery response");
+                    if (responseInfo->info.type == CA_MSG_CONFIRM)
+                    {
+                        SendDirectStackResponse(endPoint, responseInfo->info.messageId, CA_EMPTY,
+                                CA_MSG_ACKNOWLEDGE, 0, NULL, NULL, 0, NULL, CA_RESPONSE_FOR_RES);
+                    }
+                    OICFree(response);
+                    return;
+                }
+
                 // In case of error, still want application to receive the error message.
                 if (OCResultToSuccess(response->result) || PAYLOAD_TYPE_REPRESENTATION == type ||
                         PAYLOAD_TYPE_DIAGNOSTIC == type)
@@ -1962,20 +1990,30 @@ void OC_CALL OCHandleResponse(const CAEndpoint_t* endPoint, const CAResponseInfo
                     HandleBatchResponse(cbNode->requestUri, (OCRepPayload **)&response->payload);
                 }
 
-                OCStackApplicationResult appFeedback = cbNode->callBack(cbNode->context,
-                                                                        cbNode->handle,
-                                                                        response);
-                cbNode->sequenceNumber = response->sequenceNumber;
-
-                if (appFeedback == OC_STACK_DELETE_TRANSACTION)
+                if (cbNode->batchWindowMs && response->payload &&
+                    PAYLOAD_TYPE_DISCOVERY == response->payload->type &&
+                    OC_STACK_OK == AddDiscoveryBatchResponse(cbNode, response))
                 {
-                    DeleteClientCB(cbNode);
+                    // Delivered with the other responses by DeliverDiscoveryBatches.
+                    OIC_LOG(INFO, TAG, "Batching discovery response");
                 }
                 else
                 {
-                    // To keep discovery callbacks active.
-                    cbNode->TTL = GetTicks(MAX_CB_TIMEOUT_SECONDS *
-                                            MILLISECONDS_PER_SECOND);
+                    OCStackApplicationResult appFeedback = cbNode->callBack(cbNode->context,
+                                                                            cbNode->handle,
+                                                                            response);
+                    cbNode->sequenceNumber = response->sequenceNumber;
+
+                    if (appFeedback == OC_STACK_DELETE_TRANSACTION)
+                    {
+                        DeleteClientCB(cbNode);
+                    }
+                    else
+                    {
+                        // To keep discovery callbacks active.
+                        cbNode->TTL = GetTicks(MAX_CB_TIMEOUT_SECONDS *
+                                                MILLISECONDS_PER_SECOND);
+                    }
                 }
             }
 
@@ -2361,61 +2399,47 @@ void OCHandleRequests(const CAEndpoint_t* endPoint, const CARequestInfo_t* reque
     directResponseType = (directResponseType == CA_MSG_CONFIRM)
             ? CA_MSG_ACKNOWLEDGE : CA_MSG_NONCONFIRM;
 
-    char * uriWithoutQuery = NULL;
-    char * query = NULL;
-    OCStackResult requestResult = OC_STACK_ERROR;
-
-    requestResult = getQueryFromUri(requestInfo->info.resourceUri, &query, &uriWithoutQuery);
-
-    if (requestResult != OC_STACK_OK || !uriWithoutQuery)
+    size_t uriLength = 0;
+    const char *query = OCGetUriQuery(requestInfo->info.resourceUri, &uriLength);
+    if (!uriLength)
     {
-        OIC_LOG_V(ERROR, TAG, "getQueryFromUri() failed with OC error code %d\n", requestResult);
+        OIC_LOG(ERROR, TAG, "Request URI has no path.");
         return;
     }
-    OIC_LOG_V(INFO, TAG, "URI without query: %s", uriWithoutQuery);
-    OIC_LOG_V(INFO, TAG, "Query : %s", query);
 
+    // The URI and query are copied straight into the request, which is zeroed.
     OCServerProtocolRequest serverRequest = { 0 };
-    if (strlen(uriWithoutQuery) < MAX_URI_LENGTH)
+    if (uriLength < MAX_URI_LENGTH)
     {
-        OICStrcpy(serverRequest.resourceUrl, sizeof(serverRequest.resourceUrl), uriWithoutQuery);
-        OICFree(uriWithoutQuery);
+        memcpy(serverRequest.resourceUrl, requestInfo->info.resourceUri, uriLength);
     }
     else
     {
         OIC_LOG(ERROR, TAG, "URI length exceeds MAX_URI_LENGTH.");
-        OICFree(uriWithoutQuery);
-        OICFree(query);
         return;
     }
 
     if (query)
     {
-        if (strlen(query) < MAX_QUERY_LENGTH)
+        size_t queryLength = strnlen(query, MAX_QUERY_LENGTH);
+        if (queryLength < MAX_QUERY_LENGTH)
         {
-            OICStrcpy(serverRequest.query, sizeof(serverRequest.query), query);
-            OICFree(query);
+            memcpy(serverRequest.query, query, queryLength);
         }
         else
         {
             OIC_LOG(ERROR, TAG, "Query length exceeds MAX_QUERY_LENGTH.");
-            OICFree(query);
             return;
         }
     }
+    OIC_LOG_V(INFO, TAG, "URI without query: %s", serverRequest.resourceUrl);
+    OIC_LOG_V(INFO, TAG, "Query : %s", serverRequest.query);
 
     if ((requestInfo->info.payload) && (0 < requestInfo->info.payloadSize))
     {
         serverRequest.payloadFormat = CAToOCPayloadFormat(requestInfo->info.payloadFormat);
         serverRequest.reqTotalSize = requestInfo->info.payloadSize;
-        serverRequest.payload = (uint8_t *) OICMalloc(requestInfo->info.payloadSize);
-        if (!serverRequest.payload)
-        {
-            OIC_LOG(ERROR, TAG, "Allocation for payload failed.");
-            return;
-        }
-        memcpy (serverRequest.payload, requestInfo->info.payload,
-                requestInfo->info.payloadSize);
+        serverRequest.payload = requestInfo->info.payload;
     }
     else
     {
@@ -2443,7 +2467,6 @@ void OCHandleRequests(const CAEndpoint_t* endPoint, const CARequestInfo_t* reque
                                     requestInfo->info.options, requestInfo->info.token,
                                     requestInfo->info.tokenLength, requestInfo->info.resourceUri,
                                     CA_RESPONSE_DATA);
-            OICFree(serverRequest.payload);
             return;
     }
 
@@ -2454,20 +2477,7 @@ void OCHandleRequests(const CAEndpoint_t* endPoint, const CARequestInfo_t* reque
     if (serverRequest.tokenLength)
     {
         // Non empty token
-        serverRequest.requestToken = (CAToken_t)OICMalloc(requestInfo->info.tokenLength);
-
-        if (!serverRequest.requestToken)
-        {
-            OIC_LOG(FATAL, TAG, "Allocation for token failed.");
-            SendDirectStackResponse(endPoint, requestInfo->info.messageId, CA_INTERNAL_SERVER_ERROR,
-                                    directResponseType, requestInfo->info.numOptions,
-                                    requestInfo->info.options, requestInfo->info.token,
-                                    requestInfo->info.tokenLength, requestInfo->info.resourceUri,
-                                    CA_RESPONSE_DATA);
-            OICFree(serverRequest.payload);
-            return;
-        }
-        memcpy(serverRequest.requestToken, requestInfo->info.token, requestInfo->info.tokenLength);
+        serverRequest.requestToken = requestInfo->info.token;
     }
 
     serverRequest.acceptFormat = CAToOCPayloadFormat(requestInfo->info.acceptFormat);
@@ -2510,8 +2520,6 @@ void OCHandleRequests(const CAEndpoint_t* endPoint, const CARequestInfo_t* reque
                                 requestInfo->info.options, requestInfo->info.token,
                                 requestInfo->info.tokenLength, requestInfo->info.resourceUri,
                                 CA_RESPONSE_DATA);
-        OICFree(serverRequest.payload);
-        OICFree(serverRequest.requestToken);
         return;
     }
     serverRequest.numRcvdVendorSpecificHeaderOptions = tempNum;
@@ -2521,7 +2529,7 @@ void OCHandleRequests(const CAEndpoint_t* endPoint, const CARequestInfo_t* reque
                sizeof(CAHeaderOption_t) * tempNum);
     }
 
-    requestResult = HandleStackRequests (&serverRequest);
+    OCStackResult requestResult = HandleStackRequests (&serverRequest);
 
     if (requestResult == OC_STACK_SLOW_RESOURCE)
     {
@@ -2550,10 +2558,8 @@ void OCHandleRequests(const CAEndpoint_t* endPoint, const CARequestInfo_t* reque
                                 requestInfo->info.tokenLength, requestInfo->info.resourceUri,
                                 CA_RESPONSE_DATA);
     }
-    // requestToken is fed to HandleStackRequests, which then goes to AddServerRequest.
-    // The token is copied in there, and is thus still owned by this function.
-    OICFree(serverRequest.payload);
-    OICFree(serverRequest.requestToken);
+    // payload and requestToken are borrowed from requestInfo for HandleStackRequests,
+    // which copies them in AddServerRequest when it keeps the request.
     OIC_LOG(INFO, TAG, "Exit OCHandleRequests");
 }
 
@@ -2678,7 +2684,13 @@ OCStackResult OC_CALL OCInit2(OCMode mode, OCTransportFlags serverFlags, OCTrans
     if (g_ocStackStartCount == 0)
     {
         // This is the first call to initialize the stack so it gets to do the real work.
-        result = OCInitializeInternal(mode, serverFlags, clientFlags, transportType);
+        if (!g_ocStackLock)
+        {
+            g_ocStackLock = oc_mutex_new_recursive();
+        }
+        result = g_ocStackLock ? OCInitializeInternal(mode, serverFlags, clientFlags,
+                                                      transportType)
+                               : OC_STACK_NO_MEMORY;
     }
 
     if (result == OC_STACK_OK)
@@ -2845,6 +2857,7 @@ exit:
         OIC_LOG(ERROR, TAG, "Stack initialization error");
         TerminateScheduleResourceList();
         deleteAllResources();
+        DeleteDiscoveryCache();
         CATerminate();
         stackState = OC_STACK_UNINITIALIZED;
     }
@@ -2863,7 +2876,14 @@ OCStackResult OC_CALL OCStop(void)
     if (g_ocStackStartCount == 1)
     {
         // This is the last call to stop the stack, do the real work.
+        OCLockStack();
         result = OCDeInitializeInternal();
+        OCUnlockStack();
+        if (OC_STACK_OK == result)
+        {
+            oc_mutex_free(g_ocStackLock);
+            g_ocStackLock = NULL;
+        }
     }
     else if (g_ocStackStartCount == 0)
     {
@@ -2915,6 +2935,7 @@ OCStackResult OCDeInitializeInternal(void)
     TerminateScheduleResourceList();
     // Free memory dynamically allocated for resources
     deleteAllResources();
+    DeleteDiscoveryCache();
     // Remove all the client callbacks
     DeleteClientCBList();
     // Terminate connectivity-abstraction layer.
@@ -2950,6 +2971,16 @@ OCStackResult OC_CALL OCStopMulticastServer(void)
     return OC_STACK_OK;
 }
 
+OCStackResult OC_CALL OCSetMulticastDiscoveryPolicy(const OCMulticastDiscoveryPolicy *policy)
+{
+    VERIFY_NON_NULL(policy, ERROR, OC_STACK_INVALID_PARAM);
+
+    OCLockStack();
+    SetMulticastDiscoveryPolicy(policy);
+    OCUnlockStack();
+    return OC_STACK_OK;
+}
+
 CAMessageType_t qualityOfServiceToMessageType(OCQualityOfService qos)
 {
     switch (qos)
@@ -3292,6 +3323,7 @@ OCStackResult OC_CALL OCDoRequest(OCDoHandle *handle,
     char *resourceUri = NULL;
     char *resourceType = NULL;
     bool isProxyRequest = false;
+    bool stackLocked = false;
 
     /*
      * Support original behavior with address on resourceUri argument.
@@ -3568,31 +3600,23 @@ OCStackResult OC_CALL OCDoRequest(OCDoHandle *handle,
             // For DEFAULT interface repType will be PAYLOAD_REP_OBJECT_ARRAY
             if (requestUri && repPayload->repType == PAYLOAD_REP_ARRAY)
             {
-                char *interfaceName = NULL;
-                char *rtTypeName = NULL;
-                char *uriQuery = NULL;
-                char *uriWithoutQuery = NULL;
-                if (OC_STACK_OK == getQueryFromUri(requestUri, &uriQuery, &uriWithoutQuery))
+                size_t pathLength = 0;
+                const char *uriQuery = OCGetUriQuery(requestUri, &pathLength);
+                OCParsedQuery parsedQuery;
+                const char *interfaceName = NULL;
+                const char *rtTypeName = NULL;
+                if (NULL == uriQuery)
                 {
-                    if (OC_STACK_OK == ExtractFiltersFromQuery(uriQuery, &interfaceName,
-                        &rtTypeName))
-                    {
-                        if (interfaceName &&
-                            (0 == strcmp(OC_RSRVD_INTERFACE_DEFAULT, interfaceName)))
-                        {
-                            repPayload->repType = PAYLOAD_REP_OBJECT_ARRAY;
-                        }
-                    }
-                    else if (NULL == uriQuery)
-                    {
-                        repPayload->repType = PAYLOAD_REP_OBJECT_ARRAY;
-                    }
+                    repPayload->repType = PAYLOAD_REP_OBJECT_ARRAY;
+                }
+                else if (OC_STACK_OK == OCParseQuery(uriQuery, &parsedQuery)
+                         && OC_STACK_OK == OCGetQueryFilters(&parsedQuery, &interfaceName,
+                                                             &rtTypeName)
+                         && interfaceName
+                         && (0 == strcmp(OC_RSRVD_INTERFACE_DEFAULT, interfaceName)))
+                {
+                    repPayload->repType = PAYLOAD_REP_OBJECT_ARRAY;
                 }
-
-                OICFree(interfaceName);
-                OICFree(rtTypeName);
-                OICFree(uriQuery);
-                OICFree(uriWithoutQuery);
             }
         }
 
@@ -3612,6 +3636,10 @@ OCStackResult OC_CALL OCDoRequest(OCDoHandle *handle,
         requestInfo.info.payloadFormat = CA_FORMAT_UNDEFINED;
     }
 
+    // The request is built, from here on the stack state is shared with OCProcess.
+    OCLockStack();
+    stackLocked = true;
+
     // prepare for response
 #ifdef WITH_PRESENCE
     if (method == OC_REST_PRESENCE)
@@ -3750,6 +3778,10 @@ exit:
         }
         OICFree(resHandle);
     }
+    if (stackLocked)
+    {
+        OCUnlockStack();
+    }
 
     OICFree(requestInfo.info.payload);
     OICFree(devAddr);
@@ -3759,8 +3791,8 @@ exit:
     return result;
 }
 
-OCStackResult OC_CALL OCCancel(OCDoHandle handle, OCQualityOfService qos, OCHeaderOption * options,
-        uint8_t numOptions)
+static OCStackResult OCCancelInternal(OCDoHandle handle, OCQualityOfService qos,
+                                      OCHeaderOption *options, uint8_t numOptions)
 {
     /*
      * This ftn is implemented one of two ways in the case of observation:
@@ -3866,6 +3898,95 @@ OCStackResult OC_CALL OCCancel(OCDoHandle handle, OCQualityOfService qos, OCHead
     return ret;
 }
 
+OCStackResult OC_CALL OCCancel(OCDoHandle handle, OCQualityOfService qos, OCHeaderOption * options,
+        uint8_t numOptions)
+{
+    OCLockStack();
+    OCStackResult result = OCCancelInternal(handle, qos, options, numOptions);
+    OCUnlockStack();
+    return result;
+}
+
+OCStackResult OC_CALL OCSetDiscoveryBatchWindow(OCDoHandle handle, uint32_t windowMs)
+{
+    OCStackResult result = OC_STACK_INVALID_PARAM;
+    OCLockStack();
+    ClientCB *cbNode = GetClientCBUsingHandle(handle);
+    if (cbNode && OC_REST_DISCOVER == cbNode->method)
+    {
+        cbNode->batchWindowMs = windowMs;
+        result = OC_STACK_OK;
+    }
+    OCUnlockStack();
+    return result;
+}
+
+/**
+ * Deliver the batched discovery responses whose batch window has elapsed.
+ */
+static void DeliverDiscoveryBatches(void)
+{
+    uint64_t now = OICGetCurrentTime(TIME_IN_MS);
+    ClientCB *cbNode = g_cbList;
+    while (cbNode)
+    {
+        if (!cbNode->batchResponse || now < cbNode->batchDeadline)
+        {
+            cbNode = cbNode->next;
+            continue;
+        }
+
+        OCClientResponse *response = cbNode->batchResponse;
+        cbNode->batchResponse = NULL;
+        OCStackApplicationResult appFeedback = cbNode->callBack(cbNode->context,
+                                                                cbNode->handle,
+                                                                response);
+        if (appFeedback == OC_STACK_DELETE_TRANSACTION)
+        {
+            DeleteClientCB(cbNode);
+        }
+        else
+        {
+            // To keep discovery callbacks active.
+            cbNode->TTL = GetTicks(MAX_CB_TIMEOUT_SECONDS * MILLISECONDS_PER_SECOND);
+        }
+        OCPayloadDestroy(response->payload);
+        OICFree(response);
+
+        // The callback may have added or deleted callbacks, start over.
+        cbNode = g_cbList;
+    }
+}
+
+/**
+ * Get the time until DeliverDiscoveryBatches has batched responses to deliver.
+ */
+static uint32_t GetDiscoveryBatchTimeout(uint32_t timeoutMs)
+{
+    uint64_t now = 0;
+    ClientCB *cbNode = NULL;
+    LL_FOREACH(g_cbList, cbNode)
+    {
+        if (!cbNode->batchResponse)
+        {
+            continue;
+        }
+        if (!now)
+        {
+            now = OICGetCurrentTime(TIME_IN_MS);
+        }
+        if (cbNode->batchDeadline <= now)
+        {
+            return 0;
+        }
+        if (cbNode->batchDeadline - now < timeoutMs)
+        {
+            timeoutMs = (uint32_t)(cbNode->batchDeadline - now);
+        }
+    }
+    return timeoutMs;
+}
+
 /**
  * @brief   Register Persistent storage callback.
  * @param[in] persistentStorageHandler  Pointers to open, read, write, close & unlink handlers.
@@ -3993,6 +4114,44 @@ exit:
 
     return result;
 }
+
+/**
+ * Get the time until OCProcessPresence has a presence request to send or a
+ * presence subscription to time out.
+ */
+static uint32_t GetPresenceTimeout(uint32_t timeoutMs)
+{
+    uint32_t now = GetTicks(0);
+    ClientCB* cbNode = NULL;
+
+    LL_FOREACH(g_cbList, cbNode)
+    {
+        if (OC_REST_PRESENCE != cbNode->method || !cbNode->presence ||
+            cbNode->presence->TTLlevel > PresenceTimeOutSize)
+        {
+            continue;
+        }
+
+        // The last level times out at once, as in OCProcessPresence.
+        uint32_t expiry = now;
+        if (cbNode->presence->TTLlevel < PresenceTimeOutSize)
+        {
+            expiry = cbNode->presence->timeOut[cbNode->presence->TTLlevel];
+        }
+        if (expiry <= now)
+        {
+            return 0;
+        }
+
+        uint64_t remainingMs = ((uint64_t)(expiry - now) * MILLISECONDS_PER_SECOND) /
+                               COAP_TICKS_PER_SECOND;
+        if (remainingMs < timeoutMs)
+        {
+            timeoutMs = (uint32_t)remainingMs;
+        }
+    }
+    return timeoutMs;
+}
 #endif // WITH_PRESENCE
 
 OCStackResult OC_CALL OCProcess(void)
@@ -4002,10 +4161,16 @@ OCStackResult OC_CALL OCProcess(void)
         OIC_LOG(ERROR, TAG, "OCProcess has failed. ocstack is not initialized");
         return OC_STACK_ERROR;
     }
+
+    OCLockStack();
 #ifdef WITH_PRESENCE
     OCProcessPresence();
 #endif
     CAHandleRequestResponse();
+    HandleAggregateResponseTimeouts();
+    HandleDelayedResponses();
+    DeliverDiscoveryBatches();
+    ProcessObserverNotifications();
 
 #ifdef ROUTING_GATEWAY
     RMProcess();
@@ -4015,9 +4180,76 @@ OCStackResult OC_CALL OCProcess(void)
     ProcessKeepAlive();
     CAProcessPing();
 #endif
+    OCUnlockStack();
     return OC_STACK_OK;
 }
 
+OCStackResult OC_CALL OCGetWakeupFd(int *fd)
+{
+    VERIFY_NON_NULL(fd, ERROR, OC_STACK_INVALID_PARAM);
+    if (stackState == OC_STACK_UNINITIALIZED)
+    {
+        OIC_LOG(ERROR, TAG, "ocstack is not initialized");
+        return OC_STACK_ERROR;
+    }
+    return CAResultToOCResult(CAGetWakeupFd(fd));
+}
+
+uint32_t OC_CALL OCGetProcessTimeout(uint32_t maxTimeoutMs)
+{
+    if (stackState == OC_STACK_UNINITIALIZED)
+    {
+        return maxTimeoutMs;
+    }
+
+    uint32_t timeoutMs = maxTimeoutMs;
+    OCLockStack();
+#ifdef WITH_PRESENCE
+    timeoutMs = GetPresenceTimeout(timeoutMs);
+#endif
+    timeoutMs = GetAggregateResponseTimeout(timeoutMs);
+    timeoutMs = GetDelayedResponseTimeout(timeoutMs);
+    timeoutMs = GetDiscoveryBatchTimeout(timeoutMs);
+    timeoutMs = GetObserverNotificationTimeout(timeoutMs);
+
+#ifdef ROUTING_GATEWAY
+    // The routing manager does not tell when its timers expire, check them regularly.
+    if (ROUTING_PROCESS_INTERVAL_MS < timeoutMs)
+    {
+        timeoutMs = ROUTING_PROCESS_INTERVAL_MS;
+    }
+#endif
+
+#ifdef TCP_ADAPTER
+    timeoutMs = GetKeepAliveTimeout(timeoutMs);
+    timeoutMs = CAGetPingTimeout(timeoutMs);
+#endif
+    OCUnlockStack();
+    return timeoutMs;
+}
+
+OCStackResult OC_CALL OCWaitForWork(uint32_t timeoutMs)
+{
+    return CAResultToOCResult(CAWaitForWakeup(timeoutMs));
+}
+
+OCStackResult OC_CALL OCSignalWakeup(void)
+{
+    return CAResultToOCResult(CASignalWakeup());
+}
+
+OCStackResult OC_CALL OCProcessWait(uint32_t timeoutMs)
+{
+    if (stackState == OC_STACK_UNINITIALIZED)
+    {
+        OIC_LOG(ERROR, TAG, "OCProcessWait has failed. ocstack is not initialized");
+        return OC_STACK_ERROR;
+    }
+
+    OCWaitForWork(OCGetProcessTimeout(timeoutMs));
+    return OCProcess();
+}
+
 #ifdef WITH_PRESENCE
 OCStackResult OC_CALL OCStartPresence(const uint32_t ttl)
 {
@@ -4457,6 +4689,7 @@ OCStackResult OC_CALL OCBindResourceAM(
     }
 
     OIC_LOG(INFO, TAG, "resource bound");
+    InvalidateDiscoveryCache();
 
 #ifdef WITH_PRESENCE
     if (presenceResource.handle)
@@ -4544,6 +4777,7 @@ OCStackResult OC_CALL OCUnBindResource(
             }
 
             OIC_LOG(INFO, TAG, "resource unbound");
+            InvalidateDiscoveryCache();
 
             // Send notification when resource is unbounded successfully.
 #ifdef WITH_PRESENCE
@@ -4734,6 +4968,7 @@ OCStackResult BindTpsTypeToResource(OCResource* resource,
 
     OIC_LOG_V(INFO, TAG, "Binding %d TPS flags to %s", supportedTps, resource->uri);
     resource->endpointType = supportedTps;
+    InvalidateDiscoveryCache();
     return result;
 }
 
@@ -4911,6 +5146,7 @@ OCStackResult OC_CALL OCSetResourceProperties(OCResourceHandle handle, uint8_t r
         return OC_STACK_NO_RESOURCE;
     }
     resource->resourceProperties = (OCResourceProperty) (resource->resourceProperties | resourceProperties);
+    InvalidateDiscoveryCache();
     return OC_STACK_OK;
 }
 
@@ -4925,6 +5161,7 @@ OCStackResult OC_CALL OCClearResourceProperties(OCResourceHandle handle, uint8_t
         return OC_STACK_NO_RESOURCE;
     }
     resource->resourceProperties = (OCResourceProperty) (resource->resourceProperties & ~resourceProperties);
+    InvalidateDiscoveryCache();
     return OC_STACK_OK;
 }
 
@@ -5148,7 +5385,8 @@ OCStackResult SendStopNotification(void)
 }
 
 #endif // WITH_PRESENCE
-OCStackResult OC_CALL OCNotifyAllObservers(OCResourceHandle handle, OCQualityOfService qos)
+static OCStackResult OCNotifyAllObserversInternal(OCResourceHandle handle,
+                                                  OCQualityOfService qos)
 {
     OCResource *resPtr = NULL;
     OCStackResult result = OC_STACK_ERROR;
@@ -5186,6 +5424,14 @@ OCStackResult OC_CALL OCNotifyAllObservers(OCResourceHandle handle, OCQualityOfS
     }
 }
 
+OCStackResult OC_CALL OCNotifyAllObservers(OCResourceHandle handle, OCQualityOfService qos)
+{
+    OCLockStack();
+    OCStackResult result = OCNotifyAllObserversInternal(handle, qos);
+    OCUnlockStack();
+    return result;
+}
+
 OCStackResult
 OC_CALL OCNotifyListOfObservers (OCResourceHandle handle,
                                  OCObservationId  *obsIdList,
@@ -5196,6 +5442,7 @@ OC_CALL OCNotifyListOfObservers (OCResourceHandle handle,
     OIC_LOG(INFO, TAG, "Entering OCNotifyListOfObservers");
 
     OCResource *resPtr = NULL;
+    OCStackResult result = OC_STACK_NO_RESOURCE;
     //TODO: we should allow the server to define this
     uint32_t maxAge = MAX_OBSERVE_AGE;
 
@@ -5203,17 +5450,84 @@ OC_CALL OCNotifyListOfObservers (OCResourceHandle handle,
     VERIFY_NON_NULL(obsIdList, ERROR, OC_STACK_ERROR);
     VERIFY_NON_NULL(payload, ERROR, OC_STACK_ERROR);
 
+    OCLockStack();
     resPtr = findResource ((OCResource *) handle);
-    if (NULL == resPtr || myStackMode == OC_CLIENT)
+    if (NULL != resPtr && myStackMode != OC_CLIENT)
     {
-        return OC_STACK_NO_RESOURCE;
+        incrementSequenceNumber(resPtr);
+        result = SendListObserverNotification(resPtr, obsIdList, numberOfIds,
+                                              payload, maxAge, qos);
     }
-    else
+    OCUnlockStack();
+    return result;
+}
+
+OCStackResult OC_CALL OCSetObserveNotificationPolicy(OCResourceHandle handle,
+                                                     const OCObserveNotificationPolicy *policy)
+{
+    VERIFY_NON_NULL(handle, ERROR, OC_STACK_INVALID_PARAM);
+    VERIFY_NON_NULL(policy, ERROR, OC_STACK_INVALID_PARAM);
+
+    OCStackResult result = OC_STACK_NO_RESOURCE;
+    OCLockStack();
+    OCResource *resPtr = findResource((OCResource *) handle);
+    if (resPtr)
     {
-        incrementSequenceNumber(resPtr);
+        resPtr->observePolicy = *policy;
+        ResourceObserver *observer = NULL;
+        LL_FOREACH(resPtr->observersHead, observer)
+        {
+            observer->policy = *policy;
+        }
+        result = OC_STACK_OK;
+    }
+    OCUnlockStack();
+    return result;
+}
+
+OCStackResult OC_CALL OCSetObserverNotificationPolicy(OCResourceHandle handle,
+                                                      OCObservationId observationId,
+                                                      const OCObserveNotificationPolicy *policy)
+{
+    VERIFY_NON_NULL(handle, ERROR, OC_STACK_INVALID_PARAM);
+    VERIFY_NON_NULL(policy, ERROR, OC_STACK_INVALID_PARAM);
+
+    OCStackResult result = OC_STACK_NO_RESOURCE;
+    OCLockStack();
+    OCResource *resPtr = findResource((OCResource *) handle);
+    if (resPtr)
+    {
+        ResourceObserver *observer = GetObserverUsingId(resPtr, observationId);
+        if (observer)
+        {
+            observer->policy = *policy;
+            result = OC_STACK_OK;
+        }
+        else
+        {
+            result = OC_STACK_OBSERVER_NOT_FOUND;
+        }
+    }
+    OCUnlockStack();
+    return result;
+}
+
+OCStackResult OC_CALL OCGetObserveNotificationStats(OCResourceHandle handle,
+                                                    OCObserveNotificationStats *stats)
+{
+    VERIFY_NON_NULL(handle, ERROR, OC_STACK_INVALID_PARAM);
+    VERIFY_NON_NULL(stats, ERROR, OC_STACK_INVALID_PARAM);
+
+    OCStackResult result = OC_STACK_NO_RESOURCE;
+    OCLockStack();
+    OCResource *resPtr = findResource((OCResource *) handle);
+    if (resPtr)
+    {
+        *stats = resPtr->observeStats;
+        result = OC_STACK_OK;
     }
-    return (SendListObserverNotification(resPtr, obsIdList, numberOfIds,
-            payload, maxAge, qos));
+    OCUnlockStack();
+    return result;
 }
 
 OCStackResult OC_CALL OCDoResponse(OCEntityHandlerResponse *ehResponse)
@@ -5234,7 +5548,9 @@ OCStackResult OC_CALL OCDoResponse(OCEntityHandlerResponse *ehResponse)
     if(serverRequest)
     {
         // response handler in ocserverrequest.c. Usually HandleSingleResponse.
+        OCLockStack();
         result = serverRequest->ehResponseHandler(ehResponse);
+        OCUnlockStack();
     }
 
     OIC_TRACE_END();
@@ -5283,6 +5599,7 @@ OCStackResult OCChangeResourceProperty(OCResourceProperty * inputProperty,
     {
         *inputProperty = (OCResourceProperty) (*inputProperty | resourceProperties);
     }
+    InvalidateDiscoveryCache();
     return OC_STACK_OK;
 }
 #endif
@@ -5446,6 +5763,7 @@ void insertResource(OCResource *resource)
         tailResource = resource;
     }
     resource->next = NULL;
+    InvalidateDiscoveryCache();
 }
 
 OCResource *findResource(OCResource *resource)
@@ -5553,6 +5871,7 @@ OCStackResult deleteResource(OCResource *resource)
                 prev->next = temp->next;
             }
 
+            InvalidateDiscoveryCache();
             deleteResourceElements(temp);
             OICFree(temp);
             temp = NULL;
@@ -5665,6 +5984,7 @@ static void insertResourceType(OCResource *resource, OCResourceType *resourceTyp
     {
         return;
     }
+    InvalidateDiscoveryCache();
     if (isRtsM)
         prsrcType = &(resource->rsrcTypeM);
     else
@@ -5767,6 +6087,7 @@ void insertResourceInterface(OCResource *resource, OCResourceInterface *newInter
     OCResourceInterface *previous = NULL;
 
     newInterface->next = NULL;
+    InvalidateDiscoveryCache();
 
     OCResourceInterface **firstInterface = &(resource->rsrcInterface);
 
@@ -5860,69 +6181,6 @@ OCResourceInterface *findResourceInterfaceAtIndex(OCResourceHandle handle,
     return pointer;
 }
 
-/*
- * This function splits the URI using the '?' delimiter.
- * "uriWithoutQuery" is the block of characters between the beginning
- * till the delimiter or '\0' which ever comes first.
- * "query" is whatever is to the right of the delimiter if present.
- * No delimiter sets the query to NULL.
- * If either are present, they will be malloc'ed into the params 2, 3.
- * The first param, *uri is left untouched.
-
- * NOTE: This function does not account for whitespace at the end of the URI NOR
- *       malformed URIs with '??'. Whitespace at the end will be assumed to be
- *       part of the query.
- */
-OCStackResult getQueryFromUri(const char * uri, char** query, char ** uriWithoutQuery)
-{
-    if(!uri)
-    {
-        return OC_STACK_INVALID_URI;
-    }
-    if(!query || !uriWithoutQuery)
-    {
-        return OC_STACK_INVALID_PARAM;
-    }
-
-    *query           = NULL;
-    *uriWithoutQuery = NULL;
-
-    size_t uriWithoutQueryLen = 0;
-    size_t queryLen = 0;
-    size_t uriLen = strlen(uri);
-
-    char *pointerToDelimiter = strstr(uri, "?");
-
-    uriWithoutQueryLen = pointerToDelimiter == NULL ? uriLen : (size_t)(pointerToDelimiter - uri);
-    queryLen = pointerToDelimiter == NULL ? 0 : uriLen - uriWithoutQueryLen - 1;
-
-    if (uriWithoutQueryLen)
-    {
-        *uriWithoutQuery =  (char *) OICCalloc(uriWithoutQueryLen + 1, 1);
-        if (!*uriWithoutQuery)
-        {
-            goto exit;
-        }
-        OICStrcpy(*uriWithoutQuery, uriWithoutQueryLen +1, uri);
-    }
-    if (queryLen)
-    {
-        *query = (char *) OICCalloc(queryLen + 1, 1);
-        if (!*query)
-        {
-            OICFree(*uriWithoutQuery);
-            *uriWithoutQuery = NULL;
-            goto exit;
-        }
-        OICStrcpy(*query, queryLen + 1, pointerToDelimiter + 1);
-    }
-
-    return OC_STACK_OK;
-
-    exit:
-        return OC_STACK_NO_MEMORY;
-}
-
 static const OicUuid_t* OC_CALL OCGetServerInstanceID(void)
 {
     static OicUuid_t sid;
@@ -617,6 +617,47 @@ void ProcessKeepAlive()
     }
 }
 
+uint32_t GetKeepAliveTimeout(uint32_t timeoutMs)
+{
+    if (!g_isKeepAliveInitialized)
+    {
+        return timeoutMs;
+    }
+
+    uint64_t currentTime = OICGetCurrentTime(TIME_IN_US);
+    size_t len = u_arraylist_length(g_keepAliveConnectionTable);
+    for (size_t i = 0; i < len && timeoutMs; i++)
+    {
+        KeepAliveEntry_t *entry = (KeepAliveEntry_t *)u_arraylist_get(g_keepAliveConnectionTable,
+                                                                      i);
+        if (NULL == entry)
+        {
+            continue;
+        }
+
+        // The same timers as ProcessKeepAlive.
+        uint64_t expiry = entry->timeStamp;
+        if (OC_CLIENT == entry->mode && entry->sentPingMsg)
+        {
+            expiry += KEEPALIVE_RESPONSE_TIMEOUT_SEC * USECS_PER_SEC;
+        }
+        else
+        {
+            expiry += entry->interval * KEEPALIVE_RESPONSE_TIMEOUT_SEC * USECS_PER_SEC;
+        }
+
+        if (expiry <= currentTime)
+        {
+            timeoutMs = 0;
+        }
+        else if ((expiry - currentTime + 999) / 1000 < timeoutMs)
+        {
+            timeoutMs = (uint32_t)((expiry - currentTime + 999) / 1000);
+        }
+    }
+    return timeoutMs;
+}
+
 void IncreaseInterval(KeepAliveEntry_t *entry)
 {
     VERIFY_NON_NULL_NR(entry, FATAL);
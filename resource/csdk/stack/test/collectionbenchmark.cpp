@@ -0,0 +1,284 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+// Latency of a batch interface GET on a collection of 200 children, each taking
+// 5 ms to produce its representation. Requests are fed straight into the stack,
+// the response goes to the loopback discard port. Results are printed as one
+// JSON object per benchmark.
+
+extern "C"
+{
+    #include "ocpayload.h"
+    #include "ocstack.h"
+    #include "ocstackinternal.h"
+    #include "ocserverrequest.h"
+    #include "oic_string.h"
+}
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const int CHILD_COUNT = 200;
+    const int WORKER_COUNT = 16;
+    const std::chrono::milliseconds CHILD_DELAY(5);
+
+    // Serializes the stack between OCProcess and the workers, as the C++ stack does.
+    std::recursive_mutex g_stackLock;
+
+    struct Child
+    {
+        std::string uri;
+        std::chrono::milliseconds delay;
+        bool slow;
+    };
+
+    struct PendingResponse
+    {
+        OCRequestHandle request;
+        OCResourceHandle resource;
+        const Child *child;
+    };
+
+    std::mutex g_queueLock;
+    std::condition_variable g_queueCond;
+    std::deque<PendingResponse> g_queue;
+    bool g_stopWorkers;
+
+    void respond(OCRequestHandle request, OCResourceHandle resource, const Child *child)
+    {
+        OCRepPayload *payload = OCRepPayloadCreate();
+        OCRepPayloadSetPropInt(payload, "value", 1);
+
+        OCEntityHandlerResponse response = {};
+        response.requestHandle = request;
+        response.resourceHandle = resource;
+        response.ehResult = OC_EH_OK;
+        response.payload = (OCPayload *)payload;
+        OICStrcpy(response.resourceUri, sizeof(response.resourceUri), child->uri.c_str());
+
+        {
+            std::lock_guard<std::recursive_mutex> lock(g_stackLock);
+            OCDoResponse(&response);
+        }
+        OCRepPayloadDestroy(payload);
+    }
+
+    void worker()
+    {
+        for (;;)
+        {
+            PendingResponse pending;
+            {
+                std::unique_lock<std::mutex> lock(g_queueLock);
+                g_queueCond.wait(lock, []{ return g_stopWorkers || !g_queue.empty(); });
+                if (g_queue.empty())
+                {
+                    return;
+                }
+                pending = g_queue.front();
+                g_queue.pop_front();
+            }
+            std::this_thread::sleep_for(pending.child->delay);
+            respond(pending.request, pending.resource, pending.child);
+        }
+    }
+
+    OCEntityHandlerResult childHandler(OCEntityHandlerFlag, OCEntityHandlerRequest *ehRequest,
+                                       void *callbackParam)
+    {
+        const Child *child = static_cast<const Child *>(callbackParam);
+        if (!child->slow)
+        {
+            std::this_thread::sleep_for(child->delay);
+            respond(ehRequest->requestHandle, ehRequest->resource, child);
+            return OC_EH_OK;
+        }
+
+        std::lock_guard<std::mutex> lock(g_queueLock);
+        g_queue.push_back({ ehRequest->requestHandle, ehRequest->resource, child });
+        g_queueCond.notify_one();
+        return OC_EH_SLOW;
+    }
+}
+
+class CollectionBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp()
+    {
+        ASSERT_EQ(OC_STACK_OK, OCInit(NULL, 0, OC_SERVER));
+        ASSERT_EQ(OC_STACK_OK, OCCreateResource(&collection, "oic.wk.col",
+                                                OC_RSRVD_INTERFACE_BATCH, "/bench/collection",
+                                                NULL, NULL, OC_DISCOVERABLE));
+
+        g_stopWorkers = false;
+        for (int i = 0; i < WORKER_COUNT; i++)
+        {
+            workers.emplace_back(worker);
+        }
+        token = 0;
+    }
+
+    void TearDown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_queueLock);
+            g_stopWorkers = true;
+            g_queueCond.notify_all();
+        }
+        for (auto &t : workers)
+        {
+            t.join();
+        }
+        workers.clear();
+
+        OCSetBatchResponseTimeout(0);
+        EXPECT_EQ(OC_STACK_OK, OCStop());
+    }
+
+    void addChildren(int count, std::chrono::milliseconds delay, bool slow)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            Child child = { "/bench/child/" + std::to_string(children.size()), delay, slow };
+            children.push_back(child);
+        }
+    }
+
+    void createChildren()
+    {
+        for (auto &child : children)
+        {
+            OCResourceHandle handle;
+            ASSERT_EQ(OC_STACK_OK, OCCreateResource(&handle, "x.bench.child",
+                                                    OC_RSRVD_INTERFACE_DEFAULT,
+                                                    child.uri.c_str(), childHandler, &child,
+                                                    OC_DISCOVERABLE));
+            ASSERT_EQ(OC_STACK_OK, OCBindResource(collection, handle));
+        }
+    }
+
+    // Returns the time until the aggregated response was sent.
+    double batchGet()
+    {
+        uint64_t requestToken = ++token;
+        OCServerProtocolRequest request = {};
+        request.method = OC_REST_GET;
+        request.qos = OC_LOW_QOS;
+        OICStrcpy(request.resourceUrl, sizeof(request.resourceUrl), "/bench/collection");
+        OICStrcpy(request.query, sizeof(request.query), "if=" OC_RSRVD_INTERFACE_BATCH);
+        request.devAddr.adapter = OC_ADAPTER_IP;
+        request.devAddr.flags = OC_IP_USE_V4;
+        OICStrcpy(request.devAddr.addr, sizeof(request.devAddr.addr), "127.0.0.1");
+        request.devAddr.port = 9;
+        request.requestToken = (CAToken_t)&requestToken;
+        request.tokenLength = sizeof(requestToken);
+        request.coapID = (uint16_t)requestToken;
+
+        auto start = std::chrono::steady_clock::now();
+        auto sent = start;
+        {
+            std::lock_guard<std::recursive_mutex> lock(g_stackLock);
+            HandleStackRequests(&request);
+        }
+
+        bool responseSent = false;
+        for (;;)
+        {
+            {
+                std::lock_guard<std::recursive_mutex> lock(g_stackLock);
+                OCProcess();
+                OCServerRequest *pending = GetServerRequestUsingToken(request.requestToken,
+                                                                      request.tokenLength);
+                if (!responseSent && (!pending || pending->aggregateResponseSent))
+                {
+                    sent = std::chrono::steady_clock::now();
+                    responseSent = true;
+                }
+                // Children responding after the deadline still hold the request.
+                if (!pending)
+                {
+                    break;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        std::chrono::duration<double> elapsed = sent - start;
+        return elapsed.count();
+    }
+
+    OCResourceHandle collection;
+    std::vector<Child> children;
+    std::vector<std::thread> workers;
+    uint64_t token;
+};
+
+TEST_F(CollectionBenchmark, SequentialChildren)
+{
+    addChildren(CHILD_COUNT, CHILD_DELAY, false);
+    createChildren();
+
+    double seconds = batchGet();
+    std::cout << "{\"benchmark\":\"SequentialChildren\",\"children\":" << CHILD_COUNT
+              << ",\"childDelayMs\":" << CHILD_DELAY.count()
+              << ",\"latencyMs\":" << (seconds * 1000) << "}" << std::endl;
+}
+
+TEST_F(CollectionBenchmark, SlowChildren)
+{
+    addChildren(CHILD_COUNT, CHILD_DELAY, true);
+    createChildren();
+
+    double seconds = batchGet();
+    std::cout << "{\"benchmark\":\"SlowChildren\",\"children\":" << CHILD_COUNT
+              << ",\"workers\":" << WORKER_COUNT
+              << ",\"childDelayMs\":" << CHILD_DELAY.count()
+              << ",\"latencyMs\":" << (seconds * 1000) << "}" << std::endl;
+
+    EXPECT_LT(seconds, CHILD_COUNT * CHILD_DELAY.count() / 1000.0);
+}
+
+TEST_F(CollectionBenchmark, SlowChildrenWithDeadline)
+{
+    const uint32_t timeoutMs = 200;
+    addChildren(CHILD_COUNT - WORKER_COUNT / 2, CHILD_DELAY, true);
+    addChildren(WORKER_COUNT / 2, std::chrono::milliseconds(2000), true);
+    createChildren();
+    ASSERT_EQ(OC_STACK_OK, OCSetBatchResponseTimeout(timeoutMs));
+
+    double seconds = batchGet();
+    std::cout << "{\"benchmark\":\"SlowChildrenWithDeadline\",\"children\":" << CHILD_COUNT
+              << ",\"workers\":" << WORKER_COUNT
+              << ",\"timeoutMs\":" << timeoutMs
+              << ",\"latencyMs\":" << (seconds * 1000) << "}" << std::endl;
+
+    EXPECT_LT(seconds, 1.0);
+}
@@ -0,0 +1,361 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+// Microbenchmarks of the stack hot paths: payload encoding and decoding,
+// client callback lookup by token, resource lookup by URI, request query
+// parsing, discovery responses and requests issued from several threads
+// while OCProcess runs.
+// Results are printed as one JSON object per benchmark.
+
+extern "C"
+{
+    #include "ocpayload.h"
+    #include "ocpayloadcbor.h"
+    #include "ocstack.h"
+    #include "ocstackinternal.h"
+    #include "occlientcb.h"
+    #include "ocquery.h"
+    #include "ocresourcehandler.h"
+    #include "oic_malloc.h"
+    #include "oic_string.h"
+}
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const int ITERATIONS = 20000;
+    const int LOOKUP_ITERATIONS = 200000;
+    const int DISCOVERY_RESOURCE_COUNT = 50;
+    const int CLIENT_CB_COUNT = 100;
+    const int RESOURCE_COUNT = 200;
+    const int CONCURRENT_REQUESTS = 8000;
+
+    template <typename Op>
+    double nsPerOp(int iterations, Op op)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            op(i);
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    }
+
+    void report(const char *name, int iterations, double ns, const std::string &extra = "")
+    {
+        std::cout << "{\"benchmark\":\"" << name << "\",\"iterations\":" << iterations
+                  << extra << ",\"nsPerOp\":" << ns << "}" << std::endl;
+    }
+
+    // A light as seen in most device profiles, with a nested object and arrays.
+    OCRepPayload *createRepPayload()
+    {
+        OCRepPayload *payload = OCRepPayloadCreate();
+        OCRepPayloadSetUri(payload, "/a/light/1");
+        OCRepPayloadAddResourceType(payload, "oic.r.switch.binary");
+        OCRepPayloadAddResourceType(payload, "oic.r.light.brightness");
+        OCRepPayloadAddInterface(payload, OC_RSRVD_INTERFACE_DEFAULT);
+        OCRepPayloadAddInterface(payload, OC_RSRVD_INTERFACE_ACTUATOR);
+
+        OCRepPayloadSetPropBool(payload, "value", true);
+        OCRepPayloadSetPropInt(payload, "brightness", 42);
+        OCRepPayloadSetPropDouble(payload, "temperature", 2700.5);
+        OCRepPayloadSetPropString(payload, "name", "Living room ceiling");
+
+        OCRepPayload *range = OCRepPayloadCreate();
+        OCRepPayloadSetPropInt(range, "min", 0);
+        OCRepPayloadSetPropInt(range, "max", 100);
+        OCRepPayloadSetPropObjectAsOwner(payload, "range", range);
+
+        int64_t samples[16];
+        for (size_t i = 0; i < 16; i++)
+        {
+            samples[i] = (int64_t)(i * 7);
+        }
+        size_t dimensions[MAX_REP_ARRAY_DEPTH] = { 16, 0, 0 };
+        OCRepPayloadSetIntArray(payload, "samples", samples, dimensions);
+
+        uint8_t bytes[64];
+        for (size_t i = 0; i < sizeof(bytes); i++)
+        {
+            bytes[i] = (uint8_t)i;
+        }
+        OCByteString byteString = { bytes, sizeof(bytes) };
+        OCRepPayloadSetPropByteString(payload, "blob", byteString);
+        return payload;
+    }
+
+    OCDiscoveryPayload *createDiscoveryPayload()
+    {
+        OCDiscoveryPayload *payload = OCDiscoveryPayloadCreate();
+        payload->sid = OICStrdup(OCGetServerInstanceIDString());
+        OCResourcePayloadAddStringLL(&payload->type, OC_RSRVD_RESOURCE_TYPE_RES);
+        OCResourcePayloadAddStringLL(&payload->iface, OC_RSRVD_INTERFACE_LL);
+        OCResourcePayloadAddStringLL(&payload->iface, OC_RSRVD_INTERFACE_DEFAULT);
+
+        for (int i = 0; i < DISCOVERY_RESOURCE_COUNT; i++)
+        {
+            OCResourcePayload *resource = (OCResourcePayload *)OICCalloc(1, sizeof(OCResourcePayload));
+            resource->uri = OICStrdup(("/a/light/" + std::to_string(i)).c_str());
+            OCResourcePayloadAddStringLL(&resource->types, "oic.r.switch.binary");
+            OCResourcePayloadAddStringLL(&resource->interfaces, OC_RSRVD_INTERFACE_DEFAULT);
+            OCResourcePayloadAddStringLL(&resource->interfaces, OC_RSRVD_INTERFACE_ACTUATOR);
+            resource->bitmap = OC_DISCOVERABLE | OC_OBSERVABLE;
+            resource->port = 5683;
+            OCDiscoveryPayloadAddNewResource(payload, resource);
+        }
+        return payload;
+    }
+
+    void benchmarkPayload(const char *convertName, const char *parseName, OCPayload *payload,
+                          OCPayloadType type)
+    {
+        uint8_t *cbor = NULL;
+        size_t size = 0;
+        ASSERT_EQ(OC_STACK_OK, OCConvertPayload(payload, OC_FORMAT_CBOR, &cbor, &size));
+        std::string extra = ",\"bytes\":" + std::to_string(size);
+
+        double ns = nsPerOp(ITERATIONS, [&](int)
+        {
+            uint8_t *out = NULL;
+            size_t outSize = 0;
+            OCConvertPayload(payload, OC_FORMAT_CBOR, &out, &outSize);
+            OICFree(out);
+        });
+        report(convertName, ITERATIONS, ns, extra);
+
+        ns = nsPerOp(ITERATIONS, [&](int)
+        {
+            OCPayload *parsed = NULL;
+            OCParsePayload(&parsed, OC_FORMAT_CBOR, type, cbor, size);
+            OCPayloadDestroy(parsed);
+        });
+        report(parseName, ITERATIONS, ns, extra);
+
+        OICFree(cbor);
+    }
+}
+
+class StackBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp()
+    {
+        ASSERT_EQ(OC_STACK_OK, OCInit(NULL, 0, OC_CLIENT_SERVER));
+    }
+
+    void TearDown()
+    {
+        EXPECT_EQ(OC_STACK_OK, OCStop());
+    }
+};
+
+TEST_F(StackBenchmark, RepPayload)
+{
+    OCRepPayload *payload = createRepPayload();
+    benchmarkPayload("RepPayloadConvert", "RepPayloadParse", (OCPayload *)payload,
+                     PAYLOAD_TYPE_REPRESENTATION);
+    OCRepPayloadDestroy(payload);
+}
+
+TEST_F(StackBenchmark, DiscoveryPayload)
+{
+    OCDiscoveryPayload *payload = createDiscoveryPayload();
+    benchmarkPayload("DiscoveryPayloadConvert", "DiscoveryPayloadParse", (OCPayload *)payload,
+                     PAYLOAD_TYPE_DISCOVERY);
+    OCDiscoveryPayloadDestroy(payload);
+}
+
+TEST_F(StackBenchmark, GetClientCBUsingToken)
+{
+    OCCallbackData cbData = {};
+    cbData.cb = [](void *, OCDoHandle, OCClientResponse *) { return OC_STACK_KEEP_TRANSACTION; };
+
+    std::vector<CAToken_t> tokens;
+    for (int i = 0; i < CLIENT_CB_COUNT; i++)
+    {
+        CAToken_t token = NULL;
+        ASSERT_EQ(CA_STATUS_OK, CAGenerateToken(&token, CA_MAX_TOKEN_LEN));
+        OCDoHandle handle = (OCDoHandle)OICCalloc(1, 1);
+        OCDevAddr *devAddr = (OCDevAddr *)OICCalloc(1, sizeof(OCDevAddr));
+        char *uri = OICStrdup(("/a/light/" + std::to_string(i)).c_str());
+
+        ClientCB *clientCB = NULL;
+        ASSERT_EQ(OC_STACK_OK, AddClientCB(&clientCB, &cbData, CA_MSG_CONFIRM, token,
+                                           CA_MAX_TOKEN_LEN, NULL, 0, NULL, 0, CA_FORMAT_UNDEFINED,
+                                           &handle, OC_REST_GET, devAddr, uri, NULL,
+                                           MAX_CB_TIMEOUT_SECONDS));
+        tokens.push_back(token);
+    }
+
+    double ns = nsPerOp(LOOKUP_ITERATIONS, [&](int i)
+    {
+        CAToken_t token = tokens[(i * 7919) % CLIENT_CB_COUNT];
+        EXPECT_TRUE(NULL != GetClientCBUsingToken(token, CA_MAX_TOKEN_LEN));
+    });
+    report("GetClientCBUsingToken", LOOKUP_ITERATIONS, ns,
+           ",\"callbacks\":" + std::to_string(CLIENT_CB_COUNT));
+}
+
+TEST_F(StackBenchmark, FindResourceByUri)
+{
+    std::vector<std::string> uris;
+    for (int i = 0; i < RESOURCE_COUNT; i++)
+    {
+        uris.push_back("/a/light/" + std::to_string(i));
+        OCResourceHandle handle;
+        ASSERT_EQ(OC_STACK_OK, OCCreateResource(&handle, "oic.r.switch.binary",
+                                                OC_RSRVD_INTERFACE_DEFAULT, uris.back().c_str(),
+                                                NULL, NULL, OC_DISCOVERABLE | OC_OBSERVABLE));
+    }
+
+    double ns = nsPerOp(LOOKUP_ITERATIONS, [&](int i)
+    {
+        EXPECT_TRUE(NULL != FindResourceByUri(uris[(i * 7919) % RESOURCE_COUNT].c_str()));
+    });
+    report("FindResourceByUri", LOOKUP_ITERATIONS, ns,
+           ",\"resources\":" + std::to_string(RESOURCE_COUNT));
+}
+
+TEST_F(StackBenchmark, ParseRequestQuery)
+{
+    const char *uri = "/a/light/1?if=oic.if.baseline;rt=oic.r.switch.binary";
+
+    double ns = nsPerOp(LOOKUP_ITERATIONS, [&](int)
+    {
+        size_t pathLength = 0;
+        OCParsedQuery parsed;
+        const char *interfaceFilter = NULL;
+        const char *resourceTypeFilter = NULL;
+        OCParseQuery(OCGetUriQuery(uri, &pathLength), &parsed);
+        EXPECT_EQ(OC_STACK_OK, OCGetQueryFilters(&parsed, &interfaceFilter, &resourceTypeFilter));
+    });
+    report("ParseRequestQuery", LOOKUP_ITERATIONS, ns);
+}
+
+TEST_F(StackBenchmark, DiscoveryResponse)
+{
+    for (int i = 0; i < DISCOVERY_RESOURCE_COUNT; i++)
+    {
+        OCResourceHandle handle;
+        ASSERT_EQ(OC_STACK_OK, OCCreateResource(&handle, "oic.r.switch.binary",
+                                                OC_RSRVD_INTERFACE_ACTUATOR,
+                                                ("/a/light/" + std::to_string(i)).c_str(),
+                                                NULL, NULL, OC_DISCOVERABLE | OC_OBSERVABLE));
+    }
+
+    uint8_t token[] = { 0xd1, 0x5c };
+    OCServerProtocolRequest request = {};
+    request.method = OC_REST_GET;
+    request.qos = OC_LOW_QOS;
+    OICStrcpy(request.resourceUrl, sizeof(request.resourceUrl), OC_RSRVD_WELL_KNOWN_URI);
+    request.devAddr.adapter = OC_ADAPTER_IP;
+    request.devAddr.flags = OC_IP_USE_V4;
+    OICStrcpy(request.devAddr.addr, sizeof(request.devAddr.addr), "127.0.0.1");
+    request.devAddr.port = 9;
+    request.requestToken = (CAToken_t)token;
+    request.tokenLength = sizeof(token);
+
+    // Invalidating the cache before each request measures building the response.
+    for (bool cached : { false, true })
+    {
+        double ns = nsPerOp(ITERATIONS, [&](int)
+        {
+            if (!cached)
+            {
+                InvalidateDiscoveryCache();
+            }
+            EXPECT_EQ(OC_STACK_OK, HandleStackRequests(&request));
+        });
+        report(cached ? "DiscoveryResponseCached" : "DiscoveryResponse", ITERATIONS, ns,
+               ",\"resources\":" + std::to_string(DISCOVERY_RESOURCE_COUNT) +
+               ",\"responsesPerSec\":" + std::to_string((long long)(1e9 / ns)));
+    }
+}
+
+TEST_F(StackBenchmark, ConcurrentRequests)
+{
+    OCCallbackData cbData = {};
+    cbData.cb = [](void *, OCDoHandle, OCClientResponse *) { return OC_STACK_KEEP_TRANSACTION; };
+
+    OCDevAddr destination = {};
+    destination.adapter = OC_ADAPTER_IP;
+    destination.flags = OC_IP_USE_V4;
+    destination.port = 5683;
+    OICStrcpy(destination.addr, sizeof(destination.addr), "127.0.0.1");
+
+    std::atomic<bool> processing(true);
+    std::thread processThread([&processing]
+    {
+        while (processing)
+        {
+            OCProcessWait(10);
+        }
+    });
+
+    for (int threads : { 1, 2, 4, 8 })
+    {
+        int perThread = CONCURRENT_REQUESTS / threads;
+        std::atomic<int> failures(0);
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> issuers;
+        for (int t = 0; t < threads; t++)
+        {
+            issuers.emplace_back([&, t]
+            {
+                std::string uri = "/a/light/" + std::to_string(t);
+                for (int i = 0; i < perThread; i++)
+                {
+                    OCDoHandle handle = NULL;
+                    if (OC_STACK_OK != OCDoRequest(&handle, OC_REST_GET, uri.c_str(),
+                                                   &destination, NULL, CT_ADAPTER_IP,
+                                                   OC_LOW_QOS, &cbData, NULL, 0)
+                        || OC_STACK_OK != OCCancel(handle, OC_LOW_QOS, NULL, 0))
+                    {
+                        failures++;
+                    }
+                }
+            });
+        }
+        for (auto &issuer : issuers)
+        {
+            issuer.join();
+        }
+
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        EXPECT_EQ(0, failures);
+        report("ConcurrentRequests", perThread * threads, elapsed.count() / (perThread * threads),
+               ",\"threads\":" + std::to_string(threads));
+    }
+
+    processing = false;
+    OCSignalWakeup();
+    processThread.join();
+}
@@ -30,6 +30,8 @@ extern "C"
     #include "oic_time.h"
     #include "ocresourcehandler.h"
     #include "occollection.h"
+    #include "ocquery.h"
+    #include "ocpayloadcbor.h"
     #include "mbedtls/ssl_ciphersuites.h"
     #include "octypes.h"
 #if defined (WITH_POSIX) && (defined (__WITH_DTLS__) || defined(__WITH_TLS__))
@@ -45,6 +47,9 @@ extern "C"
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#ifdef __linux__
+#include <poll.h>
+#endif
 #include <stdlib.h>
 
 //-----------------------------------------------------------------------------
@@ -55,6 +60,9 @@ extern "C"
 
 #include <iostream>
 #include <stdint.h>
+#include <thread>
+#include <atomic>
+#include <vector>
 
 #include "gtest_helper.h"
 
@@ -246,6 +254,108 @@ TEST(StackInit, StackInitInvalidMode)
     EXPECT_EQ(0u, g_ocStackStartCount);
 }
 
+TEST(StackProcessWait, NotInitialized)
+{
+    int fd = -1;
+    EXPECT_EQ(OC_STACK_ERROR, OCGetWakeupFd(&fd));
+    EXPECT_EQ(OC_STACK_ERROR, OCProcessWait(0));
+}
+
+TEST(StackProcessWait, NoTimedWork)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    EXPECT_EQ(OC_STACK_OK, OCInit(0, 0, OC_SERVER));
+    EXPECT_EQ(500u, OCGetProcessTimeout(500));
+    EXPECT_EQ(OC_STACK_OK, OCProcessWait(10));
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
+TEST(StackProcessWait, SignalWakesWaitingThread)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    EXPECT_EQ(OC_STACK_OK, OCInit(0, 0, OC_SERVER));
+
+    std::thread waiter([]
+    {
+        // Returns long before the deadman timer if woken up.
+        EXPECT_EQ(OC_STACK_OK, OCWaitForWork(60000));
+    });
+    EXPECT_EQ(OC_STACK_OK, OCSignalWakeup());
+    waiter.join();
+
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
+#ifdef __linux__
+TEST(StackProcessWait, WakeupFdReadableUntilProcess)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    EXPECT_EQ(OC_STACK_OK, OCInit(0, 0, OC_SERVER));
+
+    int fd = -1;
+    ASSERT_EQ(OC_STACK_OK, OCGetWakeupFd(&fd));
+    struct pollfd pfd = { fd, POLLIN, 0 };
+
+    EXPECT_EQ(OC_STACK_OK, OCSignalWakeup());
+    EXPECT_EQ(1, poll(&pfd, 1, 0));
+    EXPECT_EQ(1, poll(&pfd, 1, 0));
+    EXPECT_EQ(OC_STACK_OK, OCProcess());
+    EXPECT_EQ(0, poll(&pfd, 1, 0));
+
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+#endif
+
+TEST(StackRequests, ConcurrentWithProcess)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    EXPECT_EQ(OC_STACK_OK, OCInit(0, 0, OC_CLIENT));
+
+    OCCallbackData cbData = {};
+    cbData.cb = asyncDoResourcesCallback;
+    cbData.context = (void*)DEFAULT_CONTEXT_VALUE;
+
+    OCDevAddr destination = {};
+    destination.adapter = OC_ADAPTER_IP;
+    destination.flags = OC_IP_USE_V4;
+    destination.port = 5683;
+    OICStrcpy(destination.addr, sizeof(destination.addr), "127.0.0.1");
+
+    std::atomic<bool> processing(true);
+    std::thread processThread([&processing]
+    {
+        while (processing)
+        {
+            EXPECT_EQ(OC_STACK_OK, OCProcessWait(10));
+        }
+    });
+
+    std::vector<std::thread> issuers;
+    for (int t = 0; t < 4; t++)
+    {
+        issuers.emplace_back([&]
+        {
+            for (int i = 0; i < 100; i++)
+            {
+                OCDoHandle handle = NULL;
+                EXPECT_EQ(OC_STACK_OK, OCDoRequest(&handle, OC_REST_GET, "/a/led", &destination,
+                                                   NULL, CT_ADAPTER_IP, OC_LOW_QOS, &cbData,
+                                                   NULL, 0));
+                EXPECT_EQ(OC_STACK_OK, OCCancel(handle, OC_LOW_QOS, NULL, 0));
+            }
+        });
+    }
+    for (auto &issuer : issuers)
+    {
+        issuer.join();
+    }
+
+    processing = false;
+    OCSignalWakeup();
+    processThread.join();
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
 TEST(StackStart, StackStartSuccessClient)
 {
     itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
@@ -2040,6 +2150,392 @@ TEST(StackBind, BindEntityHandlerGood)
     EXPECT_EQ(OC_STACK_OK, OCStop());
 }
 
+static OCEntityHandlerResult batchChildHandler(OCEntityHandlerFlag, OCEntityHandlerRequest *ehRequest,
+                                               void *callbackParam)
+{
+    OCRequestHandle *slowRequest = (OCRequestHandle *)callbackParam;
+    if (slowRequest)
+    {
+        *slowRequest = ehRequest->requestHandle;
+        return OC_EH_SLOW;
+    }
+
+    OCRepPayload *payload = OCRepPayloadCreate();
+    OCEntityHandlerResponse response = {};
+    response.requestHandle = ehRequest->requestHandle;
+    response.resourceHandle = ehRequest->resource;
+    response.ehResult = OC_EH_OK;
+    response.payload = (OCPayload *)payload;
+    EXPECT_EQ(OC_STACK_OK, OCDoResponse(&response));
+    OCRepPayloadDestroy(payload);
+    return OC_EH_OK;
+}
+
+TEST(StackCollection, BatchResponseTimeoutSendsPartialResponse)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    OIC_LOG(INFO, TAG, "Starting BatchResponseTimeoutSendsPartialResponse test");
+    InitStack(OC_SERVER);
+
+    OCRequestHandle slowRequest = NULL;
+    OCResourceHandle collection, fastChild, slowChild;
+    EXPECT_EQ(OC_STACK_OK, OCCreateResource(&collection, "oic.wk.col", OC_RSRVD_INTERFACE_BATCH,
+                                            "/a/collection", NULL, NULL, OC_DISCOVERABLE));
+    EXPECT_EQ(OC_STACK_OK, OCCreateResource(&fastChild, "core.led", "core.rw", "/a/fast",
+                                            batchChildHandler, NULL, OC_DISCOVERABLE));
+    EXPECT_EQ(OC_STACK_OK, OCCreateResource(&slowChild, "core.led", "core.rw", "/a/slow",
+                                            batchChildHandler, &slowRequest, OC_DISCOVERABLE));
+    EXPECT_EQ(OC_STACK_OK, OCBindResource(collection, fastChild));
+    EXPECT_EQ(OC_STACK_OK, OCBindResource(collection, slowChild));
+    EXPECT_EQ(OC_STACK_OK, OCSetBatchResponseTimeout(100));
+
+    uint8_t token[] = { 0xba, 0x7c, 0x40 };
+    OCServerProtocolRequest request = {};
+    request.method = OC_REST_GET;
+    request.qos = OC_LOW_QOS;
+    OICStrcpy(request.resourceUrl, sizeof(request.resourceUrl), "/a/collection");
+    OICStrcpy(request.query, sizeof(request.query), "if=" OC_RSRVD_INTERFACE_BATCH);
+    request.devAddr.adapter = OC_ADAPTER_IP;
+    request.devAddr.flags = OC_IP_USE_V4;
+    OICStrcpy(request.devAddr.addr, sizeof(request.devAddr.addr), "127.0.0.1");
+    request.devAddr.port = 9;
+    request.requestToken = (CAToken_t)token;
+    request.tokenLength = sizeof(token);
+    HandleStackRequests(&request);
+
+    OCServerRequest *serverRequest = GetServerRequestUsingToken(request.requestToken,
+                                                                request.tokenLength);
+    ASSERT_TRUE(NULL != serverRequest);
+    EXPECT_EQ((OCRequestHandle)serverRequest, slowRequest);
+    EXPECT_EQ(1, serverRequest->numResponses);
+
+    while (!serverRequest->aggregateResponseSent)
+    {
+        OCProcess();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // The late response is dropped, and the request freed.
+    OCRepPayload *payload = OCRepPayloadCreate();
+    OCEntityHandlerResponse response = {};
+    response.requestHandle = slowRequest;
+    response.resourceHandle = slowChild;
+    response.ehResult = OC_EH_OK;
+    response.payload = (OCPayload *)payload;
+    EXPECT_EQ(OC_STACK_OK, OCDoResponse(&response));
+    OCRepPayloadDestroy(payload);
+    EXPECT_TRUE(NULL == GetServerRequestUsingToken(request.requestToken, request.tokenLength));
+
+    EXPECT_EQ(OC_STACK_OK, OCSetBatchResponseTimeout(0));
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
+static OCEntityHandlerResult observeHandler(OCEntityHandlerFlag, OCEntityHandlerRequest *ehRequest,
+                                            void *)
+{
+    OCRepPayload *payload = OCRepPayloadCreate();
+    OCEntityHandlerResponse response = {};
+    response.requestHandle = ehRequest->requestHandle;
+    response.resourceHandle = ehRequest->resource;
+    response.ehResult = OC_EH_OK;
+    response.payload = (OCPayload *)payload;
+    EXPECT_EQ(OC_STACK_OK, OCDoResponse(&response));
+    OCRepPayloadDestroy(payload);
+    return OC_EH_OK;
+}
+
+TEST(StackNotify, NotificationPolicy)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    OIC_LOG(INFO, TAG, "Starting NotificationPolicy test");
+    InitStack(OC_SERVER);
+
+    OCResourceHandle handle;
+    EXPECT_EQ(OC_STACK_OK, OCCreateResource(&handle, "core.led", "core.rw", "/a/led",
+                                            observeHandler, NULL,
+                                            OC_DISCOVERABLE|OC_OBSERVABLE));
+    OCObserveNotificationPolicy policy = { 60000, 0, true };
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCSetObserveNotificationPolicy(handle, NULL));
+    EXPECT_EQ(OC_STACK_OK, OCSetObserveNotificationPolicy(handle, &policy));
+    EXPECT_EQ(OC_STACK_OBSERVER_NOT_FOUND, OCSetObserverNotificationPolicy(handle, 0, &policy));
+
+    uint8_t token[] = { 0x0b, 0x5e, 0x77 };
+    OCServerProtocolRequest request = {};
+    request.method = OC_REST_GET;
+    request.qos = OC_LOW_QOS;
+    request.observationOption = OC_OBSERVE_REGISTER;
+    OICStrcpy(request.resourceUrl, sizeof(request.resourceUrl), "/a/led");
+    request.devAddr.adapter = OC_ADAPTER_IP;
+    request.devAddr.flags = OC_IP_USE_V4;
+    OICStrcpy(request.devAddr.addr, sizeof(request.devAddr.addr), "127.0.0.1");
+    request.devAddr.port = 9;
+    request.requestToken = (CAToken_t)token;
+    request.tokenLength = sizeof(token);
+    HandleStackRequests(&request);
+
+    // The first notification is sent, the following ones replace each other until the
+    // interval has elapsed.
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(OC_STACK_OK, OCNotifyAllObservers(handle, OC_LOW_QOS));
+    }
+    OCObserveNotificationStats stats;
+    EXPECT_EQ(OC_STACK_OK, OCGetObserveNotificationStats(handle, &stats));
+    EXPECT_EQ(1u, stats.sent);
+    EXPECT_EQ(8u, stats.coalesced);
+    EXPECT_EQ(0u, stats.dropped);
+    EXPECT_LT(OCGetProcessTimeout(UINT32_MAX), 60001u);
+
+    // Without coalescing, the notifications are dropped instead.
+    policy.coalesce = false;
+    EXPECT_EQ(OC_STACK_OK, OCSetObserveNotificationPolicy(handle, &policy));
+    EXPECT_EQ(OC_STACK_OK, OCNotifyAllObservers(handle, OC_LOW_QOS));
+    EXPECT_EQ(OC_STACK_OK, OCGetObserveNotificationStats(handle, &stats));
+    EXPECT_EQ(1u, stats.sent);
+    EXPECT_EQ(1u, stats.dropped);
+
+    // A zeroed policy sends the notifications, replacing the kept one.
+    policy = OCObserveNotificationPolicy();
+    EXPECT_EQ(OC_STACK_OK, OCSetObserveNotificationPolicy(handle, &policy));
+    EXPECT_EQ(OC_STACK_OK, OCNotifyAllObservers(handle, OC_LOW_QOS));
+    EXPECT_EQ(OC_STACK_OK, OCGetObserveNotificationStats(handle, &stats));
+    EXPECT_EQ(2u, stats.sent);
+    EXPECT_EQ(9u, stats.coalesced);
+
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
+static OCStackResult discoverLocally(const char *query, bool multicast = false)
+{
+    uint8_t token[] = { 0xd1, 0x5c };
+    OCServerProtocolRequest request = {};
+    request.method = OC_REST_GET;
+    request.qos = OC_LOW_QOS;
+    OICStrcpy(request.resourceUrl, sizeof(request.resourceUrl), OC_RSRVD_WELL_KNOWN_URI);
+    OICStrcpy(request.query, sizeof(request.query), query);
+    request.devAddr.adapter = OC_ADAPTER_IP;
+    request.devAddr.flags = multicast ? (OCTransportFlags)(OC_IP_USE_V4 | OC_MULTICAST)
+                                      : OC_IP_USE_V4;
+    OICStrcpy(request.devAddr.addr, sizeof(request.devAddr.addr), "127.0.0.1");
+    request.devAddr.port = 9;
+    request.requestToken = (CAToken_t)token;
+    request.tokenLength = sizeof(token);
+    return HandleStackRequests(&request);
+}
+
+TEST(StackDiscovery, CachedResponseInvalidated)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    OIC_LOG(INFO, TAG, "Starting CachedResponseInvalidated test");
+    InitStack(OC_SERVER);
+
+    // The second requests are answered from the cache, unmatched queries included.
+    EXPECT_EQ(OC_STACK_OK, discoverLocally(""));
+    EXPECT_EQ(OC_STACK_OK, discoverLocally(""));
+    EXPECT_EQ(OC_STACK_CONTINUE, discoverLocally("rt=core.led"));
+    EXPECT_EQ(OC_STACK_CONTINUE, discoverLocally("rt=core.led"));
+
+    OCResourceHandle handle;
+    EXPECT_EQ(OC_STACK_OK, OCCreateResource(&handle, "core.led", "core.rw", "/a/led",
+                                            NULL, NULL, OC_DISCOVERABLE));
+    EXPECT_EQ(OC_STACK_OK, discoverLocally("rt=core.led"));
+    EXPECT_EQ(OC_STACK_CONTINUE, discoverLocally("rt=core.led;if=oic.if.a"));
+
+    EXPECT_EQ(OC_STACK_OK, OCBindResourceInterfaceToResource(handle, "oic.if.a"));
+    EXPECT_EQ(OC_STACK_OK, discoverLocally("rt=core.led;if=oic.if.a"));
+
+    EXPECT_EQ(OC_STACK_OK, OCDeleteResource(handle));
+    EXPECT_EQ(OC_STACK_CONTINUE, discoverLocally("rt=core.led"));
+
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
+TEST(StackDiscovery, MulticastResponseSuppressed)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    OIC_LOG(INFO, TAG, "Starting MulticastResponseSuppressed test");
+    InitStack(OC_SERVER);
+
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCSetMulticastDiscoveryPolicy(NULL));
+    OCMulticastDiscoveryPolicy policy = { 0, 60000 };
+    EXPECT_EQ(OC_STACK_OK, OCSetMulticastDiscoveryPolicy(&policy));
+
+    // The repeated multicast request is ignored, the unicast one is answered.
+    EXPECT_EQ(OC_STACK_OK, discoverLocally("", true));
+    EXPECT_EQ(OC_STACK_CONTINUE, discoverLocally("", true));
+    EXPECT_EQ(OC_STACK_OK, discoverLocally(""));
+
+    // A changed response is sent again.
+    OCResourceHandle handle;
+    EXPECT_EQ(OC_STACK_OK, OCCreateResource(&handle, "core.led", "core.rw", "/a/led",
+                                            NULL, NULL, OC_DISCOVERABLE));
+    EXPECT_EQ(OC_STACK_OK, discoverLocally("", true));
+    EXPECT_EQ(OC_STACK_CONTINUE, discoverLocally("", true));
+
+    policy.suppressionMs = 0;
+    EXPECT_EQ(OC_STACK_OK, OCSetMulticastDiscoveryPolicy(&policy));
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
+TEST(StackDiscovery, MulticastResponseDelayed)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    OIC_LOG(INFO, TAG, "Starting MulticastResponseDelayed test");
+    InitStack(OC_SERVER);
+
+    OCMulticastDiscoveryPolicy policy = { 100, 0 };
+    EXPECT_EQ(OC_STACK_OK, OCSetMulticastDiscoveryPolicy(&policy));
+
+    // The response waits for OCProcess, a retransmission of the request is ignored meanwhile.
+    EXPECT_EQ(OC_STACK_OK, discoverLocally("", true));
+    EXPECT_GE(100u, OCGetProcessTimeout(1000));
+    EXPECT_EQ(OC_STACK_CONTINUE, discoverLocally("", true));
+
+    uint8_t token[] = { 0xd1, 0x5c };
+    while (GetServerRequestUsingToken((CAToken_t)token, sizeof(token)))
+    {
+        OCProcess();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(1000u, OCGetProcessTimeout(1000));
+
+    policy.leisureMs = 0;
+    EXPECT_EQ(OC_STACK_OK, OCSetMulticastDiscoveryPolicy(&policy));
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
+TEST(StackDiscovery, BatchWindow)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    OIC_LOG(INFO, TAG, "Starting BatchWindow test");
+    InitStack(OC_CLIENT);
+
+    OCCallbackData cbData;
+    cbData.cb = asyncDoResourcesCallback;
+    cbData.context = (void*)DEFAULT_CONTEXT_VALUE;
+    cbData.cd = NULL;
+
+    OCDoHandle discoverHandle;
+    EXPECT_EQ(OC_STACK_OK, OCDoResource(&discoverHandle, OC_REST_DISCOVER,
+                                        OC_RSRVD_WELL_KNOWN_URI, NULL, 0, CT_DEFAULT,
+                                        OC_LOW_QOS, &cbData, NULL, 0));
+    EXPECT_EQ(OC_STACK_OK, OCSetDiscoveryBatchWindow(discoverHandle, 500));
+
+    OCDoHandle getHandle;
+    EXPECT_EQ(OC_STACK_OK, OCDoResource(&getHandle, OC_REST_GET, OC_RSRVD_WELL_KNOWN_URI,
+                                        NULL, 0, CT_ADAPTER_IP, OC_LOW_QOS, &cbData, NULL, 0));
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCSetDiscoveryBatchWindow(getHandle, 500));
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCSetDiscoveryBatchWindow(NULL, 500));
+
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
+namespace
+{
+    struct DiscoveryBatch
+    {
+        int calls;
+        bool addrValid;
+        std::string addr;
+        std::vector<std::string> sids;
+    };
+
+    OCStackApplicationResult discoveryBatchCallback(void *ctx, OCDoHandle /*handle*/,
+                                                    OCClientResponse *clientResponse)
+    {
+        DiscoveryBatch *batch = (DiscoveryBatch *)ctx;
+        batch->calls++;
+        batch->addrValid = (clientResponse->addr == &clientResponse->devAddr);
+        batch->addr = clientResponse->devAddr.addr;
+        for (OCDiscoveryPayload *payload = (OCDiscoveryPayload *)clientResponse->payload;
+             payload; payload = payload->next)
+        {
+            batch->sids.push_back(payload->sid ? payload->sid : "");
+        }
+        return OC_STACK_KEEP_TRANSACTION;
+    }
+
+    // Takes a discovery response through the same steps as HandleCAResponses.
+    bool receiveDiscoveryResponse(ClientCB *cbNode, const char *sid, const char *name,
+                                  const char *addr)
+    {
+        OCDiscoveryPayload *payload = OCDiscoveryPayloadCreate();
+        payload->sid = OICStrdup(sid);
+        payload->name = name ? OICStrdup(name) : NULL;
+
+        uint8_t *bytes = NULL;
+        size_t size = 0;
+        EXPECT_EQ(OC_STACK_OK, OCConvertPayload((OCPayload *)payload, OC_FORMAT_CBOR,
+                                                &bytes, &size));
+        bool repeated = CheckDiscoveryResponseReceived(cbNode, bytes, size);
+        OICFree(bytes);
+        if (repeated)
+        {
+            OCDiscoveryPayloadDestroy(payload);
+            return false;
+        }
+
+        OCClientResponse *response = (OCClientResponse *)OICCalloc(1, sizeof(*response));
+        OICStrcpy(response->devAddr.addr, sizeof(response->devAddr.addr), addr);
+        response->devAddr.adapter = OC_ADAPTER_IP;
+        response->devAddr.port = 5683;
+        FixUpClientResponse(response);
+        response->result = OC_STACK_OK;
+        response->payload = (OCPayload *)payload;
+        EXPECT_EQ(OC_STACK_OK, AddDiscoveryBatchResponse(cbNode, response));
+        OCPayloadDestroy(response->payload);
+
+        // The batch must not point into the response, which is freed as it is.
+        memset(response, 0xa5, sizeof(*response));
+        OICFree(response);
+        return true;
+    }
+}
+
+TEST(StackDiscovery, BatchedResponses)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    OIC_LOG(INFO, TAG, "Starting BatchedResponses test");
+    InitStack(OC_CLIENT);
+
+    DiscoveryBatch batch = DiscoveryBatch();
+    OCCallbackData cbData;
+    cbData.cb = discoveryBatchCallback;
+    cbData.context = &batch;
+    cbData.cd = NULL;
+
+    OCDoHandle discoverHandle;
+    ASSERT_EQ(OC_STACK_OK, OCDoResource(&discoverHandle, OC_REST_DISCOVER,
+                                        OC_RSRVD_WELL_KNOWN_URI, NULL, 0, CT_DEFAULT,
+                                        OC_LOW_QOS, &cbData, NULL, 0));
+    ASSERT_EQ(OC_STACK_OK, OCSetDiscoveryBatchWindow(discoverHandle, 200));
+    ClientCB *cbNode = GetClientCBUsingHandle(discoverHandle);
+    ASSERT_TRUE(NULL != cbNode);
+
+    const char *sidA = "11111111-1111-1111-1111-111111111111";
+    const char *sidB = "22222222-2222-2222-2222-222222222222";
+    EXPECT_TRUE(receiveDiscoveryResponse(cbNode, sidA, NULL, "192.168.0.1"));
+    // The same response received on another interface is skipped unparsed.
+    EXPECT_FALSE(receiveDiscoveryResponse(cbNode, sidA, NULL, "192.168.0.3"));
+    EXPECT_TRUE(receiveDiscoveryResponse(cbNode, sidB, NULL, "192.168.0.2"));
+    // Another response of a device already in the batch is parsed, then dropped.
+    EXPECT_TRUE(receiveDiscoveryResponse(cbNode, sidA, "other", "192.168.0.4"));
+
+    EXPECT_EQ(OC_STACK_OK, OCProcess());
+    EXPECT_EQ(0, batch.calls);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_EQ(OC_STACK_OK, OCProcess());
+    EXPECT_EQ(1, batch.calls);
+    EXPECT_TRUE(batch.addrValid);
+    EXPECT_EQ("192.168.0.1", batch.addr);
+    ASSERT_EQ(2u, batch.sids.size());
+    EXPECT_EQ(sidA, batch.sids[0]);
+    EXPECT_EQ(sidB, batch.sids[1]);
+
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
 TEST(StackResourceAccess, GetResourceByIndex)
 {
     itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
@@ -2600,6 +3096,105 @@ TEST(StackHeaderOption, getHeaderOption)
     EXPECT_EQ(8, actualDataSize);
 }
 
+TEST(StackQuery, GetUriQuery)
+{
+    size_t pathLength = 0;
+    EXPECT_STREQ("if=oic.if.ll;rt=oic.r.light",
+                 OCGetUriQuery("/a/light?if=oic.if.ll;rt=oic.r.light", &pathLength));
+    EXPECT_EQ(strlen("/a/light"), pathLength);
+
+    EXPECT_EQ(NULL, OCGetUriQuery("/a/light", &pathLength));
+    EXPECT_EQ(strlen("/a/light"), pathLength);
+
+    EXPECT_EQ(NULL, OCGetUriQuery("/a/light?", &pathLength));
+    EXPECT_EQ(strlen("/a/light"), pathLength);
+
+    EXPECT_STREQ("if=oic.if.ll", OCGetUriQuery("?if=oic.if.ll", &pathLength));
+    EXPECT_EQ(0u, pathLength);
+
+    EXPECT_EQ(NULL, OCGetUriQuery(NULL, &pathLength));
+    EXPECT_EQ(0u, pathLength);
+}
+
+TEST(StackQuery, ParseQuery)
+{
+    OCParsedQuery parsed;
+    EXPECT_EQ(OC_STACK_OK, OCParseQuery("if=oic.if.b&rt=oic.r.light;;flag&x=a=b", &parsed));
+    ASSERT_EQ(4, parsed.numParams);
+    EXPECT_STREQ("if", parsed.params[0].key);
+    EXPECT_STREQ("oic.if.b", parsed.params[0].value);
+    EXPECT_STREQ("rt", parsed.params[1].key);
+    EXPECT_STREQ("oic.r.light", parsed.params[1].value);
+    EXPECT_STREQ("flag", parsed.params[2].key);
+    EXPECT_STREQ("", parsed.params[2].value);
+    EXPECT_STREQ("x", parsed.params[3].key);
+    EXPECT_STREQ("a=b", parsed.params[3].value);
+
+    EXPECT_EQ(OC_STACK_OK, OCParseQuery(NULL, &parsed));
+    EXPECT_EQ(0, parsed.numParams);
+    EXPECT_EQ(OC_STACK_OK, OCParseQuery("", &parsed));
+    EXPECT_EQ(0, parsed.numParams);
+}
+
+TEST(StackQuery, ParseQueryLimits)
+{
+    OCParsedQuery parsed;
+    std::string query = "a=1";
+    for (int i = 1; i < OC_MAX_QUERY_PARAMS; i++)
+    {
+        query += "&a=1";
+    }
+    EXPECT_EQ(OC_STACK_OK, OCParseQuery(query.c_str(), &parsed));
+    EXPECT_EQ(OC_MAX_QUERY_PARAMS, parsed.numParams);
+
+    EXPECT_FALSE(parsed.truncated);
+
+    query += "&a=1";
+    EXPECT_EQ(OC_STACK_INVALID_QUERY, OCParseQuery(query.c_str(), &parsed));
+    EXPECT_TRUE(parsed.truncated);
+
+    std::string longQuery = "if=" + std::string(MAX_QUERY_LENGTH, 'x');
+    EXPECT_EQ(OC_STACK_INVALID_QUERY, OCParseQuery(longQuery.c_str(), &parsed));
+    EXPECT_TRUE(parsed.truncated);
+
+    const char *interfaceFilter = NULL;
+    const char *resourceTypeFilter = NULL;
+    EXPECT_EQ(OC_STACK_INVALID_QUERY,
+              OCGetQueryFilters(&parsed, &interfaceFilter, &resourceTypeFilter));
+}
+
+TEST(StackQuery, GetQueryFilters)
+{
+    OCParsedQuery parsed;
+    const char *interfaceFilter = NULL;
+    const char *resourceTypeFilter = NULL;
+
+    ASSERT_EQ(OC_STACK_OK, OCParseQuery("rt=oic.r.light&IF=oic.if.baseline", &parsed));
+    EXPECT_EQ(OC_STACK_OK, OCGetQueryFilters(&parsed, &interfaceFilter, &resourceTypeFilter));
+    EXPECT_STREQ(OC_RSRVD_INTERFACE_DEFAULT, interfaceFilter);
+    EXPECT_STREQ("oic.r.light", resourceTypeFilter);
+
+    ASSERT_EQ(OC_STACK_OK, OCParseQuery("if=oic.if.ll;if=oic.if.b", &parsed));
+    EXPECT_EQ(OC_STACK_OK, OCGetQueryFilters(&parsed, &interfaceFilter, &resourceTypeFilter));
+    EXPECT_STREQ(OC_RSRVD_INTERFACE_BATCH, interfaceFilter);
+    EXPECT_EQ(NULL, resourceTypeFilter);
+
+    ASSERT_EQ(OC_STACK_OK, OCParseQuery(NULL, &parsed));
+    EXPECT_EQ(OC_STACK_OK, OCGetQueryFilters(&parsed, &interfaceFilter, &resourceTypeFilter));
+    EXPECT_EQ(NULL, interfaceFilter);
+    EXPECT_EQ(NULL, resourceTypeFilter);
+
+    ASSERT_EQ(OC_STACK_OK, OCParseQuery("if=oic.if.ll&di=1234", &parsed));
+    EXPECT_EQ(OC_STACK_INVALID_QUERY,
+              OCGetQueryFilters(&parsed, &interfaceFilter, &resourceTypeFilter));
+    EXPECT_EQ(NULL, interfaceFilter);
+    EXPECT_EQ(NULL, resourceTypeFilter);
+
+    ASSERT_EQ(OC_STACK_OK, OCParseQuery("if=oic.if.ll&rt=oic.r.light&rt=oic.r.fan", &parsed));
+    EXPECT_EQ(OC_STACK_INVALID_QUERY,
+              OCGetQueryFilters(&parsed, &interfaceFilter, &resourceTypeFilter));
+}
+
 TEST(StackEndpoints, OCGetSupportedEndpointTpsFlags)
 {
     itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
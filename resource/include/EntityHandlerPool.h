@@ -0,0 +1,115 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+/**
+ * @file
+ *
+ * This file contains the declaration of EntityHandlerPool, the worker threads
+ * InProcServerWrapper runs entity handlers on when configured to.
+ */
+
+#ifndef OC_ENTITY_HANDLER_POOL_H_
+#define OC_ENTITY_HANDLER_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <octypes.h>
+
+namespace OC
+{
+    /**
+     * Runs tasks on a fixed number of threads, in the order they were posted,
+     * while running at most a given number of tasks per resource at a time.
+     * A task waiting for its resource does not hold up tasks of other resources.
+     */
+    class EntityHandlerPool
+    {
+        public:
+            typedef std::function<void()> Task;
+
+            /**
+             * @param threadCount Number of threads running the tasks.
+             * @param maxTasksPerResource Default maximum number of tasks running at a time
+             *        for a resource, 0 for no limit.
+             */
+            EntityHandlerPool(unsigned int threadCount, unsigned int maxTasksPerResource);
+            ~EntityHandlerPool();
+
+            EntityHandlerPool(const EntityHandlerPool&) = delete;
+            EntityHandlerPool& operator=(const EntityHandlerPool&) = delete;
+
+            /**
+             * Starts the threads. Does nothing if they are running.
+             */
+            void start();
+
+            /**
+             * Waits for the running tasks and stops the threads. Tasks not started are dropped.
+             */
+            void stop();
+
+            /**
+             * Queues a task for a resource.
+             *
+             * @return false if the pool is stopped, in which case the task is not queued.
+             */
+            bool post(OCResourceHandle resource, Task task);
+
+            /**
+             * Sets the maximum number of tasks running at a time for a resource,
+             * 0 for no limit, overriding the default one.
+             */
+            void setMaxTasks(OCResourceHandle resource, unsigned int maxTasks);
+
+            /**
+             * Forgets the limit set for a resource.
+             */
+            void removeResource(OCResourceHandle resource);
+
+        private:
+            struct PendingTask
+            {
+                OCResourceHandle resource;
+                Task task;
+            };
+
+            void worker();
+            std::deque<PendingTask>::iterator findRunnable();
+
+            const unsigned int m_threadCount;
+            const unsigned int m_maxTasksPerResource;
+
+            std::mutex m_lock;
+            std::condition_variable m_cond;
+            bool m_running;
+            std::deque<PendingTask> m_queue;
+            std::map<OCResourceHandle, unsigned int> m_runningTasks;
+            std::map<OCResourceHandle, unsigned int> m_maxTasks;
+            std::vector<std::thread> m_threads;
+    };
+}
+
+#endif // OC_ENTITY_HANDLER_POOL_H_
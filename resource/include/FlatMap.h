@@ -0,0 +1,303 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+/**
+ * @file
+ *
+ * This file contains the definition of FlatMap, the attribute container of
+ * OCRepresentation and RCSResourceAttributes.
+ */
+
+#ifndef OC_FLATMAP_H_
+#define OC_FLATMAP_H_
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OC
+{
+    /**
+     * Associative container keeping its elements sorted by key in one vector.
+     *
+     * A representation holds a handful of attributes, so a binary search over
+     * contiguous storage beats a tree or a hash table, and the whole container
+     * is a single allocation. Elements are usually added in key order, as when
+     * a payload or another FlatMap is copied, and that is an append.
+     *
+     * Unlike std::map, inserting or erasing invalidates iterators and references.
+     */
+    template<typename Key, typename T, typename Compare = std::less<Key>>
+    class FlatMap
+    {
+        private:
+            // The stored pairs need an assignable key to be shifted on insert and erase,
+            // callers only ever see them as value_type with a const key.
+            typedef std::pair<Key, T> stored_type;
+            typedef std::vector<stored_type> container_type;
+
+            template<typename Base, typename Value>
+            class Iterator
+            {
+                public:
+                    typedef std::random_access_iterator_tag iterator_category;
+                    typedef typename std::remove_const<Value>::type value_type;
+                    typedef typename Base::difference_type difference_type;
+                    typedef Value* pointer;
+                    typedef Value& reference;
+
+                    Iterator() = default;
+                    explicit Iterator(Base base) : m_base(base) {}
+
+                    // An iterator converts to a const_iterator.
+                    template<typename OtherBase, typename OtherValue, typename = typename
+                        std::enable_if<std::is_convertible<OtherBase, Base>::value>::type>
+                    Iterator(const Iterator<OtherBase, OtherValue>& other) : m_base(other.base())
+                    {
+                    }
+
+                    const Base& base() const { return m_base; }
+
+                    reference operator*() const { return reinterpret_cast<reference>(*m_base); }
+                    pointer operator->() const { return &**this; }
+                    reference operator[](difference_type n) const { return *(*this + n); }
+
+                    Iterator& operator++() { ++m_base; return *this; }
+                    Iterator operator++(int) { return Iterator(m_base++); }
+                    Iterator& operator--() { --m_base; return *this; }
+                    Iterator operator--(int) { return Iterator(m_base--); }
+                    Iterator& operator+=(difference_type n) { m_base += n; return *this; }
+                    Iterator& operator-=(difference_type n) { m_base -= n; return *this; }
+                    Iterator operator+(difference_type n) const { return Iterator(m_base + n); }
+                    Iterator operator-(difference_type n) const { return Iterator(m_base - n); }
+
+                    friend Iterator operator+(difference_type n, const Iterator& it)
+                    {
+                        return it + n;
+                    }
+
+                    template<typename OtherBase, typename OtherValue>
+                    difference_type operator-(const Iterator<OtherBase, OtherValue>& rhs) const
+                    {
+                        return m_base - rhs.base();
+                    }
+
+                    template<typename OtherBase, typename OtherValue>
+                    bool operator==(const Iterator<OtherBase, OtherValue>& rhs) const
+                    {
+                        return m_base == rhs.base();
+                    }
+
+                    template<typename OtherBase, typename OtherValue>
+                    bool operator!=(const Iterator<OtherBase, OtherValue>& rhs) const
+                    {
+                        return m_base != rhs.base();
+                    }
+
+                    template<typename OtherBase, typename OtherValue>
+                    bool operator<(const Iterator<OtherBase, OtherValue>& rhs) const
+                    {
+                        return m_base < rhs.base();
+                    }
+
+                    template<typename OtherBase, typename OtherValue>
+                    bool operator>(const Iterator<OtherBase, OtherValue>& rhs) const
+                    {
+                        return m_base > rhs.base();
+                    }
+
+                    template<typename OtherBase, typename OtherValue>
+                    bool operator<=(const Iterator<OtherBase, OtherValue>& rhs) const
+                    {
+                        return m_base <= rhs.base();
+                    }
+
+                    template<typename OtherBase, typename OtherValue>
+                    bool operator>=(const Iterator<OtherBase, OtherValue>& rhs) const
+                    {
+                        return m_base >= rhs.base();
+                    }
+
+                private:
+                    Base m_base;
+            };
+
+        public:
+            typedef Key key_type;
+            typedef T mapped_type;
+            typedef std::pair<const Key, T> value_type;
+            typedef typename container_type::size_type size_type;
+            typedef Iterator<typename container_type::iterator, value_type> iterator;
+            typedef Iterator<typename container_type::const_iterator, const value_type>
+                const_iterator;
+
+            FlatMap() = default;
+            FlatMap(const FlatMap&) = default;
+            FlatMap(FlatMap&&) = default;
+            FlatMap& operator=(const FlatMap&) = default;
+            FlatMap& operator=(FlatMap&&) = default;
+
+            iterator begin() { return iterator(m_data.begin()); }
+            const_iterator begin() const { return const_iterator(m_data.begin()); }
+            const_iterator cbegin() const { return const_iterator(m_data.cbegin()); }
+            iterator end() { return iterator(m_data.end()); }
+            const_iterator end() const { return const_iterator(m_data.end()); }
+            const_iterator cend() const { return const_iterator(m_data.cend()); }
+
+            bool empty() const { return m_data.empty(); }
+            size_type size() const { return m_data.size(); }
+            void reserve(size_type count) { m_data.reserve(count); }
+            void clear() { m_data.clear(); }
+            void swap(FlatMap& other) { m_data.swap(other.m_data); }
+
+            iterator find(const Key& key)
+            {
+                auto it = lowerBound(key);
+                return iterator((it != m_data.end() && !Compare()(key, it->first)) ?
+                        it : m_data.end());
+            }
+
+            const_iterator find(const Key& key) const
+            {
+                return const_cast<FlatMap*>(this)->find(key);
+            }
+
+            size_type count(const Key& key) const
+            {
+                return find(key) != end() ? 1 : 0;
+            }
+
+            T& at(const Key& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                {
+                    throw std::out_of_range("FlatMap::at");
+                }
+                return it->second;
+            }
+
+            const T& at(const Key& key) const
+            {
+                return const_cast<FlatMap*>(this)->at(key);
+            }
+
+            T& operator[](const Key& key)
+            {
+                return findOrInsert(key)->second;
+            }
+
+            T& operator[](Key&& key)
+            {
+                return findOrInsert(std::move(key))->second;
+            }
+
+            std::pair<iterator, bool> insert(const value_type& value)
+            {
+                return emplace(value.first, value.second);
+            }
+
+            std::pair<iterator, bool> insert(value_type&& value)
+            {
+                return emplace(std::move(value.first), std::move(value.second));
+            }
+
+            template<typename K, typename V>
+            std::pair<iterator, bool> emplace(K&& key, V&& value)
+            {
+                if (m_data.empty() || Compare()(m_data.back().first, key))
+                {
+                    m_data.emplace_back(std::forward<K>(key), std::forward<V>(value));
+                    return std::make_pair(iterator(m_data.end() - 1), true);
+                }
+
+                auto it = lowerBound(key);
+                if (!Compare()(key, it->first))
+                {
+                    return std::make_pair(iterator(it), false);
+                }
+                return std::make_pair(iterator(m_data.emplace(it, std::forward<K>(key),
+                            std::forward<V>(value))), true);
+            }
+
+            iterator erase(const_iterator pos)
+            {
+                return iterator(m_data.erase(pos.base()));
+            }
+
+            size_type erase(const Key& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                {
+                    return 0;
+                }
+                m_data.erase(it.base());
+                return 1;
+            }
+
+            friend bool operator==(const FlatMap& lhs, const FlatMap& rhs)
+            {
+                return lhs.m_data == rhs.m_data;
+            }
+
+            friend bool operator!=(const FlatMap& lhs, const FlatMap& rhs)
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+            // Only constructs a value if the key is missing.
+            template<typename K>
+            typename container_type::iterator findOrInsert(K&& key)
+            {
+                if (m_data.empty() || Compare()(m_data.back().first, key))
+                {
+                    m_data.emplace_back(std::forward<K>(key), T());
+                    return m_data.end() - 1;
+                }
+
+                auto it = lowerBound(key);
+                if (Compare()(key, it->first))
+                {
+                    it = m_data.emplace(it, std::forward<K>(key), T());
+                }
+                return it;
+            }
+
+            template<typename K>
+            typename container_type::iterator lowerBound(const K& key)
+            {
+                return std::lower_bound(m_data.begin(), m_data.end(), key,
+                        [](const stored_type& item, const K& k)
+                        {
+                            return Compare()(item.first, k);
+                        });
+            }
+
+            container_type m_data;
+    };
+} // namespace OC
+
+#endif // OC_FLATMAP_H_
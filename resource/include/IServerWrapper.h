@@ -82,6 +82,10 @@ namespace OC
                     const OCResourceHandle& resourceHandle,
                     const std::string& resourceInterfaceName) = 0;
 
+        virtual OCStackResult setResourceConcurrency(
+                    const OCResourceHandle& resourceHandle,
+                    unsigned int maxConcurrentRequests) = 0;
+
         virtual OCStackResult startPresence(const unsigned int seconds) = 0;
 
         virtual OCStackResult stopPresence() = 0;
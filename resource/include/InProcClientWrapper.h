@@ -240,6 +240,8 @@ namespace OC
            const HeaderOptions& headerOptions);
         std::thread m_listeningThread;
         bool m_threadRun;
+        // Held around OCProcess and the stack calls that are not thread-safe. Requests,
+        // responses and notifications are serialized by the stack itself.
         std::weak_ptr<std::recursive_mutex> m_csdkLock;
 
     private:
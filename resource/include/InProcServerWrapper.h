@@ -23,11 +23,15 @@
 
 #include <thread>
 #include <mutex>
+#include <map>
+#include <memory>
 
 #include <IServerWrapper.h>
 
 namespace OC
 {
+    class EntityHandlerPool;
+
     class InProcServerWrapper : public IServerWrapper
     {
     public:
@@ -78,6 +82,10 @@ namespace OC
                     const OCResourceHandle& resourceHandle,
                     const std::string& resourceInterface);
 
+        virtual OCStackResult setResourceConcurrency(
+                    const OCResourceHandle& resourceHandle,
+                    unsigned int maxConcurrentRequests);
+
         virtual OCStackResult startPresence(const unsigned int seconds);
 
         virtual OCStackResult stopPresence();
@@ -97,12 +105,31 @@ namespace OC
         virtual OCStackResult start();
 
         virtual OCStackResult getSupportedTransportsInfo(OCTpsSchemeFlags& supportedTps);
+
+        /**
+         * Runs an entity handler on the entity handler threads, if configured.
+         *
+         * @return true if the request was queued and is answered by sendResponse,
+         *         false if the handler has to run on the calling thread.
+         */
+        bool dispatchEntityHandler(const EntityHandler& entityHandler,
+                                   const std::shared_ptr<OCResourceRequest>& request);
     private:
         void processFunc();
+        void completeDispatch(const std::shared_ptr<OCResourceRequest>& request,
+                              uint64_t dispatchId, OCEntityHandlerResult result);
         std::thread m_processThread;
         bool m_threadRun;
+        // Held around OCProcess and the stack calls that are not thread-safe. Requests,
+        // responses and notifications are serialized by the stack itself.
         std::weak_ptr<std::recursive_mutex> m_csdkLock;
         PlatformConfig  m_cfg;
+        std::unique_ptr<EntityHandlerPool> m_entityHandlerPool;
+        // Dispatched requests not answered yet. A request handle may be reused once
+        // answered, so each dispatch is told apart by its id.
+        std::mutex m_dispatchLock;
+        std::map<OCRequestHandle, uint64_t> m_pendingRequests;
+        uint64_t m_lastDispatchId;
     };
 }
 
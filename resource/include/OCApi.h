@@ -175,6 +175,24 @@ namespace OC
          */
         bool                       useLegacyCleanup;
 
+        /**
+         * Number of threads running the entity handlers of the resources registered
+         * through OCPlatform. With 0, the default, entity handlers run on the thread
+         * processing the stack and hold it up for as long as they run.
+         *
+         * Otherwise the stack answers each request as a slow one (OC_EH_SLOW) and the
+         * entity handler runs on one of these threads, responding with
+         * OCPlatform::sendResponse. If it returns an error without responding, an error
+         * response is sent for it.
+         */
+        unsigned int               entityHandlerThreads;
+
+        /**
+         * Maximum number of requests each resource handles at a time on the entity handler
+         * threads, 0 for no limit. OCPlatform::setResourceConcurrency overrides it.
+         */
+        unsigned int               maxConcurrentRequestsPerResource;
+
         public:
             PlatformConfig(const ServiceType serviceType_,
             const ModeType mode_,
@@ -188,7 +206,9 @@ namespace OC
                 port(0),
                 QoS(QualityOfService::NaQos),
                 ps(ps_),
-                useLegacyCleanup(false)
+                useLegacyCleanup(false),
+                entityHandlerThreads(0),
+                maxConcurrentRequestsPerResource(0)
         {}
             /// @deprecated this constructor is deprecated (since 2014.10).
             OC_DEPRECATED_MSG(
@@ -204,7 +224,9 @@ namespace OC
                 port(0),
                 QoS(QualityOfService::NaQos),
                 ps(nullptr),
-                useLegacyCleanup(true)
+                useLegacyCleanup(true),
+                entityHandlerThreads(0),
+                maxConcurrentRequestsPerResource(0)
         {}
             /// @deprecated this constructor is deprecated (since 2017.03).
             OC_DEPRECATED_MSG(
@@ -225,7 +247,9 @@ namespace OC
                 port(0),
                 QoS(QoS_),
                 ps(ps_),
-                useLegacyCleanup(true)
+                useLegacyCleanup(true),
+                entityHandlerThreads(0),
+                maxConcurrentRequestsPerResource(0)
         {}
             /// @deprecated this constructor is deprecated (since 2017.03).
             OC_DEPRECATED_MSG(
@@ -246,7 +270,9 @@ namespace OC
                 port(port_),
                 QoS(QoS_),
                 ps(ps_),
-                useLegacyCleanup(true)
+                useLegacyCleanup(true),
+                entityHandlerThreads(0),
+                maxConcurrentRequestsPerResource(0)
         {}
             /// @deprecated this constructor is deprecated (since 2017.03).
             OC_DEPRECATED_MSG(
@@ -267,7 +293,9 @@ namespace OC
                 ipAddress(ipAddress_),
                 port(port_),
                 QoS(QoS_),
-                ps(ps_)
+                ps(ps_),
+                entityHandlerThreads(0),
+                maxConcurrentRequestsPerResource(0)
         {}
             PlatformConfig(const ServiceType serviceType_,
                            const ModeType mode_,
@@ -283,7 +311,9 @@ namespace OC
                 port(0),
                 QoS(QoS_),
                 ps(ps_),
-                useLegacyCleanup(false)
+                useLegacyCleanup(false),
+                entityHandlerThreads(0),
+                maxConcurrentRequestsPerResource(0)
         {}
             /// @deprecated this constructor is deprecated (since 2017.03).
             OC_DEPRECATED_MSG(
@@ -305,7 +335,9 @@ namespace OC
                 port(0),
                 QoS(QoS_),
                 ps(ps_),
-                useLegacyCleanup(true)
+                useLegacyCleanup(true),
+                entityHandlerThreads(0),
+                maxConcurrentRequestsPerResource(0)
         {}
 
     };
@@ -632,6 +632,16 @@ namespace OC
         OCStackResult bindInterfaceToResource(const OCResourceHandle& resourceHandle,
                         const std::string& resourceInterfaceName);
 
+        /**
+        * Sets the maximum number of requests a resource handles at a time when entity
+        * handlers run on their own threads, see PlatformConfig::entityHandlerThreads.
+        * @param resourceHandle handle to the resource
+        * @param maxConcurrentRequests maximum number of requests, 0 for no limit
+        *
+        * @return Returns ::OC_STACK_OK if success.
+        */
+        OCStackResult setResourceConcurrency(const OCResourceHandle& resourceHandle,
+                        unsigned int maxConcurrentRequests);
 
         /**
         * Start Presence announcements.
@@ -302,6 +302,9 @@ namespace OC
         OCStackResult bindInterfaceToResource(const OCResourceHandle& resourceHandle,
                         const std::string& resourceInterfaceName) const;
 
+        OCStackResult setResourceConcurrency(const OCResourceHandle& resourceHandle,
+                        unsigned int maxConcurrentRequests) const;
+
         OCStackResult startPresence(const unsigned int ttl);
 
         OCStackResult stopPresence();
@@ -34,6 +34,7 @@
 #include <map>
 
 #include <AttributeValue.h>
+#include <FlatMap.h>
 #include <StringConstants.h>
 
 #ifdef __ANDROID__
@@ -85,6 +86,10 @@ namespace OC
     {
         public:
             friend bool operator==(const OC::OCRepresentation&, const OC::OCRepresentation&);
+
+            // Attributes sorted by name, see FlatMap.
+            typedef FlatMap<std::string, AttributeValue> AttributeMap;
+
             // Note: Implementation of all constructors and destructors
             // are all placed in the same location due to a crash that
             // was observed in Android, where merely constructing/destructing
@@ -159,7 +164,7 @@ namespace OC
                 m_values[str] = std::forward<T>(val);
             }
 
-            const std::map<std::string, AttributeValue>& getValues() const {
+            const AttributeMap& getValues() const {
                 return m_values;
             }
 
@@ -358,10 +363,10 @@ namespace OC
 
                 private:
                     AttributeItem(const std::string& name,
-                            std::map<std::string, AttributeValue>& vals);
+                            AttributeMap& vals);
                     AttributeItem(const AttributeItem&) = default;
                     std::string m_attrName;
-                    std::map<std::string, AttributeValue>& m_values;
+                    AttributeMap& m_values;
             };
 
             // Iterator to allow iteration via STL containers/methods
@@ -388,11 +393,11 @@ namespace OC
                     reference operator*();
                     pointer operator->();
                 private:
-                    iterator(std::map<std::string, AttributeValue>::iterator&& itr,
-                            std::map<std::string, AttributeValue>& vals)
+                    iterator(AttributeMap::iterator&& itr,
+                            AttributeMap& vals)
                         : m_iterator(std::move(itr)),
                         m_item(m_iterator != vals.end() ? m_iterator->first:"", vals){}
-                    std::map<std::string, AttributeValue>::iterator m_iterator;
+                    AttributeMap::iterator m_iterator;
                     AttributeItem m_item;
             };
 
@@ -421,11 +426,11 @@ namespace OC
                     const_reference operator*() const;
                     const_pointer operator->() const;
                 private:
-                    const_iterator(std::map<std::string, AttributeValue>::const_iterator&& itr,
-                            std::map<std::string, AttributeValue>& vals)
+                    const_iterator(AttributeMap::const_iterator&& itr,
+                            AttributeMap& vals)
                         : m_iterator(std::move(itr)),
                         m_item(m_iterator != vals.end() ? m_iterator->first: "", vals){}
-                    std::map<std::string, AttributeValue>::const_iterator m_iterator;
+                    AttributeMap::const_iterator m_iterator;
                     AttributeItem m_item;
             };
 
@@ -478,7 +483,7 @@ namespace OC
         private:
             std::string m_uri;
             std::vector<OCRepresentation> m_children;
-            mutable std::map<std::string, AttributeValue> m_values;
+            mutable AttributeMap m_values;
             std::vector<std::string> m_resourceTypes;
             std::vector<std::string> m_interfaces;
             std::vector<std::string> m_dataModelVersions;
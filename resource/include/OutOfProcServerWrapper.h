@@ -107,6 +107,14 @@ namespace OC
             return OC_STACK_NOTIMPL;
         }
 
+        virtual OCStackResult setResourceConcurrency(
+            const OCResourceHandle& /*resourceHandle*/,
+            unsigned int /*maxConcurrentRequests*/)
+        {
+            //Not implemented yet
+            return OC_STACK_NOTIMPL;
+        }
+
         virtual OCStackResult startPresence(const unsigned int /*seconds*/)
         {
             //Not implemented yet
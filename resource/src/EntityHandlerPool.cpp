@@ -0,0 +1,165 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <EntityHandlerPool.h>
+
+#include <utility>
+
+namespace OC
+{
+    EntityHandlerPool::EntityHandlerPool(unsigned int threadCount,
+                                         unsigned int maxTasksPerResource)
+        : m_threadCount(threadCount), m_maxTasksPerResource(maxTasksPerResource),
+          m_running(false)
+    {
+    }
+
+    EntityHandlerPool::~EntityHandlerPool()
+    {
+        stop();
+    }
+
+    void EntityHandlerPool::start()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_running)
+        {
+            return;
+        }
+
+        m_running = true;
+        for (unsigned int i = 0; i < m_threadCount; ++i)
+        {
+            m_threads.emplace_back(&EntityHandlerPool::worker, this);
+        }
+    }
+
+    void EntityHandlerPool::stop()
+    {
+        std::vector<std::thread> threads;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_running = false;
+            m_queue.clear();
+            threads.swap(m_threads);
+        }
+        m_cond.notify_all();
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    bool EntityHandlerPool::post(OCResourceHandle resource, Task task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (!m_running)
+            {
+                return false;
+            }
+            m_queue.push_back(PendingTask{ resource, std::move(task) });
+        }
+        m_cond.notify_one();
+        return true;
+    }
+
+    void EntityHandlerPool::setMaxTasks(OCResourceHandle resource, unsigned int maxTasks)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_maxTasks[resource] = maxTasks;
+        }
+        // A raised limit may let queued tasks run.
+        m_cond.notify_all();
+    }
+
+    void EntityHandlerPool::removeResource(OCResourceHandle resource)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_maxTasks.erase(resource);
+        }
+        m_cond.notify_all();
+    }
+
+    std::deque<EntityHandlerPool::PendingTask>::iterator EntityHandlerPool::findRunnable()
+    {
+        for (auto it = m_queue.begin(); it != m_queue.end(); ++it)
+        {
+            auto limit = m_maxTasks.find(it->resource);
+            unsigned int maxTasks = (limit != m_maxTasks.end()) ? limit->second
+                                                                : m_maxTasksPerResource;
+            if (0 == maxTasks)
+            {
+                return it;
+            }
+
+            auto running = m_runningTasks.find(it->resource);
+            if (running == m_runningTasks.end() || running->second < maxTasks)
+            {
+                return it;
+            }
+        }
+        return m_queue.end();
+    }
+
+    void EntityHandlerPool::worker()
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        for (;;)
+        {
+            auto next = m_queue.end();
+            m_cond.wait(lock, [this, &next]
+                    {
+                        if (!m_running)
+                        {
+                            return true;
+                        }
+                        next = findRunnable();
+                        return next != m_queue.end();
+                    });
+            if (!m_running)
+            {
+                return;
+            }
+
+            PendingTask pending = std::move(*next);
+            m_queue.erase(next);
+            ++m_runningTasks[pending.resource];
+
+            lock.unlock();
+            pending.task();
+            lock.lock();
+
+            auto running = m_runningTasks.find(pending.resource);
+            if (0 == --running->second)
+            {
+                m_runningTasks.erase(running);
+            }
+            // Tasks held back by the limit of this resource may run now.
+            if (!m_queue.empty())
+            {
+                m_cond.notify_all();
+            }
+        }
+    }
+}
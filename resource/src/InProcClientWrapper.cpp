@@ -31,6 +31,9 @@
 
 #define TAG "OIC_CLIENT_WRAPPER"
 
+// Longest time the listening thread waits for the stack to have work.
+static const uint32_t MAX_PROCESS_WAIT_MS = 1000;
+
 using namespace std;
 
 namespace OC
@@ -79,6 +82,7 @@ namespace OC
         if (m_threadRun && m_listeningThread.joinable())
         {
             m_threadRun = false;
+            OCSignalWakeup();
             m_listeningThread.join();
         }
         return OC_STACK_OK;
@@ -89,11 +93,13 @@ namespace OC
         while(m_threadRun)
         {
             OCStackResult result;
+            uint32_t timeoutMs = 0;
             auto cLock = m_csdkLock.lock();
             if (cLock)
             {
                 std::lock_guard<std::recursive_mutex> lock(*cLock);
                 result = OCProcess();
+                timeoutMs = OCGetProcessTimeout(MAX_PROCESS_WAIT_MS);
             }
             else
             {
@@ -105,8 +111,11 @@ namespace OC
                 // TODO: do something with result if failed?
             }
 
-            // To minimize CPU utilization we may wish to do this with sleep
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            // Sleep until the stack has work to do, without holding it.
+            if (OC_STACK_OK != result || OC_STACK_OK != OCWaitForWork(timeoutMs))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
         }
     }
 
@@ -305,7 +314,6 @@ namespace OC
         auto cLock = m_csdkLock.lock();
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
             result = OCDoResource(nullptr, OC_REST_DISCOVER,
                                   resourceUri.str().c_str(),
                                   nullptr, nullptr, connectivityType,
@@ -354,7 +362,6 @@ namespace OC
         auto cLock = m_csdkLock.lock();
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
             result = OCDoResource(nullptr, OC_REST_DISCOVER,
                                   resourceUri.str().c_str(),
                                   nullptr, nullptr, connectivityType,
@@ -452,7 +459,6 @@ namespace OC
         auto cLock = m_csdkLock.lock();
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
             result = OCDoResource(nullptr, OC_REST_DISCOVER,
                                   resourceUri.str().c_str(),
                                   nullptr, nullptr, connectivityType,
@@ -561,7 +567,6 @@ namespace OC
         auto cLock = m_csdkLock.lock();
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
             result = OCDoResource(nullptr, OC_REST_DISCOVER,
                                   resourceUri.str().c_str(),
                                   nullptr, nullptr, connectivityType,
@@ -660,7 +665,6 @@ namespace OC
         auto cLock = m_csdkLock.lock();
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
             OCHeaderOption options[MAX_HEADER_OPTIONS];
             result = OCDoResource(
                                   nullptr, OC_REST_GET,
@@ -730,7 +734,6 @@ namespace OC
         auto cLock = m_csdkLock.lock();
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
             result = OCDoResource(nullptr, OC_REST_DISCOVER,
                                   deviceUri.str().c_str(),
                                   nullptr, nullptr, connectivityType,
@@ -852,7 +855,6 @@ namespace OC
 
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
             OCHeaderOption options[MAX_HEADER_OPTIONS];
 
             result = OCDoResource(nullptr, OC_REST_PUT,
@@ -926,7 +928,6 @@ namespace OC
 
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
             OCHeaderOption options[MAX_HEADER_OPTIONS];
 
             result = OCDoResource(
@@ -1093,7 +1094,6 @@ namespace OC
 
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
             OCHeaderOption options[MAX_HEADER_OPTIONS];
 
             result = OCDoResource(nullptr, OC_REST_POST,
@@ -1140,7 +1140,6 @@ namespace OC
 
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
             OCDoHandle handle;
             OCHeaderOption options[MAX_HEADER_OPTIONS];
 
@@ -1206,8 +1205,6 @@ namespace OC
         {
             OCHeaderOption options[MAX_HEADER_OPTIONS];
 
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
-
             result = OCDoResource(nullptr, OC_REST_DELETE,
                                   uri.c_str(), &devAddr,
                                   nullptr,
@@ -1296,7 +1293,6 @@ namespace OC
 
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
             OCHeaderOption options[MAX_HEADER_OPTIONS];
 
             result = OCDoResource(handle, method,
@@ -1337,7 +1333,6 @@ namespace OC
 
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
             OCHeaderOption options[MAX_HEADER_OPTIONS];
 
             result = OCCancel(handle,
@@ -1420,7 +1415,6 @@ namespace OC
 
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
             result = OCCancel(handle, OC_LOW_QOS, NULL, 0);
         }
         else
@@ -1455,8 +1449,6 @@ namespace OC
 
         if (cLock)
         {
-            std::lock_guard<std::recursive_mutex> lock(*cLock);
-
             std::ostringstream os;
             os << host << OC_RSRVD_DEVICE_PRESENCE_URI;
             QueryParamsList queryParams({{OC_RSRVD_DEVICE_ID, di}});
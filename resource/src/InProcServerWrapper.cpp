@@ -30,6 +30,7 @@
 #include <string>
 
 #include <InProcServerWrapper.h>
+#include <EntityHandlerPool.h>
 #include <InitializeException.h>
 #include <OCResourceRequest.h>
 #include <OCResourceResponse.h>
@@ -45,6 +46,9 @@
 
 #define TAG "OIC_SERVER_WRAPPER"
 
+// Longest time the processing thread waits for the stack to have work.
+static const uint32_t MAX_PROCESS_WAIT_MS = 1000;
+
 using namespace std;
 using namespace OC;
 
@@ -191,7 +195,7 @@ OCEntityHandlerResult DefaultEntityHandlerWrapper(OCEntityHandlerFlag flag,
 
 OCEntityHandlerResult EntityHandlerWrapper(OCEntityHandlerFlag flag,
                                            OCEntityHandlerRequest * entityHandlerRequest,
-                                           void* /*callbackParam*/)
+                                           void* callbackParam)
 {
     OCEntityHandlerResult result = OC_EH_ERROR;
 
@@ -239,6 +243,13 @@ OCEntityHandlerResult EntityHandlerWrapper(OCEntityHandlerFlag flag,
         // Call CPP Application Entity Handler
         if(entityHandlerEntry->second)
         {
+            // A dispatched request is answered from the entity handler threads.
+            auto server = static_cast<OC::InProcServerWrapper*>(callbackParam);
+            if(server && (flag & OC_REQUEST_FLAG) &&
+               server->dispatchEntityHandler(entityHandlerEntry->second, pRequest))
+            {
+                return OC_EH_SLOW;
+            }
             result = entityHandlerEntry->second(pRequest);
         }
         else
@@ -261,14 +272,24 @@ namespace OC
     InProcServerWrapper::InProcServerWrapper(
         std::weak_ptr<std::recursive_mutex> csdkLock, PlatformConfig cfg)
      : m_threadRun(false), m_csdkLock(csdkLock),
-       m_cfg { cfg }
+       m_cfg { cfg }, m_lastDispatchId(0)
     {
+        if (m_cfg.entityHandlerThreads > 0)
+        {
+            m_entityHandlerPool.reset(new EntityHandlerPool(m_cfg.entityHandlerThreads,
+                                            m_cfg.maxConcurrentRequestsPerResource));
+        }
     }
 
     OCStackResult InProcServerWrapper::start()
     {
         OIC_LOG(INFO, TAG, "start");
 
+        if (m_entityHandlerPool)
+        {
+            m_entityHandlerPool->start();
+        }
+
         if (false == m_threadRun)
         {
             m_threadRun = true;
@@ -281,9 +302,16 @@ namespace OC
     {
         OIC_LOG(INFO, TAG, "stop");
 
+        // Running handlers may still respond, so wait for them while the stack is up.
+        if (m_entityHandlerPool)
+        {
+            m_entityHandlerPool->stop();
+        }
+
         if(m_processThread.joinable())
         {
             m_threadRun = false;
+            OCSignalWakeup();
             m_processThread.join();
         }
 
@@ -296,10 +324,12 @@ namespace OC
         while(cLock && m_threadRun)
         {
             OCStackResult result;
+            uint32_t timeoutMs;
 
             {
                 std::lock_guard<std::recursive_mutex> lock(*cLock);
                 result = OCProcess();
+                timeoutMs = OCGetProcessTimeout(MAX_PROCESS_WAIT_MS);
             }
 
             if(OC_STACK_ERROR == result)
@@ -308,7 +338,11 @@ namespace OC
                 // ...the value of variable result is simply ignored for now.
             }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            // Sleep until the stack has work to do, without holding it.
+            if(OC_STACK_OK != OCWaitForWork(timeoutMs))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
         }
     }
 
@@ -428,7 +462,7 @@ namespace OC
                             resourceInterface.c_str(),
                             resourceURI.c_str(), // const char * uri
                             EntityHandlerWrapper, // OCEntityHandler entityHandler
-                            NULL,
+                            this, // void* callbackParam
                             resourceProperties, // uint8_t resourceProperties
                             resourceTpsTypes);  // OCTpsSchemeFlags resourceTpsTypes
             }
@@ -508,6 +542,11 @@ namespace OC
             {
                 throw OCException(OC::Exception::RESOURCE_UNREG_FAILED, result);
             }
+
+            if (m_entityHandlerPool)
+            {
+                m_entityHandlerPool->removeResource(resourceHandle);
+            }
         }
         else
         {
@@ -585,6 +624,89 @@ namespace OC
         return result;
     }
 
+    OCStackResult InProcServerWrapper::setResourceConcurrency(
+                     const OCResourceHandle& resourceHandle,
+                     unsigned int maxConcurrentRequests)
+    {
+        if (!resourceHandle)
+        {
+            return OC_STACK_INVALID_PARAM;
+        }
+
+        // Without entity handler threads requests are handled one at a time anyway.
+        if (m_entityHandlerPool)
+        {
+            m_entityHandlerPool->setMaxTasks(resourceHandle, maxConcurrentRequests);
+        }
+        return OC_STACK_OK;
+    }
+
+    bool InProcServerWrapper::dispatchEntityHandler(const EntityHandler& entityHandler,
+                     const std::shared_ptr<OCResourceRequest>& request)
+    {
+        OCRequestHandle requestHandle = request->getRequestHandle();
+        if (!m_entityHandlerPool || !requestHandle)
+        {
+            return false;
+        }
+
+        uint64_t dispatchId;
+        {
+            std::lock_guard<std::mutex> lock(m_dispatchLock);
+            dispatchId = ++m_lastDispatchId;
+            m_pendingRequests[requestHandle] = dispatchId;
+        }
+
+        bool posted = m_entityHandlerPool->post(request->getResourceHandle(),
+            [this, entityHandler, request, dispatchId]()
+            {
+                OCEntityHandlerResult result = OC_EH_ERROR;
+                try
+                {
+                    result = entityHandler(request);
+                }
+                catch (std::exception& e)
+                {
+                    oclog() << "Exception in entity handler: " << e.what() << std::flush;
+                }
+                completeDispatch(request, dispatchId, result);
+            });
+
+        if (!posted)
+        {
+            std::lock_guard<std::mutex> lock(m_dispatchLock);
+            m_pendingRequests.erase(requestHandle);
+        }
+        return posted;
+    }
+
+    void InProcServerWrapper::completeDispatch(const std::shared_ptr<OCResourceRequest>& request,
+                     uint64_t dispatchId, OCEntityHandlerResult result)
+    {
+        // On success the handler has responded or is going to, as it would inline.
+        if (OC_EH_ERROR != result && result < OC_EH_BAD_REQ)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_dispatchLock);
+            auto pending = m_pendingRequests.find(request->getRequestHandle());
+            if (pending == m_pendingRequests.end() || pending->second != dispatchId)
+            {
+                return;
+            }
+            m_pendingRequests.erase(pending);
+        }
+
+        // The stack sends the error inline, here it has already acknowledged the request.
+        auto pResponse = std::make_shared<OCResourceResponse>();
+        pResponse->setRequestHandle(request->getRequestHandle());
+        pResponse->setResourceHandle(request->getResourceHandle());
+        pResponse->setResponseResult(result);
+        sendResponse(pResponse);
+    }
+
     OCStackResult InProcServerWrapper::startPresence(const unsigned int seconds)
     {
         auto cLock = m_csdkLock.lock();
@@ -697,9 +819,13 @@ namespace OC
                 }
             }
 
+            {
+                std::lock_guard<std::mutex> lock(m_dispatchLock);
+                m_pendingRequests.erase(response.requestHandle);
+            }
+
             if(cLock)
             {
-                std::lock_guard<std::recursive_mutex> lock(*cLock);
                 result = OCDoResponse(&response);
             }
             else
@@ -327,6 +327,13 @@ namespace OC
                                                              resourceInterfaceName);
         }
 
+        OCStackResult setResourceConcurrency(const OCResourceHandle& resourceHandle,
+                                 unsigned int maxConcurrentRequests)
+        {
+            return OCPlatform_impl::Instance().setResourceConcurrency(resourceHandle,
+                                                             maxConcurrentRequests);
+        }
+
         OCStackResult startPresence(const unsigned int announceDurationSeconds)
         {
             return OCPlatform_impl::Instance().startPresence(announceDurationSeconds);
@@ -623,6 +623,13 @@ namespace OC
                              resourceHandle, resourceInterfaceName);
     }
 
+    OCStackResult OCPlatform_impl::setResourceConcurrency(const OCResourceHandle& resourceHandle,
+                                             unsigned int maxConcurrentRequests) const
+    {
+        return checked_guard(m_server, &IServerWrapper::setResourceConcurrency,
+                             resourceHandle, maxConcurrentRequests);
+    }
+
     OCStackResult OCPlatform_impl::startPresence(const unsigned int announceDurationSeconds)
     {
         return checked_guard(m_server, &IServerWrapper::startPresence,
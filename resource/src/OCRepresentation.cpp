@@ -602,6 +602,13 @@ namespace OC
             ll = ll->next;
         }
 
+        size_t numberOfValues = 0;
+        for (OCRepPayloadValue* val = pl->values; val; val = val->next)
+        {
+            ++numberOfValues;
+        }
+        m_values.reserve(numberOfValues);
+
         OCRepPayloadValue* val = pl->values;
 
         while(val)
@@ -885,7 +892,7 @@ namespace OC
 namespace OC
 {
     OCRepresentation::AttributeItem::AttributeItem(const std::string& name,
-            std::map<std::string, AttributeValue>& vals):
+            AttributeMap& vals):
             m_attrName(name), m_values(vals){}
 
     OCRepresentation::AttributeItem OCRepresentation::operator[](const std::string& key)
@@ -0,0 +1,207 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+// Latency of fast requests sent in a burst along with slow ones, with entity
+// handlers run on the stack thread and on entity handler threads. One request in
+// four goes to a resource taking 20 ms to respond, the others respond at once.
+// Requests are fed straight into the stack, the responses go to the loopback
+// discard port. Results are printed as one JSON object per benchmark.
+
+#include <gtest/gtest.h>
+
+#include <InProcServerWrapper.h>
+#include <OCResourceRequest.h>
+#include <OCResourceResponse.h>
+
+extern "C"
+{
+    #include "ocstack.h"
+    #include "ocstackinternal.h"
+    #include "oic_string.h"
+}
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OC
+{
+    namespace test
+    {
+        namespace EntityHandlerBenchmarks
+        {
+            typedef std::chrono::steady_clock Clock;
+
+            const int REQUEST_COUNT = 200;
+            const int SLOW_EVERY = 4;
+            const std::chrono::milliseconds SLOW_DELAY(20);
+            const unsigned int HANDLER_THREADS = 8;
+            const unsigned int SLOW_CONCURRENCY = 4;
+
+            class EntityHandlerBenchmark : public ::testing::Test
+            {
+                protected:
+                    void SetUp()
+                    {
+                        ASSERT_EQ(OC_STACK_OK, OCInit(NULL, 0, OC_SERVER));
+                        m_stackLock = std::make_shared<std::recursive_mutex>();
+                        m_completed = 0;
+                        m_sent.assign(REQUEST_COUNT, Clock::time_point());
+                        m_done.assign(REQUEST_COUNT, Clock::time_point());
+                    }
+
+                    void TearDown()
+                    {
+                        m_server.reset();
+                        EXPECT_EQ(OC_STACK_OK, OCStop());
+                    }
+
+                    void createServer(unsigned int entityHandlerThreads)
+                    {
+                        PlatformConfig cfg(ServiceType::InProc, ModeType::Server, nullptr);
+                        cfg.entityHandlerThreads = entityHandlerThreads;
+                        m_server.reset(new InProcServerWrapper(m_stackLock, cfg));
+                        ASSERT_EQ(OC_STACK_OK, m_server->start());
+
+                        m_fast = registerResource("/bench/fast", std::chrono::milliseconds(0));
+                        m_slow = registerResource("/bench/slow", SLOW_DELAY);
+                    }
+
+                    OCResourceHandle registerResource(const std::string& uri,
+                                                      std::chrono::milliseconds delay)
+                    {
+                        OCResourceHandle handle = nullptr;
+                        std::string resourceUri = uri;
+                        EntityHandler handler = [this, delay](
+                                const std::shared_ptr<OCResourceRequest> request)
+                        {
+                            std::this_thread::sleep_for(delay);
+
+                            auto response = std::make_shared<OCResourceResponse>();
+                            response->setRequestHandle(request->getRequestHandle());
+                            response->setResourceHandle(request->getResourceHandle());
+                            response->setResponseResult(OC_EH_OK);
+                            m_server->sendResponse(response);
+
+                            int id = std::stoi(request->getQueryParameters().at("id"));
+                            std::lock_guard<std::mutex> lock(m_lock);
+                            m_done[id] = Clock::now();
+                            ++m_completed;
+                            m_cond.notify_all();
+                            return OC_EH_OK;
+                        };
+                        EXPECT_EQ(OC_STACK_OK, m_server->registerResource(handle, resourceUri,
+                                    "x.bench", DEFAULT_INTERFACE, handler, OC_DISCOVERABLE));
+                        return handle;
+                    }
+
+                    void sendRequest(int id)
+                    {
+                        uint64_t token = (uint64_t)id + 1;
+                        OCServerProtocolRequest request = {};
+                        request.method = OC_REST_GET;
+                        request.qos = OC_LOW_QOS;
+                        OICStrcpy(request.resourceUrl, sizeof(request.resourceUrl),
+                                  (id % SLOW_EVERY) ? "/bench/fast" : "/bench/slow");
+                        OICStrcpy(request.query, sizeof(request.query),
+                                  ("id=" + std::to_string(id)).c_str());
+                        request.devAddr.adapter = OC_ADAPTER_IP;
+                        request.devAddr.flags = OC_IP_USE_V4;
+                        OICStrcpy(request.devAddr.addr, sizeof(request.devAddr.addr), "127.0.0.1");
+                        request.devAddr.port = 9;
+                        request.requestToken = (CAToken_t)&token;
+                        request.tokenLength = sizeof(token);
+                        request.coapID = (uint16_t)token;
+
+                        m_sent[id] = Clock::now();
+                        std::lock_guard<std::recursive_mutex> lock(*m_stackLock);
+                        HandleStackRequests(&request);
+                    }
+
+                    void run(const std::string& name, unsigned int entityHandlerThreads)
+                    {
+                        auto start = Clock::now();
+                        for (int id = 0; id < REQUEST_COUNT; ++id)
+                        {
+                            sendRequest(id);
+                        }
+                        {
+                            std::unique_lock<std::mutex> lock(m_lock);
+                            ASSERT_TRUE(m_cond.wait_for(lock, std::chrono::seconds(30),
+                                        [this]{ return m_completed == REQUEST_COUNT; }));
+                        }
+                        std::chrono::duration<double, std::milli> total = Clock::now() - start;
+
+                        std::vector<double> fastLatencies;
+                        for (int id = 0; id < REQUEST_COUNT; ++id)
+                        {
+                            if (id % SLOW_EVERY)
+                            {
+                                std::chrono::duration<double, std::milli> latency =
+                                    m_done[id] - m_sent[id];
+                                fastLatencies.push_back(latency.count());
+                            }
+                        }
+                        std::sort(fastLatencies.begin(), fastLatencies.end());
+
+                        std::cout << "{\"benchmark\":\"" << name << "\""
+                                  << ",\"requests\":" << REQUEST_COUNT
+                                  << ",\"slowRequests\":" << REQUEST_COUNT / SLOW_EVERY
+                                  << ",\"slowDelayMs\":" << SLOW_DELAY.count()
+                                  << ",\"handlerThreads\":" << entityHandlerThreads
+                                  << ",\"fastP50Ms\":" << fastLatencies[fastLatencies.size() / 2]
+                                  << ",\"fastP99Ms\":"
+                                  << fastLatencies[fastLatencies.size() * 99 / 100]
+                                  << ",\"totalMs\":" << total.count() << "}" << std::endl;
+                    }
+
+                    std::shared_ptr<std::recursive_mutex> m_stackLock;
+                    std::unique_ptr<InProcServerWrapper> m_server;
+                    OCResourceHandle m_fast;
+                    OCResourceHandle m_slow;
+
+                    std::mutex m_lock;
+                    std::condition_variable m_cond;
+                    int m_completed;
+                    std::vector<Clock::time_point> m_sent;
+                    std::vector<Clock::time_point> m_done;
+            };
+
+            TEST_F(EntityHandlerBenchmark, InlineHandlers)
+            {
+                createServer(0);
+                run("InlineHandlers", 0);
+            }
+
+            TEST_F(EntityHandlerBenchmark, PooledHandlers)
+            {
+                createServer(HANDLER_THREADS);
+                ASSERT_EQ(OC_STACK_OK, m_server->setResourceConcurrency(m_slow, SLOW_CONCURRENCY));
+                run("PooledHandlers", HANDLER_THREADS);
+            }
+        }
+    }
+}
@@ -0,0 +1,198 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <gtest/gtest.h>
+#include <EntityHandlerPool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace OC
+{
+    namespace test
+    {
+        namespace EntityHandlerPoolTests
+        {
+            // Counts the tasks running at a time and lets a test hold them.
+            class TaskTracker
+            {
+                public:
+                    TaskTracker() : m_running(0), m_maxRunning(0), m_done(0), m_held(false) {}
+
+                    EntityHandlerPool::Task task()
+                    {
+                        return [this]
+                        {
+                            std::unique_lock<std::mutex> lock(m_lock);
+                            m_maxRunning = std::max(m_maxRunning, ++m_running);
+                            m_cond.notify_all();
+                            m_cond.wait(lock, [this]{ return !m_held; });
+                            --m_running;
+                            ++m_done;
+                            m_cond.notify_all();
+                        };
+                    }
+
+                    void hold()
+                    {
+                        std::lock_guard<std::mutex> lock(m_lock);
+                        m_held = true;
+                    }
+
+                    void release()
+                    {
+                        std::lock_guard<std::mutex> lock(m_lock);
+                        m_held = false;
+                        m_cond.notify_all();
+                    }
+
+                    bool waitRunning(int count)
+                    {
+                        std::unique_lock<std::mutex> lock(m_lock);
+                        return m_cond.wait_for(lock, std::chrono::seconds(5),
+                                               [this, count]{ return m_running >= count; });
+                    }
+
+                    bool waitDone(int count)
+                    {
+                        std::unique_lock<std::mutex> lock(m_lock);
+                        return m_cond.wait_for(lock, std::chrono::seconds(5),
+                                               [this, count]{ return m_done >= count; });
+                    }
+
+                    int maxRunning()
+                    {
+                        std::lock_guard<std::mutex> lock(m_lock);
+                        return m_maxRunning;
+                    }
+
+                private:
+                    std::mutex m_lock;
+                    std::condition_variable m_cond;
+                    int m_running;
+                    int m_maxRunning;
+                    int m_done;
+                    bool m_held;
+            };
+
+            int resourceA;
+            int resourceB;
+
+            TEST(EntityHandlerPoolTest, PostFailsWhenStopped)
+            {
+                EntityHandlerPool pool(1, 0);
+                TaskTracker tracker;
+
+                EXPECT_FALSE(pool.post(&resourceA, tracker.task()));
+                pool.start();
+                EXPECT_TRUE(pool.post(&resourceA, tracker.task()));
+                EXPECT_TRUE(tracker.waitDone(1));
+                pool.stop();
+                EXPECT_FALSE(pool.post(&resourceA, tracker.task()));
+            }
+
+            TEST(EntityHandlerPoolTest, RunsTasksConcurrently)
+            {
+                EntityHandlerPool pool(4, 0);
+                pool.start();
+                TaskTracker tracker;
+                tracker.hold();
+
+                for (int i = 0; i < 4; ++i)
+                {
+                    EXPECT_TRUE(pool.post(&resourceA, tracker.task()));
+                }
+                EXPECT_TRUE(tracker.waitRunning(4));
+                tracker.release();
+                EXPECT_TRUE(tracker.waitDone(4));
+            }
+
+            TEST(EntityHandlerPoolTest, LimitsTasksPerResource)
+            {
+                EntityHandlerPool pool(4, 2);
+                pool.start();
+                TaskTracker tracker;
+                tracker.hold();
+
+                for (int i = 0; i < 6; ++i)
+                {
+                    EXPECT_TRUE(pool.post(&resourceA, tracker.task()));
+                }
+                EXPECT_TRUE(tracker.waitRunning(2));
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                tracker.release();
+                EXPECT_TRUE(tracker.waitDone(6));
+                EXPECT_EQ(2, tracker.maxRunning());
+            }
+
+            TEST(EntityHandlerPoolTest, RunsOtherResourceWhileOneIsAtItsLimit)
+            {
+                EntityHandlerPool pool(2, 1);
+                pool.start();
+                TaskTracker heldTracker;
+                TaskTracker tracker;
+                heldTracker.hold();
+
+                EXPECT_TRUE(pool.post(&resourceA, heldTracker.task()));
+                EXPECT_TRUE(pool.post(&resourceA, heldTracker.task()));
+                EXPECT_TRUE(pool.post(&resourceB, tracker.task()));
+
+                EXPECT_TRUE(tracker.waitDone(1));
+                heldTracker.release();
+                EXPECT_TRUE(heldTracker.waitDone(2));
+                EXPECT_EQ(1, heldTracker.maxRunning());
+            }
+
+            TEST(EntityHandlerPoolTest, SetMaxTasksOverridesDefault)
+            {
+                EntityHandlerPool pool(4, 1);
+                pool.start();
+                pool.setMaxTasks(&resourceA, 3);
+                TaskTracker tracker;
+                tracker.hold();
+
+                for (int i = 0; i < 4; ++i)
+                {
+                    EXPECT_TRUE(pool.post(&resourceA, tracker.task()));
+                }
+                EXPECT_TRUE(tracker.waitRunning(3));
+                tracker.release();
+                EXPECT_TRUE(tracker.waitDone(4));
+                EXPECT_EQ(3, tracker.maxRunning());
+
+                pool.removeResource(&resourceA);
+                TaskTracker defaultTracker;
+                defaultTracker.hold();
+                for (int i = 0; i < 2; ++i)
+                {
+                    EXPECT_TRUE(pool.post(&resourceA, defaultTracker.task()));
+                }
+                EXPECT_TRUE(defaultTracker.waitRunning(1));
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                defaultTracker.release();
+                EXPECT_TRUE(defaultTracker.waitDone(2));
+                EXPECT_EQ(1, defaultTracker.maxRunning());
+            }
+        }
+    }
+}
@@ -0,0 +1,149 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <gtest/gtest.h>
+#include <FlatMap.h>
+
+#include <string>
+#include <type_traits>
+
+namespace OC
+{
+    namespace test
+    {
+        namespace FlatMapTests
+        {
+            typedef FlatMap<std::string, int> IntMap;
+
+            TEST(FlatMapTest, IteratesInKeyOrder)
+            {
+                IntMap map;
+                map["c"] = 3;
+                map["a"] = 1;
+                map["b"] = 2;
+
+                std::string keys;
+                int sum = 0;
+                for (const auto& item : map)
+                {
+                    keys += item.first;
+                    sum += item.second;
+                }
+                EXPECT_EQ("abc", keys);
+                EXPECT_EQ(6, sum);
+            }
+
+            TEST(FlatMapTest, IteratorsExposeConstKeys)
+            {
+                static_assert(std::is_same<const std::string&,
+                        decltype((std::declval<IntMap::iterator>()->first))>::value,
+                        "keys must not be writable through an iterator");
+
+                IntMap map;
+                map["a"] = 1;
+                map["b"] = 2;
+
+                IntMap::iterator it = map.find("b");
+                it->second = 3;
+                IntMap::const_iterator cit = it;
+                EXPECT_EQ(cit, map.cbegin() + 1);
+                EXPECT_EQ(1, map.end() - cit);
+                EXPECT_EQ(3, map.at("b"));
+
+                map.erase(map.cbegin());
+                EXPECT_EQ("b", map.begin()->first);
+            }
+
+            TEST(FlatMapTest, IndexReturnsExistingValue)
+            {
+                IntMap map;
+                map["a"] = 1;
+                map["a"] += 1;
+
+                EXPECT_EQ(1u, map.size());
+                EXPECT_EQ(2, map["a"]);
+            }
+
+            TEST(FlatMapTest, FindMissingKey)
+            {
+                IntMap map;
+                EXPECT_TRUE(map.find("a") == map.end());
+
+                map["b"] = 2;
+                EXPECT_TRUE(map.find("a") == map.end());
+                EXPECT_TRUE(map.find("c") == map.end());
+                EXPECT_EQ(0u, map.count("a"));
+                EXPECT_EQ(1u, map.count("b"));
+            }
+
+            TEST(FlatMapTest, AtThrowsForMissingKey)
+            {
+                IntMap map;
+                map["a"] = 1;
+
+                EXPECT_EQ(1, map.at("a"));
+                EXPECT_THROW(map.at("b"), std::out_of_range);
+            }
+
+            TEST(FlatMapTest, EmplaceDoesNotReplace)
+            {
+                IntMap map;
+                EXPECT_TRUE(map.emplace("b", 2).second);
+                EXPECT_TRUE(map.emplace("a", 1).second);
+
+                auto result = map.emplace("b", 3);
+                EXPECT_FALSE(result.second);
+                EXPECT_EQ(2, result.first->second);
+            }
+
+            TEST(FlatMapTest, Erase)
+            {
+                IntMap map;
+                map["a"] = 1;
+                map["b"] = 2;
+                map["c"] = 3;
+
+                EXPECT_EQ(1u, map.erase("b"));
+                EXPECT_EQ(0u, map.erase("b"));
+
+                auto next = map.erase(map.find("a"));
+                ASSERT_TRUE(next != map.end());
+                EXPECT_EQ("c", next->first);
+                EXPECT_EQ(1u, map.size());
+            }
+
+            TEST(FlatMapTest, EqualityDoesNotDependOnInsertionOrder)
+            {
+                IntMap lhs;
+                lhs["a"] = 1;
+                lhs["b"] = 2;
+
+                IntMap rhs;
+                rhs["b"] = 2;
+                rhs["a"] = 1;
+
+                EXPECT_TRUE(lhs == rhs);
+
+                rhs["b"] = 3;
+                EXPECT_TRUE(lhs != rhs);
+            }
+        }
+    }
+}
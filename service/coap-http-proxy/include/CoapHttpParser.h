@@ -144,7 +144,9 @@ OCStackResult CHPParserInitialize(void);
 OCStackResult CHPParserTerminate(void);
 
 /**
- * Function to initiate TCP session and post HTTP request. If the method returns
+ * Function to initiate TCP session and post HTTP request. Connections to the HTTP server are
+ * kept open and reused, and GET responses with a freshness lifetime are answered from the
+ * response cache until they expire. If the method returns
  * success, payload might be cached by the parser (req->payloadCached) and caller shall not free the
  * payload if the flag is set.
  * @param[in]   req         Object containing HTTP request information.
@@ -154,6 +156,16 @@ OCStackResult CHPParserTerminate(void);
 OCStackResult CHPPostHttpRequest(HttpRequest_t *req, CHPResponseCallback httpcb,
                                  void *context);
 
+/**
+ * Function to get the freshness lifetime carried by a Cache-Control (s-maxage, max-age,
+ * no-cache, no-store, private) or Expires header option, as used for CoAP Max-Age and the
+ * response cache. Cache-Control directives are matched as whole tokens ignoring case.
+ * @param[in]   option      HTTP header option.
+ * @param[out]  maxAge      Lifetime in seconds, 0 if the response is stale.
+ * @return OC_STACK_OK if the option carries a lifetime, OC_STACK_INVALID_OPTION otherwise.
+ */
+OCStackResult CHPGetMaxAge(const HttpHeaderOption_t *option, uint32_t *maxAge);
+
 /**
  * Macro to verify the validity of input argument.
  *
@@ -378,6 +378,7 @@ void CHPHandleHttpResponse(const HttpResponse_t *httpResponse, void *context)
     response.numSendVendorSpecificHeaderOptions = 0;
     OCHeaderOption *optionsPointer = response.sendVendorSpecificHeaderOptions;
 
+    bool maxAgeAdded = false;
     size_t tempOptionNumber = u_arraylist_length(httpResponse->headerOptions);
     for (size_t numOptions = 0; (numOptions < tempOptionNumber) &&
                              (response.numSendVendorSpecificHeaderOptions < MAX_HEADER_OPTIONS);
@@ -392,6 +393,16 @@ void CHPHandleHttpResponse(const HttpResponse_t *httpResponse, void *context)
             continue;
         }
 
+        // Cache-Control and Expires both map onto Max-Age, which may appear only once
+        if (COAP_OPTION_MAXAGE == optionsPointer->optionID)
+        {
+            if (maxAgeAdded)
+            {
+                continue;
+            }
+            maxAgeAdded = true;
+        }
+
         response.numSendVendorSpecificHeaderOptions++;
         optionsPointer += 1;
     }
@@ -157,6 +157,31 @@ OCStackResult CHPGetOCOption(const HttpHeaderOption_t *httpOption, OCHeaderOptio
     }
 
     ocfOption->protocolID = OC_COAP_ID;
+    if (COAP_OPTION_MAXAGE == ocfOption->optionID)
+    {
+        // Max-Age is a CoAP uint option holding seconds, not the HTTP header text
+        uint32_t maxAge = 0;
+        OCStackResult ret = CHPGetMaxAge(httpOption, &maxAge);
+        if (OC_STACK_OK != ret)
+        {
+            OIC_LOG(INFO, TAG, "No lifetime in HTTP cache option");
+            return ret;
+        }
+
+        ocfOption->optionLength = 0;
+        for (int shift = 24; shift >= 0; shift -= 8)
+        {
+            uint8_t byte = (uint8_t)(maxAge >> shift);
+            if (byte || ocfOption->optionLength)
+            {
+                ocfOption->optionData[ocfOption->optionLength++] = byte;
+            }
+        }
+
+        OIC_LOG(DEBUG, TAG, "CHPGetCoAPOption OUT");
+        return OC_STACK_OK;
+    }
+
     ocfOption->optionLength = httpOption->optionLength < sizeof(ocfOption->optionData) ?
                                 httpOption->optionLength : sizeof(ocfOption->optionData);
     memcpy(ocfOption->optionData,  httpOption->optionData, ocfOption->optionLength);
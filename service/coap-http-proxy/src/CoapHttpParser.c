@@ -27,10 +27,12 @@
 #include "CoapHttpParser.h"
 #include "oic_malloc.h"
 #include "oic_string.h"
+#include "oic_time.h"
 #include "uarraylist.h"
 #include "experimental/logger.h"
 
 #include <string.h>
+#include <strings.h>
 #include <curl/curl.h>
 #ifdef HAVE_PTHREAD_H
 #include <pthread.h>
@@ -44,11 +46,30 @@
 #include <sys/select.h>
 #endif //!defined(_WIN32)
 #include <errno.h>
+#include <time.h>
 
 #define TAG "CHP_PARSER"
 
 #define DEFAULT_USER_AGENT "IoTivity"
 #define MAX_PAYLOAD_SIZE (1048576U) // 1 MB
+#define INITIAL_PAYLOAD_SIZE (1024U)
+
+/* Idle easy handles kept for reuse by later requests */
+#define EASY_HANDLE_POOL_SIZE (16)
+/* Parallel connections per HTTP host, requests beyond this are queued by libcurl */
+#define MAX_HOST_CONNECTIONS (8L)
+/* Idle connections kept open in the connection cache of the multi handle */
+#define MAX_CACHED_CONNECTIONS (32L)
+/* Number of GET responses kept in the response cache */
+#define RESPONSE_CACHE_SIZE (64)
+
+#define CACHE_CONTROL_MAX_AGE "max-age"
+#define CACHE_CONTROL_S_MAXAGE "s-maxage"
+#define CACHE_CONTROL_PUBLIC "public"
+
+#define HTTP_OPTION_VARY "vary"
+#define HTTP_OPTION_AUTHORIZATION "authorization"
+#define HTTP_OPTION_COOKIE "cookie"
 
 typedef struct
 {
@@ -66,8 +87,25 @@ typedef struct
     CURL* easyHandle;
     /* libcurl does not copy header options passed to a request */
     struct curl_slist *list;
+    /* Allocated size of resp.payload */
+    size_t payloadCapacity;
+    /* Response is stored in response cache, set for GET requests only */
+    char *cacheUri;
+    char *cacheAccept;
+    /* Request carried credentials, its response is only cached if marked shareable */
+    bool cacheAuthorized;
 } CHPContext_t;
 
+/* Cached response of a GET request, keyed by resource URI and accept format */
+typedef struct
+{
+    char *uri;
+    char *accept;
+    /* Absolute time in ms after which the response is stale */
+    uint64_t expiresAt;
+    HttpResponse_t resp;
+} CHPCacheEntry_t;
+
 /* A curl mutihandle is not threadsafe so we require mutexes to add new easy
  * handles to multihandle.
  */
@@ -97,8 +135,25 @@ static int g_refreshFds[2];
  */
 static pthread_t g_multiHandleThread;
 
+/*
+ * Easy handles of completed transfers. Reusing them keeps their DNS and TLS session
+ * caches, the connections themselves are shared through the multi handle.
+ * Guarded by g_multiHandleMutex.
+ */
+static CURL *g_easyHandlePool[EASY_HANDLE_POOL_SIZE];
+static size_t g_easyHandlePoolCount;
+
+/*
+ * Response cache and responses served from it which are waiting to be delivered by
+ * the multi_handle thread. Guarded by g_multiHandleMutex.
+ */
+static CHPCacheEntry_t g_responseCache[RESPONSE_CACHE_SIZE];
+static u_arraylist_t *g_cachedResponses;
+
 static void CHPParserLockMutex(void);
 static void CHPParserUnlockMutex(void);
+static void CHPFreeContext(CHPContext_t *ctxt);
+static void CHPParserSignalRefresh(void);
 
 static void CHPParserResetHeaderOptions(u_arraylist_t** headerOptions)
 {
@@ -112,6 +167,314 @@ static void CHPParserResetHeaderOptions(u_arraylist_t** headerOptions)
     u_arraylist_free(headerOptions);
 }
 
+/* Shall be called with g_multiHandleMutex held */
+static CURL *CHPAcquireEasyHandle(void)
+{
+    if (g_easyHandlePoolCount)
+    {
+        return g_easyHandlePool[--g_easyHandlePoolCount];
+    }
+
+    return curl_easy_init();
+}
+
+/* Shall be called with g_multiHandleMutex held */
+static void CHPReleaseEasyHandle(CURL *easyHandle)
+{
+    if (!g_terminateParser && g_easyHandlePoolCount < EASY_HANDLE_POOL_SIZE)
+    {
+        curl_easy_reset(easyHandle);
+        g_easyHandlePool[g_easyHandlePoolCount++] = easyHandle;
+        return;
+    }
+
+    curl_easy_cleanup(easyHandle);
+}
+
+static void CHPCleanupEasyHandlePool(void)
+{
+    while (g_easyHandlePoolCount)
+    {
+        curl_easy_cleanup(g_easyHandlePool[--g_easyHandlePoolCount]);
+    }
+}
+
+static bool CHPCopyResponse(const HttpResponse_t *src, HttpResponse_t *dst)
+{
+    *dst = *src;
+    dst->payload = NULL;
+    dst->headerOptions = NULL;
+
+    if (src->payload && src->payloadLength)
+    {
+        dst->payload = OICMalloc(src->payloadLength);
+        if (!dst->payload)
+        {
+            return false;
+        }
+        memcpy(dst->payload, src->payload, src->payloadLength);
+    }
+
+    size_t headerCount = u_arraylist_length(src->headerOptions);
+    if (headerCount)
+    {
+        dst->headerOptions = u_arraylist_create();
+        if (!dst->headerOptions)
+        {
+            OICFree(dst->payload);
+            dst->payload = NULL;
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < headerCount; i++)
+    {
+        HttpHeaderOption_t *option = OICMalloc(sizeof(HttpHeaderOption_t));
+        if (!option || !u_arraylist_add(dst->headerOptions, option))
+        {
+            OICFree(option);
+            CHPParserResetHeaderOptions(&(dst->headerOptions));
+            OICFree(dst->payload);
+            dst->payload = NULL;
+            return false;
+        }
+
+        memcpy(option, u_arraylist_get(src->headerOptions, i), sizeof(HttpHeaderOption_t));
+    }
+
+    return true;
+}
+
+static void CHPFreeCacheEntry(CHPCacheEntry_t *entry)
+{
+    CHPParserResetHeaderOptions(&(entry->resp.headerOptions));
+    OICFree(entry->resp.payload);
+    OICFree(entry->uri);
+    OICFree(entry->accept);
+    memset(entry, 0, sizeof(CHPCacheEntry_t));
+}
+
+static HttpHeaderOption_t *CHPFindHeaderOption(u_arraylist_t *headerOptions, const char *name)
+{
+    size_t headerCount = u_arraylist_length(headerOptions);
+    for (size_t i = 0; i < headerCount; i++)
+    {
+        HttpHeaderOption_t *option = u_arraylist_get(headerOptions, i);
+        if (option && 0 == strcasecmp(option->optionName, name))
+        {
+            return option;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Look up directive name in a Cache-Control value. Directives are matched as whole
+ * comma separated tokens ignoring case, commas inside a quoted argument do not split.
+ * If value is given it points to the argument of the directive or is NULL if it has none.
+ */
+static bool CHPFindCacheDirective(const char *data, const char *name, const char **value)
+{
+    size_t nameLength = strlen(name);
+    const char *token = data;
+
+    while ('\0' != *token)
+    {
+        token += strspn(token, " \t,");
+        if (0 == strncasecmp(token, name, nameLength))
+        {
+            const char *end = token + nameLength;
+            end += strspn(end, " \t");
+            if ('\0' == *end || ',' == *end || '=' == *end)
+            {
+                if (value)
+                {
+                    *value = NULL;
+                    if ('=' == *end)
+                    {
+                        end++;
+                        end += strspn(end, " \t\"");
+                        *value = end;
+                    }
+                }
+                return true;
+            }
+        }
+
+        bool quoted = false;
+        for (; '\0' != *token && (quoted || ',' != *token); token++)
+        {
+            if ('"' == *token)
+            {
+                quoted = !quoted;
+            }
+        }
+    }
+
+    return false;
+}
+
+static bool CHPGetResponseMaxAge(const HttpResponse_t *resp, uint32_t *maxAge)
+{
+    bool found = false;
+    size_t headerCount = u_arraylist_length(resp->headerOptions);
+
+    for (size_t i = 0; i < headerCount; i++)
+    {
+        HttpHeaderOption_t *option = u_arraylist_get(resp->headerOptions, i);
+        uint32_t optionMaxAge = 0;
+        if (option && OC_STACK_OK == CHPGetMaxAge(option, &optionMaxAge))
+        {
+            // Cache-Control takes precedence over Expires
+            if (!found || 0 == strcasecmp(option->optionName, HTTP_OPTION_CACHE_CONTROL))
+            {
+                *maxAge = optionMaxAge;
+            }
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+/* Shall be called with g_multiHandleMutex held */
+static void CHPCacheResponse(const CHPContext_t *ctxt)
+{
+    uint32_t maxAge = 0;
+    if (!ctxt->cacheUri || CHP_SUCCESS != ctxt->resp.status ||
+        !CHPGetResponseMaxAge(&(ctxt->resp), &maxAge) || !maxAge)
+    {
+        return;
+    }
+
+    // Entries are keyed by uri and accept only, a response selected by other request
+    // headers could be served to the wrong client
+    if (CHPFindHeaderOption(ctxt->resp.headerOptions, HTTP_OPTION_VARY))
+    {
+        OIC_LOG_V(DEBUG, TAG, "Response of %s varies, not cached", ctxt->cacheUri);
+        return;
+    }
+
+    if (ctxt->cacheAuthorized)
+    {
+        HttpHeaderOption_t *cacheControl =
+            CHPFindHeaderOption(ctxt->resp.headerOptions, HTTP_OPTION_CACHE_CONTROL);
+        if (!cacheControl ||
+            (!CHPFindCacheDirective(cacheControl->optionData, CACHE_CONTROL_PUBLIC, NULL) &&
+             !CHPFindCacheDirective(cacheControl->optionData, CACHE_CONTROL_S_MAXAGE, NULL)))
+        {
+            OIC_LOG_V(DEBUG, TAG, "Response of %s is private, not cached", ctxt->cacheUri);
+            return;
+        }
+    }
+
+    uint64_t now = OICGetCurrentTime(TIME_IN_MS);
+    CHPCacheEntry_t *slot = NULL;
+
+    // Replace the same resource, else a free or stale slot, else the one expiring first
+    for (size_t i = 0; i < RESPONSE_CACHE_SIZE; i++)
+    {
+        CHPCacheEntry_t *entry = &g_responseCache[i];
+        if (entry->uri && 0 == strcmp(entry->uri, ctxt->cacheUri) &&
+            0 == strcmp(entry->accept, ctxt->cacheAccept))
+        {
+            slot = entry;
+            break;
+        }
+
+        if (!slot || (slot->uri && (!entry->uri || entry->expiresAt <= now ||
+                                    entry->expiresAt < slot->expiresAt)))
+        {
+            slot = entry;
+        }
+    }
+
+    CHPFreeCacheEntry(slot);
+    slot->uri = OICStrdup(ctxt->cacheUri);
+    slot->accept = OICStrdup(ctxt->cacheAccept);
+    if (!slot->uri || !slot->accept || !CHPCopyResponse(&(ctxt->resp), &(slot->resp)))
+    {
+        OIC_LOG(ERROR, TAG, "Failed to cache response");
+        CHPFreeCacheEntry(slot);
+        return;
+    }
+
+    slot->expiresAt = now + (uint64_t)maxAge * 1000;
+    OIC_LOG_V(DEBUG, TAG, "Cached response of %s for %u s", slot->uri, maxAge);
+}
+
+/*
+ * Fill ctxt with a fresh cached response for req if there is one. The Cache-Control
+ * header of the copy carries the remaining lifetime so that it maps onto CoAP Max-Age.
+ * Shall be called with g_multiHandleMutex held.
+ */
+static bool CHPGetCachedResponse(const HttpRequest_t *req, CHPContext_t *ctxt)
+{
+    uint64_t now = OICGetCurrentTime(TIME_IN_MS);
+
+    for (size_t i = 0; i < RESPONSE_CACHE_SIZE; i++)
+    {
+        CHPCacheEntry_t *entry = &g_responseCache[i];
+        if (!entry->uri || 0 != strcmp(entry->uri, req->resourceUri) ||
+            0 != strcmp(entry->accept, req->acceptFormat))
+        {
+            continue;
+        }
+
+        if (entry->expiresAt <= now)
+        {
+            CHPFreeCacheEntry(entry);
+            return false;
+        }
+
+        if (!CHPCopyResponse(&(entry->resp), &(ctxt->resp)))
+        {
+            return false;
+        }
+
+        size_t headerCount = u_arraylist_length(ctxt->resp.headerOptions);
+        for (size_t j = 0; j < headerCount; j++)
+        {
+            HttpHeaderOption_t *option = u_arraylist_get(ctxt->resp.headerOptions, j);
+            if (0 == strcasecmp(option->optionName, HTTP_OPTION_CACHE_CONTROL) ||
+                0 == strcasecmp(option->optionName, HTTP_OPTION_EXPIRES))
+            {
+                OICStrcpy(option->optionName, sizeof(option->optionName),
+                          HTTP_OPTION_CACHE_CONTROL);
+                snprintf(option->optionData, sizeof(option->optionData), "max-age=%" PRIu64,
+                         (entry->expiresAt - now) / 1000);
+                option->optionLength = (uint16_t)strlen(option->optionData);
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+static void CHPClearResponseCache(void)
+{
+    for (size_t i = 0; i < RESPONSE_CACHE_SIZE; i++)
+    {
+        CHPFreeCacheEntry(&g_responseCache[i]);
+    }
+}
+
+/* Shall be called with g_multiHandleMutex held */
+static void CHPDeliverCachedResponses(void)
+{
+    CHPContext_t *ctxt = NULL;
+    while (g_cachedResponses && !g_terminateParser &&
+           NULL != (ctxt = u_arraylist_remove(g_cachedResponses, 0)))
+    {
+        OIC_LOG_V(DEBUG, TAG, "Cached response delivered for %s", ctxt->cacheUri);
+        ctxt->cb(&(ctxt->resp), ctxt->context);
+        CHPFreeContext(ctxt);
+    }
+}
+
 static void CHPFreeContext(CHPContext_t *ctxt)
 {
     VERIFY_NON_NULL_VOID(ctxt, TAG, "ctxt is NULL");
@@ -122,12 +485,14 @@ static void CHPFreeContext(CHPContext_t *ctxt)
 
     if(ctxt->easyHandle)
     {
-        curl_easy_cleanup(ctxt->easyHandle);
+        CHPReleaseEasyHandle(ctxt->easyHandle);
     }
 
     CHPParserResetHeaderOptions(&(ctxt->resp.headerOptions));
     OICFree(ctxt->resp.payload);
     OICFree(ctxt->payload);
+    OICFree(ctxt->cacheUri);
+    OICFree(ctxt->cacheAccept);
     OICFree(ctxt);
 }
 
@@ -191,8 +556,12 @@ static void *CHPParserExecuteMultiHandle(void* data)
             }
             else
             {
-                // libcurl recommend doing this.
-                usleep(100000);
+                // libcurl recommend doing this, unless it wants curl_multi_perform() right
+                // away, e.g. to hand an idle reused connection to a queued transfer.
+                if (curlMultiTimeout)
+                {
+                    usleep((curlMultiTimeout < 100 ? curlMultiTimeout : 100) * 1000);
+                }
                 // dont select() and directly call curl_multi_perform()
                 goForSelect = false;
             }
@@ -219,7 +588,7 @@ static void *CHPParserExecuteMultiHandle(void* data)
             else
             {
                 timeout.tv_sec = curlMultiTimeout / 1000;
-                timeout.tv_usec = 0;
+                timeout.tv_usec = (curlMultiTimeout % 1000) * 1000;
                 tv = &timeout;
             }
 
@@ -282,11 +651,13 @@ static void *CHPParserExecuteMultiHandle(void* data)
                     OICStrcpy(ptr->resp.dataFormat, sizeof(ptr->resp.dataFormat), contentType);
                     OIC_LOG_V(DEBUG, TAG, "Transfer completed %d uri: %s, %s", g_activeConnections,
                                                                            uri, contentType);
+                    CHPCacheResponse(ptr);
                     ptr->cb(&(ptr->resp), ptr->context);
                     CHPFreeContext(ptr);
                 }
             } while(cmsg && !g_terminateParser);
         }while (ret == CURLM_CALL_MULTI_PERFORM && !g_terminateParser);
+        CHPDeliverCachedResponses();
         CHPParserUnlockMutex();
     }
 
@@ -409,6 +780,27 @@ static OCStackResult CHPParserInitializeMultiHandle(void)
         return OC_STACK_ERROR;
     }
 
+    /* Keep connections alive between requests and multiplex requests to the same
+     * host over one HTTP/2 connection when the server supports it.
+     */
+#ifdef CURLPIPE_MULTIPLEX
+    curl_multi_setopt(g_multiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x071e00
+    curl_multi_setopt(g_multiHandle, CURLMOPT_MAX_HOST_CONNECTIONS, MAX_HOST_CONNECTIONS);
+#endif
+    curl_multi_setopt(g_multiHandle, CURLMOPT_MAXCONNECTS, MAX_CACHED_CONNECTIONS);
+
+    g_cachedResponses = u_arraylist_create();
+    if (!g_cachedResponses)
+    {
+        OIC_LOG(ERROR, TAG, "Failed to create cached response list.");
+        curl_multi_cleanup(g_multiHandle);
+        g_multiHandle = NULL;
+        CHPParserUnlockMutex();
+        return OC_STACK_NO_MEMORY;
+    }
+
     CHPParserUnlockMutex();
     return OC_STACK_OK;
 }
@@ -423,6 +815,15 @@ static OCStackResult CHPParserTerminateMultiHandle(void)
         return OC_STACK_OK;
     }
 
+    CHPContext_t *ctxt = NULL;
+    while (g_cachedResponses && NULL != (ctxt = u_arraylist_remove(g_cachedResponses, 0)))
+    {
+        CHPFreeContext(ctxt);
+    }
+    u_arraylist_free(&g_cachedResponses);
+
+    CHPCleanupEasyHandlePool();
+    CHPClearResponseCache();
     curl_multi_cleanup(g_multiHandle);
     g_multiHandle = NULL;
     CHPParserUnlockMutex();
@@ -533,35 +934,39 @@ static size_t CHPEasyHandleWriteCb(char *buffer, size_t size, size_t num, void *
         OIC_LOG_V(ERROR, TAG, "%s Payload limit exceeded", __func__);
         resp->payloadLength = 0;
         ctx->writeOffset = 0;
+        ctx->payloadCapacity = 0;
         OICFree(resp->payload);
         resp->payload = NULL;
         return 0;
     }
 
-    if (!resp->payload)
+    if (ctx->writeOffset + dataToWrite > ctx->payloadCapacity)
     {
-        resp->payload = OICMalloc(dataToWrite);
-        if (!resp->payload)
+        // Grow geometrically to avoid a realloc for every chunk received from curl
+        size_t newCapacity = ctx->payloadCapacity ? ctx->payloadCapacity : INITIAL_PAYLOAD_SIZE;
+        while (newCapacity < ctx->writeOffset + dataToWrite)
         {
-            OIC_LOG_V(ERROR, TAG, "%s Out of memory!", __func__);
-            return 0;
+            newCapacity *= 2;
         }
-    }
-    else
-    {
-        // Realloc buffer
-        void *newPayload = OICRealloc(resp->payload, ctx->writeOffset + dataToWrite);
+        if (newCapacity > MAX_PAYLOAD_SIZE)
+        {
+            newCapacity = MAX_PAYLOAD_SIZE;
+        }
+
+        void *newPayload = OICRealloc(resp->payload, newCapacity);
         if (!newPayload)
         {
             OIC_LOG_V(ERROR, TAG, "Realloc failed! Current: %" PRIuPTR " Extra: %" PRIuPTR, ctx->writeOffset,
                                                                            dataToWrite);
             resp->payloadLength = 0;
             ctx->writeOffset = 0;
+            ctx->payloadCapacity = 0;
             OICFree(resp->payload);
             resp->payload = NULL;
             return 0;
         }
         resp->payload = newPayload;
+        ctx->payloadCapacity = newCapacity;
     }
 
     memcpy(resp->payload + ctx->writeOffset, buffer, dataToWrite);
@@ -619,6 +1024,7 @@ static size_t CHPEasyHandleHeaderCb(char *buffer, size_t size, size_t num, void
             OIC_LOG(ERROR, TAG, "New header received");
             resp->payloadLength = 0;
             ctx->writeOffset = 0;
+            ctx->payloadCapacity = 0;
             OICFree(resp->payload);
             resp->payload = NULL;
             CHPParserResetHeaderOptions(&(resp->headerOptions));
@@ -697,7 +1103,19 @@ static size_t CHPEasyHandleHeaderCb(char *buffer, size_t size, size_t num, void
             option->optionData[headerValueLen] = '\0';
         }
 
+        option->optionLength = (uint16_t)strlen(option->optionData);
         OIC_LOG_V(DEBUG, TAG, "%s:: %s: %s", __func__, option->optionName, option->optionData);
+
+        // Reserve the whole body up front when its length is announced
+        if (0 == strcasecmp(option->optionName, HTTP_OPTION_CONTENT_LENGTH) && !resp->payload)
+        {
+            unsigned long contentLength = strtoul(option->optionData, NULL, 10);
+            if (contentLength && contentLength <= MAX_PAYLOAD_SIZE)
+            {
+                resp->payload = OICMalloc(contentLength);
+                ctx->payloadCapacity = resp->payload ? contentLength : 0;
+            }
+        }
         // Add to header option list
         if(!u_arraylist_add(resp->headerOptions, option))
         {
@@ -719,7 +1137,9 @@ static OCStackResult CHPInitializeEasyHandle(CURL** easyHandle, HttpRequest_t *r
     VERIFY_NON_NULL_RET(easyHandle, TAG, "easyHandle", OC_STACK_INVALID_PARAM);
     VERIFY_NON_NULL_RET(handleContext, TAG, "handleContext", OC_STACK_INVALID_PARAM);
 
-    CURL *e = curl_easy_init();
+    CHPParserLockMutex();
+    CURL *e = CHPAcquireEasyHandle();
+    CHPParserUnlockMutex();
     if(!e)
     {
         OIC_LOG(ERROR, TAG, "easy init failed!");
@@ -749,8 +1169,18 @@ static OCStackResult CHPInitializeEasyHandle(CURL** easyHandle, HttpRequest_t *r
     curl_easy_setopt(e, CURLOPT_LOW_SPEED_LIMIT, 1024L);
     curl_easy_setopt(e, CURLOPT_LOW_SPEED_TIME, 60L);
     curl_easy_setopt(e, CURLOPT_USERAGENT, DEFAULT_USER_AGENT);
-    /* Close connection once done with transaction */
-    curl_easy_setopt(e, CURLOPT_FORBID_REUSE, 1L);
+    /* Keep connection open for following transactions to the same host */
+#if LIBCURL_VERSION_NUM >= 0x071900
+    curl_easy_setopt(e, CURLOPT_TCP_KEEPALIVE, 1L);
+#endif
+#ifdef CURL_HTTP_VERSION_2TLS
+    /* Use HTTP/2 for https when the server offers it, HTTP/1.1 otherwise */
+    curl_easy_setopt(e, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x072b00
+    /* Prefer waiting for a multiplexed connection over opening a new one */
+    curl_easy_setopt(e, CURLOPT_PIPEWAIT, 1L);
+#endif
     /* Allow redirect */
     curl_easy_setopt(e, CURLOPT_FOLLOWLOCATION, 1L);
     /* Only redirect to http servers */
@@ -790,6 +1220,9 @@ static OCStackResult CHPInitializeEasyHandle(CURL** easyHandle, HttpRequest_t *r
             curl_easy_setopt(e, CURLOPT_CUSTOMREQUEST, "DELETE");
             break;
         default:
+            CHPParserLockMutex();
+            CHPReleaseEasyHandle(e);
+            CHPParserUnlockMutex();
             return OC_STACK_INVALID_METHOD;
     }
 
@@ -818,6 +1251,7 @@ static OCStackResult CHPInitializeEasyHandle(CURL** easyHandle, HttpRequest_t *r
     list = curl_slist_append(list, buffer);
     snprintf(buffer, sizeof(buffer), "Content-Type: %s", req->payloadFormat);
     curl_easy_setopt(e, CURLOPT_HTTPHEADER, list);
+    handleContext->list = list;
 
     *easyHandle = e;
     OIC_LOG_V(DEBUG, TAG, "%s OUT", __func__);
@@ -840,10 +1274,48 @@ OCStackResult CHPPostHttpRequest(HttpRequest_t *req, CHPResponseCallback httpcb,
 
     ctxt->cb = httpcb;
     ctxt->context = context;
+
+    if (CHP_GET == req->method)
+    {
+        ctxt->cacheUri = OICStrdup(req->resourceUri);
+        ctxt->cacheAccept = OICStrdup(req->acceptFormat);
+        if (!ctxt->cacheUri || !ctxt->cacheAccept)
+        {
+            OIC_LOG(ERROR, TAG, "Memory failed!");
+            CHPFreeContext(ctxt);
+            return OC_STACK_NO_MEMORY;
+        }
+
+        ctxt->cacheAuthorized =
+            CHPFindHeaderOption(req->headerOptions, HTTP_OPTION_AUTHORIZATION) ||
+            CHPFindHeaderOption(req->headerOptions, HTTP_OPTION_COOKIE);
+
+        CHPParserLockMutex();
+        bool cached = CHPGetCachedResponse(req, ctxt);
+        if (cached && !u_arraylist_add(g_cachedResponses, ctxt))
+        {
+            CHPParserResetHeaderOptions(&(ctxt->resp.headerOptions));
+            OICFree(ctxt->resp.payload);
+            ctxt->resp.payload = NULL;
+            cached = false;
+        }
+        CHPParserUnlockMutex();
+
+        if (cached)
+        {
+            // Response is delivered from multi_handle thread like any other response
+            OIC_LOG_V(DEBUG, TAG, "Cache hit for %s", req->resourceUri);
+            CHPParserSignalRefresh();
+            return OC_STACK_OK;
+        }
+    }
+
     OCStackResult ret = CHPInitializeEasyHandle(&ctxt->easyHandle, req, ctxt);
     if(ret != OC_STACK_OK)
     {
         OIC_LOG_V(ERROR, TAG, "Failed to initialize easy handle [%d]", ret);
+        OICFree(ctxt->cacheUri);
+        OICFree(ctxt->cacheAccept);
         OICFree(ctxt);
         return ret;
     }
@@ -853,6 +1325,14 @@ OCStackResult CHPPostHttpRequest(HttpRequest_t *req, CHPResponseCallback httpcb,
     curl_multi_add_handle(g_multiHandle, ctxt->easyHandle);
     g_activeConnections++;
     CHPParserUnlockMutex();
+    CHPParserSignalRefresh();
+
+    OIC_LOG_V(DEBUG, TAG, "%s OUT", __func__);
+    return OC_STACK_OK;
+}
+
+static void CHPParserSignalRefresh(void)
+{
     // Notify refreshfd
     ssize_t len = 0;
     do
@@ -864,7 +1344,57 @@ OCStackResult CHPPostHttpRequest(HttpRequest_t *req, CHPResponseCallback httpcb,
     {
         OIC_LOG_V(DEBUG, TAG, "refresh failed: %s", strerror(errno));
     }
+}
 
-    OIC_LOG_V(DEBUG, TAG, "%s OUT", __func__);
+OCStackResult CHPGetMaxAge(const HttpHeaderOption_t *option, uint32_t *maxAge)
+{
+    VERIFY_NON_NULL_RET(option, TAG, "option", OC_STACK_INVALID_PARAM);
+    VERIFY_NON_NULL_RET(maxAge, TAG, "maxAge", OC_STACK_INVALID_PARAM);
+
+    if (0 == strcasecmp(option->optionName, HTTP_OPTION_EXPIRES))
+    {
+        time_t expires = curl_getdate(option->optionData, NULL);
+        if (-1 == expires)
+        {
+            return OC_STACK_INVALID_OPTION;
+        }
+
+        time_t now = time(NULL);
+        *maxAge = (expires > now) ? (uint32_t)(expires - now) : 0;
+        return OC_STACK_OK;
+    }
+
+    if (0 != strcasecmp(option->optionName, HTTP_OPTION_CACHE_CONTROL))
+    {
+        return OC_STACK_INVALID_OPTION;
+    }
+
+    // Responses which must be revalidated are stale right away
+    const char *data = option->optionData;
+    if (CHPFindCacheDirective(data, "no-store", NULL) ||
+        CHPFindCacheDirective(data, "no-cache", NULL) ||
+        CHPFindCacheDirective(data, "private", NULL))
+    {
+        *maxAge = 0;
+        return OC_STACK_OK;
+    }
+
+    // The proxy is a shared cache hence s-maxage overrides max-age
+    const char *directive = NULL;
+    if (!CHPFindCacheDirective(data, CACHE_CONTROL_S_MAXAGE, &directive) &&
+        !CHPFindCacheDirective(data, CACHE_CONTROL_MAX_AGE, &directive))
+    {
+        return OC_STACK_INVALID_OPTION;
+    }
+
+    if (!directive || *directive < '0' || *directive > '9')
+    {
+        return OC_STACK_INVALID_OPTION;
+    }
+
+    char *end = NULL;
+    unsigned long value = strtoul(directive, &end, 10);
+
+    *maxAge = (value > UINT32_MAX) ? UINT32_MAX : (uint32_t)value;
     return OC_STACK_OK;
 }
@@ -0,0 +1,278 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+// Throughput of the HTTP backend of the proxy against a local HTTP/1.1 stand-in
+// server. Results are printed as one JSON object per benchmark.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "oic_string.h"
+#include "CoapHttpParser.h"
+
+namespace
+{
+    const int REQUEST_COUNT = 2000;
+    const int REQUESTS_IN_FLIGHT = 32;
+
+    class HttpStandInServer
+    {
+    public:
+        HttpStandInServer(const std::string &cacheControl, size_t bodySize)
+            : m_cacheControl(cacheControl), m_body(bodySize, 'a'), m_running(true),
+              m_connections(0), m_requests(0)
+        {
+            if (m_body.size() >= 2)
+            {
+                m_body.front() = '"';
+                m_body.back() = '"';
+            }
+
+            m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+            int on = 1;
+            setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+            sockaddr_in addr = {};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            bind(m_listenFd, (sockaddr *)&addr, sizeof(addr));
+            listen(m_listenFd, 128);
+
+            socklen_t len = sizeof(addr);
+            getsockname(m_listenFd, (sockaddr *)&addr, &len);
+            m_port = ntohs(addr.sin_port);
+
+            m_acceptThread = std::thread(&HttpStandInServer::acceptLoop, this);
+        }
+
+        ~HttpStandInServer()
+        {
+            m_running = false;
+            m_acceptThread.join();
+            for (auto &t : m_connectionThreads)
+            {
+                t.join();
+            }
+            close(m_listenFd);
+        }
+
+        std::string uri(const std::string &path) const
+        {
+            return "http://127.0.0.1:" + std::to_string(m_port) + path;
+        }
+
+        int connections() const { return m_connections; }
+        int requests() const { return m_requests; }
+
+    private:
+        void acceptLoop()
+        {
+            while (m_running)
+            {
+                pollfd pfd = { m_listenFd, POLLIN, 0 };
+                if (poll(&pfd, 1, 50) <= 0)
+                {
+                    continue;
+                }
+
+                int fd = accept(m_listenFd, NULL, NULL);
+                if (fd >= 0)
+                {
+                    m_connections++;
+                    m_connectionThreads.emplace_back(&HttpStandInServer::serve, this, fd);
+                }
+            }
+        }
+
+        void serve(int fd)
+        {
+            std::string pending;
+            char buffer[4096];
+
+            while (m_running)
+            {
+                pollfd pfd = { fd, POLLIN, 0 };
+                if (poll(&pfd, 1, 50) <= 0)
+                {
+                    continue;
+                }
+
+                ssize_t len = read(fd, buffer, sizeof(buffer));
+                if (len <= 0)
+                {
+                    break;
+                }
+                pending.append(buffer, len);
+
+                size_t end;
+                while ((end = pending.find("\r\n\r\n")) != std::string::npos)
+                {
+                    pending.erase(0, end + 4);
+                    m_requests++;
+
+                    std::string response = "HTTP/1.1 200 OK\r\n"
+                                           "Content-Type: application/json\r\n"
+                                           "Content-Length: " + std::to_string(m_body.size()) +
+                                           "\r\n";
+                    if (!m_cacheControl.empty())
+                    {
+                        response += "Cache-Control: " + m_cacheControl + "\r\n";
+                    }
+                    response += "\r\n" + m_body;
+
+                    size_t sent = 0;
+                    while (sent < response.size())
+                    {
+                        ssize_t ret = write(fd, response.data() + sent, response.size() - sent);
+                        if (ret <= 0)
+                        {
+                            break;
+                        }
+                        sent += ret;
+                    }
+                }
+            }
+
+            close(fd);
+        }
+
+        std::string m_cacheControl;
+        std::string m_body;
+        std::atomic_bool m_running;
+        std::atomic_int m_connections;
+        std::atomic_int m_requests;
+        int m_listenFd;
+        uint16_t m_port;
+        std::thread m_acceptThread;
+        std::vector<std::thread> m_connectionThreads;
+    };
+
+    std::mutex g_lock;
+    std::condition_variable g_cond;
+    int g_inFlight;
+    int g_completed;
+    size_t g_lastPayloadLength;
+
+    void responseCallback(const HttpResponse_t *response, void *context)
+    {
+        (void)context;
+        std::lock_guard<std::mutex> lock(g_lock);
+        g_lastPayloadLength = response->payloadLength;
+        g_inFlight--;
+        g_completed++;
+        g_cond.notify_all();
+    }
+
+    double runRequests(const std::string &uri, int count)
+    {
+        HttpRequest_t req = {1, 1, CHP_GET, NULL, "", NULL, 0, false,
+                             JSON_CONTENT_TYPE, JSON_CONTENT_TYPE};
+        OICStrcpy(req.resourceUri, sizeof(req.resourceUri), uri.c_str());
+
+        g_inFlight = 0;
+        g_completed = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < count; i++)
+        {
+            {
+                std::unique_lock<std::mutex> lock(g_lock);
+                g_cond.wait(lock, []{ return g_inFlight < REQUESTS_IN_FLIGHT; });
+                g_inFlight++;
+            }
+            EXPECT_EQ(OC_STACK_OK, CHPPostHttpRequest(&req, responseCallback, NULL));
+        }
+
+        std::unique_lock<std::mutex> lock(g_lock);
+        EXPECT_TRUE(g_cond.wait_for(lock, std::chrono::seconds(30),
+                                    [count]{ return g_completed == count; }));
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+}
+
+class CoApHttpBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp()
+    {
+        ASSERT_EQ(OC_STACK_OK, CHPParserInitialize());
+    }
+
+    void TearDown()
+    {
+        CHPParserTerminate();
+    }
+};
+
+TEST_F(CoApHttpBenchmark, ReusedConnections)
+{
+    HttpStandInServer server("no-cache", 128);
+    double seconds = runRequests(server.uri("/sensor"), REQUEST_COUNT);
+
+    std::cout << "{\"benchmark\":\"ReusedConnections\",\"requests\":" << REQUEST_COUNT
+              << ",\"connections\":" << server.connections()
+              << ",\"requestsPerSec\":" << (REQUEST_COUNT / seconds) << "}" << std::endl;
+
+    EXPECT_EQ(REQUEST_COUNT, server.requests());
+    EXPECT_LT(server.connections(), REQUESTS_IN_FLIGHT);
+}
+
+TEST_F(CoApHttpBenchmark, CachedResponses)
+{
+    HttpStandInServer server("max-age=60", 128);
+    double seconds = runRequests(server.uri("/config"), REQUEST_COUNT);
+
+    std::cout << "{\"benchmark\":\"CachedResponses\",\"requests\":" << REQUEST_COUNT
+              << ",\"serverRequests\":" << server.requests()
+              << ",\"requestsPerSec\":" << (REQUEST_COUNT / seconds) << "}" << std::endl;
+
+    EXPECT_LE(server.requests(), REQUESTS_IN_FLIGHT);
+}
+
+TEST_F(CoApHttpBenchmark, LargeBodies)
+{
+    const size_t bodySize = 512 * 1024;
+    const int count = 200;
+    HttpStandInServer server("no-store", bodySize);
+    double seconds = runRequests(server.uri("/image"), count);
+
+    std::cout << "{\"benchmark\":\"LargeBodies\",\"requests\":" << count
+              << ",\"bodyBytes\":" << bodySize
+              << ",\"megabytesPerSec\":" << (count * bodySize / seconds / 1048576) << "}"
+              << std::endl;
+
+    EXPECT_EQ(bodySize, g_lastPayloadLength);
+}
@@ -251,6 +251,44 @@ TEST_F(CoApHttpTest, CHPGetOCOption)
     EXPECT_EQ(OC_STACK_INVALID_OPTION, (CHPGetOCOption(&httpOption, &ocOp)));
 }
 
+TEST_F(CoApHttpTest, CHPGetMaxAge)
+{
+    HttpHeaderOption_t httpOption;
+    uint32_t maxAge = 0;
+    OICStrcpy(httpOption.optionName, sizeof(httpOption.optionName), HTTP_OPTION_CACHE_CONTROL);
+
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, (CHPGetMaxAge(NULL, &maxAge)));
+
+    OICStrcpy(httpOption.optionData, sizeof(httpOption.optionData), "Public, Max-Age=60");
+    EXPECT_EQ(OC_STACK_OK, (CHPGetMaxAge(&httpOption, &maxAge)));
+    EXPECT_EQ(60u, maxAge);
+
+    OICStrcpy(httpOption.optionData, sizeof(httpOption.optionData), "max-age=60, s-maxage=30");
+    EXPECT_EQ(OC_STACK_OK, (CHPGetMaxAge(&httpOption, &maxAge)));
+    EXPECT_EQ(30u, maxAge);
+
+    // directives are case insensitive
+    OICStrcpy(httpOption.optionData, sizeof(httpOption.optionData), "No-Cache, max-age=60");
+    EXPECT_EQ(OC_STACK_OK, (CHPGetMaxAge(&httpOption, &maxAge)));
+    EXPECT_EQ(0u, maxAge);
+
+    OICStrcpy(httpOption.optionData, sizeof(httpOption.optionData), "max-age=60, PRIVATE");
+    EXPECT_EQ(OC_STACK_OK, (CHPGetMaxAge(&httpOption, &maxAge)));
+    EXPECT_EQ(0u, maxAge);
+
+    // only whole directives count
+    OICStrcpy(httpOption.optionData, sizeof(httpOption.optionData),
+              "x-no-cache, ext=\"private, no-store\", max-age=60");
+    EXPECT_EQ(OC_STACK_OK, (CHPGetMaxAge(&httpOption, &maxAge)));
+    EXPECT_EQ(60u, maxAge);
+
+    OICStrcpy(httpOption.optionData, sizeof(httpOption.optionData), "x-max-age=60");
+    EXPECT_EQ(OC_STACK_INVALID_OPTION, (CHPGetMaxAge(&httpOption, &maxAge)));
+
+    OICStrcpy(httpOption.optionData, sizeof(httpOption.optionData), "max-age=-1");
+    EXPECT_EQ(OC_STACK_INVALID_OPTION, (CHPGetMaxAge(&httpOption, &maxAge)));
+}
+
 TEST_F(CoApHttpTest, CHPGetOCContentType)
 {
     const char *httpContentType = CBOR_CONTENT_TYPE;
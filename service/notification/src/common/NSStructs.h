@@ -59,12 +59,16 @@ typedef struct _NSCacheElement
 
 } NSCacheElement;
 
+/** ns cache index (provider only) */
+typedef struct _NSCacheIndex NSCacheIndex;
+
 /** ns cache list */
 typedef struct
 {
     NSCacheType cacheType;         /**< cache type */
     NSCacheElement * head;         /**< head node of list */
     NSCacheElement * tail;         /**< tail node of list */
+    NSCacheIndex * index;          /**< hash index by id, NULL if not indexed */
 
 } NSCacheList;
 
@@ -45,6 +45,7 @@ NSCacheList * NSConsumerStorageCreate(void)
 
     newList->head = NULL;
     newList->tail = NULL;
+    newList->index = NULL;
 
     pthread_mutex_unlock(mutex);
 
@@ -21,6 +21,177 @@
 #include "NSProviderMemoryCache.h"
 #include <string.h>
 
+#define NS_PROVIDER_CACHE_INDEX_SIZE 1024
+#define NS_PROVIDER_OBSERVER_ARRAY_INIT_SIZE 16
+
+pthread_mutex_t NSCacheMutex;
+pthread_mutexattr_t NSCacheMutexAttr;
+
+/** Bucket node of the provider cache index. */
+typedef struct _NSCacheIndexNode
+{
+    NSCacheElement * element;            /**< indexed list element */
+    struct _NSCacheIndexNode * next;     /**< next node in the same bucket */
+
+} NSCacheIndexNode;
+
+/**
+ * Hash index over the elements of a provider cache list.
+ * Subscriber lists are keyed by consumer id, topic lists by topic name, so the
+ * bucket of a topic name in the consumer topic list holds all of its subscribers.
+ */
+struct _NSCacheIndex
+{
+    NSCacheIndexNode * buckets[NS_PROVIDER_CACHE_INDEX_SIZE];
+};
+
+static const char * NSProviderGetIndexKey(NSCacheType type, void * data)
+{
+    if (!data)
+    {
+        return NULL;
+    }
+
+    switch (type)
+    {
+        case NS_PROVIDER_CACHE_SUBSCRIBER:
+        case NS_PROVIDER_CACHE_SUBSCRIBER_OBSERVE_ID:
+            return ((NSCacheSubData *) data)->id;
+        case NS_PROVIDER_CACHE_REGISTER_TOPIC:
+            return ((NSCacheTopicData *) data)->topicName;
+        case NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME:
+        case NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID:
+            return ((NSCacheTopicSubData *) data)->topicName;
+        default:
+            return NULL;
+    }
+}
+
+static bool NSProviderIsIndexedLookup(NSCacheType type)
+{
+    return type == NS_PROVIDER_CACHE_SUBSCRIBER
+            || type == NS_PROVIDER_CACHE_REGISTER_TOPIC
+            || type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME;
+}
+
+static size_t NSProviderIndexHash(const char * key)
+{
+    // djb2
+    size_t hash = 5381;
+    unsigned char c = 0;
+
+    while ((c = (unsigned char) *key++))
+    {
+        hash = ((hash << 5) + hash) + c;
+    }
+
+    return hash % NS_PROVIDER_CACHE_INDEX_SIZE;
+}
+
+static NSCacheIndexNode * NSProviderIndexBucket(NSCacheList * list, const char * key)
+{
+    if (!list->index || !key)
+    {
+        return NULL;
+    }
+
+    return list->index->buckets[NSProviderIndexHash(key)];
+}
+
+static NSResult NSProviderIndexInsert(NSCacheList * list, NSCacheElement * element)
+{
+    const char * key = NSProviderGetIndexKey(list->cacheType, element->data);
+
+    if (!key)
+    {
+        return NS_OK;
+    }
+
+    if (!list->index)
+    {
+        list->index = (NSCacheIndex *) OICCalloc(1, sizeof(NSCacheIndex));
+        NS_VERIFY_NOT_NULL(list->index, NS_ERROR);
+    }
+
+    NSCacheIndexNode * node = (NSCacheIndexNode *) OICMalloc(sizeof(NSCacheIndexNode));
+    NS_VERIFY_NOT_NULL(node, NS_ERROR);
+
+    size_t bucket = NSProviderIndexHash(key);
+    node->element = element;
+    node->next = list->index->buckets[bucket];
+    list->index->buckets[bucket] = node;
+
+    return NS_OK;
+}
+
+static void NSProviderIndexRemove(NSCacheList * list, NSCacheElement * element)
+{
+    const char * key = NSProviderGetIndexKey(list->cacheType, element->data);
+
+    if (!list->index || !key)
+    {
+        return;
+    }
+
+    NSCacheIndexNode ** iter = &(list->index->buckets[NSProviderIndexHash(key)]);
+
+    while (*iter)
+    {
+        if ((*iter)->element == element)
+        {
+            NSCacheIndexNode * del = *iter;
+            *iter = del->next;
+            NSOICFree(del);
+            return;
+        }
+
+        iter = &((*iter)->next);
+    }
+}
+
+static void NSProviderIndexDestroy(NSCacheList * list)
+{
+    if (!list->index)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < NS_PROVIDER_CACHE_INDEX_SIZE; ++i)
+    {
+        NSCacheIndexNode * iter = list->index->buckets[i];
+
+        while (iter)
+        {
+            NSCacheIndexNode * next = iter->next;
+            NSOICFree(iter);
+            iter = next;
+        }
+    }
+
+    NSOICFree(list->index);
+}
+
+static NSCacheElement * NSProviderFindConsumerTopic(NSCacheList * conTopicList,
+        const char * cId, const char * topicName)
+{
+    NSCacheIndexNode * iter = NSProviderIndexBucket(conTopicList, topicName);
+
+    while (iter)
+    {
+        NSCacheTopicSubData * curr = (NSCacheTopicSubData *) iter->element->data;
+
+        if ((strcmp(curr->topicName, topicName) == 0) &&
+                (strncmp(curr->id, cId, NS_UUID_STRING_SIZE) == 0))
+        {
+            return iter->element;
+        }
+
+        iter = iter->next;
+    }
+
+    return NULL;
+}
+
 #define NS_PROVIDER_DELETE_REGISTERED_TOPIC_DATA(it, topicData, newObj) \
     { \
         if (it) \
@@ -46,6 +217,7 @@ NSCacheList * NSProviderStorageCreate(void)
     }
 
     newList->head = newList->tail = NULL;
+    newList->index = NULL;
 
     pthread_mutex_unlock(&NSCacheMutex);
     NS_LOG(DEBUG, "NSCacheCreate");
@@ -65,6 +237,27 @@ NSCacheElement * NSProviderStorageRead(NSCacheList * list, const char * findId)
 
     NS_LOG_V(INFO_PRIVATE, "Find ID - %s", findId);
 
+    if (NSProviderIsIndexedLookup(type))
+    {
+        NSCacheIndexNode * node = NSProviderIndexBucket(list, findId);
+
+        while (node)
+        {
+            if (NSProviderCompareIdCacheData(type, node->element->data, findId))
+            {
+                NS_LOG(DEBUG, "Found in Cache");
+                pthread_mutex_unlock(&NSCacheMutex);
+                return node->element;
+            }
+
+            node = node->next;
+        }
+
+        NS_LOG(DEBUG, "Not found in Cache");
+        pthread_mutex_unlock(&NSCacheMutex);
+        return NULL;
+    }
+
     while (iter)
     {
         next = iter->next;
@@ -205,7 +398,8 @@ NSResult NSProviderStorageWrite(NSCacheList * list, NSCacheElement * newObj)
         NS_LOG(DEBUG, "Type is REGITSTER TOPIC");
 
         NSCacheTopicSubData * topicData = (NSCacheTopicSubData *) newObj->data;
-        NSCacheElement * it = NSProviderStorageRead(list, topicData->topicName);
+        NSCacheElement * it = NSProviderFindConsumerTopic(list, topicData->id,
+                topicData->topicName);
 
         NS_PROVIDER_DELETE_REGISTERED_TOPIC_DATA(it, topicData, newObj);
     }
@@ -219,6 +413,13 @@ NSResult NSProviderStorageWrite(NSCacheList * list, NSCacheElement * newObj)
         NS_PROVIDER_DELETE_REGISTERED_TOPIC_DATA(it, topicData, newObj);
     }
 
+    if (NSProviderIndexInsert(list, newObj) != NS_OK)
+    {
+        NS_LOG(ERROR, "Fail to index cache data");
+        pthread_mutex_unlock(&NSCacheMutex);
+        return NS_ERROR;
+    }
+
     if (list->head == NULL)
     {
         NS_LOG(DEBUG, "list->head is NULL, Insert First Data");
@@ -247,6 +448,7 @@ NSResult NSProviderStorageDestroy(NSCacheList * list)
         iter = next;
     }
 
+    NSProviderIndexDestroy(list);
     NSOICFree(list);
     return NS_OK;
 }
@@ -401,6 +603,12 @@ NSResult NSProviderStorageDelete(NSCacheList * list, const char * delId)
         return NS_FAIL;
     }
 
+    if (NSProviderIsIndexedLookup(type) && !NSProviderStorageRead(list, delId))
+    {
+        pthread_mutex_unlock(&NSCacheMutex);
+        return NS_FAIL;
+    }
+
     if (NSProviderCompareIdCacheData(type, del->data, delId))
     {
         if (del == list->head) // first object
@@ -411,6 +619,7 @@ NSResult NSProviderStorageDelete(NSCacheList * list, const char * delId)
             }
 
             list->head = del->next;
+            NSProviderIndexRemove(list, del);
             NSProviderDeleteCacheData(type, del->data);
             NSOICFree(del);
             pthread_mutex_unlock(&NSCacheMutex);
@@ -430,6 +639,7 @@ NSResult NSProviderStorageDelete(NSCacheList * list, const char * delId)
             }
 
             prev->next = del->next;
+            NSProviderIndexRemove(list, del);
             NSProviderDeleteCacheData(type, del->data);
             NSOICFree(del);
             pthread_mutex_unlock(&NSCacheMutex);
@@ -616,6 +826,7 @@ NSResult NSProviderDeleteConsumerTopic(NSCacheList * conTopicList,
             }
 
             conTopicList->head = del->next;
+            NSProviderIndexRemove(conTopicList, del);
             NSProviderDeleteCacheData(type, del->data);
             NSOICFree(del);
             pthread_mutex_unlock(&NSCacheMutex);
@@ -638,6 +849,7 @@ NSResult NSProviderDeleteConsumerTopic(NSCacheList * conTopicList,
             }
 
             prev->next = del->next;
+            NSProviderIndexRemove(conTopicList, del);
             NSProviderDeleteCacheData(type, del->data);
             NSOICFree(del);
             pthread_mutex_unlock(&NSCacheMutex);
@@ -651,3 +863,102 @@ NSResult NSProviderDeleteConsumerTopic(NSCacheList * conTopicList,
     pthread_mutex_unlock(&NSCacheMutex);
     return NS_FAIL;
 }
+
+static bool NSProviderAppendObserver(OCObservationId ** obArray, size_t * obCount,
+        size_t * obCapacity, OCObservationId obId)
+{
+    if (*obCount == *obCapacity)
+    {
+        size_t newCapacity = *obCapacity ? (*obCapacity * 2) : NS_PROVIDER_OBSERVER_ARRAY_INIT_SIZE;
+        OCObservationId * newArray = (OCObservationId *) OICRealloc(*obArray,
+                newCapacity * sizeof(OCObservationId));
+
+        if (!newArray)
+        {
+            return false;
+        }
+
+        *obArray = newArray;
+        *obCapacity = newCapacity;
+    }
+
+    (*obArray)[(*obCount)++] = obId;
+    return true;
+}
+
+NSResult NSProviderGetMessageObservers(NSCacheList * subList, NSCacheList * conTopicList,
+        const char * topicName, OCObservationId ** obArray, size_t * obCount)
+{
+    NS_VERIFY_NOT_NULL(subList, NS_ERROR);
+    NS_VERIFY_NOT_NULL(obArray, NS_ERROR);
+    NS_VERIFY_NOT_NULL(obCount, NS_ERROR);
+
+    pthread_mutex_lock(&NSCacheMutex);
+
+    size_t obCapacity = 0;
+    *obArray = NULL;
+    *obCount = 0;
+
+    if (!topicName || topicName[0] == '\0')
+    {
+        NSCacheElement * iter = subList->head;
+
+        while (iter)
+        {
+            NSCacheSubData * subData = (NSCacheSubData *) iter->data;
+
+            if (subData->isWhite && subData->messageObId != 0 &&
+                    !NSProviderAppendObserver(obArray, obCount, &obCapacity,
+                            subData->messageObId))
+            {
+                NSOICFree(*obArray);
+                *obCount = 0;
+                pthread_mutex_unlock(&NSCacheMutex);
+                return NS_ERROR;
+            }
+
+            iter = iter->next;
+        }
+
+        pthread_mutex_unlock(&NSCacheMutex);
+        return NS_OK;
+    }
+
+    NSCacheIndexNode * iter = conTopicList ? NSProviderIndexBucket(conTopicList, topicName) : NULL;
+
+    while (iter)
+    {
+        NSCacheTopicSubData * topicData = (NSCacheTopicSubData *) iter->element->data;
+
+        if (strcmp(topicData->topicName, topicName) == 0)
+        {
+            NSCacheIndexNode * subIter = NSProviderIndexBucket(subList, topicData->id);
+
+            while (subIter)
+            {
+                NSCacheSubData * subData = (NSCacheSubData *) subIter->element->data;
+
+                if (strcmp(subData->id, topicData->id) == 0)
+                {
+                    if (subData->isWhite && subData->messageObId != 0 &&
+                            !NSProviderAppendObserver(obArray, obCount, &obCapacity,
+                                    subData->messageObId))
+                    {
+                        NSOICFree(*obArray);
+                        *obCount = 0;
+                        pthread_mutex_unlock(&NSCacheMutex);
+                        return NS_ERROR;
+                    }
+                    break;
+                }
+
+                subIter = subIter->next;
+            }
+        }
+
+        iter = iter->next;
+    }
+
+    pthread_mutex_unlock(&NSCacheMutex);
+    return NS_OK;
+}
@@ -174,7 +174,23 @@ bool NSProviderIsTopicSubScribed(NSCacheElement * conTopicList, char * cId, char
 NSResult NSProviderDeleteConsumerTopic(NSCacheList * conTopicList,
         NSCacheTopicSubData * topicSubData);
 
-pthread_mutex_t NSCacheMutex;
-pthread_mutexattr_t NSCacheMutexAttr;
+/**
+ * Collect the message observation ids of whitelisted subscribers for a message.
+ * Topic messages only go to subscribers of the topic, found through the topic
+ * index of the consumer topic list instead of a scan of all subscribers.
+ *
+ * @param subList       subscriber list.
+ * @param conTopicList  consumer topic list.
+ * @param topicName     topic of the message, NULL or empty for all subscribers.
+ * @param obArray       [out] allocated observation id array, caller frees it.
+ * @param obCount       [out] number of observation ids in obArray.
+ *
+ * @return OK if collected, otherwise ERROR.
+ */
+NSResult NSProviderGetMessageObservers(NSCacheList * subList, NSCacheList * conTopicList,
+        const char * topicName, OCObservationId ** obArray, size_t * obCount);
+
+extern pthread_mutex_t NSCacheMutex;
+extern pthread_mutexattr_t NSCacheMutexAttr;
 
 #endif /* _NS_PROVIDER_CACHEADAPTER__H_ */
@@ -114,7 +114,7 @@ NSResult NSSendNotification(NSMessage *msg)
     NS_LOG(DEBUG, "NSSendMessage - IN");
 
     OCResourceHandle rHandle = NULL;
-    OCObservationId obArray[255] = { 0, };
+    OCObservationId * obArray = NULL;
     size_t obCount = 0;
 
     if (NSPutMessageResource(msg, &rHandle) != NS_OK)
@@ -146,36 +146,18 @@ NSResult NSSendNotification(NSMessage *msg)
         return NS_ERROR;
     }
 
-    NSCacheElement * it = consumerSubList->head;
-
-    while (it)
+    if (msg->topic && (msg->topic)[0] != '\0')
     {
-        NSCacheSubData * subData = (NSCacheSubData *) it->data;
-        NS_LOG_V(INFO_PRIVATE, "message subData->id = %s", subData->id);
-        NS_LOG_V(DEBUG, "subData->messageId = %d", subData->messageObId);
-        NS_LOG_V(DEBUG, "subData->syncId = %d", subData->syncObId);
-        NS_LOG_V(DEBUG, "subData->isWhite = %d", subData->isWhite);
-
-        if (subData->isWhite)
-        {
-            if(subData->messageObId != 0)
-            {
-                if (msg->topic && (msg->topic)[0] != '\0')
-                {
-                    NS_LOG_V(DEBUG, "this is topic message: %s", msg->topic);
+        NS_LOG_V(DEBUG, "this is topic message: %s", msg->topic);
+    }
 
-                    if (NSProviderIsTopicSubScribed(consumerTopicList->head, subData->id, msg->topic))
-                    {
-                        obArray[obCount++] = subData->messageObId;
-                    }
-                }
-                else
-                {
-                    obArray[obCount++] = subData->messageObId;
-                }
-            }
-        }
-        it = it->next;
+    if (NSProviderGetMessageObservers(consumerSubList, consumerTopicList, msg->topic,
+            &obArray, &obCount) != NS_OK)
+    {
+        NS_LOG(ERROR, "fail to get message observers");
+        OCRepPayloadDestroy(payload);
+        msg->extraInfo = NULL;
+        return NS_ERROR;
     }
 
     for (size_t i = 0; i < obCount; ++i)
@@ -193,8 +175,9 @@ NSResult NSSendNotification(NSMessage *msg)
         return NS_ERROR;
     }
 
-    OCStackResult ocstackResult = OCNotifyListOfObservers(rHandle, obArray, obCount, payload,
+    OCStackResult ocstackResult = NSNotifyListOfObservers(rHandle, obArray, obCount, payload,
             OC_LOW_QOS);
+    NSOICFree(obArray);
 
     NS_LOG_V(DEBUG, "Message ocstackResult = %d", ocstackResult);
 
@@ -217,7 +200,7 @@ NSResult NSSendSync(NSSyncInfo *sync)
 {
     NS_LOG(DEBUG, "NSSendSync - IN");
 
-    OCObservationId obArray[255] = { 0, };
+    OCObservationId * obArray = NULL;
     size_t obCount = 0;
 
     OCResourceHandle rHandle = NULL;
@@ -227,6 +210,17 @@ NSResult NSSendSync(NSSyncInfo *sync)
         return NS_ERROR;
     }
 
+    size_t subCount = 0;
+    for (NSCacheElement * it = consumerSubList->head; it; it = it->next)
+    {
+        subCount++;
+    }
+    if (subCount)
+    {
+        obArray = (OCObservationId *) OICMalloc(subCount * sizeof(OCObservationId));
+        NS_VERIFY_NOT_NULL(obArray, NS_ERROR);
+    }
+
     NSCacheElement * it = consumerSubList->head;
 
     while (it)
@@ -251,6 +245,7 @@ NSResult NSSendSync(NSSyncInfo *sync)
     if (NSSetSyncPayload(sync, &payload) != NS_OK)
     {
         NS_LOG(ERROR, "Failed to allocate payload");
+        NSOICFree(obArray);
         return NS_ERROR;
     }
 
@@ -281,8 +276,9 @@ NSResult NSSendSync(NSSyncInfo *sync)
         NS_LOG(DEBUG, "-------------------------------------------------------message\n");
     }
 
-    OCStackResult ocstackResult = OCNotifyListOfObservers(rHandle, obArray,
+    OCStackResult ocstackResult = NSNotifyListOfObservers(rHandle, obArray,
             obCount, payload, OC_LOW_QOS);
+    NSOICFree(obArray);
 
     NS_LOG_V(DEBUG, "Sync ocstackResult = %d", ocstackResult);
     if (ocstackResult != OC_STACK_OK)
@@ -344,3 +344,30 @@ NSResult NSPutTopicResource(NSTopicList *topicList, OCResourceHandle * handle)
     NS_LOG(DEBUG, "NSPutTopicResource - OUT");
     return NS_OK;
 }
+
+OCStackResult NSNotifyListOfObservers(OCResourceHandle handle, OCObservationId * obArray,
+        size_t obCount, const OCRepPayload * payload, OCQualityOfService qos)
+{
+    OCStackResult result = OC_STACK_OK;
+
+    for (size_t sent = 0; sent < obCount; )
+    {
+        size_t chunk = obCount - sent;
+        if (chunk > UINT8_MAX)
+        {
+            chunk = UINT8_MAX;
+        }
+
+        OCStackResult chunkResult = OCNotifyListOfObservers(handle, obArray + sent,
+                (uint8_t) chunk, payload, qos);
+        if (chunkResult != OC_STACK_OK && result == OC_STACK_OK)
+        {
+            NS_LOG_V(ERROR, "fail to notify observers %" PRIuPTR " to %" PRIuPTR,
+                    sent, sent + chunk - 1);
+            result = chunkResult;
+        }
+        sent += chunk;
+    }
+
+    return result;
+}
@@ -121,4 +121,20 @@ NSResult NSPutSyncResource(NSSyncInfo *sync, OCResourceHandle * handle);
  */
 NSResult NSPutTopicResource(NSTopicList *topicList, OCResourceHandle * handle);
 
+/**
+ * Notify a list of observers of a resource.
+ * The stack takes at most UINT8_MAX observation ids per call,
+ * so longer lists are sent in several calls.
+ *
+ * @param[in] handle    resource handler
+ * @param[in] obArray   observation ids
+ * @param[in] obCount   number of observation ids in obArray
+ * @param[in] payload   notification payload
+ * @param[in] qos       quality of service
+ *
+ * @return OC_STACK_OK if every call succeeded, otherwise the first error.
+ */
+OCStackResult NSNotifyListOfObservers(OCResourceHandle handle, OCObservationId * obArray,
+        size_t obCount, const OCRepPayload * payload, OCQualityOfService qos);
+
 #endif /* _NS_PROVIDER_RESOURCE_H_ */
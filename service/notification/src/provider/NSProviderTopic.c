@@ -141,25 +141,14 @@ NSResult NSSendTopicUpdation(void)
     OCRepPayloadSetPropInt(payload, NS_ATTRIBUTE_MESSAGE_ID, NS_TOPIC);
     OCRepPayloadSetPropString(payload, NS_ATTRIBUTE_PROVIDER_ID, NSGetProviderInfo()->providerId);
 
-    OCObservationId obArray[255] =
-    { 0, };
+    OCObservationId * obArray = NULL;
     size_t obCount = 0;
 
-    NSCacheElement * it = consumerSubList->head;
-
-    while (it)
+    if (NSProviderGetMessageObservers(consumerSubList, NULL, NULL, &obArray, &obCount) != NS_OK)
     {
-        NSCacheSubData * subData = (NSCacheSubData *) it->data;
-
-        if (subData->isWhite)
-        {
-            if (subData->messageObId != 0)
-            {
-                obArray[obCount++] = subData->messageObId;
-            }
-        }
-
-        it = it->next;
+        NS_LOG(ERROR, "fail to get message observers");
+        OCRepPayloadDestroy(payload);
+        return NS_ERROR;
     }
 
     if (!obCount)
@@ -169,7 +158,10 @@ NSResult NSSendTopicUpdation(void)
         return NS_ERROR;
     }
 
-    if (OCNotifyListOfObservers(rHandle, obArray, obCount, payload, OC_HIGH_QOS) != OC_STACK_OK)
+    OCStackResult ocstackResult = NSNotifyListOfObservers(rHandle, obArray, obCount, payload,
+            OC_HIGH_QOS);
+    NSOICFree(obArray);
+    if (ocstackResult != OC_STACK_OK)
     {
         NS_LOG(ERROR, "fail to send topic updation");
         OCRepPayloadDestroy(payload);
@@ -0,0 +1,225 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <gtest/gtest.h>
+#include <HippoMocks/hippomocks.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "NSProviderMemoryCache.h"
+#include "NSProviderResource.h"
+}
+
+// Fan-out resolution cost of NSSendNotification, i.e. building the observer
+// array for one message, with many consumers spread over many topics.
+
+namespace
+{
+    const int CONSUMER_COUNT = 10000;
+    const int TOPIC_COUNT = 100;
+    const int TOPICS_PER_CONSUMER = 5;
+    const int MESSAGE_COUNT = 20000;
+
+    std::string consumerId(int index)
+    {
+        char id[NS_UUID_STRING_SIZE] = { 0, };
+        snprintf(id, sizeof(id), "%08x-0000-0000-0000-%012x", index, index);
+        return id;
+    }
+
+    std::string topicName(int index)
+    {
+        return "OCF_TOPIC_" + std::to_string(index);
+    }
+}
+
+class NotificationProviderCacheBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp()
+    {
+        pthread_mutexattr_init(&NSCacheMutexAttr);
+        pthread_mutexattr_settype(&NSCacheMutexAttr, PTHREAD_MUTEX_RECURSIVE);
+        pthread_mutex_init(&NSCacheMutex, &NSCacheMutexAttr);
+
+        subList = NSProviderStorageCreate();
+        subList->cacheType = NS_PROVIDER_CACHE_SUBSCRIBER;
+        topicList = NSProviderStorageCreate();
+        topicList->cacheType = NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME;
+
+        for (int i = 0; i < CONSUMER_COUNT; ++i)
+        {
+            NSCacheSubData * subData = (NSCacheSubData *) OICMalloc(sizeof(NSCacheSubData));
+            OICStrcpy(subData->id, NS_UUID_STRING_SIZE, consumerId(i).c_str());
+            subData->messageObId = (i % 255) + 1;
+            subData->syncObId = 0;
+            subData->isWhite = true;
+
+            NSCacheElement * element = (NSCacheElement *) OICMalloc(sizeof(NSCacheElement));
+            element->data = (NSCacheData *) subData;
+            element->next = NULL;
+            ASSERT_EQ(NS_OK, NSProviderStorageWrite(subList, element));
+
+            for (int t = 0; t < TOPICS_PER_CONSUMER; ++t)
+            {
+                NSCacheTopicSubData * topicData =
+                        (NSCacheTopicSubData *) OICMalloc(sizeof(NSCacheTopicSubData));
+                OICStrcpy(topicData->id, NS_UUID_STRING_SIZE, consumerId(i).c_str());
+                topicData->topicName = OICStrdup(topicName((i + t) % TOPIC_COUNT).c_str());
+
+                NSCacheElement * topicElement =
+                        (NSCacheElement *) OICMalloc(sizeof(NSCacheElement));
+                topicElement->data = (NSCacheData *) topicData;
+                topicElement->next = NULL;
+                ASSERT_EQ(NS_OK, NSProviderStorageWrite(topicList, topicElement));
+            }
+        }
+    }
+
+    void TearDown()
+    {
+        NSProviderStorageDestroy(subList);
+        NSProviderStorageDestroy(topicList);
+        pthread_mutex_destroy(&NSCacheMutex);
+        pthread_mutexattr_destroy(&NSCacheMutexAttr);
+    }
+
+    NSCacheList * subList;
+    NSCacheList * topicList;
+};
+
+TEST_F(NotificationProviderCacheBenchmark, TopicNotificationFanOut)
+{
+    size_t total = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < MESSAGE_COUNT; ++i)
+    {
+        OCObservationId * obArray = NULL;
+        size_t obCount = 0;
+        std::string topic = topicName(i % TOPIC_COUNT);
+
+        ASSERT_EQ(NS_OK, NSProviderGetMessageObservers(subList, topicList, topic.c_str(),
+                &obArray, &obCount));
+        ASSERT_EQ((size_t) (CONSUMER_COUNT / TOPIC_COUNT * TOPICS_PER_CONSUMER), obCount);
+
+        total += obCount;
+        OICFree(obArray);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "{\"benchmark\":\"TopicNotificationFanOut\",\"consumers\":" << CONSUMER_COUNT
+              << ",\"topics\":" << TOPIC_COUNT << ",\"messages\":" << MESSAGE_COUNT
+              << ",\"observers\":" << total
+              << ",\"notificationsPerSec\":" << (MESSAGE_COUNT / elapsed.count()) << "}"
+              << std::endl;
+}
+
+TEST_F(NotificationProviderCacheBenchmark, BroadcastNotificationFanOut)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < MESSAGE_COUNT / 10; ++i)
+    {
+        OCObservationId * obArray = NULL;
+        size_t obCount = 0;
+
+        ASSERT_EQ(NS_OK, NSProviderGetMessageObservers(subList, topicList, NULL,
+                &obArray, &obCount));
+        ASSERT_EQ((size_t) CONSUMER_COUNT, obCount);
+        OICFree(obArray);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "{\"benchmark\":\"BroadcastNotificationFanOut\",\"consumers\":"
+              << CONSUMER_COUNT << ",\"messages\":" << MESSAGE_COUNT / 10
+              << ",\"notificationsPerSec\":" << ((MESSAGE_COUNT / 10) / elapsed.count()) << "}"
+              << std::endl;
+}
+
+TEST_F(NotificationProviderCacheBenchmark, SubscriberLookupById)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < CONSUMER_COUNT; ++i)
+    {
+        ASSERT_TRUE(NULL != NSProviderStorageRead(subList, consumerId(i).c_str()));
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "{\"benchmark\":\"SubscriberLookupById\",\"consumers\":" << CONSUMER_COUNT
+              << ",\"lookupsPerSec\":" << (CONSUMER_COUNT / elapsed.count()) << "}"
+              << std::endl;
+}
+
+TEST_F(NotificationProviderCacheBenchmark, UnsubscribedConsumerLeavesTopicIndex)
+{
+    std::string topic = topicName(0);
+    NSCacheTopicSubData topicData;
+    OICStrcpy(topicData.id, NS_UUID_STRING_SIZE, consumerId(0).c_str());
+    topicData.topicName = (char *) topic.c_str();
+
+    OCObservationId * obArray = NULL;
+    size_t before = 0;
+    size_t after = 0;
+
+    ASSERT_EQ(NS_OK, NSProviderGetMessageObservers(subList, topicList, topic.c_str(),
+            &obArray, &before));
+    OICFree(obArray);
+
+    ASSERT_EQ(NS_OK, NSProviderDeleteConsumerTopic(topicList, &topicData));
+
+    ASSERT_EQ(NS_OK, NSProviderGetMessageObservers(subList, topicList, topic.c_str(),
+            &obArray, &after));
+    OICFree(obArray);
+
+    EXPECT_EQ(before - 1, after);
+}
+
+TEST_F(NotificationProviderCacheBenchmark, NotifyMoreThan255Observers)
+{
+    OCObservationId * obArray = NULL;
+    size_t obCount = 0;
+    ASSERT_EQ(NS_OK, NSProviderGetMessageObservers(subList, topicList, topicName(0).c_str(),
+            &obArray, &obCount));
+    ASSERT_LT((size_t) UINT8_MAX, obCount);
+
+    std::vector<OCObservationId> notified;
+    std::vector<uint8_t> chunks;
+    MockRepository mocks;
+    mocks.OnCallFunc(OCNotifyListOfObservers).Do(
+            [&](OCResourceHandle, OCObservationId * obsIdList, uint8_t numberOfIds,
+                    const OCRepPayload *, OCQualityOfService) -> OCStackResult
+            {
+                chunks.push_back(numberOfIds);
+                notified.insert(notified.end(), obsIdList, obsIdList + numberOfIds);
+                return OC_STACK_OK;
+            });
+
+    EXPECT_EQ(OC_STACK_OK, NSNotifyListOfObservers(NULL, obArray, obCount, NULL, OC_LOW_QOS));
+
+    ASSERT_EQ((obCount + UINT8_MAX - 1) / UINT8_MAX, chunks.size());
+    EXPECT_EQ(std::vector<OCObservationId>(obArray, obArray + obCount), notified);
+    OICFree(obArray);
+}
@@ -27,6 +27,7 @@
 #ifndef RCSREMOTERESOURCEOBJECT_H
 #define RCSREMOTERESOURCEOBJECT_H
 
+#include <unordered_map>
 #include <vector>
 
 #include "RCSResourceAttributes.h"
@@ -33,7 +33,6 @@
 #define BOOST_MPL_LIMIT_VECTOR_SIZE 30
 
 #include <functional>
-#include <unordered_map>
 #include <vector>
 
 #include "boost/variant.hpp"
@@ -43,6 +42,7 @@
 #include "boost/mpl/begin_end.hpp"
 #include "boost/scoped_ptr.hpp"
 
+#include "FlatMap.h"
 #include "RCSException.h"
 
 /** OIC namespace */
@@ -773,7 +773,7 @@ namespace OIC
             }
 
         private:
-            std::unordered_map< std::string, Value > m_values;
+            OC::FlatMap< std::string, Value > m_values;
 
             //! @cond
             friend class ResourceAttributesConverter;
@@ -1006,7 +1006,7 @@ namespace OIC
                 public std::iterator< std::forward_iterator_tag, RCSResourceAttributes::KeyValuePair >
         {
         private:
-            typedef std::unordered_map< std::string, Value >::iterator base_iterator;
+            typedef OC::FlatMap< std::string, Value >::iterator base_iterator;
 
         public:
             /** constructor */
@@ -1051,7 +1051,7 @@ namespace OIC
                                        const RCSResourceAttributes::KeyValuePair >
         {
         private:
-            typedef std::unordered_map< std::string, Value >::const_iterator base_iterator;
+            typedef OC::FlatMap< std::string, Value >::const_iterator base_iterator;
 
         public:
             /** constructor */
@@ -30,6 +30,7 @@
 #include <mutex>
 #include <thread>
 #include <map>
+#include <unordered_map>
 
 #include "RCSResourceAttributes.h"
 #include "RCSResponse.h"
@@ -230,6 +230,12 @@ namespace OIC
             public:
                 ResourceAttributesBuilder() = default;
 
+                /** reserve room for the given number of attributes */
+                void reserve(size_t size)
+                {
+                    m_target.m_values.reserve(size);
+                }
+
                 /** insert items */
                 void insertItem(const OC::OCRepresentation::AttributeItem& item)
                 {
@@ -384,6 +390,7 @@ namespace OIC
                     const OC::OCRepresentation& ocRepresentation)
             {
                 ResourceAttributesBuilder builder;
+                builder.reserve(ocRepresentation.size());
 
                 for (const auto& item : ocRepresentation)
                 {
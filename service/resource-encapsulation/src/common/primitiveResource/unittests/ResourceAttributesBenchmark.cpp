@@ -0,0 +1,141 @@
+//******************************************************************
+//
+// Copyright 2026 The IoTivity Project Contributors
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+// C++ heap allocations and time spent on the attributes of a small sensor
+// reading for each GET, on the server from RCSResourceAttributes to the
+// payload and on the client from the payload back to RCSResourceAttributes.
+// Allocations of the C stack (OICMalloc) are not counted. Results are printed
+// as one JSON object per benchmark.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include "RCSResourceAttributes.h"
+#include "ResourceAttributesConverter.h"
+#include "ocpayload.h"
+
+using namespace OIC::Service;
+
+namespace
+{
+    const int GET_COUNT = 100000;
+
+    std::atomic<long> g_allocations(0);
+
+    RCSResourceAttributes sensorReading()
+    {
+        RCSResourceAttributes attrs;
+        attrs["temperature"] = 21.5;
+        attrs["humidity"] = 40;
+        attrs["units"] = "C";
+        attrs["status"] = "normal";
+        attrs["timestamp"] = 1476835200;
+        attrs["range"] = std::vector< double >{ -40.0, 125.0 };
+        return attrs;
+    }
+
+    void report(const char *name, long allocations, double seconds)
+    {
+        std::cout << "{\"benchmark\":\"" << name << "\",\"gets\":" << GET_COUNT
+                  << ",\"allocationsPerGet\":" << (double)allocations / GET_COUNT
+                  << ",\"getsPerSec\":" << (GET_COUNT / seconds) << "}" << std::endl;
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    g_allocations++;
+    void *ptr = std::malloc(size ? size : 1);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+TEST(ResourceAttributesBenchmark, ServerGet)
+{
+    const RCSResourceAttributes attrs = sensorReading();
+
+    long allocations = g_allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < GET_COUNT; i++)
+    {
+        OCRepPayload *payload = ResourceAttributesConverter::toOCRepresentation(attrs).getPayload();
+        ASSERT_TRUE(NULL != payload);
+        OCRepPayloadDestroy(payload);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    report("ServerGet", g_allocations - allocations, elapsed.count());
+}
+
+TEST(ResourceAttributesBenchmark, ClientGet)
+{
+    OCRepPayload *payload = ResourceAttributesConverter::toOCRepresentation(
+            sensorReading()).getPayload();
+    ASSERT_TRUE(NULL != payload);
+
+    long allocations = g_allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < GET_COUNT; i++)
+    {
+        OC::MessageContainer message;
+        message.setPayload(payload);
+        RCSResourceAttributes attrs =
+                ResourceAttributesConverter::fromOCRepresentation(message.representations()[0]);
+        ASSERT_EQ(6u, attrs.size());
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    report("ClientGet", g_allocations - allocations, elapsed.count());
+
+    OCRepPayloadDestroy(payload);
+}
+
+TEST(ResourceAttributesBenchmark, Lookup)
+{
+    const RCSResourceAttributes attrs = sensorReading();
+
+    double sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < GET_COUNT; i++)
+    {
+        sum += attrs.at("temperature").get< double >() + attrs.at("humidity").get< int >();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "{\"benchmark\":\"Lookup\",\"lookups\":" << 2 * GET_COUNT
+              << ",\"lookupsPerSec\":" << (2 * GET_COUNT / elapsed.count()) << "}" << std::endl;
+
+    EXPECT_EQ(GET_COUNT * 61.5, sum);
+}
@@ -21,7 +21,9 @@
 #include "SceneCollectionResource.h"
 
 #include <atomic>
+#include <thread>
 #include "OCApi.h"
+#include "RCSException.h"
 #include "RCSRequest.h"
 #include "RCSSeparateResponse.h"
 
@@ -36,7 +38,8 @@ namespace OIC
 
         SceneCollectionResource::SceneCollectionResource()
         : m_uri(PREFIX_SCENE_COLLECTION_URI + "/" + std::to_string(g_numOfSceneCollection++)),
-          m_address(), m_sceneCollectionResourceObject(), m_requestHandler()
+          m_address(), m_sceneCollectionResourceObject(),
+          m_maxConcurrentExecutes(SCENE_MAX_CONCURRENT_EXECUTES), m_requestHandler()
         {
             m_sceneCollectionResourceObject = createResourceObject();
         }
@@ -174,33 +177,54 @@ namespace OIC
 
         void SceneCollectionResource::execute(
                 std::string && sceneName, SceneExecuteCallback executeCB)
+        {
+            if (!executeCB)
+            {
+                executeWithResult(std::move(sceneName), nullptr);
+                return;
+            }
+
+            executeWithResult(std::move(sceneName),
+                    [executeCB](int eCode, const std::vector< MemberExecuteResult > &)
+                    {
+                        executeCB(eCode);
+                    });
+        }
+
+        void SceneCollectionResource::executeWithResult(
+                std::string && sceneName, SceneExecuteResultCallback executeCB)
         {
             auto sceneValues = m_sceneCollectionResourceObject->getAttributeValue(
                     SCENE_KEY_SCENEVALUES).get< std::vector< std::string > >();
 
             auto foundSceneValue
                 = std::find(sceneValues.begin(), sceneValues.end(), sceneName);
-            if (foundSceneValue == sceneValues.end() && executeCB && !m_sceneMembers.size())
+            if (foundSceneValue == sceneValues.end())
             {
-                std::thread(std::move(executeCB), SCENE_CLIENT_BADREQUEST).detach();
+                // Never called back inline, the caller may still be handling the request.
+                if (executeCB)
+                {
+                    std::thread(std::move(executeCB), SCENE_CLIENT_BADREQUEST,
+                            std::vector< MemberExecuteResult >()).detach();
+                }
                 return;
             }
 
             m_sceneCollectionResourceObject->setAttribute(
                     SCENE_KEY_LAST_SCENE, sceneName);
 
-            {
-                std::lock_guard<std::mutex> memberlock(m_sceneMemberLock);
-                auto executeHandler
-                    = SceneExecuteResponseHandler::createExecuteHandler(
-                            shared_from_this(), std::move(executeCB));
-                for (auto & it : m_sceneMembers)
-                {
-                    it->execute(std::move(sceneName), std::bind(
-                            &SceneExecuteResponseHandler::onResponse, executeHandler,
-                            std::placeholders::_1, std::placeholders::_2));
-                }
-            }
+            // Members without an action for this scene have nothing to do.
+            // The copy lets the requests go out without holding m_sceneMemberLock.
+            auto members = findSceneMembers(sceneName);
+
+            auto executeHandler = SceneExecuteResponseHandler::createExecuteHandler(
+                    std::move(sceneName), std::move(members), std::move(executeCB));
+            executeHandler->start(m_maxConcurrentExecutes);
+        }
+
+        void SceneCollectionResource::setMaxConcurrentExecutes(unsigned int maxExecutes)
+        {
+            m_maxConcurrentExecutes = maxExecutes;
         }
 
         std::string SceneCollectionResource::getId() const
@@ -428,15 +452,135 @@ namespace OIC
                     });
         }
 
-        void SceneCollectionResource::SceneExecuteResponseHandler::
-        onResponse(const RCSResourceAttributes & /*attributes*/, int errorCode)
+        SceneCollectionResource::SceneExecuteResponseHandler::Ptr
+        SceneCollectionResource::SceneExecuteResponseHandler::createExecuteHandler(
+                std::string && sceneName, std::vector<SceneMemberResource::Ptr> && members,
+                SceneExecuteResultCallback executeCB)
         {
-            std::unique_lock<std::mutex> responseLock(m_responseMutex);
+            auto executeHandler = std::make_shared<SceneExecuteResponseHandler>();
+
+            executeHandler->m_sceneName = std::move(sceneName);
+            executeHandler->m_members = std::move(members);
+            executeHandler->m_numOfMembers = executeHandler->m_members.size();
+            executeHandler->m_responseMembers = 0;
+            executeHandler->m_nextMember = 0;
+            executeHandler->m_results.resize(executeHandler->m_numOfMembers);
+            executeHandler->m_cb = std::move(executeCB);
+            executeHandler->m_errorCode  = SCENE_RESPONSE_SUCCESS;
+
+            return executeHandler;
+        }
+
+        void SceneCollectionResource::SceneExecuteResponseHandler::start(
+                unsigned int maxConcurrentExecutes)
+        {
+            if (m_numOfMembers == 0)
+            {
+                // Reported from another thread, like the responses of the members.
+                if (m_cb)
+                {
+                    std::thread(std::move(m_cb), m_errorCode, m_results).detach();
+                }
+                return;
+            }
+
+            size_t numOfRequests = m_numOfMembers;
+            if (maxConcurrentExecutes != 0 && maxConcurrentExecutes < numOfRequests)
+            {
+                numOfRequests = maxConcurrentExecutes;
+            }
+
+            {
+                std::lock_guard<std::mutex> responseLock(m_responseMutex);
+                m_nextMember = numOfRequests;
+            }
+
+            for (size_t i = 0; i < numOfRequests; ++i)
+            {
+                executeMember(i);
+            }
+        }
+
+        void SceneCollectionResource::SceneExecuteResponseHandler::executeMember(size_t index)
+        {
+            // Members failing right away are accounted here and their slot moves on to the
+            // next member in this loop rather than by recursion.
+            while (true)
+            {
+                auto startTime = std::chrono::steady_clock::now();
+                m_results[index].targetUri = m_members[index]->getTargetUri();
+
+                try
+                {
+                    m_members[index]->execute(m_sceneName, std::bind(
+                            &SceneExecuteResponseHandler::onResponse, shared_from_this(), index,
+                            startTime, std::placeholders::_1, std::placeholders::_2));
+                    return;
+                }
+                catch (const RCSException &)
+                {
+                }
+
+                std::unique_lock<std::mutex> responseLock(m_responseMutex);
+                size_t next = 0;
+                if (recordResponse(index, startTime, SCENE_SERVER_INTERNALSERVERERROR, next))
+                {
+                    index = next;
+                    continue;
+                }
+
+                if (m_responseMembers == m_numOfMembers)
+                {
+                    // Not on the caller's stack, the result is reported from another thread
+                    // like the responses of the members.
+                    responseLock.unlock();
+                    if (m_cb)
+                    {
+                        std::thread(std::move(m_cb), m_errorCode, m_results).detach();
+                    }
+                }
+                return;
+            }
+        }
+
+        // Called with m_responseMutex held, returns true if member next is to be executed.
+        bool SceneCollectionResource::SceneExecuteResponseHandler::
+        recordResponse(size_t index, std::chrono::steady_clock::time_point startTime,
+                int errorCode, size_t & next)
+        {
+            m_results[index].errorCode = errorCode;
+            m_results[index].latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - startTime);
+
             m_responseMembers++;
             if (errorCode != SCENE_RESPONSE_SUCCESS && m_errorCode != errorCode)
             {
                 m_errorCode = errorCode;
             }
+
+            // Keep the window full, the next member goes out as soon as one responded.
+            if (m_nextMember < m_numOfMembers)
+            {
+                next = m_nextMember++;
+                return true;
+            }
+
+            return false;
+        }
+
+        void SceneCollectionResource::SceneExecuteResponseHandler::
+        onResponse(size_t index, std::chrono::steady_clock::time_point startTime,
+                const RCSResourceAttributes & /*attributes*/, int errorCode)
+        {
+            std::unique_lock<std::mutex> responseLock(m_responseMutex);
+            size_t next = 0;
+            if (recordResponse(index, startTime, errorCode, next))
+            {
+                responseLock.unlock();
+                executeMember(next);
+                return;
+            }
+
             if (m_responseMembers == m_numOfMembers)
             {
                /* Explicitly unlocking the unique_lock.
@@ -446,31 +590,12 @@ namespace OIC
                 * returns. So, its better to release the lock explicitly.
                 */
                 responseLock.unlock();
-                m_cb(m_errorCode);
+                if (m_cb)
+                {
+                    m_cb(m_errorCode, m_results);
+                }
             }
         }
 
-        SceneCollectionResource::SceneExecuteResponseHandler::Ptr
-        SceneCollectionResource::SceneExecuteResponseHandler::createExecuteHandler(
-                const SceneCollectionResource::Ptr ptr, SceneExecuteCallback executeCB)
-        {
-            auto executeHandler = std::make_shared<SceneExecuteResponseHandler>();
-
-            executeHandler->m_numOfMembers = ptr->m_sceneMembers.size();
-            executeHandler->m_responseMembers = 0;
-
-            executeHandler->m_cb =
-                    [executeCB](int eCode)
-                    {
-                        std::thread(std::move(executeCB), eCode).detach();
-                    };
-
-            executeHandler->m_owner
-                = std::weak_ptr<SceneCollectionResource>(ptr);
-            executeHandler->m_errorCode  = SCENE_RESPONSE_SUCCESS;
-
-            return executeHandler;
-        }
-
     }
 }
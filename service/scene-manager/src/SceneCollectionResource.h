@@ -21,7 +21,10 @@
 #ifndef SCENE_COLLECTION_RESOURCE_OBJECT_H
 #define SCENE_COLLECTION_RESOURCE_OBJECT_H
 
+#include <atomic>
+#include <chrono>
 #include <list>
+#include <mutex>
 
 #include "RCSResourceObject.h"
 #include "SceneCommons.h"
@@ -39,6 +42,17 @@ namespace OIC
             typedef std::shared_ptr< SceneCollectionResource > Ptr;
             typedef std::function< void(int) > SceneExecuteCallback;
 
+            /** result of one scene member in a scene execution */
+            struct MemberExecuteResult
+            {
+                std::string targetUri;
+                int errorCode;
+                std::chrono::milliseconds latency;
+            };
+
+            typedef std::function< void(int, const std::vector< MemberExecuteResult > &) >
+                    SceneExecuteResultCallback;
+
             ~SceneCollectionResource() = default;
 
             static SceneCollectionResource::Ptr create();
@@ -67,6 +81,20 @@ namespace OIC
             void execute(std::string &&, SceneExecuteCallback);
             void execute(const std::string &, SceneExecuteCallback);
 
+            /**
+             * execute the given scene name and report the result of every member
+             * once all of them responded
+             * @param name of the scene to execute
+             * @param callback with the aggregated error code and the member results
+             */
+            void executeWithResult(std::string &&, SceneExecuteResultCallback);
+
+            /**
+             * set how many member requests of one scene execution are in flight at once
+             * @param maximum number of requests, 0 for no limit
+             */
+            void setMaxConcurrentExecutes(unsigned int);
+
             /**
              * set the scene name
              * @param string name to set
@@ -99,26 +127,36 @@ namespace OIC
 
         private:
             class SceneExecuteResponseHandler
+                    : public std::enable_shared_from_this<SceneExecuteResponseHandler>
             {
             public:
                 typedef std::shared_ptr<SceneExecuteResponseHandler> Ptr;
 
                 SceneExecuteResponseHandler()
-                : m_numOfMembers(0), m_responseMembers(0), m_errorCode(0)
+                : m_numOfMembers(0), m_responseMembers(0), m_nextMember(0), m_errorCode(0)
                 {
                 }
                 ~SceneExecuteResponseHandler() = default;
 
-                int m_numOfMembers;
-                int m_responseMembers;
+                size_t m_numOfMembers;
+                size_t m_responseMembers;
+                size_t m_nextMember;
                 int m_errorCode;
-                std::weak_ptr<SceneCollectionResource> m_owner;
-                SceneExecuteCallback m_cb;
+                std::string m_sceneName;
+                std::vector<SceneMemberResource::Ptr> m_members;
+                std::vector<MemberExecuteResult> m_results;
+                SceneExecuteResultCallback m_cb;
                 std::mutex m_responseMutex;
 
                 static SceneExecuteResponseHandler::Ptr createExecuteHandler(
-                        const SceneCollectionResource::Ptr, SceneExecuteCallback);
-                void onResponse(const RCSResourceAttributes &, int);
+                        std::string &&, std::vector<SceneMemberResource::Ptr> &&,
+                        SceneExecuteResultCallback);
+                void start(unsigned int);
+                void executeMember(size_t);
+                bool recordResponse(size_t, std::chrono::steady_clock::time_point, int,
+                        size_t &);
+                void onResponse(size_t, std::chrono::steady_clock::time_point,
+                        const RCSResourceAttributes &, int);
             };
 
             class SceneCollectionRequestHandler
@@ -152,6 +190,7 @@ namespace OIC
             RCSResourceObject::Ptr m_sceneCollectionResourceObject;
             mutable std::mutex m_sceneMemberLock;
             std::vector<SceneMemberResource::Ptr> m_sceneMembers;
+            std::atomic_uint m_maxConcurrentExecutes;
 
             SceneCollectionRequestHandler m_requestHandler;
 
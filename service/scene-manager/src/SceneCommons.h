@@ -79,6 +79,8 @@ namespace OIC
         const int SCENE_CLIENT_BADREQUEST = 400;                                   /*!< bad request */
         const int SCENE_SERVER_INTERNALSERVERERROR = 500;                          /*!< internal server error */
 
+        const unsigned int SCENE_MAX_CONCURRENT_EXECUTES = 64;                     /*!< member requests in flight per scene execution */
+
         /**
          * @class   SceneUtils
          */
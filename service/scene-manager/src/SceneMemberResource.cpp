@@ -209,9 +209,13 @@ namespace OIC
                         }
                     });
 
-            if (setAtt.empty() && executeCB != nullptr)
+            if (setAtt.empty())
             {
-                executeCB(RCSResourceAttributes(), SCENE_RESPONSE_SUCCESS);
+                if (executeCB != nullptr)
+                {
+                    executeCB(RCSResourceAttributes(), SCENE_RESPONSE_SUCCESS);
+                }
+                return;
             }
 
             m_remoteMemberObj->setRemoteAttributes(setAtt, executeCB);
@@ -211,3 +211,38 @@ TEST_F(SceneTest, executeSceneUsingEmptyCallback)
 
     ASSERT_THROW(pScene1->execute(nullptr), RCSInvalidParameterException);
 }
+
+TEST_F(SceneTest, executeSceneWithManyMembers)
+{
+    const int numOfMembers = 100;
+    std::vector<RCSResourceObject::Ptr> servers;
+
+    createSceneCollection();
+    createScene();
+    for (int i = 0; i < numOfMembers; ++i)
+    {
+        std::string uri = "/a/testuri4_" + std::to_string(i);
+        auto pResource = RCSResourceObject::Builder(
+                uri, RESOURCE_TYPE, DEFAULT_INTERFACE).build();
+        pResource->setAttribute(KEY, VALUE);
+        servers.push_back(pResource);
+
+        auto ocResourcePtr = OC::OCPlatform::constructResourceObject(
+                "coap://" + SceneUtils::getNetAddress(), uri,
+                OCConnectivityType::CT_ADAPTER_IP, false,
+                pResource->getTypes(), pResource->getInterfaces());
+        pScene1->addNewSceneAction(
+                RCSRemoteResourceObject::fromOCResource(ocResourcePtr), KEY, "on");
+    }
+
+    mocks.ExpectCallFunc(executeCallback).Match([](int code)
+    {
+        return code == SCENE_RESPONSE_SUCCESS;
+    }).Do([this](int)
+    {
+        proceed();
+    });
+
+    pScene1->execute(executeCallback);
+    waitForCb(3000);
+}
@@ -0,0 +1,239 @@
+/******************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+// Open-loop load generator for OIC servers. Runs against servers on the network,
+// or with -l against simulated resources hosted in the same process, which are
+// reached over the loopback interface. Results are printed as a JSON object.
+
+#include "simulator_manager.h"
+#include "simulator_load_generator.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <getopt.h>
+
+namespace
+{
+    const char *DEFAULT_RESOURCE_TYPE = "oic.r.loadgen";
+
+    void printUsage(const char *name)
+    {
+        std::cout << "Usage: " << name << " [options]" << std::endl;
+        std::cout << "  -s <scenario>  requests, observe or discovery (default requests)" << std::endl;
+        std::cout << "  -r <rate>      requests, updates or discoveries per second (default 100)"
+                  << std::endl;
+        std::cout << "  -c <threads>   threads issuing the schedule (default 4)" << std::endl;
+        std::cout << "  -d <seconds>   length of the run (default 10)" << std::endl;
+        std::cout << "  -t <ms>        time to wait for late responses (default 5000)" << std::endl;
+        std::cout << "  -m <g:p:p>     GET:PUT:POST request mix (default 1:0:0)" << std::endl;
+        std::cout << "  -T <type>      resource type of the targets (default "
+                  << DEFAULT_RESOURCE_TYPE << ")" << std::endl;
+        std::cout << "  -l <count>     host <count> simulated resources in this process" << std::endl;
+        std::cout << "  -w <ms>        time to wait for discovery of the targets (default 2000)"
+                  << std::endl;
+        std::cout << "  -o <file>      write the report to <file> instead of stdout" << std::endl;
+    }
+
+    bool parseMix(const std::string &mix, LoadConfig &config)
+    {
+        return 3 == sscanf(mix.c_str(), "%u:%u:%u", &config.getWeight, &config.putWeight,
+                           &config.postWeight);
+    }
+
+    std::vector<SimulatorSingleResourceSP> createResources(unsigned int count,
+            const std::string &resourceType)
+    {
+        std::vector<SimulatorSingleResourceSP> resources;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            std::string name = "loadgen" + std::to_string(i);
+            SimulatorSingleResourceSP resource = SimulatorManager::getInstance()->createSingleResource(
+                    name, "/loadgen/" + std::to_string(i), resourceType);
+
+            SimulatorResourceAttribute value("value");
+            value.setProperty(IntegerProperty::build(0));
+            value.setValue(0);
+            resource->addAttribute(value);
+
+            SimulatorResourceAttribute timestamp(SimulatorLoadGenerator::TIMESTAMP_ATTRIBUTE);
+            timestamp.setProperty(DoubleProperty::build(0.0));
+            timestamp.setValue(0.0);
+            resource->addAttribute(timestamp);
+
+            resource->setObservable(true);
+            resource->start();
+            resources.push_back(resource);
+        }
+        return resources;
+    }
+
+    std::vector<SimulatorRemoteResourceSP> findTargets(const std::string &resourceType,
+            unsigned int wait)
+    {
+        std::mutex lock;
+        std::set<std::string> ids;
+        std::vector<SimulatorRemoteResourceSP> targets;
+
+        SimulatorManager::getInstance()->findResource(resourceType,
+                [&](std::shared_ptr<SimulatorRemoteResource> resource)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (ids.insert(resource->getID()).second)
+            {
+                targets.push_back(resource);
+            }
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(wait));
+
+        std::lock_guard<std::mutex> guard(lock);
+        return targets;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    LoadConfig config;
+    config.scenario = LoadScenario::REQUESTS;
+    config.rate = 100;
+    config.concurrency = 4;
+    config.duration = 10000;
+    config.timeout = 5000;
+    config.getWeight = 1;
+    config.putWeight = 0;
+    config.postWeight = 0;
+
+    std::string resourceType = DEFAULT_RESOURCE_TYPE;
+    std::string output;
+    unsigned int loopbackCount = 0;
+    unsigned int discoveryWait = 2000;
+
+    int opt;
+    while (-1 != (opt = getopt(argc, argv, "s:r:c:d:t:m:T:l:w:o:h")))
+    {
+        switch (opt)
+        {
+            case 's':
+                if (std::string("requests") == optarg)
+                {
+                    config.scenario = LoadScenario::REQUESTS;
+                }
+                else if (std::string("observe") == optarg)
+                {
+                    config.scenario = LoadScenario::OBSERVE_FAN_IN;
+                }
+                else if (std::string("discovery") == optarg)
+                {
+                    config.scenario = LoadScenario::DISCOVERY_STORM;
+                }
+                else
+                {
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'r': config.rate = atof(optarg); break;
+            case 'c': config.concurrency = atoi(optarg); break;
+            case 'd': config.duration = atoi(optarg) * 1000; break;
+            case 't': config.timeout = atoi(optarg); break;
+            case 'm':
+                if (!parseMix(optarg, config))
+                {
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'T': resourceType = optarg; break;
+            case 'l': loopbackCount = atoi(optarg); break;
+            case 'w': discoveryWait = atoi(optarg); break;
+            case 'o': output = optarg; break;
+            default:
+                printUsage(argv[0]);
+                return ('h' == opt) ? 0 : 1;
+        }
+    }
+
+    try
+    {
+        std::vector<SimulatorSingleResourceSP> sources = createResources(loopbackCount,
+                resourceType);
+
+        SimulatorLoadGenerator generator(config);
+        generator.setResourceType(resourceType);
+
+        SimulatorResourceModel representation;
+        representation.add("value", 1);
+        generator.setRepresentation(representation);
+
+        if (LoadScenario::DISCOVERY_STORM != config.scenario)
+        {
+            std::vector<SimulatorRemoteResourceSP> targets = findTargets(resourceType,
+                    discoveryWait);
+            if (targets.empty())
+            {
+                std::cerr << "No resources of type " << resourceType << " found!" << std::endl;
+                return 1;
+            }
+
+            for (auto &target : targets)
+            {
+                generator.addTarget(target);
+            }
+        }
+
+        if (LoadScenario::OBSERVE_FAN_IN == config.scenario)
+        {
+            for (auto &source : sources)
+            {
+                generator.addSource(source);
+            }
+        }
+
+        LoadReport report = generator.run();
+
+        for (auto &source : sources)
+        {
+            source->stop();
+        }
+
+        if (output.empty())
+        {
+            std::cout << report.toJSON() << std::endl;
+        }
+        else
+        {
+            std::ofstream file(output);
+            file << report.toJSON() << std::endl;
+        }
+    }
+    catch (SimulatorException &e)
+    {
+        std::cerr << "SimulatorException occured [code : " << e.code() << " Detail: "
+                  << e.what() << "]" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,193 @@
+/******************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/**
+ * @file simulator_load_generator.h
+ *
+ * @brief This file provides a class for generating load against remote resources and
+ *        measuring the latency of the responses.
+ *
+ */
+
+#ifndef SIMULATOR_LOAD_GENERATOR_H_
+#define SIMULATOR_LOAD_GENERATOR_H_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "simulator_client_types.h"
+#include "simulator_remote_resource.h"
+#include "simulator_single_resource.h"
+#include "simulator_uncopyable.h"
+
+/** enum for load scenario */
+enum class LoadScenario
+{
+    REQUESTS,          /**< GET/PUT/POST requests spread over the targets */
+    OBSERVE_FAN_IN,    /**< notifications from all targets observed at once */
+    DISCOVERY_STORM    /**< repeated multicast discovery of a resource type */
+};
+
+/** structure for load generation parameters */
+typedef struct
+{
+    LoadScenario scenario;     /**< scenario to run */
+    double rate;               /**< requests, updates or discoveries per second */
+    unsigned int concurrency;  /**< number of threads issuing the schedule */
+    unsigned int duration;     /**< length of the run in milliseconds */
+    unsigned int timeout;      /**< time in milliseconds to wait for late responses */
+    unsigned int getWeight;    /**< share of GET requests in the REQUESTS scenario */
+    unsigned int putWeight;    /**< share of PUT requests in the REQUESTS scenario */
+    unsigned int postWeight;   /**< share of POST requests in the REQUESTS scenario */
+} LoadConfig;
+
+/** structure for latency statistics of one method and resource, times in milliseconds */
+typedef struct
+{
+    uint64_t sent;        /**< requests sent */
+    uint64_t received;    /**< successful responses */
+    uint64_t errors;      /**< failed sends and error responses */
+    uint64_t timeouts;    /**< requests without response at the end of the run */
+    double min;           /**< lowest latency */
+    double mean;          /**< mean latency */
+    double p50;           /**< median latency */
+    double p99;           /**< 99th percentile latency */
+    double p999;          /**< 99.9th percentile latency */
+    double max;           /**< highest latency */
+} LatencyStats;
+
+/**
+ * @class   LoadReport
+ * @brief   Result of a load generation run.
+ */
+class LoadReport
+{
+    public:
+        LoadScenario scenario;       /**< scenario that was run */
+        double targetRate;           /**< configured rate per second */
+        double achievedRate;         /**< rate per second at which the schedule was issued */
+        unsigned int concurrency;    /**< number of threads issuing the schedule */
+        double duration;             /**< time taken to issue the schedule in milliseconds */
+
+        /**
+         * Statistics keyed by "<METHOD> <URI>", plus "<METHOD> *" over all resources.
+         * Methods are GET, PUT and POST, NOTIFY for observe notifications and
+         * DISCOVER for the time to the first discovery response.
+         */
+        std::map<std::string, LatencyStats> stats;
+
+        /**
+         * API for getting the report as a JSON object.
+         *
+         * @return JSON string.
+         */
+        std::string toJSON() const;
+};
+
+class LoadRecorder;
+
+/**
+ * @class   SimulatorLoadGenerator
+ * @brief   This class provides an open-loop load generator for remote resources.
+ *
+ * Requests are sent on a fixed schedule derived from the configured rate, whether
+ * or not earlier requests have been answered, and latencies are measured from the
+ * scheduled send time. A slow server therefore shows up as latency instead of
+ * silently lowering the offered load.
+ */
+class SimulatorLoadGenerator : private UnCopyable
+{
+    public:
+        /**
+         * Name of the attribute carrying the update time in notifications of the
+         * OBSERVE_FAN_IN scenario, as microseconds of the monotonic clock.
+         */
+        static const char *TIMESTAMP_ATTRIBUTE;
+
+        /**
+         * @param config - Load generation parameters.
+         *
+         * NOTE: API throws @InvalidArgsException on invalid parameters.
+         */
+        SimulatorLoadGenerator(const LoadConfig &config);
+
+        /**
+         * API to add a remote resource to send requests to or observe.
+         *
+         * @param resource - Remote resource.
+         */
+        void addTarget(const SimulatorRemoteResourceSP &resource);
+
+        /**
+         * API to add a local resource to be updated in the OBSERVE_FAN_IN scenario.
+         * Without sources the notifications of the targets are only counted.
+         * The resource must have a double attribute named @TIMESTAMP_ATTRIBUTE.
+         *
+         * @param resource - Simulated resource.
+         */
+        void addSource(const SimulatorSingleResourceSP &resource);
+
+        /**
+         * API to set the representation sent with PUT and POST requests.
+         *
+         * @param representation - Resource representation.
+         */
+        void setRepresentation(const SimulatorResourceModel &representation);
+
+        /**
+         * API to set the resource type searched for in the DISCOVERY_STORM scenario.
+         *
+         * @param resourceType - Resource type, empty to discover all resources.
+         */
+        void setResourceType(const std::string &resourceType);
+
+        /**
+         * API to run the configured scenario. Blocks for the configured duration
+         * plus the response timeout.
+         *
+         * @return Report of the run.
+         *
+         * NOTE: API throws @SimulatorException if the scenario cannot be started.
+         */
+        LoadReport run();
+
+    private:
+        typedef std::chrono::steady_clock::time_point TimePoint;
+        typedef std::function<void (uint64_t index, TimePoint due)> ScheduledAction;
+
+        void dispatch(ScheduledAction action, LoadReport &report);
+        void sendRequest(const std::shared_ptr<LoadRecorder> &recorder, uint64_t index,
+                         TimePoint due);
+        void runRequests(const std::shared_ptr<LoadRecorder> &recorder, LoadReport &report);
+        void runObserveFanIn(const std::shared_ptr<LoadRecorder> &recorder, LoadReport &report);
+        void runDiscoveryStorm(const std::shared_ptr<LoadRecorder> &recorder,
+                               LoadReport &report);
+
+        LoadConfig m_config;
+        std::vector<SimulatorRemoteResourceSP> m_targets;
+        std::vector<SimulatorSingleResourceSP> m_sources;
+        SimulatorResourceModel m_representation;
+        std::string m_resourceType;
+};
+
+#endif
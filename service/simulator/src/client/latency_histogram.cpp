@@ -0,0 +1,144 @@
+/******************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const unsigned int SUB_BUCKET_BITS = 5;
+    const uint64_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    const uint64_t EXACT_LIMIT = 2 * SUB_BUCKET_COUNT;
+    const unsigned int VALUE_BITS = 64;
+    const size_t BUCKET_COUNT = EXACT_LIMIT +
+                                (VALUE_BITS - SUB_BUCKET_BITS - 1) * SUB_BUCKET_COUNT;
+
+    unsigned int highestBit(uint64_t value)
+    {
+        unsigned int bit = 0;
+        while (value >>= 1)
+        {
+            bit++;
+        }
+        return bit;
+    }
+}
+
+LatencyHistogram::LatencyHistogram()
+    :   m_buckets(BUCKET_COUNT, 0),
+        m_count(0),
+        m_min(0),
+        m_max(0),
+        m_sum(0) {}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value)
+{
+    if (value < EXACT_LIMIT)
+    {
+        return value;
+    }
+
+    // Keep the top SUB_BUCKET_BITS + 1 bits of the value.
+    unsigned int shift = highestBit(value) - SUB_BUCKET_BITS;
+    uint64_t subBucket = (value >> shift) - SUB_BUCKET_COUNT;
+    return EXACT_LIMIT + (shift - 1) * SUB_BUCKET_COUNT + subBucket;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index)
+{
+    if (index < EXACT_LIMIT)
+    {
+        return index;
+    }
+
+    unsigned int shift = (index - EXACT_LIMIT) / SUB_BUCKET_COUNT + 1;
+    uint64_t subBucket = (index - EXACT_LIMIT) % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t latency)
+{
+    m_buckets[bucketIndex(latency)]++;
+    m_min = (0 == m_count) ? latency : std::min(m_min, latency);
+    m_max = std::max(m_max, latency);
+    m_sum += latency;
+    m_count++;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    if (0 == other.m_count)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        m_buckets[i] += other.m_buckets[i];
+    }
+    m_min = (0 == m_count) ? other.m_min : std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    m_sum += other.m_sum;
+    m_count += other.m_count;
+}
+
+uint64_t LatencyHistogram::count() const
+{
+    return m_count;
+}
+
+uint64_t LatencyHistogram::min() const
+{
+    return m_min;
+}
+
+uint64_t LatencyHistogram::max() const
+{
+    return m_max;
+}
+
+double LatencyHistogram::mean() const
+{
+    return (0 == m_count) ? 0 : m_sum / m_count;
+}
+
+uint64_t LatencyHistogram::percentile(double percentile) const
+{
+    if (0 == m_count)
+    {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t) std::ceil(percentile / 100 * m_count);
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += m_buckets[i];
+        if (seen >= rank)
+        {
+            return std::min(bucketUpperBound(i), m_max);
+        }
+    }
+    return m_max;
+}
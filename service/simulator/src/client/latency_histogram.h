@@ -0,0 +1,86 @@
+/******************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/**
+ * @file latency_histogram.h
+ *
+ * @brief This file provides a histogram for recording request latencies.
+ *
+ */
+
+#ifndef SIMULATOR_LATENCY_HISTOGRAM_H_
+#define SIMULATOR_LATENCY_HISTOGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class LatencyHistogram
+ *
+ * Log-linear histogram of latencies in microseconds. Values below 64us are
+ * recorded exactly, larger values into 32 sub-buckets per power of two,
+ * so percentiles are reported with a relative error of at most 1/32.
+ */
+class LatencyHistogram
+{
+    public:
+        LatencyHistogram();
+
+        /**
+         * Record one latency.
+         * @param[in] latency   latency in microseconds
+         */
+        void record(uint64_t latency);
+
+        /**
+         * Add all values recorded in another histogram.
+         * @param[in] other   histogram to merge
+         */
+        void merge(const LatencyHistogram &other);
+
+        /** @return number of recorded values */
+        uint64_t count() const;
+        /** @return smallest recorded value, 0 if empty */
+        uint64_t min() const;
+        /** @return largest recorded value, 0 if empty */
+        uint64_t max() const;
+        /** @return arithmetic mean of the recorded values, 0 if empty */
+        double mean() const;
+
+        /**
+         * Get the value at the given percentile.
+         * @param[in] percentile   percentile in the range [0, 100]
+         * @return upper bound of the bucket holding the percentile, 0 if empty
+         */
+        uint64_t percentile(double percentile) const;
+
+    private:
+        static size_t bucketIndex(uint64_t value);
+        static uint64_t bucketUpperBound(size_t index);
+
+        std::vector<uint64_t> m_buckets;
+        uint64_t m_count;
+        uint64_t m_min;
+        uint64_t m_max;
+        double m_sum;
+};
+
+#endif
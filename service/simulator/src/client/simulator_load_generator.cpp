@@ -0,0 +1,510 @@
+/******************************************************************
+ *
+ * Copyright 2026 The IoTivity Project Contributors
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include "simulator_load_generator.h"
+#include "simulator_manager.h"
+#include "latency_histogram.h"
+#include "simulator_utils.h"
+#include "experimental/logger.h"
+
+#include <condition_variable>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#define TAG "LOAD_GENERATOR"
+
+const char *SimulatorLoadGenerator::TIMESTAMP_ATTRIBUTE = "timestamp";
+
+namespace
+{
+    uint64_t elapsedMicroseconds(std::chrono::steady_clock::time_point since)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - since;
+        return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    }
+
+    double monotonicMicroseconds()
+    {
+        auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+        return (double) std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count();
+    }
+
+    std::string scenarioString(LoadScenario scenario)
+    {
+        switch (scenario)
+        {
+            case LoadScenario::REQUESTS: return "requests";
+            case LoadScenario::OBSERVE_FAN_IN: return "observe";
+            case LoadScenario::DISCOVERY_STORM: return "discovery";
+        }
+
+        return "unknown";
+    }
+
+    std::string escapeJSON(const std::string &value)
+    {
+        std::ostringstream out;
+        for (char c : value)
+        {
+            if ('"' == c || '\\' == c)
+            {
+                out << '\\' << c;
+            }
+            else if ((unsigned char) c < 0x20)
+            {
+                out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int) c
+                    << std::dec;
+            }
+            else
+            {
+                out << c;
+            }
+        }
+        return out.str();
+    }
+
+    bool isSuccess(SimulatorResult result)
+    {
+        return result <= SIMULATOR_RESOURCE_CHANGED;
+    }
+}
+
+/**
+ * @class LoadRecorder
+ *
+ * Counters and latency histograms of one run. Callbacks may outlive the run,
+ * so the recorder is shared with every request in flight.
+ */
+class LoadRecorder
+{
+    public:
+        LoadRecorder() : m_pending(0) {}
+
+        void sent(const std::string &key)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_entries[key].sent++;
+            m_pending++;
+        }
+
+        void failed(const std::string &key)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_entries[key].errors++;
+            completed();
+        }
+
+        void received(const std::string &key, SimulatorResult result, uint64_t latency)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            Entry &entry = m_entries[key];
+            if (isSuccess(result))
+            {
+                entry.received++;
+                entry.histogram.record(latency);
+            }
+            else
+            {
+                entry.errors++;
+            }
+            completed();
+        }
+
+        /** Count a response that was not matched to a request. */
+        void unmatched(const std::string &key)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_entries[key].received++;
+        }
+
+        /** Wait until every request was answered or the timeout passed. */
+        void waitForResponses(std::chrono::milliseconds timeout)
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_cond.wait_for(lock, timeout, [this] { return 0 == m_pending; });
+        }
+
+        void collect(std::map<std::string, LatencyStats> &stats)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+
+            std::map<std::string, Entry> totals;
+            for (auto &entry : m_entries)
+            {
+                std::string method = entry.first.substr(0, entry.first.find(' '));
+                Entry &total = totals[method + " *"];
+                total.sent += entry.second.sent;
+                total.received += entry.second.received;
+                total.errors += entry.second.errors;
+                total.histogram.merge(entry.second.histogram);
+
+                stats[entry.first] = toStats(entry.second);
+            }
+
+            for (auto &total : totals)
+            {
+                stats[total.first] = toStats(total.second);
+            }
+        }
+
+    private:
+        struct Entry
+        {
+            Entry() : sent(0), received(0), errors(0) {}
+
+            uint64_t sent;
+            uint64_t received;
+            uint64_t errors;
+            LatencyHistogram histogram;
+        };
+
+        void completed()
+        {
+            if (m_pending > 0 && 0 == --m_pending)
+            {
+                m_cond.notify_all();
+            }
+        }
+
+        static LatencyStats toStats(const Entry &entry)
+        {
+            const LatencyHistogram &histogram = entry.histogram;
+
+            LatencyStats stats;
+            stats.sent = entry.sent;
+            stats.received = entry.received;
+            stats.errors = entry.errors;
+            stats.timeouts = (entry.sent > entry.received + entry.errors) ?
+                             entry.sent - entry.received - entry.errors : 0;
+            stats.min = histogram.min() / 1000.0;
+            stats.mean = histogram.mean() / 1000.0;
+            stats.p50 = histogram.percentile(50) / 1000.0;
+            stats.p99 = histogram.percentile(99) / 1000.0;
+            stats.p999 = histogram.percentile(99.9) / 1000.0;
+            stats.max = histogram.max() / 1000.0;
+            return stats;
+        }
+
+        std::mutex m_lock;
+        std::condition_variable m_cond;
+        std::map<std::string, Entry> m_entries;
+        uint64_t m_pending;
+};
+
+std::string LoadReport::toJSON() const
+{
+    std::ostringstream out;
+    out << "{\"scenario\":\"" << scenarioString(scenario) << "\""
+        << ",\"targetRate\":" << targetRate
+        << ",\"achievedRate\":" << achievedRate
+        << ",\"concurrency\":" << concurrency
+        << ",\"durationMs\":" << duration
+        << ",\"results\":[";
+
+    bool first = true;
+    for (auto &entry : stats)
+    {
+        const LatencyStats &s = entry.second;
+        out << (first ? "" : ",")
+            << "{\"name\":\"" << escapeJSON(entry.first) << "\""
+            << ",\"sent\":" << s.sent
+            << ",\"received\":" << s.received
+            << ",\"errors\":" << s.errors
+            << ",\"timeouts\":" << s.timeouts
+            << ",\"latencyMs\":{\"min\":" << s.min
+            << ",\"mean\":" << s.mean
+            << ",\"p50\":" << s.p50
+            << ",\"p99\":" << s.p99
+            << ",\"p999\":" << s.p999
+            << ",\"max\":" << s.max << "}}";
+        first = false;
+    }
+
+    out << "]}";
+    return out.str();
+}
+
+SimulatorLoadGenerator::SimulatorLoadGenerator(const LoadConfig &config)
+    :   m_config(config)
+{
+    VALIDATE_INPUT(config.rate <= 0, "Invalid rate!")
+    VALIDATE_INPUT(0 == config.concurrency, "Invalid concurrency!")
+    VALIDATE_INPUT(0 == config.duration, "Invalid duration!")
+    VALIDATE_INPUT(LoadScenario::REQUESTS == config.scenario &&
+                   0 == config.getWeight + config.putWeight + config.postWeight,
+                   "No request types selected!")
+}
+
+void SimulatorLoadGenerator::addTarget(const SimulatorRemoteResourceSP &resource)
+{
+    VALIDATE_INPUT(!resource, "Invalid resource!")
+    m_targets.push_back(resource);
+}
+
+void SimulatorLoadGenerator::addSource(const SimulatorSingleResourceSP &resource)
+{
+    VALIDATE_INPUT(!resource, "Invalid resource!")
+    m_sources.push_back(resource);
+}
+
+void SimulatorLoadGenerator::setRepresentation(const SimulatorResourceModel &representation)
+{
+    m_representation = representation;
+}
+
+void SimulatorLoadGenerator::setResourceType(const std::string &resourceType)
+{
+    m_resourceType = resourceType;
+}
+
+LoadReport SimulatorLoadGenerator::run()
+{
+    LoadReport report;
+    report.scenario = m_config.scenario;
+    report.targetRate = m_config.rate;
+    report.concurrency = m_config.concurrency;
+
+    std::shared_ptr<LoadRecorder> recorder = std::make_shared<LoadRecorder>();
+    switch (m_config.scenario)
+    {
+        case LoadScenario::REQUESTS: runRequests(recorder, report); break;
+        case LoadScenario::OBSERVE_FAN_IN: runObserveFanIn(recorder, report); break;
+        case LoadScenario::DISCOVERY_STORM: runDiscoveryStorm(recorder, report); break;
+    }
+
+    recorder->collect(report.stats);
+    return report;
+}
+
+void SimulatorLoadGenerator::dispatch(ScheduledAction action, LoadReport &report)
+{
+    // The n-th action is due at n / rate seconds, whether or not earlier
+    // actions have completed. Threads take turns so that one slow send
+    // does not hold up the schedule.
+    uint64_t total = (uint64_t)(m_config.rate * m_config.duration / 1000);
+    std::chrono::duration<double> interval(1 / m_config.rate);
+    TimePoint start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < m_config.concurrency; t++)
+    {
+        threads.emplace_back([&, t]
+        {
+            for (uint64_t index = t; index < total; index += m_config.concurrency)
+            {
+                TimePoint due = start + std::chrono::duration_cast<
+                                std::chrono::steady_clock::duration>(interval * index);
+                std::this_thread::sleep_until(due);
+                action(index, due);
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    report.duration = elapsedMicroseconds(start) / 1000.0;
+    report.achievedRate = total / (report.duration / 1000);
+}
+
+void SimulatorLoadGenerator::sendRequest(const std::shared_ptr<LoadRecorder> &recorder,
+        uint64_t index, TimePoint due)
+{
+    // Spread every request type evenly over all targets.
+    const SimulatorRemoteResourceSP &target = m_targets[index % m_targets.size()];
+    unsigned int slot = (index / m_targets.size()) %
+                        (m_config.getWeight + m_config.putWeight + m_config.postWeight);
+
+    RequestType type = RequestType::RQ_TYPE_GET;
+    std::string method = "GET";
+    if (slot >= m_config.getWeight + m_config.putWeight)
+    {
+        type = RequestType::RQ_TYPE_POST;
+        method = "POST";
+    }
+    else if (slot >= m_config.getWeight)
+    {
+        type = RequestType::RQ_TYPE_PUT;
+        method = "PUT";
+    }
+
+    std::string key = method + " " + target->getURI();
+    SimulatorRemoteResource::ResponseCallback callback = std::bind(
+                [](const std::string &, SimulatorResult result, const SimulatorResourceModel &,
+                   std::shared_ptr<LoadRecorder> recorder, std::string key, TimePoint due)
+    {
+        recorder->received(key, result, elapsedMicroseconds(due));
+    }, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, recorder, key, due);
+
+    recorder->sent(key);
+    try
+    {
+        switch (type)
+        {
+            case RequestType::RQ_TYPE_PUT: target->put(m_representation, callback); break;
+            case RequestType::RQ_TYPE_POST: target->post(m_representation, callback); break;
+            default: target->get(std::map<std::string, std::string>(), callback); break;
+        }
+    }
+    catch (SimulatorException &e)
+    {
+        OIC_LOG_V(ERROR, TAG, "Failed to send %s request: %s", method.c_str(), e.what());
+        recorder->failed(key);
+    }
+}
+
+void SimulatorLoadGenerator::runRequests(const std::shared_ptr<LoadRecorder> &recorder,
+        LoadReport &report)
+{
+    if (m_targets.empty())
+    {
+        throw SimulatorException(SIMULATOR_NO_RESOURCE, "No target resources!");
+    }
+
+    dispatch(std::bind(&SimulatorLoadGenerator::sendRequest, this, recorder,
+                       std::placeholders::_1, std::placeholders::_2), report);
+    recorder->waitForResponses(std::chrono::milliseconds(m_config.timeout));
+}
+
+void SimulatorLoadGenerator::runObserveFanIn(const std::shared_ptr<LoadRecorder> &recorder,
+        LoadReport &report)
+{
+    if (m_targets.empty())
+    {
+        throw SimulatorException(SIMULATOR_NO_RESOURCE, "No target resources!");
+    }
+
+    // Notifications carry the time of the update, so only those of updates
+    // made during this run are matched. The response to the observe request
+    // itself carries an older value.
+    double runStart = monotonicMicroseconds();
+    for (auto &target : m_targets)
+    {
+        std::string key = "NOTIFY " + target->getURI();
+        bool matched = !m_sources.empty();
+        target->observe(ObserveType::OBSERVE, std::bind(
+                            [](const std::string &, SimulatorResult result,
+                               const SimulatorResourceModel &resModel, int,
+                               std::shared_ptr<LoadRecorder> recorder, std::string key,
+                               bool matched, double runStart)
+        {
+            if (!matched)
+            {
+                recorder->unmatched(key);
+                return;
+            }
+
+            if (!resModel.contains(TIMESTAMP_ATTRIBUTE))
+            {
+                return;
+            }
+
+            double updated = resModel.get<double>(TIMESTAMP_ATTRIBUTE);
+            if (updated < runStart)
+            {
+                return;
+            }
+
+            double latency = monotonicMicroseconds() - updated;
+            recorder->received(key, result, (uint64_t)(latency > 0 ? latency : 0));
+        }, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+        std::placeholders::_4, recorder, key, matched, runStart));
+    }
+
+    if (m_sources.empty())
+    {
+        // Updates are made by the remote servers, just count for the duration.
+        TimePoint start = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(m_config.duration));
+        report.duration = elapsedMicroseconds(start) / 1000.0;
+        report.achievedRate = 0;
+    }
+    else
+    {
+        dispatch([this, &recorder](uint64_t index, TimePoint)
+        {
+            const SimulatorSingleResourceSP &source = m_sources[index % m_sources.size()];
+            recorder->sent("NOTIFY " + source->getURI());
+            if (!source->updateAttributeValue(TIMESTAMP_ATTRIBUTE, monotonicMicroseconds()))
+            {
+                recorder->failed("NOTIFY " + source->getURI());
+            }
+        }, report);
+        recorder->waitForResponses(std::chrono::milliseconds(m_config.timeout));
+    }
+
+    for (auto &target : m_targets)
+    {
+        try
+        {
+            target->cancelObserve();
+        }
+        catch (SimulatorException &e)
+        {
+            OIC_LOG_V(ERROR, TAG, "Failed to cancel observe: %s", e.what());
+        }
+    }
+}
+
+void SimulatorLoadGenerator::runDiscoveryStorm(const std::shared_ptr<LoadRecorder> &recorder,
+        LoadReport &report)
+{
+    std::string key = "DISCOVER " + (m_resourceType.empty() ? "*" : m_resourceType);
+
+    dispatch([this, &recorder, &key](uint64_t, TimePoint due)
+    {
+        // Only the first response of each discovery is timed.
+        std::shared_ptr<std::once_flag> firstResponse = std::make_shared<std::once_flag>();
+        ResourceFindCallback callback = std::bind(
+                                            [](std::shared_ptr<SimulatorRemoteResource>,
+                                               std::shared_ptr<LoadRecorder> recorder, std::string key, TimePoint due,
+                                               std::shared_ptr<std::once_flag> firstResponse)
+        {
+            std::call_once(*firstResponse, [&]
+            {
+                recorder->received(key, SIMULATOR_OK, elapsedMicroseconds(due));
+            });
+        }, std::placeholders::_1, recorder, key, due, firstResponse);
+
+        recorder->sent(key);
+        try
+        {
+            if (m_resourceType.empty())
+            {
+                SimulatorManager::getInstance()->findResource(callback);
+            }
+            else
+            {
+                SimulatorManager::getInstance()->findResource(m_resourceType, callback);
+            }
+        }
+        catch (SimulatorException &e)
+        {
+            OIC_LOG_V(ERROR, TAG, "Failed to send discovery request: %s", e.what());
+            recorder->failed(key);
+        }
+    }, report);
+
+    recorder->waitForResponses(std::chrono::milliseconds(m_config.timeout));
+}
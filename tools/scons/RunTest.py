@@ -110,6 +110,42 @@ def run_test(env, run_valgrind, test, test_targets=None):
     env.AlwaysBuild(ut)
 
 
+def run_benchmark(env, benchmark, benchmark_targets=None):
+    """
+    Run a benchmark using the given SCons construction environment.
+
+    `benchmark` is the path relative to the top of the build directory of
+    the benchmark binary. Benchmarks print one JSON object per line for
+    each result; these lines are collected in
+    BUILD_DIR/benchmark_out/<benchmark name>.json so runs can be compared.
+
+    `benchmark_targets` are set as explicit dependencies, the default is
+    the name 'benchmark'. As with run_test, a failing benchmark does not
+    fail the build.
+    """
+
+    build_dir = env.get('BUILD_DIR')
+    result_dir = os.path.join(build_dir, 'benchmark_out')
+    if not os.path.isdir(result_dir):
+        os.makedirs(result_dir)
+
+    env.AppendENVPath('LD_LIBRARY_PATH', build_dir)
+
+    if not benchmark_targets:
+        benchmark_targets = ['benchmark']
+
+    benchmark_cmd = os.path.join(build_dir, benchmark)
+    out_file = os.path.join(result_dir, os.path.basename(benchmark) + '.json')
+
+    if env.get('TARGET_OS') in ['linux']:
+        env.Depends('ub' + benchmark, benchmark_cmd)
+
+    ub = env.Command('ub' + benchmark, None,
+                     "-%s | grep '^{' > %s" % (benchmark_cmd, out_file))
+    env.Depends(ub, benchmark_targets)
+    env.AlwaysBuild(ub)
+
+
 def run_uwp_wack_test(env, cert_file, appx_file, report_output_path):
     if env.get('TARGET_OS') != 'windows' or env.get('MSVC_UWP_APP') != '1':
         return